@@ -0,0 +1,35 @@
+# GPLANG: Common Subexpressions - repeated work the optimizer shares
+# Demonstrates: expressions computed twice, reloads of a global just
+# stored, and calls that change globals between loads
+
+var total: i32 = 0
+var calls: i32 = 0
+
+func bump(step: i32) -> i32:
+    calls = calls + step
+    return calls
+
+func main():
+    print("🔁 GPLANG Common Subexpressions")
+
+    var a = 7
+    var b = 5
+    var sum = 0
+    for i in range(20):
+        var p = (a + i) * (b - i)
+        var q = (i + a) * (b - i) + (a + i)
+        sum += p + q
+        total = total + p
+        sum += total
+    print("Sum: " + str(sum))
+    print("Total: " + str(total))
+
+    var before = calls
+    bump(3)
+    var after = calls
+    print("Calls: " + str(before) + " -> " + str(after) + ", doubled " + str(calls + calls))
+
+    var left = "ab"
+    var right = "cd"
+    print("Strings: " + left + right + " " + right + left)
+    return 0
@@ -0,0 +1,56 @@
+# GPLANG: Inline Calls - small functions the optimizer inlines
+# Demonstrates: accessors and helpers inlined into loops with -O,
+# `inline func` to always inline, recursion left as calls
+
+func cell(row: i32, col: i32, width: i32) -> i32:
+    return row * width + col
+
+func clamp(value: i32, low: i32, high: i32) -> i32:
+    if value < low:
+        return low
+    if value > high:
+        return high
+    return value
+
+inline func weight(value: i32) -> i32:
+    var result = value * 3
+    if value % 2 == 0:
+        result = result + 1
+    return result
+
+func is_even(n: i32) -> i32:
+    if n == 0:
+        return 1
+    return is_odd(n - 1)
+
+func is_odd(n: i32) -> i32:
+    if n == 0:
+        return 0
+    return is_even(n - 1)
+
+func factorial(n: i32) -> i32:
+    if n <= 1:
+        return 1
+    return n * factorial(n - 1)
+
+func main():
+    print("📥 GPLANG Inline Calls")
+
+    var width = 8
+    var trace = 0
+    for row in range(8):
+        for col in range(8):
+            trace += cell(row, col, width) * clamp(row - col, 0 - 2, 2)
+    print("Weighted cells: " + str(trace))
+
+    var weights = 0
+    for i in range(100):
+        weights += weight(i)
+    print("Weights: " + str(weights))
+
+    print("Clamped: " + str(clamp(42, 0, 10)) + " " + str(clamp(0 - 5, 0, 10)))
+    print("10 is even: " + str(is_even(10)))
+    print("7 is odd: " + str(is_odd(7)))
+    print("12!: " + str(factorial(12)))
+
+    return 0
@@ -0,0 +1,30 @@
+# GPLANG: Loop Direction - range() counts up or down by the step's sign
+# Demonstrates: steps only known at run time, literal steps written
+# with nested minus signs, and a parallel loop counting down
+
+func count(start: i64, end: i64, step: i64) -> i64:
+    var n = 0
+    for i in range(start, end, step):
+        n = n + 1
+    return n
+
+func main():
+    print("↕️ GPLANG Loop Direction")
+
+    var down = -1
+    print("range(0, 5, -1): " + str(count(0, 5, down)))
+    print("range(0, -5, -1): " + str(count(0, -5, down)))
+    print("range(10, 0, -3): " + str(count(10, 0, -3)))
+    print("range(0, 10, 3): " + str(count(0, 10, 3)))
+
+    var k = 0
+    for i in range(0, 10, -(-2)):
+        k = k + i
+    print("Sum of range(0, 10, -(-2)): " + str(k))
+
+    var total = 0
+    parallel for i in range(100000, 0, down):
+        total += i
+    print("Parallel sum counting down: " + str(total))
+
+    return 0
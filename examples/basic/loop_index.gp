@@ -0,0 +1,40 @@
+# GPLANG: Loop Index - index arithmetic the optimizer simplifies
+# Demonstrates: row * width + col in nested loops, invariant expressions
+# moved out of loops and products of the loop counter turned into adds
+
+func main():
+    print("🔢 GPLANG Loop Index")
+
+    var width = 12
+    var height = 9
+    var checksum = 0
+    for row in range(height):
+        for col in range(width):
+            var index = row * width + col
+            checksum += index * (width * height - index)
+    print("Grid checksum: " + str(checksum))
+
+    var stepped = 0
+    for i in range(3, 300, 7):
+        stepped += i * 5 + width * 2
+    print("Stepped: " + str(stepped))
+
+    var falling = 0
+    for j in range(40, 0, -3):
+        falling += j * 11
+    print("Falling: " + str(falling))
+
+    var scale = 0.1
+    var fractions = 0.0
+    for k in range(10):
+        fractions += k * scale
+    print("Fractions: " + str(fractions))
+
+    var n = 0
+    var label = ""
+    while n < 4:
+        label = label + "ab"
+        n += 1
+    print("Label: " + label)
+
+    return 0
@@ -0,0 +1,34 @@
+# GPLANG: Parallel Sum - work-stealing parallel loops
+# Demonstrates: parallel for with running sums, split across all cores
+
+func is_prime(n: i64) -> bool:
+    if n < 2:
+        return false
+    var d = 2
+    while d * d <= n:
+        if n % d == 0:
+            return false
+        d = d + 1
+    return true
+
+func main():
+    print("🧮 GPLANG Parallel Sum")
+
+    var total = 0
+    parallel for i in range(1, 1000001):
+        total += i
+    print("Sum of 1..1000000: " + str(total))
+
+    var primes = 0
+    parallel for n in range(200000):
+        if is_prime(n):
+            primes += 1
+    print("Primes below 200000: " + str(primes))
+
+    var squares = 0.0
+    parallel for k in range(1000, 0, -1):
+        var x = k * 0.5
+        squares = squares + x * x
+    print("Sum of squares: " + str(squares))
+
+    return 0
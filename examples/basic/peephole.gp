@@ -0,0 +1,42 @@
+# GPLANG: Peephole - machine-level cleanups after instruction selection
+# Demonstrates: multiplications by powers of two done as shifts, reloads
+# of just-spilled values turned into register copies, branches over
+# jumps folded into one inverted branch
+
+func scale(x: i32) -> i32:
+    return x * 8 + x * 1 - x * 64
+
+func pick(a: i32, b: i32) -> i32:
+    if a > b:
+        return a * 16
+    else:
+        return b * 2
+
+func mix(n: i32) -> i32:
+    var a = n + 1
+    var b = n * 2
+    var c = n * 4
+    var d = n + 3
+    var e = n * 32
+    var f = n + 5
+    var g = n * 128
+    var h = n + 7
+    var i = n * 3
+    var j = n + 9
+    var k = n * 5
+    var l = n + 11
+    return a + b + c + d + e + f + g + h + i + j + k + l
+
+func main():
+    print("🔧 GPLANG Peephole")
+
+    var total = 0
+    for n in range(1000):
+        total = total + scale(n) + pick(n, 500)
+    print("Scaled and picked: " + str(total))
+
+    var mixed = 0
+    for n in range(100):
+        mixed = mixed + mix(n)
+    print("Mixed: " + str(mixed))
+    return 0
@@ -0,0 +1,38 @@
+# GPLANG: Shadowing - block-scoped variables
+# Demonstrates: a var in a while, if or for body hides the outer name
+# until the block ends, including inside a parallel loop body
+
+func scale(x: i64) -> i64:
+    if x > 10:
+        var x = 10
+        return x * 2
+    return x * 2
+
+func main():
+    print("🫥 GPLANG Shadowing")
+
+    var x = 1
+    var n = 0
+    while n < 3:
+        var x = 8
+        n = n + x
+    print("After while: x = " + str(x) + ", n = " + str(n))
+
+    if n > 0:
+        var x = 2.5
+        print("Inside if: x = " + str(x))
+    print("After if: x = " + str(x))
+
+    for i in range(3):
+        var x = i + 100
+        n = n + x
+    print("After for: x = " + str(x) + ", n = " + str(n))
+
+    var total = 0
+    parallel for i in range(1000):
+        var x = i * 2
+        total += x
+    print("Parallel total: " + str(total) + ", x = " + str(x))
+
+    print("scale(4) = " + str(scale(4)) + ", scale(40) = " + str(scale(40)))
+    return 0
@@ -0,0 +1,64 @@
+# GPLANG: Tail Calls - recursion that runs in constant stack space
+# Demonstrates: calls in tail position entered with jmp, self-recursion
+# turned into loops by -O, with an accumulator for `f(n - 1) + x`, and
+# tail calls passing more arguments than fit in registers
+
+func count_down(n: i32, total: i32) -> i32:
+    if n == 0:
+        return total
+    return count_down(n - 1, total + n % 7)
+
+func is_even(n: i32) -> i32:
+    if n == 0:
+        return 1
+    return is_odd(n - 1)
+
+func is_odd(n: i32) -> i32:
+    if n == 0:
+        return 0
+    return is_even(n - 1)
+
+func ping(n: i64, a: i64, b: i64, c: i64, d: i64, e: i64, f: i64) -> i64:
+    if n == 0:
+        return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f
+    return pong(n - 1, f, a, b, c, d, e + 1)
+
+func pong(n: i64, a: i64, b: i64, c: i64, d: i64, e: i64, f: i64) -> i64:
+    if n == 0:
+        return a - b + c - d + e - f
+    return ping(n - 1, b, c, d, e, f, a + n % 3)
+
+func spread(n: i64, a: i64, b: i64, c: i64, d: i64, e: i64, f: i64, g: i64) -> i64:
+    if n == 0:
+        return a + 2 * b + 3 * c + 4 * d + 5 * e + 6 * f + 7 * g
+    return spread(n - 1, g, a, b, c, d, e, f + n % 5)
+
+func widen(n: i64) -> i64:
+    return spread(n, 1, 2, 3, 4, 5, 6, 7)
+
+func triangle(n: i32) -> i32:
+    if n == 0:
+        return 0
+    return n + triangle(n - 1)
+
+func factorial(n: i32) -> i32:
+    if n <= 1:
+        return 1
+    return factorial(n - 1) * n
+
+func fibonacci(n: i32) -> i32:
+    if n <= 1:
+        return n
+    return fibonacci(n - 1) + fibonacci(n - 2)
+
+func main():
+    print("🔁 GPLANG Tail Calls")
+
+    print("Count down: " + str(count_down(1000000, 0)))
+    print("Parity of 1000001: " + str(is_even(1000001)) + " even, " + str(is_odd(1000001)) + " odd")
+    print("Ping-pong over 7 arguments: " + str(ping(100001, 1, 2, 3, 4, 5, 6)))
+    print("Spread over 8 arguments: " + str(widen(1000000)))
+    print("Triangle(50000): " + str(triangle(50000)))
+    print("Factorial(20): " + str(factorial(20)))
+    print("Fibonacci(24): " + str(fibonacci(24)))
+    return 0
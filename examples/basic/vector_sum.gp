@@ -0,0 +1,26 @@
+# GPLANG: Vector Sum - loops the optimizer vectorizes
+# Demonstrates: integer sums over counted loops, run two iterations at a time with -O
+
+func main():
+    print("➕ GPLANG Vector Sum")
+
+    var total = 0
+    var squares = 0
+    for i in range(1, 1000001):
+        total += i * 3 + 1
+        squares += i * i
+    print("Sum of 3i+1: " + str(total))
+    print("Sum of squares: " + str(squares))
+
+    var scale = 0 - 40000000
+    var wide = 0
+    for k in range(7):
+        wide -= k * scale * 1000
+    print("Wide products: " + str(wide))
+
+    var countdown = 100
+    for j in range(5, 10):
+        countdown -= j
+    print("Countdown: " + str(countdown))
+
+    return 0
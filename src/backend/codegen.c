@@ -1,4 +1,14 @@
+#include <stdarg.h>
 #include "codegen.h"
+#include "regalloc.h"
+#include "peephole.h"
+
+static void emit_allocation_summary(CodeGenerator* codegen);
+static bool count_uses(CodeGenerator* codegen, IRFunction* function);
+static void write_label(CodeGenerator* codegen, const char* label);
+static void write_instruction(CodeGenerator* codegen, const char* mnemonic, const char* operands);
+static void write_comment(CodeGenerator* codegen, const char* comment);
+static void arm64_function_entry(CodeGenerator* codegen, IRFunction* function);
 
 // Create code generator
 CodeGenerator* codegen_create(TargetArch target, FILE* output) {
@@ -7,13 +17,31 @@ CodeGenerator* codegen_create(TargetArch target, FILE* output) {
     
     codegen->target = target;
     codegen->output = output;
+    memset(&codegen->assembly, 0, sizeof(codegen->assembly));
+    codegen->encoder = NULL;
     codegen->register_map = NULL;
     codegen->register_map_size = 0;
     codegen->register_map_capacity = 0;
+    codegen->callee_saved_used = 0;
+    memset(codegen->callee_save_offset, 0, sizeof(codegen->callee_save_offset));
     codegen->stack_offset = 0;
     codegen->max_stack_size = 0;
     codegen->next_label_id = 1;
+    codegen->current_module = NULL;
     codegen->current_function = NULL;
+    codegen->current_block = NULL;
+    codegen->module_kinds = NULL;
+    codegen->value_kinds = NULL;
+    codegen->use_counts = NULL;
+    codegen->deferred = NULL;
+    codegen->tail_return = NULL;
+    codegen->string_literals = NULL;
+    codegen->string_literal_count = 0;
+    codegen->string_literal_capacity = 0;
+    codegen->pool = NULL;
+    codegen->parent = NULL;
+    codegen->code = NULL;
+    codegen->peephole_rewrites = 0;
     codegen->has_errors = false;
     codegen->error_message = NULL;
     
@@ -25,41 +53,179 @@ void codegen_destroy(CodeGenerator* codegen) {
     if (!codegen) return;
     
     free(codegen->register_map);
+    value_kinds_destroy(codegen->module_kinds);
+    free(codegen->use_counts);
+    for (int i = 0; i < codegen->string_literal_count; i++) {
+        free(codegen->string_literals[i]);
+    }
+    free(codegen->string_literals);
+    text_buffer_free(&codegen->assembly);
+    if (codegen->code) {
+        free(codegen->code->lines);
+        free(codegen->code->text);
+        free(codegen->code);
+    }
     free(codegen->error_message);
     free(codegen);
 }
 
+// Functions of a module, generated by independent workers
+typedef struct {
+    CodeGenerator* parent;
+    IRFunction** functions;
+    CodeGenerator** workers;
+} ModuleJob;
+
+// Generate one function into its own buffer. The worker shares the
+// module's value kinds and string literals, which it only reads.
+static void generate_function_job(void* context, size_t index) {
+    ModuleJob* job = context;
+    CodeGenerator* parent = job->parent;
+    CodeGenerator* worker = codegen_create(parent->target, NULL);
+    job->workers[index] = worker;
+    if (!worker) return;
+    
+    worker->parent = parent;
+    worker->current_module = parent->current_module;
+    worker->module_kinds = parent->module_kinds;
+    worker->code = calloc(1, sizeof(CodeBuffer));
+    if (!worker->code) {
+        codegen_error(worker, "Out of memory buffering function code");
+        return;
+    }
+    if (!codegen_generate_function(worker, job->functions[index]) && !worker->has_errors) {
+        codegen_error(worker, "Code generation failed");
+    }
+    if (!worker->has_errors) {
+        int rewrites = peephole_optimize(worker->code, worker->target);
+        if (rewrites > 0) worker->peephole_rewrites = rewrites;
+    }
+    
+    // Only the buffered lines outlive the job
+    free(worker->register_map);
+    worker->register_map = NULL;
+    worker->register_map_size = worker->register_map_capacity = 0;
+    free(worker->use_counts);
+    worker->use_counts = NULL;
+}
+
+static void destroy_worker(CodeGenerator* worker) {
+    if (!worker) return;
+    worker->module_kinds = NULL;    // Owned by the parent
+    codegen_destroy(worker);
+}
+
+// Write a function's buffered lines to the encoder and the assembly
+static void flush_function(CodeGenerator* codegen, const CodeBuffer* code) {
+    for (int i = 0; i < code->line_count; i++) {
+        const CodeLine* line = &code->lines[i];
+        const char* text = code->text + line->text;
+        switch (line->kind) {
+            case CODE_LABEL:
+                write_label(codegen, text);
+                break;
+            case CODE_INSTRUCTION:
+                write_instruction(codegen, text, code->text + line->operands);
+                break;
+            case CODE_COMMENT:
+                write_comment(codegen, text);
+                break;
+        }
+    }
+    if (codegen->output) text_buffer_putc(&codegen->assembly, '\n');
+}
+
+/*
+ * Functions only share read-only module state, so each is generated by
+ * its own worker, on the pool when there is one. Their buffers are then
+ * written out in module order: the output does not depend on scheduling.
+ */
+static bool generate_functions(CodeGenerator* codegen, IRModule* module) {
+    int count = 0;
+    for (IRFunction* function = module->functions; function; function = function->next) count++;
+    if (count == 0) return true;
+    
+    ModuleJob job = { codegen, calloc(count, sizeof(IRFunction*)), calloc(count, sizeof(CodeGenerator*)) };
+    if (!job.functions || !job.workers) {
+        free(job.functions);
+        free(job.workers);
+        codegen_error(codegen, "Out of memory in code generation");
+        return false;
+    }
+    int index = 0;
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        job.functions[index++] = function;
+    }
+    
+    // Workers only look literals up: number them all beforehand
+    if (codegen->target == TARGET_X86_64) x86_64_module_literals(codegen, module);
+    if (!codegen->has_errors) thread_pool_run(codegen->pool, count, generate_function_job, &job);
+    
+    // The first failure in module order is the one reported
+    for (int i = 0; i < count && !codegen->has_errors; i++) {
+        CodeGenerator* worker = job.workers[i];
+        if (!worker) {
+            codegen_error(codegen, "Out of memory in code generation");
+        } else if (worker->has_errors) {
+            codegen_error(codegen, worker->error_message);
+        } else if (worker->code->failed) {
+            codegen_error(codegen, "Out of memory buffering function code");
+        } else {
+            flush_function(codegen, worker->code);
+            codegen->peephole_rewrites += worker->peephole_rewrites;
+        }
+    }
+    
+    for (int i = 0; i < count; i++) destroy_worker(job.workers[i]);
+    free(job.functions);
+    free(job.workers);
+    return !codegen->has_errors;
+}
+
 // Generate code for module
 bool codegen_generate_module(CodeGenerator* codegen, IRModule* module) {
     if (!codegen || !module) return false;
     
-    // Emit module header
-    fprintf(codegen->output, "# GPLANG Generated Assembly\n");
-    fprintf(codegen->output, "# Module: %s\n", module->name);
-    if (module->source_file) {
-        fprintf(codegen->output, "# Source: %s\n", module->source_file);
+    // The IR is untyped: find out which registers hold doubles and strings
+    codegen->current_module = module;
+    value_kinds_destroy(codegen->module_kinds);
+    codegen->module_kinds = value_kinds_infer(module);
+    if (!codegen->module_kinds) {
+        codegen_error(codegen, "Out of memory in value kind inference");
+        return false;
     }
-    fprintf(codegen->output, "# Target: %s\n", target_arch_to_string(codegen->target));
-    fprintf(codegen->output, "\n");
     
-    // Emit target-specific directives
-    if (codegen->target == TARGET_X86_64) {
-        fprintf(codegen->output, ".section .text\n");
-        fprintf(codegen->output, ".global main\n\n");
-    } else if (codegen->target == TARGET_ARM64) {
-        fprintf(codegen->output, ".section .text\n");
-        fprintf(codegen->output, ".global main\n\n");
+    // Emit module header
+    if (codegen->output) {
+        TextBuffer* text = &codegen->assembly;
+        text_buffer_puts(text, "# GPLANG Generated Assembly\n# Module: ");
+        text_buffer_puts(text, module->name);
+        if (module->source_file) {
+            text_buffer_puts(text, "\n# Source: ");
+            text_buffer_puts(text, module->source_file);
+        }
+        text_buffer_puts(text, "\n# Target: ");
+        text_buffer_puts(text, target_arch_to_string(codegen->target));
+        text_buffer_puts(text, "\n\n");
+        
+        // Emit target-specific directives
+        if (codegen->target == TARGET_X86_64 || codegen->target == TARGET_ARM64) {
+            text_buffer_puts(text, ".section .text\n.global main\n\n");
+        }
     }
     
-    // Generate code for each function
-    IRFunction* function = module->functions;
-    while (function) {
-        if (!codegen_generate_function(codegen, function)) {
-            return false;
+    if (!generate_functions(codegen, module)) return false;
+    
+    if (codegen->target == TARGET_X86_64) {
+        x86_64_module_data(codegen);
+        if (codegen->encoder && !x86_64_encoder_finish(codegen->encoder)) {
+            codegen_error(codegen, codegen->encoder->error);
         }
-        function = function->next;
     }
     
+    if (codegen->output && !text_buffer_write(&codegen->assembly, codegen->output)) {
+        codegen_error(codegen, "Failed to write the assembly");
+    }
     return !codegen->has_errors;
 }
 
@@ -68,12 +234,26 @@ bool codegen_generate_function(CodeGenerator* codegen, IRFunction* function) {
     if (!codegen || !function) return false;
     
     codegen->current_function = function;
+    codegen->value_kinds = value_kinds_registers(codegen->module_kinds, function);
+    codegen->deferred = NULL;
+    codegen->tail_return = NULL;
+    if (!count_uses(codegen, function)) return false;
+    
+    // Registers and stack slots for every value, before the prologue sizes the frame
+    codegen_allocate_registers(codegen, function);
+    if (codegen->has_errors) return false;
     
     // Emit function label
     emit_label(codegen, function->name);
+    emit_allocation_summary(codegen);
     
     // Emit function prologue
     emit_function_prologue(codegen, function);
+    if (codegen->target == TARGET_X86_64) {
+        x86_64_function_entry(codegen, function);
+    } else if (codegen->target == TARGET_ARM64) {
+        arm64_function_entry(codegen, function);
+    }
     
     // Generate code for each basic block
     IRBasicBlock* block = function->blocks;
@@ -84,10 +264,21 @@ bool codegen_generate_function(CodeGenerator* codegen, IRFunction* function) {
         block = block->next;
     }
     
-    // Emit function epilogue
-    emit_function_epilogue(codegen, function);
+    // Returns emit their own epilogue; only falling off the last block needs one here
+    IRBasicBlock* last = function->blocks;
+    while (last && last->next) last = last->next;
+    if (!last || !ir_basic_block_is_terminated(last)) {
+        emit_function_epilogue(codegen, function);
+    }
     
-    fprintf(codegen->output, "\n");
+    // Called on its own rather than for a module, the function goes straight out
+    if (!codegen->code && codegen->output) {
+        text_buffer_putc(&codegen->assembly, '\n');
+        if (!text_buffer_write(&codegen->assembly, codegen->output)) {
+            codegen_error(codegen, "Failed to write the assembly");
+            return false;
+        }
+    }
     return true;
 }
 
@@ -95,9 +286,12 @@ bool codegen_generate_function(CodeGenerator* codegen, IRFunction* function) {
 bool codegen_generate_basic_block(CodeGenerator* codegen, IRBasicBlock* block) {
     if (!codegen || !block) return false;
     
+    codegen->current_block = block;
+    
     // Emit block label if it has one
-    if (block->label && strcmp(block->label, "entry") != 0) {
-        emit_label(codegen, block->label);
+    if (block->label) {
+        char label[128];
+        emit_label(codegen, codegen_block_label(codegen, block->label, label, sizeof(label)));
     }
     
     // Generate code for each instruction
@@ -129,145 +323,827 @@ bool codegen_generate_instruction(CodeGenerator* codegen, IRInstruction* instruc
     }
 }
 
-// Generate x86_64 instruction
-bool codegen_x86_64_instruction(CodeGenerator* codegen, IRInstruction* instruction) {
-    switch (instruction->opcode) {
-        case IR_ADD:
-            emit_instruction(codegen, "addq", "%rax, %rbx");
-            break;
-        case IR_SUB:
-            emit_instruction(codegen, "subq", "%rax, %rbx");
-            break;
-        case IR_MUL:
-            emit_instruction(codegen, "imulq", "%rax, %rbx");
-            break;
-        case IR_DIV:
-            emit_instruction(codegen, "idivq", "%rbx");
-            break;
-        case IR_CONST_INT:
-            emit_instruction(codegen, "movq", "$42, %rax");
-            break;
-        case IR_LOAD:
-            emit_instruction(codegen, "movq", "(%rax), %rbx");
-            break;
-        case IR_STORE:
-            emit_instruction(codegen, "movq", "%rax, (%rbx)");
-            break;
-        case IR_CALL:
-            emit_instruction(codegen, "call", "printf");
-            break;
-        case IR_RETURN:
-            emit_instruction(codegen, "movq", "$0, %rax");
-            break;
-        case IR_JUMP:
-            emit_instruction(codegen, "jmp", "loop");
-            break;
-        case IR_BRANCH:
-            emit_instruction(codegen, "cmpq", "$0, %rax");
-            emit_instruction(codegen, "jne", "true_branch");
-            break;
-        default:
-            emit_comment(codegen, "Unsupported instruction");
+// Count how often each virtual register is read, for folding single-use values
+static bool count_uses(CodeGenerator* codegen, IRFunction* function) {
+    int count = function->next_register_id > 0 ? function->next_register_id : 1;
+    free(codegen->use_counts);
+    codegen->use_counts = calloc(count, sizeof(int));
+    if (!codegen->use_counts) {
+        codegen_error(codegen, "Out of memory counting register uses");
+        return false;
+    }
+    
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            IRValue* operands[3] = { inst->src1, inst->src2, inst->src3 };
+            for (int i = 0; i < 3; i++) {
+                if (operands[i] && operands[i]->type == IR_VALUE_REGISTER &&
+                    operands[i]->reg_id >= 0 && operands[i]->reg_id < count) {
+                    codegen->use_counts[operands[i]->reg_id]++;
+                }
+            }
+            for (int a = 0; a < inst->arg_count; a++) {
+                if (inst->args[a] && inst->args[a]->type == IR_VALUE_REGISTER &&
+                    inst->args[a]->reg_id >= 0 && inst->args[a]->reg_id < count) {
+                    codegen->use_counts[inst->args[a]->reg_id]++;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Emit an instruction with printf-style operands
+void emit_format(CodeGenerator* codegen, const char* mnemonic, const char* format, ...) {
+    char operands[160];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(operands, sizeof(operands), format, args);
+    va_end(args);
+    emit_instruction(codegen, mnemonic, operands);
+}
+
+// Emit "mnemonic first, second", the common two-operand form, without a format string
+void emit_operands(CodeGenerator* codegen, const char* mnemonic, const char* first, const char* second) {
+    char operands[160];
+    size_t first_length = strlen(first), second_length = strlen(second);
+    if (first_length + second_length + 3 > sizeof(operands)) {
+        emit_format(codegen, mnemonic, "%s, %s", first, second);
+        return;
+    }
+    memcpy(operands, first, first_length);
+    operands[first_length] = ',';
+    operands[first_length + 1] = ' ';
+    memcpy(operands + first_length + 2, second, second_length + 1);
+    emit_instruction(codegen, mnemonic, operands);
+}
+
+// prefix, value in decimal and suffix, as "$%lld" or "%d(%rbp)" would print them; truncates like snprintf
+const char* codegen_operand(char* buffer, size_t size, const char* prefix, long long value, const char* suffix) {
+    char digits[24];
+    char* start = digits + sizeof(digits);
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        *--start = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) *--start = '-';
+
+    const char* parts[3] = { prefix, start, suffix };
+    size_t lengths[3] = { strlen(prefix), (size_t)(digits + sizeof(digits) - start), strlen(suffix) };
+    size_t used = 0;
+    for (int i = 0; i < 3 && size > 0; i++) {
+        size_t length = lengths[i] < size - 1 - used ? lengths[i] : size - 1 - used;
+        memcpy(buffer + used, parts[i], length);
+        used += length;
+    }
+    if (size > 0) buffer[used] = '\0';
+    return buffer;
+}
+
+// Allocation of a register operand, NULL for constants and unknown registers
+const RegisterMapping* codegen_value_mapping(CodeGenerator* codegen, const IRValue* value) {
+    if (!value || value->type != IR_VALUE_REGISTER) return NULL;
+    if (value->reg_id < 0 || value->reg_id >= codegen->register_map_size) return NULL;
+    return &codegen->register_map[value->reg_id];
+}
+
+ValueKind codegen_value_kind(CodeGenerator* codegen, const IRValue* value) {
+    return value_kind_of(codegen->value_kinds, codegen->current_function->next_register_id, value);
+}
+
+bool codegen_is_int_constant(const IRValue* value) {
+    return value && value->type == IR_VALUE_CONSTANT && value->constant.const_type == IR_CONST_INT_VAL;
+}
+
+// Block labels are local to their function, so they are prefixed with its name
+const char* codegen_block_label(CodeGenerator* codegen, const char* label, char* buffer, size_t size) {
+    snprintf(buffer, size, ".L%s.%s", codegen->current_function->name, label);
+    return buffer;
+}
+
+// mov of an arbitrary 64-bit constant into an ARM64 register
+static void arm64_materialize(CodeGenerator* codegen, const char* reg, long long value) {
+    if (value >= -65536 && value < 65536) {
+        emit_format(codegen, "mov", "%s, #%lld", reg, value);
+        return;
+    }
+    unsigned long long bits = (unsigned long long)value;
+    emit_format(codegen, "movz", "%s, #%llu", reg, bits & 0xFFFF);
+    for (int shift = 16; shift < 64; shift += 16) {
+        unsigned long long chunk = (bits >> shift) & 0xFFFF;
+        if (chunk) emit_format(codegen, "movk", "%s, #%llu, lsl #%d", reg, chunk, shift);
+    }
+}
+
+// Load or store reg at a frame-pointer-relative offset
+static void emit_frame_access(CodeGenerator* codegen, bool store, int reg, int offset) {
+    if (codegen->target == TARGET_X86_64) {
+        const char* name = get_register_name_x86_64(reg);
+        if (store) emit_format(codegen, "movq", "%s, %d(%%rbp)", name, offset);
+        else emit_format(codegen, "movq", "%d(%%rbp), %s", offset, name);
+    } else if (codegen->target == TARGET_ARM64) {
+        const char* name = get_register_name_arm64(reg);
+        if (offset >= -256) {
+            emit_format(codegen, store ? "str" : "ldr", "%s, [x29, #%d]", name, offset);
+            return;
+        }
+        const char* base = get_register_name_arm64(store ? (reg == 16 ? 17 : 16) : reg);
+        arm64_materialize(codegen, base, -offset);
+        emit_format(codegen, "sub", "%s, x29, %s", base, base);
+        emit_format(codegen, store ? "str" : "ldr", "%s, [%s]", name, base);
+    } else if (codegen->target == TARGET_RISCV64) {
+        const char* name = get_register_name_riscv64(reg);
+        if (offset >= -2048) {
+            emit_format(codegen, store ? "sd" : "ld", "%s, %d(s0)", name, offset);
+            return;
+        }
+        const char* base = get_register_name_riscv64(store ? (reg == 31 ? 30 : 31) : reg);
+        emit_format(codegen, "li", "%s, %d", base, offset);
+        emit_format(codegen, "add", "%s, s0, %s", base, base);
+        emit_format(codegen, store ? "sd" : "ld", "%s, 0(%s)", name, base);
+    }
+}
+
+// Register holding value; spilled values, frame addresses and constants go through scratch
+static const char* arm64_source(CodeGenerator* codegen, const IRValue* value, int scratch) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    const char* scratch_name = get_register_name_arm64(scratch);
+    if (mapping) {
+        if (mapping->physical_reg >= 0) return get_register_name_arm64(mapping->physical_reg);
+        if (mapping->is_constant) {
+            if (mapping->constant_value == 0) return "xzr";
+            arm64_materialize(codegen, scratch_name, mapping->constant_value);
+            return scratch_name;
+        }
+        if (mapping->is_stack_address) {
+            arm64_materialize(codegen, scratch_name, -mapping->spill_offset);
+            emit_format(codegen, "sub", "%s, x29, %s", scratch_name, scratch_name);
+            return scratch_name;
+        }
+        if (mapping->is_spilled) {
+            emit_frame_access(codegen, false, scratch, mapping->spill_offset);
+            return scratch_name;
+        }
+        return "xzr";   // Never defined
+    }
+    if (codegen_is_int_constant(value)) {
+        if (value->constant.int_val == 0) return "xzr";
+        arm64_materialize(codegen, scratch_name, value->constant.int_val);
+        return scratch_name;
+    }
+    codegen_error(codegen, value && value->type == IR_VALUE_GLOBAL
+                  ? "The ARM64 backend does not support global variables yet"
+                  : "The ARM64 backend supports integer operands only");
+    return "xzr";
+}
+
+// Register to compute value into; x16 when it is spilled or unused
+static int arm64_dest(CodeGenerator* codegen, const IRValue* value) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    return mapping && mapping->physical_reg >= 0 ? mapping->physical_reg : 16;
+}
+
+// Write a spilled result back to its slot
+static void arm64_finish_dest(CodeGenerator* codegen, const IRValue* value, int reg) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (mapping && mapping->is_spilled) emit_frame_access(codegen, true, reg, mapping->spill_offset);
+}
+
+// [base] operand for the address in value
+static const char* arm64_address(CodeGenerator* codegen, const IRValue* value, char* buffer, size_t size) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (mapping && mapping->is_stack_address && mapping->spill_offset >= -256) {
+        snprintf(buffer, size, "[x29, #%d]", mapping->spill_offset);
+    } else {
+        snprintf(buffer, size, "[%s]", arm64_source(codegen, value, 17));
+    }
+    return buffer;
+}
+
+static void arm64_binary(CodeGenerator* codegen, const char* mnemonic, IRInstruction* instruction) {
+    const char* rhs = arm64_source(codegen, instruction->src2, 17);
+    const char* lhs = arm64_source(codegen, instruction->src1, 16);
+    int dest = arm64_dest(codegen, instruction->dest);
+    emit_format(codegen, mnemonic, "%s, %s, %s", get_register_name_arm64(dest), lhs, rhs);
+    arm64_finish_dest(codegen, instruction->dest, dest);
+}
+
+// Condition codes, in IR_EQ..IR_GE order
+static const char* arm64_conditions[] = { "eq", "ne", "lt", "le", "gt", "ge" };
+
+static void arm64_compare(CodeGenerator* codegen, IRInstruction* instruction) {
+    const char* rhs = arm64_source(codegen, instruction->src2, 17);
+    const char* lhs = arm64_source(codegen, instruction->src1, 16);
+    emit_format(codegen, "cmp", "%s, %s", lhs, rhs);
+    int dest = arm64_dest(codegen, instruction->dest);
+    emit_format(codegen, "cset", "%s, %s", get_register_name_arm64(dest),
+                arm64_conditions[instruction->opcode - IR_EQ]);
+    arm64_finish_dest(codegen, instruction->dest, dest);
+}
+
+// Remainder as lhs - (lhs / rhs) * rhs; x30 was saved by the prologue and is free between calls
+static void arm64_remainder(CodeGenerator* codegen, IRInstruction* instruction) {
+    const char* rhs = arm64_source(codegen, instruction->src2, 17);
+    const char* lhs = arm64_source(codegen, instruction->src1, 16);
+    int dest = arm64_dest(codegen, instruction->dest);
+    emit_format(codegen, "sdiv", "x30, %s, %s", lhs, rhs);
+    emit_format(codegen, "msub", "%s, x30, %s, %s", get_register_name_arm64(dest), rhs, lhs);
+    arm64_finish_dest(codegen, instruction->dest, dest);
+}
+
+// Operands are truth values: nonzero is true
+static void arm64_logical(CodeGenerator* codegen, IRInstruction* instruction) {
+    const char* rhs = arm64_source(codegen, instruction->src2, 17);
+    const char* lhs = arm64_source(codegen, instruction->src1, 16);
+    emit_format(codegen, "cmp", "%s, xzr", lhs);
+    emit_instruction(codegen, "cset", "x16, ne");
+    emit_format(codegen, "cmp", "%s, xzr", rhs);
+    emit_instruction(codegen, "cset", "x17, ne");
+    int dest = arm64_dest(codegen, instruction->dest);
+    emit_format(codegen, instruction->opcode == IR_AND ? "and" : "orr", "%s, x16, x17",
+                get_register_name_arm64(dest));
+    arm64_finish_dest(codegen, instruction->dest, dest);
+}
+
+// A register or a frame slot
+typedef struct {
+    int reg;                        // -1 for the slot
+    int slot;
+} Arm64Location;
+
+// A parallel-move entry: call arguments, PHI copies and parameters
+typedef struct {
+    const IRValue* value;           // Built straight into dest when source is unset
+    Arm64Location source;
+    Arm64Location dest;
+    bool has_source;
+    bool done;
+} Arm64Move;
+
+static bool arm64_same_location(Arm64Location a, Arm64Location b) {
+    return a.reg == b.reg && (a.reg >= 0 || a.slot == b.slot);
+}
+
+// Where value lives, if it lives anywhere; constants and frame addresses are rebuilt instead
+static bool arm64_location(CodeGenerator* codegen, const IRValue* value, Arm64Location* location) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (!mapping) return false;
+    if (mapping->physical_reg >= 0) {
+        *location = (Arm64Location){ mapping->physical_reg, 0 };
+        return true;
+    }
+    if (mapping->is_spilled && !mapping->is_constant && !mapping->is_stack_address) {
+        *location = (Arm64Location){ -1, mapping->spill_offset };
+        return true;
+    }
+    return false;
+}
+
+// Copy one location to another; x30 carries slot-to-slot copies
+static void arm64_copy(CodeGenerator* codegen, Arm64Location dest, Arm64Location source) {
+    if (dest.reg >= 0 && source.reg >= 0) {
+        emit_format(codegen, "mov", "%s, %s", get_register_name_arm64(dest.reg), get_register_name_arm64(source.reg));
+    } else if (dest.reg >= 0) {
+        emit_frame_access(codegen, false, dest.reg, source.slot);
+    } else if (source.reg >= 0) {
+        emit_frame_access(codegen, true, source.reg, dest.slot);
+    } else {
+        emit_frame_access(codegen, false, 30, source.slot);
+        emit_frame_access(codegen, true, 30, dest.slot);
+    }
+}
+
+// Whether another pending move still reads move i's destination
+static bool arm64_move_blocked(const Arm64Move* moves, int count, int i) {
+    for (int j = 0; j < count; j++) {
+        if (j != i && !moves[j].done && moves[j].has_source &&
+            arm64_same_location(moves[j].source, moves[i].dest)) return true;
+    }
+    return false;
+}
+
+/*
+ * Perform the moves as if all at once. Cycles are broken by parking a
+ * destination's old value in x17. Constants and frame addresses read
+ * no location, so they are built last, once every copy has its source.
+ */
+static void arm64_parallel_move(CodeGenerator* codegen, Arm64Move* moves, int count) {
+    for (int i = 0; i < count; i++) {
+        moves[i].done = moves[i].has_source && arm64_same_location(moves[i].source, moves[i].dest);
+    }
+
+    for (;;) {
+        bool remaining = false, progress = false;
+        for (int i = 0; i < count; i++) {
+            if (moves[i].done || !moves[i].has_source) continue;
+            remaining = true;
+            if (!arm64_move_blocked(moves, count, i)) {
+                arm64_copy(codegen, moves[i].dest, moves[i].source);
+                moves[i].done = true;
+                progress = true;
+            }
+        }
+        if (!remaining) break;
+        if (progress) continue;
+
+        for (int i = 0; i < count; i++) {
+            if (moves[i].done || !moves[i].has_source) continue;
+            Arm64Location park = { 17, 0 };
+            arm64_copy(codegen, park, moves[i].dest);
+            for (int j = 0; j < count; j++) {
+                if (!moves[j].done && moves[j].has_source && arm64_same_location(moves[j].source, moves[i].dest)) {
+                    moves[j].source = park;
+                }
+            }
             break;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (moves[i].done) continue;
+        int reg = moves[i].dest.reg >= 0 ? moves[i].dest.reg : 16;
+        const char* value = arm64_source(codegen, moves[i].value, reg);
+        if (strcmp(value, get_register_name_arm64(reg)) != 0) {
+            emit_format(codegen, "mov", "%s, %s", get_register_name_arm64(reg), value);
+        }
+        if (moves[i].dest.reg < 0) emit_frame_access(codegen, true, reg, moves[i].dest.slot);
+    }
+}
+
+// Fill in a move's source from value
+static void arm64_move_source(CodeGenerator* codegen, Arm64Move* move, const IRValue* value) {
+    move->value = value;
+    move->has_source = arm64_location(codegen, value, &move->source);
+}
+
+// Parameters arrive in x0-x7 (AAPCS64); main first runs the global initializers
+static void arm64_function_entry(CodeGenerator* codegen, IRFunction* function) {
+    const RegisterFile* file = regalloc_register_file(TARGET_ARM64);
+    if (strcmp(function->name, "main") == 0 &&
+        value_kinds_function_index(codegen->module_kinds, "__init") >= 0) {
+        emit_instruction(codegen, "bl", "__init");
+    }
+    if (function->parameter_count > file->argument_count) {
+        codegen_error(codegen, "The ARM64 backend passes at most 8 arguments, all in registers");
+        return;
     }
+
+    Arm64Move moves[8];
+    int count = 0;
+    for (int p = 0; p < function->parameter_count; p++) {
+        Arm64Move* move = &moves[count];
+        if (!arm64_location(codegen, function->parameters[p], &move->dest)) continue;
+        move->value = NULL;
+        move->source = (Arm64Location){ file->arguments[p], 0 };
+        move->has_source = true;
+        count++;
+    }
+    arm64_parallel_move(codegen, moves, count);
+}
+
+static IRBasicBlock* arm64_find_block(CodeGenerator* codegen, const IRValue* label) {
+    if (!label || label->type != IR_VALUE_LABEL || !label->label) return NULL;
+    for (IRBasicBlock* block = codegen->current_function->blocks; block; block = block->next) {
+        if (block->label && strcmp(block->label, label->label) == 0) return block;
+    }
+    return NULL;
+}
+
+// Copies for the PHIs of target on the edge from the current block
+static bool arm64_edge_moves(CodeGenerator* codegen, IRBasicBlock* target) {
+    int count = 0;
+    for (IRInstruction* phi = target->instructions; phi && phi->opcode == IR_PHI; phi = phi->next) count++;
+    if (count == 0) return true;
+    Arm64Move* moves = calloc(count, sizeof(Arm64Move));
+    if (!moves) {
+        codegen_error(codegen, "Out of memory for PHI copies");
+        return false;
+    }
+
+    int move_count = 0;
+    const char* from = codegen->current_block->label;
+    for (IRInstruction* phi = target->instructions; phi && phi->opcode == IR_PHI; phi = phi->next) {
+        Arm64Move* move = &moves[move_count];
+        if (!arm64_location(codegen, phi->dest, &move->dest)) continue;
+        for (int a = 0; a + 1 < phi->arg_count; a += 2) {
+            const IRValue* label = phi->args[a + 1];
+            if (label && label->type == IR_VALUE_LABEL && from && strcmp(label->label, from) == 0) {
+                arm64_move_source(codegen, move, phi->args[a]);
+                move_count++;
+                break;
+            }
+        }
+    }
+    arm64_parallel_move(codegen, moves, move_count);
+    free(moves);
+    return true;
+}
+
+// Leave the current block for label: PHI copies, then b unless it is the next block
+static bool arm64_jump(CodeGenerator* codegen, const IRValue* label, bool may_fall_through) {
+    IRBasicBlock* target = arm64_find_block(codegen, label);
+    if (!target) {
+        codegen_error(codegen, "ARM64: jump to an unknown block");
+        return false;
+    }
+    if (!arm64_edge_moves(codegen, target)) return false;
+    if (may_fall_through && target == codegen->current_block->next) return true;
+
+    char name[128];
+    emit_instruction(codegen, "b", codegen_block_label(codegen, target->label, name, sizeof(name)));
     return true;
 }
 
-// Generate ARM64 instruction
+static bool arm64_has_phis(const IRBasicBlock* block) {
+    return block && block->instructions && block->instructions->opcode == IR_PHI;
+}
+
+// cbz/cbnz straight to a side without PHIs, else to an edge block doing the false side's copies
+static bool arm64_branch(CodeGenerator* codegen, IRInstruction* instruction) {
+    const char* condition = arm64_source(codegen, instruction->src1, 16);
+    IRBasicBlock* on_true = arm64_find_block(codegen, instruction->src2);
+    IRBasicBlock* on_false = arm64_find_block(codegen, instruction->src3);
+    if (!on_true || !on_false) {
+        codegen_error(codegen, "ARM64: branch to an unknown block");
+        return false;
+    }
+
+    char name[128];
+    if (!arm64_has_phis(on_false)) {
+        emit_format(codegen, "cbz", "%s, %s", condition, codegen_block_label(codegen, on_false->label, name, sizeof(name)));
+        return arm64_jump(codegen, instruction->src2, true);
+    }
+    if (!arm64_has_phis(on_true)) {
+        emit_format(codegen, "cbnz", "%s, %s", condition, codegen_block_label(codegen, on_true->label, name, sizeof(name)));
+        return arm64_jump(codegen, instruction->src3, true);
+    }
+    snprintf(name, sizeof(name), ".L%s.edge%d", codegen->current_function->name, codegen->next_label_id++);
+    emit_format(codegen, "cbz", "%s, %s", condition, name);
+    if (!arm64_jump(codegen, instruction->src2, false)) return false;
+    emit_label(codegen, name);
+    return arm64_jump(codegen, instruction->src3, true);
+}
+
+// Call a GPLANG or runtime function, with every argument in x0-x7
+static bool arm64_call(CodeGenerator* codegen, const char* callee, IRValue** args, int count, const IRValue* dest) {
+    const RegisterFile* file = regalloc_register_file(TARGET_ARM64);
+    if (count > file->argument_count) {
+        codegen_error(codegen, "The ARM64 backend passes at most 8 arguments, all in registers");
+        return false;
+    }
+
+    Arm64Move moves[8];
+    for (int a = 0; a < count; a++) {
+        moves[a].dest = (Arm64Location){ file->arguments[a], 0 };
+        arm64_move_source(codegen, &moves[a], args[a]);
+    }
+    arm64_parallel_move(codegen, moves, count);
+    emit_instruction(codegen, "bl", callee);
+
+    Arm64Location result;
+    if (dest && arm64_location(codegen, dest, &result)) {
+        Arm64Location x0 = { file->return_register, 0 };
+        if (!arm64_same_location(result, x0)) arm64_copy(codegen, result, x0);
+    }
+    return true;
+}
+
+/*
+ * A call to a GPLANG function whose result is returned right away
+ * becomes b after the epilogue, so the callee returns to our caller.
+ * Every argument is in x0-x7, so no stack area has to be shared;
+ * arguments pointing into this frame rule it out.
+ */
+static bool arm64_tail_call(CodeGenerator* codegen, IRInstruction* instruction) {
+    const RegisterFile* file = regalloc_register_file(TARGET_ARM64);
+    IRInstruction* ret = instruction->next;
+    const IRValue* dest = instruction->dest;
+    if (!ret || ret->opcode != IR_RETURN || !ret->src1 || !dest ||
+        ret->src1->type != IR_VALUE_REGISTER || dest->type != IR_VALUE_REGISTER ||
+        ret->src1->reg_id != dest->reg_id || instruction->arg_count > file->argument_count) {
+        return false;
+    }
+    for (int a = 0; a < instruction->arg_count; a++) {
+        const RegisterMapping* mapping = codegen_value_mapping(codegen, instruction->args[a]);
+        if (mapping && mapping->is_stack_address) return false;
+    }
+
+    Arm64Move moves[8];
+    for (int a = 0; a < instruction->arg_count; a++) {
+        moves[a].dest = (Arm64Location){ file->arguments[a], 0 };
+        arm64_move_source(codegen, &moves[a], instruction->args[a]);
+    }
+    arm64_parallel_move(codegen, moves, instruction->arg_count);
+    emit_tail_call_epilogue(codegen, codegen->current_function, instruction->src1->global_name);
+    codegen->tail_return = ret;
+    return true;
+}
+
+// Generate ARM64 instruction; the backend handles integers only and reports anything else
 bool codegen_arm64_instruction(CodeGenerator* codegen, IRInstruction* instruction) {
+    char address[32];
+    char message[160];
+    int dest;
+    
+    if (instruction->dest && codegen_value_kind(codegen, instruction->dest) != VALUE_INT) {
+        codegen_error(codegen, "The ARM64 backend supports integer values only");
+        return false;
+    }
+    
     switch (instruction->opcode) {
         case IR_ADD:
-            emit_instruction(codegen, "add", "x0, x0, x1");
+            arm64_binary(codegen, "add", instruction);
             break;
         case IR_SUB:
-            emit_instruction(codegen, "sub", "x0, x0, x1");
+            arm64_binary(codegen, "sub", instruction);
             break;
         case IR_MUL:
-            emit_instruction(codegen, "mul", "x0, x0, x1");
+            arm64_binary(codegen, "mul", instruction);
             break;
         case IR_DIV:
-            emit_instruction(codegen, "sdiv", "x0, x0, x1");
+            arm64_binary(codegen, "sdiv", instruction);
+            break;
+        case IR_MOD:
+            arm64_remainder(codegen, instruction);
             break;
-        case IR_CONST_INT:
-            emit_instruction(codegen, "mov", "x0, #42");
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+            arm64_compare(codegen, instruction);
             break;
+        case IR_NOT: {
+            const char* value = arm64_source(codegen, instruction->src1, 16);
+            emit_format(codegen, "cmp", "%s, xzr", value);
+            dest = arm64_dest(codegen, instruction->dest);
+            emit_format(codegen, "cset", "%s, eq", get_register_name_arm64(dest));
+            arm64_finish_dest(codegen, instruction->dest, dest);
+            break;
+        }
+        case IR_AND:
+        case IR_OR:
+            arm64_logical(codegen, instruction);
+            break;
+        case IR_CONST_INT: {
+            const RegisterMapping* mapping = codegen_value_mapping(codegen, instruction->dest);
+            if (mapping && mapping->is_constant) break;     // Rematerialized at each use
+            dest = arm64_dest(codegen, instruction->dest);
+            arm64_materialize(codegen, get_register_name_arm64(dest),
+                              codegen_is_int_constant(instruction->src1) ? instruction->src1->constant.int_val : 0);
+            arm64_finish_dest(codegen, instruction->dest, dest);
+            break;
+        }
         case IR_LOAD:
-            emit_instruction(codegen, "ldr", "x0, [x1]");
+            arm64_address(codegen, instruction->src1, address, sizeof(address));
+            dest = arm64_dest(codegen, instruction->dest);
+            emit_format(codegen, "ldr", "%s, %s", get_register_name_arm64(dest), address);
+            arm64_finish_dest(codegen, instruction->dest, dest);
+            break;
+        case IR_STORE: {
+            const char* value = arm64_source(codegen, instruction->src1, 16);
+            emit_format(codegen, "str", "%s, %s", value,
+                        arm64_address(codegen, instruction->src2, address, sizeof(address)));
             break;
-        case IR_STORE:
-            emit_instruction(codegen, "str", "x0, [x1]");
+        }
+        case IR_ALLOCA:
+        case IR_PHI:
+        case IR_NOP:
+            break;  // Frame slots come from the allocator; PHIs are copied on their edges
+        case IR_CALL: {
+            const IRValue* callee = instruction->src1;
+            if (callee && callee->type == IR_VALUE_GLOBAL && strcmp(callee->global_name, "print") == 0 &&
+                instruction->arg_count == 1 && codegen_value_kind(codegen, instruction->args[0]) == VALUE_INT) {
+                if (!arm64_call(codegen, "gp_rt_print_int", instruction->args, 1, instruction->dest)) return false;
+                break;
+            }
+            if (!callee || callee->type != IR_VALUE_GLOBAL ||
+                value_kinds_function_index(codegen->module_kinds, callee->global_name) < 0) {
+                snprintf(message, sizeof(message), "The ARM64 backend cannot call '%s' yet; only GPLANG functions",
+                         callee && callee->type == IR_VALUE_GLOBAL ? callee->global_name : "?");
+                codegen_error(codegen, message);
+                return false;
+            }
+            if (arm64_tail_call(codegen, instruction)) break;
+            if (!arm64_call(codegen, callee->global_name, instruction->args, instruction->arg_count,
+                            instruction->dest)) return false;
             break;
-        case IR_CALL:
-            emit_instruction(codegen, "bl", "printf");
+        }
+        case IR_PRINT:
+            if (!arm64_call(codegen, "gp_rt_print_int", &instruction->src1, instruction->src1 ? 1 : 0,
+                            instruction->dest)) return false;
             break;
-        case IR_RETURN:
-            emit_instruction(codegen, "mov", "x0, #0");
+        case IR_RETURN: {
+            if (instruction == codegen->tail_return) break;     // Left through the tail call's b
+            const char* value = instruction->src1 ? arm64_source(codegen, instruction->src1, 16) : "xzr";
+            if (strcmp(value, "x0") != 0) emit_format(codegen, "mov", "x0, %s", value);
+            emit_function_epilogue(codegen, codegen->current_function);
             break;
+        }
         case IR_JUMP:
-            emit_instruction(codegen, "b", "loop");
+            if (!arm64_jump(codegen, instruction->src1, true)) return false;
             break;
         case IR_BRANCH:
-            emit_instruction(codegen, "cmp", "x0, #0");
-            emit_instruction(codegen, "bne", "true_branch");
+            if (!arm64_branch(codegen, instruction)) return false;
             break;
         default:
-            emit_comment(codegen, "Unsupported instruction");
-            break;
+            snprintf(message, sizeof(message), "The ARM64 backend does not support '%s' yet",
+                     ir_opcode_to_string(instruction->opcode));
+            codegen_error(codegen, message);
+            return false;
     }
-    return true;
+    return !codegen->has_errors;
 }
 
-// Generate RISC-V instruction (placeholder)
+// RISC-V has a register file and frame layout but no instruction selection yet
 bool codegen_riscv64_instruction(CodeGenerator* codegen, IRInstruction* instruction) {
-    emit_comment(codegen, "RISC-V code generation not implemented yet");
-    return true;
+    (void)instruction;
+    codegen_error(codegen, "RISC-V code generation is not implemented yet; use --target x86_64 or arm64");
+    return false;
+}
+
+// Copy text into the function's buffer; returns its offset
+size_t code_buffer_text(CodeBuffer* code, const char* text) {
+    size_t length = strlen(text) + 1;
+    if (code->text_size + length > code->text_capacity) {
+        size_t capacity = code->text_capacity ? code->text_capacity * 2 : 1024;
+        while (capacity < code->text_size + length) capacity *= 2;
+        char* grown = realloc(code->text, capacity);
+        if (!grown) {
+            code->failed = true;
+            return 0;
+        }
+        code->text = grown;
+        code->text_capacity = capacity;
+    }
+    size_t offset = code->text_size;
+    memcpy(code->text + offset, text, length);
+    code->text_size += length;
+    return offset;
+}
+
+static void buffer_line(CodeBuffer* code, CodeLineKind kind, const char* text, const char* operands) {
+    if (code->failed) return;
+    if (code->line_count == code->line_capacity) {
+        int capacity = code->line_capacity ? code->line_capacity * 2 : 64;
+        CodeLine* lines = realloc(code->lines, capacity * sizeof(CodeLine));
+        if (!lines) {
+            code->failed = true;
+            return;
+        }
+        code->lines = lines;
+        code->line_capacity = capacity;
+    }
+    CodeLine* line = &code->lines[code->line_count];
+    line->kind = kind;
+    line->text = code_buffer_text(code, text);
+    line->operands = operands ? code_buffer_text(code, operands) : 0;
+    if (!code->failed) code->line_count++;
+}
+
+static void write_label(CodeGenerator* codegen, const char* label) {
+    if (codegen->encoder) x86_64_encoder_label(codegen->encoder, label, false);
+    if (!codegen->output) return;
+    text_buffer_puts(&codegen->assembly, label);
+    text_buffer_append(&codegen->assembly, ":\n", 2);
+}
+
+static void write_instruction(CodeGenerator* codegen, const char* mnemonic, const char* operands) {
+    if (codegen->encoder) x86_64_encode(codegen->encoder, mnemonic, operands);
+    if (!codegen->output) return;
+    text_buffer_append(&codegen->assembly, "    ", 4);
+    text_buffer_puts(&codegen->assembly, mnemonic);
+    text_buffer_putc(&codegen->assembly, ' ');
+    text_buffer_puts(&codegen->assembly, operands);
+    text_buffer_putc(&codegen->assembly, '\n');
+}
+
+static void write_comment(CodeGenerator* codegen, const char* comment) {
+    if (!codegen->output) return;
+    text_buffer_puts(&codegen->assembly, codegen->target == TARGET_ARM64 ? "    // " : "    # ");
+    text_buffer_puts(&codegen->assembly, comment);
+    text_buffer_putc(&codegen->assembly, '\n');
 }
 
 // Emit label
 void emit_label(CodeGenerator* codegen, const char* label) {
-    fprintf(codegen->output, "%s:\n", label);
+    if (codegen->code) buffer_line(codegen->code, CODE_LABEL, label, NULL);
+    else write_label(codegen, label);
 }
 
 // Emit instruction
 void emit_instruction(CodeGenerator* codegen, const char* mnemonic, const char* operands) {
-    fprintf(codegen->output, "    %s %s\n", mnemonic, operands);
+    if (codegen->code) buffer_line(codegen->code, CODE_INSTRUCTION, mnemonic, operands);
+    else write_instruction(codegen, mnemonic, operands);
 }
 
 // Emit comment
 void emit_comment(CodeGenerator* codegen, const char* comment) {
-    if (codegen->target == TARGET_X86_64) {
-        fprintf(codegen->output, "    # %s\n", comment);
-    } else if (codegen->target == TARGET_ARM64) {
-        fprintf(codegen->output, "    // %s\n", comment);
+    if (codegen->code) buffer_line(codegen->code, CODE_COMMENT, comment, NULL);
+    else write_comment(codegen, comment);
+}
+
+// Reserve a frame slot; returns its offset from the frame pointer
+int allocate_stack_slot(CodeGenerator* codegen, int size) {
+    int align = size >= 16 ? 16 : size >= 8 ? 8 : (size > 0 ? size : 1);
+    codegen->stack_offset = (codegen->stack_offset + size + align - 1) / align * align;
+    if (codegen->stack_offset > codegen->max_stack_size) {
+        codegen->max_stack_size = codegen->stack_offset;
+    }
+    return -codegen->stack_offset;
+}
+
+// Bytes below the frame pointer, kept 16-byte aligned for calls
+static int frame_size(CodeGenerator* codegen) {
+    return (codegen->max_stack_size + 15) & ~15;
+}
+
+// Save or restore the callee-saved registers the allocator handed out
+static void emit_callee_saves(CodeGenerator* codegen, bool store) {
+    for (int reg = 0; reg < 32; reg++) {
+        if (codegen->callee_saved_used & (1u << reg)) {
+            emit_frame_access(codegen, store, reg, codegen->callee_save_offset[reg]);
+        }
     }
 }
 
+// One comment line per function describing its allocation
+static void emit_allocation_summary(CodeGenerator* codegen) {
+    int in_registers = 0, spilled = 0;
+    for (int r = 0; r < codegen->register_map_size; r++) {
+        if (codegen->register_map[r].physical_reg >= 0) in_registers++;
+        if (codegen->register_map[r].is_spilled) spilled++;
+    }
+    
+    char summary[96];
+    snprintf(summary, sizeof(summary), "%d values in registers, %d spilled, %d-byte frame",
+             in_registers, spilled, frame_size(codegen));
+    emit_comment(codegen, summary);
+}
+
 // Emit function prologue
 void emit_function_prologue(CodeGenerator* codegen, IRFunction* function) {
+    int frame = frame_size(codegen);
+    
     if (codegen->target == TARGET_X86_64) {
         emit_instruction(codegen, "pushq", "%rbp");
         emit_instruction(codegen, "movq", "%rsp, %rbp");
-        emit_comment(codegen, "Function prologue");
+        if (frame > 0) emit_format(codegen, "subq", "$%d, %%rsp", frame);
     } else if (codegen->target == TARGET_ARM64) {
         emit_instruction(codegen, "stp", "x29, x30, [sp, #-16]!");
         emit_instruction(codegen, "mov", "x29, sp");
-        emit_comment(codegen, "Function prologue");
+        if (frame > 0 && frame < 4096) {
+            emit_format(codegen, "sub", "sp, sp, #%d", frame);
+        } else if (frame > 0) {
+            arm64_materialize(codegen, "x16", frame);
+            emit_instruction(codegen, "sub", "sp, sp, x16");
+        }
+    } else if (codegen->target == TARGET_RISCV64) {
+        // ra and the caller's s0 sit at -8(s0) and -16(s0), inside the frame
+        emit_instruction(codegen, "addi", "sp, sp, -16");
+        emit_instruction(codegen, "sd", "ra, 8(sp)");
+        emit_instruction(codegen, "sd", "s0, 0(sp)");
+        emit_instruction(codegen, "addi", "s0, sp, 16");
+        if (frame - 16 > 0 && frame - 16 <= 2048) {
+            emit_format(codegen, "addi", "sp, sp, %d", -(frame - 16));
+        } else if (frame - 16 > 0) {
+            emit_format(codegen, "li", "t6, %d", frame - 16);
+            emit_instruction(codegen, "sub", "sp, sp, t6");
+        }
     }
+    emit_callee_saves(codegen, true);
+    emit_comment(codegen, "Function prologue");
 }
 
-// Emit function epilogue
-void emit_function_epilogue(CodeGenerator* codegen, IRFunction* function) {
+// Tear down the frame, then return or, for a tail call, jump to tail_target
+static void emit_frame_exit(CodeGenerator* codegen, const char* tail_target) {
+    emit_comment(codegen, "Function epilogue");
+    emit_callee_saves(codegen, false);
+    
     if (codegen->target == TARGET_X86_64) {
-        emit_comment(codegen, "Function epilogue");
+        if (frame_size(codegen) > 0) emit_instruction(codegen, "movq", "%rbp, %rsp");
         emit_instruction(codegen, "popq", "%rbp");
-        emit_instruction(codegen, "ret", "");
+        emit_instruction(codegen, tail_target ? "jmp" : "ret", tail_target ? tail_target : "");
     } else if (codegen->target == TARGET_ARM64) {
-        emit_comment(codegen, "Function epilogue");
+        if (frame_size(codegen) > 0) emit_instruction(codegen, "mov", "sp, x29");
         emit_instruction(codegen, "ldp", "x29, x30, [sp], #16");
-        emit_instruction(codegen, "ret", "");
+        emit_instruction(codegen, tail_target ? "b" : "ret", tail_target ? tail_target : "");
+    } else if (codegen->target == TARGET_RISCV64) {
+        emit_instruction(codegen, "addi", "sp, s0, -16");
+        emit_instruction(codegen, "ld", "ra, 8(sp)");
+        emit_instruction(codegen, "ld", "s0, 0(sp)");
+        emit_instruction(codegen, "addi", "sp, sp, 16");
+        emit_instruction(codegen, tail_target ? "j" : "ret", tail_target ? tail_target : "");
     }
 }
 
+// Emit function epilogue
+void emit_function_epilogue(CodeGenerator* codegen, IRFunction* function) {
+    emit_frame_exit(codegen, NULL);
+}
+
+// Epilogue of a tail call: the callee returns straight to our caller
+void emit_tail_call_epilogue(CodeGenerator* codegen, IRFunction* function, const char* callee) {
+    emit_frame_exit(codegen, callee);
+}
+
 // Convert target to string
 const char* target_arch_to_string(TargetArch target) {
     switch (target) {
@@ -2,6 +2,10 @@
 #define GPLANG_CODEGEN_H
 
 #include "../ir/ir.h"
+#include "value_kinds.h"
+#include "x86_64_encoder.h"
+#include "text_buffer.h"
+#include "../compiler/thread_pool.h"
 #include <stdio.h>
 
 // Target architectures
@@ -11,23 +15,54 @@ typedef enum {
     TARGET_RISCV64
 } TargetArch;
 
-// Register allocation
+// Register allocation: where a virtual register lives in the current function
 typedef struct {
     int virtual_reg;
-    int physical_reg;
-    bool is_spilled;
-    int spill_offset;
+    int physical_reg;       // Hardware register number, -1 if none
+    bool is_spilled;        // Value lives in the stack slot at spill_offset
+    int spill_offset;       // Frame-pointer-relative slot, 0 if none
+    bool is_stack_address;  // IR_ALLOCA result: the value is the slot's address
+    bool is_constant;       // IR_CONST_INT result: rematerialized at each use
+    long long constant_value;
 } RegisterMapping;
 
+// One line of a function's code, kept until the module is written out
+typedef enum {
+    CODE_LABEL,
+    CODE_INSTRUCTION,
+    CODE_COMMENT
+} CodeLineKind;
+
+typedef struct {
+    CodeLineKind kind;
+    size_t text;            // Label, mnemonic or comment: offset into CodeBuffer.text
+    size_t operands;        // Instruction operands, likewise
+} CodeLine;
+
+// A function's code, buffered so functions can be generated concurrently
+typedef struct {
+    CodeLine* lines;
+    int line_count;
+    int line_capacity;
+    char* text;
+    size_t text_size;
+    size_t text_capacity;
+    bool failed;            // Out of memory: lines were dropped
+} CodeBuffer;
+
 // Code generator
 typedef struct CodeGenerator {
     TargetArch target;
-    FILE* output;
+    FILE* output;                   // Assembly text, NULL when only encoding
+    TextBuffer assembly;            // Text for output, written in one go
+    X86Encoder* encoder;            // x86-64 machine code, NULL when only writing text
     
-    // Register allocation
+    // Register allocation (indexed by virtual register)
     RegisterMapping* register_map;
     int register_map_size;
     int register_map_capacity;
+    uint32_t callee_saved_used;     // Bit per hardware register, saved in the prologue
+    int callee_save_offset[32];
     
     // Stack management
     int stack_offset;
@@ -37,7 +72,25 @@ typedef struct CodeGenerator {
     int next_label_id;
     
     // Current function context
+    IRModule* current_module;
     IRFunction* current_function;
+    IRBasicBlock* current_block;
+    ModuleKinds* module_kinds;
+    const ValueKind* value_kinds;   // Kinds of the current function's registers
+    int* use_counts;                // Operand uses per virtual register
+    IRInstruction* deferred;        // Folded into the next instruction (compare into branch...)
+    IRInstruction* tail_return;     // Return already left through by a tail call's jmp
+    
+    // String literals, emitted to .rodata after the functions
+    char** string_literals;
+    int string_literal_count;
+    int string_literal_capacity;
+    
+    // Parallel function generation
+    thread_pool_t* pool;            // Workers for codegen_generate_module, NULL for serial
+    const struct CodeGenerator* parent;     // Module-wide state of a function worker
+    CodeBuffer* code;               // Lines of the current function, NULL to write straight out
+    int peephole_rewrites;          // Applied by peephole_optimize, summed over the module
     
     // Error handling
     bool has_errors;
@@ -60,6 +113,9 @@ bool codegen_generate_instruction(CodeGenerator* codegen, IRInstruction* instruc
 bool codegen_x86_64_instruction(CodeGenerator* codegen, IRInstruction* instruction);
 bool codegen_arm64_instruction(CodeGenerator* codegen, IRInstruction* instruction);
 bool codegen_riscv64_instruction(CodeGenerator* codegen, IRInstruction* instruction);
+void x86_64_function_entry(CodeGenerator* codegen, IRFunction* function);
+void x86_64_module_literals(CodeGenerator* codegen, IRModule* module);
+void x86_64_module_data(CodeGenerator* codegen);
 
 // Register allocation
 void codegen_allocate_registers(CodeGenerator* codegen, IRFunction* function);
@@ -71,6 +127,14 @@ void emit_label(CodeGenerator* codegen, const char* label);
 void emit_instruction(CodeGenerator* codegen, const char* mnemonic, const char* operands);
 void emit_comment(CodeGenerator* codegen, const char* comment);
 void emit_directive(CodeGenerator* codegen, const char* directive);
+void emit_format(CodeGenerator* codegen, const char* mnemonic, const char* format, ...);
+void emit_operands(CodeGenerator* codegen, const char* mnemonic, const char* first, const char* second);
+const char* codegen_operand(char* buffer, size_t size, const char* prefix, long long value, const char* suffix);
+size_t code_buffer_text(CodeBuffer* code, const char* text);
+const char* codegen_block_label(CodeGenerator* codegen, const char* label, char* buffer, size_t size);
+const RegisterMapping* codegen_value_mapping(CodeGenerator* codegen, const IRValue* value);
+ValueKind codegen_value_kind(CodeGenerator* codegen, const IRValue* value);
+bool codegen_is_int_constant(const IRValue* value);
 
 // Target-specific helpers
 const char* get_register_name_x86_64(int reg_id);
@@ -81,6 +145,7 @@ const char* get_register_name_riscv64(int reg_id);
 int allocate_stack_slot(CodeGenerator* codegen, int size);
 void emit_function_prologue(CodeGenerator* codegen, IRFunction* function);
 void emit_function_epilogue(CodeGenerator* codegen, IRFunction* function);
+void emit_tail_call_epilogue(CodeGenerator* codegen, IRFunction* function, const char* callee);
 
 // Utility functions
 const char* target_arch_to_string(TargetArch target);
@@ -0,0 +1,453 @@
+/*
+ * GPLANG ELF Writer
+ * Executable layout (non-PIE, loaded at 0x400000):
+ *
+ *   R+X  ELF header, program headers, .interp, .hash, .dynsym, .dynstr,
+ *        .rela.dyn, .rodata, .text, _start, one PLT stub per import
+ *   R+W  .dynamic, .got, .bss
+ *
+ * Imports are bound eagerly with R_X86_64_GLOB_DAT relocations into the
+ * GOT, so the PLT stubs are a single indirect jmp each. _start calls
+ * main directly: ld.so has already run libc's initializers by the time
+ * it jumps to the entry point, and exit() flushes stdio afterwards.
+ */
+
+#include "elf_writer.h"
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+extern char* my_strdup(const char* s);
+
+#define ELF_BASE_ADDRESS 0x400000
+#define ELF_PAGE_SIZE 0x1000
+#define ELF_INTERPRETER "/lib64/ld-linux-x86-64.so.2"
+#define PLT_STUB_SIZE 8
+
+static bool elf_fail(X86Encoder* encoder, const char* message, const char* detail) {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "%s%s%s", message, detail ? ": " : "", detail ? detail : "");
+    free(encoder->error);
+    encoder->error = my_strdup(buffer);
+    return false;
+}
+
+static size_t align_up(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+static uint32_t add_string(X86Buffer* table, const char* text) {
+    uint32_t offset = (uint32_t)table->size;
+    x86_64_encoder_emit(table, text, strlen(text) + 1);
+    return offset;
+}
+
+static void put_int32(uint8_t* field, int64_t value) {
+    for (int b = 0; b < 4; b++) field[b] = (uint8_t)(value >> (8 * b));
+}
+
+static bool write_file(X86Encoder* encoder, const char* path, const uint8_t* data, size_t size, bool executable) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return elf_fail(encoder, "Cannot open output file", path);
+    bool ok = fwrite(data, 1, size, file) == size;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) return elf_fail(encoder, "Cannot write output file", path);
+
+    if (executable) {
+        mode_t mask = umask(0);
+        umask(mask);
+        chmod(path, 0777 & ~mask);
+    }
+    return true;
+}
+
+static bool is_function(const X86Symbol* symbol) {
+    return symbol->section == X86_SECTION_TEXT && symbol->name[0] != '.';
+}
+
+// Distance to the next function in .text, for st_size
+static size_t function_size(const X86Encoder* encoder, const X86Symbol* function) {
+    size_t end = encoder->text.size;
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        const X86Symbol* other = &encoder->symbols[i];
+        if (is_function(other) && other->offset > function->offset && other->offset < end) end = other->offset;
+    }
+    return end - function->offset;
+}
+
+/*
+ * Relocatable object: .text, .rodata and .bss with their symbols, and
+ * .rela.text for references to data and to external functions. Block
+ * labels stay out of the symbol table, as with the system assembler.
+ */
+bool elf_write_object(X86Encoder* encoder, const char* path) {
+    enum { SECTION_TEXT = 1, SECTION_RODATA, SECTION_BSS, SECTION_SYMTAB, SECTION_STRTAB,
+           SECTION_RELA, SECTION_NOTE, SECTION_SHSTRTAB, SECTION_COUNT };
+    static const uint16_t section_index[] = {
+        [X86_SECTION_TEXT] = SECTION_TEXT, [X86_SECTION_RODATA] = SECTION_RODATA, [X86_SECTION_BSS] = SECTION_BSS
+    };
+
+    X86Buffer strtab = { 0 }, shstrtab = { 0 }, symtab = { 0 }, rela = { 0 }, image = { 0 };
+    int* symbol_index = calloc(encoder->symbol_count ? encoder->symbol_count : 1, sizeof(int));
+    bool ok = symbol_index != NULL;
+    add_string(&strtab, "");
+
+    // Null symbol and one per section, then locals, then globals (ELF requires that order)
+    Elf64_Sym symbol = { 0 };
+    x86_64_encoder_emit(&symtab, &symbol, sizeof(symbol));
+    for (int s = SECTION_TEXT; s <= SECTION_BSS; s++) {
+        symbol.st_info = ELF64_ST_INFO(STB_LOCAL, STT_SECTION);
+        symbol.st_shndx = (uint16_t)s;
+        x86_64_encoder_emit(&symtab, &symbol, sizeof(symbol));
+    }
+    int count = 1 + SECTION_BSS, first_global = 0;
+    for (int pass = 0; ok && pass < 2; pass++) {
+        bool globals = pass == 1;
+        if (globals) first_global = count;
+        for (int i = 0; i < encoder->symbol_count; i++) {
+            const X86Symbol* source = &encoder->symbols[i];
+            bool global = source->global || source->section == X86_SECTION_UNDEFINED;
+            if (global != globals || source->name[0] == '.') continue;
+
+            memset(&symbol, 0, sizeof(symbol));
+            symbol.st_name = add_string(&strtab, source->name);
+            symbol.st_value = source->offset;
+            if (source->section == X86_SECTION_UNDEFINED) {
+                symbol.st_info = ELF64_ST_INFO(STB_GLOBAL, STT_NOTYPE);
+            } else {
+                bool function = is_function(source);
+                symbol.st_info = ELF64_ST_INFO(global ? STB_GLOBAL : STB_LOCAL, function ? STT_FUNC : STT_OBJECT);
+                symbol.st_shndx = section_index[source->section];
+                symbol.st_size = function ? function_size(encoder, source) : source->size;
+            }
+            x86_64_encoder_emit(&symtab, &symbol, sizeof(symbol));
+            symbol_index[i] = count++;
+        }
+    }
+
+    // Data references go through the section symbol, calls to externals through the PLT
+    for (int f = 0; ok && f < encoder->fixup_count; f++) {
+        const X86Fixup* fixup = &encoder->fixups[f];
+        const X86Symbol* target = &encoder->symbols[fixup->symbol];
+        Elf64_Rela entry = { 0 };
+        entry.r_offset = fixup->offset;
+        if (target->section == X86_SECTION_UNDEFINED) {
+            entry.r_info = ELF64_R_INFO(symbol_index[fixup->symbol], fixup->call ? R_X86_64_PLT32 : R_X86_64_PC32);
+            entry.r_addend = fixup->addend;
+        } else {
+            entry.r_info = ELF64_R_INFO(section_index[target->section], R_X86_64_PC32);
+            entry.r_addend = fixup->addend + (int64_t)target->offset;
+        }
+        x86_64_encoder_emit(&rela, &entry, sizeof(entry));
+    }
+
+    static const char* names[SECTION_COUNT] = {
+        "", ".text", ".rodata", ".bss", ".symtab", ".strtab", ".rela.text", ".note.GNU-stack", ".shstrtab"
+    };
+    uint32_t name_offsets[SECTION_COUNT];
+    for (int s = 0; s < SECTION_COUNT; s++) name_offsets[s] = add_string(&shstrtab, names[s]);
+
+    Elf64_Shdr sections[SECTION_COUNT];
+    memset(sections, 0, sizeof(sections));
+    x86_64_encoder_emit(&image, &(Elf64_Ehdr){ 0 }, sizeof(Elf64_Ehdr));
+
+    const X86Buffer* contents[SECTION_COUNT] = {
+        [SECTION_TEXT] = &encoder->text, [SECTION_RODATA] = &encoder->rodata, [SECTION_SYMTAB] = &symtab,
+        [SECTION_STRTAB] = &strtab, [SECTION_RELA] = &rela, [SECTION_SHSTRTAB] = &shstrtab
+    };
+    for (int s = 1; s < SECTION_COUNT; s++) {
+        Elf64_Shdr* section = &sections[s];
+        section->sh_name = name_offsets[s];
+        section->sh_type = SHT_PROGBITS;
+        section->sh_addralign = 1;
+        if (contents[s]) {
+            x86_64_encoder_align(&image, 16, 0);
+            section->sh_offset = image.size;
+            section->sh_size = contents[s]->size;
+            if (contents[s]->size) x86_64_encoder_emit(&image, contents[s]->data, contents[s]->size);
+        } else {
+            section->sh_offset = image.size;
+        }
+    }
+    sections[SECTION_TEXT].sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+    sections[SECTION_TEXT].sh_addralign = 16;
+    sections[SECTION_RODATA].sh_flags = SHF_ALLOC;
+    sections[SECTION_BSS].sh_type = SHT_NOBITS;
+    sections[SECTION_BSS].sh_flags = SHF_ALLOC | SHF_WRITE;
+    sections[SECTION_BSS].sh_size = encoder->bss_size;
+    sections[SECTION_BSS].sh_addralign = 8;
+    sections[SECTION_SYMTAB].sh_type = SHT_SYMTAB;
+    sections[SECTION_SYMTAB].sh_link = SECTION_STRTAB;
+    sections[SECTION_SYMTAB].sh_info = (uint32_t)first_global;
+    sections[SECTION_SYMTAB].sh_entsize = sizeof(Elf64_Sym);
+    sections[SECTION_SYMTAB].sh_addralign = 8;
+    sections[SECTION_STRTAB].sh_type = SHT_STRTAB;
+    sections[SECTION_RELA].sh_type = SHT_RELA;
+    sections[SECTION_RELA].sh_flags = SHF_INFO_LINK;
+    sections[SECTION_RELA].sh_link = SECTION_SYMTAB;
+    sections[SECTION_RELA].sh_info = SECTION_TEXT;
+    sections[SECTION_RELA].sh_entsize = sizeof(Elf64_Rela);
+    sections[SECTION_RELA].sh_addralign = 8;
+    sections[SECTION_SHSTRTAB].sh_type = SHT_STRTAB;
+
+    x86_64_encoder_align(&image, 8, 0);
+    size_t section_headers = image.size;
+    x86_64_encoder_emit(&image, sections, sizeof(sections));
+
+    ok = ok && !strtab.failed && !shstrtab.failed && !symtab.failed && !rela.failed && !image.failed;
+    if (ok) {
+        Elf64_Ehdr* header = (Elf64_Ehdr*)image.data;
+        memcpy(header->e_ident, ELFMAG, SELFMAG);
+        header->e_ident[EI_CLASS] = ELFCLASS64;
+        header->e_ident[EI_DATA] = ELFDATA2LSB;
+        header->e_ident[EI_VERSION] = EV_CURRENT;
+        header->e_ident[EI_OSABI] = ELFOSABI_SYSV;
+        header->e_type = ET_REL;
+        header->e_machine = EM_X86_64;
+        header->e_version = EV_CURRENT;
+        header->e_shoff = section_headers;
+        header->e_ehsize = sizeof(Elf64_Ehdr);
+        header->e_shentsize = sizeof(Elf64_Shdr);
+        header->e_shnum = SECTION_COUNT;
+        header->e_shstrndx = SECTION_SHSTRTAB;
+        ok = write_file(encoder, path, image.data, image.size, false);
+    } else {
+        elf_fail(encoder, "Out of memory writing ELF object", NULL);
+    }
+
+    free(symbol_index);
+    free(strtab.data);
+    free(shstrtab.data);
+    free(symtab.data);
+    free(rela.data);
+    free(image.data);
+    return ok;
+}
+
+/*
+ * Executable. _start aligns the stack, calls main and passes its result
+ * to exit (through the GOT) or, with no imports, to the exit_group
+ * system call.
+ */
+bool elf_write_executable(X86Encoder* encoder, const char* path, const char* runtime_dir) {
+    int main_symbol = -1;
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        if (strcmp(encoder->symbols[i].name, "main") == 0 && encoder->symbols[i].section == X86_SECTION_TEXT) {
+            main_symbol = i;
+        }
+    }
+    if (main_symbol < 0) return elf_fail(encoder, "No main function to start the executable with", NULL);
+
+    // Imports: every undefined symbol, plus exit for _start
+    int* imports = malloc((encoder->symbol_count + 1) * sizeof(int));
+    int* import_of = malloc((encoder->symbol_count + 1) * sizeof(int));
+    if (!imports || !import_of) {
+        free(imports);
+        free(import_of);
+        return elf_fail(encoder, "Out of memory writing executable", NULL);
+    }
+    int import_count = 0;
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        import_of[i] = -1;
+        if (encoder->symbols[i].section == X86_SECTION_UNDEFINED) {
+            import_of[i] = import_count;
+            imports[import_count++] = i;
+        }
+    }
+    bool dynamic = import_count > 0;
+    int exit_import = -1;
+    if (dynamic) {
+        int known = encoder->symbol_count;
+        int exit_symbol = x86_64_encoder_symbol(encoder, "exit");
+        if (exit_symbol == known) {
+            import_of[exit_symbol] = import_count;
+            imports[import_count++] = exit_symbol;
+        }
+        if (exit_symbol >= 0 && encoder->symbols[exit_symbol].section == X86_SECTION_UNDEFINED) {
+            exit_import = import_of[exit_symbol];
+        }
+        if (exit_import < 0) {
+            free(imports);
+            free(import_of);
+            return elf_fail(encoder, "Cannot import exit from libc", "the program defines its own");
+        }
+    }
+
+    // String and symbol tables for the dynamic linker
+    X86Buffer dynstr = { 0 };
+    add_string(&dynstr, "");
+    uint32_t runtime_name = add_string(&dynstr, ELF_RUNTIME_LIBRARY);
+    uint32_t libc_name = add_string(&dynstr, "libc.so.6");
+    uint32_t runpath = runtime_dir ? add_string(&dynstr, runtime_dir) : 0;
+    uint32_t* import_names = calloc(import_count ? import_count : 1, sizeof(uint32_t));
+    for (int i = 0; import_names && i < import_count; i++) {
+        import_names[i] = add_string(&dynstr, encoder->symbols[imports[i]].name);
+    }
+
+    // Read-only/executable segment
+    int phnum = dynamic ? 6 : 3;
+    size_t offset = sizeof(Elf64_Ehdr) + phnum * sizeof(Elf64_Phdr);
+    size_t interp_offset = offset;
+    if (dynamic) offset += sizeof(ELF_INTERPRETER);
+    int symbol_count = dynamic ? import_count + 1 : 0;
+    size_t hash_offset = align_up(offset, 8);
+    size_t hash_size = dynamic ? (2 + 1 + symbol_count) * sizeof(uint32_t) : 0;
+    size_t dynsym_offset = align_up(hash_offset + hash_size, 8);
+    size_t dynstr_offset = dynsym_offset + symbol_count * sizeof(Elf64_Sym);
+    size_t rela_offset = align_up(dynstr_offset + (dynamic ? dynstr.size : 0), 8);
+    size_t rodata_offset = align_up(rela_offset + (dynamic ? import_count * sizeof(Elf64_Rela) : 0), 16);
+    size_t text_offset = align_up(rodata_offset + encoder->rodata.size, 16);
+    size_t start_offset = text_offset + align_up(encoder->text.size, 16);
+    size_t plt_offset = start_offset + 32;
+    size_t code_end = plt_offset + (dynamic ? import_count * PLT_STUB_SIZE : 0);
+
+    // Read-write segment: .dynamic and .got in the file, .bss after them in memory
+    enum { DYNAMIC_ENTRIES = 13 };
+    size_t data_offset = align_up(code_end, ELF_PAGE_SIZE);
+    size_t got_offset = data_offset + (dynamic ? DYNAMIC_ENTRIES * sizeof(Elf64_Dyn) : 0);
+    size_t data_end = got_offset + (dynamic ? import_count * sizeof(uint64_t) : 0);
+    size_t bss_offset = align_up(data_end, 16);
+    #define ADDRESS(file_offset) ((uint64_t)ELF_BASE_ADDRESS + (file_offset))
+
+    uint8_t* file = calloc(1, data_end);
+    bool ok = file && import_names && !dynstr.failed;
+    if (!ok) {
+        elf_fail(encoder, "Out of memory writing executable", NULL);
+    }
+
+    for (int f = 0; ok && f < encoder->fixup_count; f++) {
+        const X86Fixup* fixup = &encoder->fixups[f];
+        const X86Symbol* target = &encoder->symbols[fixup->symbol];
+        uint64_t address;
+        switch (target->section) {
+            case X86_SECTION_RODATA: address = ADDRESS(rodata_offset) + target->offset; break;
+            case X86_SECTION_BSS: address = ADDRESS(bss_offset) + target->offset; break;
+            case X86_SECTION_TEXT: address = ADDRESS(text_offset) + target->offset; break;
+            default: address = ADDRESS(plt_offset) + import_of[fixup->symbol] * PLT_STUB_SIZE; break;
+        }
+        int64_t value = (int64_t)(address + fixup->addend - ADDRESS(text_offset + fixup->offset));
+        put_int32(encoder->text.data + fixup->offset, value);
+    }
+
+    if (ok) {
+        memcpy(file + rodata_offset, encoder->rodata.data, encoder->rodata.size);
+        memcpy(file + text_offset, encoder->text.data, encoder->text.size);
+
+        // _start: xor %ebp,%ebp; and $-16,%rsp; call main; mov %eax,%edi; then exit
+        uint8_t* start = file + start_offset;
+        static const uint8_t prologue[] = { 0x31, 0xED, 0x48, 0x83, 0xE4, 0xF0, 0xE8, 0, 0, 0, 0, 0x89, 0xC7 };
+        memcpy(start, prologue, sizeof(prologue));
+        put_int32(start + 7, (int64_t)(text_offset + encoder->symbols[main_symbol].offset) -
+                             (int64_t)(start_offset + 11));
+        uint8_t* tail = start + sizeof(prologue);
+        if (dynamic) {
+            // call *exit@GOT(%rip); hlt
+            tail[0] = 0xFF;
+            tail[1] = 0x15;
+            put_int32(tail + 2, (int64_t)(got_offset + exit_import * 8) - (int64_t)(start_offset + sizeof(prologue) + 6));
+            tail[6] = 0xF4;
+        } else {
+            // mov $231,%eax (exit_group); syscall
+            static const uint8_t exit_group[] = { 0xB8, 0xE7, 0, 0, 0, 0x0F, 0x05 };
+            memcpy(tail, exit_group, sizeof(exit_group));
+        }
+
+        for (int i = 0; i < import_count; i++) {
+            // jmp *got[i](%rip), padded with a two-byte nop
+            uint8_t* stub = file + plt_offset + i * PLT_STUB_SIZE;
+            stub[0] = 0xFF;
+            stub[1] = 0x25;
+            put_int32(stub + 2, (int64_t)(got_offset + i * 8) - (int64_t)(plt_offset + i * PLT_STUB_SIZE + 6));
+            stub[6] = 0x66;
+            stub[7] = 0x90;
+        }
+    }
+
+    if (ok && dynamic) {
+        memcpy(file + interp_offset, ELF_INTERPRETER, sizeof(ELF_INTERPRETER));
+
+        // One bucket: the executable defines nothing for others to look up
+        uint32_t* hash = (uint32_t*)(file + hash_offset);
+        hash[0] = 1;
+        hash[1] = (uint32_t)symbol_count;
+
+        Elf64_Sym* symbols = (Elf64_Sym*)(file + dynsym_offset);
+        Elf64_Rela* relocations = (Elf64_Rela*)(file + rela_offset);
+        for (int i = 0; i < import_count; i++) {
+            symbols[i + 1].st_name = import_names[i];
+            symbols[i + 1].st_info = ELF64_ST_INFO(STB_GLOBAL, STT_FUNC);
+            relocations[i].r_offset = ADDRESS(got_offset + i * 8);
+            relocations[i].r_info = ELF64_R_INFO(i + 1, R_X86_64_GLOB_DAT);
+        }
+        memcpy(file + dynstr_offset, dynstr.data, dynstr.size);
+
+        Elf64_Dyn entries[DYNAMIC_ENTRIES] = {
+            { DT_NEEDED, { runtime_name } },
+            { DT_NEEDED, { libc_name } },
+            { runtime_dir ? DT_RUNPATH : DT_DEBUG, { runpath } },
+            { DT_HASH, { ADDRESS(hash_offset) } },
+            { DT_STRTAB, { ADDRESS(dynstr_offset) } },
+            { DT_SYMTAB, { ADDRESS(dynsym_offset) } },
+            { DT_STRSZ, { dynstr.size } },
+            { DT_SYMENT, { sizeof(Elf64_Sym) } },
+            { DT_RELA, { ADDRESS(rela_offset) } },
+            { DT_RELASZ, { import_count * sizeof(Elf64_Rela) } },
+            { DT_RELAENT, { sizeof(Elf64_Rela) } },
+            { DT_DEBUG, { 0 } },
+            { DT_NULL, { 0 } }
+        };
+        memcpy(file + data_offset, entries, sizeof(entries));
+    }
+
+    if (ok) {
+        Elf64_Ehdr* header = (Elf64_Ehdr*)file;
+        memcpy(header->e_ident, ELFMAG, SELFMAG);
+        header->e_ident[EI_CLASS] = ELFCLASS64;
+        header->e_ident[EI_DATA] = ELFDATA2LSB;
+        header->e_ident[EI_VERSION] = EV_CURRENT;
+        header->e_ident[EI_OSABI] = ELFOSABI_SYSV;
+        header->e_type = ET_EXEC;
+        header->e_machine = EM_X86_64;
+        header->e_version = EV_CURRENT;
+        header->e_entry = ADDRESS(start_offset);
+        header->e_phoff = sizeof(Elf64_Ehdr);
+        header->e_ehsize = sizeof(Elf64_Ehdr);
+        header->e_phentsize = sizeof(Elf64_Phdr);
+        header->e_phnum = (uint16_t)phnum;
+        header->e_shentsize = sizeof(Elf64_Shdr);
+
+        Elf64_Phdr* program = (Elf64_Phdr*)(file + sizeof(Elf64_Ehdr));
+        int p = 0;
+        if (dynamic) {
+            program[p++] = (Elf64_Phdr){ PT_PHDR, PF_R, sizeof(Elf64_Ehdr), ADDRESS(sizeof(Elf64_Ehdr)),
+                                         ADDRESS(sizeof(Elf64_Ehdr)), phnum * sizeof(Elf64_Phdr),
+                                         phnum * sizeof(Elf64_Phdr), 8 };
+            program[p++] = (Elf64_Phdr){ PT_INTERP, PF_R, interp_offset, ADDRESS(interp_offset),
+                                         ADDRESS(interp_offset), sizeof(ELF_INTERPRETER),
+                                         sizeof(ELF_INTERPRETER), 1 };
+        }
+        program[p++] = (Elf64_Phdr){ PT_LOAD, PF_R | PF_X, 0, ADDRESS(0), ADDRESS(0), code_end, code_end,
+                                     ELF_PAGE_SIZE };
+        program[p++] = (Elf64_Phdr){ PT_LOAD, PF_R | PF_W, data_offset, ADDRESS(data_offset), ADDRESS(data_offset),
+                                     data_end - data_offset, bss_offset + encoder->bss_size - data_offset,
+                                     ELF_PAGE_SIZE };
+        if (dynamic) {
+            program[p++] = (Elf64_Phdr){ PT_DYNAMIC, PF_R | PF_W, data_offset, ADDRESS(data_offset),
+                                         ADDRESS(data_offset), DYNAMIC_ENTRIES * sizeof(Elf64_Dyn),
+                                         DYNAMIC_ENTRIES * sizeof(Elf64_Dyn), 8 };
+        }
+        program[p++] = (Elf64_Phdr){ PT_GNU_STACK, PF_R | PF_W, 0, 0, 0, 0, 0, 16 };
+
+        ok = write_file(encoder, path, file, data_end, true);
+    }
+    #undef ADDRESS
+
+    free(file);
+    free(dynstr.data);
+    free(import_names);
+    free(imports);
+    free(import_of);
+    return ok;
+}
@@ -0,0 +1,24 @@
+/*
+ * GPLANG ELF Writer
+ * Writes the machine code from x86_64_encoder.h as an ELF64 relocatable
+ * object (for linking with other code) or as a ready-to-run executable.
+ * Executables that call into the runtime are dynamically linked against
+ * libgplang_rt.so and libc.so.6 with a GOT filled in at load time, so
+ * no system linker is needed; programs without external calls are
+ * written as static executables.
+ */
+
+#ifndef GPLANG_ELF_WRITER_H
+#define GPLANG_ELF_WRITER_H
+
+#include "x86_64_encoder.h"
+
+#define ELF_RUNTIME_LIBRARY "libgplang_rt.so"
+
+// Function declarations
+
+// Both report failures through encoder->error
+bool elf_write_object(X86Encoder* encoder, const char* path);
+bool elf_write_executable(X86Encoder* encoder, const char* path, const char* runtime_dir);
+
+#endif // GPLANG_ELF_WRITER_H
@@ -0,0 +1,183 @@
+/*
+ * GPLANG JIT
+ * Memory layout, one anonymous mapping in three page-aligned parts so
+ * every rel32 field reaches its target:
+ *
+ *   R+X  .text, then one stub per import: jmp *slot(%rip)
+ *   R    .rodata, then the import slots (absolute addresses)
+ *   R+W  .bss
+ *
+ * The stubs keep calls to the runtime, which lives in the compiler
+ * binary and may be further than 2 GB away, within rel32 range.
+ */
+
+#define _GNU_SOURCE
+
+#include "jit.h"
+#include "../runtime/gp_runtime.h"
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+extern char* my_strdup(const char* s);
+
+#define JIT_STUB_SIZE 8
+
+struct JITModule {
+    uint8_t* memory;
+    size_t size;
+    int (*main)(void);
+};
+
+// Runtime entry points the backend calls, bound without a dynamic loader
+static const struct { const char* name; void* address; } runtime_symbols[] = {
+    { "gp_rt_print_int", (void*)gp_rt_print_int },
+    { "gp_rt_print_float", (void*)gp_rt_print_float },
+    { "gp_rt_print_string", (void*)gp_rt_print_string },
+    { "gp_rt_str_int", (void*)gp_rt_str_int },
+    { "gp_rt_str_float", (void*)gp_rt_str_float },
+    { "gp_rt_int_from_float", (void*)gp_rt_int_from_float },
+    { "gp_rt_int_from_string", (void*)gp_rt_int_from_string },
+    { "gp_rt_float_from_int", (void*)gp_rt_float_from_int },
+    { "gp_rt_float_from_string", (void*)gp_rt_float_from_string },
+    { "gp_rt_string_length", (void*)gp_rt_string_length },
+    { "gp_rt_string_concat", (void*)gp_rt_string_concat },
+    { "gp_rt_concat_values", (void*)gp_rt_concat_values },
+    { "gp_rt_compare_values", (void*)gp_rt_compare_values },
+    { "gp_rt_time_now", (void*)gp_rt_time_now },
+    { "gp_rt_time_seconds", (void*)gp_rt_time_seconds },
+    { "gp_rt_time_milliseconds", (void*)gp_rt_time_milliseconds },
+    { "gp_rt_float_mod", (void*)gp_rt_float_mod },
+    { "gp_rt_profile_open", (void*)gp_rt_profile_open },
+    { "gp_rt_profile_count", (void*)gp_rt_profile_count },
+    { "gp_rt_profile_close", (void*)gp_rt_profile_close }
+};
+
+static bool jit_fail(X86Encoder* encoder, const char* message, const char* detail) {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "%s%s%s", message, detail ? ": " : "", detail ? detail : "");
+    free(encoder->error);
+    encoder->error = my_strdup(buffer);
+    return false;
+}
+
+static size_t align_up(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+// The runtime table first, then anything else this process can see (libc)
+static void* resolve_import(const char* name) {
+    for (size_t i = 0; i < sizeof(runtime_symbols) / sizeof(runtime_symbols[0]); i++) {
+        if (strcmp(runtime_symbols[i].name, name) == 0) return runtime_symbols[i].address;
+    }
+    return dlsym(RTLD_DEFAULT, name);
+}
+
+JITModule* jit_load(X86Encoder* encoder) {
+    int main_symbol = -1;
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        if (strcmp(encoder->symbols[i].name, "main") == 0 && encoder->symbols[i].section == X86_SECTION_TEXT) {
+            main_symbol = i;
+        }
+    }
+    if (main_symbol < 0) {
+        jit_fail(encoder, "No main function to run", NULL);
+        return NULL;
+    }
+
+    int* import_of = malloc((encoder->symbol_count ? encoder->symbol_count : 1) * sizeof(int));
+    if (!import_of) {
+        jit_fail(encoder, "Out of memory loading program", NULL);
+        return NULL;
+    }
+    int import_count = 0;
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        import_of[i] = encoder->symbols[i].section == X86_SECTION_UNDEFINED ? import_count++ : -1;
+    }
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t stub_offset = align_up(encoder->text.size, 16);
+    size_t rodata_offset = align_up(stub_offset + import_count * JIT_STUB_SIZE, page);
+    size_t slot_offset = align_up(rodata_offset + encoder->rodata.size, 8);
+    size_t bss_offset = align_up(slot_offset + import_count * sizeof(uint64_t), page);
+    size_t size = align_up(bss_offset + encoder->bss_size, page);
+
+    JITModule* module = calloc(1, sizeof(JITModule));
+    uint8_t* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (!module || memory == MAP_FAILED) {
+        free(module);
+        free(import_of);
+        if (memory != MAP_FAILED) munmap(memory, size);
+        jit_fail(encoder, "Cannot map memory for program", NULL);
+        return NULL;
+    }
+    module->memory = memory;
+    module->size = size;
+
+    memcpy(memory, encoder->text.data, encoder->text.size);
+    if (encoder->rodata.size) memcpy(memory + rodata_offset, encoder->rodata.data, encoder->rodata.size);
+
+    bool ok = true;
+    for (int i = 0; ok && i < encoder->symbol_count; i++) {
+        if (import_of[i] < 0) continue;
+        void* address = resolve_import(encoder->symbols[i].name);
+        if (!address) {
+            ok = jit_fail(encoder, "Undefined function", encoder->symbols[i].name);
+            break;
+        }
+        size_t slot = slot_offset + import_of[i] * sizeof(uint64_t);
+        size_t stub = stub_offset + import_of[i] * JIT_STUB_SIZE;
+        uint64_t value = (uint64_t)(uintptr_t)address;
+        memcpy(memory + slot, &value, sizeof(value));
+
+        // jmp *slot(%rip), padded with a two-byte nop
+        int32_t displacement = (int32_t)((int64_t)slot - (int64_t)(stub + 6));
+        memory[stub] = 0xFF;
+        memory[stub + 1] = 0x25;
+        memcpy(memory + stub + 2, &displacement, sizeof(displacement));
+        memory[stub + 6] = 0x66;
+        memory[stub + 7] = 0x90;
+    }
+
+    for (int f = 0; ok && f < encoder->fixup_count; f++) {
+        const X86Fixup* fixup = &encoder->fixups[f];
+        const X86Symbol* target = &encoder->symbols[fixup->symbol];
+        size_t offset;
+        switch (target->section) {
+            case X86_SECTION_RODATA: offset = rodata_offset + target->offset; break;
+            case X86_SECTION_BSS: offset = bss_offset + target->offset; break;
+            case X86_SECTION_TEXT: offset = target->offset; break;
+            default: offset = stub_offset + import_of[fixup->symbol] * JIT_STUB_SIZE; break;
+        }
+        int32_t value = (int32_t)((int64_t)offset + fixup->addend - (int64_t)fixup->offset);
+        memcpy(memory + fixup->offset, &value, sizeof(value));
+    }
+    free(import_of);
+
+    if (ok && (mprotect(memory, rodata_offset, PROT_READ | PROT_EXEC) != 0 ||
+               mprotect(memory + rodata_offset, bss_offset - rodata_offset, PROT_READ) != 0)) {
+        ok = jit_fail(encoder, "Cannot make program memory executable", NULL);
+    }
+    if (!ok) {
+        jit_destroy(module);
+        return NULL;
+    }
+
+    module->main = (int (*)(void))(void*)(memory + encoder->symbols[main_symbol].offset);
+    return module;
+}
+
+void jit_destroy(JITModule* module) {
+    if (!module) return;
+    munmap(module->memory, module->size);
+    free(module);
+}
+
+int jit_run_main(JITModule* module) {
+    int status = module->main();
+    fflush(stdout);
+    return status;
+}
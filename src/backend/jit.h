@@ -0,0 +1,25 @@
+/*
+ * GPLANG JIT
+ * Loads the machine code from x86_64_encoder.h into executable memory
+ * in this process, for `gplang --run`. Calls to the runtime are bound
+ * to the compiler's own copy of src/runtime, so nothing is written to
+ * disk and no process is started.
+ */
+
+#ifndef GPLANG_JIT_H
+#define GPLANG_JIT_H
+
+#include "x86_64_encoder.h"
+
+typedef struct JITModule JITModule;
+
+// Function declarations
+
+// Reports failures through encoder->error
+JITModule* jit_load(X86Encoder* encoder);
+void jit_destroy(JITModule* module);
+
+// Runs the program's main and returns its exit status
+int jit_run_main(JITModule* module);
+
+#endif // GPLANG_JIT_H
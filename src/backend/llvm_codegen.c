@@ -1,404 +1,2215 @@
 /*
  * GPLANG LLVM IR Code Generator
  * Translates AST to LLVM IR for high performance execution
+ *
+ * Values are typed with the semantic analyzer's type kinds: integers are
+ * i64, floats double, booleans i1 and strings i8*. The analyzer does not
+ * record expression types yet, so the generator infers them itself: a
+ * forward pass over the whole module, repeated until nothing changes,
+ * promotes every local, global, parameter and return type along
+ * bool -> int -> float -> string (the order the native backend's value
+ * kinds use). Builtins call the same runtime (gp_runtime.h) as the
+ * native backend, so both link against libgplang_rt.
+ *
+ * Loops over range() get real bounds and step, nsw induction updates and
+ * !llvm.loop metadata; those the native vectorizer would take also ask
+ * `opt -O3` to vectorize them. Pointers are written in the typed (i8*)
+ * syntax that LLVM 14-16 accept.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <assert.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include "llvm_codegen.h"
+#include "text_buffer.h"
 #include "../frontend/parser.h"
+#include "../frontend/semantic.h"
 
-// LLVM Code generator state
+extern char* my_strdup(const char* s);
+
+#define LLVM_VALUE_SIZE 192
+#define LLVM_INIT_FUNCTION "__init"
+
+// Runtime kind numbers for gp_rt_concat_values/gp_rt_compare_values (GP_KIND_*)
+#define LLVM_KIND_INT 0
+#define LLVM_KIND_FLOAT 1
+#define LLVM_KIND_STRING 2
+
+typedef struct {
+    const char* name;
+    const char* symbol;             // IR name: name, or name.N for a shadowing local
+    ast_node_t* declaration;        // The var, for or parameter node of a local
+    type_kind_t type;
+} LLVMVariable;
+
+typedef struct {
+    LLVMVariable* items;
+    int count;
+    int capacity;
+} LLVMScope;
+
+typedef struct {
+    const char* name;
+    ast_node_t* node;               // NULL for __init
+    type_kind_t return_type;
+    bool return_annotated;
+    type_kind_t* params;
+    bool* param_annotated;
+    int param_count;
+    LLVMScope locals;
+    bool impure;                    // Prints or writes globals, directly or through calls
+} LLVMFunction;
+
+// An SSA register or constant with its type
 typedef struct {
-    FILE* output_file;
+    type_kind_t type;
+    char text[LLVM_VALUE_SIZE];
+} LLVMValue;
+
+struct LLVMCodegen {
+    FILE* output;
+    TextBuffer text;                // The module, written to output in one go
+
+    LLVMFunction* functions;
+    int function_count;
+    LLVMScope globals;
+    ast_node_t** init_statements;   // Top-level statements, run by __init
+    int init_count;
+    bool changed;                   // Inference promoted a type this pass
+
+    LLVMFunction* current;
+    int* visible;                   // Indices into current->locals, innermost last
+    int visible_count;
+    int visible_capacity;
     int temp_counter;
     int label_counter;
-    int indent_level;
-    char current_function[256];
-    int in_parallel_loop;
-} llvm_codegen_t;
+    int loop_count;
+    bool terminated;                // Current block already ends in br/ret
+    char block[32];                 // Label of the current block, for PHI edges
+
+    char** strings;
+    int string_count;
+    int string_capacity;
+
+    TextBuffer outlined;            // Parallel loop bodies, written after the current function
+    TextBuffer loop_metadata;       // The !llvm.loop node of each loop so far
+
+    char* error;
+};
+
+static LLVMCodegen* g_default_codegen = NULL;
+
+// Forward declarations
+static LLVMValue generate_expression(LLVMCodegen* g, ast_node_t* node);
+static void generate_statement(LLVMCodegen* g, ast_node_t* node);
+static type_kind_t expression_type(LLVMCodegen* g, ast_node_t* node);
+static void infer_statement(LLVMCodegen* g, ast_node_t* node);
+static void find_side_effects(LLVMCodegen* g);
+static void generate_block(LLVMCodegen* g, ast_node_t* block);
+
+static void llvm_error(LLVMCodegen* g, const char* format, ...) {
+    if (g->error) return;   // Keep the first error
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    g->error = my_strdup(message);
+}
+
+static void emit_line(LLVMCodegen* g, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    text_buffer_append(&g->text, "  ", 2);
+    text_buffer_vprintf(&g->text, format, args);
+    text_buffer_putc(&g->text, '\n');
+    va_end(args);
+}
+
+static void emit_label(LLVMCodegen* g, const char* label) {
+    text_buffer_putc(&g->text, '\n');
+    text_buffer_puts(&g->text, label);
+    text_buffer_append(&g->text, ":\n", 2);
+    g->terminated = false;
+    snprintf(g->block, sizeof(g->block), "%s", label);
+}
+
+static void new_temp(LLVMCodegen* g, LLVMValue* value, type_kind_t type) {
+    value->type = type;
+    snprintf(value->text, sizeof(value->text), "%%t%d", g->temp_counter++);
+}
+
+static void new_label(LLVMCodegen* g, char* label, size_t size, const char* prefix, int id) {
+    snprintf(label, size, "%s.%d", prefix, id);
+}
+
+static LLVMValue constant(type_kind_t type, const char* text) {
+    LLVMValue value;
+    value.type = type;
+    snprintf(value.text, sizeof(value.text), "%s", text);
+    return value;
+}
+
+/*
+ * Types
+ */
+static const char* llvm_type(type_kind_t type) {
+    switch (type) {
+        case TYPE_BOOL: return "i1";
+        case TYPE_FLOAT64: return "double";
+        case TYPE_STRING: return "i8*";
+        case TYPE_VOID: return "void";
+        default: return "i64";
+    }
+}
+
+static const char* zero_value(type_kind_t type) {
+    switch (type) {
+        case TYPE_BOOL: return "false";
+        case TYPE_FLOAT64: return "0.0";
+        case TYPE_STRING: return "null";
+        default: return "0";
+    }
+}
+
+static int type_rank(type_kind_t type) {
+    switch (type) {
+        case TYPE_VOID: return 0;
+        case TYPE_BOOL: return 1;
+        case TYPE_FLOAT64: return 3;
+        case TYPE_STRING: return 4;
+        default: return 2;
+    }
+}
+
+static type_kind_t join_types(type_kind_t a, type_kind_t b) {
+    return type_rank(a) >= type_rank(b) ? a : b;
+}
+
+// Numeric result of an arithmetic operator: float if either side is
+static type_kind_t numeric_type(type_kind_t a, type_kind_t b) {
+    return a == TYPE_FLOAT64 || b == TYPE_FLOAT64 ? TYPE_FLOAT64 : TYPE_INT64;
+}
+
+// Type named by an annotation; false for names without a scalar lowering
+static bool annotation_type(ast_node_t* type_node, type_kind_t* type) {
+    if (!type_node || type_node->type != AST_IDENTIFIER || !type_node->data.identifier.name) return false;
+    const char* name = type_node->data.identifier.name;
+
+    static const struct { const char* name; type_kind_t type; } names[] = {
+        { "i8", TYPE_INT64 }, { "i16", TYPE_INT64 }, { "i32", TYPE_INT64 }, { "i64", TYPE_INT64 },
+        { "u8", TYPE_INT64 }, { "u16", TYPE_INT64 }, { "u32", TYPE_INT64 }, { "u64", TYPE_INT64 },
+        { "int", TYPE_INT64 }, { "f32", TYPE_FLOAT64 }, { "f64", TYPE_FLOAT64 }, { "float", TYPE_FLOAT64 },
+        { "bool", TYPE_BOOL }, { "string", TYPE_STRING }, { "str", TYPE_STRING }, { "void", TYPE_VOID }
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if (strcmp(names[i].name, name) == 0) {
+            *type = names[i].type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void promote(LLVMCodegen* g, type_kind_t* slot, type_kind_t type) {
+    type_kind_t joined = join_types(*slot, type);
+    if (joined != *slot) {
+        *slot = joined;
+        g->changed = true;
+    }
+}
+
+/*
+ * Variables and functions
+ */
+static LLVMVariable* scope_find(LLVMScope* scope, const char* name) {
+    for (int i = 0; name && i < scope->count; i++) {
+        if (strcmp(scope->items[i].name, name) == 0) return &scope->items[i];
+    }
+    return NULL;
+}
+
+static LLVMVariable* scope_add(LLVMCodegen* g, LLVMScope* scope, const char* name) {
+    LLVMVariable* existing = scope_find(scope, name);
+    if (existing || !name) return existing;
+
+    if (scope->count == scope->capacity) {
+        int capacity = scope->capacity ? scope->capacity * 2 : 16;
+        LLVMVariable* items = realloc(scope->items, capacity * sizeof(LLVMVariable));
+        if (!items) {
+            llvm_error(g, "Out of memory for variables");
+            return NULL;
+        }
+        scope->items = items;
+        scope->capacity = capacity;
+    }
+    LLVMVariable* variable = &scope->items[scope->count++];
+    variable->name = name;
+    variable->symbol = name;
+    variable->declaration = NULL;
+    variable->type = TYPE_VOID;
+    g->changed = true;
+    return variable;
+}
+
+static bool in_init(const LLVMCodegen* g) {
+    return g->current && !g->current->node;
+}
+
+/*
+ * Locals are block scoped, as in irgen: a declaration is visible from
+ * where it runs to the end of its block, and one in an inner block
+ * shadows the outer name. Every declaration node has its own slot in
+ * locals; the walkers below push it on visible as they pass it and drop
+ * back to a saved count when the block ends.
+ */
+static int enter_scope(const LLVMCodegen* g) {
+    return g->visible_count;
+}
+
+static void leave_scope(LLVMCodegen* g, int scope) {
+    g->visible_count = scope;
+}
+
+// Position of name on the visible stack, or -1
+static int visible_position(const LLVMCodegen* g, const char* name) {
+    for (int i = g->visible_count - 1; name && i >= 0; i--) {
+        if (strcmp(g->current->locals.items[g->visible[i]].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// A name in scope: local first, then module global
+static LLVMVariable* lookup_variable(LLVMCodegen* g, const char* name, bool* global) {
+    int position = g->current && !in_init(g) ? visible_position(g, name) : -1;
+    *global = position < 0;
+    return position < 0 ? scope_find(&g->globals, name) : &g->current->locals.items[g->visible[position]];
+}
+
+static LLVMVariable* find_declared(LLVMFunction* function, ast_node_t* declaration) {
+    for (int i = 0; i < function->locals.count; i++) {
+        if (function->locals.items[i].declaration == declaration) return &function->locals.items[i];
+    }
+    return NULL;
+}
+
+// The local declared by node, made visible; top-level code declares globals
+static LLVMVariable* declare_variable(LLVMCodegen* g, ast_node_t* node, const char* name, bool* global) {
+    *global = in_init(g);
+    if (*global) return scope_add(g, &g->globals, name);
+    if (!name) return NULL;
+
+    LLVMFunction* function = g->current;
+    LLVMVariable* variable = find_declared(function, node);
+    if (!variable) {
+        int shadowed = 0;
+        for (int i = 0; i < function->locals.count; i++) {
+            if (strcmp(function->locals.items[i].name, name) == 0) shadowed++;
+        }
+        char* symbol = NULL;
+        if (shadowed > 0) {
+            size_t size = strlen(name) + 16;
+            symbol = malloc(size);
+            if (!symbol) {
+                llvm_error(g, "Out of memory for variables");
+                return NULL;
+            }
+            snprintf(symbol, size, "%s.%d", name, shadowed);
+        }
+
+        // scope_add matches by name, so append the slot directly
+        if (function->locals.count == function->locals.capacity) {
+            int capacity = function->locals.capacity ? function->locals.capacity * 2 : 16;
+            LLVMVariable* items = realloc(function->locals.items, capacity * sizeof(LLVMVariable));
+            if (!items) {
+                free(symbol);
+                llvm_error(g, "Out of memory for variables");
+                return NULL;
+            }
+            function->locals.items = items;
+            function->locals.capacity = capacity;
+        }
+        variable = &function->locals.items[function->locals.count++];
+        variable->name = name;
+        variable->symbol = symbol ? symbol : name;
+        variable->declaration = node;
+        variable->type = TYPE_VOID;
+        g->changed = true;
+    }
+
+    if (g->visible_count == g->visible_capacity) {
+        int capacity = g->visible_capacity ? g->visible_capacity * 2 : 16;
+        int* visible = realloc(g->visible, capacity * sizeof(int));
+        if (!visible) {
+            llvm_error(g, "Out of memory for variables");
+            return NULL;
+        }
+        g->visible = visible;
+        g->visible_capacity = capacity;
+    }
+    g->visible[g->visible_count++] = (int)(variable - function->locals.items);
+    return variable;
+}
+
+// Start walking function: only its parameters are in scope
+static void enter_function(LLVMCodegen* g, LLVMFunction* function) {
+    g->current = function;
+    g->visible_count = 0;
+    ast_node_t* params = function->node ? function->node->data.function.parameters : NULL;
+    for (int i = 0; i < function->param_count; i++) {
+        bool global;
+        declare_variable(g, params->children[i], params->children[i]->data.variable.name, &global);
+    }
+}
+
+static LLVMFunction* find_function(LLVMCodegen* g, const char* name) {
+    for (int i = 0; name && i < g->function_count; i++) {
+        if (strcmp(g->functions[i].name, name) == 0) return &g->functions[i];
+    }
+    return NULL;
+}
+
+static bool is_main(const LLVMFunction* function) {
+    return strcmp(function->name, "main") == 0;
+}
+
+static bool is_range_call(ast_node_t* node) {
+    return node && node->type == AST_CALL && node->data.call.callee &&
+           node->data.call.callee->type == AST_IDENTIFIER &&
+           strcmp(node->data.call.callee->data.identifier.name, "range") == 0 &&
+           node->child_count >= 1 && node->child_count <= 3;
+}
+
+static const char* callee_name(ast_node_t* call) {
+    ast_node_t* callee = call->data.call.callee;
+    return callee && callee->type == AST_IDENTIFIER ? callee->data.identifier.name : NULL;
+}
+
+// Time.now(): a member call on a name that is not a variable
+static bool is_time_now(LLVMCodegen* g, ast_node_t* call) {
+    ast_node_t* callee = call->data.call.callee;
+    if (!callee || callee->type != AST_MEMBER || !callee->data.member.object) return false;
+    ast_node_t* object = callee->data.member.object;
+    bool global;
+    return object->type == AST_IDENTIFIER && strcmp(object->data.identifier.name, "Time") == 0 &&
+           strcmp(callee->data.member.name, "now") == 0 &&
+           !lookup_variable(g, object->data.identifier.name, &global);
+}
+
+// x.seconds() / x.milliseconds() on a Time.now() difference
+static const char* time_method(ast_node_t* call) {
+    ast_node_t* callee = call->data.call.callee;
+    if (!callee || callee->type != AST_MEMBER || call->child_count != 0) return NULL;
+    if (strcmp(callee->data.member.name, "seconds") == 0) return "gp_rt_time_seconds";
+    if (strcmp(callee->data.member.name, "milliseconds") == 0) return "gp_rt_time_milliseconds";
+    return NULL;
+}
+
+static const char* math_intrinsic(const char* name) {
+    if (!name) return NULL;
+    if (strcmp(name, "sqrt") == 0) return "llvm.sqrt.f64";
+    if (strcmp(name, "sin") == 0) return "llvm.sin.f64";
+    if (strcmp(name, "cos") == 0) return "llvm.cos.f64";
+    return NULL;
+}
+
+/*
+ * Type inference
+ */
+static type_kind_t binary_type(TokenType op, type_kind_t left, type_kind_t right) {
+    switch (op) {
+        case TOKEN_EQ: case TOKEN_NE: case TOKEN_LT: case TOKEN_LE: case TOKEN_GT: case TOKEN_GE:
+        case TOKEN_AND: case TOKEN_OR:
+            return TYPE_BOOL;
+        case TOKEN_PLUS:
+            if (left == TYPE_STRING || right == TYPE_STRING) return TYPE_STRING;
+            return numeric_type(left, right);
+        case TOKEN_POWER:
+            return TYPE_FLOAT64;
+        default:
+            return numeric_type(left, right);
+    }
+}
+
+static type_kind_t call_type(LLVMCodegen* g, ast_node_t* node) {
+    const char* name = callee_name(node);
+    LLVMFunction* function = find_function(g, name);
+    if (function) return is_main(function) ? TYPE_INT64 : function->return_type;
+
+    if (is_time_now(g, node)) return TYPE_INT64;
+    if (time_method(node)) return TYPE_FLOAT64;
+    if (!name) return TYPE_INT64;
+    if (strcmp(name, "print") == 0) return TYPE_VOID;
+    if (strcmp(name, "str") == 0) return TYPE_STRING;
+    if (strcmp(name, "float") == 0 || math_intrinsic(name)) return TYPE_FLOAT64;
+    return TYPE_INT64;
+}
+
+static type_kind_t expression_type(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return TYPE_VOID;
+
+    switch (node->type) {
+        case AST_NUMBER: {
+            const char* text = node->data.literal.value ? node->data.literal.value : "0";
+            return strpbrk(text, ".eE") && strncmp(text, "0x", 2) != 0 ? TYPE_FLOAT64 : TYPE_INT64;
+        }
+        case AST_STRING:
+            return TYPE_STRING;
+        case AST_BOOLEAN:
+            return TYPE_BOOL;
+        case AST_IDENTIFIER: {
+            bool global;
+            LLVMVariable* variable = lookup_variable(g, node->data.identifier.name, &global);
+            return variable && variable->type != TYPE_VOID ? variable->type : TYPE_INT64;
+        }
+        case AST_BINARY_OP:
+            return binary_type(node->data.binary_op.operator,
+                               expression_type(g, node->data.binary_op.left),
+                               expression_type(g, node->data.binary_op.right));
+        case AST_UNARY_OP:
+            if (node->data.unary_op.operator == TOKEN_NOT) return TYPE_BOOL;
+            return numeric_type(expression_type(g, node->data.unary_op.operand), TYPE_INT64);
+        case AST_CALL:
+            return call_type(g, node);
+        default:
+            return TYPE_INT64;
+    }
+}
+
+// Argument types flow into unannotated parameters of the callee
+static void infer_expression(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_BINARY_OP:
+            infer_expression(g, node->data.binary_op.left);
+            infer_expression(g, node->data.binary_op.right);
+            break;
+        case AST_UNARY_OP:
+            infer_expression(g, node->data.unary_op.operand);
+            break;
+        case AST_CALL: {
+            if (node->data.call.callee && node->data.call.callee->type == AST_MEMBER) {
+                infer_expression(g, node->data.call.callee->data.member.object);
+            }
+            LLVMFunction* function = find_function(g, callee_name(node));
+            for (size_t i = 0; i < node->child_count; i++) {
+                infer_expression(g, node->children[i]);
+                if (function && (int)i < function->param_count && !function->param_annotated[i]) {
+                    promote(g, &function->params[i], expression_type(g, node->children[i]));
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void infer_block(LLVMCodegen* g, ast_node_t* block) {
+    if (!block) return;
+    int scope = enter_scope(g);
+    if (block->type != AST_BLOCK) {
+        infer_statement(g, block);
+    } else {
+        for (size_t i = 0; i < block->child_count; i++) {
+            infer_statement(g, block->children[i]);
+        }
+    }
+    leave_scope(g, scope);
+}
+
+static void infer_statement(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return;
+    bool global;
+
+    switch (node->type) {
+        case AST_VARIABLE: {
+            // The value is typed before the name it may shadow goes out of sight
+            infer_expression(g, node->data.variable.value);
+            type_kind_t type;
+            if (!annotation_type(node->data.variable.type, &type) || type == TYPE_VOID) {
+                type = node->data.variable.value ? expression_type(g, node->data.variable.value) : TYPE_INT64;
+            }
+            LLVMVariable* variable = declare_variable(g, node, node->data.variable.name, &global);
+            if (variable) promote(g, &variable->type, type);
+            break;
+        }
+        case AST_ASSIGN: {
+            ast_node_t* target = node->data.assign.target;
+            infer_expression(g, node->data.assign.value);
+            if (!target || target->type != AST_IDENTIFIER) break;
+
+            LLVMVariable* variable = lookup_variable(g, target->data.identifier.name, &global);
+            if (!variable) variable = scope_add(g, &g->globals, target->data.identifier.name);
+            if (!variable) break;
+            type_kind_t value = expression_type(g, node->data.assign.value);
+            if (node->data.assign.operator != TOKEN_ASSIGN) {
+                value = binary_type(node->data.assign.operator, variable->type, value);
+            }
+            promote(g, &variable->type, value);
+            break;
+        }
+        case AST_RETURN:
+            infer_expression(g, node->data.return_stmt.expression);
+            if (node->data.return_stmt.expression && !g->current->return_annotated) {
+                promote(g, &g->current->return_type, expression_type(g, node->data.return_stmt.expression));
+            }
+            break;
+        case AST_IF:
+            infer_expression(g, node->data.if_stmt.condition);
+            infer_block(g, node->data.if_stmt.then_block);
+            infer_block(g, node->data.if_stmt.else_block);
+            break;
+        case AST_WHILE:
+            infer_expression(g, node->data.while_stmt.condition);
+            infer_block(g, node->data.while_stmt.body);
+            break;
+        case AST_FOR: {
+            ast_node_t* iterable = node->data.for_stmt.iterable;
+            for (size_t i = 0; iterable && i < iterable->child_count; i++) {
+                infer_expression(g, iterable->children[i]);
+            }
+            int scope = enter_scope(g);
+            LLVMVariable* variable = declare_variable(g, node, node->data.for_stmt.variable, &global);
+            if (variable) promote(g, &variable->type, TYPE_INT64);
+            infer_block(g, node->data.for_stmt.body);
+            leave_scope(g, scope);
+            break;
+        }
+        case AST_BLOCK:
+        case AST_UNSAFE_BLOCK:
+            infer_block(g, node);
+            break;
+        case AST_EXPRESSION_STMT:
+            for (size_t i = 0; i < node->child_count; i++) {
+                infer_statement(g, node->children[i]);
+            }
+            break;
+        case AST_IMPORT:
+        case AST_FUNCTION:
+            break;
+        default:
+            infer_expression(g, node);
+            break;
+    }
+}
+
+static void infer_function(LLVMCodegen* g, LLVMFunction* function) {
+    enter_function(g, function);
+    if (!function->node) {
+        for (int i = 0; i < g->init_count; i++) infer_statement(g, g->init_statements[i]);
+        return;
+    }
+
+    for (int i = 0; i < g->visible_count; i++) {
+        promote(g, &function->locals.items[g->visible[i]].type, function->params[i]);
+    }
+    infer_block(g, function->node->data.function.body);
+}
+
+// Collect functions and top-level statements, then infer to a fixed point
+static bool collect_module(LLVMCodegen* g, ast_node_t* root) {
+    int count = 0;
+    for (size_t i = 0; i < root->child_count; i++) {
+        ast_node_t* node = root->children[i];
+        if (!node) continue;
+        if (node->type == AST_FUNCTION) {
+            count++;
+        } else if (node->type != AST_IMPORT) {
+            g->init_count++;
+        }
+    }
+
+    g->functions = calloc(count + 1, sizeof(LLVMFunction));
+    g->init_statements = calloc(g->init_count ? g->init_count : 1, sizeof(ast_node_t*));
+    if (!g->functions || !g->init_statements) {
+        llvm_error(g, "Out of memory for functions");
+        return false;
+    }
+
+    g->init_count = 0;
+    for (size_t i = 0; i < root->child_count; i++) {
+        ast_node_t* node = root->children[i];
+        if (!node || node->type == AST_IMPORT) continue;
+        if (node->type != AST_FUNCTION) {
+            g->init_statements[g->init_count++] = node;
+            continue;
+        }
+        if (!node->data.function.name || find_function(g, node->data.function.name)) continue;
+
+        LLVMFunction* function = &g->functions[g->function_count++];
+        function->name = node->data.function.name;
+        function->node = node;
+        function->return_annotated = annotation_type(node->data.function.return_type, &function->return_type);
+        if (!function->return_annotated) function->return_type = TYPE_VOID;
+
+        ast_node_t* params = node->data.function.parameters;
+        function->param_count = params ? (int)params->child_count : 0;
+        function->params = calloc(function->param_count + 1, sizeof(type_kind_t));
+        function->param_annotated = calloc(function->param_count + 1, sizeof(bool));
+        if (!function->params || !function->param_annotated) {
+            llvm_error(g, "Out of memory for parameters");
+            return false;
+        }
+        for (int p = 0; p < function->param_count; p++) {
+            ast_node_t* param = params->children[p];
+            if (!param || param->type != AST_VARIABLE || !param->data.variable.name) {
+                llvm_error(g, "Unsupported parameter in function '%s'", function->name);
+                return false;
+            }
+            function->param_annotated[p] = annotation_type(param->data.variable.type, &function->params[p]) &&
+                                           function->params[p] != TYPE_VOID;
+            if (!function->param_annotated[p]) function->params[p] = TYPE_VOID;
+        }
+    }
+    if (g->init_count > 0) {
+        LLVMFunction* init = &g->functions[g->function_count++];
+        init->name = LLVM_INIT_FUNCTION;
+        init->return_type = TYPE_VOID;
+        init->return_annotated = true;
+    }
+
+    do {
+        g->changed = false;
+        for (int f = 0; f < g->function_count; f++) infer_function(g, &g->functions[f]);
+    } while (g->changed && !g->error);
+
+    // Parameters nobody passes a value to, and untyped locals, are integers
+    for (int f = 0; f < g->function_count; f++) {
+        LLVMFunction* function = &g->functions[f];
+        for (int p = 0; p < function->param_count; p++) {
+            if (function->params[p] == TYPE_VOID) function->params[p] = TYPE_INT64;
+        }
+        for (int v = 0; v < function->locals.count; v++) {
+            if (function->locals.items[v].type == TYPE_VOID) function->locals.items[v].type = TYPE_INT64;
+        }
+    }
+    for (int v = 0; v < g->globals.count; v++) {
+        if (g->globals.items[v].type == TYPE_VOID) g->globals.items[v].type = TYPE_INT64;
+    }
+    g->current = NULL;
+
+    find_side_effects(g);
+    return !g->error;
+}
+
+/*
+ * Side effects: printing and writing globals. A function has them if its
+ * body does, or if it calls a function that does.
+ */
+static bool block_has_effects(LLVMCodegen* g, ast_node_t* node);
+
+static bool expression_has_effects(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return false;
+
+    switch (node->type) {
+        case AST_BINARY_OP:
+            return expression_has_effects(g, node->data.binary_op.left) ||
+                   expression_has_effects(g, node->data.binary_op.right);
+        case AST_UNARY_OP:
+            return expression_has_effects(g, node->data.unary_op.operand);
+        case AST_CALL: {
+            const char* name = callee_name(node);
+            LLVMFunction* function = find_function(g, name);
+            if ((name && strcmp(name, "print") == 0) || (function && function->impure)) return true;
+            if (node->data.call.callee && node->data.call.callee->type == AST_MEMBER &&
+                expression_has_effects(g, node->data.call.callee->data.member.object)) {
+                return true;
+            }
+            for (size_t i = 0; i < node->child_count; i++) {
+                if (expression_has_effects(g, node->children[i])) return true;
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool block_has_effects(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return false;
+    bool global;
+
+    switch (node->type) {
+        case AST_VARIABLE: {
+            bool effects = expression_has_effects(g, node->data.variable.value);
+            declare_variable(g, node, node->data.variable.name, &global);
+            return effects;
+        }
+        case AST_ASSIGN: {
+            ast_node_t* target = node->data.assign.target;
+            if (!target || target->type != AST_IDENTIFIER ||
+                !lookup_variable(g, target->data.identifier.name, &global) || global) {
+                return true;
+            }
+            return expression_has_effects(g, node->data.assign.value);
+        }
+        case AST_RETURN:
+            return expression_has_effects(g, node->data.return_stmt.expression);
+        case AST_IF:
+            return expression_has_effects(g, node->data.if_stmt.condition) ||
+                   block_has_effects(g, node->data.if_stmt.then_block) ||
+                   block_has_effects(g, node->data.if_stmt.else_block);
+        case AST_WHILE:
+            return expression_has_effects(g, node->data.while_stmt.condition) ||
+                   block_has_effects(g, node->data.while_stmt.body);
+        case AST_FOR: {
+            ast_node_t* iterable = node->data.for_stmt.iterable;
+            for (size_t i = 0; iterable && i < iterable->child_count; i++) {
+                if (expression_has_effects(g, iterable->children[i])) return true;
+            }
+            int scope = enter_scope(g);
+            declare_variable(g, node, node->data.for_stmt.variable, &global);
+            bool effects = block_has_effects(g, node->data.for_stmt.body);
+            leave_scope(g, scope);
+            return effects;
+        }
+        case AST_BLOCK:
+        case AST_UNSAFE_BLOCK:
+        case AST_EXPRESSION_STMT: {
+            int scope = enter_scope(g);
+            bool effects = false;
+            for (size_t i = 0; i < node->child_count && !effects; i++) {
+                effects = block_has_effects(g, node->children[i]);
+            }
+            if (node->type != AST_EXPRESSION_STMT) leave_scope(g, scope);
+            return effects;
+        }
+        case AST_IMPORT:
+        case AST_FUNCTION:
+            return false;
+        default:
+            return expression_has_effects(g, node);
+    }
+}
+
+static void find_side_effects(LLVMCodegen* g) {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int f = 0; f < g->function_count; f++) {
+            LLVMFunction* function = &g->functions[f];
+            if (function->impure) continue;
+
+            enter_function(g, function);
+            if (!function->node || is_main(function) ||
+                block_has_effects(g, function->node->data.function.body)) {
+                function->impure = true;
+                changed = true;
+            }
+        }
+    }
+    g->current = NULL;
+}
+
+/*
+ * Conversions
+ */
+static LLVMValue convert(LLVMCodegen* g, LLVMValue value, type_kind_t to) {
+    if (value.type == to || to == TYPE_VOID) return value;
+    if (value.type == TYPE_VOID) {
+        llvm_error(g, "Value of a call that returns nothing is used");
+        return constant(to, zero_value(to));
+    }
+
+    LLVMValue result;
+    if (to == TYPE_STRING) {
+        bool is_float = value.type == TYPE_FLOAT64;
+        if (value.type == TYPE_BOOL) value = convert(g, value, TYPE_INT64);
+        new_temp(g, &result, TYPE_STRING);
+        emit_line(g, "%s = call i8* @%s(%s %s)", result.text, is_float ? "gp_rt_str_float" : "gp_rt_str_int",
+                  llvm_type(value.type), value.text);
+        return result;
+    }
+    if (value.type == TYPE_STRING) {
+        llvm_error(g, "Cannot use a string as a %s", to == TYPE_FLOAT64 ? "float" : "number");
+        return constant(to, zero_value(to));
+    }
+
+    new_temp(g, &result, to);
+    switch (to) {
+        case TYPE_BOOL:
+            if (value.type == TYPE_FLOAT64) {
+                emit_line(g, "%s = fcmp une double %s, 0.0", result.text, value.text);
+            } else {
+                emit_line(g, "%s = icmp ne i64 %s, 0", result.text, value.text);
+            }
+            break;
+        case TYPE_FLOAT64:
+            emit_line(g, "%s = %s %s %s to double", result.text, value.type == TYPE_BOOL ? "uitofp" : "sitofp",
+                      llvm_type(value.type), value.text);
+            break;
+        default:
+            if (value.type == TYPE_FLOAT64) {
+                emit_line(g, "%s = fptosi double %s to i64", result.text, value.text);
+            } else {
+                emit_line(g, "%s = zext i1 %s to i64", result.text, value.text);
+            }
+            break;
+    }
+    return result;
+}
+
+// Raw 64-bit pattern and GP_KIND_* of a value, for the any-kind runtime calls
+static LLVMValue value_bits(LLVMCodegen* g, LLVMValue value, int* kind) {
+    LLVMValue bits;
+    switch (value.type) {
+        case TYPE_FLOAT64:
+            *kind = LLVM_KIND_FLOAT;
+            new_temp(g, &bits, TYPE_INT64);
+            emit_line(g, "%s = bitcast double %s to i64", bits.text, value.text);
+            return bits;
+        case TYPE_STRING:
+            *kind = LLVM_KIND_STRING;
+            new_temp(g, &bits, TYPE_INT64);
+            emit_line(g, "%s = ptrtoint i8* %s to i64", bits.text, value.text);
+            return bits;
+        default:
+            *kind = LLVM_KIND_INT;
+            return convert(g, value, TYPE_INT64);
+    }
+}
+
+/*
+ * Expressions
+ */
+static LLVMValue string_constant(LLVMCodegen* g, const char* text) {
+    if (g->string_count == g->string_capacity) {
+        int capacity = g->string_capacity ? g->string_capacity * 2 : 16;
+        char** strings = realloc(g->strings, capacity * sizeof(char*));
+        if (!strings) {
+            llvm_error(g, "Out of memory for string constants");
+            return constant(TYPE_STRING, "null");
+        }
+        g->strings = strings;
+        g->string_capacity = capacity;
+    }
+    int index = g->string_count++;
+    g->strings[index] = my_strdup(text);
+
+    LLVMValue value;
+    size_t size = strlen(text) + 1;
+    value.type = TYPE_STRING;
+    snprintf(value.text, sizeof(value.text),
+             "getelementptr inbounds ([%zu x i8], [%zu x i8]* @.str.%d, i64 0, i64 0)", size, size, index);
+    return value;
+}
+
+static LLVMValue number_constant(const char* text) {
+    LLVMValue value;
+    if (!text) return constant(TYPE_INT64, "0");
+
+    if (strpbrk(text, ".eE") && strncmp(text, "0x", 2) != 0) {
+        // Hexadecimal bit pattern: exact for every double
+        double number = strtod(text, NULL);
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        value.type = TYPE_FLOAT64;
+        snprintf(value.text, sizeof(value.text), "0x%016llX", (unsigned long long)bits);
+        return value;
+    }
+    value.type = TYPE_INT64;
+    snprintf(value.text, sizeof(value.text), "%lld", strtoll(text, NULL, 0));
+    return value;
+}
+
+static LLVMValue load_variable(LLVMCodegen* g, const char* name) {
+    bool global;
+    LLVMVariable* variable = lookup_variable(g, name, &global);
+    if (!variable) {
+        llvm_error(g, "Undefined variable '%s'", name);
+        return constant(TYPE_INT64, "0");
+    }
+    LLVMValue value;
+    new_temp(g, &value, variable->type);
+    const char* type = llvm_type(variable->type);
+    emit_line(g, "%s = load %s, %s* %s%s", value.text, type, type, global ? "@g." : "%v.", variable->symbol);
+    return value;
+}
+
+static void store_variable(LLVMCodegen* g, const char* name, LLVMValue value, bool global) {
+    bool local_global;
+    LLVMVariable* variable = global ? scope_find(&g->globals, name) : lookup_variable(g, name, &local_global);
+    if (!global && local_global) variable = NULL;
+    if (!variable) {
+        llvm_error(g, "Undefined variable '%s'", name);
+        return;
+    }
+    value = convert(g, value, variable->type);
+    const char* type = llvm_type(variable->type);
+    emit_line(g, "store %s %s, %s* %s%s", type, value.text, type, global ? "@g." : "%v.", variable->symbol);
+}
+
+static const char* compare_predicate(TokenType op, bool is_float) {
+    switch (op) {
+        case TOKEN_EQ: return is_float ? "oeq" : "eq";
+        case TOKEN_NE: return is_float ? "une" : "ne";
+        case TOKEN_LT: return is_float ? "olt" : "slt";
+        case TOKEN_LE: return is_float ? "ole" : "sle";
+        case TOKEN_GT: return is_float ? "ogt" : "sgt";
+        default: return is_float ? "oge" : "sge";
+    }
+}
+
+static LLVMValue generate_binary(LLVMCodegen* g, TokenType op, LLVMValue left, LLVMValue right) {
+    LLVMValue result;
+    type_kind_t type = binary_type(op, left.type, right.type);
+
+    switch (op) {
+        case TOKEN_EQ: case TOKEN_NE: case TOKEN_LT: case TOKEN_LE: case TOKEN_GT: case TOKEN_GE: {
+            if (left.type == TYPE_STRING || right.type == TYPE_STRING) {
+                int left_kind, right_kind;
+                LLVMValue left_bits = value_bits(g, left, &left_kind);
+                LLVMValue right_bits = value_bits(g, right, &right_kind);
+                LLVMValue order;
+                new_temp(g, &order, TYPE_INT64);
+                emit_line(g, "%s = call i64 @gp_rt_compare_values(i64 %s, i64 %d, i64 %s, i64 %d)",
+                          order.text, left_bits.text, left_kind, right_bits.text, right_kind);
+                new_temp(g, &result, TYPE_BOOL);
+                emit_line(g, "%s = icmp %s i64 %s, 0", result.text, compare_predicate(op, false), order.text);
+                return result;
+            }
+            bool is_float = left.type == TYPE_FLOAT64 || right.type == TYPE_FLOAT64;
+            type_kind_t operand = is_float ? TYPE_FLOAT64 : TYPE_INT64;
+            left = convert(g, left, operand);
+            right = convert(g, right, operand);
+            new_temp(g, &result, TYPE_BOOL);
+            emit_line(g, "%s = %s %s %s %s, %s", result.text, is_float ? "fcmp" : "icmp",
+                      compare_predicate(op, is_float), llvm_type(operand), left.text, right.text);
+            return result;
+        }
+
+        case TOKEN_POWER:
+            left = convert(g, left, TYPE_FLOAT64);
+            right = convert(g, right, TYPE_FLOAT64);
+            new_temp(g, &result, TYPE_FLOAT64);
+            emit_line(g, "%s = call double @llvm.pow.f64(double %s, double %s)", result.text, left.text, right.text);
+            return result;
+
+        default:
+            break;
+    }
+
+    if (type == TYPE_STRING) {
+        new_temp(g, &result, TYPE_STRING);
+        if (left.type == TYPE_STRING && right.type == TYPE_STRING) {
+            emit_line(g, "%s = call i8* @gp_rt_string_concat(i8* %s, i8* %s)", result.text, left.text, right.text);
+            return result;
+        }
+        int left_kind, right_kind;
+        LLVMValue left_bits = value_bits(g, left, &left_kind);
+        LLVMValue right_bits = value_bits(g, right, &right_kind);
+        new_temp(g, &result, TYPE_STRING);
+        emit_line(g, "%s = call i8* @gp_rt_concat_values(i64 %s, i64 %d, i64 %s, i64 %d)",
+                  result.text, left_bits.text, left_kind, right_bits.text, right_kind);
+        return result;
+    }
+
+    const char* instruction;
+    bool is_float = type == TYPE_FLOAT64;
+    switch (op) {
+        case TOKEN_PLUS: instruction = is_float ? "fadd" : "add nsw"; break;
+        case TOKEN_MINUS: instruction = is_float ? "fsub" : "sub nsw"; break;
+        case TOKEN_MULTIPLY: instruction = is_float ? "fmul" : "mul nsw"; break;
+        case TOKEN_DIVIDE: instruction = is_float ? "fdiv" : "sdiv"; break;
+        case TOKEN_MODULO: instruction = is_float ? "frem" : "srem"; break;
+        default:
+            llvm_error(g, "Unsupported binary operator %d", op);
+            return constant(TYPE_INT64, "0");
+    }
+    left = convert(g, left, type);
+    right = convert(g, right, type);
+    new_temp(g, &result, type);
+    emit_line(g, "%s = %s %s %s, %s", result.text, instruction, llvm_type(type), left.text, right.text);
+    return result;
+}
+
+static bool is_logical(const ast_node_t* node) {
+    return node && node->type == AST_BINARY_OP &&
+           (node->data.binary_op.operator == TOKEN_AND || node->data.binary_op.operator == TOKEN_OR);
+}
+
+/*
+ * and/or as a value: the right operand gets a block of its own, reached
+ * only when the left does not decide the result, and a phi joins the two
+ */
+static LLVMValue generate_logical(LLVMCodegen* g, ast_node_t* node) {
+    bool is_and = node->data.binary_op.operator == TOKEN_AND;
+    int id = g->label_counter++;
+    char right_label[32], end_label[32], left_block[32];
+    new_label(g, right_label, sizeof(right_label), is_and ? "and.rhs" : "or.rhs", id);
+    new_label(g, end_label, sizeof(end_label), is_and ? "and.end" : "or.end", id);
+
+    LLVMValue left = convert(g, generate_expression(g, node->data.binary_op.left), TYPE_BOOL);
+    memcpy(left_block, g->block, sizeof(left_block));
+    emit_line(g, "br i1 %s, label %%%s, label %%%s", left.text,
+              is_and ? right_label : end_label, is_and ? end_label : right_label);
+
+    emit_label(g, right_label);
+    LLVMValue right = convert(g, generate_expression(g, node->data.binary_op.right), TYPE_BOOL);
+    emit_line(g, "br label %%%s", end_label);
+    char right_block[32];
+    memcpy(right_block, g->block, sizeof(right_block));
+
+    emit_label(g, end_label);
+    LLVMValue result;
+    new_temp(g, &result, TYPE_BOOL);
+    emit_line(g, "%s = phi i1 [ %s, %%%s ], [ %s, %%%s ]", result.text, is_and ? "false" : "true", left_block,
+              right.text, right_block);
+    return result;
+}
+
+// Branch on a condition; and/or only evaluate their right operand when needed
+static void generate_branch(LLVMCodegen* g, ast_node_t* node, const char* on_true, const char* on_false) {
+    if (is_logical(node)) {
+        bool is_and = node->data.binary_op.operator == TOKEN_AND;
+        char right_label[32];
+        new_label(g, right_label, sizeof(right_label), is_and ? "and.rhs" : "or.rhs", g->label_counter++);
+        generate_branch(g, node->data.binary_op.left, is_and ? right_label : on_true, is_and ? on_false : right_label);
+        emit_label(g, right_label);
+        generate_branch(g, node->data.binary_op.right, on_true, on_false);
+        return;
+    }
+    if (node && node->type == AST_UNARY_OP && node->data.unary_op.operator == TOKEN_NOT) {
+        generate_branch(g, node->data.unary_op.operand, on_false, on_true);
+        return;
+    }
+    LLVMValue condition = convert(g, generate_expression(g, node), TYPE_BOOL);
+    emit_line(g, "br i1 %s, label %%%s, label %%%s", condition.text, on_true, on_false);
+}
+
+static LLVMValue generate_unary(LLVMCodegen* g, ast_node_t* node) {
+    LLVMValue operand = generate_expression(g, node->data.unary_op.operand);
+    LLVMValue result;
+
+    switch (node->data.unary_op.operator) {
+        case TOKEN_NOT:
+            operand = convert(g, operand, TYPE_BOOL);
+            new_temp(g, &result, TYPE_BOOL);
+            emit_line(g, "%s = xor i1 %s, true", result.text, operand.text);
+            return result;
+        case TOKEN_MINUS:
+            if (operand.type == TYPE_FLOAT64) {
+                new_temp(g, &result, TYPE_FLOAT64);
+                emit_line(g, "%s = fneg double %s", result.text, operand.text);
+                return result;
+            }
+            operand = convert(g, operand, TYPE_INT64);
+            new_temp(g, &result, TYPE_INT64);
+            emit_line(g, "%s = sub nsw i64 0, %s", result.text, operand.text);
+            return result;
+        default:
+            llvm_error(g, "Unsupported unary operator %d", node->data.unary_op.operator);
+            return operand;
+    }
+}
+
+// One-argument runtime call; result_type TYPE_VOID discards the result
+static LLVMValue runtime_call(LLVMCodegen* g, const char* function, type_kind_t result_type, LLVMValue argument) {
+    LLVMValue result;
+    if (result_type == TYPE_VOID) {
+        emit_line(g, "call i64 @%s(%s %s)", function, llvm_type(argument.type), argument.text);
+        return constant(TYPE_VOID, "");
+    }
+    new_temp(g, &result, result_type);
+    emit_line(g, "%s = call %s @%s(%s %s)", result.text, llvm_type(result_type), function,
+              llvm_type(argument.type), argument.text);
+    return result;
+}
+
+static LLVMValue generate_user_call(LLVMCodegen* g, LLVMFunction* function, ast_node_t* node) {
+    if ((int)node->child_count != function->param_count) {
+        llvm_error(g, "Function '%s' takes %d arguments, %zu given", function->name,
+                   function->param_count, node->child_count);
+        return constant(TYPE_INT64, "0");
+    }
+
+    size_t size = 64 + node->child_count * (LLVM_VALUE_SIZE + 16);
+    char* arguments = malloc(size);
+    if (!arguments) {
+        llvm_error(g, "Out of memory for call arguments");
+        return constant(TYPE_INT64, "0");
+    }
+    size_t length = 0;
+    arguments[0] = '\0';
+    for (size_t i = 0; i < node->child_count; i++) {
+        LLVMValue argument = convert(g, generate_expression(g, node->children[i]), function->params[i]);
+        length += snprintf(arguments + length, size - length, "%s%s %s", i ? ", " : "",
+                           llvm_type(argument.type), argument.text);
+    }
+
+    LLVMValue result = constant(TYPE_VOID, "");
+    type_kind_t type = is_main(function) ? TYPE_INT64 : function->return_type;
+    const char* prefix = is_main(function) ? "" : "gp.";
+    if (type == TYPE_VOID) {
+        emit_line(g, "call void @%s%s(%s)", prefix, function->name, arguments);
+    } else if (is_main(function)) {
+        LLVMValue status;
+        new_temp(g, &status, TYPE_INT64);
+        emit_line(g, "%s = call i32 @main()", status.text);
+        new_temp(g, &result, TYPE_INT64);
+        emit_line(g, "%s = sext i32 %s to i64", result.text, status.text);
+    } else {
+        new_temp(g, &result, type);
+        emit_line(g, "%s = call %s @%s%s(%s)", result.text, llvm_type(type), prefix, function->name, arguments);
+    }
+    free(arguments);
+    return result;
+}
+
+static LLVMValue generate_call(LLVMCodegen* g, ast_node_t* node) {
+    const char* name = callee_name(node);
+    LLVMFunction* function = find_function(g, name);
+    if (function) return generate_user_call(g, function, node);
+
+    if (is_time_now(g, node)) {
+        LLVMValue result;
+        new_temp(g, &result, TYPE_INT64);
+        emit_line(g, "%s = call i64 @gp_rt_time_now()", result.text);
+        return result;
+    }
+    const char* method = time_method(node);
+    if (method) {
+        LLVMValue receiver = generate_expression(g, node->data.call.callee->data.member.object);
+        return runtime_call(g, method, TYPE_FLOAT64, convert(g, receiver, TYPE_INT64));
+    }
+    if (!name) {
+        llvm_error(g, "Unsupported call in the LLVM backend");
+        return constant(TYPE_INT64, "0");
+    }
+
+    if (strcmp(name, "print") == 0) {
+        for (size_t i = 0; i < node->child_count; i++) {
+            LLVMValue value = generate_expression(g, node->children[i]);
+            if (value.type == TYPE_STRING) {
+                runtime_call(g, "gp_rt_print_string", TYPE_VOID, value);
+            } else if (value.type == TYPE_FLOAT64) {
+                runtime_call(g, "gp_rt_print_float", TYPE_VOID, value);
+            } else {
+                runtime_call(g, "gp_rt_print_int", TYPE_VOID, convert(g, value, TYPE_INT64));
+            }
+        }
+        return constant(TYPE_VOID, "");
+    }
+
+    if (node->child_count != 1) {
+        llvm_error(g, "Unsupported call to '%s' in the LLVM backend", name);
+        return constant(TYPE_INT64, "0");
+    }
+    LLVMValue argument = generate_expression(g, node->children[0]);
+
+    if (strcmp(name, "str") == 0) return convert(g, argument, TYPE_STRING);
+    if (strcmp(name, "int") == 0) {
+        if (argument.type == TYPE_STRING) return runtime_call(g, "gp_rt_int_from_string", TYPE_INT64, argument);
+        return convert(g, argument, TYPE_INT64);
+    }
+    if (strcmp(name, "float") == 0) {
+        if (argument.type == TYPE_STRING) return runtime_call(g, "gp_rt_float_from_string", TYPE_FLOAT64, argument);
+        return convert(g, argument, TYPE_FLOAT64);
+    }
+    if (strcmp(name, "len") == 0 && argument.type == TYPE_STRING) {
+        return runtime_call(g, "gp_rt_string_length", TYPE_INT64, argument);
+    }
+    const char* intrinsic = math_intrinsic(name);
+    if (intrinsic) return runtime_call(g, intrinsic, TYPE_FLOAT64, convert(g, argument, TYPE_FLOAT64));
+
+    llvm_error(g, "Unsupported call to '%s' in the LLVM backend", name);
+    return constant(TYPE_INT64, "0");
+}
 
-static llvm_codegen_t g_llvm_codegen = {0};
+static LLVMValue generate_expression(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return constant(TYPE_VOID, "");
 
-// Forward declarations
-static void generate_node(ast_node_t* node);
-static void generate_program(ast_node_t* node);
-static void generate_function(ast_node_t* node);
-static void generate_variable_declaration(ast_node_t* node);
-static void generate_binary_operation(ast_node_t* node);
-static void generate_for_statement(ast_node_t* node);
-static void generate_return_statement(ast_node_t* node);
-static void generate_block(ast_node_t* node);
-static void generate_number_literal(ast_node_t* node);
-static void generate_identifier(ast_node_t* node);
-static void generate_parallel_for(ast_node_t* node);
-static void generate_regular_for(ast_node_t* node);
-static void emit_header(void);
-static void emit_footer(void);
-static void emit_line(const char* format, ...);
-static char* new_temp(void);
-static char* new_label(const char* prefix);
-static char* get_last_temp(void);
+    switch (node->type) {
+        case AST_NUMBER:
+            return number_constant(node->data.literal.value);
+        case AST_STRING:
+            return string_constant(g, node->data.literal.value ? node->data.literal.value : "");
+        case AST_BOOLEAN:
+            return constant(TYPE_BOOL, node->data.literal.value &&
+                                       strcmp(node->data.literal.value, "true") == 0 ? "true" : "false");
+        case AST_IDENTIFIER:
+            return load_variable(g, node->data.identifier.name);
+        case AST_BINARY_OP: {
+            if (is_logical(node)) return generate_logical(g, node);
+            LLVMValue left = generate_expression(g, node->data.binary_op.left);
+            LLVMValue right = generate_expression(g, node->data.binary_op.right);
+            return generate_binary(g, node->data.binary_op.operator, left, right);
+        }
+        case AST_UNARY_OP:
+            return generate_unary(g, node);
+        case AST_CALL:
+            return generate_call(g, node);
+        default:
+            llvm_error(g, "Unsupported expression (node type %d) in the LLVM backend", node->type);
+            return constant(TYPE_INT64, "0");
+    }
+}
 
 /*
- * Initialize LLVM code generator
+ * Statements
  */
-int llvm_codegen_init(const char* output_filename) {
-    printf("⚡ Initializing GPLANG LLVM Code Generator...\n");
-    
-    memset(&g_llvm_codegen, 0, sizeof(llvm_codegen_t));
-    
-    g_llvm_codegen.output_file = fopen(output_filename, "w");
-    if (!g_llvm_codegen.output_file) {
-        printf("❌ Failed to open output file: %s\n", output_filename);
-        return -1;
+
+// Statements after ret/br start a fresh (unreachable) block
+static void ensure_open_block(LLVMCodegen* g) {
+    if (!g->terminated) return;
+    char label[32];
+    new_label(g, label, sizeof(label), "dead", g->label_counter++);
+    emit_label(g, label);
+}
+
+static void branch_if_open(LLVMCodegen* g, const char* label) {
+    if (g->terminated) return;
+    emit_line(g, "br label %%%s", label);
+    g->terminated = true;
+}
+
+static void generate_block(LLVMCodegen* g, ast_node_t* block) {
+    if (!block) return;
+    int scope = enter_scope(g);
+    if (block->type != AST_BLOCK) {
+        generate_statement(g, block);
+    } else {
+        for (size_t i = 0; i < block->child_count; i++) {
+            generate_statement(g, block->children[i]);
+        }
     }
-    
-    g_llvm_codegen.temp_counter = 0;
-    g_llvm_codegen.label_counter = 0;
-    g_llvm_codegen.indent_level = 0;
-    
-    // Write LLVM IR header
-    emit_header();
-    
-    printf("✅ LLVM code generator initialized\n");
-    printf("   • Target: LLVM IR\n");
-    printf("   • Output: %s\n", output_filename);
-    printf("   • Optimizations: ENABLED\n");
-    
-    return 0;
+    leave_scope(g, scope);
+}
+
+static void generate_if(LLVMCodegen* g, ast_node_t* node) {
+    int id = g->label_counter++;
+    char then_label[32], else_label[32], end_label[32];
+    new_label(g, then_label, sizeof(then_label), "if.then", id);
+    new_label(g, else_label, sizeof(else_label), "if.else", id);
+    new_label(g, end_label, sizeof(end_label), "if.end", id);
+    bool has_else = node->data.if_stmt.else_block != NULL;
+
+    generate_branch(g, node->data.if_stmt.condition, then_label, has_else ? else_label : end_label);
+
+    emit_label(g, then_label);
+    generate_block(g, node->data.if_stmt.then_block);
+    branch_if_open(g, end_label);
+
+    if (has_else) {
+        emit_label(g, else_label);
+        generate_block(g, node->data.if_stmt.else_block);
+        branch_if_open(g, end_label);
+    }
+    emit_label(g, end_label);
+}
+
+static void generate_while(LLVMCodegen* g, ast_node_t* node) {
+    int id = g->label_counter++;
+    char cond_label[32], body_label[32], end_label[32];
+    new_label(g, cond_label, sizeof(cond_label), "while.cond", id);
+    new_label(g, body_label, sizeof(body_label), "while.body", id);
+    new_label(g, end_label, sizeof(end_label), "while.end", id);
+
+    emit_line(g, "br label %%%s", cond_label);
+    emit_label(g, cond_label);
+    generate_branch(g, node->data.while_stmt.condition, body_label, end_label);
+
+    emit_label(g, body_label);
+    generate_block(g, node->data.while_stmt.body);
+    branch_if_open(g, cond_label);
+
+    emit_label(g, end_label);
 }
 
 /*
- * Generate LLVM IR from AST
+ * Loops that ask opt to vectorize: the bodies ir_vectorize.c widens,
+ * straight-line integer add, sub and mul into locals. Any other loop
+ * (one that prints, calls, branches or sums doubles) only earns a "loop
+ * not vectorized" warning when asked, so its metadata says nothing.
  */
-int llvm_generate_code(ast_node_t* root) {
-    printf("⚡ Generating LLVM IR code...\n");
-    
-    if (!root) {
-        printf("❌ No AST to generate code from\n");
-        return -1;
+static bool vectorizable_expression(LLVMCodegen* g, ast_node_t* node) {
+    if (!node || expression_type(g, node) != TYPE_INT64) return false;
+
+    switch (node->type) {
+        case AST_NUMBER:
+        case AST_IDENTIFIER:
+            return true;
+        case AST_BINARY_OP: {
+            TokenType op = node->data.binary_op.operator;
+            return (op == TOKEN_PLUS || op == TOKEN_MINUS || op == TOKEN_MULTIPLY) &&
+                   vectorizable_expression(g, node->data.binary_op.left) &&
+                   vectorizable_expression(g, node->data.binary_op.right);
+        }
+        case AST_UNARY_OP:
+            return node->data.unary_op.operator == TOKEN_MINUS &&
+                   vectorizable_expression(g, node->data.unary_op.operand);
+        default:
+            return false;
     }
-    
-    // Generate code for the entire program
-    generate_node(root);
-    
-    // Write footer
-    emit_footer();
-    
-    printf("✅ LLVM IR generation completed\n");
-    printf("   • LLVM IR generated successfully\n");
-    printf("   • Ready for optimization and compilation\n");
-    
-    return 0;
+}
+
+static bool vectorizable_statement(LLVMCodegen* g, ast_node_t* node) {
+    if (!node) return true;
+    bool global;
+
+    switch (node->type) {
+        case AST_VARIABLE:
+            if (!vectorizable_expression(g, node->data.variable.value)) return false;
+            declare_variable(g, node, node->data.variable.name, &global);
+            return true;
+        case AST_ASSIGN: {
+            ast_node_t* target = node->data.assign.target;
+            TokenType op = node->data.assign.operator;
+            return target && target->type == AST_IDENTIFIER &&
+                   lookup_variable(g, target->data.identifier.name, &global) && !global &&
+                   (op == TOKEN_ASSIGN || op == TOKEN_PLUS || op == TOKEN_MINUS) &&
+                   vectorizable_expression(g, target) && vectorizable_expression(g, node->data.assign.value);
+        }
+        case AST_BLOCK:
+        case AST_EXPRESSION_STMT:
+            for (size_t i = 0; i < node->child_count; i++) {
+                if (!vectorizable_statement(g, node->children[i])) return false;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The !llvm.loop node for a loop with this body; every loop may be assumed to make progress
+static int loop_metadata(LLVMCodegen* g, ast_node_t* body) {
+    int scope = enter_scope(g);
+    bool vectorize = vectorizable_statement(g, body);
+    leave_scope(g, scope);
+
+    int id = g->loop_count++ + 2;
+    text_buffer_printf(&g->loop_metadata, "!%d = distinct !{!%d, !0%s}\n", id, id, vectorize ? ", !1" : "");
+    return id;
 }
 
 /*
- * Generate code for AST node
+ * parallel for: the body is outlined into
+ *
+ *   void @gp.<function>.parallel.<N>(i8* env, i64 first, i64 last)
+ *
+ * which runs iterations [first, last) of the loop, and the loop itself
+ * becomes one call to gp_rt_parallel_for (gp_parallel.c), which splits
+ * the iterations across its worker threads. env holds start, step and a
+ * pointer to every enclosing local the body uses. Variables declared in
+ * the body, and the loop variable, get one copy per chunk.
+ *
+ * The iterations run concurrently and in no particular order, so the loop
+ * runs serially instead if its body prints, writes a global, returns, or
+ * assigns an enclosing local other than as a sum (x += e, x -= e,
+ * x = x + e, x = x - e). A sum is accumulated per chunk and added to x
+ * atomically when the chunk ends.
  */
-static void generate_node(ast_node_t* node) {
+typedef struct {
+    const char* name;
+    const char* symbol;
+    type_kind_t type;
+    int reads;              // Uses in the body
+    int reduction_reads;    // Of those, the x in x = x + e
+    bool reduction;
+} LLVMCapture;
+
+typedef struct {
+    LLVMScope privates;     // Slots declared in the body, and the loop variable
+    int scope;              // Visible names from here on are private
+    LLVMCapture* captures;
+    int capture_count;
+    int capture_capacity;
+    char reason[128];       // Why the loop runs serially; empty if it need not
+} LLVMParallelLoop;
+
+static void serial_because(LLVMParallelLoop* loop, const char* format, const char* name) {
+    if (loop->reason[0]) return;
+    snprintf(loop->reason, sizeof(loop->reason), format, name);
+}
+
+static void add_private(LLVMCodegen* g, LLVMParallelLoop* loop, ast_node_t* declaration) {
+    LLVMVariable* local = find_declared(g->current, declaration);
+    if (!local) return;
+    LLVMVariable* entry = scope_add(g, &loop->privates, local->symbol);
+    if (entry) *entry = *local;
+}
+
+static void collect_privates(LLVMCodegen* g, LLVMParallelLoop* loop, ast_node_t* node) {
     if (!node) return;
-    
+
     switch (node->type) {
-        case AST_PROGRAM:
-            generate_program(node);
+        case AST_VARIABLE:
+            add_private(g, loop, node);
             break;
-        case AST_FUNCTION:
-            generate_function(node);
+        case AST_FOR:
+            add_private(g, loop, node);
+            collect_privates(g, loop, node->data.for_stmt.body);
             break;
-        case AST_VARIABLE:
-            generate_variable_declaration(node);
+        case AST_IF:
+            collect_privates(g, loop, node->data.if_stmt.then_block);
+            collect_privates(g, loop, node->data.if_stmt.else_block);
+            break;
+        case AST_WHILE:
+            collect_privates(g, loop, node->data.while_stmt.body);
+            break;
+        case AST_BLOCK:
+        case AST_UNSAFE_BLOCK:
+        case AST_EXPRESSION_STMT:
+            for (size_t i = 0; i < node->child_count; i++) {
+                collect_privates(g, loop, node->children[i]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// The capture for an enclosing local; NULL for privates and globals
+static LLVMCapture* capture(LLVMCodegen* g, LLVMParallelLoop* loop, const char* name) {
+    int position = visible_position(g, name);
+    if (position < 0 || position >= loop->scope) return NULL;
+    LLVMVariable* variable = &g->current->locals.items[g->visible[position]];
+
+    for (int i = 0; i < loop->capture_count; i++) {
+        if (loop->captures[i].symbol == variable->symbol) return &loop->captures[i];
+    }
+    if (loop->capture_count == loop->capture_capacity) {
+        int capacity = loop->capture_capacity ? loop->capture_capacity * 2 : 8;
+        LLVMCapture* captures = realloc(loop->captures, capacity * sizeof(LLVMCapture));
+        if (!captures) {
+            llvm_error(g, "Out of memory for parallel loop");
+            return NULL;
+        }
+        loop->captures = captures;
+        loop->capture_capacity = capacity;
+    }
+    LLVMCapture* entry = &loop->captures[loop->capture_count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->name = variable->name;
+    entry->symbol = variable->symbol;
+    entry->type = variable->type;
+    return entry;
+}
+
+static void scan_parallel_statement(LLVMCodegen* g, LLVMParallelLoop* loop, ast_node_t* node);
+
+static void scan_parallel_expression(LLVMCodegen* g, LLVMParallelLoop* loop, ast_node_t* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_IDENTIFIER: {
+            LLVMCapture* entry = capture(g, loop, node->data.identifier.name);
+            if (entry) entry->reads++;
             break;
+        }
         case AST_BINARY_OP:
-            generate_binary_operation(node);
+            scan_parallel_expression(g, loop, node->data.binary_op.left);
+            scan_parallel_expression(g, loop, node->data.binary_op.right);
             break;
-        case AST_FOR:
-            generate_for_statement(node);
+        case AST_UNARY_OP:
+            scan_parallel_expression(g, loop, node->data.unary_op.operand);
+            break;
+        case AST_CALL: {
+            const char* name = callee_name(node);
+            LLVMFunction* function = find_function(g, name);
+            if (name && strcmp(name, "print") == 0) serial_because(loop, "body prints%s", "");
+            if (function && function->impure) serial_because(loop, "body calls %s, which has side effects", name);
+            if (node->data.call.callee && node->data.call.callee->type == AST_MEMBER) {
+                scan_parallel_expression(g, loop, node->data.call.callee->data.member.object);
+            }
+            for (size_t i = 0; i < node->child_count; i++) {
+                scan_parallel_expression(g, loop, node->children[i]);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void scan_parallel_assign(LLVMCodegen* g, LLVMParallelLoop* loop, ast_node_t* node) {
+    ast_node_t* target = node->data.assign.target;
+    ast_node_t* value = node->data.assign.value;
+    TokenType op = node->data.assign.operator;
+    if (!target || target->type != AST_IDENTIFIER) {
+        serial_because(loop, "body assigns to something other than a variable%s", "");
+        return;
+    }
+
+    const char* name = target->data.identifier.name;
+    bool global;
+    LLVMCapture* entry = capture(g, loop, name);
+    if (!entry) {
+        if (!lookup_variable(g, name, &global) || global) serial_because(loop, "body writes global %s", name);
+    } else if (op == TOKEN_PLUS || op == TOKEN_MINUS) {
+        entry->reduction = true;
+    } else if (op == TOKEN_ASSIGN && value && value->type == AST_BINARY_OP &&
+               (value->data.binary_op.operator == TOKEN_PLUS || value->data.binary_op.operator == TOKEN_MINUS) &&
+               value->data.binary_op.left && value->data.binary_op.left->type == AST_IDENTIFIER &&
+               strcmp(value->data.binary_op.left->data.identifier.name, name) == 0) {
+        entry->reduction = true;
+        entry->reduction_reads++;
+    } else {
+        serial_because(loop, "body assigns %s, which is shared between iterations", name);
+    }
+    scan_parallel_expression(g, loop, value);
+}
+
+static void scan_parallel_statement(LLVMCodegen* g, LLVMParallelLoop* loop, ast_node_t* node) {
+    if (!node) return;
+
+    bool global;
+    int scope = enter_scope(g);
+
+    switch (node->type) {
+        case AST_VARIABLE:
+            scan_parallel_expression(g, loop, node->data.variable.value);
+            declare_variable(g, node, node->data.variable.name, &global);
+            return;
+        case AST_ASSIGN:
+            scan_parallel_assign(g, loop, node);
             break;
         case AST_RETURN:
-            generate_return_statement(node);
+            serial_because(loop, "body returns%s", "");
             break;
-        case AST_BLOCK:
-            generate_block(node);
+        case AST_IF:
+            scan_parallel_expression(g, loop, node->data.if_stmt.condition);
+            scan_parallel_statement(g, loop, node->data.if_stmt.then_block);
+            scan_parallel_statement(g, loop, node->data.if_stmt.else_block);
             break;
-        case AST_NUMBER:
-            generate_number_literal(node);
+        case AST_WHILE:
+            scan_parallel_expression(g, loop, node->data.while_stmt.condition);
+            scan_parallel_statement(g, loop, node->data.while_stmt.body);
             break;
-        case AST_IDENTIFIER:
-            generate_identifier(node);
+        case AST_FOR: {
+            ast_node_t* iterable = node->data.for_stmt.iterable;
+            for (size_t i = 0; iterable && i < iterable->child_count; i++) {
+                scan_parallel_expression(g, loop, iterable->children[i]);
+            }
+            declare_variable(g, node, node->data.for_stmt.variable, &global);
+            scan_parallel_statement(g, loop, node->data.for_stmt.body);
             break;
-        default:
-            // Generate children for other node types
+        }
+        case AST_BLOCK:
+        case AST_UNSAFE_BLOCK:
+            for (size_t i = 0; i < node->child_count; i++) {
+                scan_parallel_statement(g, loop, node->children[i]);
+            }
+            break;
+        case AST_EXPRESSION_STMT:
+            // Declarations here belong to the enclosing block
             for (size_t i = 0; i < node->child_count; i++) {
-                generate_node(node->children[i]);
+                scan_parallel_statement(g, loop, node->children[i]);
             }
+            return;
+        case AST_IMPORT:
+        case AST_FUNCTION:
+            break;
+        default:
+            scan_parallel_expression(g, loop, node);
             break;
     }
+    leave_scope(g, scope);
 }
 
-/*
- * Generate program (top-level)
- */
-static void generate_program(ast_node_t* node) {
-    emit_line("; GPLANG Program - Generated LLVM IR");
-    emit_line("");
-    
-    // Generate functions
-    for (size_t i = 0; i < node->child_count; i++) {
-        if (node->children[i]->type == AST_FUNCTION) {
-            generate_node(node->children[i]);
+// Fills loop and returns true if the body may run on many threads
+static bool analyze_parallel_loop(LLVMCodegen* g, ast_node_t* node, LLVMParallelLoop* loop) {
+    memset(loop, 0, sizeof(*loop));
+    if (in_init(g)) {
+        serial_because(loop, "top-level loops run serially%s", "");
+        return false;
+    }
+
+    // generate_for has just declared the loop variable
+    loop->scope = g->visible_count - 1;
+    add_private(g, loop, node);
+    collect_privates(g, loop, node->data.for_stmt.body);
+    scan_parallel_statement(g, loop, node->data.for_stmt.body);
+
+    for (int i = 0; i < loop->capture_count; i++) {
+        const LLVMCapture* entry = &loop->captures[i];
+        if (!entry->reduction) continue;
+        if (entry->type != TYPE_INT64 && entry->type != TYPE_FLOAT64) {
+            serial_because(loop, "body assigns %s, which is not a number", entry->name);
+        } else if (entry->reads != entry->reduction_reads) {
+            serial_because(loop, "body reads the running sum %s", entry->name);
+        }
+    }
+    return !loop->reason[0] && !g->error;
+}
+
+static void free_parallel_loop(LLVMParallelLoop* loop) {
+    free(loop->privates.items);
+    free(loop->captures);
+}
+
+// "{ i64, i64, T*, ... }": start, step, then one pointer per capture
+static char* environment_type(const LLVMParallelLoop* loop) {
+    size_t size = 32 + loop->capture_count * 16;
+    char* type = malloc(size);
+    if (!type) return NULL;
+    size_t length = snprintf(type, size, "{ i64, i64");
+    for (int i = 0; i < loop->capture_count; i++) {
+        length += snprintf(type + length, size - length, ", %s*", llvm_type(loop->captures[i].type));
+    }
+    snprintf(type + length, size - length, " }");
+    return type;
+}
+
+static void generate_outlined_body(LLVMCodegen* g, ast_node_t* node, const LLVMParallelLoop* loop,
+                                   const char* name, const char* env_type) {
+    const char* variable = node->data.for_stmt.variable;
+    int id = g->label_counter++;
+    char cond_label[32], body_label[32], step_label[32], end_label[32];
+    new_label(g, cond_label, sizeof(cond_label), "chunk.cond", id);
+    new_label(g, body_label, sizeof(body_label), "chunk.body", id);
+    new_label(g, step_label, sizeof(step_label), "chunk.step", id);
+    new_label(g, end_label, sizeof(end_label), "chunk.end", id);
+
+    text_buffer_printf(&g->text, "\n; parallel for %s in %s\n", variable, g->current->name);
+    text_buffer_printf(&g->text, "define internal void @gp.%s(i8* %%env, i64 %%first, i64 %%last) #0 {\nentry:\n", name);
+    strcpy(g->block, "entry");
+    emit_line(g, "%%env.fields = bitcast i8* %%env to %s*", env_type);
+    emit_line(g, "%%env.start = getelementptr inbounds %s, %s* %%env.fields, i32 0, i32 0", env_type, env_type);
+    emit_line(g, "%%start = load i64, i64* %%env.start");
+    emit_line(g, "%%env.step = getelementptr inbounds %s, %s* %%env.fields, i32 0, i32 1", env_type, env_type);
+    emit_line(g, "%%step = load i64, i64* %%env.step");
+
+    for (int i = 0; i < loop->capture_count; i++) {
+        const LLVMCapture* entry = &loop->captures[i];
+        const char* type = llvm_type(entry->type);
+        emit_line(g, "%%slot.%s = getelementptr inbounds %s, %s* %%env.fields, i32 0, i32 %d",
+                  entry->symbol, env_type, env_type, i + 2);
+        if (entry->reduction) {
+            emit_line(g, "%%sum.%s = load %s*, %s** %%slot.%s", entry->symbol, type, type, entry->symbol);
+            emit_line(g, "%%v.%s = alloca %s", entry->symbol, type);
+            emit_line(g, "store %s %s, %s* %%v.%s", type, zero_value(entry->type), type, entry->symbol);
+        } else {
+            emit_line(g, "%%v.%s = load %s*, %s** %%slot.%s", entry->symbol, type, type, entry->symbol);
+        }
+    }
+    for (int i = 0; i < loop->privates.count; i++) {
+        const LLVMVariable* local = &loop->privates.items[i];
+        emit_line(g, "%%v.%s = alloca %s", local->symbol, llvm_type(local->type));
+    }
+    emit_line(g, "%%iteration = alloca i64");
+    emit_line(g, "store i64 %%first, i64* %%iteration");
+    emit_line(g, "br label %%%s", cond_label);
+
+    emit_label(g, cond_label);
+    LLVMValue index, in_range;
+    new_temp(g, &index, TYPE_INT64);
+    emit_line(g, "%s = load i64, i64* %%iteration", index.text);
+    new_temp(g, &in_range, TYPE_BOOL);
+    emit_line(g, "%s = icmp slt i64 %s, %%last", in_range.text, index.text);
+    emit_line(g, "br i1 %s, label %%%s, label %%%s", in_range.text, body_label, end_label);
+
+    // v = start + iteration * step
+    emit_label(g, body_label);
+    LLVMValue offset, value;
+    new_temp(g, &offset, TYPE_INT64);
+    emit_line(g, "%s = mul nsw i64 %s, %%step", offset.text, index.text);
+    new_temp(g, &value, TYPE_INT64);
+    emit_line(g, "%s = add nsw i64 %%start, %s", value.text, offset.text);
+    store_variable(g, variable, value, false);
+    generate_block(g, node->data.for_stmt.body);
+    branch_if_open(g, step_label);
+
+    emit_label(g, step_label);
+    LLVMValue current, next;
+    new_temp(g, &current, TYPE_INT64);
+    emit_line(g, "%s = load i64, i64* %%iteration", current.text);
+    new_temp(g, &next, TYPE_INT64);
+    emit_line(g, "%s = add nsw i64 %s, 1", next.text, current.text);
+    emit_line(g, "store i64 %s, i64* %%iteration", next.text);
+    emit_line(g, "br label %%%s, !llvm.loop !%d", cond_label, loop_metadata(g, node->data.for_stmt.body));
+    g->terminated = true;
+
+    emit_label(g, end_label);
+    for (int i = 0; i < loop->capture_count; i++) {
+        const LLVMCapture* entry = &loop->captures[i];
+        if (!entry->reduction) continue;
+        const char* type = llvm_type(entry->type);
+        LLVMValue partial;
+        new_temp(g, &partial, entry->type);
+        emit_line(g, "%s = load %s, %s* %%v.%s", partial.text, type, type, entry->symbol);
+        emit_line(g, "atomicrmw %s %s* %%sum.%s, %s %s monotonic", entry->type == TYPE_FLOAT64 ? "fadd" : "add",
+                  type, entry->symbol, type, partial.text);
+    }
+    emit_line(g, "ret void");
+    text_buffer_puts(&g->text, "}\n");
+}
+
+static void generate_parallel_for(LLVMCodegen* g, ast_node_t* node, const LLVMParallelLoop* loop,
+                                  LLVMValue start, LLVMValue end, LLVMValue step) {
+    char name[256];
+    snprintf(name, sizeof(name), "%s.parallel.%d", g->current->name, g->label_counter++);
+    char* env_type = environment_type(loop);
+    if (!env_type) {
+        llvm_error(g, "Out of memory for parallel loop");
+        return;
+    }
+
+    // The body goes to its own function, written out after this one
+    TextBuffer text = g->text;
+    int temp_counter = g->temp_counter;
+    char block[sizeof(g->block)];
+    memcpy(block, g->block, sizeof(block));
+    memset(&g->text, 0, sizeof(g->text));
+    g->temp_counter = 0;
+    generate_outlined_body(g, node, loop, name, env_type);
+    TextBuffer body = g->text;
+    g->text = text;
+    g->temp_counter = temp_counter;
+    g->terminated = false;
+    memcpy(g->block, block, sizeof(block));
+
+    text_buffer_append(&g->outlined, body.data, body.size);
+    if (body.failed) g->outlined.failed = true;
+    text_buffer_free(&body);
+
+    LLVMValue stack, env, field, env_bytes;
+    new_temp(g, &stack, TYPE_STRING);
+    emit_line(g, "%s = call i8* @llvm.stacksave()", stack.text);
+    new_temp(g, &env, TYPE_STRING);
+    emit_line(g, "%s = alloca %s", env.text, env_type);
+    for (int i = -2; i < loop->capture_count; i++) {
+        new_temp(g, &field, TYPE_STRING);
+        emit_line(g, "%s = getelementptr inbounds %s, %s* %s, i32 0, i32 %d", field.text, env_type, env_type,
+                  env.text, i + 2);
+        if (i < 0) {
+            emit_line(g, "store i64 %s, i64* %s", i == -2 ? start.text : step.text, field.text);
+        } else {
+            const char* type = llvm_type(loop->captures[i].type);
+            emit_line(g, "store %s* %%v.%s, %s** %s", type, loop->captures[i].symbol, type, field.text);
         }
     }
+    new_temp(g, &env_bytes, TYPE_STRING);
+    emit_line(g, "%s = bitcast %s* %s to i8*", env_bytes.text, env_type, env.text);
+    emit_line(g, "call void @gp_rt_parallel_for(i64 %s, i64 %s, i64 %s, void (i8*, i64, i64)* @gp.%s, i8* %s)",
+              start.text, end.text, step.text, name, env_bytes.text);
+    emit_line(g, "call void @llvm.stackrestore(i8* %s)", stack.text);
+    free(env_type);
 }
 
 /*
- * Generate function
+ * for v in range(start, end, step): bounds and step are evaluated once
+ * before the loop. A literal step picks the compare (v > end when it
+ * is negative, as in irgen); any other step selects between v < end
+ * and v > end on its sign, which opt unswitches out of the loop.
+ *
+ *   for.cond:  v < end ? for.body : for.end
+ *   for.body:  ...; br for.step
+ *   for.step:  v += step (nsw); br for.cond, !llvm.loop
  */
-static void generate_function(ast_node_t* node) {
-    const char* func_name = node->data.function.name;
-    strcpy(g_llvm_codegen.current_function, func_name);
-    
-    emit_line("");
-    emit_line("; Function: %s", func_name);
-    
-    // Function signature
-    if (strcmp(func_name, "main") == 0) {
-        emit_line("define i32 @main() {");
+static void generate_for(LLVMCodegen* g, ast_node_t* node) {
+    ast_node_t* iterable = node->data.for_stmt.iterable;
+    const char* variable = node->data.for_stmt.variable;
+    if (!is_range_call(iterable) || !variable) {
+        llvm_error(g, "The LLVM backend only supports 'for' over range()");
+        return;
+    }
+
+    LLVMValue start = constant(TYPE_INT64, "0");
+    LLVMValue end;
+    LLVMValue step = constant(TYPE_INT64, "1");
+    if (iterable->child_count == 1) {
+        end = convert(g, generate_expression(g, iterable->children[0]), TYPE_INT64);
     } else {
-        emit_line("define void @%s() {", func_name);
-    }
-    
-    g_llvm_codegen.indent_level++;
-    
-    // Entry block
-    emit_line("entry:");
-    g_llvm_codegen.indent_level++;
-    
-    // Generate function body
-    if (node->data.function.body) {
-        generate_node(node->data.function.body);
-    }
-    
-    // Default return if none specified
-    if (strcmp(func_name, "main") == 0) {
-        emit_line("ret i32 0");
+        start = convert(g, generate_expression(g, iterable->children[0]), TYPE_INT64);
+        end = convert(g, generate_expression(g, iterable->children[1]), TYPE_INT64);
+    }
+    const char* compare = "slt";
+    LLVMValue counts_up = constant(TYPE_BOOL, "true");
+    if (iterable->child_count == 3) {
+        ast_node_t* step_node = iterable->children[2];
+        long long value;
+        step = convert(g, generate_expression(g, step_node), TYPE_INT64);
+        if (ast_integer_constant(step_node, &value)) {
+            if (value < 0) compare = "sgt";
+        } else {
+            compare = NULL;
+        }
+    }
+
+    // The loop variable is scoped to the loop
+    int scope = enter_scope(g);
+    bool global;
+    LLVMVariable* slot = declare_variable(g, node, variable, &global);
+    if (!slot) {
+        leave_scope(g, scope);
+        return;
+    }
+
+    if (node->data.for_stmt.is_parallel) {
+        LLVMParallelLoop loop;
+        bool parallel = analyze_parallel_loop(g, node, &loop);
+        if (parallel) {
+            generate_parallel_for(g, node, &loop, start, end, step);
+        } else {
+            emit_line(g, "; parallel for %s runs serially: %s", variable, loop.reason);
+        }
+        free_parallel_loop(&loop);
+        if (parallel) {
+            leave_scope(g, scope);
+            return;
+        }
+    }
+
+    store_variable(g, variable, start, global);
+    if (!compare) {
+        new_temp(g, &counts_up, TYPE_BOOL);
+        emit_line(g, "%s = icmp sgt i64 %s, 0", counts_up.text, step.text);
+    }
+
+    int id = g->label_counter++;
+    int loop = loop_metadata(g, node->data.for_stmt.body);
+    char cond_label[32], body_label[32], step_label[32], end_label[32];
+    new_label(g, cond_label, sizeof(cond_label), "for.cond", id);
+    new_label(g, body_label, sizeof(body_label), "for.body", id);
+    new_label(g, step_label, sizeof(step_label), "for.step", id);
+    new_label(g, end_label, sizeof(end_label), "for.end", id);
+
+    emit_line(g, "br label %%%s", cond_label);
+
+    emit_label(g, cond_label);
+    LLVMValue index = load_variable(g, variable);
+    LLVMValue in_range;
+    if (compare) {
+        new_temp(g, &in_range, TYPE_BOOL);
+        emit_line(g, "%s = icmp %s i64 %s, %s", in_range.text, compare, index.text, end.text);
     } else {
-        emit_line("ret void");
+        LLVMValue below, above;
+        new_temp(g, &below, TYPE_BOOL);
+        emit_line(g, "%s = icmp slt i64 %s, %s", below.text, index.text, end.text);
+        new_temp(g, &above, TYPE_BOOL);
+        emit_line(g, "%s = icmp sgt i64 %s, %s", above.text, index.text, end.text);
+        new_temp(g, &in_range, TYPE_BOOL);
+        emit_line(g, "%s = select i1 %s, i1 %s, i1 %s", in_range.text, counts_up.text, below.text, above.text);
     }
-    
-    g_llvm_codegen.indent_level -= 2;
-    emit_line("}");
+    emit_line(g, "br i1 %s, label %%%s, label %%%s", in_range.text, body_label, end_label);
+
+    emit_label(g, body_label);
+    generate_block(g, node->data.for_stmt.body);
+    branch_if_open(g, step_label);
+
+    emit_label(g, step_label);
+    LLVMValue current = load_variable(g, variable);
+    LLVMValue next;
+    new_temp(g, &next, TYPE_INT64);
+    emit_line(g, "%s = add nsw i64 %s, %s", next.text, current.text, step.text);
+    store_variable(g, variable, next, global);
+    emit_line(g, "br label %%%s, !llvm.loop !%d", cond_label, loop);
+    g->terminated = true;
+
+    emit_label(g, end_label);
+    leave_scope(g, scope);
 }
 
-/*
- * Generate variable declaration
- */
-static void generate_variable_declaration(ast_node_t* node) {
-    const char* var_name = node->data.variable.name;
-    
-    // Allocate space for variable
-    emit_line("%%%s = alloca i32, align 4", var_name);
-    
-    // Generate initializer if present
-    if (node->data.variable.value) {
-        generate_node(node->data.variable.value);
-        char* value_reg = get_last_temp();
-        emit_line("store i32 %s, i32* %%%s, align 4", value_reg, var_name);
+static void generate_return(LLVMCodegen* g, ast_node_t* node) {
+    LLVMFunction* function = g->current;
+    LLVMValue value = generate_expression(g, node->data.return_stmt.expression);
+
+    if (is_main(function)) {
+        value = value.type == TYPE_VOID ? constant(TYPE_INT64, "0") : convert(g, value, TYPE_INT64);
+        LLVMValue status;
+        new_temp(g, &status, TYPE_INT64);
+        emit_line(g, "%s = trunc i64 %s to i32", status.text, value.text);
+        emit_line(g, "ret i32 %s", status.text);
+    } else if (function->return_type == TYPE_VOID) {
+        emit_line(g, "ret void");
+    } else {
+        if (value.type == TYPE_VOID) value = constant(function->return_type, zero_value(function->return_type));
+        value = convert(g, value, function->return_type);
+        emit_line(g, "ret %s %s", llvm_type(value.type), value.text);
     }
+    g->terminated = true;
 }
 
-/*
- * Generate binary operation
- */
-static void generate_binary_operation(ast_node_t* node) {
-    // Generate left operand
-    generate_node(node->data.binary_op.left);
-    char* left_reg = get_last_temp();
-    
-    // Generate right operand
-    generate_node(node->data.binary_op.right);
-    char* right_reg = get_last_temp();
-    
-    // Generate operation
-    char* result_reg = new_temp();
-    
-    switch (node->data.binary_op.operator) {
-        case TOKEN_PLUS:
-            emit_line("%s = add nsw i32 %s, %s", result_reg, left_reg, right_reg);
+static void generate_statement(LLVMCodegen* g, ast_node_t* node) {
+    if (!node || g->error) return;
+    ensure_open_block(g);
+    bool global;
+
+    switch (node->type) {
+        case AST_VARIABLE: {
+            LLVMValue value = node->data.variable.value
+                ? generate_expression(g, node->data.variable.value) : constant(TYPE_INT64, "0");
+            declare_variable(g, node, node->data.variable.name, &global);
+            store_variable(g, node->data.variable.name, value, global);
             break;
-        case TOKEN_MINUS:
-            emit_line("%s = sub nsw i32 %s, %s", result_reg, left_reg, right_reg);
+        }
+        case AST_ASSIGN: {
+            ast_node_t* target = node->data.assign.target;
+            if (!target || target->type != AST_IDENTIFIER) {
+                llvm_error(g, "The LLVM backend only supports assignment to variables");
+                break;
+            }
+            LLVMValue value = generate_expression(g, node->data.assign.value);
+            if (node->data.assign.operator != TOKEN_ASSIGN) {
+                LLVMValue current = load_variable(g, target->data.identifier.name);
+                value = generate_binary(g, node->data.assign.operator, current, value);
+            }
+            lookup_variable(g, target->data.identifier.name, &global);
+            store_variable(g, target->data.identifier.name, value, global);
+            break;
+        }
+        case AST_RETURN:
+            generate_return(g, node);
+            break;
+        case AST_IF:
+            generate_if(g, node);
+            break;
+        case AST_WHILE:
+            generate_while(g, node);
             break;
-        case TOKEN_MULTIPLY:
-            emit_line("%s = mul nsw i32 %s, %s", result_reg, left_reg, right_reg);
+        case AST_FOR:
+            generate_for(g, node);
+            break;
+        case AST_BLOCK:
+        case AST_UNSAFE_BLOCK:
+            generate_block(g, node);
+            break;
+        case AST_EXPRESSION_STMT:
+            for (size_t i = 0; i < node->child_count; i++) {
+                generate_statement(g, node->children[i]);
+            }
             break;
-        case TOKEN_DIVIDE:
-            emit_line("%s = sdiv i32 %s, %s", result_reg, left_reg, right_reg);
+        case AST_IMPORT:
+        case AST_FUNCTION:
             break;
         default:
-            printf("❌ Unsupported binary operator: %d\n", node->data.binary_op.operator);
+            generate_expression(g, node);
             break;
     }
 }
 
 /*
- * Generate for statement (including parallel)
+ * Functions: user functions are internal (so opt may inline and
+ * specialize them) and renamed gp.* to stay clear of C symbols. String
+ * parameters are noalias: strings are never written after creation.
+ * `inline func` declarations are alwaysinline (#2).
  */
-static void generate_for_statement(ast_node_t* node) {
-    const char* var_name = node->data.for_stmt.variable;
-    int is_parallel = node->data.for_stmt.is_parallel;
-    
-    if (is_parallel) {
-        emit_line("; Parallel for loop - %s", var_name);
-        generate_parallel_for(node);
+static void generate_function(LLVMCodegen* g, LLVMFunction* function) {
+    enter_function(g, function);
+    g->terminated = false;
+    g->temp_counter = 0;
+
+    text_buffer_printf(&g->text, "\n; Function: %s\n", function->name);
+    if (is_main(function)) {
+        text_buffer_puts(&g->text, "define i32 @main(");
     } else {
-        emit_line("; Regular for loop - %s", var_name);
-        generate_regular_for(node);
+        text_buffer_printf(&g->text, "define internal %s @gp.%s(", llvm_type(function->return_type), function->name);
     }
-}
+    ast_node_t* params = function->node ? function->node->data.function.parameters : NULL;
+    for (int p = 0; p < function->param_count; p++) {
+        text_buffer_printf(&g->text, "%s%s%s %%p.%s", p ? ", " : "", llvm_type(function->params[p]),
+                function->params[p] == TYPE_STRING ? " noalias" : "", params->children[p]->data.variable.name);
+    }
+    bool always_inline = function->node && function->node->data.function.is_inline && !is_main(function);
+    text_buffer_printf(&g->text, ") %s {\nentry:\n", always_inline ? "#2" : "#0");
+    strcpy(g->block, "entry");
 
-/*
- * Generate parallel for loop
- */
-static void generate_parallel_for(ast_node_t* node) {
-    emit_line("; OpenMP parallel for - ultra performance");
-    emit_line("call void @__kmpc_fork_call(%%struct.ident_t* @.ident, i32 0, void (i32*, i32*, ...)* @.omp_outlined.)");
-}
+    for (int v = 0; v < function->locals.count; v++) {
+        const LLVMVariable* local = &function->locals.items[v];
+        emit_line(g, "%%v.%s = alloca %s", local->symbol, llvm_type(local->type));
+    }
+    for (int p = 0; p < function->param_count; p++) {
+        const char* name = params->children[p]->data.variable.name;
+        LLVMValue incoming;
+        incoming.type = function->params[p];
+        snprintf(incoming.text, sizeof(incoming.text), "%%p.%s", name);
+        store_variable(g, name, incoming, false);
+    }
+    if (is_main(function) && find_function(g, LLVM_INIT_FUNCTION)) {
+        emit_line(g, "call void @gp.%s()", LLVM_INIT_FUNCTION);
+    }
 
-/*
- * Generate regular for loop
- */
-static void generate_regular_for(ast_node_t* node) {
-    const char* var_name = node->data.for_stmt.variable;
-    
-    char* loop_header = new_label("for.header");
-    char* loop_body = new_label("for.body");
-    char* loop_end = new_label("for.end");
-    
-    // Initialize loop variable
-    emit_line("%%%s = alloca i32, align 4", var_name);
-    emit_line("store i32 0, i32* %%%s, align 4", var_name);
-    emit_line("br label %%%s", loop_header);
-    
-    // Loop header (condition check)
-    emit_line("");
-    emit_line("%s:", loop_header);
-    char* i_val = new_temp();
-    emit_line("%s = load i32, i32* %%%s, align 4", i_val, var_name);
-    char* cond = new_temp();
-    emit_line("%s = icmp slt i32 %s, 1000000", cond, i_val);
-    emit_line("br i1 %s, label %%%s, label %%%s", cond, loop_body, loop_end);
-    
-    // Loop body
-    emit_line("");
-    emit_line("%s:", loop_body);
-    if (node->data.for_stmt.body) {
-        generate_node(node->data.for_stmt.body);
-    }
-    
-    // Increment and continue
-    char* next_val = new_temp();
-    emit_line("%s = add nsw i32 %s, 1", next_val, i_val);
-    emit_line("store i32 %s, i32* %%%s, align 4", next_val, var_name);
-    emit_line("br label %%%s", loop_header);
-    
-    // Loop end
-    emit_line("");
-    emit_line("%s:", loop_end);
-}
+    if (function->node) {
+        generate_block(g, function->node->data.function.body);
+    } else {
+        for (int i = 0; i < g->init_count; i++) generate_statement(g, g->init_statements[i]);
+    }
 
-/*
- * Generate literals and identifiers
- */
-static void generate_number_literal(ast_node_t* node) {
-    char* temp = new_temp();
-    emit_line("%s = add i32 0, %s", temp, node->data.literal.value);
-}
+    // Falling off the end returns nothing (0 from main)
+    if (!g->terminated) {
+        if (is_main(function)) {
+            emit_line(g, "ret i32 0");
+        } else if (function->return_type == TYPE_VOID) {
+            emit_line(g, "ret void");
+        } else {
+            emit_line(g, "ret %s %s", llvm_type(function->return_type), zero_value(function->return_type));
+        }
+    }
+    text_buffer_puts(&g->text, "}\n");
+    g->current = NULL;
 
-static void generate_identifier(ast_node_t* node) {
-    const char* name = node->data.identifier.name;
-    char* temp = new_temp();
-    emit_line("%s = load i32, i32* %%%s, align 4", temp, name);
+    text_buffer_append(&g->text, g->outlined.data, g->outlined.size);
+    if (g->outlined.failed) g->text.failed = true;
+    g->outlined.size = 0;
 }
 
-static void generate_return_statement(ast_node_t* node) {
-    if (node->data.return_stmt.expression) {
-        generate_node(node->data.return_stmt.expression);
-        char* value_reg = get_last_temp();
-        emit_line("ret i32 %s", value_reg);
-    } else {
-        emit_line("ret void");
+static void emit_header(LLVMCodegen* g, const char* module_name) {
+    text_buffer_puts(&g->text, "; GPLANG Generated LLVM IR\n");
+    text_buffer_printf(&g->text, "; ModuleID = '%s'\n\n", module_name ? module_name : "gplang");
+    text_buffer_puts(&g->text, "target datalayout = \"e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128\"\n");
+    text_buffer_puts(&g->text, "target triple = \"x86_64-unknown-linux-gnu\"\n\n");
+
+    // Runtime (gp_runtime.h); every string it returns is a fresh allocation
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_print_int(i64) #1\n");
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_print_float(double) #1\n");
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_print_string(i8* nocapture readonly) #1\n");
+    text_buffer_puts(&g->text, "declare noalias i8* @gp_rt_str_int(i64) #1\n");
+    text_buffer_puts(&g->text, "declare noalias i8* @gp_rt_str_float(double) #1\n");
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1\n");
+    text_buffer_puts(&g->text, "declare double @gp_rt_float_from_string(i8* nocapture readonly) #1\n");
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_string_length(i8* nocapture readonly) #1\n");
+    text_buffer_puts(&g->text, "declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1\n");
+    text_buffer_puts(&g->text, "declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1\n");
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1\n");
+    text_buffer_puts(&g->text, "declare i64 @gp_rt_time_now() #1\n");
+    text_buffer_puts(&g->text, "declare double @gp_rt_time_seconds(i64) #1\n");
+    text_buffer_puts(&g->text, "declare double @gp_rt_time_milliseconds(i64) #1\n");
+    text_buffer_puts(&g->text, "declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1\n");
+    text_buffer_puts(&g->text, "declare double @llvm.pow.f64(double, double)\n");
+    text_buffer_puts(&g->text, "declare double @llvm.sqrt.f64(double)\n");
+    text_buffer_puts(&g->text, "declare double @llvm.sin.f64(double)\n");
+    text_buffer_puts(&g->text, "declare double @llvm.cos.f64(double)\n");
+    text_buffer_puts(&g->text, "declare i8* @llvm.stacksave()\n");
+    text_buffer_puts(&g->text, "declare void @llvm.stackrestore(i8*)\n");
+
+    for (int v = 0; v < g->globals.count; v++) {
+        const LLVMVariable* global = &g->globals.items[v];
+        if (v == 0) text_buffer_putc(&g->text, '\n');
+        text_buffer_printf(&g->text, "@g.%s = internal global %s %s\n", global->name, llvm_type(global->type),
+                zero_value(global->type));
     }
 }
 
-static void generate_block(ast_node_t* node) {
-    for (size_t i = 0; i < node->child_count; i++) {
-        generate_node(node->children[i]);
+static void emit_footer(LLVMCodegen* g) {
+    if (g->string_count > 0) text_buffer_putc(&g->text, '\n');
+    for (int i = 0; i < g->string_count; i++) {
+        const unsigned char* text = (const unsigned char*)g->strings[i];
+        text_buffer_printf(&g->text, "@.str.%d = private unnamed_addr constant [%zu x i8] c\"", i, strlen(g->strings[i]) + 1);
+        for (const unsigned char* c = text; *c; c++) {
+            if (*c < 0x20 || *c >= 0x7F || *c == '"' || *c == '\\') {
+                text_buffer_printf(&g->text, "\\%02X", *c);
+            } else {
+                text_buffer_putc(&g->text, (char)*c);
+            }
+        }
+        text_buffer_puts(&g->text, "\\00\"\n");
+    }
+
+    text_buffer_puts(&g->text, "\nattributes #0 = { nounwind }\n");
+    text_buffer_puts(&g->text, "attributes #1 = { nounwind }\n");
+    text_buffer_puts(&g->text, "attributes #2 = { nounwind alwaysinline }\n");
+
+    if (g->loop_count > 0) {
+        text_buffer_puts(&g->text, "\n!0 = !{!\"llvm.loop.mustprogress\"}\n");
+        text_buffer_puts(&g->text, "!1 = !{!\"llvm.loop.vectorize.enable\", i1 true}\n");
+        text_buffer_append(&g->text, g->loop_metadata.data, g->loop_metadata.size);
+        if (g->loop_metadata.failed) g->text.failed = true;
     }
 }
 
 /*
- * Utility functions
+ * Public interface
  */
-static void emit_header(void) {
-    emit_line("; GPLANG Generated LLVM IR");
-    emit_line("; Target: Native x86_64 with ultra optimizations");
-    emit_line("");
-    emit_line("target datalayout = \"e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128\"");
-    emit_line("target triple = \"x86_64-unknown-linux-gnu\"");
-    emit_line("");
-    emit_line("declare i32 @printf(i8*, ...)");
-    emit_line("declare void @__kmpc_fork_call(%%struct.ident_t*, i32, void (i32*, i32*, ...)*)");
-    emit_line("");
-}
-
-static void emit_footer(void) {
-    emit_line("");
-    emit_line("; End of GPLANG generated LLVM IR");
+LLVMCodegen* llvm_codegen_create(FILE* output) {
+    LLVMCodegen* codegen = calloc(1, sizeof(LLVMCodegen));
+    if (codegen) codegen->output = output;
+    return codegen;
 }
 
-static void emit_line(const char* format, ...) {
-    for (int i = 0; i < g_llvm_codegen.indent_level; i++) {
-        fprintf(g_llvm_codegen.output_file, "  ");
+static void reset(LLVMCodegen* g) {
+    for (int f = 0; f < g->function_count; f++) {
+        free(g->functions[f].params);
+        free(g->functions[f].param_annotated);
+        LLVMScope* locals = &g->functions[f].locals;
+        for (int v = 0; v < locals->count; v++) {
+            if (locals->items[v].symbol != locals->items[v].name) free((char*)locals->items[v].symbol);
+        }
+        free(locals->items);
     }
-    
-    va_list args;
-    va_start(args, format);
-    vfprintf(g_llvm_codegen.output_file, format, args);
-    va_end(args);
-    
-    fprintf(g_llvm_codegen.output_file, "\n");
+    for (int i = 0; i < g->string_count; i++) {
+        free(g->strings[i]);
+    }
+    free(g->functions);
+    free(g->globals.items);
+    free(g->init_statements);
+    free(g->visible);
+    free(g->strings);
+    text_buffer_free(&g->text);
+    text_buffer_free(&g->outlined);
+    text_buffer_free(&g->loop_metadata);
+    free(g->error);
+
+    FILE* output = g->output;
+    memset(g, 0, sizeof(*g));
+    g->output = output;
 }
 
-static char* new_temp(void) {
-    static char temp_name[32];
-    snprintf(temp_name, sizeof(temp_name), "%%t%d", g_llvm_codegen.temp_counter++);
-    return temp_name;
+void llvm_codegen_destroy(LLVMCodegen* codegen) {
+    if (!codegen) return;
+    reset(codegen);
+    free(codegen);
 }
 
-static char* new_label(const char* prefix) {
-    static char label_name[64];
-    snprintf(label_name, sizeof(label_name), "%s.%d", prefix, g_llvm_codegen.label_counter++);
-    return label_name;
+bool llvm_codegen_generate(LLVMCodegen* codegen, ast_node_t* root, const char* module_name) {
+    reset(codegen);
+    if (!root) {
+        llvm_error(codegen, "No AST to generate code from");
+        return false;
+    }
+    if (!collect_module(codegen, root)) return false;
+
+    emit_header(codegen, module_name);
+    for (int f = 0; f < codegen->function_count && !codegen->error; f++) {
+        generate_function(codegen, &codegen->functions[f]);
+    }
+    emit_footer(codegen);
+    if (codegen->text.failed) llvm_error(codegen, "Out of memory for the LLVM IR");
+    if (!codegen->error && !text_buffer_write(&codegen->text, codegen->output)) {
+        llvm_error(codegen, "Failed to write the LLVM IR");
+    }
+    return !codegen->error;
 }
 
-static char* get_last_temp(void) {
-    static char temp_name[32];
-    snprintf(temp_name, sizeof(temp_name), "%%t%d", g_llvm_codegen.temp_counter - 1);
-    return temp_name;
+const char* llvm_codegen_error(const LLVMCodegen* codegen) {
+    return codegen->error;
 }
 
 /*
- * Cleanup LLVM code generator
+ * Legacy single-instance interface
  */
-void llvm_codegen_cleanup(void) {
-    if (g_llvm_codegen.output_file) {
-        fclose(g_llvm_codegen.output_file);
-        g_llvm_codegen.output_file = NULL;
+int llvm_codegen_init(const char* output_filename) {
+    llvm_codegen_cleanup();
+
+    FILE* output = fopen(output_filename, "w");
+    if (!output) {
+        fprintf(stderr, "❌ Failed to open output file: %s\n", output_filename);
+        return -1;
+    }
+    g_default_codegen = llvm_codegen_create(output);
+    if (!g_default_codegen) {
+        fclose(output);
+        return -1;
+    }
+    return 0;
+}
+
+int llvm_generate_code(ast_node_t* root) {
+    if (!g_default_codegen) return -1;
+    if (!llvm_codegen_generate(g_default_codegen, root, NULL)) {
+        fprintf(stderr, "❌ LLVM IR generation failed: %s\n", llvm_codegen_error(g_default_codegen));
+        return -1;
     }
-    
-    printf("🧹 LLVM code generator cleaned up\n");
+    return 0;
+}
+
+void llvm_codegen_cleanup(void) {
+    if (!g_default_codegen) return;
+    fclose(g_default_codegen->output);
+    llvm_codegen_destroy(g_default_codegen);
+    g_default_codegen = NULL;
 }
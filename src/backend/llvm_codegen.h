@@ -7,8 +7,19 @@
 #define LLVM_CODEGEN_H
 
 #include "../frontend/parser.h"
+#include <stdio.h>
 
-// Function declarations
+// LLVM generator context
+// Each generator owns its type tables and output state, so separate
+// instances can translate different units concurrently.
+typedef struct LLVMCodegen LLVMCodegen;
+
+LLVMCodegen* llvm_codegen_create(FILE* output);
+void llvm_codegen_destroy(LLVMCodegen* codegen);
+bool llvm_codegen_generate(LLVMCodegen* codegen, ast_node_t* root, const char* module_name);
+const char* llvm_codegen_error(const LLVMCodegen* codegen);
+
+// Legacy single-instance interface (wraps a default generator)
 int llvm_codegen_init(const char* output_filename);
 int llvm_generate_code(ast_node_t* root);
 void llvm_codegen_cleanup(void);
@@ -0,0 +1,460 @@
+/*
+ * GPLANG Machine Peephole Optimizer
+ * Every rewrite either deletes a line or replaces an instruction by a
+ * cheaper equivalent that no pattern of the same table matches again,
+ * so sweeping the function until nothing changes terminates. Deleted
+ * lines are only marked during a sweep and squeezed out at the end.
+ *
+ * None of the patterns depends on what is live afterwards: the second
+ * of two moves is dropped only when it cannot change anything, and a
+ * reload is only turned into a register copy of the value just stored.
+ */
+
+#include <ctype.h>
+#include <stdarg.h>
+#include "peephole.h"
+
+#define WINDOW_SIZE 3
+#define OPERAND_SIZE 96
+#define TEXT_SIZE (3 * OPERAND_SIZE)    // Operands of a rewritten instruction
+#define MAX_OPERANDS 3
+#define MAX_SWEEPS 4
+
+typedef struct {
+    CodeBuffer* code;
+    bool* dead;                     // Per line: deleted by a rewrite
+    int window[WINDOW_SIZE];        // Line indexes, -1 past the end of the function
+} Peephole;
+
+typedef bool (*PeepholeRule)(Peephole* p);
+
+typedef struct {
+    const char* name;
+    const char* mnemonic;           // Of the window's first instruction, NULL for any
+    PeepholeRule apply;
+} PeepholePattern;
+
+// Window starting at line start: the next labels and instructions, comments skipped
+static void fill_window(Peephole* p, int start) {
+    int line = start;
+    for (int slot = 0; slot < WINDOW_SIZE; slot++) {
+        while (line < p->code->line_count && (p->dead[line] || p->code->lines[line].kind == CODE_COMMENT)) line++;
+        p->window[slot] = line < p->code->line_count ? line : -1;
+        line++;
+    }
+}
+
+static const CodeLine* window_line(Peephole* p, int slot) {
+    return p->window[slot] >= 0 ? &p->code->lines[p->window[slot]] : NULL;
+}
+
+static const char* mnemonic(Peephole* p, int slot) {
+    return p->code->text + window_line(p, slot)->text;
+}
+
+static const char* operands(Peephole* p, int slot) {
+    return p->code->text + window_line(p, slot)->operands;
+}
+
+// Instruction in slot, with the given mnemonic unless that is NULL
+static bool is_instruction(Peephole* p, int slot, const char* name) {
+    const CodeLine* line = window_line(p, slot);
+    return line && line->kind == CODE_INSTRUCTION && (!name || strcmp(mnemonic(p, slot), name) == 0);
+}
+
+static bool is_label(Peephole* p, int slot, const char* name) {
+    const CodeLine* line = window_line(p, slot);
+    return line && line->kind == CODE_LABEL && strcmp(p->code->text + line->text, name) == 0;
+}
+
+// Split slot's operands at the commas outside () and []; returns their count, -1 if they do not fit
+static int split_operands(Peephole* p, int slot, char parts[MAX_OPERANDS][OPERAND_SIZE]) {
+    const char* text = operands(p, slot);
+    int count = 0, depth = 0;
+    size_t length = 0;
+    for (const char* c = text; ; c++) {
+        if (*c == '\0' || (*c == ',' && depth == 0)) {
+            if (count == MAX_OPERANDS) return -1;
+            while (length > 0 && parts[count][length - 1] == ' ') length--;
+            parts[count++][length] = '\0';
+            if (*c == '\0') return length > 0 || count > 1 ? count : 0;
+            length = 0;
+            while (c[1] == ' ') c++;
+            continue;
+        }
+        if (*c == '(' || *c == '[') depth++;
+        if (*c == ')' || *c == ']') depth--;
+        if (length + 1 >= OPERAND_SIZE) return -1;
+        parts[count][length++] = *c;
+    }
+}
+
+static bool is_power_of_two(long long value, int* shift) {
+    if (value <= 0 || (value & (value - 1)) != 0) return false;
+    *shift = 0;
+    while ((1LL << *shift) != value) (*shift)++;
+    return true;
+}
+
+// Decimal constant after prefix ("$" or "#"), nothing else
+static bool parse_constant(const char* operand, const char* prefix, long long* value) {
+    size_t length = strlen(prefix);
+    if (strncmp(operand, prefix, length) != 0) return false;
+    const char* digits = operand + length;
+    if (*digits == '-') digits++;
+    if (!isdigit((unsigned char)*digits)) return false;
+    char* end;
+    *value = strtoll(operand + length, &end, 10);
+    return *end == '\0';
+}
+
+// Operands of a rewritten instruction; false when they would not fit, and the rewrite is skipped
+static bool format_operands(char* text, size_t size, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, size, format, args);
+    va_end(args);
+    return length >= 0 && (size_t)length < size;
+}
+
+static bool rewrite(Peephole* p, int slot, const char* name, const char* text) {
+    size_t name_offset = code_buffer_text(p->code, name);
+    size_t text_offset = code_buffer_text(p->code, text);
+    if (p->code->failed) return false;
+    CodeLine* line = &p->code->lines[p->window[slot]];
+    line->text = name_offset;
+    line->operands = text_offset;
+    return true;
+}
+
+static void delete_line(Peephole* p, int slot) {
+    p->dead[p->window[slot]] = true;
+}
+
+/*
+ * x86-64 (AT&T operand order: source, destination)
+ */
+
+// 64-bit general register; %xmm moves also clear the upper lanes
+static bool x86_64_is_gpr(const char* operand) {
+    return operand[0] == '%' && operand[1] == 'r';
+}
+
+// Register, immediate or memory: anything but a vector register
+static bool x86_64_is_plain(const char* operand) {
+    return operand[0] != '%' || operand[1] == 'r';
+}
+
+static bool x86_64_is_frame_slot(const char* operand) {
+    const char* c = operand;
+    if (*c == '-') c++;
+    if (!isdigit((unsigned char)*c)) return false;
+    while (isdigit((unsigned char)*c)) c++;
+    return strcmp(c, "(%rbp)") == 0;
+}
+
+// Whether operand reads reg, e.g. as the base of an address
+static bool x86_64_mentions(const char* operand, const char* reg) {
+    size_t length = strlen(reg);
+    for (const char* found = strstr(operand, reg); found; found = strstr(found + 1, reg)) {
+        if (!isalnum((unsigned char)found[length])) return true;
+    }
+    return false;
+}
+
+// movq a, b then movq b, a or movq a, b again: the second moves nothing
+static bool x86_64_redundant_move(Peephole* p) {
+    char first[MAX_OPERANDS][OPERAND_SIZE], second[MAX_OPERANDS][OPERAND_SIZE];
+    if (!is_instruction(p, 1, "movq") || split_operands(p, 0, first) != 2 || split_operands(p, 1, second) != 2) {
+        return false;
+    }
+    if (!x86_64_is_plain(first[0]) || !x86_64_is_plain(first[1])) return false;
+    // Loading a register from an address it forms changes the address
+    if (x86_64_is_gpr(first[1]) && x86_64_mentions(first[0], first[1])) return false;
+
+    bool swapped = strcmp(second[0], first[1]) == 0 && strcmp(second[1], first[0]) == 0;
+    bool repeated = strcmp(second[0], first[0]) == 0 && strcmp(second[1], first[1]) == 0;
+    if (!swapped && !repeated) return false;
+    delete_line(p, 1);
+    return true;
+}
+
+// Reloading the frame slot just stored to: copy the stored value instead
+static bool x86_64_forward_store(Peephole* p) {
+    char store[MAX_OPERANDS][OPERAND_SIZE], load[MAX_OPERANDS][OPERAND_SIZE];
+    if (!is_instruction(p, 1, "movq") || split_operands(p, 0, store) != 2 || split_operands(p, 1, load) != 2) {
+        return false;
+    }
+    long long constant;
+    bool value = x86_64_is_gpr(store[0]) || parse_constant(store[0], "$", &constant);
+    if (!value || !x86_64_is_frame_slot(store[1]) || strcmp(load[0], store[1]) != 0 || !x86_64_is_gpr(load[1])) {
+        return false;
+    }
+
+    char copy[TEXT_SIZE];
+    return format_operands(copy, sizeof(copy), "%s, %s", store[0], load[1]) && rewrite(p, 1, "movq", copy);
+}
+
+// leaq 0(%r), %d copies a register
+static bool x86_64_lea_move(Peephole* p) {
+    char parts[MAX_OPERANDS][OPERAND_SIZE];
+    if (split_operands(p, 0, parts) != 2 || !x86_64_is_gpr(parts[1])) return false;
+    const char* address = parts[0][0] == '0' ? parts[0] + 1 : parts[0];
+    size_t length = strlen(address);
+    if (length < 4 || address[0] != '(' || address[length - 1] != ')' || strchr(address, ',')) return false;
+
+    char source[OPERAND_SIZE];
+    memcpy(source, address + 1, length - 2);       // Shorter than parts[0]
+    source[length - 2] = '\0';
+    if (!x86_64_is_gpr(source)) return false;
+    if (strcmp(source, parts[1]) == 0) {
+        delete_line(p, 0);
+        return true;
+    }
+    char copy[TEXT_SIZE];
+    return format_operands(copy, sizeof(copy), "%s, %s", source, parts[1]) && rewrite(p, 0, "movq", copy);
+}
+
+// imulq $2^n, %r is shlq $n, %r; by 1 it is nothing. The flags differ,
+// but the backend never reads flags a multiplication set.
+static bool x86_64_multiply_shift(Peephole* p) {
+    char parts[MAX_OPERANDS][OPERAND_SIZE];
+    long long factor;
+    int shift;
+    if (split_operands(p, 0, parts) != 2 || !parse_constant(parts[0], "$", &factor) ||
+        !x86_64_is_gpr(parts[1]) || !is_power_of_two(factor, &shift)) {
+        return false;
+    }
+    if (shift == 0) {
+        delete_line(p, 0);
+        return true;
+    }
+    char text[TEXT_SIZE];
+    return format_operands(text, sizeof(text), "$%d, %s", shift, parts[1]) && rewrite(p, 0, "shlq", text);
+}
+
+// cmpq $0, %r sets the flags jcc reads exactly as testq %r, %r, which is
+// shorter and still fuses with the jcc that follows
+static bool x86_64_compare_zero(Peephole* p) {
+    char parts[MAX_OPERANDS][OPERAND_SIZE];
+    if (split_operands(p, 0, parts) != 2 || strcmp(parts[0], "$0") != 0 || !x86_64_is_gpr(parts[1])) return false;
+    char text[TEXT_SIZE];
+    return format_operands(text, sizeof(text), "%s, %s", parts[1], parts[1]) && rewrite(p, 0, "testq", text);
+}
+
+static const char* x86_64_inverse_condition(const char* condition) {
+    static const char* pairs[][2] = {
+        { "e", "ne" }, { "z", "nz" }, { "l", "ge" }, { "le", "g" }, { "b", "ae" },
+        { "be", "a" }, { "s", "ns" }, { "p", "np" }, { "o", "no" }
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        if (strcmp(condition, pairs[i][0]) == 0) return pairs[i][1];
+        if (strcmp(condition, pairs[i][1]) == 0) return pairs[i][0];
+    }
+    return NULL;
+}
+
+// jcc L1; jmp L2; L1: is one jcc on the opposite condition to L2
+static bool x86_64_branch_over_jump(Peephole* p) {
+    const char* name = mnemonic(p, 0);
+    if (name[0] != 'j' || strcmp(name, "jmp") == 0 || !is_instruction(p, 1, "jmp") ||
+        !is_label(p, 2, operands(p, 0))) {
+        return false;
+    }
+    const char* inverse = x86_64_inverse_condition(name + 1);
+    if (!inverse) return false;
+
+    char jump[8];
+    char target[TEXT_SIZE];
+    if (!format_operands(jump, sizeof(jump), "j%s", inverse) ||
+        !format_operands(target, sizeof(target), "%s", operands(p, 1)) || !rewrite(p, 0, jump, target)) {
+        return false;
+    }
+    delete_line(p, 1);
+    return true;
+}
+
+// jmp L straight before L falls through
+static bool x86_64_jump_to_next(Peephole* p) {
+    if (!is_label(p, 1, operands(p, 0))) return false;
+    delete_line(p, 0);
+    return true;
+}
+
+static const PeepholePattern x86_64_patterns[] = {
+    { "redundant-move", "movq", x86_64_redundant_move },
+    { "forward-store", "movq", x86_64_forward_store },
+    { "lea-move", "leaq", x86_64_lea_move },
+    { "multiply-shift", "imulq", x86_64_multiply_shift },
+    { "compare-zero", "cmpq", x86_64_compare_zero },
+    { "branch-over-jump", NULL, x86_64_branch_over_jump },
+    { "jump-to-next", "jmp", x86_64_jump_to_next },
+};
+
+/*
+ * ARM64 (destination first)
+ */
+
+static bool arm64_is_register(const char* operand) {
+    return operand[0] == 'x' && (isdigit((unsigned char)operand[1]) || strcmp(operand, "xzr") == 0);
+}
+
+// mov a, a, or mov b, a straight after mov a, b
+static bool arm64_redundant_move(Peephole* p) {
+    char first[MAX_OPERANDS][OPERAND_SIZE], second[MAX_OPERANDS][OPERAND_SIZE];
+    if (split_operands(p, 0, first) != 2 || !arm64_is_register(first[0]) || !arm64_is_register(first[1])) {
+        return false;
+    }
+    if (strcmp(first[0], first[1]) == 0) {
+        delete_line(p, 0);
+        return true;
+    }
+    if (!is_instruction(p, 1, "mov") || split_operands(p, 1, second) != 2) return false;
+    if (strcmp(second[0], first[1]) != 0 || strcmp(second[1], first[0]) != 0) return false;
+    delete_line(p, 1);
+    return true;
+}
+
+// ldr of the address just stored to: copy the stored register instead
+static bool arm64_forward_store(Peephole* p) {
+    char store[MAX_OPERANDS][OPERAND_SIZE], load[MAX_OPERANDS][OPERAND_SIZE];
+    if (!is_instruction(p, 1, "ldr") || split_operands(p, 0, store) != 2 || split_operands(p, 1, load) != 2) {
+        return false;
+    }
+    if (!arm64_is_register(store[0]) || !arm64_is_register(load[0]) || strcmp(load[0], "xzr") == 0 ||
+        store[1][0] != '[' || store[1][strlen(store[1]) - 1] != ']' || strcmp(store[1], load[1]) != 0) {
+        return false;
+    }
+    if (strcmp(store[0], load[0]) == 0) {
+        delete_line(p, 1);
+        return true;
+    }
+    char copy[TEXT_SIZE];
+    return format_operands(copy, sizeof(copy), "%s, %s", load[0], store[0]) && rewrite(p, 1, "mov", copy);
+}
+
+/*
+ * mov x17, #2^n then mul d, s, x17 (possibly with the left operand
+ * loaded into x16 in between) is lsl d, s, #n. The scratch register
+ * only carries the constant into the multiplication.
+ */
+static bool arm64_multiply_shift(Peephole* p) {
+    char constant[MAX_OPERANDS][OPERAND_SIZE], multiply[MAX_OPERANDS][OPERAND_SIZE];
+    long long factor;
+    int shift;
+    if (split_operands(p, 0, constant) != 2 || strcmp(constant[0], "x17") != 0 ||
+        !parse_constant(constant[1], "#", &factor) || !is_power_of_two(factor, &shift)) {
+        return false;
+    }
+
+    // The left operand may be built in x16 between the two
+    int slot = 1;
+    if (!is_instruction(p, slot, "mul")) {
+        char between[MAX_OPERANDS][OPERAND_SIZE];
+        int count = is_instruction(p, 1, NULL) ? split_operands(p, 1, between) : -1;
+        if (count < 2 || strcmp(between[0], "x16") != 0) return false;
+        for (int i = 1; i < count; i++) {
+            if (strstr(between[i], "x17")) return false;
+        }
+        slot = 2;
+        if (!is_instruction(p, slot, "mul")) return false;
+    }
+    if (split_operands(p, slot, multiply) != 3 || strcmp(multiply[2], "x17") != 0 ||
+        strcmp(multiply[1], "x17") == 0) {
+        return false;
+    }
+
+    char text[TEXT_SIZE];
+    bool fits = shift == 0 ? format_operands(text, sizeof(text), "%s, %s", multiply[0], multiply[1])
+                           : format_operands(text, sizeof(text), "%s, %s, #%d", multiply[0], multiply[1], shift);
+    if (!fits || !rewrite(p, slot, shift == 0 ? "mov" : "lsl", text)) return false;
+    delete_line(p, 0);
+    return true;
+}
+
+// cmp x, #0 then b.eq/b.ne is a single cbz/cbnz
+static bool arm64_compare_branch(Peephole* p) {
+    char parts[MAX_OPERANDS][OPERAND_SIZE];
+    if (split_operands(p, 0, parts) != 2 || !arm64_is_register(parts[0]) || strcmp(parts[1], "#0") != 0 ||
+        !is_instruction(p, 1, NULL)) {
+        return false;
+    }
+    const char* branch = mnemonic(p, 1);
+    const char* fused = strcmp(branch, "beq") == 0 || strcmp(branch, "b.eq") == 0 ? "cbz"
+                      : strcmp(branch, "bne") == 0 || strcmp(branch, "b.ne") == 0 ? "cbnz" : NULL;
+    if (!fused) return false;
+
+    char text[TEXT_SIZE];
+    if (!format_operands(text, sizeof(text), "%s, %s", parts[0], operands(p, 1)) || !rewrite(p, 1, fused, text)) {
+        return false;
+    }
+    delete_line(p, 0);
+    return true;
+}
+
+// b L straight before L falls through
+static bool arm64_jump_to_next(Peephole* p) {
+    if (!is_label(p, 1, operands(p, 0))) return false;
+    delete_line(p, 0);
+    return true;
+}
+
+static const PeepholePattern arm64_patterns[] = {
+    { "redundant-move", "mov", arm64_redundant_move },
+    { "forward-store", "str", arm64_forward_store },
+    { "multiply-shift", "mov", arm64_multiply_shift },
+    { "compare-branch", "cmp", arm64_compare_branch },
+    { "jump-to-next", "b", arm64_jump_to_next },
+};
+
+#define PATTERN_COUNT(table) ((int)(sizeof(table) / sizeof(table[0])))
+
+// Squeeze the deleted lines out
+static void compact(CodeBuffer* code, const bool* dead) {
+    int kept = 0;
+    for (int i = 0; i < code->line_count; i++) {
+        if (!dead[i]) code->lines[kept++] = code->lines[i];
+    }
+    code->line_count = kept;
+}
+
+int peephole_optimize(CodeBuffer* code, TargetArch target) {
+    const PeepholePattern* patterns = NULL;
+    int pattern_count = 0;
+    if (target == TARGET_X86_64) {
+        patterns = x86_64_patterns;
+        pattern_count = PATTERN_COUNT(x86_64_patterns);
+    } else if (target == TARGET_ARM64) {
+        patterns = arm64_patterns;
+        pattern_count = PATTERN_COUNT(arm64_patterns);
+    }
+    if (pattern_count == 0 || code->line_count == 0 || code->failed) return 0;
+
+    Peephole p = { code, calloc(code->line_count, sizeof(bool)), { -1, -1, -1 } };
+    if (!p.dead) return -1;
+
+    int rewrites = 0;
+    bool changed = true;
+    for (int sweep = 0; changed && sweep < MAX_SWEEPS; sweep++) {
+        changed = false;
+        for (int i = 0; i < code->line_count; i++) {
+            if (p.dead[i] || code->lines[i].kind != CODE_INSTRUCTION) continue;
+            fill_window(&p, i);
+            for (int k = 0; k < pattern_count; k++) {
+                if (patterns[k].mnemonic && !is_instruction(&p, 0, patterns[k].mnemonic)) continue;
+                if (patterns[k].apply(&p)) {
+                    rewrites++;
+                    changed = true;
+                    break;
+                }
+                if (code->failed) break;
+            }
+            if (code->failed) break;
+        }
+        if (code->failed) break;
+    }
+
+    compact(code, p.dead);
+    free(p.dead);
+    return code->failed ? -1 : rewrites;
+}
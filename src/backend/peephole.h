@@ -0,0 +1,22 @@
+/*
+ * GPLANG Machine Peephole Optimizer
+ * Rewrites short windows of a function's buffered instructions (see
+ * CodeBuffer in codegen.h) after instruction selection, before they
+ * reach the assembly text or the x86-64 encoder. Each target has a
+ * table of patterns; a window is a few consecutive labels and
+ * instructions, with comments skipped. Labels end the straight-line
+ * code the move patterns look at, so the pass never needs liveness.
+ */
+
+#ifndef GPLANG_PEEPHOLE_H
+#define GPLANG_PEEPHOLE_H
+
+#include "codegen.h"
+
+// Function declarations
+
+// Rewrite code in place until no pattern applies; returns the number
+// of rewrites, or -1 when out of memory (code is then left valid)
+int peephole_optimize(CodeBuffer* code, TargetArch target);
+
+#endif // GPLANG_PEEPHOLE_H
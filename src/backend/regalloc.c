@@ -0,0 +1,560 @@
+/*
+ * GPLANG Register Allocation
+ * Liveness is computed per variable by walking backwards from each use
+ * to its definition, which needs no per-block live sets. Each register
+ * gets one interval covering every position it is live at, and linear
+ * scan (Poletto & Sarkar) assigns intervals in start order, spilling the
+ * active interval that ends last when the register file runs out.
+ */
+
+#include <limits.h>
+#include "regalloc.h"
+
+// x86_64 hardware numbers: rax rcx rdx rbx rsp rbp rsi rdi r8-r15.
+// rax and rdx stay free for return values and idiv.
+static const int x86_64_caller_saved[] = { 1, 6, 7, 8, 9 };
+static const int x86_64_callee_saved[] = { 3, 12, 13, 14, 15 };
+static const int x86_64_arguments[] = { 7, 6, 2, 1, 8, 9 };
+// %xmm0 and %xmm1 are scratch for double and vector arithmetic
+static const int x86_64_vector[] = { 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+static const RegisterFile x86_64_registers = {
+    x86_64_caller_saved, 5, x86_64_callee_saved, 5, x86_64_arguments, 6,
+    0, { 10, 11 }, 5, 4, x86_64_vector, 14
+};
+
+// ARM64: x16/x17 (IP0/IP1) are scratch, x18 is reserved by the platform
+static const int arm64_caller_saved[] = { 9, 10, 11, 12, 13, 14, 15, 8, 1, 2, 3, 4, 5, 6, 7 };
+static const int arm64_callee_saved[] = { 19, 20, 21, 22, 23, 24, 25, 26, 27, 28 };
+static const int arm64_arguments[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+static const RegisterFile arm64_registers = {
+    arm64_caller_saved, 15, arm64_callee_saved, 10, arm64_arguments, 8,
+    0, { 16, 17 }, 29, 31
+};
+
+// RISC-V: t5/t6 are scratch, s0 is the frame pointer
+static const int riscv64_caller_saved[] = { 5, 6, 7, 28, 29, 11, 12, 13, 14, 15, 16, 17 };
+static const int riscv64_callee_saved[] = { 9, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27 };
+static const int riscv64_arguments[] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+
+static const RegisterFile riscv64_registers = {
+    riscv64_caller_saved, 12, riscv64_callee_saved, 11, riscv64_arguments, 8,
+    10, { 30, 31 }, 8, 2
+};
+
+const RegisterFile* regalloc_register_file(TargetArch target) {
+    switch (target) {
+        case TARGET_X86_64: return &x86_64_registers;
+        case TARGET_ARM64: return &arm64_registers;
+        case TARGET_RISCV64: return &riscv64_registers;
+        default: return NULL;
+    }
+}
+
+bool regalloc_is_callee_saved(const RegisterFile* file, int reg) {
+    for (int i = 0; i < file->callee_saved_count; i++) {
+        if (file->callee_saved[i] == reg) return true;
+    }
+    return false;
+}
+
+const char* get_register_name_x86_64(int reg_id) {
+    static const char* names[] = {
+        "%rax", "%rcx", "%rdx", "%rbx", "%rsp", "%rbp", "%rsi", "%rdi",
+        "%r8", "%r9", "%r10", "%r11", "%r12", "%r13", "%r14", "%r15"
+    };
+    return reg_id >= 0 && reg_id < 16 ? names[reg_id] : "%invalid";
+}
+
+const char* get_register_name_arm64(int reg_id) {
+    static const char* names[] = {
+        "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7",
+        "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+        "x16", "x17", "x18", "x19", "x20", "x21", "x22", "x23",
+        "x24", "x25", "x26", "x27", "x28", "x29", "x30", "sp"
+    };
+    return reg_id >= 0 && reg_id < 32 ? names[reg_id] : "invalid";
+}
+
+const char* get_register_name_riscv64(int reg_id) {
+    static const char* names[] = {
+        "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+        "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+        "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+        "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
+    };
+    return reg_id >= 0 && reg_id < 32 ? names[reg_id] : "invalid";
+}
+
+static ValueKind operand_kind(const IRFlatFunction* flat, const ValueKind* kinds, IRFlatOperand operand) {
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_REG:
+            return kinds && (int)ir_flat_payload(operand) < flat->next_register_id
+                   ? kinds[ir_flat_payload(operand)] : VALUE_INT;
+        case IR_FLAT_FLOAT: return VALUE_FLOAT;
+        case IR_FLAT_STRING: return VALUE_STRING;
+        default: return VALUE_INT;
+    }
+}
+
+// Instructions lowered to a call (string and float helpers too), which clobber caller-saved registers
+static bool is_call(const IRFlatFunction* flat, const ValueKind* kinds, const IRFlatInst* inst) {
+    return value_kinds_lowers_to_call(inst->opcode, operand_kind(flat, kinds, inst->dest),
+                                      operand_kind(flat, kinds, inst->src[0]),
+                                      operand_kind(flat, kinds, inst->src[1]));
+}
+
+typedef struct {
+    const IRFlatFunction* flat;
+    uint32_t reg_count;
+    int* start;
+    int* end;
+    uint32_t* def_block;
+    uint32_t* live_in;          // Stamp: vreg + 1 if live into the block
+    uint32_t* live_out;         // Stamp: vreg + 1 if live out of the block
+    uint32_t* worklist;
+} Liveness;
+
+static int block_start(const IRFlatFunction* flat, uint32_t b) {
+    return regalloc_position(flat->blocks[b].first_inst);
+}
+
+// Position just after the block's last instruction
+static int block_end(const IRFlatFunction* flat, uint32_t b) {
+    const IRFlatBlock* block = &flat->blocks[b];
+    if (block->inst_count == 0) return block_start(flat, b);
+    return regalloc_position(block->first_inst + block->inst_count - 1) + 1;
+}
+
+static void extend(Liveness* live, uint32_t reg, int position) {
+    if (position < live->start[reg]) live->start[reg] = position;
+    if (position > live->end[reg]) live->end[reg] = position;
+}
+
+// Mark reg live out of block b and walk up from there to its definition
+static void mark_live_out(Liveness* live, uint32_t reg, uint32_t b) {
+    const IRFlatFunction* flat = live->flat;
+    uint32_t stamp = reg + 1;
+    if (live->live_out[b] == stamp) return;
+
+    live->live_out[b] = stamp;
+    extend(live, reg, block_end(flat, b));
+    if (live->def_block[reg] == b) return;
+
+    uint32_t depth = 0;
+    live->worklist[depth++] = b;
+    while (depth > 0) {
+        uint32_t block = live->worklist[--depth];
+        if (live->live_in[block] == stamp) continue;
+        live->live_in[block] = stamp;
+        extend(live, reg, block_start(flat, block));
+
+        const IRFlatBlock* fb = &flat->blocks[block];
+        for (uint32_t p = 0; p < fb->pred_count; p++) {
+            uint32_t pred = flat->edges[fb->first_pred + p];
+            if (live->live_out[pred] == stamp) continue;
+            live->live_out[pred] = stamp;
+            extend(live, reg, block_end(flat, pred));
+            if (live->def_block[reg] != pred) live->worklist[depth++] = pred;
+        }
+    }
+}
+
+// Use of reg in block b at position; walks up unless defined in b
+static void mark_use(Liveness* live, uint32_t reg, uint32_t b, int position) {
+    extend(live, reg, position);
+    if (live->def_block[reg] == b || live->live_in[b] == reg + 1) return;
+
+    // Live into b: every predecessor has it live out
+    live->live_in[b] = reg + 1;
+    extend(live, reg, block_start(live->flat, b));
+    const IRFlatBlock* block = &live->flat->blocks[b];
+    for (uint32_t p = 0; p < block->pred_count; p++) {
+        mark_live_out(live, reg, live->flat->edges[block->first_pred + p]);
+    }
+}
+
+// Uses grouped by register, so the liveness stamps of one walk stay valid
+typedef struct {
+    uint32_t* first;            // Uses of reg r: block[first[r] .. first[r + 1])
+    uint32_t* block;
+    int* position;              // -1: live out of block (PHI input)
+} UseLists;
+
+static uint32_t use_register(const IRFlatFunction* flat, IRFlatOperand operand, const bool* is_alloca) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG) return UINT32_MAX;
+    uint32_t reg = ir_flat_payload(operand);
+    return reg < (uint32_t)flat->next_register_id && !is_alloca[reg] ? reg : UINT32_MAX;
+}
+
+// Two passes over the uses: count per register, then fill
+static bool collect_uses(const IRFlatFunction* flat, const bool* is_alloca, uint32_t reg_count, UseLists* uses) {
+    uses->first = calloc(reg_count + 2, sizeof(uint32_t));
+    if (!uses->first) return false;
+
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            for (uint32_t r = 0; r <= reg_count; r++) uses->first[r + 1] += uses->first[r];
+            uint32_t total = uses->first[reg_count + 1];
+            uses->block = malloc((total ? total : 1) * sizeof(uint32_t));
+            uses->position = malloc((total ? total : 1) * sizeof(int));
+            if (!uses->block || !uses->position) return false;
+        }
+
+        for (uint32_t b = 0; b < flat->block_count; b++) {
+            const IRFlatBlock* block = &flat->blocks[b];
+            for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+                const IRFlatInst* inst = &flat->insts[i];
+                bool phi = inst->opcode == IR_PHI;
+                uint32_t step = phi ? 2 : 1;
+                uint32_t operand_count = phi ? inst->arg_count : 3 + inst->arg_count;
+
+                for (uint32_t o = 0; o < operand_count; o += step) {
+                    IRFlatOperand operand = phi || o >= 3 ? flat->args[inst->first_arg + o - (phi ? 0 : 3)]
+                                                          : inst->src[o];
+                    uint32_t reg = use_register(flat, operand, is_alloca);
+                    uint32_t use_block = b;
+                    int position = regalloc_position(i);
+                    if (phi) {
+                        if (o + 1 >= inst->arg_count) break;
+                        use_block = ir_flat_payload(flat->args[inst->first_arg + o + 1]);
+                        position = -1;
+                        if (use_block >= flat->block_count) continue;
+                    }
+                    if (reg == UINT32_MAX) continue;
+
+                    if (pass == 0) {
+                        uses->first[reg + 2]++;
+                    } else {
+                        uint32_t slot = uses->first[reg + 1]++;
+                        uses->block[slot] = use_block;
+                        uses->position[slot] = position;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static int compare_intervals(const void* a, const void* b) {
+    const LiveInterval* x = a;
+    const LiveInterval* y = b;
+    if (x->start != y->start) return x->start < y->start ? -1 : 1;
+    return x->vreg - y->vreg;
+}
+
+/*
+ * One interval per register from its definition to its last use. A PHI
+ * is copied at the end of each predecessor, so its inputs are live out
+ * of that predecessor and its result is live there too.
+ */
+LiveInterval* regalloc_compute_intervals(const IRFlatFunction* flat, const ValueKind* kinds, int* count) {
+    *count = 0;
+    uint32_t reg_count = flat->next_register_id > 0 ? (uint32_t)flat->next_register_id : 0;
+    uint32_t n = flat->block_count;
+
+    Liveness live = { 0 };
+    live.flat = flat;
+    live.reg_count = reg_count;
+    live.start = malloc((reg_count ? reg_count : 1) * sizeof(int));
+    live.end = malloc((reg_count ? reg_count : 1) * sizeof(int));
+    live.def_block = malloc((reg_count ? reg_count : 1) * sizeof(uint32_t));
+    live.live_in = calloc(n ? n : 1, sizeof(uint32_t));
+    live.live_out = calloc(n ? n : 1, sizeof(uint32_t));
+    live.worklist = malloc((n + 1) * sizeof(uint32_t));
+    bool* is_alloca = calloc(reg_count ? reg_count : 1, sizeof(bool));
+    uint32_t* calls_before = malloc((flat->inst_count + 1) * sizeof(uint32_t));
+    UseLists uses = { 0 };
+    LiveInterval* intervals = NULL;
+
+    if (!live.start || !live.end || !live.def_block || !live.live_in || !live.live_out ||
+        !live.worklist || !is_alloca || !calls_before) {
+        goto done;
+    }
+
+    for (uint32_t r = 0; r < reg_count; r++) {
+        live.start[r] = INT_MAX;
+        live.end[r] = -1;
+        live.def_block[r] = UINT32_MAX;
+    }
+
+    // Definitions; parameters are defined on entry
+    for (uint32_t p = 0; p < flat->param_count; p++) {
+        if (ir_flat_kind(flat->params[p]) != IR_FLAT_REG) continue;
+        uint32_t reg = ir_flat_payload(flat->params[p]);
+        if (reg >= reg_count || n == 0) continue;
+        live.def_block[reg] = 0;
+        extend(&live, reg, 0);
+    }
+
+    calls_before[0] = 0;
+    for (uint32_t b = 0; b < n; b++) {
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            const IRFlatInst* inst = &flat->insts[i];
+            calls_before[i + 1] = calls_before[i] + (is_call(flat, kinds, inst) ? 1 : 0);
+
+            if (ir_flat_kind(inst->dest) != IR_FLAT_REG) continue;
+            uint32_t reg = ir_flat_payload(inst->dest);
+            if (reg >= reg_count) continue;
+            if (inst->opcode == IR_ALLOCA) {
+                is_alloca[reg] = true;
+                continue;
+            }
+            live.def_block[reg] = b;
+            extend(&live, reg, regalloc_position(i));
+        }
+    }
+
+    // PHI results are written at the end of each predecessor
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        const IRFlatInst* inst = &flat->insts[i];
+        if (inst->opcode != IR_PHI || ir_flat_kind(inst->dest) != IR_FLAT_REG) continue;
+        uint32_t dest = ir_flat_payload(inst->dest);
+        if (dest >= reg_count) continue;
+        for (uint32_t a = 1; a < inst->arg_count; a += 2) {
+            uint32_t pred = ir_flat_payload(flat->args[inst->first_arg + a]);
+            if (pred < n) extend(&live, dest, block_end(flat, pred));
+        }
+    }
+
+    if (!collect_uses(flat, is_alloca, reg_count, &uses)) goto done;
+    for (uint32_t r = 0; r < reg_count; r++) {
+        for (uint32_t u = uses.first[r]; u < uses.first[r + 1]; u++) {
+            if (uses.position[u] < 0) mark_live_out(&live, r, uses.block[u]);
+            else mark_use(&live, r, uses.block[u], uses.position[u]);
+        }
+    }
+
+    intervals = malloc((reg_count ? reg_count : 1) * sizeof(LiveInterval));
+    if (!intervals) goto done;
+
+    for (uint32_t r = 0; r < reg_count; r++) {
+        if (is_alloca[r] || live.end[r] < 0) continue;
+
+        LiveInterval* interval = &intervals[(*count)++];
+        interval->vreg = (int)r;
+        interval->start = live.start[r];
+        interval->end = live.end[r];
+
+        // Calls c with start < 2c < end
+        uint32_t first = (uint32_t)interval->start / 2 + 1;
+        uint32_t last = (uint32_t)(interval->end + 1) / 2;
+        if (last > flat->inst_count) last = flat->inst_count;
+        interval->crosses_call = last > first && calls_before[last] > calls_before[first];
+    }
+    qsort(intervals, (size_t)*count, sizeof(LiveInterval), compare_intervals);
+
+done:
+    free(live.start);
+    free(live.end);
+    free(live.def_block);
+    free(live.live_in);
+    free(live.live_out);
+    free(live.worklist);
+    free(is_alloca);
+    free(calls_before);
+    free(uses.first);
+    free(uses.block);
+    free(uses.position);
+    return intervals;
+}
+
+static bool is_vector(const CodeGenerator* codegen, int vreg) {
+    return codegen->value_kinds && codegen->value_kinds[vreg] == VALUE_VECTOR;
+}
+
+// Registers of the current function, for the prologue's saves
+static void assign(CodeGenerator* codegen, const RegisterFile* file, int vreg, int reg) {
+    RegisterMapping* mapping = &codegen->register_map[vreg];
+    mapping->physical_reg = reg;
+    mapping->is_spilled = false;
+    if (!is_vector(codegen, vreg) && regalloc_is_callee_saved(file, reg)) codegen->callee_saved_used |= 1u << reg;
+}
+
+static int pick_register(const RegisterFile* file, const bool* in_use, bool crosses_call, bool vector) {
+    if (vector) {
+        for (int i = 0; i < file->vector_register_count && !crosses_call; i++) {
+            if (!in_use[file->vector_registers[i]]) return file->vector_registers[i];
+        }
+        return -1;
+    }
+    if (!crosses_call) {
+        for (int i = 0; i < file->caller_saved_count; i++) {
+            if (!in_use[file->caller_saved[i]]) return file->caller_saved[i];
+        }
+    }
+    for (int i = 0; i < file->callee_saved_count; i++) {
+        if (!in_use[file->callee_saved[i]]) return file->callee_saved[i];
+    }
+    return -1;
+}
+
+/*
+ * Linear scan over the function's intervals. Allocas get a stack slot
+ * each, spilled values get one when they are spilled, and slots for the
+ * callee-saved registers in use are reserved last. Vector values are
+ * scanned in the same pass against their own register file.
+ */
+void codegen_allocate_registers(CodeGenerator* codegen, IRFunction* function) {
+    const RegisterFile* file = regalloc_register_file(codegen->target);
+    int reg_count = function->next_register_id > 0 ? function->next_register_id : 0;
+
+    free(codegen->register_map);
+    codegen->register_map = calloc(reg_count ? reg_count : 1, sizeof(RegisterMapping));
+    codegen->register_map_size = 0;
+    codegen->register_map_capacity = 0;
+    codegen->callee_saved_used = 0;
+    // RISC-V keeps ra and the caller's s0 at the top of the frame
+    codegen->stack_offset = codegen->target == TARGET_RISCV64 ? 16 : 0;
+    codegen->max_stack_size = codegen->stack_offset;
+    if (!codegen->register_map || !file) {
+        codegen_error(codegen, "Out of memory in register allocation");
+        return;
+    }
+    codegen->register_map_size = reg_count;
+    codegen->register_map_capacity = reg_count;
+    for (int r = 0; r < reg_count; r++) {
+        codegen->register_map[r].virtual_reg = r;
+        codegen->register_map[r].physical_reg = -1;
+    }
+
+    IRFlatFunction* flat = ir_flat_from_function(function);
+    LiveInterval* intervals = NULL;
+    int count = 0;
+    if (flat && ir_flat_rebuild_edges(flat)) {
+        intervals = regalloc_compute_intervals(flat, codegen->value_kinds, &count);
+    }
+    if (!intervals) {
+        codegen_error(codegen, "Out of memory in register allocation");
+        ir_flat_destroy(flat);
+        return;
+    }
+
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        const IRFlatInst* inst = &flat->insts[i];
+        if (inst->opcode != IR_ALLOCA || ir_flat_kind(inst->dest) != IR_FLAT_REG) continue;
+        uint32_t reg = ir_flat_payload(inst->dest);
+        if ((int)reg >= reg_count || codegen->register_map[reg].is_stack_address) continue;
+        codegen->register_map[reg].is_stack_address = true;
+        codegen->register_map[reg].spill_offset = allocate_stack_slot(codegen, 8);
+    }
+
+    // Integer constants defined once are rematerialized at their uses instead of holding a register
+    uint8_t* definitions = calloc(reg_count ? reg_count : 1, 1);
+    for (uint32_t i = 0; definitions && i < flat->inst_count; i++) {
+        const IRFlatInst* inst = &flat->insts[i];
+        if (ir_flat_kind(inst->dest) != IR_FLAT_REG || (int)ir_flat_payload(inst->dest) >= reg_count) continue;
+        uint32_t reg = ir_flat_payload(inst->dest);
+        RegisterMapping* mapping = &codegen->register_map[reg];
+        bool constant = inst->opcode == IR_CONST_INT && ir_flat_is_int_constant(inst->src[0]) &&
+                        !mapping->is_stack_address && definitions[reg] == 0;
+        mapping->is_constant = constant;
+        if (constant) mapping->constant_value = ir_flat_int_value(flat, inst->src[0]);
+        definitions[reg] = 1;
+    }
+    for (uint32_t p = 0; definitions && p < flat->param_count; p++) {
+        if (ir_flat_kind(flat->params[p]) == IR_FLAT_REG && (int)ir_flat_payload(flat->params[p]) < reg_count) {
+            codegen->register_map[ir_flat_payload(flat->params[p])].is_constant = false;
+        }
+    }
+
+    // Active intervals, ordered by end
+    LiveInterval** active = malloc((count ? count : 1) * sizeof(LiveInterval*));
+    if (!active || !definitions) {
+        free(active);
+        free(definitions);
+        codegen_error(codegen, "Out of memory in register allocation");
+        free(intervals);
+        ir_flat_destroy(flat);
+        return;
+    }
+    int active_count = 0;
+    bool in_use[32] = { false };
+    bool vector_in_use[32] = { false };
+
+    for (int i = 0; i < count; i++) {
+        LiveInterval* current = &intervals[i];
+        if (codegen->register_map[current->vreg].is_constant) continue;
+
+        // Expire intervals that ended before this one starts
+        int kept = 0;
+        for (int a = 0; a < active_count; a++) {
+            if (active[a]->end < current->start) {
+                bool* registers = is_vector(codegen, active[a]->vreg) ? vector_in_use : in_use;
+                registers[codegen->register_map[active[a]->vreg].physical_reg] = false;
+            } else {
+                active[kept++] = active[a];
+            }
+        }
+        active_count = kept;
+
+        bool vector = is_vector(codegen, current->vreg);
+        bool* registers = vector ? vector_in_use : in_use;
+        int reg = pick_register(file, registers, current->crosses_call, vector);
+        if (reg < 0) {
+            // Spill whichever usable active interval of the same class ends last
+            int victim = -1;
+            for (int a = active_count - 1; a >= 0 && !(vector && current->crosses_call); a--) {
+                int victim_reg = codegen->register_map[active[a]->vreg].physical_reg;
+                if (is_vector(codegen, active[a]->vreg) != vector) continue;
+                if (vector || !current->crosses_call || regalloc_is_callee_saved(file, victim_reg)) {
+                    victim = a;
+                    break;
+                }
+            }
+            if (victim < 0 || active[victim]->end <= current->end) {
+                codegen_spill_register(codegen, current->vreg);
+                continue;
+            }
+
+            reg = codegen->register_map[active[victim]->vreg].physical_reg;
+            codegen_spill_register(codegen, active[victim]->vreg);
+            memmove(&active[victim], &active[victim + 1], (size_t)(active_count - victim - 1) * sizeof(LiveInterval*));
+            active_count--;
+        }
+
+        assign(codegen, file, current->vreg, reg);
+        registers[reg] = true;
+
+        int position = active_count;
+        while (position > 0 && active[position - 1]->end > current->end) {
+            active[position] = active[position - 1];
+            position--;
+        }
+        active[position] = current;
+        active_count++;
+    }
+
+    for (int i = 0; i < file->callee_saved_count; i++) {
+        int reg = file->callee_saved[i];
+        if (codegen->callee_saved_used & (1u << reg)) {
+            codegen->callee_save_offset[reg] = allocate_stack_slot(codegen, 8);
+        }
+    }
+
+    free(active);
+    free(definitions);
+    free(intervals);
+    ir_flat_destroy(flat);
+}
+
+// Physical register holding virtual_reg, or -1 if it is spilled or unused
+int codegen_get_physical_register(CodeGenerator* codegen, int virtual_reg) {
+    if (virtual_reg < 0 || virtual_reg >= codegen->register_map_size) return -1;
+    return codegen->register_map[virtual_reg].physical_reg;
+}
+
+// Move virtual_reg to a stack slot of its own
+void codegen_spill_register(CodeGenerator* codegen, int virtual_reg) {
+    if (virtual_reg < 0 || virtual_reg >= codegen->register_map_size) return;
+
+    RegisterMapping* mapping = &codegen->register_map[virtual_reg];
+    mapping->physical_reg = -1;
+    mapping->is_spilled = true;
+    if (mapping->spill_offset == 0) {
+        mapping->spill_offset = allocate_stack_slot(codegen, is_vector(codegen, virtual_reg) ? 16 : 8);
+    }
+}
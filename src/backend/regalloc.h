@@ -0,0 +1,54 @@
+/*
+ * GPLANG Register Allocation
+ * Live intervals over a function's instruction order and linear-scan
+ * assignment onto each target's register file. Values whose interval
+ * crosses a call only get callee-saved registers; the rest prefer
+ * caller-saved ones. Vector values get the target's vector registers,
+ * which no call preserves. Values that do not fit are spilled to stack
+ * slots, and every alloca gets a slot of its own.
+ */
+
+#ifndef GPLANG_REGALLOC_H
+#define GPLANG_REGALLOC_H
+
+#include "codegen.h"
+#include "../ir/ir_flat.h"
+
+// Live range of one virtual register, in instruction positions
+typedef struct {
+    int vreg;
+    int start;              // Definition (or first block it is live into)
+    int end;                // Last use, inclusive
+    bool crosses_call;      // A call lies strictly inside [start, end]
+} LiveInterval;
+
+// Physical registers of a target, by hardware number
+typedef struct {
+    const int* caller_saved;        // Allocatable, clobbered by calls
+    int caller_saved_count;
+    const int* callee_saved;        // Allocatable, saved in the prologue
+    int callee_saved_count;
+    const int* arguments;           // Integer argument registers, in order
+    int argument_count;
+    int return_register;
+    int scratch[2];                 // Never allocated: spill reloads and temporaries
+    int frame_pointer;
+    int stack_pointer;
+    const int* vector_registers;    // Allocatable, clobbered by calls; none if the target has no vector code
+    int vector_register_count;
+} RegisterFile;
+
+// Function declarations
+const RegisterFile* regalloc_register_file(TargetArch target);
+bool regalloc_is_callee_saved(const RegisterFile* file, int reg);
+
+// Position of instruction i of the flat function (block order)
+static inline int regalloc_position(uint32_t inst) {
+    return (int)inst * 2;
+}
+
+// Intervals of every non-alloca register, sorted by start; NULL on OOM.
+// kinds (may be NULL) marks instructions the backend lowers to runtime calls.
+LiveInterval* regalloc_compute_intervals(const IRFlatFunction* flat, const ValueKind* kinds, int* count);
+
+#endif // GPLANG_REGALLOC_H
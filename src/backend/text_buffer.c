@@ -0,0 +1,142 @@
+/*
+ * GPLANG Text Buffer
+ * The buffer doubles as it fills, so appending a line is amortized
+ * constant time. text_buffer_printf handles the common conversions
+ * itself and leaves the rest to vsnprintf.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "text_buffer.h"
+
+void text_buffer_free(TextBuffer* buffer) {
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->size = buffer->capacity = 0;
+    buffer->failed = false;
+}
+
+// Room for extra more bytes; false once an allocation has failed
+static bool reserve(TextBuffer* buffer, size_t extra) {
+    if (buffer->failed) return false;
+    if (buffer->size + extra <= buffer->capacity) return true;
+
+    size_t capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+    while (capacity < buffer->size + extra) capacity *= 2;
+    char* data = realloc(buffer->data, capacity);
+    if (!data) {
+        buffer->failed = true;
+        return false;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+void text_buffer_append(TextBuffer* buffer, const char* text, size_t length) {
+    if (!reserve(buffer, length)) return;
+    memcpy(buffer->data + buffer->size, text, length);
+    buffer->size += length;
+}
+
+void text_buffer_puts(TextBuffer* buffer, const char* text) {
+    text_buffer_append(buffer, text, strlen(text));
+}
+
+void text_buffer_putc(TextBuffer* buffer, char c) {
+    if (!reserve(buffer, 1)) return;
+    buffer->data[buffer->size++] = c;
+}
+
+// Decimal digits, written back to front
+void text_buffer_int(TextBuffer* buffer, long long value) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        *--start = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) *--start = '-';
+    text_buffer_append(buffer, start, (size_t)(end - start));
+}
+
+void text_buffer_uint(TextBuffer* buffer, unsigned long long value) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    do {
+        *--start = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    text_buffer_append(buffer, start, (size_t)(end - start));
+}
+
+// Format through vsnprintf, in place; only text longer than the spare room is formatted twice
+static void format_rest(TextBuffer* buffer, const char* format, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+    size_t room = buffer->capacity - buffer->size;
+    int length = vsnprintf(buffer->failed ? NULL : buffer->data + buffer->size,
+                           buffer->failed ? 0 : room, format, args);
+    if (length >= 0 && (size_t)length >= room && reserve(buffer, (size_t)length + 1)) {
+        vsnprintf(buffer->data + buffer->size, (size_t)length + 1, format, retry);
+    }
+    if (length >= 0 && !buffer->failed) buffer->size += (size_t)length;
+    va_end(retry);
+}
+
+/*
+ * The conversions the backends use (%s %c %d %lld %llu %zu %%) go
+ * straight to the append routines; the first one with flags, a width
+ * or any other type hands the rest of the format to vsnprintf.
+ */
+void text_buffer_vprintf(TextBuffer* buffer, const char* format, va_list args) {
+    const char* text = format;
+    for (;;) {
+        const char* percent = strchr(text, '%');
+        if (!percent) {
+            text_buffer_puts(buffer, text);
+            return;
+        }
+        text_buffer_append(buffer, text, (size_t)(percent - text));
+
+        const char* spec = percent + 1;
+        if (spec[0] == 's') {
+            text_buffer_puts(buffer, va_arg(args, const char*));
+        } else if (spec[0] == 'd') {
+            text_buffer_int(buffer, va_arg(args, int));
+        } else if (spec[0] == 'c') {
+            text_buffer_putc(buffer, (char)va_arg(args, int));
+        } else if (spec[0] == '%') {
+            text_buffer_putc(buffer, '%');
+        } else if (spec[0] == 'z' && spec[1] == 'u') {
+            text_buffer_uint(buffer, va_arg(args, size_t));
+            spec++;
+        } else if (spec[0] == 'l' && spec[1] == 'l' && spec[2] == 'd') {
+            text_buffer_int(buffer, va_arg(args, long long));
+            spec += 2;
+        } else if (spec[0] == 'l' && spec[1] == 'l' && spec[2] == 'u') {
+            text_buffer_uint(buffer, va_arg(args, unsigned long long));
+            spec += 2;
+        } else {
+            format_rest(buffer, percent, args);
+            return;
+        }
+        text = spec + 1;
+    }
+}
+
+void text_buffer_printf(TextBuffer* buffer, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    text_buffer_vprintf(buffer, format, args);
+    va_end(args);
+}
+
+bool text_buffer_write(TextBuffer* buffer, FILE* file) {
+    bool ok = !buffer->failed && fwrite(buffer->data, 1, buffer->size, file) == buffer->size;
+    buffer->size = 0;
+    return ok;
+}
@@ -0,0 +1,40 @@
+/*
+ * GPLANG Text Buffer
+ * Growable in-memory text the backends build their output in (.s
+ * assembly, .ll LLVM IR), so the whole file goes out with a single
+ * write at the end instead of a locked stream call per line. Native
+ * instruction lines are appended piecewise, their common operands built
+ * without a format string (emit_operands, codegen_operand); LLVM IR
+ * lines still pass through text_buffer_printf, whose common
+ * conversions skip vsnprintf but scan the format string every time.
+ */
+
+#ifndef GPLANG_TEXT_BUFFER_H
+#define GPLANG_TEXT_BUFFER_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef struct {
+    char* data;                     // Not NUL-terminated
+    size_t size;
+    size_t capacity;
+    bool failed;                    // An allocation failed; the contents are incomplete
+} TextBuffer;
+
+// Function declarations
+void text_buffer_free(TextBuffer* buffer);
+void text_buffer_append(TextBuffer* buffer, const char* text, size_t length);
+void text_buffer_puts(TextBuffer* buffer, const char* text);
+void text_buffer_putc(TextBuffer* buffer, char c);
+void text_buffer_int(TextBuffer* buffer, long long value);
+void text_buffer_uint(TextBuffer* buffer, unsigned long long value);
+void text_buffer_printf(TextBuffer* buffer, const char* format, ...);
+void text_buffer_vprintf(TextBuffer* buffer, const char* format, va_list args);
+
+// Write the contents to file and empty the buffer; false if either failed
+bool text_buffer_write(TextBuffer* buffer, FILE* file);
+
+#endif // GPLANG_TEXT_BUFFER_H
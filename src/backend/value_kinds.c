@@ -0,0 +1,241 @@
+/*
+ * GPLANG Value Kinds
+ * Forward inference to a fixed point: every register starts as an
+ * integer and is only ever promoted (int -> float -> string), so the
+ * iteration terminates after a few passes over the module.
+ */
+
+#include "value_kinds.h"
+
+extern char* my_strdup(const char* s);
+
+static const RuntimeFunction runtime_functions[] = {
+    { "print", { "gp_rt_print_int", "gp_rt_print_float", "gp_rt_print_string" }, VALUE_INT, false },
+    { "str", { "gp_rt_str_int", "gp_rt_str_float", NULL }, VALUE_STRING, false },
+    { "int", { NULL, "gp_rt_int_from_float", "gp_rt_int_from_string" }, VALUE_INT, false },
+    { "float", { "gp_rt_float_from_int", NULL, "gp_rt_float_from_string" }, VALUE_FLOAT, true },
+    { "len", { "gp_rt_string_length", "gp_rt_string_length", "gp_rt_string_length" }, VALUE_INT, false },
+    { "Time.now", { "gp_rt_time_now", "gp_rt_time_now", "gp_rt_time_now" }, VALUE_INT, false },
+    { "__method_seconds", { "gp_rt_time_seconds", "gp_rt_time_seconds", "gp_rt_time_seconds" }, VALUE_FLOAT, true },
+    { "__method_milliseconds", { "gp_rt_time_milliseconds", "gp_rt_time_milliseconds", "gp_rt_time_milliseconds" },
+      VALUE_FLOAT, true },
+};
+
+const RuntimeFunction* runtime_function_lookup(const char* name) {
+    if (!name) return NULL;
+    for (size_t i = 0; i < sizeof(runtime_functions) / sizeof(runtime_functions[0]); i++) {
+        if (strcmp(runtime_functions[i].name, name) == 0) return &runtime_functions[i];
+    }
+    return NULL;
+}
+
+bool value_kinds_lowers_to_call(IROpcode opcode, ValueKind dest, ValueKind lhs, ValueKind rhs) {
+    switch (opcode) {
+        case IR_CALL: case IR_ASYNC_CALL: case IR_SPAWN: case IR_PRINT: case IR_READ:
+            return true;
+        case IR_ADD:
+            return dest == VALUE_STRING;
+        case IR_MOD:
+            return dest == VALUE_FLOAT;
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+            return lhs == VALUE_STRING || rhs == VALUE_STRING;
+        default:
+            return false;
+    }
+}
+
+static ValueKind join(ValueKind a, ValueKind b) {
+    return a > b ? a : b;
+}
+
+ValueKind value_kind_of(const ValueKind* registers, int register_count, const IRValue* value) {
+    if (!value) return VALUE_INT;
+    if (value->type == IR_VALUE_REGISTER) {
+        return registers && value->reg_id >= 0 && value->reg_id < register_count ? registers[value->reg_id] : VALUE_INT;
+    }
+    if (value->type == IR_VALUE_CONSTANT) {
+        if (value->constant.const_type == IR_CONST_FLOAT_VAL) return VALUE_FLOAT;
+        if (value->constant.const_type == IR_CONST_STRING_VAL) return VALUE_STRING;
+    }
+    return VALUE_INT;
+}
+
+int value_kinds_function_index(const ModuleKinds* kinds, const char* name) {
+    for (int i = 0; name && i < kinds->function_count; i++) {
+        if (strcmp(kinds->functions[i]->name, name) == 0) return i;
+    }
+    return -1;
+}
+
+const ValueKind* value_kinds_registers(const ModuleKinds* kinds, const IRFunction* function) {
+    for (int i = 0; kinds && i < kinds->function_count; i++) {
+        if (kinds->functions[i] == function) return kinds->registers[i];
+    }
+    return NULL;
+}
+
+static ValueKind* global_kind(ModuleKinds* kinds, const char* name) {
+    for (int i = 0; i < kinds->global_count; i++) {
+        if (strcmp(kinds->global_names[i], name) == 0) return &kinds->global_kinds[i];
+    }
+
+    char** names = realloc(kinds->global_names, (kinds->global_count + 1) * sizeof(char*));
+    if (names) kinds->global_names = names;
+    ValueKind* global_kinds = realloc(kinds->global_kinds, (kinds->global_count + 1) * sizeof(ValueKind));
+    if (global_kinds) kinds->global_kinds = global_kinds;
+    if (!names || !global_kinds) return NULL;
+
+    kinds->global_names[kinds->global_count] = my_strdup(name);
+    kinds->global_kinds[kinds->global_count] = VALUE_INT;
+    return &kinds->global_kinds[kinds->global_count++];
+}
+
+// Raise *slot to at least kind; reports whether anything changed
+static bool promote(ValueKind* slot, ValueKind kind, bool* changed) {
+    if (!slot || *slot >= kind) return false;
+    *slot = kind;
+    *changed = true;
+    return true;
+}
+
+static void infer_instruction(ModuleKinds* kinds, int f, IRInstruction* inst, bool* changed) {
+    IRFunction* function = kinds->functions[f];
+    ValueKind* registers = kinds->registers[f];
+    int count = function->next_register_id;
+    ValueKind* dest = inst->dest && inst->dest->type == IR_VALUE_REGISTER &&
+                      inst->dest->reg_id >= 0 && inst->dest->reg_id < count
+                      ? &registers[inst->dest->reg_id] : NULL;
+    ValueKind lhs = value_kind_of(registers, count, inst->src1);
+    ValueKind rhs = value_kind_of(registers, count, inst->src2);
+
+    switch (inst->opcode) {
+        case IR_CONST_FLOAT:
+            promote(dest, VALUE_FLOAT, changed);
+            break;
+        case IR_CONST_STRING:
+            promote(dest, VALUE_STRING, changed);
+            break;
+        case IR_ADD:
+            promote(dest, join(lhs, rhs), changed);
+            break;
+        case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+            promote(dest, join(lhs, rhs) == VALUE_FLOAT ? VALUE_FLOAT : VALUE_INT, changed);
+            break;
+        case IR_LOAD:
+            if (inst->src1 && inst->src1->type == IR_VALUE_GLOBAL) {
+                ValueKind* global = global_kind(kinds, inst->src1->global_name);
+                if (global) promote(dest, *global, changed);
+            } else {
+                promote(dest, lhs, changed);
+            }
+            break;
+        case IR_STORE:
+            if (inst->src2 && inst->src2->type == IR_VALUE_GLOBAL) {
+                promote(global_kind(kinds, inst->src2->global_name), lhs, changed);
+            } else if (inst->src2 && inst->src2->type == IR_VALUE_REGISTER &&
+                       inst->src2->reg_id >= 0 && inst->src2->reg_id < count) {
+                promote(&registers[inst->src2->reg_id], lhs, changed);
+            }
+            break;
+        case IR_VEC_SPLAT: case IR_VEC_IOTA: case IR_VEC_ADD: case IR_VEC_SUB: case IR_VEC_MUL:
+            promote(dest, VALUE_VECTOR, changed);
+            break;
+        case IR_PHI:
+            for (int a = 0; a + 1 < inst->arg_count; a += 2) {
+                promote(dest, value_kind_of(registers, count, inst->args[a]), changed);
+            }
+            break;
+        case IR_RETURN:
+            if (inst->src1) promote(&kinds->returns[f], lhs, changed);
+            break;
+        case IR_CALL: {
+            const char* name = inst->src1 && inst->src1->type == IR_VALUE_GLOBAL ? inst->src1->global_name : NULL;
+            int callee = value_kinds_function_index(kinds, name);
+            if (callee >= 0) {
+                IRFunction* target = kinds->functions[callee];
+                for (int a = 0; a < inst->arg_count && a < target->parameter_count; a++) {
+                    promote(&kinds->parameters[callee][a], value_kind_of(registers, count, inst->args[a]), changed);
+                }
+                promote(dest, kinds->returns[callee], changed);
+                break;
+            }
+            const RuntimeFunction* runtime = runtime_function_lookup(name);
+            if (runtime) promote(dest, runtime->result, changed);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+ModuleKinds* value_kinds_infer(IRModule* module) {
+    ModuleKinds* kinds = calloc(1, sizeof(ModuleKinds));
+    if (!kinds) return NULL;
+    kinds->module = module;
+
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        kinds->function_count++;
+    }
+    int n = kinds->function_count;
+    kinds->functions = calloc(n ? n : 1, sizeof(IRFunction*));
+    kinds->registers = calloc(n ? n : 1, sizeof(ValueKind*));
+    kinds->parameters = calloc(n ? n : 1, sizeof(ValueKind*));
+    kinds->returns = calloc(n ? n : 1, sizeof(ValueKind));
+    if (!kinds->functions || !kinds->registers || !kinds->parameters || !kinds->returns) {
+        value_kinds_destroy(kinds);
+        return NULL;
+    }
+
+    int f = 0;
+    for (IRFunction* function = module->functions; function; function = function->next, f++) {
+        kinds->functions[f] = function;
+        kinds->registers[f] = calloc(function->next_register_id > 0 ? function->next_register_id : 1,
+                                     sizeof(ValueKind));
+        kinds->parameters[f] = calloc(function->parameter_count > 0 ? function->parameter_count : 1,
+                                      sizeof(ValueKind));
+        if (!kinds->registers[f] || !kinds->parameters[f]) {
+            value_kinds_destroy(kinds);
+            return NULL;
+        }
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (f = 0; f < n; f++) {
+            IRFunction* function = kinds->functions[f];
+            for (int p = 0; p < function->parameter_count; p++) {
+                IRValue* param = function->parameters[p];
+                if (param && param->type == IR_VALUE_REGISTER && param->reg_id >= 0 &&
+                    param->reg_id < function->next_register_id) {
+                    promote(&kinds->registers[f][param->reg_id], kinds->parameters[f][p], &changed);
+                }
+            }
+            for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+                for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+                    infer_instruction(kinds, f, inst, &changed);
+                }
+            }
+        }
+    }
+    return kinds;
+}
+
+void value_kinds_destroy(ModuleKinds* kinds) {
+    if (!kinds) return;
+
+    for (int f = 0; f < kinds->function_count; f++) {
+        if (kinds->registers) free(kinds->registers[f]);
+        if (kinds->parameters) free(kinds->parameters[f]);
+    }
+    for (int g = 0; g < kinds->global_count; g++) {
+        free(kinds->global_names[g]);
+    }
+    free(kinds->functions);
+    free(kinds->registers);
+    free(kinds->parameters);
+    free(kinds->returns);
+    free(kinds->global_names);
+    free(kinds->global_kinds);
+    free(kinds);
+}
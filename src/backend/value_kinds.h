@@ -0,0 +1,59 @@
+/*
+ * GPLANG Value Kinds
+ * The IR is untyped, so the backend infers whether each register holds
+ * an integer, a double or a string from constants, runtime function
+ * results and the operations applied to it. Inference runs over the
+ * whole module at once, so parameters and return values of user
+ * functions take the kinds their call sites and returns give them.
+ */
+
+#ifndef GPLANG_VALUE_KINDS_H
+#define GPLANG_VALUE_KINDS_H
+
+#include "../ir/ir.h"
+
+// Ordered by promotion: int op float is float, anything + string is string.
+// The numbering is shared with the runtime (GP_KIND_* in runtime/gp_runtime.h).
+// Vectors (IR_VEC_* results) never mix with the others or reach the runtime.
+typedef enum {
+    VALUE_INT,
+    VALUE_FLOAT,
+    VALUE_STRING,
+    VALUE_VECTOR            // IR_VECTOR_LANES 64-bit integers
+} ValueKind;
+
+// Builtin implemented by the runtime library, chosen by its first argument's kind
+typedef struct {
+    const char* name;               // GPLANG name: print, str, Time.now, __method_seconds...
+    const char* symbols[3];         // Runtime symbol per argument kind; NULL returns the argument
+    ValueKind result;
+    bool float_result;              // Returned in %xmm0 / d0 rather than an integer register
+} RuntimeFunction;
+
+typedef struct ModuleKinds {
+    IRModule* module;
+    int function_count;
+    IRFunction** functions;
+    ValueKind** registers;          // Per function, indexed by virtual register
+    ValueKind** parameters;
+    ValueKind* returns;
+
+    // Globals, by name
+    char** global_names;
+    ValueKind* global_kinds;
+    int global_count;
+} ModuleKinds;
+
+// Function declarations
+ModuleKinds* value_kinds_infer(IRModule* module);
+void value_kinds_destroy(ModuleKinds* kinds);
+int value_kinds_function_index(const ModuleKinds* kinds, const char* name);
+const ValueKind* value_kinds_registers(const ModuleKinds* kinds, const IRFunction* function);
+ValueKind value_kind_of(const ValueKind* registers, int register_count, const IRValue* value);
+
+const RuntimeFunction* runtime_function_lookup(const char* name);
+
+// True if the instruction becomes a call (so it clobbers caller-saved registers)
+bool value_kinds_lowers_to_call(IROpcode opcode, ValueKind dest, ValueKind lhs, ValueKind rhs);
+
+#endif // GPLANG_VALUE_KINDS_H
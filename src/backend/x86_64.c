@@ -0,0 +1,1361 @@
+/*
+ * GPLANG x86-64 Instruction Selection
+ * Lowers the linked IR onto the allocation from regalloc.c. Operands
+ * become registers, frame slots or immediates: integer constants fold
+ * into the instructions that use them, add/scale combinations become
+ * lea, a compare feeding the next branch becomes cmp/jcc and other
+ * booleans are materialized with setcc/cmov. Doubles travel as bit
+ * patterns in integer registers and are computed in %xmm0/%xmm1;
+ * strings are pointers managed by the runtime library (gp_runtime.h).
+ * Vectors from the loop vectorizer hold two 64-bit integers in %xmm2-15
+ * or a 16-byte aligned frame slot and use the SSE2 packed instructions.
+ *
+ * Scratch registers, never allocated: %r10, %r11, %rax (return value,
+ * setcc), %rdx (idiv), %xmm0 and %xmm1.
+ */
+
+#include "codegen.h"
+#include "regalloc.h"
+
+extern char* my_strdup(const char* s);
+
+#define OPERAND_SIZE 96
+
+// Condition suffixes, in IR_EQ..IR_GE order
+static const char* signed_conditions[] = { "e", "ne", "l", "le", "g", "ge" };
+static const char* unsigned_conditions[] = { "e", "ne", "b", "be", "a", "ae" };     // ucomisd
+
+// A parallel-move entry: function arguments, PHI copies and parameters
+typedef struct {
+    const IRValue* value;           // Source value, NULL if source is a fixed register or slot
+    char source[OPERAND_SIZE];      // Location of the source, empty if it must be materialized
+    char dest[OPERAND_SIZE];
+    bool to_double;                 // Integer converted to a double on the way
+    bool vector;                    // 16 bytes, moved with movdqa
+    bool done;
+} Move;
+
+// Argument of a call into the runtime or C library
+typedef struct {
+    const IRValue* value;           // NULL passes immediate
+    long long immediate;
+    bool in_xmm;                    // C double, passed in the next %xmm register
+} CallArgument;
+
+static const char* reg64(int reg) {
+    return get_register_name_x86_64(reg);
+}
+
+static const char* xmm(int reg) {
+    static const char* names[] = {
+        "%xmm0", "%xmm1", "%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+        "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"
+    };
+    return reg >= 0 && reg < 16 ? names[reg] : "%invalid";
+}
+
+// The allocator's register for value: an %xmm register for vectors
+static const char* x86_64_register(CodeGenerator* codegen, const IRValue* value, int reg) {
+    return codegen_value_kind(codegen, value) == VALUE_VECTOR ? xmm(reg) : reg64(reg);
+}
+
+// 32-bit name of a 64-bit register, for the xor zeroing idiom
+static const char* reg32(const char* name) {
+    static const char* names[] = {
+        "%eax", "%ecx", "%edx", "%ebx", "%esp", "%ebp", "%esi", "%edi",
+        "%r8d", "%r9d", "%r10d", "%r11d", "%r12d", "%r13d", "%r14d", "%r15d"
+    };
+    for (int reg = 0; reg < 16; reg++) {
+        if (strcmp(reg64(reg), name) == 0) return names[reg];
+    }
+    return name;
+}
+
+static bool x86_64_is_memory(const char* operand) {
+    return strchr(operand, '(') != NULL;
+}
+
+static bool x86_64_is_immediate(const char* operand) {
+    return operand[0] == '$';
+}
+
+static bool fits_imm32(long long value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+static bool same_register(const IRValue* a, const IRValue* b) {
+    return a && b && a->type == IR_VALUE_REGISTER && b->type == IR_VALUE_REGISTER && a->reg_id == b->reg_id;
+}
+
+// Integer constant value of an operand: a literal or a rematerialized register
+static bool x86_64_constant(CodeGenerator* codegen, const IRValue* value, long long* constant) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (mapping && mapping->is_constant) {
+        *constant = mapping->constant_value;
+        return true;
+    }
+    if (codegen_is_int_constant(value)) {
+        *constant = value->constant.int_val;
+        return true;
+    }
+    return false;
+}
+
+// Index of a string literal in the module's .rodata table
+static int x86_64_string_literal(CodeGenerator* codegen, const char* text) {
+    const CodeGenerator* table = codegen->parent ? codegen->parent : codegen;
+    for (int i = 0; i < table->string_literal_count; i++) {
+        if (strcmp(table->string_literals[i], text) == 0) return i;
+    }
+    
+    // A function worker shares the table and must not grow it
+    if (codegen->parent) {
+        codegen_error(codegen, "String literal missing from the module table");
+        return 0;
+    }
+    if (codegen->string_literal_count == codegen->string_literal_capacity) {
+        int capacity = codegen->string_literal_capacity ? codegen->string_literal_capacity * 2 : 16;
+        char** literals = realloc(codegen->string_literals, capacity * sizeof(char*));
+        if (!literals) {
+            codegen_error(codegen, "Out of memory for string literals");
+            return 0;
+        }
+        codegen->string_literals = literals;
+        codegen->string_literal_capacity = capacity;
+    }
+    codegen->string_literals[codegen->string_literal_count] = my_strdup(text);
+    return codegen->string_literal_count++;
+}
+
+// Number every string constant a function may load, in module order,
+// before the functions are generated
+void x86_64_module_literals(CodeGenerator* codegen, IRModule* module) {
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+            for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+                IRValue* operands[3] = { inst->src1, inst->src2, inst->src3 };
+                for (int i = 0; i < 3 + inst->arg_count; i++) {
+                    IRValue* value = i < 3 ? operands[i] : inst->args[i - 3];
+                    if (inst->opcode == IR_ALLOCA && i == 0) continue;     // Slot name
+                    if (value && value->type == IR_VALUE_CONSTANT &&
+                        value->constant.const_type == IR_CONST_STRING_VAL) {
+                        x86_64_string_literal(codegen, value->constant.string_val);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// text into an operand buffer, truncated like snprintf
+static const char* x86_64_copy_operand(char* buffer, size_t size, const char* text) {
+    size_t length = strlen(text);
+    if (length >= size) length = size - 1;
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    return buffer;
+}
+
+// Frame slot operand, offset(%rbp)
+static const char* x86_64_frame_slot(char* buffer, size_t size, int offset) {
+    return codegen_operand(buffer, size, "", offset, "(%rbp)");
+}
+
+/*
+ * movq between two operands, through %r10 when both are in memory.
+ * Zeroing a register uses xor, which clobbers the flags: no move may be
+ * emitted between a compare and the jcc/setcc/cmov that reads them.
+ */
+static void x86_64_move(CodeGenerator* codegen, const char* source, const char* dest) {
+    if (strcmp(source, dest) == 0) return;
+    if (x86_64_is_memory(source) && x86_64_is_memory(dest)) {
+        emit_operands(codegen, "movq", source, "%r10");
+        source = "%r10";
+    }
+    if (strcmp(source, "$0") == 0 && !x86_64_is_memory(dest)) {
+        emit_operands(codegen, "xorl", reg32(dest), reg32(dest));
+        return;
+    }
+    emit_operands(codegen, "movq", source, dest);
+}
+
+/*
+ * Operand for value that needs no code: its register, its spill slot or
+ * a 32-bit immediate. Returns false for frame addresses, wide and float
+ * constants and string literals, which x86_64_materialize builds.
+ */
+static bool x86_64_location(CodeGenerator* codegen, const IRValue* value, char* buffer, size_t size) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    long long constant;
+    if (mapping && mapping->physical_reg >= 0) {
+        x86_64_copy_operand(buffer, size, x86_64_register(codegen, value, mapping->physical_reg));
+        return true;
+    }
+    if (x86_64_constant(codegen, value, &constant)) {
+        if (!fits_imm32(constant)) return false;
+        codegen_operand(buffer, size, "$", constant, "");
+        return true;
+    }
+    if (mapping && mapping->is_stack_address) return false;
+    if (mapping && mapping->is_spilled) {
+        x86_64_frame_slot(buffer, size, mapping->spill_offset);
+        return true;
+    }
+    if (mapping || !value) {
+        x86_64_copy_operand(buffer, size, "$0");    // Never defined
+        return true;
+    }
+    return false;
+}
+
+// Build a value without a location in reg
+static void x86_64_materialize(CodeGenerator* codegen, const IRValue* value, const char* reg) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    char operand[OPERAND_SIZE];
+    long long constant;
+    if (mapping && mapping->is_stack_address) {
+        emit_operands(codegen, "leaq", x86_64_frame_slot(operand, sizeof(operand), mapping->spill_offset), reg);
+    } else if (x86_64_constant(codegen, value, &constant)) {
+        emit_operands(codegen, "movabsq", codegen_operand(operand, sizeof(operand), "$", constant, ""), reg);
+    } else if (value->type == IR_VALUE_CONSTANT && value->constant.const_type == IR_CONST_FLOAT_VAL) {
+        long long bits;
+        memcpy(&bits, &value->constant.float_val, sizeof(bits));
+        emit_operands(codegen, "movabsq", codegen_operand(operand, sizeof(operand), "$", bits, ""), reg);
+    } else if (value->type == IR_VALUE_CONSTANT && value->constant.const_type == IR_CONST_STRING_VAL) {
+        int literal = x86_64_string_literal(codegen, value->constant.string_val);
+        emit_operands(codegen, "leaq", codegen_operand(operand, sizeof(operand), ".LC", literal, "(%rip)"), reg);
+    } else {
+        emit_comment(codegen, "Unsupported operand");
+        emit_operands(codegen, "xorl", reg32(reg), reg32(reg));
+    }
+}
+
+// Operand holding value; anything without a location is built in scratch
+static const char* x86_64_source(CodeGenerator* codegen, const IRValue* value, int scratch,
+                                 char* buffer, size_t size) {
+    if (x86_64_location(codegen, value, buffer, size)) return buffer;
+    x86_64_materialize(codegen, value, reg64(scratch));
+    return reg64(scratch);
+}
+
+// Register or memory operand holding value (immediates go through scratch)
+static const char* x86_64_rm(CodeGenerator* codegen, const IRValue* value, int scratch,
+                             char* buffer, size_t size) {
+    const char* source = x86_64_source(codegen, value, scratch, buffer, size);
+    if (!x86_64_is_immediate(source)) return source;
+    emit_operands(codegen, "movq", source, reg64(scratch));
+    return reg64(scratch);
+}
+
+// Where to write value: its register or spill slot; %r10 (%xmm0) for unused results
+static const char* x86_64_dest(CodeGenerator* codegen, const IRValue* value, char* buffer, size_t size) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (mapping && mapping->physical_reg >= 0) return x86_64_register(codegen, value, mapping->physical_reg);
+    if (mapping && mapping->is_spilled) {
+        x86_64_frame_slot(buffer, size, mapping->spill_offset);
+        return buffer;
+    }
+    return codegen_value_kind(codegen, value) == VALUE_VECTOR ? "%xmm0" : "%r10";
+}
+
+// Location of value for a move into it, false if the result is unused
+static bool x86_64_dest_location(CodeGenerator* codegen, const IRValue* value, char* buffer, size_t size) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (!mapping || (mapping->physical_reg < 0 && !mapping->is_spilled)) return false;
+    if (codegen->use_counts[value->reg_id] == 0) return false;
+    if (mapping->physical_reg >= 0) x86_64_copy_operand(buffer, size, x86_64_register(codegen, value, mapping->physical_reg));
+    else x86_64_frame_slot(buffer, size, mapping->spill_offset);
+    return true;
+}
+
+// Memory operand for the address in value: a frame slot, a global or (register)
+static const char* x86_64_address(CodeGenerator* codegen, const IRValue* value, char* buffer, size_t size) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    if (value && value->type == IR_VALUE_GLOBAL) {
+        snprintf(buffer, size, "gp_global_%s(%%rip)", value->global_name);
+    } else if (mapping && mapping->is_stack_address) {
+        x86_64_frame_slot(buffer, size, mapping->spill_offset);
+    } else if (mapping && mapping->physical_reg >= 0) {
+        snprintf(buffer, size, "(%s)", reg64(mapping->physical_reg));
+    } else {
+        x86_64_move(codegen, x86_64_source(codegen, value, 11, buffer, size), "%r11");
+        x86_64_copy_operand(buffer, size, "(%r11)");
+    }
+    return buffer;
+}
+
+// Load value into %xmm<xmm> as a double, converting integers
+static void x86_64_load_double(CodeGenerator* codegen, const IRValue* value, int xmm) {
+    char buffer[OPERAND_SIZE];
+    char name[8];
+    if (codegen_value_kind(codegen, value) == VALUE_FLOAT) {
+        const char* source = x86_64_source(codegen, value, 11, buffer, sizeof(buffer));
+        if (x86_64_is_immediate(source)) {
+            emit_operands(codegen, "movq", source, "%r11");
+            source = "%r11";
+        }
+        emit_operands(codegen, "movq", source, codegen_operand(name, sizeof(name), "%xmm", xmm, ""));
+    } else {
+        emit_operands(codegen, "cvtsi2sdq", x86_64_rm(codegen, value, 11, buffer, sizeof(buffer)),
+                      codegen_operand(name, sizeof(name), "%xmm", xmm, ""));
+    }
+}
+
+// movdqa between two vector operands, through %xmm0 when both are in memory
+static void x86_64_vector_move(CodeGenerator* codegen, const char* source, const char* dest) {
+    if (strcmp(source, dest) == 0) return;
+    if (x86_64_is_memory(source) && x86_64_is_memory(dest)) {
+        emit_operands(codegen, "movdqa", source, "%xmm0");
+        source = "%xmm0";
+    }
+    emit_operands(codegen, "movdqa", source, dest);
+}
+
+static void x86_64_emit_move(CodeGenerator* codegen, Move* move) {
+    const char* source = move->source;
+    if (move->vector) {
+        x86_64_vector_move(codegen, source, move->dest);
+        return;
+    }
+    if (!source[0]) {
+        const char* reg = x86_64_is_memory(move->dest) || move->to_double ? "%r10" : move->dest;
+        x86_64_materialize(codegen, move->value, reg);
+        source = reg;
+    }
+    if (move->to_double) {
+        if (x86_64_is_immediate(source)) {
+            emit_operands(codegen, "movq", source, "%r10");
+            source = "%r10";
+        }
+        emit_operands(codegen, "cvtsi2sdq", source, "%xmm0");
+        emit_operands(codegen, "movq", "%xmm0", move->dest);
+        return;
+    }
+    x86_64_move(codegen, source, move->dest);
+}
+
+// Another pending move still reads moves[i]'s destination
+static bool x86_64_move_blocked(const Move* moves, int count, int i) {
+    for (int j = 0; j < count; j++) {
+        if (j != i && !moves[j].done && moves[j].source[0] && strcmp(moves[j].source, moves[i].dest) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Perform all moves as if at once. Moves are emitted once nothing else
+ * still reads their destination; what is left are cycles, broken by
+ * parking one destination's old value in %r11 (%xmm0 for vectors).
+ * Values that have to be built (frame addresses, literals) read no
+ * register and go last.
+ */
+static void x86_64_parallel_move(CodeGenerator* codegen, Move* moves, int count) {
+    for (int i = 0; i < count; i++) {
+        moves[i].done = moves[i].source[0] && !moves[i].to_double && strcmp(moves[i].source, moves[i].dest) == 0;
+    }
+
+    for (;;) {
+        bool remaining = false, progress = false;
+        for (int i = 0; i < count; i++) {
+            if (moves[i].done || !moves[i].source[0]) continue;
+            remaining = true;
+            if (!x86_64_move_blocked(moves, count, i)) {
+                x86_64_emit_move(codegen, &moves[i]);
+                moves[i].done = true;
+                progress = true;
+            }
+        }
+        if (!remaining) break;
+        if (progress) continue;
+
+        for (int i = 0; i < count; i++) {
+            if (moves[i].done || !moves[i].source[0]) continue;
+            const char* park = moves[i].vector ? "%xmm0" : "%r11";
+            if (moves[i].vector) x86_64_vector_move(codegen, moves[i].dest, park);
+            else x86_64_move(codegen, moves[i].dest, park);
+            for (int j = 0; j < count; j++) {
+                if (!moves[j].done && strcmp(moves[j].source, moves[i].dest) == 0) strcpy(moves[j].source, park);
+            }
+            break;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!moves[i].done) x86_64_emit_move(codegen, &moves[i]);
+    }
+}
+
+// Fill in a move's source from value, converting to a double for dest_kind
+static void x86_64_move_source(CodeGenerator* codegen, Move* move, const IRValue* value, ValueKind dest_kind) {
+    move->value = value;
+    if (!x86_64_location(codegen, value, move->source, sizeof(move->source))) move->source[0] = '\0';
+    move->to_double = dest_kind == VALUE_FLOAT && codegen_value_kind(codegen, value) != VALUE_FLOAT;
+    move->vector = dest_kind == VALUE_VECTOR;
+}
+
+static IRBasicBlock* x86_64_find_block(CodeGenerator* codegen, const IRValue* label) {
+    if (!label || label->type != IR_VALUE_LABEL || !label->label) return NULL;
+    IRBasicBlock* next = codegen->current_block ? codegen->current_block->next : NULL;
+    if (next && next->label && strcmp(next->label, label->label) == 0) return next;
+    for (IRBasicBlock* block = codegen->current_function->blocks; block; block = block->next) {
+        if (block->label && strcmp(block->label, label->label) == 0) return block;
+    }
+    return NULL;
+}
+
+static bool x86_64_has_phis(const IRBasicBlock* block) {
+    return block && block->instructions && block->instructions->opcode == IR_PHI;
+}
+
+// Copies for the PHIs of target on the edge from the current block
+static void x86_64_edge_moves(CodeGenerator* codegen, IRBasicBlock* target) {
+    int count = 0;
+    for (IRInstruction* phi = target->instructions; phi && phi->opcode == IR_PHI; phi = phi->next) count++;
+    Move* moves = calloc(count, sizeof(Move));
+    if (!moves) {
+        codegen_error(codegen, "Out of memory for PHI copies");
+        return;
+    }
+
+    int move_count = 0;
+    const char* from = codegen->current_block->label;
+    for (IRInstruction* phi = target->instructions; phi && phi->opcode == IR_PHI; phi = phi->next) {
+        Move* move = &moves[move_count];
+        if (!x86_64_dest_location(codegen, phi->dest, move->dest, sizeof(move->dest))) continue;
+        for (int a = 0; a + 1 < phi->arg_count; a += 2) {
+            const IRValue* label = phi->args[a + 1];
+            if (label && label->type == IR_VALUE_LABEL && from && strcmp(label->label, from) == 0) {
+                x86_64_move_source(codegen, move, phi->args[a], codegen_value_kind(codegen, phi->dest));
+                move_count++;
+                break;
+            }
+        }
+    }
+    x86_64_parallel_move(codegen, moves, move_count);
+    free(moves);
+}
+
+// Leave the current block for label: PHI copies, then jmp unless it is the next block
+static void x86_64_jump(CodeGenerator* codegen, const IRValue* label, bool may_fall_through) {
+    IRBasicBlock* target = x86_64_find_block(codegen, label);
+    if (!target) {
+        emit_comment(codegen, "Jump to unknown block");
+        return;
+    }
+    if (x86_64_has_phis(target)) x86_64_edge_moves(codegen, target);
+    if (may_fall_through && target == codegen->current_block->next) return;
+
+    char name[128];
+    emit_instruction(codegen, "jmp", codegen_block_label(codegen, target->label, name, sizeof(name)));
+}
+
+/*
+ * Call a runtime or C library function with the System V convention:
+ * doubles in %xmm0-7, everything else in the integer argument registers.
+ * The result lands in dest when it has a location, else stays in %rax.
+ */
+static void x86_64_c_call(CodeGenerator* codegen, const char* symbol, const CallArgument* args, int count,
+                          const IRValue* dest, bool float_result) {
+    const RegisterFile* file = regalloc_register_file(TARGET_X86_64);
+    Move moves[6];
+    int move_count = 0, xmm = 0;
+
+    // Doubles first: filling %xmm registers leaves the integer arguments' sources intact
+    for (int a = 0; a < count; a++) {
+        if (!args[a].in_xmm) continue;
+        if (xmm == 8) {
+            codegen_error(codegen, "Too many floating-point arguments to a runtime call");
+            return;
+        }
+        x86_64_load_double(codegen, args[a].value, xmm++);
+    }
+    for (int a = 0; a < count; a++) {
+        if (args[a].in_xmm) continue;
+        if (move_count == file->argument_count) {
+            codegen_error(codegen, "Too many arguments to a runtime call");
+            return;
+        }
+        Move* move = &moves[move_count];
+        x86_64_copy_operand(move->dest, sizeof(move->dest), reg64(file->arguments[move_count]));
+        if (args[a].value) {
+            x86_64_move_source(codegen, move, args[a].value, VALUE_INT);
+            move->to_double = false;
+        } else {
+            move->value = NULL;
+            move->to_double = false;
+            move->vector = false;
+            codegen_operand(move->source, sizeof(move->source), "$", args[a].immediate, "");
+        }
+        move_count++;
+    }
+    x86_64_parallel_move(codegen, moves, move_count);
+    emit_format(codegen, "call", "%s@PLT", symbol);
+
+    char buffer[OPERAND_SIZE];
+    if (dest && x86_64_dest_location(codegen, dest, buffer, sizeof(buffer))) {
+        if (float_result) emit_operands(codegen, "movq", "%xmm0", buffer);
+        else x86_64_move(codegen, "%rax", buffer);
+    }
+}
+
+// One-argument runtime helper chosen by the argument's kind (print, str, int...)
+static void x86_64_runtime_call(CodeGenerator* codegen, const RuntimeFunction* runtime, IRInstruction* inst,
+                                IRValue** args, int arg_count) {
+    ValueKind kind = arg_count > 0 ? codegen_value_kind(codegen, args[0]) : VALUE_INT;
+    const char* symbol = runtime->symbols[kind];
+    if (!symbol) {
+        // Conversion to the kind the value already has
+        Move move = { 0 };
+        if (arg_count > 0 && x86_64_dest_location(codegen, inst->dest, move.dest, sizeof(move.dest))) {
+            x86_64_move_source(codegen, &move, args[0], codegen_value_kind(codegen, inst->dest));
+            x86_64_parallel_move(codegen, &move, 1);
+        }
+        return;
+    }
+
+    CallArgument call_args[6];
+    int count = arg_count < 6 ? arg_count : 6;
+    for (int a = 0; a < count; a++) {
+        call_args[a].value = args[a];
+        call_args[a].immediate = 0;
+        call_args[a].in_xmm = codegen_value_kind(codegen, args[a]) == VALUE_FLOAT;
+    }
+    x86_64_c_call(codegen, symbol, call_args, count, inst->dest, runtime->float_result);
+}
+
+// The first arguments of a call to a GPLANG function, into %rdi, %rsi...
+static void x86_64_register_arguments(CodeGenerator* codegen, IRInstruction* inst, int callee) {
+    const RegisterFile* file = regalloc_register_file(TARGET_X86_64);
+    const ModuleKinds* kinds = codegen->module_kinds;
+    int parameter_count = kinds->functions[callee]->parameter_count;
+    Move moves[6];
+    int move_count = 0;
+    for (int a = 0; a < inst->arg_count && a < file->argument_count; a++) {
+        ValueKind kind = a < parameter_count ? kinds->parameters[callee][a] : VALUE_INT;
+        x86_64_copy_operand(moves[move_count].dest, sizeof(moves[move_count].dest), reg64(file->arguments[a]));
+        x86_64_move_source(codegen, &moves[move_count], inst->args[a], kind);
+        move_count++;
+    }
+    x86_64_parallel_move(codegen, moves, move_count);
+}
+
+/*
+ * Call a GPLANG function. Arguments go in %rdi, %rsi, %rdx, %rcx, %r8,
+ * %r9 and then on the stack, all as integer registers: doubles are
+ * passed as their bits, so a callee never needs to know the caller's
+ * view of its parameters beyond the kinds inference agreed on.
+ */
+static void x86_64_user_call(CodeGenerator* codegen, IRInstruction* inst, int callee) {
+    const RegisterFile* file = regalloc_register_file(TARGET_X86_64);
+    const ModuleKinds* kinds = codegen->module_kinds;
+    int parameter_count = kinds->functions[callee]->parameter_count;
+    int stack_count = inst->arg_count > file->argument_count ? inst->arg_count - file->argument_count : 0;
+    int padding = stack_count % 2 ? 8 : 0;
+
+    if (padding) emit_instruction(codegen, "subq", "$8, %rsp");
+    for (int a = inst->arg_count - 1; a >= file->argument_count; a--) {
+        Move move = { 0 };
+        ValueKind kind = a < parameter_count ? kinds->parameters[callee][a] : VALUE_INT;
+        x86_64_move_source(codegen, &move, inst->args[a], kind);
+        x86_64_copy_operand(move.dest, sizeof(move.dest), "%r10");
+        if (move.to_double || !move.source[0]) {
+            x86_64_emit_move(codegen, &move);
+            emit_instruction(codegen, "pushq", "%r10");
+        } else {
+            emit_instruction(codegen, "pushq", move.source);
+        }
+    }
+
+    x86_64_register_arguments(codegen, inst, callee);
+    emit_instruction(codegen, "call", kinds->functions[callee]->name);
+    if (stack_count > 0) emit_format(codegen, "addq", "$%d, %%rsp", stack_count * 8 + padding);
+
+    char buffer[OPERAND_SIZE];
+    if (x86_64_dest_location(codegen, inst->dest, buffer, sizeof(buffer))) x86_64_move(codegen, "%rax", buffer);
+}
+
+// Every call to function in the module passes all its parameters, so
+// its incoming stack arguments fill the whole area above the return address
+static bool x86_64_full_calls_only(CodeGenerator* codegen, const IRFunction* function) {
+    for (IRFunction* caller = codegen->current_module->functions; caller; caller = caller->next) {
+        for (IRBasicBlock* block = caller->blocks; block; block = block->next) {
+            for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+                if (inst->opcode == IR_CALL && inst->src1 && inst->src1->type == IR_VALUE_GLOBAL &&
+                    strcmp(inst->src1->global_name, function->name) == 0 &&
+                    inst->arg_count != function->parameter_count) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * A call whose result is returned right away reuses the frame: the
+ * arguments go to their registers, the frame is torn down and the
+ * callee is entered with jmp, so it returns straight to our caller.
+ * Stack arguments overwrite our own incoming ones, which the entry
+ * moves already copied out, so the callee may need no more stack
+ * slots than we were given; our caller still pops what it pushed.
+ * Arguments pointing into this frame, and callees that return a
+ * different kind (which the return would convert), rule it out.
+ */
+static bool x86_64_tail_call(CodeGenerator* codegen, IRInstruction* inst, int callee) {
+    const RegisterFile* file = regalloc_register_file(TARGET_X86_64);
+    const ModuleKinds* kinds = codegen->module_kinds;
+    IRFunction* function = codegen->current_function;
+    IRInstruction* ret = inst->next;
+    int caller = value_kinds_function_index(kinds, function->name);
+    if (!ret || ret->opcode != IR_RETURN || !same_register(ret->src1, inst->dest) || caller < 0 ||
+        kinds->returns[caller] != kinds->returns[callee] ||
+        inst->arg_count != kinds->functions[callee]->parameter_count) {
+        return false;
+    }
+    for (int a = 0; a < inst->arg_count; a++) {
+        const RegisterMapping* mapping = codegen_value_mapping(codegen, inst->args[a]);
+        if (mapping && mapping->is_stack_address) return false;
+    }
+
+    int stack_count = inst->arg_count - file->argument_count;
+    if (stack_count > 0) {
+        int incoming = function->parameter_count - file->argument_count;
+        if (stack_count > incoming || !x86_64_full_calls_only(codegen, function)) {
+            emit_comment(codegen, "Not a tail call: the callee needs more stack arguments than this frame received");
+            return false;
+        }
+    }
+
+    // Register and stack arguments at once: a value may move between them
+    int parameter_count = kinds->functions[callee]->parameter_count;
+    Move* moves = calloc(inst->arg_count > 0 ? inst->arg_count : 1, sizeof(Move));
+    if (!moves) {
+        codegen_error(codegen, "Out of memory for tail call arguments");
+        return false;
+    }
+    for (int a = 0; a < inst->arg_count; a++) {
+        ValueKind kind = a < parameter_count ? kinds->parameters[callee][a] : VALUE_INT;
+        if (a < file->argument_count) {
+            x86_64_copy_operand(moves[a].dest, sizeof(moves[a].dest), reg64(file->arguments[a]));
+        } else {
+            x86_64_frame_slot(moves[a].dest, sizeof(moves[a].dest), 16 + 8 * (a - file->argument_count));
+        }
+        x86_64_move_source(codegen, &moves[a], inst->args[a], kind);
+    }
+    x86_64_parallel_move(codegen, moves, inst->arg_count);
+    free(moves);
+
+    emit_tail_call_epilogue(codegen, function, kinds->functions[callee]->name);
+    codegen->tail_return = ret;
+    return true;
+}
+
+static void x86_64_call(CodeGenerator* codegen, IRInstruction* inst) {
+    const char* name = inst->src1 && inst->src1->type == IR_VALUE_GLOBAL ? inst->src1->global_name : NULL;
+    if (!name) {
+        emit_comment(codegen, "Indirect calls are not supported");
+        return;
+    }
+
+    int callee = value_kinds_function_index(codegen->module_kinds, name);
+    if (callee >= 0) {
+        if (!x86_64_tail_call(codegen, inst, callee)) x86_64_user_call(codegen, inst, callee);
+        return;
+    }
+
+    const RuntimeFunction* runtime = runtime_function_lookup(name);
+    if (runtime) {
+        x86_64_runtime_call(codegen, runtime, inst, inst->args, inst->arg_count);
+        return;
+    }
+
+    // Anything else is an external C function taking and returning integers or doubles
+    CallArgument args[14];
+    int count = inst->arg_count < 14 ? inst->arg_count : 14;
+    for (int a = 0; a < count; a++) {
+        args[a].value = inst->args[a];
+        args[a].immediate = 0;
+        args[a].in_xmm = codegen_value_kind(codegen, inst->args[a]) == VALUE_FLOAT;
+    }
+    x86_64_c_call(codegen, name, args, count, inst->dest, false);
+}
+
+/*
+ * Set the flags for a compare and return the condition that is true
+ * when the compare holds. Strings compare through the runtime, doubles
+ * with ucomisd (unsigned conditions), integers with cmp or test.
+ */
+static const char* x86_64_compare(CodeGenerator* codegen, IRInstruction* inst) {
+    int index = inst->opcode - IR_EQ;
+    ValueKind lhs_kind = codegen_value_kind(codegen, inst->src1);
+    ValueKind rhs_kind = codegen_value_kind(codegen, inst->src2);
+
+    if (lhs_kind == VALUE_STRING || rhs_kind == VALUE_STRING) {
+        CallArgument args[4] = {
+            { inst->src1, 0, false }, { NULL, lhs_kind, false },
+            { inst->src2, 0, false }, { NULL, rhs_kind, false }
+        };
+        x86_64_c_call(codegen, "gp_rt_compare_values", args, 4, NULL, false);
+        emit_instruction(codegen, "testq", "%rax, %rax");
+        return signed_conditions[index];
+    }
+    if (lhs_kind == VALUE_FLOAT || rhs_kind == VALUE_FLOAT) {
+        x86_64_load_double(codegen, inst->src1, 0);
+        x86_64_load_double(codegen, inst->src2, 1);
+        emit_instruction(codegen, "ucomisd", "%xmm1, %xmm0");
+        return unsigned_conditions[index];
+    }
+
+    char lhs_buffer[OPERAND_SIZE], rhs_buffer[OPERAND_SIZE];
+    const char* rhs = x86_64_source(codegen, inst->src2, 11, rhs_buffer, sizeof(rhs_buffer));
+    const char* lhs = x86_64_source(codegen, inst->src1, 10, lhs_buffer, sizeof(lhs_buffer));
+    if (x86_64_is_immediate(lhs) && !x86_64_is_immediate(rhs)) {
+        // cmp wants the immediate on the right: swap the operands and mirror the condition
+        static const int mirrored[] = { 0, 1, 4, 5, 2, 3 };
+        const char* swap = lhs;
+        lhs = rhs;
+        rhs = swap;
+        index = mirrored[index];
+    } else if (x86_64_is_immediate(lhs) || (x86_64_is_memory(lhs) && x86_64_is_memory(rhs))) {
+        emit_operands(codegen, "movq", lhs, "%r10");
+        lhs = "%r10";
+    }
+
+    if (strcmp(rhs, "$0") == 0 && !x86_64_is_memory(lhs)) {
+        emit_operands(codegen, "testq", lhs, lhs);
+    } else {
+        emit_operands(codegen, "cmpq", rhs, lhs);
+    }
+    return signed_conditions[index];
+}
+
+static const char* x86_64_inverse_condition(const char* condition) {
+    static const char* pairs[][2] = {
+        { "e", "ne" }, { "l", "ge" }, { "le", "g" }, { "b", "ae" }, { "be", "a" }
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        if (strcmp(condition, pairs[i][0]) == 0) return pairs[i][1];
+        if (strcmp(condition, pairs[i][1]) == 0) return pairs[i][0];
+    }
+    return condition;
+}
+
+// Write the flags' condition to dest as 0 or 1
+static void x86_64_set_boolean(CodeGenerator* codegen, const char* condition, const IRValue* dest) {
+    char mnemonic[8], buffer[OPERAND_SIZE];
+    snprintf(mnemonic, sizeof(mnemonic), "set%s", condition);
+    emit_instruction(codegen, mnemonic, "%al");
+    emit_instruction(codegen, "movzbl", "%al, %eax");
+    if (x86_64_dest_location(codegen, dest, buffer, sizeof(buffer))) x86_64_move(codegen, "%rax", buffer);
+}
+
+// cmp of value against zero
+static void x86_64_test(CodeGenerator* codegen, const IRValue* value) {
+    char buffer[OPERAND_SIZE];
+    const char* operand = x86_64_rm(codegen, value, 10, buffer, sizeof(buffer));
+    if (x86_64_is_memory(operand)) emit_operands(codegen, "cmpq", "$0", operand);
+    else emit_operands(codegen, "testq", operand, operand);
+}
+
+/*
+ * Logical and/or without branches: one operand's truth value is set in
+ * %eax and the other operand selects the fixed result with cmov. Both
+ * operands are values already computed: irgen only emits IR_AND/IR_OR
+ * when the right operand has no side effect and cannot trap, and
+ * lowers every other and/or to branches.
+ */
+static void x86_64_logical(CodeGenerator* codegen, IRInstruction* inst) {
+    bool is_and = inst->opcode == IR_AND;
+    char buffer[OPERAND_SIZE];
+
+    emit_instruction(codegen, "xorl", "%eax, %eax");
+    emit_instruction(codegen, is_and ? "xorl" : "movl", is_and ? "%r11d, %r11d" : "$1, %r11d");
+    x86_64_test(codegen, inst->src2);
+    emit_instruction(codegen, "setne", "%al");
+    x86_64_test(codegen, inst->src1);
+    emit_instruction(codegen, is_and ? "cmoveq" : "cmovneq", "%r11, %rax");
+    if (x86_64_dest_location(codegen, inst->dest, buffer, sizeof(buffer))) x86_64_move(codegen, "%rax", buffer);
+}
+
+// dest = src1 op src2, computed in dest's register when it can be
+static void x86_64_binary(CodeGenerator* codegen, const char* mnemonic, IRInstruction* inst, bool commutative) {
+    char lhs_buffer[OPERAND_SIZE], rhs_buffer[OPERAND_SIZE], dest_buffer[OPERAND_SIZE];
+    const IRValue* left = inst->src1;
+    const IRValue* right = inst->src2;
+    const char* dest = x86_64_dest(codegen, inst->dest, dest_buffer, sizeof(dest_buffer));
+
+    // dest already holds the right operand: swap when the order does not matter
+    if (commutative && x86_64_location(codegen, right, rhs_buffer, sizeof(rhs_buffer)) &&
+        strcmp(rhs_buffer, dest) == 0) {
+        left = inst->src2;
+        right = inst->src1;
+    }
+
+    const char* rhs = x86_64_source(codegen, right, 11, rhs_buffer, sizeof(rhs_buffer));
+    const char* lhs = x86_64_source(codegen, left, 10, lhs_buffer, sizeof(lhs_buffer));
+    const char* work = !x86_64_is_memory(dest) && strcmp(dest, rhs) != 0 ? dest : "%r10";
+    x86_64_move(codegen, lhs, work);
+    emit_operands(codegen, mnemonic, rhs, work);
+    x86_64_move(codegen, work, dest);
+}
+
+// Register name of value if it lives in one, else NULL
+static const char* x86_64_in_register(CodeGenerator* codegen, const IRValue* value) {
+    const RegisterMapping* mapping = codegen_value_mapping(codegen, value);
+    return mapping && mapping->physical_reg >= 0 ? reg64(mapping->physical_reg) : NULL;
+}
+
+// lea into dest, through %r10 when dest is in memory
+static void x86_64_lea(CodeGenerator* codegen, const IRValue* dest, const char* address) {
+    char buffer[OPERAND_SIZE];
+    const char* target = x86_64_dest(codegen, dest, buffer, sizeof(buffer));
+    const char* work = x86_64_is_memory(target) ? "%r10" : target;
+    emit_operands(codegen, "leaq", address, work);
+    x86_64_move(codegen, work, target);
+}
+
+// mul by 2, 4 or 8 of a value in a register: the index part of an lea
+static bool x86_64_scaled_index(CodeGenerator* codegen, IRInstruction* mul, const char** index, int* scale) {
+    long long constant;
+    const IRValue* other;
+    if (mul->opcode != IR_MUL || codegen_value_kind(codegen, mul->dest) != VALUE_INT) return false;
+    if (x86_64_constant(codegen, mul->src2, &constant)) {
+        other = mul->src1;
+    } else if (x86_64_constant(codegen, mul->src1, &constant)) {
+        other = mul->src2;
+    } else {
+        return false;
+    }
+    if (constant != 2 && constant != 4 && constant != 8) return false;
+    const char* reg = x86_64_in_register(codegen, other);
+    if (!reg) return false;
+    if (index) *index = reg;
+    if (scale) *scale = (int)constant;
+    return true;
+}
+
+// The other operand of an add that uses value: the base of an lea (register or 32-bit constant)
+static const IRValue* x86_64_add_base(IRInstruction* add, const IRValue* value) {
+    if (same_register(add->src1, value)) return add->src2;
+    if (same_register(add->src2, value)) return add->src1;
+    return NULL;
+}
+
+// Whether inst is emitted as part of the instruction after it
+static bool x86_64_folds_into_next(CodeGenerator* codegen, IRInstruction* inst) {
+    IRInstruction* next = inst->next;
+    if (!next || !inst->dest || inst->dest->type != IR_VALUE_REGISTER) return false;
+    if (inst->dest->reg_id < 0 || inst->dest->reg_id >= codegen->current_function->next_register_id ||
+        codegen->use_counts[inst->dest->reg_id] != 1) {
+        return false;
+    }
+
+    switch (inst->opcode) {
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+            return next->opcode == IR_BRANCH && same_register(next->src1, inst->dest);
+        case IR_MUL: {
+            if (next->opcode != IR_ADD || codegen_value_kind(codegen, next->dest) != VALUE_INT) return false;
+            if (!x86_64_scaled_index(codegen, inst, NULL, NULL)) return false;
+            const IRValue* base = x86_64_add_base(next, inst->dest);
+            long long constant;
+            return base && (x86_64_in_register(codegen, base) ||
+                            (x86_64_constant(codegen, base, &constant) && fits_imm32(constant)));
+        }
+        default:
+            return false;
+    }
+}
+
+// Integer add: lea when the result goes to a third register or folds a scaled index
+static void x86_64_add(CodeGenerator* codegen, IRInstruction* inst) {
+    char address[OPERAND_SIZE];
+    long long constant;
+    IRInstruction* mul = codegen->deferred;
+
+    if (mul && mul->opcode == IR_MUL) {
+        codegen->deferred = NULL;
+        const char* index;
+        int scale;
+        x86_64_scaled_index(codegen, mul, &index, &scale);
+        const IRValue* base = x86_64_add_base(inst, mul->dest);
+        const char* base_reg = x86_64_in_register(codegen, base);
+        if (base_reg) snprintf(address, sizeof(address), "(%s,%s,%d)", base_reg, index, scale);
+        else if (x86_64_constant(codegen, base, &constant)) snprintf(address, sizeof(address), "%lld(,%s,%d)", constant, index, scale);
+        x86_64_lea(codegen, inst->dest, address);
+        return;
+    }
+
+    const char* dest = x86_64_in_register(codegen, inst->dest);
+    const char* lhs = x86_64_in_register(codegen, inst->src1);
+    const char* rhs = x86_64_in_register(codegen, inst->src2);
+    if (dest && lhs && rhs && strcmp(dest, lhs) != 0 && strcmp(dest, rhs) != 0) {
+        snprintf(address, sizeof(address), "(%s,%s)", lhs, rhs);
+        x86_64_lea(codegen, inst->dest, address);
+        return;
+    }
+    const char* reg = lhs;
+    const IRValue* other = inst->src2;
+    if (!reg || !x86_64_constant(codegen, other, &constant)) {
+        reg = rhs;
+        other = inst->src1;
+    }
+    if (dest && reg && strcmp(dest, reg) != 0 && x86_64_constant(codegen, other, &constant) && fits_imm32(constant)) {
+        snprintf(address, sizeof(address), "%lld(%s)", constant, reg);
+        x86_64_lea(codegen, inst->dest, address);
+        return;
+    }
+    x86_64_binary(codegen, "addq", inst, true);
+}
+
+static void x86_64_sub(CodeGenerator* codegen, IRInstruction* inst) {
+    const char* dest = x86_64_in_register(codegen, inst->dest);
+    const char* lhs = x86_64_in_register(codegen, inst->src1);
+    long long constant;
+    if (dest && lhs && strcmp(dest, lhs) != 0 && x86_64_constant(codegen, inst->src2, &constant) &&
+        fits_imm32(-constant)) {
+        char address[OPERAND_SIZE];
+        snprintf(address, sizeof(address), "%lld(%s)", -constant, lhs);
+        x86_64_lea(codegen, inst->dest, address);
+        return;
+    }
+    x86_64_binary(codegen, "subq", inst, false);
+}
+
+// Multiplication by a constant: shifts for powers of two, lea for 3, 5 and 9
+static void x86_64_mul(CodeGenerator* codegen, IRInstruction* inst) {
+    long long constant;
+    const IRValue* other = inst->src1;
+    if (!x86_64_constant(codegen, inst->src2, &constant)) {
+        other = inst->src2;
+        if (!x86_64_constant(codegen, inst->src1, &constant)) {
+            x86_64_binary(codegen, "imulq", inst, true);
+            return;
+        }
+    }
+
+    const char* reg = x86_64_in_register(codegen, other);
+    if (reg && (constant == 3 || constant == 5 || constant == 9)) {
+        char address[OPERAND_SIZE];
+        snprintf(address, sizeof(address), "(%s,%s,%lld)", reg, reg, constant - 1);
+        x86_64_lea(codegen, inst->dest, address);
+        return;
+    }
+    if (constant > 1 && (constant & (constant - 1)) == 0) {
+        char lhs_buffer[OPERAND_SIZE], dest_buffer[OPERAND_SIZE], amount[8];
+        int shift = 0;
+        while ((1LL << shift) != constant) shift++;
+        const char* dest = x86_64_dest(codegen, inst->dest, dest_buffer, sizeof(dest_buffer));
+        x86_64_move(codegen, x86_64_source(codegen, other, 10, lhs_buffer, sizeof(lhs_buffer)), dest);
+        emit_operands(codegen, "shlq", codegen_operand(amount, sizeof(amount), "$", shift, ""), dest);
+        return;
+    }
+    x86_64_binary(codegen, "imulq", inst, true);
+}
+
+// Arithmetic on doubles in %xmm0 and %xmm1
+static void x86_64_float_binary(CodeGenerator* codegen, const char* mnemonic, IRInstruction* inst) {
+    char buffer[OPERAND_SIZE];
+    x86_64_load_double(codegen, inst->src1, 0);
+    x86_64_load_double(codegen, inst->src2, 1);
+    emit_operands(codegen, mnemonic, "%xmm1", "%xmm0");
+    if (x86_64_dest_location(codegen, inst->dest, buffer, sizeof(buffer))) {
+        emit_operands(codegen, "movq", "%xmm0", buffer);
+    }
+}
+
+// Every lane of a vector gets the integer src1
+static void x86_64_vector_splat(CodeGenerator* codegen, IRInstruction* inst) {
+    char source[OPERAND_SIZE], dest[OPERAND_SIZE];
+    long long constant;
+    if (!x86_64_dest_location(codegen, inst->dest, dest, sizeof(dest))) return;
+    if (x86_64_constant(codegen, inst->src1, &constant) && constant == 0) {
+        emit_instruction(codegen, "pxor", "%xmm0, %xmm0");
+    } else {
+        emit_operands(codegen, "movq", x86_64_rm(codegen, inst->src1, 11, source, sizeof(source)), "%xmm0");
+        emit_instruction(codegen, "punpcklqdq", "%xmm0, %xmm0");
+    }
+    x86_64_vector_move(codegen, "%xmm0", dest);
+}
+
+// Lane i gets src1 + i
+static void x86_64_vector_iota(CodeGenerator* codegen, IRInstruction* inst) {
+    char source[OPERAND_SIZE], dest[OPERAND_SIZE];
+    if (!x86_64_dest_location(codegen, inst->dest, dest, sizeof(dest))) return;
+    x86_64_move(codegen, x86_64_source(codegen, inst->src1, 11, source, sizeof(source)), "%r11");
+    emit_instruction(codegen, "movq", "%r11, %xmm0");
+    for (int lane = 1; lane < IR_VECTOR_LANES; lane++) {
+        emit_instruction(codegen, "addq", "$1, %r11");
+        emit_instruction(codegen, "movq", "%r11, %xmm1");
+        emit_instruction(codegen, "punpcklqdq", "%xmm1, %xmm0");
+    }
+    x86_64_vector_move(codegen, "%xmm0", dest);
+}
+
+// paddq/psubq in two-operand form; memory operands are 16-byte aligned slots
+static void x86_64_vector_binary(CodeGenerator* codegen, const char* mnemonic, IRInstruction* inst, bool commutative) {
+    char lhs_buffer[OPERAND_SIZE], rhs_buffer[OPERAND_SIZE], dest[OPERAND_SIZE];
+    if (!x86_64_dest_location(codegen, inst->dest, dest, sizeof(dest))) return;
+    const char* lhs = x86_64_dest(codegen, inst->src1, lhs_buffer, sizeof(lhs_buffer));
+    const char* rhs = x86_64_dest(codegen, inst->src2, rhs_buffer, sizeof(rhs_buffer));
+    if (commutative && strcmp(dest, rhs) == 0) {
+        const char* swap = lhs;
+        lhs = rhs;
+        rhs = swap;
+    }
+    if (x86_64_is_memory(dest) || strcmp(dest, rhs) == 0) {
+        x86_64_vector_move(codegen, lhs, "%xmm0");
+        emit_operands(codegen, mnemonic, rhs, "%xmm0");
+        x86_64_vector_move(codegen, "%xmm0", dest);
+        return;
+    }
+    x86_64_vector_move(codegen, lhs, dest);
+    emit_operands(codegen, mnemonic, rhs, dest);
+}
+
+/*
+ * SSE2 has no 64-bit lane multiply. With a = ah:al and b = bh:bl in
+ * 32-bit halves, the low 64 bits of a * b are al*bl + ((ah*bl + al*bh) << 32),
+ * each product from pmuludq.
+ */
+static void x86_64_vector_mul(CodeGenerator* codegen, IRInstruction* inst) {
+    char lhs_buffer[OPERAND_SIZE], rhs_buffer[OPERAND_SIZE], dest[OPERAND_SIZE];
+    if (!x86_64_dest_location(codegen, inst->dest, dest, sizeof(dest))) return;
+    const char* lhs = x86_64_dest(codegen, inst->src1, lhs_buffer, sizeof(lhs_buffer));
+    const char* rhs = x86_64_dest(codegen, inst->src2, rhs_buffer, sizeof(rhs_buffer));
+    x86_64_vector_move(codegen, lhs, "%xmm0");
+    emit_instruction(codegen, "psrlq", "$32, %xmm0");
+    emit_operands(codegen, "pmuludq", rhs, "%xmm0");
+    x86_64_vector_move(codegen, rhs, "%xmm1");
+    emit_instruction(codegen, "psrlq", "$32, %xmm1");
+    emit_operands(codegen, "pmuludq", lhs, "%xmm1");
+    emit_instruction(codegen, "paddq", "%xmm1, %xmm0");
+    emit_instruction(codegen, "psllq", "$32, %xmm0");
+    x86_64_vector_move(codegen, lhs, "%xmm1");
+    emit_operands(codegen, "pmuludq", rhs, "%xmm1");
+    emit_instruction(codegen, "paddq", "%xmm1, %xmm0");
+    x86_64_vector_move(codegen, "%xmm0", dest);
+}
+
+// Sum of the two lanes as a scalar integer
+static void x86_64_vector_reduce_add(CodeGenerator* codegen, IRInstruction* inst) {
+    char source[OPERAND_SIZE], dest[OPERAND_SIZE];
+    if (!x86_64_dest_location(codegen, inst->dest, dest, sizeof(dest))) return;
+    x86_64_vector_move(codegen, x86_64_dest(codegen, inst->src1, source, sizeof(source)), "%xmm0");
+    emit_instruction(codegen, "movdqa", "%xmm0, %xmm1");
+    emit_instruction(codegen, "punpckhqdq", "%xmm1, %xmm1");
+    emit_instruction(codegen, "paddq", "%xmm1, %xmm0");
+    emit_operands(codegen, "movq", "%xmm0", dest);
+}
+
+static void x86_64_divide(CodeGenerator* codegen, IRInstruction* inst) {
+    char source[OPERAND_SIZE], dest[OPERAND_SIZE];
+    // idiv works on %rdx:%rax, which the allocator never hands out
+    const char* divisor = x86_64_source(codegen, inst->src2, 11, source, sizeof(source));
+    if (x86_64_is_immediate(divisor)) {
+        emit_operands(codegen, "movq", divisor, "%r11");
+        divisor = "%r11";
+    }
+    x86_64_move(codegen, x86_64_source(codegen, inst->src1, 10, dest, sizeof(dest)), "%rax");
+    emit_instruction(codegen, "cqto", "");
+    emit_instruction(codegen, "idivq", divisor);
+    x86_64_move(codegen, inst->opcode == IR_DIV ? "%rax" : "%rdx",
+                x86_64_dest(codegen, inst->dest, dest, sizeof(dest)));
+}
+
+// String concatenation through the runtime; mixed kinds are converted there
+static void x86_64_concat(CodeGenerator* codegen, IRInstruction* inst) {
+    ValueKind lhs_kind = codegen_value_kind(codegen, inst->src1);
+    ValueKind rhs_kind = codegen_value_kind(codegen, inst->src2);
+    if (lhs_kind == VALUE_STRING && rhs_kind == VALUE_STRING) {
+        CallArgument args[2] = { { inst->src1, 0, false }, { inst->src2, 0, false } };
+        x86_64_c_call(codegen, "gp_rt_string_concat", args, 2, inst->dest, false);
+        return;
+    }
+    CallArgument args[4] = {
+        { inst->src1, 0, false }, { NULL, lhs_kind, false },
+        { inst->src2, 0, false }, { NULL, rhs_kind, false }
+    };
+    x86_64_c_call(codegen, "gp_rt_concat_values", args, 4, inst->dest, false);
+}
+
+// Kind of the memory an address operand refers to
+static ValueKind x86_64_slot_kind(CodeGenerator* codegen, const IRValue* address) {
+    if (address && address->type == IR_VALUE_GLOBAL && codegen->module_kinds) {
+        for (int g = 0; g < codegen->module_kinds->global_count; g++) {
+            if (strcmp(codegen->module_kinds->global_names[g], address->global_name) == 0) {
+                return codegen->module_kinds->global_kinds[g];
+            }
+        }
+        return VALUE_INT;
+    }
+    return codegen_value_kind(codegen, address);
+}
+
+static void x86_64_return(CodeGenerator* codegen, IRInstruction* inst) {
+    if (inst->src1) {
+        Move move = { 0 };
+        const ModuleKinds* kinds = codegen->module_kinds;
+        int index = kinds ? value_kinds_function_index(kinds, codegen->current_function->name) : -1;
+        x86_64_copy_operand(move.dest, sizeof(move.dest), "%rax");
+        x86_64_move_source(codegen, &move, inst->src1, index >= 0 ? kinds->returns[index] : VALUE_INT);
+        x86_64_parallel_move(codegen, &move, 1);
+    } else {
+        emit_instruction(codegen, "xorl", "%eax, %eax");
+    }
+    emit_function_epilogue(codegen, codegen->current_function);
+}
+
+static void x86_64_branch(CodeGenerator* codegen, IRInstruction* inst) {
+    const char* condition;
+    long long constant;
+    IRInstruction* compare = codegen->deferred;
+
+    if (compare && same_register(compare->dest, inst->src1)) {
+        codegen->deferred = NULL;
+        condition = x86_64_compare(codegen, compare);
+    } else if (x86_64_constant(codegen, inst->src1, &constant)) {
+        x86_64_jump(codegen, constant ? inst->src2 : inst->src3, true);
+        return;
+    } else {
+        x86_64_test(codegen, inst->src1);
+        condition = "ne";
+    }
+
+    IRBasicBlock* on_true = x86_64_find_block(codegen, inst->src2);
+    IRBasicBlock* on_false = x86_64_find_block(codegen, inst->src3);
+    if (!on_true || !on_false) {
+        emit_comment(codegen, "Branch to unknown block");
+        return;
+    }
+
+    char mnemonic[8], label[128];
+    bool true_copies = x86_64_has_phis(on_true);
+    if (!true_copies && !x86_64_has_phis(on_false) && on_true == codegen->current_block->next) {
+        snprintf(mnemonic, sizeof(mnemonic), "j%s", x86_64_inverse_condition(condition));
+        emit_instruction(codegen, mnemonic, codegen_block_label(codegen, on_false->label, label, sizeof(label)));
+        return;
+    }
+
+    // PHI copies for the taken edge sit in a stub after the block
+    snprintf(mnemonic, sizeof(mnemonic), "j%s", condition);
+    if (true_copies) {
+        snprintf(label, sizeof(label), ".L%s.edge%d", codegen->current_function->name, codegen->next_label_id++);
+    } else {
+        codegen_block_label(codegen, on_true->label, label, sizeof(label));
+    }
+    emit_instruction(codegen, mnemonic, label);
+    x86_64_jump(codegen, inst->src3, !true_copies);
+    if (true_copies) {
+        emit_label(codegen, label);
+        x86_64_jump(codegen, inst->src2, true);
+    }
+}
+
+// Generate x86_64 instruction
+bool codegen_x86_64_instruction(CodeGenerator* codegen, IRInstruction* instruction) {
+    char source[OPERAND_SIZE], dest[OPERAND_SIZE];
+    ValueKind kind = codegen_value_kind(codegen, instruction->dest);
+
+    if (x86_64_folds_into_next(codegen, instruction)) {
+        codegen->deferred = instruction;
+        return true;
+    }
+
+    switch (instruction->opcode) {
+        case IR_ADD:
+            if (kind == VALUE_STRING) x86_64_concat(codegen, instruction);
+            else if (kind == VALUE_FLOAT) x86_64_float_binary(codegen, "addsd", instruction);
+            else x86_64_add(codegen, instruction);
+            break;
+        case IR_SUB:
+            if (kind == VALUE_FLOAT) x86_64_float_binary(codegen, "subsd", instruction);
+            else x86_64_sub(codegen, instruction);
+            break;
+        case IR_MUL:
+            if (kind == VALUE_FLOAT) x86_64_float_binary(codegen, "mulsd", instruction);
+            else x86_64_mul(codegen, instruction);
+            break;
+        case IR_DIV:
+            if (kind == VALUE_FLOAT) x86_64_float_binary(codegen, "divsd", instruction);
+            else x86_64_divide(codegen, instruction);
+            break;
+        case IR_MOD:
+            if (kind == VALUE_FLOAT) {
+                CallArgument args[2] = { { instruction->src1, 0, true }, { instruction->src2, 0, true } };
+                x86_64_c_call(codegen, "gp_rt_float_mod", args, 2, instruction->dest, true);
+            } else {
+                x86_64_divide(codegen, instruction);
+            }
+            break;
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+            x86_64_set_boolean(codegen, x86_64_compare(codegen, instruction), instruction->dest);
+            break;
+        case IR_NOT:
+            x86_64_test(codegen, instruction->src1);
+            x86_64_set_boolean(codegen, "e", instruction->dest);
+            break;
+        case IR_AND:
+        case IR_OR:
+            x86_64_logical(codegen, instruction);
+            break;
+        case IR_CONST_INT:
+            if (codegen_value_mapping(codegen, instruction->dest) &&
+                codegen_value_mapping(codegen, instruction->dest)->is_constant) {
+                break;  // Rematerialized at each use
+            }
+            // fall through
+        case IR_CONST_FLOAT:
+        case IR_CONST_STRING: {
+            Move move = { 0 };
+            if (x86_64_dest_location(codegen, instruction->dest, move.dest, sizeof(move.dest))) {
+                x86_64_move_source(codegen, &move, instruction->src1, kind);
+                move.to_double = false;
+                x86_64_emit_move(codegen, &move);
+            }
+            break;
+        }
+        case IR_LOAD:
+            x86_64_move(codegen, x86_64_address(codegen, instruction->src1, source, sizeof(source)),
+                        x86_64_dest(codegen, instruction->dest, dest, sizeof(dest)));
+            break;
+        case IR_STORE:
+            if (x86_64_slot_kind(codegen, instruction->src2) == VALUE_FLOAT &&
+                codegen_value_kind(codegen, instruction->src1) != VALUE_FLOAT) {
+                x86_64_load_double(codegen, instruction->src1, 0);
+                emit_operands(codegen, "movq", "%xmm0", x86_64_address(codegen, instruction->src2, dest, sizeof(dest)));
+                break;
+            }
+            x86_64_move(codegen, x86_64_source(codegen, instruction->src1, 10, source, sizeof(source)),
+                        x86_64_address(codegen, instruction->src2, dest, sizeof(dest)));
+            break;
+        case IR_ALLOCA:
+        case IR_PHI:
+        case IR_NOP:
+            break;  // Frame slots come from the allocator; PHIs are copied on their edges
+        case IR_CALL:
+            x86_64_call(codegen, instruction);
+            break;
+        case IR_PRINT: {
+            const RuntimeFunction* print = runtime_function_lookup("print");
+            x86_64_runtime_call(codegen, print, instruction, &instruction->src1, instruction->src1 ? 1 : 0);
+            break;
+        }
+        case IR_RETURN:
+            if (instruction != codegen->tail_return) x86_64_return(codegen, instruction);
+            break;
+        case IR_JUMP:
+            x86_64_jump(codegen, instruction->src1, true);
+            break;
+        case IR_BRANCH:
+            x86_64_branch(codegen, instruction);
+            break;
+        case IR_VEC_SPLAT:
+            x86_64_vector_splat(codegen, instruction);
+            break;
+        case IR_VEC_IOTA:
+            x86_64_vector_iota(codegen, instruction);
+            break;
+        case IR_VEC_ADD:
+            x86_64_vector_binary(codegen, "paddq", instruction, true);
+            break;
+        case IR_VEC_SUB:
+            x86_64_vector_binary(codegen, "psubq", instruction, false);
+            break;
+        case IR_VEC_MUL:
+            x86_64_vector_mul(codegen, instruction);
+            break;
+        case IR_VEC_REDUCE_ADD:
+            x86_64_vector_reduce_add(codegen, instruction);
+            break;
+        default:
+            emit_comment(codegen, "Unsupported instruction");
+            break;
+    }
+    return true;
+}
+
+/*
+ * After the prologue: run top-level statements before main's body and
+ * move parameters from the argument registers (and the caller's stack
+ * above the return address) to where the allocator put them.
+ */
+void x86_64_function_entry(CodeGenerator* codegen, IRFunction* function) {
+    const RegisterFile* file = regalloc_register_file(TARGET_X86_64);
+
+    if (strcmp(function->name, "main") == 0 && codegen->module_kinds &&
+        value_kinds_function_index(codegen->module_kinds, "__init") >= 0) {
+        emit_instruction(codegen, "call", "__init");
+    }
+    if (function->parameter_count == 0) return;
+
+    Move* moves = calloc(function->parameter_count, sizeof(Move));
+    if (!moves) {
+        codegen_error(codegen, "Out of memory for parameter moves");
+        return;
+    }
+    int count = 0;
+    for (int p = 0; p < function->parameter_count; p++) {
+        Move* move = &moves[count];
+        if (!x86_64_dest_location(codegen, function->parameters[p], move->dest, sizeof(move->dest))) continue;
+        if (p < file->argument_count) {
+            x86_64_copy_operand(move->source, sizeof(move->source), reg64(file->arguments[p]));
+        } else {
+            x86_64_frame_slot(move->source, sizeof(move->source), 16 + 8 * (p - file->argument_count));
+        }
+        count++;
+    }
+    x86_64_parallel_move(codegen, moves, count);
+    free(moves);
+}
+
+// String literals and globals, after all functions
+void x86_64_module_data(CodeGenerator* codegen) {
+    TextBuffer* out = &codegen->assembly;
+    X86Encoder* encoder = codegen->encoder;
+    const ModuleKinds* kinds = codegen->module_kinds;
+    char name[160];
+
+    if (encoder) {
+        int main_symbol = x86_64_encoder_symbol(encoder, "main");
+        if (main_symbol >= 0) encoder->symbols[main_symbol].global = true;
+        for (int i = 0; i < codegen->string_literal_count; i++) {
+            snprintf(name, sizeof(name), ".LC%d", i);
+            x86_64_encoder_data(encoder, name, codegen->string_literals[i], strlen(codegen->string_literals[i]) + 1);
+        }
+        for (int g = 0; kinds && g < kinds->global_count; g++) {
+            snprintf(name, sizeof(name), "gp_global_%s", kinds->global_names[g]);
+            x86_64_encoder_bss(encoder, name, 8, 8);
+        }
+    }
+    if (!codegen->output) return;
+
+    if (codegen->string_literal_count > 0) {
+        text_buffer_puts(out, ".section .rodata\n");
+        for (int i = 0; i < codegen->string_literal_count; i++) {
+            text_buffer_puts(out, ".LC");
+            text_buffer_int(out, i);
+            text_buffer_puts(out, ":\n    .string \"");
+            for (const unsigned char* c = (const unsigned char*)codegen->string_literals[i]; *c; c++) {
+                if (*c == '"' || *c == '\\') text_buffer_printf(out, "\\%c", *c);
+                else if (*c < 0x20 || *c >= 0x7F) text_buffer_printf(out, "\\%03o", *c);
+                else text_buffer_putc(out, (char)*c);
+            }
+            text_buffer_puts(out, "\"\n");
+        }
+        text_buffer_putc(out, '\n');
+    }
+
+    if (kinds && kinds->global_count > 0) {
+        text_buffer_puts(out, ".section .bss\n.p2align 3\n");
+        for (int g = 0; g < kinds->global_count; g++) {
+            text_buffer_puts(out, "gp_global_");
+            text_buffer_puts(out, kinds->global_names[g]);
+            text_buffer_puts(out, ":\n    .zero 8\n");
+        }
+        text_buffer_putc(out, '\n');
+    }
+
+    text_buffer_puts(out, ".section .note.GNU-stack,\"\",@progbits\n");
+}
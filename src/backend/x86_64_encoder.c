@@ -0,0 +1,865 @@
+/*
+ * GPLANG x86-64 Encoder
+ * Covers exactly the instruction forms the backend selects: integer
+ * ALU, mov/lea/movabs, shifts, multiply/divide, setcc/cmov, jumps and
+ * calls, push/pop, the scalar SSE2 double instructions and the packed
+ * 64-bit integer ones used for vectorized loops. Operands
+ * are parsed from the same AT&T strings written to .s files, so the
+ * assembly listing and the encoded binary never disagree.
+ */
+
+#include "x86_64_encoder.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern char* my_strdup(const char* s);
+
+#define NO_REGISTER (-1)
+#define RIP_REGISTER 16
+
+typedef enum {
+    OPERAND_REGISTER,
+    OPERAND_XMM,
+    OPERAND_IMMEDIATE,
+    OPERAND_MEMORY,
+    OPERAND_LABEL
+} OperandType;
+
+typedef struct {
+    OperandType type;
+    int reg;                        // Register number, 0-15
+    int size;                       // General register width in bytes
+    long long value;                // Immediate, or memory displacement
+    int base;                       // Memory: register, RIP_REGISTER or NO_REGISTER
+    int index;
+    int scale;
+    int symbol;                     // Label or symbolic displacement, -1 if none
+} Operand;
+
+static const char* registers64[] = {
+    "rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+    "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"
+};
+static const char* registers32[] = {
+    "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi",
+    "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d", "r15d"
+};
+static const char* registers8[] = {
+    "al", "cl", "dl", "bl", "spl", "bpl", "sil", "dil",
+    "r8b", "r9b", "r10b", "r11b", "r12b", "r13b", "r14b", "r15b"
+};
+
+// Condition codes by AT&T suffix (the low nibble of jcc/setcc/cmovcc)
+static const struct { const char* suffix; int code; } conditions[] = {
+    { "o", 0x0 }, { "no", 0x1 }, { "b", 0x2 }, { "c", 0x2 }, { "nae", 0x2 },
+    { "ae", 0x3 }, { "nb", 0x3 }, { "nc", 0x3 }, { "e", 0x4 }, { "z", 0x4 },
+    { "ne", 0x5 }, { "nz", 0x5 }, { "be", 0x6 }, { "na", 0x6 }, { "a", 0x7 },
+    { "nbe", 0x7 }, { "s", 0x8 }, { "ns", 0x9 }, { "p", 0xA }, { "np", 0xB },
+    { "l", 0xC }, { "nge", 0xC }, { "ge", 0xD }, { "nl", 0xD }, { "le", 0xE },
+    { "ng", 0xE }, { "g", 0xF }, { "nle", 0xF }
+};
+
+// Group-1 ALU instructions: /digit for the immediate forms, opcode = digit * 8 + 1 or + 3
+static const struct { const char* name; int digit; } alu_instructions[] = {
+    { "add", 0 }, { "or", 1 }, { "and", 4 }, { "sub", 5 }, { "xor", 6 }, { "cmp", 7 }
+};
+
+// Scalar double arithmetic: F2 0F <opcode> /r
+static const struct { const char* name; uint8_t opcode; } sse_instructions[] = {
+    { "addsd", 0x58 }, { "mulsd", 0x59 }, { "subsd", 0x5C }, { "divsd", 0x5E },
+    { "minsd", 0x5D }, { "maxsd", 0x5F }, { "sqrtsd", 0x51 }
+};
+
+// Packed integer instructions: 66 0F <opcode> /r
+static const struct { const char* name; uint8_t opcode; } packed_instructions[] = {
+    { "paddq", 0xD4 }, { "psubq", 0xFB }, { "pmuludq", 0xF4 }, { "pxor", 0xEF },
+    { "punpcklqdq", 0x6C }, { "punpckhqdq", 0x6D }
+};
+
+static bool encoder_fail(X86Encoder* encoder, const char* format, ...) {
+    if (encoder->error) return false;   // Keep the first error
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    encoder->error = my_strdup(message);
+    return false;
+}
+
+X86Encoder* x86_64_encoder_create(void) {
+    X86Encoder* encoder = calloc(1, sizeof(X86Encoder));
+    return encoder;
+}
+
+void x86_64_encoder_destroy(X86Encoder* encoder) {
+    if (!encoder) return;
+
+    free(encoder->text.data);
+    free(encoder->rodata.data);
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        free(encoder->symbols[i].name);
+    }
+    free(encoder->symbols);
+    free(encoder->symbol_table);
+    free(encoder->fixups);
+    free(encoder->error);
+    free(encoder);
+}
+
+void x86_64_encoder_emit(X86Buffer* buffer, const void* bytes, size_t size) {
+    if (buffer->size + size > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+        while (capacity < buffer->size + size) capacity *= 2;
+        uint8_t* data = realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+}
+
+void x86_64_encoder_align(X86Buffer* buffer, size_t align, uint8_t fill) {
+    while (align > 1 && buffer->size % align != 0) {
+        x86_64_encoder_emit(buffer, &fill, 1);
+        if (buffer->failed) return;
+    }
+}
+
+static void emit_byte(X86Encoder* encoder, uint8_t byte) {
+    x86_64_encoder_emit(&encoder->text, &byte, 1);
+}
+
+static void emit_int32(X86Encoder* encoder, int32_t value) {
+    uint8_t bytes[4] = {
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)
+    };
+    x86_64_encoder_emit(&encoder->text, bytes, 4);
+}
+
+static uint32_t symbol_hash(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)name; *c; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    return hash;
+}
+
+static int find_symbol(const X86Encoder* encoder, const char* name) {
+    if (encoder->symbol_table_size == 0) return -1;
+    uint32_t mask = (uint32_t)encoder->symbol_table_size - 1;
+    for (uint32_t slot = symbol_hash(name) & mask;; slot = (slot + 1) & mask) {
+        int index = encoder->symbol_table[slot];
+        if (index < 0) return -1;
+        if (strcmp(encoder->symbols[index].name, name) == 0) return index;
+    }
+}
+
+// Rebuild the name index at twice the size once it is half full
+static bool grow_symbol_table(X86Encoder* encoder) {
+    int size = encoder->symbol_table_size ? encoder->symbol_table_size * 2 : 256;
+    int* table = malloc(size * sizeof(int));
+    if (!table) return false;
+    memset(table, -1, size * sizeof(int));
+    for (int i = 0; i < encoder->symbol_count; i++) {
+        uint32_t slot = symbol_hash(encoder->symbols[i].name) & (uint32_t)(size - 1);
+        while (table[slot] >= 0) slot = (slot + 1) & (uint32_t)(size - 1);
+        table[slot] = i;
+    }
+    free(encoder->symbol_table);
+    encoder->symbol_table = table;
+    encoder->symbol_table_size = size;
+    return true;
+}
+
+// Index of the symbol called name, added as undefined on first reference
+int x86_64_encoder_symbol(X86Encoder* encoder, const char* name) {
+    int index = find_symbol(encoder, name);
+    if (index >= 0) return index;
+
+    if (encoder->symbol_count * 2 >= encoder->symbol_table_size && !grow_symbol_table(encoder)) {
+        encoder_fail(encoder, "Out of memory for symbols");
+        return -1;
+    }
+    if (encoder->symbol_count == encoder->symbol_capacity) {
+        int capacity = encoder->symbol_capacity ? encoder->symbol_capacity * 2 : 128;
+        X86Symbol* symbols = realloc(encoder->symbols, capacity * sizeof(X86Symbol));
+        if (!symbols) {
+            encoder_fail(encoder, "Out of memory for symbols");
+            return -1;
+        }
+        encoder->symbols = symbols;
+        encoder->symbol_capacity = capacity;
+    }
+
+    X86Symbol* symbol = &encoder->symbols[encoder->symbol_count];
+    symbol->name = my_strdup(name);
+    symbol->section = X86_SECTION_UNDEFINED;
+    symbol->offset = 0;
+    symbol->size = 0;
+    symbol->global = false;
+
+    uint32_t mask = (uint32_t)encoder->symbol_table_size - 1;
+    uint32_t slot = symbol_hash(name) & mask;
+    while (encoder->symbol_table[slot] >= 0) slot = (slot + 1) & mask;
+    encoder->symbol_table[slot] = encoder->symbol_count;
+    return encoder->symbol_count++;
+}
+
+static int define_symbol(X86Encoder* encoder, const char* name, X86Section section, size_t offset) {
+    int index = x86_64_encoder_symbol(encoder, name);
+    if (index < 0) return -1;
+    X86Symbol* symbol = &encoder->symbols[index];
+    if (symbol->section != X86_SECTION_UNDEFINED) {
+        encoder_fail(encoder, "Symbol '%s' is already defined", name);
+        return -1;
+    }
+    symbol->section = section;
+    symbol->offset = offset;
+    return index;
+}
+
+void x86_64_encoder_label(X86Encoder* encoder, const char* name, bool global) {
+    int index = define_symbol(encoder, name, X86_SECTION_TEXT, encoder->text.size);
+    if (index >= 0 && global) encoder->symbols[index].global = true;
+}
+
+void x86_64_encoder_data(X86Encoder* encoder, const char* name, const void* bytes, size_t size) {
+    int index = define_symbol(encoder, name, X86_SECTION_RODATA, encoder->rodata.size);
+    if (index < 0) return;
+    encoder->symbols[index].size = size;
+    x86_64_encoder_emit(&encoder->rodata, bytes, size);
+}
+
+void x86_64_encoder_bss(X86Encoder* encoder, const char* name, size_t size, size_t align) {
+    size_t offset = (encoder->bss_size + align - 1) / align * align;
+    int index = define_symbol(encoder, name, X86_SECTION_BSS, offset);
+    if (index < 0) return;
+    encoder->symbols[index].size = size;
+    encoder->bss_size = offset + size;
+}
+
+static void add_fixup(X86Encoder* encoder, int symbol, int64_t addend, bool call) {
+    if (encoder->fixup_count == encoder->fixup_capacity) {
+        int capacity = encoder->fixup_capacity ? encoder->fixup_capacity * 2 : 256;
+        X86Fixup* fixups = realloc(encoder->fixups, capacity * sizeof(X86Fixup));
+        if (!fixups) {
+            encoder_fail(encoder, "Out of memory for fixups");
+            return;
+        }
+        encoder->fixups = fixups;
+        encoder->fixup_capacity = capacity;
+    }
+    X86Fixup* fixup = &encoder->fixups[encoder->fixup_count++];
+    fixup->offset = encoder->text.size;
+    fixup->symbol = symbol;
+    fixup->addend = addend;
+    fixup->call = call;
+}
+
+// Operand parsing
+
+static char* trim(char* text) {
+    while (*text == ' ' || *text == '\t') text++;
+    size_t length = strlen(text);
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t')) text[--length] = '\0';
+    return text;
+}
+
+static bool parse_register(const char* name, Operand* operand) {
+    if (strncmp(name, "xmm", 3) == 0) {
+        char* end;
+        long number = strtol(name + 3, &end, 10);
+        if (end == name + 3 || *end || number < 0 || number > 15) return false;
+        operand->type = OPERAND_XMM;
+        operand->reg = (int)number;
+        return true;
+    }
+    static const struct { const char** names; int size; } widths[] = {
+        { registers64, 8 }, { registers32, 4 }, { registers8, 1 }
+    };
+    for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        for (int reg = 0; reg < 16; reg++) {
+            if (strcmp(widths[w].names[reg], name) == 0) {
+                operand->type = OPERAND_REGISTER;
+                operand->reg = reg;
+                operand->size = widths[w].size;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static bool parse_number(const char* text, long long* value) {
+    char* end;
+    if (!*text) return false;
+    *value = strtoll(text, &end, 0);
+    return *end == '\0';
+}
+
+static bool parse_memory_register(const char* text, int* reg) {
+    Operand operand;
+    if (!*text) {
+        *reg = NO_REGISTER;
+        return true;
+    }
+    if (strcmp(text, "%rip") == 0) {
+        *reg = RIP_REGISTER;
+        return true;
+    }
+    if (text[0] != '%' || !parse_register(text + 1, &operand) ||
+        operand.type != OPERAND_REGISTER || operand.size != 8) {
+        return false;
+    }
+    *reg = operand.reg;
+    return true;
+}
+
+// disp(base,index,scale), where disp is a number or symbol[+-number]
+static bool parse_memory(X86Encoder* encoder, char* text, Operand* operand) {
+    char* open = strchr(text, '(');
+    char* close = strrchr(text, ')');
+    if (!close || close < open || close[1] != '\0') return false;
+    *open = '\0';
+    *close = '\0';
+
+    operand->type = OPERAND_MEMORY;
+    operand->value = 0;
+    operand->symbol = -1;
+    operand->index = NO_REGISTER;
+    operand->scale = 1;
+
+    char* displacement = trim(text);
+    if (*displacement && !parse_number(displacement, &operand->value)) {
+        char* offset = strpbrk(displacement + 1, "+-");
+        if (offset) {
+            if (!parse_number(offset, &operand->value)) return false;
+            *offset = '\0';
+        }
+        operand->symbol = x86_64_encoder_symbol(encoder, displacement);
+        if (operand->symbol < 0) return false;
+    }
+
+    char* parts[3] = { open + 1, NULL, NULL };
+    for (int i = 1; i < 3; i++) {
+        char* comma = strchr(parts[i - 1], ',');
+        if (!comma) break;
+        *comma = '\0';
+        parts[i] = comma + 1;
+    }
+    if (!parse_memory_register(trim(parts[0]), &operand->base)) return false;
+    if (parts[1] && (!parse_memory_register(trim(parts[1]), &operand->index) ||
+                     operand->index == RIP_REGISTER || operand->index == 4)) {
+        return false;
+    }
+    if (parts[2]) {
+        long long scale;
+        if (!parse_number(trim(parts[2]), &scale) || (scale != 1 && scale != 2 && scale != 4 && scale != 8)) {
+            return false;
+        }
+        operand->scale = (int)scale;
+    }
+    return operand->base != RIP_REGISTER || operand->index == NO_REGISTER;
+}
+
+static bool parse_operand(X86Encoder* encoder, char* text, Operand* operand) {
+    text = trim(text);
+    memset(operand, 0, sizeof(*operand));
+    operand->symbol = -1;
+
+    if (text[0] == '%') return parse_register(text + 1, operand);
+    if (text[0] == '$') {
+        operand->type = OPERAND_IMMEDIATE;
+        return parse_number(text + 1, &operand->value);
+    }
+    if (strchr(text, '(')) return parse_memory(encoder, text, operand);
+    if (!*text) return false;
+
+    // Jump or call target; @PLT only says the linker may route the call through the PLT
+    char* plt = strstr(text, "@PLT");
+    if (plt && plt[4] == '\0') *plt = '\0';
+    operand->type = OPERAND_LABEL;
+    operand->symbol = x86_64_encoder_symbol(encoder, text);
+    return operand->symbol >= 0;
+}
+
+// Split at top-level commas; memory operands have commas inside their parentheses
+static bool parse_operands(X86Encoder* encoder, const char* text, Operand* operands, int* count) {
+    char buffer[256];
+    if (strlen(text) >= sizeof(buffer)) return false;
+    strcpy(buffer, text);
+
+    *count = 0;
+    char* start = buffer;
+    if (!*trim(buffer)) return true;
+    int depth = 0;
+    for (char* c = buffer;; c++) {
+        if (*c == '(') depth++;
+        if (*c == ')') depth--;
+        if ((*c == ',' && depth == 0) || *c == '\0') {
+            bool last = *c == '\0';
+            *c = '\0';
+            if (*count == 3 || !parse_operand(encoder, start, &operands[(*count)++])) return false;
+            if (last) return true;
+            start = c + 1;
+        }
+    }
+}
+
+// Instruction encoding
+
+static bool fits_int8(long long value) {
+    return value >= -128 && value <= 127;
+}
+
+static bool fits_int32(long long value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+static int scale_bits(int scale) {
+    return scale == 8 ? 3 : scale == 4 ? 2 : scale == 2 ? 1 : 0;
+}
+
+/*
+ * [prefix] [REX] opcode ModRM [SIB] [disp] for a reg field (register
+ * number or /digit) and a register or memory rm operand. trailing is
+ * the size of any immediate after the displacement, which a
+ * RIP-relative field has to account for.
+ */
+static void encode_rm(X86Encoder* encoder, uint8_t prefix, bool wide, const uint8_t* opcode, int opcode_length,
+                      int reg, const Operand* rm, int trailing) {
+    int rex = (wide ? 8 : 0) | (reg >= 8 ? 4 : 0);
+    bool byte_register = false;
+    if (rm->type == OPERAND_MEMORY) {
+        if (rm->index >= 8) rex |= 2;
+        if (rm->base >= 8 && rm->base != RIP_REGISTER) rex |= 1;
+    } else {
+        if (rm->reg >= 8) rex |= 1;
+        // spl, bpl, sil and dil are only reachable with a REX prefix
+        byte_register = rm->type == OPERAND_REGISTER && rm->size == 1 && rm->reg >= 4 && rm->reg < 8;
+    }
+
+    if (prefix) emit_byte(encoder, prefix);
+    if (rex || byte_register) emit_byte(encoder, 0x40 | rex);
+    for (int i = 0; i < opcode_length; i++) emit_byte(encoder, opcode[i]);
+
+    int reg_bits = (reg & 7) << 3;
+    if (rm->type != OPERAND_MEMORY) {
+        emit_byte(encoder, 0xC0 | reg_bits | (rm->reg & 7));
+        return;
+    }
+
+    if (rm->base == RIP_REGISTER) {
+        emit_byte(encoder, 0x05 | reg_bits);
+        if (rm->symbol >= 0) add_fixup(encoder, rm->symbol, rm->value - 4 - trailing, false);
+        emit_int32(encoder, rm->symbol >= 0 ? 0 : (int32_t)rm->value);
+        return;
+    }
+    if (rm->symbol >= 0) {
+        encoder_fail(encoder, "Absolute symbol address '%s' needs a RIP-relative operand",
+                     encoder->symbols[rm->symbol].name);
+        return;
+    }
+    if (!fits_int32(rm->value)) {
+        encoder_fail(encoder, "Displacement %lld does not fit in 32 bits", rm->value);
+        return;
+    }
+
+    int index_bits = (rm->index == NO_REGISTER ? 4 : rm->index & 7) << 3;
+    if (rm->base == NO_REGISTER) {
+        emit_byte(encoder, 0x04 | reg_bits);
+        emit_byte(encoder, scale_bits(rm->scale) << 6 | index_bits | 5);
+        emit_int32(encoder, (int32_t)rm->value);
+        return;
+    }
+
+    int mod = rm->value == 0 && (rm->base & 7) != 5 ? 0 : fits_int8(rm->value) ? 1 : 2;
+    if (rm->index != NO_REGISTER || (rm->base & 7) == 4) {
+        emit_byte(encoder, mod << 6 | reg_bits | 4);
+        emit_byte(encoder, scale_bits(rm->scale) << 6 | index_bits | (rm->base & 7));
+    } else {
+        emit_byte(encoder, mod << 6 | reg_bits | (rm->base & 7));
+    }
+    if (mod == 1) emit_byte(encoder, (uint8_t)(int8_t)rm->value);
+    if (mod == 2) emit_int32(encoder, (int32_t)rm->value);
+}
+
+static void encode_rm1(X86Encoder* encoder, bool wide, uint8_t opcode, int reg, const Operand* rm, int trailing) {
+    encode_rm(encoder, 0, wide, &opcode, 1, reg, rm, trailing);
+}
+
+static void encode_rm2(X86Encoder* encoder, uint8_t prefix, bool wide, uint8_t opcode, int reg, const Operand* rm) {
+    uint8_t bytes[2] = { 0x0F, opcode };
+    encode_rm(encoder, prefix, wide, bytes, 2, reg, rm, 0);
+}
+
+static bool is_general(const Operand* operand, int size) {
+    return operand->type == OPERAND_REGISTER && operand->size == size;
+}
+
+static bool is_rm(const Operand* operand, int size) {
+    return is_general(operand, size) || operand->type == OPERAND_MEMORY;
+}
+
+static bool is_xmm_rm(const Operand* operand) {
+    return operand->type == OPERAND_XMM || operand->type == OPERAND_MEMORY;
+}
+
+// Operand width from an AT&T suffix: q is 8 bytes, l is 4
+static int suffix_size(const char* mnemonic, size_t stem) {
+    if (strlen(mnemonic) != stem + 1) return 0;
+    return mnemonic[stem] == 'q' ? 8 : mnemonic[stem] == 'l' ? 4 : 0;
+}
+
+static int condition_code(const char* suffix) {
+    for (size_t i = 0; i < sizeof(conditions) / sizeof(conditions[0]); i++) {
+        if (strcmp(conditions[i].suffix, suffix) == 0) return conditions[i].code;
+    }
+    return -1;
+}
+
+static bool encode_alu(X86Encoder* encoder, int digit, int size, const Operand* source, const Operand* dest) {
+    bool wide = size == 8;
+    if (source->type == OPERAND_IMMEDIATE && is_rm(dest, size)) {
+        if (fits_int8(source->value)) {
+            encode_rm1(encoder, wide, 0x83, digit, dest, 1);
+            emit_byte(encoder, (uint8_t)(int8_t)source->value);
+        } else if (fits_int32(source->value)) {
+            encode_rm1(encoder, wide, 0x81, digit, dest, 4);
+            emit_int32(encoder, (int32_t)source->value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+    if (is_general(source, size) && is_rm(dest, size)) {
+        encode_rm1(encoder, wide, (uint8_t)(digit * 8 + 1), source->reg, dest, 0);
+        return true;
+    }
+    if (source->type == OPERAND_MEMORY && is_general(dest, size)) {
+        encode_rm1(encoder, wide, (uint8_t)(digit * 8 + 3), dest->reg, source, 0);
+        return true;
+    }
+    return false;
+}
+
+static bool encode_mov(X86Encoder* encoder, int size, const Operand* source, const Operand* dest) {
+    bool wide = size == 8;
+    if (size == 8 && (source->type == OPERAND_XMM || dest->type == OPERAND_XMM)) {
+        if (source->type == OPERAND_XMM && dest->type == OPERAND_XMM) {
+            encode_rm2(encoder, 0xF3, false, 0x7E, dest->reg, source);
+        } else if (dest->type == OPERAND_XMM && is_rm(source, 8)) {
+            encode_rm2(encoder, 0x66, true, 0x6E, dest->reg, source);
+        } else if (source->type == OPERAND_XMM && is_rm(dest, 8)) {
+            encode_rm2(encoder, 0x66, true, 0x7E, source->reg, dest);
+        } else {
+            return false;
+        }
+        return true;
+    }
+    if (source->type == OPERAND_IMMEDIATE && is_rm(dest, size)) {
+        if (!fits_int32(source->value) && (wide || source->value < 0 || source->value > UINT32_MAX)) return false;
+        if (!wide && dest->type == OPERAND_REGISTER) {
+            if (dest->reg >= 8) emit_byte(encoder, 0x41);
+            emit_byte(encoder, (uint8_t)(0xB8 + (dest->reg & 7)));
+        } else {
+            encode_rm1(encoder, wide, 0xC7, 0, dest, 4);
+        }
+        emit_int32(encoder, (int32_t)source->value);
+        return true;
+    }
+    if (is_general(source, size) && is_rm(dest, size)) {
+        encode_rm1(encoder, wide, 0x89, source->reg, dest, 0);
+        return true;
+    }
+    if (source->type == OPERAND_MEMORY && is_general(dest, size)) {
+        encode_rm1(encoder, wide, 0x8B, dest->reg, source, 0);
+        return true;
+    }
+    return false;
+}
+
+// jmp, jcc (condition >= 0) or call to a label: rel8 for known nearby targets, else rel32
+static bool encode_branch(X86Encoder* encoder, int condition, bool call, const Operand* target) {
+    if (target->type != OPERAND_LABEL) return false;
+    const X86Symbol* symbol = &encoder->symbols[target->symbol];
+
+    if (!call && symbol->section == X86_SECTION_TEXT) {
+        long long distance = (long long)symbol->offset - (long long)(encoder->text.size + 2);
+        if (fits_int8(distance)) {
+            emit_byte(encoder, condition >= 0 ? (uint8_t)(0x70 + condition) : 0xEB);
+            emit_byte(encoder, (uint8_t)(int8_t)distance);
+            return true;
+        }
+    }
+
+    if (call) {
+        emit_byte(encoder, 0xE8);
+    } else if (condition >= 0) {
+        emit_byte(encoder, 0x0F);
+        emit_byte(encoder, (uint8_t)(0x80 + condition));
+    } else {
+        emit_byte(encoder, 0xE9);
+    }
+    add_fixup(encoder, target->symbol, -4, call);
+    emit_int32(encoder, 0);
+    return true;
+}
+
+static bool encode_shift(X86Encoder* encoder, int digit, const Operand* count, const Operand* dest) {
+    if (!is_rm(dest, 8)) return false;
+    if (count->type == OPERAND_IMMEDIATE && count->value >= 0 && count->value < 64) {
+        encode_rm1(encoder, true, 0xC1, digit, dest, 1);
+        emit_byte(encoder, (uint8_t)count->value);
+        return true;
+    }
+    if (count->type == OPERAND_REGISTER && count->size == 1 && count->reg == 1) {
+        encode_rm1(encoder, true, 0xD3, digit, dest, 0);     // %cl
+        return true;
+    }
+    return false;
+}
+
+static bool encode_imul(X86Encoder* encoder, const Operand* operands, int count) {
+    const Operand* dest = &operands[count - 1];
+    if (!is_general(dest, 8)) return false;
+
+    const Operand* immediate = operands[0].type == OPERAND_IMMEDIATE ? &operands[0] : NULL;
+    const Operand* source = immediate ? (count == 3 ? &operands[1] : dest) : &operands[0];
+    if ((count == 3 && !immediate) || !is_rm(source, 8)) return false;
+
+    if (!immediate) {
+        encode_rm2(encoder, 0, true, 0xAF, dest->reg, source);
+    } else if (fits_int8(immediate->value)) {
+        encode_rm1(encoder, true, 0x6B, dest->reg, source, 1);
+        emit_byte(encoder, (uint8_t)(int8_t)immediate->value);
+    } else if (fits_int32(immediate->value)) {
+        encode_rm1(encoder, true, 0x69, dest->reg, source, 4);
+        emit_int32(encoder, (int32_t)immediate->value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool encode_instruction(X86Encoder* encoder, const char* mnemonic, const Operand* operands, int count) {
+    const Operand* first = &operands[0];
+    const Operand* second = &operands[1];
+    int size;
+
+    if (count == 0) {
+        if (strcmp(mnemonic, "ret") == 0) {
+            emit_byte(encoder, 0xC3);
+            return true;
+        }
+        if (strcmp(mnemonic, "cqto") == 0) {
+            emit_byte(encoder, 0x48);
+            emit_byte(encoder, 0x99);
+            return true;
+        }
+        if (strcmp(mnemonic, "nop") == 0) {
+            emit_byte(encoder, 0x90);
+            return true;
+        }
+        return false;
+    }
+
+    if (count == 2) {
+        for (size_t i = 0; i < sizeof(alu_instructions) / sizeof(alu_instructions[0]); i++) {
+            size_t stem = strlen(alu_instructions[i].name);
+            if (strncmp(mnemonic, alu_instructions[i].name, stem) == 0 && (size = suffix_size(mnemonic, stem))) {
+                return encode_alu(encoder, alu_instructions[i].digit, size, first, second);
+            }
+        }
+        for (size_t i = 0; i < sizeof(sse_instructions) / sizeof(sse_instructions[0]); i++) {
+            if (strcmp(mnemonic, sse_instructions[i].name) == 0) {
+                if (!is_xmm_rm(first) || second->type != OPERAND_XMM) return false;
+                encode_rm2(encoder, 0xF2, false, sse_instructions[i].opcode, second->reg, first);
+                return true;
+            }
+        }
+        for (size_t i = 0; i < sizeof(packed_instructions) / sizeof(packed_instructions[0]); i++) {
+            if (strcmp(mnemonic, packed_instructions[i].name) == 0) {
+                if (!is_xmm_rm(first) || second->type != OPERAND_XMM) return false;
+                encode_rm2(encoder, 0x66, false, packed_instructions[i].opcode, second->reg, first);
+                return true;
+            }
+        }
+        if (strcmp(mnemonic, "movdqa") == 0) {
+            if (is_xmm_rm(first) && second->type == OPERAND_XMM) {
+                encode_rm2(encoder, 0x66, false, 0x6F, second->reg, first);
+            } else if (first->type == OPERAND_XMM && second->type == OPERAND_MEMORY) {
+                encode_rm2(encoder, 0x66, false, 0x7F, first->reg, second);
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (strcmp(mnemonic, "psllq") == 0 || strcmp(mnemonic, "psrlq") == 0) {
+            // 66 0F 73 /6 ib and /2 ib
+            if (first->type != OPERAND_IMMEDIATE || second->type != OPERAND_XMM) return false;
+            uint8_t opcode[2] = { 0x0F, 0x73 };
+            encode_rm(encoder, 0x66, false, opcode, 2, mnemonic[2] == 'l' ? 6 : 2, second, 1);
+            emit_byte(encoder, (uint8_t)first->value);
+            return true;
+        }
+        if ((size = suffix_size(mnemonic, 3)) && strncmp(mnemonic, "mov", 3) == 0) {
+            return encode_mov(encoder, size, first, second);
+        }
+        if (strcmp(mnemonic, "movabsq") == 0) {
+            if (first->type != OPERAND_IMMEDIATE || !is_general(second, 8)) return false;
+            emit_byte(encoder, second->reg >= 8 ? 0x49 : 0x48);
+            emit_byte(encoder, (uint8_t)(0xB8 + (second->reg & 7)));
+            uint64_t bits = (uint64_t)first->value;
+            for (int i = 0; i < 8; i++) emit_byte(encoder, (uint8_t)(bits >> (8 * i)));
+            return true;
+        }
+        if (strcmp(mnemonic, "leaq") == 0) {
+            if (first->type != OPERAND_MEMORY || !is_general(second, 8)) return false;
+            encode_rm1(encoder, true, 0x8D, second->reg, first, 0);
+            return true;
+        }
+        if (strcmp(mnemonic, "testq") == 0) {
+            if (!is_general(first, 8) || !is_rm(second, 8)) return false;
+            encode_rm1(encoder, true, 0x85, first->reg, second, 0);
+            return true;
+        }
+        if (strcmp(mnemonic, "movzbl") == 0) {
+            if (!is_rm(first, 1) && first->type != OPERAND_MEMORY) return false;
+            if (!is_general(second, 4)) return false;
+            encode_rm2(encoder, 0, false, 0xB6, second->reg, first);
+            return true;
+        }
+        if (strcmp(mnemonic, "shlq") == 0) return encode_shift(encoder, 4, first, second);
+        if (strcmp(mnemonic, "shrq") == 0) return encode_shift(encoder, 5, first, second);
+        if (strcmp(mnemonic, "sarq") == 0) return encode_shift(encoder, 7, first, second);
+        if (strcmp(mnemonic, "cvtsi2sdq") == 0) {
+            if (!is_rm(first, 8) || second->type != OPERAND_XMM) return false;
+            encode_rm2(encoder, 0xF2, true, 0x2A, second->reg, first);
+            return true;
+        }
+        if (strcmp(mnemonic, "cvttsd2siq") == 0) {
+            if (!is_xmm_rm(first) || !is_general(second, 8)) return false;
+            encode_rm2(encoder, 0xF2, true, 0x2C, second->reg, first);
+            return true;
+        }
+        if (strcmp(mnemonic, "ucomisd") == 0 || strcmp(mnemonic, "comisd") == 0) {
+            if (!is_xmm_rm(first) || second->type != OPERAND_XMM) return false;
+            encode_rm2(encoder, 0x66, false, mnemonic[0] == 'u' ? 0x2E : 0x2F, second->reg, first);
+            return true;
+        }
+        if (strcmp(mnemonic, "xorpd") == 0) {
+            if (!is_xmm_rm(first) || second->type != OPERAND_XMM) return false;
+            encode_rm2(encoder, 0x66, false, 0x57, second->reg, first);
+            return true;
+        }
+        if (strncmp(mnemonic, "cmov", 4) == 0) {
+            char suffix[8];
+            size_t length = strlen(mnemonic + 4);
+            if (length < 2 || length > sizeof(suffix) || mnemonic[4 + length - 1] != 'q') return false;
+            memcpy(suffix, mnemonic + 4, length - 1);
+            suffix[length - 1] = '\0';
+            int condition = condition_code(suffix);
+            if (condition < 0 || !is_rm(first, 8) || !is_general(second, 8)) return false;
+            encode_rm2(encoder, 0, true, (uint8_t)(0x40 + condition), second->reg, first);
+            return true;
+        }
+    }
+
+    if (count >= 2 && strcmp(mnemonic, "imulq") == 0) return encode_imul(encoder, operands, count);
+    if (count != 1) return false;
+
+    if (strcmp(mnemonic, "jmp") == 0) return encode_branch(encoder, -1, false, first);
+    if (strcmp(mnemonic, "call") == 0) return encode_branch(encoder, -1, true, first);
+    if (mnemonic[0] == 'j') {
+        int condition = condition_code(mnemonic + 1);
+        return condition >= 0 && encode_branch(encoder, condition, false, first);
+    }
+    if (strncmp(mnemonic, "set", 3) == 0) {
+        int condition = condition_code(mnemonic + 3);
+        if (condition < 0 || !is_rm(first, 1)) return false;
+        encode_rm2(encoder, 0, false, (uint8_t)(0x90 + condition), 0, first);
+        return true;
+    }
+    if (strcmp(mnemonic, "pushq") == 0) {
+        if (is_general(first, 8)) {
+            if (first->reg >= 8) emit_byte(encoder, 0x41);
+            emit_byte(encoder, (uint8_t)(0x50 + (first->reg & 7)));
+        } else if (first->type == OPERAND_MEMORY) {
+            encode_rm1(encoder, false, 0xFF, 6, first, 0);
+        } else if (first->type == OPERAND_IMMEDIATE && fits_int8(first->value)) {
+            emit_byte(encoder, 0x6A);
+            emit_byte(encoder, (uint8_t)(int8_t)first->value);
+        } else if (first->type == OPERAND_IMMEDIATE && fits_int32(first->value)) {
+            emit_byte(encoder, 0x68);
+            emit_int32(encoder, (int32_t)first->value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+    if (strcmp(mnemonic, "popq") == 0) {
+        if (!is_general(first, 8)) return false;
+        if (first->reg >= 8) emit_byte(encoder, 0x41);
+        emit_byte(encoder, (uint8_t)(0x58 + (first->reg & 7)));
+        return true;
+    }
+
+    // Group-3/5 single-operand forms: F7 /digit and FF /digit
+    static const struct { const char* name; uint8_t opcode; int digit; } unary[] = {
+        { "notq", 0xF7, 2 }, { "negq", 0xF7, 3 }, { "idivq", 0xF7, 7 }, { "divq", 0xF7, 6 },
+        { "incq", 0xFF, 0 }, { "decq", 0xFF, 1 }
+    };
+    for (size_t i = 0; i < sizeof(unary) / sizeof(unary[0]); i++) {
+        if (strcmp(mnemonic, unary[i].name) == 0) {
+            if (!is_rm(first, 8)) return false;
+            encode_rm1(encoder, true, unary[i].opcode, unary[i].digit, first, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool x86_64_encode(X86Encoder* encoder, const char* mnemonic, const char* operands) {
+    Operand parsed[3];
+    int count;
+    if (encoder->error) return false;
+    if (!parse_operands(encoder, operands ? operands : "", parsed, &count)) {
+        return encoder_fail(encoder, "Cannot encode operands of '%s %s'", mnemonic, operands);
+    }
+    if (!encode_instruction(encoder, mnemonic, parsed, count)) {
+        return encoder_fail(encoder, "Cannot encode '%s %s'", mnemonic, operands);
+    }
+    if (encoder->text.failed) return encoder_fail(encoder, "Out of memory for machine code");
+    return !encoder->error;
+}
+
+bool x86_64_encoder_finish(X86Encoder* encoder) {
+    if (encoder->text.failed || encoder->rodata.failed) encoder_fail(encoder, "Out of memory for machine code");
+    if (encoder->error) return false;
+
+    int kept = 0;
+    for (int i = 0; i < encoder->fixup_count; i++) {
+        X86Fixup* fixup = &encoder->fixups[i];
+        const X86Symbol* symbol = &encoder->symbols[fixup->symbol];
+        if (symbol->section == X86_SECTION_TEXT) {
+            int64_t value = (int64_t)symbol->offset + fixup->addend - (int64_t)fixup->offset;
+            uint8_t* field = encoder->text.data + fixup->offset;
+            for (int b = 0; b < 4; b++) field[b] = (uint8_t)(value >> (8 * b));
+            continue;
+        }
+        if (symbol->section == X86_SECTION_UNDEFINED && symbol->name[0] == '.') {
+            return encoder_fail(encoder, "Undefined label '%s'", symbol->name);
+        }
+        encoder->fixups[kept++] = *fixup;
+    }
+    encoder->fixup_count = kept;
+    return true;
+}
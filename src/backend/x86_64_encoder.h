@@ -0,0 +1,82 @@
+/*
+ * GPLANG x86-64 Encoder
+ * Turns the instructions the x86-64 backend emits (AT&T syntax, one
+ * mnemonic and operand string at a time) into machine code, so a
+ * binary can be produced without running the system assembler. Labels
+ * become symbols; references the encoder cannot resolve by itself
+ * (data sections, external functions) are kept as fixups for the ELF
+ * writer (elf_writer.h).
+ */
+
+#ifndef GPLANG_X86_64_ENCODER_H
+#define GPLANG_X86_64_ENCODER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    X86_SECTION_UNDEFINED,          // External: runtime library or libc
+    X86_SECTION_TEXT,
+    X86_SECTION_RODATA,
+    X86_SECTION_BSS
+} X86Section;
+
+typedef struct {
+    char* name;
+    X86Section section;
+    size_t offset;                  // Within its section
+    size_t size;                    // Data symbols only
+    bool global;
+} X86Symbol;
+
+// A 32-bit PC-relative field in .text: *field = S + addend - P
+typedef struct {
+    size_t offset;                  // Of the field in .text
+    int symbol;
+    int64_t addend;
+    bool call;                      // Call target (PLT32 when external)
+} X86Fixup;
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;                    // An allocation failed; the contents are incomplete
+} X86Buffer;
+
+typedef struct X86Encoder {
+    X86Buffer text;
+    X86Buffer rodata;
+    size_t bss_size;
+
+    X86Symbol* symbols;
+    int symbol_count;
+    int symbol_capacity;
+    int* symbol_table;              // Open-addressed index by name, -1 if empty
+    int symbol_table_size;
+
+    X86Fixup* fixups;
+    int fixup_count;
+    int fixup_capacity;
+
+    char* error;
+} X86Encoder;
+
+// Function declarations
+X86Encoder* x86_64_encoder_create(void);
+void x86_64_encoder_destroy(X86Encoder* encoder);
+
+bool x86_64_encode(X86Encoder* encoder, const char* mnemonic, const char* operands);
+void x86_64_encoder_label(X86Encoder* encoder, const char* name, bool global);
+void x86_64_encoder_data(X86Encoder* encoder, const char* name, const void* bytes, size_t size);
+void x86_64_encoder_bss(X86Encoder* encoder, const char* name, size_t size, size_t align);
+
+// Patch every fixup whose target is in .text; what is left needs the ELF writer
+bool x86_64_encoder_finish(X86Encoder* encoder);
+
+int x86_64_encoder_symbol(X86Encoder* encoder, const char* name);
+void x86_64_encoder_emit(X86Buffer* buffer, const void* bytes, size_t size);
+void x86_64_encoder_align(X86Buffer* buffer, size_t align, uint8_t fill);
+
+#endif // GPLANG_X86_64_ENCODER_H
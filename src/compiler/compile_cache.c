@@ -0,0 +1,129 @@
+/*
+ * GPLANG Compilation Cache
+ * Entries are <dir>/<key>.gpir files in ir_module_save format. They are
+ * written to a temporary name and renamed into place, so concurrent
+ * compilers never see a half-written entry. An entry's source_file
+ * records the source length and check hash it was stored under (a hit
+ * is renamed after the input file anyway); lookup compares them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "compile_cache.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+#define CHECK_PRIME_1 0x9e3779b185ebca87ULL
+#define CHECK_PRIME_2 0xc2b2ae3d27d4eb4fULL
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t length) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Multiply-rotate per byte, as in xxHash's round: unrelated to FNV-1a
+static uint64_t check_hash(uint64_t hash, const void* data, size_t length) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < length; i++) {
+        hash += bytes[i] * CHECK_PRIME_1;
+        hash = (hash << 31 | hash >> 33) * CHECK_PRIME_2;
+    }
+    return hash;
+}
+
+const char* compile_cache_dir(void) {
+    const char* dir = getenv("GPLANG_CACHE_DIR");
+    return dir && *dir ? dir : COMPILE_CACHE_DEFAULT_DIR;
+}
+
+/*
+ * Both hashes cover every input that changes the frontend's output.
+ * Fields are NUL-separated so ("ab", "c") and ("a", "bc") hash
+ * differently.
+ */
+CompileCacheKey compile_cache_key(const char* source, size_t length, const char* version, const char* target) {
+    uint32_t format = IR_FORMAT_VERSION;
+    CompileCacheKey key = { FNV_OFFSET_BASIS, 0, length };
+    const void* fields[4] = { &format, version ? version : "", target ? target : "", source };
+    size_t sizes[4] = { sizeof(format), version ? strlen(version) + 1 : 1, target ? strlen(target) + 1 : 1, length };
+
+    for (int i = 0; i < 4; i++) {
+        key.hash = fnv1a(key.hash, fields[i], sizes[i]);
+        key.check = check_hash(key.check, fields[i], sizes[i]);
+    }
+    return key;
+}
+
+static void entry_path(char* path, size_t size, const char* cache_dir, const CompileCacheKey* key) {
+    snprintf(path, size, "%s/%016llx.gpir", cache_dir, (unsigned long long)key->hash);
+}
+
+// What an entry's source_file holds
+static void entry_check(char* text, size_t size, const CompileCacheKey* key) {
+    snprintf(text, size, "gplang-cache %zu %016llx", key->length, (unsigned long long)key->check);
+}
+
+// mkdir -p
+static bool make_directories(const char* dir) {
+    char path[4096];
+    size_t length = strlen(dir);
+    if (length == 0 || length >= sizeof(path)) return false;
+    memcpy(path, dir, length + 1);
+
+    for (char* p = path + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(path, 0755) != 0 && errno != EEXIST) return false;
+        *p = '/';
+    }
+    return mkdir(path, 0755) == 0 || errno == EEXIST;
+}
+
+IRModule* compile_cache_lookup(const char* cache_dir, const CompileCacheKey* key) {
+    if (!cache_dir || !key) return NULL;
+
+    char path[4096];
+    char check[64];
+    entry_path(path, sizeof(path), cache_dir, key);
+    entry_check(check, sizeof(check), key);
+
+    IRModule* module = ir_module_load(path);
+    if (module && (!module->source_file || strcmp(module->source_file, check) != 0)) {
+        ir_module_destroy(module);      // Same hash, different inputs
+        return NULL;
+    }
+    return module;
+}
+
+bool compile_cache_store(const char* cache_dir, const CompileCacheKey* key, IRModule* module) {
+    if (!cache_dir || !key || !module || !make_directories(cache_dir)) return false;
+
+    char path[4096];
+    char temp_path[4096 + 32];
+    char check[64];
+    entry_path(path, sizeof(path), cache_dir, key);
+    entry_check(check, sizeof(check), key);
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp.%ld", path, (long)getpid());
+
+    char* source_file = module->source_file;
+    module->source_file = check;
+    bool saved = ir_module_save(module, temp_path);
+    module->source_file = source_file;
+    if (!saved) {
+        unlink(temp_path);
+        return false;
+    }
+    if (rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+/*
+ * GPLANG Compilation Cache
+ * On-disk store of frontend IR, keyed by a hash of the source bytes,
+ * compiler version and target, so unchanged modules skip the frontend
+ */
+
+#ifndef COMPILE_CACHE_H
+#define COMPILE_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../ir/ir.h"
+
+#define COMPILE_CACHE_DEFAULT_DIR "build/cache"
+
+// The hash names the entry; the length and check are stored in it and
+// must match on lookup, so a collision on the hash alone is a miss
+typedef struct {
+    uint64_t hash;                      // FNV-1a of format, version, target and source
+    uint64_t check;                     // Independent hash of the same inputs
+    size_t length;                      // Source length in bytes
+} CompileCacheKey;
+
+// Function declarations
+const char* compile_cache_dir(void);    // $GPLANG_CACHE_DIR or build/cache
+CompileCacheKey compile_cache_key(const char* source, size_t length, const char* version, const char* target);
+
+// NULL on a miss (no entry, an entry for other inputs, or one that fails to load)
+IRModule* compile_cache_lookup(const char* cache_dir, const CompileCacheKey* key);
+bool compile_cache_store(const char* cache_dir, const CompileCacheKey* key, IRModule* module);
+
+#endif // COMPILE_CACHE_H
@@ -0,0 +1,172 @@
+/*
+ * GPLANG Compiler Thread Pool
+ * Workers sleep on a condition variable between batches and claim job
+ * indices from a shared atomic counter while a batch is running.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "thread_pool.h"
+
+struct thread_pool {
+    pthread_t* threads;
+    int thread_count;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+
+    // Current batch (protected by lock, except next_index)
+    thread_pool_job_t job;
+    void* context;
+    size_t count;
+    size_t next_index;          // Claimed with atomic fetch-add
+    unsigned long generation;   // Bumped for every batch
+    int pending_workers;        // Workers that have not finished the batch
+    bool shutdown;
+};
+
+/*
+ * Claim and run indices of the current batch until none are left
+ */
+static void run_batch(thread_pool_t* pool, thread_pool_job_t job, void* context, size_t count) {
+    for (;;) {
+        size_t index = __atomic_fetch_add(&pool->next_index, 1, __ATOMIC_RELAXED);
+        if (index >= count) break;
+        job(context, index);
+    }
+}
+
+static void* worker_main(void* arg) {
+    thread_pool_t* pool = arg;
+    unsigned long seen_generation = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen_generation) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown) break;
+
+        seen_generation = pool->generation;
+        thread_pool_job_t job = pool->job;
+        void* context = pool->context;
+        size_t count = pool->count;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_batch(pool, job, context, count);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending_workers == 0) {
+            pthread_cond_signal(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/*
+ * Number of online CPUs (at least 1)
+ */
+int thread_pool_default_size(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+/*
+ * Create pool; thread_count includes the calling thread, so a pool of
+ * size 1 spawns no workers and runs every job inline.
+ */
+thread_pool_t* thread_pool_create(int thread_count) {
+    if (thread_count < 1) {
+        thread_count = thread_pool_default_size();
+    }
+
+    thread_pool_t* pool = calloc(1, sizeof(thread_pool_t));
+    if (!pool) return NULL;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    pool->threads = calloc(thread_count, sizeof(pthread_t));
+    if (!pool->threads) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    pool->thread_count = 1;
+    for (int i = 1; i < thread_count; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            printf("⚠️  Thread pool: started %d of %d threads\n", pool->thread_count, thread_count);
+            break;
+        }
+        pool->thread_count++;
+    }
+
+    return pool;
+}
+
+/*
+ * Stop workers and release the pool
+ */
+void thread_pool_destroy(thread_pool_t* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 1; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+int thread_pool_size(const thread_pool_t* pool) {
+    return pool ? pool->thread_count : 1;
+}
+
+/*
+ * Run a batch of count jobs and wait for all of them
+ */
+void thread_pool_run(thread_pool_t* pool, size_t count, thread_pool_job_t job, void* context) {
+    if (count == 0 || !job) return;
+
+    // Serial fallback: no pool, no workers or a single job
+    if (!pool || pool->thread_count == 1 || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            job(context, i);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pool->context = context;
+    pool->count = count;
+    pool->next_index = 0;
+    pool->generation++;
+    pool->pending_workers = pool->thread_count - 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    run_batch(pool, job, context, count);
+
+    // Every worker checks in before the batch's context may be reused;
+    // late wakers find no indices left and finish at once
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending_workers > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
@@ -0,0 +1,28 @@
+/*
+ * GPLANG Compiler Thread Pool
+ * Fixed set of worker threads for running independent compiler jobs
+ * (whole files, functions) concurrently
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+
+// Job callback: invoked once for every index in [0, count)
+typedef void (*thread_pool_job_t)(void* context, size_t index);
+
+typedef struct thread_pool thread_pool_t;
+
+// Function declarations
+thread_pool_t* thread_pool_create(int thread_count);
+void thread_pool_destroy(thread_pool_t* pool);
+int thread_pool_size(const thread_pool_t* pool);
+int thread_pool_default_size(void);
+
+// Run job(context, i) for every i in [0, count) and wait for completion.
+// Indices are handed out dynamically, so uneven jobs balance across
+// workers; the calling thread takes part as well.
+void thread_pool_run(thread_pool_t* pool, size_t count, thread_pool_job_t job, void* context);
+
+#endif // THREAD_POOL_H
@@ -80,6 +80,17 @@ ast_node_t* create_boolean_node(int value) {
 void add_child(ast_node_t* parent, ast_node_t* child) {
     if (!parent || !child) return;
     
+    // Arena-owned nodes grow their child vector inside the arena
+    if (parent->arena) {
+        if (parent->child_count >= parent->child_capacity &&
+            ast_arena_grow_children(parent->arena, parent) != 0) {
+            printf("❌ Failed to resize AST children array\n");
+            return;
+        }
+        parent->children[parent->child_count++] = child;
+        return;
+    }
+    
     // Resize if needed
     if (parent->child_count >= parent->child_capacity) {
         parent->child_capacity *= 2;
@@ -100,6 +111,9 @@ void add_child(ast_node_t* parent, ast_node_t* child) {
 void free_ast_node(ast_node_t* node) {
     if (!node) return;
     
+    // Arena-owned trees are released in bulk by ast_arena_destroy
+    if (node->arena) return;
+    
     // Free children recursively
     for (size_t i = 0; i < node->child_count; i++) {
         free_ast_node(node->children[i]);
@@ -149,7 +163,8 @@ void print_ast(ast_node_t* node, int depth) {
             printf("PROGRAM\n");
             break;
         case AST_FUNCTION:
-            printf("FUNCTION: %s\n", node->data.function.name);
+            printf("FUNCTION: %s%s\n", node->data.function.is_inline ? "inline " : "",
+                   node->data.function.name);
             break;
         case AST_VARIABLE:
             printf("VARIABLE: %s\n", node->data.variable.name);
@@ -217,99 +232,21 @@ size_t count_ast_nodes(ast_node_t* node) {
 }
 
 /*
- * Parse parameter list
- */
-ast_node_t* parse_parameter_list(void) {
-    ast_node_t* params = create_ast_node(AST_BLOCK);
-    
-    // TODO: Implement parameter parsing
-    // For now, return empty parameter list
-    
-    return params;
-}
-
-/*
- * Parse type annotation
- */
-ast_node_t* parse_type(void) {
-    // TODO: Implement type parsing
-    // For now, return identifier node
-    return create_identifier_node("auto");
-}
-
-/*
- * Parse return statement
- */
-ast_node_t* parse_return_statement(void) {
-    ast_node_t* return_node = create_ast_node(AST_RETURN);
-    
-    // TODO: Implement return statement parsing
-    
-    return return_node;
-}
-
-/*
- * Parse variable declaration
- */
-ast_node_t* parse_variable_declaration(void) {
-    ast_node_t* var_node = create_ast_node(AST_VARIABLE);
-    
-    // TODO: Implement variable declaration parsing
-    
-    return var_node;
-}
-
-/*
- * Parse import statement
+ * Value of an integer literal, negated any number of times: range()
+ * steps written as -1 or -(-2) fix the loop's direction at compile time
  */
-ast_node_t* parse_import_statement(void) {
-    ast_node_t* import_node = create_ast_node(AST_IMPORT);
-    
-    // TODO: Implement import statement parsing
-    
-    return import_node;
-}
-
-/*
- * Parse expression statement
- */
-ast_node_t* parse_expression_statement(void) {
-    ast_node_t* expr_stmt = create_ast_node(AST_EXPRESSION_STMT);
-    
-    // TODO: Implement expression statement parsing
-    
-    return expr_stmt;
-}
-
-/*
- * Parse match case
- */
-ast_node_t* parse_match_case(void) {
-    ast_node_t* case_node = create_ast_node(AST_BLOCK);
-    
-    // TODO: Implement match case parsing
-    
-    return case_node;
-}
-
-/*
- * Parse array literal
- */
-ast_node_t* parse_array_literal(void) {
-    ast_node_t* array_node = create_ast_node(AST_ARRAY);
-    
-    // TODO: Implement array literal parsing
-    
-    return array_node;
-}
-
-/*
- * Parse object literal
- */
-ast_node_t* parse_object_literal(void) {
-    ast_node_t* object_node = create_ast_node(AST_OBJECT);
-    
-    // TODO: Implement object literal parsing
-    
-    return object_node;
+bool ast_integer_constant(ast_node_t* node, long long* value) {
+    if (!node) return false;
+    if (node->type == AST_NUMBER) {
+        const char* text = node->data.literal.value;
+        if (!text || (strpbrk(text, ".eE") && strncmp(text, "0x", 2) != 0)) return false;
+        *value = strtoll(text, NULL, 0);
+        return true;
+    }
+    if (node->type == AST_UNARY_OP && node->data.unary_op.operator == TOKEN_MINUS &&
+        ast_integer_constant(node->data.unary_op.operand, value)) {
+        *value = -*value;
+        return true;
+    }
+    return false;
 }
@@ -0,0 +1,221 @@
+/*
+ * GPLANG AST Arena
+ * Bump allocation for AST nodes, child vectors and interned strings
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "parser.h"
+
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 16
+#define INTERN_INITIAL_CAPACITY 256
+
+// Arena chunk (allocations are carved from data[])
+typedef struct arena_chunk {
+    struct arena_chunk* next;
+    size_t size;
+    size_t used;
+    _Alignas(ARENA_ALIGNMENT) unsigned char data[];
+} arena_chunk_t;
+
+// Interned string table entry
+typedef struct {
+    const char* text;
+    uint32_t length;
+    uint32_t hash;
+} intern_entry_t;
+
+struct ast_arena {
+    arena_chunk_t* chunks;
+    size_t bytes_allocated;
+    size_t node_count;
+
+    // Open-addressing table of interned strings
+    intern_entry_t* interned;
+    size_t intern_count;
+    size_t intern_capacity;
+};
+
+/*
+ * Create AST arena
+ */
+ast_arena_t* ast_arena_create(void) {
+    ast_arena_t* arena = calloc(1, sizeof(ast_arena_t));
+    if (!arena) return NULL;
+
+    arena->intern_capacity = INTERN_INITIAL_CAPACITY;
+    arena->interned = calloc(arena->intern_capacity, sizeof(intern_entry_t));
+    if (!arena->interned) {
+        free(arena);
+        return NULL;
+    }
+
+    return arena;
+}
+
+/*
+ * Destroy arena, releasing every node and string it owns at once
+ */
+void ast_arena_destroy(ast_arena_t* arena) {
+    if (!arena) return;
+
+    arena_chunk_t* chunk = arena->chunks;
+    while (chunk) {
+        arena_chunk_t* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(arena->interned);
+    free(arena);
+}
+
+/*
+ * Bump-allocate zeroed memory from the arena
+ */
+void* ast_arena_alloc(ast_arena_t* arena, size_t size) {
+    if (!arena) return NULL;
+
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    arena_chunk_t* chunk = arena->chunks;
+    if (!chunk || chunk->size - chunk->used < size) {
+        size_t chunk_size = size > ARENA_CHUNK_SIZE ? size : ARENA_CHUNK_SIZE;
+        chunk = malloc(sizeof(arena_chunk_t) + chunk_size);
+        if (!chunk) {
+            printf("❌ Failed to allocate AST arena chunk\n");
+            return NULL;
+        }
+        chunk->size = chunk_size;
+        chunk->used = 0;
+
+        // Oversized blocks go behind the current chunk so it keeps filling
+        if (arena->chunks && chunk_size > ARENA_CHUNK_SIZE) {
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        } else {
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
+        arena->bytes_allocated += chunk_size;
+    }
+
+    void* ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+/*
+ * Hash a string span (FNV-1a)
+ */
+static uint32_t intern_hash(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void intern_grow(ast_arena_t* arena) {
+    size_t capacity = arena->intern_capacity * 2;
+    intern_entry_t* table = calloc(capacity, sizeof(intern_entry_t));
+    if (!table) return;
+
+    for (size_t i = 0; i < arena->intern_capacity; i++) {
+        intern_entry_t* entry = &arena->interned[i];
+        if (!entry->text) continue;
+
+        size_t slot = entry->hash & (capacity - 1);
+        while (table[slot].text) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        table[slot] = *entry;
+    }
+
+    free(arena->interned);
+    arena->interned = table;
+    arena->intern_capacity = capacity;
+}
+
+/*
+ * Intern a string span: equal spans always yield the same pointer,
+ * so interned names can be compared by address.
+ */
+const char* ast_arena_intern(ast_arena_t* arena, const char* text, size_t length) {
+    if (!arena || !text) return NULL;
+
+    uint32_t hash = intern_hash(text, length);
+    size_t mask = arena->intern_capacity - 1;
+    size_t slot = hash & mask;
+
+    while (arena->interned[slot].text) {
+        intern_entry_t* entry = &arena->interned[slot];
+        if (entry->hash == hash && entry->length == length &&
+            memcmp(entry->text, text, length) == 0) {
+            return entry->text;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    char* copy = ast_arena_alloc(arena, length + 1);
+    if (!copy) return NULL;
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+
+    arena->interned[slot].text = copy;
+    arena->interned[slot].length = (uint32_t)length;
+    arena->interned[slot].hash = hash;
+
+    // Keep load factor below 1/2
+    if (++arena->intern_count * 2 > arena->intern_capacity) {
+        intern_grow(arena);
+    }
+
+    return copy;
+}
+
+/*
+ * Create arena-owned AST node (child vector is allocated on first add_child)
+ */
+ast_node_t* ast_arena_create_node(ast_arena_t* arena, ast_node_type_t type) {
+    ast_node_t* node = ast_arena_alloc(arena, sizeof(ast_node_t));
+    if (!node) return NULL;
+
+    node->type = type;
+    node->arena = arena;
+    arena->node_count++;
+    return node;
+}
+
+/*
+ * Grow an arena-owned node's child vector (old vector stays in the arena)
+ */
+int ast_arena_grow_children(ast_arena_t* arena, ast_node_t* node) {
+    size_t capacity = node->child_capacity ? node->child_capacity * 2 : 4;
+    ast_node_t** children = ast_arena_alloc(arena, capacity * sizeof(ast_node_t*));
+    if (!children) return -1;
+
+    if (node->child_count > 0) {
+        memcpy(children, node->children, node->child_count * sizeof(ast_node_t*));
+    }
+    node->children = children;
+    node->child_capacity = capacity;
+    return 0;
+}
+
+/*
+ * Arena statistics
+ */
+size_t ast_arena_bytes_allocated(const ast_arena_t* arena) {
+    return arena ? arena->bytes_allocated : 0;
+}
+
+size_t ast_arena_node_count(const ast_arena_t* arena) {
+    return arena ? arena->node_count : 0;
+}
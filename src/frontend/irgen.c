@@ -0,0 +1,774 @@
+/*
+ * GPLANG IR Generator
+ * Lowers the AST into IR. Every local lives in an entry-block stack slot
+ * (alloca) and is accessed with load/store; values are fresh registers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "irgen.h"
+
+// Use strdup from ir.c
+extern char* my_strdup(const char* s);
+
+typedef struct {
+    IRBuilder* builder;
+    IRFunction* function;
+    IRInstruction* alloca_tail;     // Last alloca at the head of the entry block
+} IRGen;
+
+static void lower_statement(IRGen* g, ast_node_t* node);
+static IRValue* lower_expression(IRGen* g, ast_node_t* node);
+
+/*
+ * Stack slot for a local, placed with the other allocas at the top of
+ * the entry block so it is allocated once even inside loops
+ */
+static IRValue* entry_alloca(IRGen* g, const char* name) {
+    IRBasicBlock* entry = g->function->entry_block;
+    IRInstruction* inst = ir_instruction_create(IR_ALLOCA);
+    if (!inst) return NULL;
+
+    inst->dest = ir_value_create_register(g->function->next_register_id++);
+    inst->src1 = ir_value_create_constant_string(name);
+
+    if (g->alloca_tail) {
+        inst->next = g->alloca_tail->next;
+        g->alloca_tail->next = inst;
+        if (entry->last_instruction == g->alloca_tail) entry->last_instruction = inst;
+    } else {
+        inst->next = entry->instructions;
+        entry->instructions = inst;
+        if (!entry->last_instruction) entry->last_instruction = inst;
+    }
+    g->alloca_tail = inst;
+    return inst->dest;
+}
+
+// Declare a local initialised with value
+static void declare_local(IRGen* g, const char* name, IRValue* value) {
+    if (!name) return;
+
+    // Variables declared by top-level statements are module globals
+    if (strcmp(g->function->name, "__init") == 0) {
+        IRValue* global = ir_value_create_global(name);
+        if (value) ir_builder_store(g->builder, value, global);
+        ir_value_destroy(global);
+        return;
+    }
+
+    IRValue* slot = entry_alloca(g, name);
+    if (!slot) return;
+    if (value) ir_builder_store(g->builder, value, slot);
+    ir_builder_add_symbol(g->builder, name, slot);
+}
+
+// Statements after return/jump start a fresh (unreachable) block
+static void ensure_open_block(IRGen* g) {
+    if (ir_basic_block_is_terminated(g->builder->current_block)) {
+        ir_builder_set_block(g->builder, ir_builder_create_block(g->builder, "dead"));
+    }
+}
+
+static void jump_if_open(IRGen* g, IRBasicBlock* target) {
+    if (!ir_basic_block_is_terminated(g->builder->current_block)) {
+        ir_builder_jump(g->builder, target);
+    }
+}
+
+static IROpcode binary_opcode(TokenType op) {
+    switch (op) {
+        case TOKEN_PLUS: return IR_ADD;
+        case TOKEN_MINUS: return IR_SUB;
+        case TOKEN_MULTIPLY: return IR_MUL;
+        case TOKEN_DIVIDE: return IR_DIV;
+        case TOKEN_MODULO: return IR_MOD;
+        case TOKEN_EQ: return IR_EQ;
+        case TOKEN_NE: return IR_NE;
+        case TOKEN_LT: return IR_LT;
+        case TOKEN_LE: return IR_LE;
+        case TOKEN_GT: return IR_GT;
+        case TOKEN_GE: return IR_GE;
+        case TOKEN_AND: return IR_AND;
+        case TOKEN_OR: return IR_OR;
+        default: return IR_NOP;
+    }
+}
+
+static bool is_logical(const ast_node_t* node) {
+    return node && node->type == AST_BINARY_OP &&
+           (node->data.binary_op.operator == TOKEN_AND || node->data.binary_op.operator == TOKEN_OR);
+}
+
+// Evaluating node has no side effect and cannot trap, so it may run
+// even where the source would skip it
+static bool speculable(const ast_node_t* node) {
+    if (!node) return false;
+    switch (node->type) {
+        case AST_NUMBER: case AST_STRING: case AST_BOOLEAN: case AST_LITERAL: case AST_IDENTIFIER:
+            return true;
+        case AST_UNARY_OP:
+            return (node->data.unary_op.operator == TOKEN_MINUS || node->data.unary_op.operator == TOKEN_NOT) &&
+                   speculable(node->data.unary_op.operand);
+        case AST_BINARY_OP: {
+            TokenType op = node->data.binary_op.operator;
+            if (op == TOKEN_DIVIDE || op == TOKEN_MODULO || op == TOKEN_POWER) return false;
+            return speculable(node->data.binary_op.left) && speculable(node->data.binary_op.right);
+        }
+        default:
+            return false;
+    }
+}
+
+/*
+ * Branch to on_true or on_false on node's truth value. and/or only
+ * evaluate their right operand when the left does not decide them.
+ */
+static void lower_branch(IRGen* g, ast_node_t* node, IRBasicBlock* on_true, IRBasicBlock* on_false) {
+    IRBuilder* b = g->builder;
+    if (is_logical(node)) {
+        bool is_and = node->data.binary_op.operator == TOKEN_AND;
+        IRBasicBlock* right = ir_builder_create_block(b, is_and ? "and.rhs" : "or.rhs");
+        lower_branch(g, node->data.binary_op.left, is_and ? right : on_true, is_and ? on_false : right);
+        ir_builder_set_block(b, right);
+        lower_branch(g, node->data.binary_op.right, on_true, on_false);
+        return;
+    }
+    if (node && node->type == AST_UNARY_OP && node->data.unary_op.operator == TOKEN_NOT) {
+        lower_branch(g, node->data.unary_op.operand, on_false, on_true);
+        return;
+    }
+
+    IRValue* condition = lower_expression(g, node);
+    if (condition) {
+        ir_builder_branch(b, condition, on_true, on_false);
+    } else {
+        ir_builder_jump(b, on_false);
+    }
+}
+
+/*
+ * and/or as a value: 1 or 0 through a stack slot. A right operand that
+ * is safe to speculate is evaluated eagerly instead, which the backends
+ * lower without branches.
+ */
+static IRValue* lower_logical(IRGen* g, ast_node_t* node) {
+    IRBuilder* b = g->builder;
+    if (speculable(node->data.binary_op.right)) {
+        IRValue* left = lower_expression(g, node->data.binary_op.left);
+        IRValue* right = lower_expression(g, node->data.binary_op.right);
+        if (!left || !right) return NULL;
+        return ir_builder_binary(b, binary_opcode(node->data.binary_op.operator), left, right);
+    }
+
+    IRValue* slot = entry_alloca(g, "logic.result");
+    if (!slot) return NULL;
+    IRBasicBlock* true_block = ir_builder_create_block(b, "logic.true");
+    IRBasicBlock* false_block = ir_builder_create_block(b, "logic.false");
+    IRBasicBlock* end_block = ir_builder_create_block(b, "logic.end");
+
+    lower_branch(g, node, true_block, false_block);
+    ir_builder_set_block(b, true_block);
+    ir_builder_store(b, ir_builder_const_int(b, 1), slot);
+    ir_builder_jump(b, end_block);
+    ir_builder_set_block(b, false_block);
+    ir_builder_store(b, ir_builder_const_int(b, 0), slot);
+    ir_builder_jump(b, end_block);
+
+    ir_builder_set_block(b, end_block);
+    return ir_builder_load(b, slot);
+}
+
+/*
+ * Call name(extra, args...) where extra is an optional receiver
+ */
+static IRValue* lower_call_named(IRGen* g, const char* name, IRValue* receiver, ast_node_t* call) {
+    int arg_count = (int)call->child_count + (receiver ? 1 : 0);
+    IRValue** args = calloc(arg_count ? arg_count : 1, sizeof(IRValue*));
+    if (!args) return NULL;
+
+    int n = 0;
+    if (receiver) args[n++] = receiver;
+    for (size_t i = 0; i < call->child_count; i++) {
+        IRValue* arg = lower_expression(g, call->children[i]);
+        if (arg) args[n++] = arg;
+    }
+
+    IRValue* result = ir_builder_call(g->builder, name, args, n);
+    free(args);
+    return result;
+}
+
+static IRValue* lower_call(IRGen* g, ast_node_t* node) {
+    ast_node_t* callee = node->data.call.callee;
+    if (!callee) return NULL;
+
+    if (callee->type == AST_IDENTIFIER) {
+        return lower_call_named(g, callee->data.identifier.name, NULL, node);
+    }
+
+    if (callee->type == AST_MEMBER) {
+        ast_node_t* object = callee->data.member.object;
+
+        // Module or type function: Time.now(), math.sqrt(x)
+        if (object && object->type == AST_IDENTIFIER &&
+            !ir_builder_get_symbol(g->builder, object->data.identifier.name)) {
+            char name[256];
+            snprintf(name, sizeof(name), "%s.%s", object->data.identifier.name, callee->data.member.name);
+            return lower_call_named(g, name, NULL, node);
+        }
+
+        // Method: the receiver becomes the first argument
+        IRValue* receiver = lower_expression(g, object);
+        char name[256];
+        snprintf(name, sizeof(name), "__method_%s", callee->data.member.name);
+        return lower_call_named(g, name, receiver, node);
+    }
+
+    // Indirect call through a computed value
+    IRValue* target = lower_expression(g, callee);
+    IRValue* result = lower_call_named(g, "__call_indirect", target, node);
+    return result;
+}
+
+/*
+ * Runtime helper call with already lowered operands
+ */
+static IRValue* call_helper(IRGen* g, const char* name, IRValue* a, IRValue* b, IRValue* c) {
+    IRValue* args[3];
+    int n = 0;
+    if (a) args[n++] = a;
+    if (b) args[n++] = b;
+    if (c) args[n++] = c;
+    return ir_builder_call(g->builder, name, args, n);
+}
+
+static IRValue* lower_literal_list(IRGen* g, const char* helper, const char* type_name, ast_node_t* node) {
+    int count = (int)node->child_count + (type_name ? 1 : 0);
+    IRValue** args = calloc(count ? count : 1, sizeof(IRValue*));
+    if (!args) return NULL;
+
+    int n = 0;
+    if (type_name) args[n++] = ir_builder_const_string(g->builder, type_name);
+    for (size_t i = 0; i < node->child_count; i++) {
+        ast_node_t* element = node->children[i];
+        // Object fields are AST_VARIABLE name/value pairs
+        ast_node_t* value = element && element->type == AST_VARIABLE ? element->data.variable.value : element;
+        IRValue* lowered = lower_expression(g, value);
+        if (lowered) args[n++] = lowered;
+    }
+
+    IRValue* result = ir_builder_call(g->builder, helper, args, n);
+    free(args);
+    return result;
+}
+
+static IRValue* lower_number(IRGen* g, const char* text) {
+    if (!text) return ir_builder_const_int(g->builder, 0);
+
+    if (strpbrk(text, ".eE") && strncmp(text, "0x", 2) != 0) {
+        return ir_builder_const_float(g->builder, strtod(text, NULL));
+    }
+    return ir_builder_const_int(g->builder, strtoll(text, NULL, 0));
+}
+
+static IRValue* lower_expression(IRGen* g, ast_node_t* node) {
+    if (!node) return NULL;
+    IRBuilder* b = g->builder;
+
+    switch (node->type) {
+        case AST_NUMBER:
+            return lower_number(g, node->data.literal.value);
+
+        case AST_STRING:
+            return ir_builder_const_string(b, node->data.literal.value ? node->data.literal.value : "");
+
+        case AST_BOOLEAN:
+            return ir_builder_const_int(b, node->data.literal.value &&
+                                           strcmp(node->data.literal.value, "true") == 0);
+
+        case AST_IDENTIFIER: {
+            IRValue* slot = ir_builder_get_symbol(b, node->data.identifier.name);
+            if (slot) return ir_builder_load(b, slot);
+
+            // Not a local: read the global of that name
+            IRValue* global = ir_value_create_global(node->data.identifier.name);
+            IRValue* value = ir_builder_load(b, global);
+            ir_value_destroy(global);
+            return value;
+        }
+
+        case AST_BINARY_OP: {
+            if (is_logical(node)) return lower_logical(g, node);
+            IRValue* left = lower_expression(g, node->data.binary_op.left);
+            IRValue* right = lower_expression(g, node->data.binary_op.right);
+            if (!left || !right) return NULL;
+
+            if (node->data.binary_op.operator == TOKEN_POWER) {
+                return call_helper(g, "pow", left, right, NULL);
+            }
+            IROpcode opcode = binary_opcode(node->data.binary_op.operator);
+            if (opcode == IR_NOP) return NULL;
+            return ir_builder_binary(b, opcode, left, right);
+        }
+
+        case AST_UNARY_OP: {
+            IRValue* operand = lower_expression(g, node->data.unary_op.operand);
+            if (!operand) return NULL;
+
+            switch (node->data.unary_op.operator) {
+                case TOKEN_MINUS:
+                    return ir_builder_binary(b, IR_SUB, ir_builder_const_int(b, 0), operand);
+                case TOKEN_NOT:
+                    return ir_builder_unary(b, IR_NOT, operand);
+                case TOKEN_AWAIT:
+                    return ir_builder_unary(b, IR_AWAIT, operand);
+                case TOKEN_SPAWN:
+                    return ir_builder_unary(b, IR_SPAWN, operand);
+                default:
+                    return operand;
+            }
+        }
+
+        case AST_CALL:
+            return lower_call(g, node);
+
+        case AST_MEMBER: {
+            ast_node_t* object = node->data.member.object;
+            if (object && object->type == AST_IDENTIFIER &&
+                !ir_builder_get_symbol(b, object->data.identifier.name)) {
+                char name[256];
+                snprintf(name, sizeof(name), "%s.%s", object->data.identifier.name, node->data.member.name);
+                IRValue* global = ir_value_create_global(name);
+                IRValue* value = ir_builder_load(b, global);
+                ir_value_destroy(global);
+                return value;
+            }
+            IRValue* receiver = lower_expression(g, object);
+            return call_helper(g, "__member_get", receiver,
+                               ir_builder_const_string(b, node->data.member.name), NULL);
+        }
+
+        case AST_INDEX: {
+            IRValue* object = lower_expression(g, node->data.index.object);
+            IRValue* index = lower_expression(g, node->data.index.index);
+            return call_helper(g, "__index_get", object, index, NULL);
+        }
+
+        case AST_ARRAY:
+            return lower_literal_list(g, "__array_new", NULL, node);
+
+        case AST_OBJECT:
+            return lower_literal_list(g, "__object_new",
+                                      node->data.identifier.name ? node->data.identifier.name : "", node);
+
+        case AST_ASSIGN:
+            lower_statement(g, node);
+            return NULL;
+
+        default:
+            return NULL;
+    }
+}
+
+/*
+ * Assignment: plain stores to locals/globals, helper calls for
+ * members and elements; compound operators read-modify-write
+ */
+static void lower_assign(IRGen* g, ast_node_t* node) {
+    IRBuilder* b = g->builder;
+    ast_node_t* target = node->data.assign.target;
+    if (!target) return;
+
+    IRValue* value = lower_expression(g, node->data.assign.value);
+    if (!value) return;
+
+    TokenType op = node->data.assign.operator;
+    if (op != TOKEN_ASSIGN) {
+        IRValue* current = lower_expression(g, target);
+        IROpcode opcode = binary_opcode(op);
+        if (!current || opcode == IR_NOP) return;
+        value = ir_builder_binary(b, opcode, current, value);
+    }
+
+    switch (target->type) {
+        case AST_IDENTIFIER: {
+            IRValue* slot = ir_builder_get_symbol(b, target->data.identifier.name);
+            if (slot) {
+                ir_builder_store(b, value, slot);
+            } else {
+                IRValue* global = ir_value_create_global(target->data.identifier.name);
+                ir_builder_store(b, value, global);
+                ir_value_destroy(global);
+            }
+            break;
+        }
+        case AST_MEMBER: {
+            IRValue* object = lower_expression(g, target->data.member.object);
+            call_helper(g, "__member_set", object,
+                        ir_builder_const_string(b, target->data.member.name), value);
+            break;
+        }
+        case AST_INDEX: {
+            IRValue* object = lower_expression(g, target->data.index.object);
+            IRValue* index = lower_expression(g, target->data.index.index);
+            call_helper(g, "__index_set", object, index, value);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void lower_block(IRGen* g, ast_node_t* block) {
+    if (!block) return;
+
+    int scope = g->builder->symbol_count;
+    if (block->type == AST_BLOCK) {
+        for (size_t i = 0; i < block->child_count; i++) {
+            lower_statement(g, block->children[i]);
+        }
+    } else {
+        lower_statement(g, block);
+    }
+    ir_builder_pop_symbols(g->builder, scope);
+}
+
+static void lower_if(IRGen* g, ast_node_t* node) {
+    IRBuilder* b = g->builder;
+    IRBasicBlock* then_block = ir_builder_create_block(b, "if.then");
+    IRBasicBlock* else_block = node->data.if_stmt.else_block ? ir_builder_create_block(b, "if.else") : NULL;
+    IRBasicBlock* end_block = ir_builder_create_block(b, "if.end");
+
+    lower_branch(g, node->data.if_stmt.condition, then_block, else_block ? else_block : end_block);
+
+    ir_builder_set_block(b, then_block);
+    lower_block(g, node->data.if_stmt.then_block);
+    jump_if_open(g, end_block);
+
+    if (else_block) {
+        ir_builder_set_block(b, else_block);
+        lower_block(g, node->data.if_stmt.else_block);
+        jump_if_open(g, end_block);
+    }
+
+    ir_builder_set_block(b, end_block);
+}
+
+static void lower_while(IRGen* g, ast_node_t* node) {
+    IRBuilder* b = g->builder;
+    IRBasicBlock* cond_block = ir_builder_create_block(b, "while.cond");
+    IRBasicBlock* body_block = ir_builder_create_block(b, "while.body");
+    IRBasicBlock* end_block = ir_builder_create_block(b, "while.end");
+
+    ir_builder_jump(b, cond_block);
+    ir_builder_set_block(b, cond_block);
+    lower_branch(g, node->data.while_stmt.condition, body_block, end_block);
+
+    ir_builder_set_block(b, body_block);
+    lower_block(g, node->data.while_stmt.body);
+    jump_if_open(g, cond_block);
+
+    ir_builder_set_block(b, end_block);
+}
+
+/*
+ * for v in range(...) is a counted loop; any other iterable walks
+ * indices 0..len(iterable) and reads each element.
+ *
+ *   for.cond:  i < end ? for.body : for.end     (i > end for a negative step)
+ *   for.body:  ...; jump for.step
+ *   for.step:  i += step; jump for.cond
+ *
+ * A step that is not a literal splits for.cond on its sign, tested
+ * once before the loop: for.up compares i < end, for.down i > end.
+ */
+static void lower_for(IRGen* g, ast_node_t* node) {
+    IRBuilder* b = g->builder;
+    ast_node_t* iterable = node->data.for_stmt.iterable;
+    const char* variable = node->data.for_stmt.variable;
+    if (!iterable || !variable) return;
+
+    int scope = b->symbol_count;
+    bool is_range = iterable->type == AST_CALL && iterable->data.call.callee &&
+                    iterable->data.call.callee->type == AST_IDENTIFIER &&
+                    strcmp(iterable->data.call.callee->data.identifier.name, "range") == 0 &&
+                    iterable->child_count >= 1 && iterable->child_count <= 3;
+
+    IRValue* start;
+    IRValue* end;
+    IRValue* step;
+    IRValue* collection = NULL;
+    IROpcode compare = IR_LT;
+    IRValue* counts_up = NULL;
+
+    if (is_range) {
+        if (iterable->child_count == 1) {
+            start = ir_builder_const_int(b, 0);
+            end = lower_expression(g, iterable->children[0]);
+        } else {
+            start = lower_expression(g, iterable->children[0]);
+            end = lower_expression(g, iterable->children[1]);
+        }
+        if (iterable->child_count == 3) {
+            ast_node_t* step_node = iterable->children[2];
+            long long value;
+            step = lower_expression(g, step_node);
+            if (ast_integer_constant(step_node, &value)) {
+                if (value < 0) compare = IR_GT;
+            } else if (step) {
+                // Direction known only at run time: test the sign once, up front
+                counts_up = ir_builder_binary(b, IR_GT, step, ir_builder_const_int(b, 0));
+            }
+        } else {
+            step = ir_builder_const_int(b, 1);
+        }
+    } else {
+        collection = lower_expression(g, iterable);
+        start = ir_builder_const_int(b, 0);
+        end = call_helper(g, "len", collection, NULL, NULL);
+        step = ir_builder_const_int(b, 1);
+    }
+    if (!start || !end || !step) return;
+
+    // Induction slot: the loop variable itself for ranges, a hidden index otherwise
+    IRValue* index_slot = entry_alloca(g, is_range ? variable : "for.index");
+    if (!index_slot) return;
+    ir_builder_store(b, start, index_slot);
+    if (is_range) ir_builder_add_symbol(b, variable, index_slot);
+
+    IRBasicBlock* cond_block = ir_builder_create_block(b, "for.cond");
+    IRBasicBlock* body_block = ir_builder_create_block(b, "for.body");
+    IRBasicBlock* step_block = ir_builder_create_block(b, "for.step");
+    IRBasicBlock* end_block = ir_builder_create_block(b, "for.end");
+
+    ir_builder_jump(b, cond_block);
+    ir_builder_set_block(b, cond_block);
+    IRValue* index = ir_builder_load(b, index_slot);
+    if (counts_up) {
+        IRBasicBlock* up_block = ir_builder_create_block(b, "for.up");
+        IRBasicBlock* down_block = ir_builder_create_block(b, "for.down");
+        ir_builder_branch(b, counts_up, up_block, down_block);
+        if (node->data.for_stmt.is_parallel && cond_block->last_instruction) {
+            cond_block->last_instruction->comment = my_strdup("parallel");
+        }
+
+        ir_builder_set_block(b, up_block);
+        ir_builder_branch(b, ir_builder_binary(b, IR_LT, index, end), body_block, end_block);
+        ir_builder_set_block(b, down_block);
+        ir_builder_branch(b, ir_builder_binary(b, IR_GT, index, end), body_block, end_block);
+    } else {
+        IRValue* in_range = ir_builder_binary(b, compare, index, end);
+        ir_builder_branch(b, in_range, body_block, end_block);
+        if (node->data.for_stmt.is_parallel && cond_block->last_instruction) {
+            cond_block->last_instruction->comment = my_strdup("parallel");
+        }
+    }
+
+    ir_builder_set_block(b, body_block);
+    if (!is_range) {
+        IRValue* current = ir_builder_load(b, index_slot);
+        declare_local(g, variable, call_helper(g, "__index_get", collection, current, NULL));
+    }
+    lower_block(g, node->data.for_stmt.body);
+    jump_if_open(g, step_block);
+
+    ir_builder_set_block(b, step_block);
+    IRValue* next = ir_builder_add(b, ir_builder_load(b, index_slot), step);
+    ir_builder_store(b, next, index_slot);
+    ir_builder_jump(b, cond_block);
+
+    ir_builder_set_block(b, end_block);
+    ir_builder_pop_symbols(b, scope);
+}
+
+/*
+ * match: cases are tested in order. Literal patterns compare for
+ * equality; a name binds the value and matches anything, like "_".
+ * Constructor patterns (Some(x), Ok(v)) are not discriminated yet and
+ * also match unconditionally.
+ */
+static void lower_match(IRGen* g, ast_node_t* node) {
+    IRBuilder* b = g->builder;
+    IRValue* subject = lower_expression(g, node->data.match_stmt.expression);
+    if (!subject) return;
+
+    IRBasicBlock* end_block = ir_builder_create_block(b, "match.end");
+
+    for (size_t i = 0; i < node->data.match_stmt.case_count; i++) {
+        ast_node_t* match_case = node->data.match_stmt.cases[i];
+        if (!match_case || match_case->child_count < 2) continue;
+
+        ast_node_t* pattern = match_case->children[0];
+        ast_node_t* body = match_case->children[1];
+        ast_node_t* guard = match_case->child_count > 2 ? match_case->children[2] : NULL;
+
+        IRBasicBlock* body_block = ir_builder_create_block(b, "match.case");
+        IRBasicBlock* next_block = ir_builder_create_block(b, "match.next");
+        int scope = b->symbol_count;
+
+        bool is_literal = pattern && (pattern->type == AST_NUMBER || pattern->type == AST_STRING ||
+                                      pattern->type == AST_BOOLEAN);
+        if (is_literal) {
+            IRValue* expected = lower_expression(g, pattern);
+            ir_builder_branch(b, ir_builder_binary(b, IR_EQ, subject, expected), body_block, next_block);
+        } else {
+            if (pattern && pattern->type == AST_IDENTIFIER &&
+                strcmp(pattern->data.identifier.name, "_") != 0) {
+                declare_local(g, pattern->data.identifier.name, subject);
+            }
+            ir_builder_jump(b, body_block);
+        }
+
+        ir_builder_set_block(b, body_block);
+        if (guard) {
+            IRBasicBlock* guarded = ir_builder_create_block(b, "match.guarded");
+            IRValue* condition = lower_expression(g, guard);
+            if (condition) {
+                ir_builder_branch(b, condition, guarded, next_block);
+            } else {
+                ir_builder_jump(b, guarded);
+            }
+            ir_builder_set_block(b, guarded);
+        }
+        lower_block(g, body);
+        jump_if_open(g, end_block);
+
+        ir_builder_pop_symbols(b, scope);
+        ir_builder_set_block(b, next_block);
+    }
+
+    jump_if_open(g, end_block);
+    ir_builder_set_block(b, end_block);
+}
+
+static void lower_statement(IRGen* g, ast_node_t* node) {
+    if (!node) return;
+    ensure_open_block(g);
+
+    switch (node->type) {
+        case AST_VARIABLE: {
+            IRValue* value = node->data.variable.value
+                ? lower_expression(g, node->data.variable.value)
+                : ir_builder_const_int(g->builder, 0);
+            declare_local(g, node->data.variable.name, value);
+            break;
+        }
+        case AST_EXPRESSION_STMT:
+            for (size_t i = 0; i < node->child_count; i++) {
+                lower_statement(g, node->children[i]);
+            }
+            break;
+        case AST_ASSIGN:
+            lower_assign(g, node);
+            break;
+        case AST_RETURN:
+            ir_builder_return(g->builder, lower_expression(g, node->data.return_stmt.expression));
+            break;
+        case AST_IF:
+            lower_if(g, node);
+            break;
+        case AST_WHILE:
+            lower_while(g, node);
+            break;
+        case AST_FOR:
+            lower_for(g, node);
+            break;
+        case AST_MATCH:
+            lower_match(g, node);
+            break;
+        case AST_BLOCK:
+        case AST_UNSAFE_BLOCK:
+            lower_block(g, node);
+            break;
+        case AST_IMPORT:
+        case AST_FUNCTION:
+            break;
+        default:
+            // Expression evaluated for its side effects
+            lower_expression(g, node);
+            break;
+    }
+}
+
+/*
+ * Open a function with an entry block; parameters arrive in registers
+ * %1..%n and are spilled to slots like any other local
+ */
+static IRFunction* begin_function(IRGen* g, IRModule* module, const char* name, ast_node_t* params) {
+    IRFunction* function = ir_function_create(name);
+    if (!function) return NULL;
+    ir_module_add_function(module, function);
+    ir_function_add_block(function, ir_basic_block_create("entry"));
+
+    g->function = function;
+    g->alloca_tail = NULL;
+    ir_builder_set_function(g->builder, function);
+
+    size_t param_count = params ? params->child_count : 0;
+    for (size_t i = 0; i < param_count; i++) {
+        ir_function_add_parameter(function, ir_value_create_register(function->next_register_id++));
+    }
+    for (size_t i = 0; i < param_count; i++) {
+        ast_node_t* param = params->children[i];
+        if (param && param->type == AST_VARIABLE) {
+            declare_local(g, param->data.variable.name, function->parameters[i]);
+        }
+    }
+    return function;
+}
+
+// Falling off the end returns nothing (0 from main)
+static void end_function(IRGen* g) {
+    if (ir_basic_block_is_terminated(g->builder->current_block)) return;
+
+    IRValue* value = NULL;
+    if (strcmp(g->function->name, "main") == 0) {
+        value = ir_builder_const_int(g->builder, 0);
+    }
+    ir_builder_return(g->builder, value);
+}
+
+IRModule* irgen_module(ast_node_t* root, const char* module_name) {
+    IRModule* module = ir_module_create(module_name);
+    if (!module) return NULL;
+
+    IRGen g = { ir_builder_create(module), NULL, NULL };
+    if (!g.builder) {
+        ir_module_destroy(module);
+        return NULL;
+    }
+    if (!root) {
+        ir_builder_destroy(g.builder);
+        return module;
+    }
+
+    for (size_t i = 0; i < root->child_count; i++) {
+        ast_node_t* node = root->children[i];
+        if (!node || node->type != AST_FUNCTION || !node->data.function.name) continue;
+
+        IRFunction* function = begin_function(&g, module, node->data.function.name,
+                                              node->data.function.parameters);
+        if (function) function->always_inline = node->data.function.is_inline;
+        lower_block(&g, node->data.function.body);
+        end_function(&g);
+    }
+
+    // Remaining top-level statements run from __init
+    bool has_init = false;
+    for (size_t i = 0; i < root->child_count; i++) {
+        ast_node_t* node = root->children[i];
+        if (!node || node->type == AST_FUNCTION || node->type == AST_IMPORT) continue;
+
+        if (!has_init) {
+            begin_function(&g, module, "__init", NULL);
+            has_init = true;
+        }
+        lower_statement(&g, node);
+    }
+    if (has_init) end_function(&g);
+
+    ir_builder_destroy(g.builder);
+    return module;
+}
@@ -0,0 +1,16 @@
+/*
+ * GPLANG IR Generator Header
+ * Lowers a checked AST into an IRModule
+ */
+
+#ifndef IRGEN_H
+#define IRGEN_H
+
+#include "parser.h"
+#include "../ir/ir.h"
+
+// Lower a program; top-level statements outside functions go into an
+// "__init" function. Returns NULL only on allocation failure.
+IRModule* irgen_module(ast_node_t* root, const char* module_name);
+
+#endif // IRGEN_H
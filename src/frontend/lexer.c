@@ -1,30 +1,5 @@
 #include "lexer.h"
 
-// Keywords mapping
-typedef struct {
-    const char* keyword;
-    TokenType type;
-} KeywordMapping;
-
-static KeywordMapping keywords[] = {
-    {"func", TOKEN_FUNC}, {"fun", TOKEN_FUN}, {"fu", TOKEN_FU},
-    {"var", TOKEN_VAR}, {"if", TOKEN_IF}, {"elif", TOKEN_ELIF}, {"else", TOKEN_ELSE},
-    {"while", TOKEN_WHILE}, {"for", TOKEN_FOR}, {"in", TOKEN_IN}, {"return", TOKEN_RETURN},
-    {"and", TOKEN_AND}, {"or", TOKEN_OR}, {"not", TOKEN_NOT},
-    {"true", TOKEN_TRUE}, {"false", TOKEN_FALSE}, {"import", TOKEN_IMPORT},
-    {"unsafe", TOKEN_UNSAFE}, {"async", TOKEN_ASYNC}, {"await", TOKEN_AWAIT}, {"spawn", TOKEN_SPAWN},
-    {"match", TOKEN_MATCH}, {"Some", TOKEN_SOME}, {"None", TOKEN_NONE},
-    {"Ok", TOKEN_OK}, {"Err", TOKEN_ERR}, {"Option", TOKEN_OPTION}, {"Result", TOKEN_RESULT},
-    {"test", TOKEN_TEST}, {"bench", TOKEN_BENCH},
-    {"int", TOKEN_INT}, {"float", TOKEN_FLOAT}, {"str", TOKEN_STR}, {"string", TOKEN_STRING_TYPE},
-    {"bool", TOKEN_BOOL}, {"list", TOKEN_LIST}, {"dict", TOKEN_DICT}, {"set", TOKEN_SET}, {"tuple", TOKEN_TUPLE},
-    {"Future", TOKEN_FUTURE}, {"Channel", TOKEN_CHANNEL}, {"Task", TOKEN_TASK},
-    {"Vec2", TOKEN_VEC2}, {"Vec3", TOKEN_VEC3}, {"Vec4", TOKEN_VEC4}, {"Matrix4", TOKEN_MATRIX4},
-    {"Color", TOKEN_COLOR}, {"Time", TOKEN_TIME}, {"Ref", TOKEN_REF}, {"Mut", TOKEN_MUT},
-    {"os", TOKEN_OS}, {"sys", TOKEN_SYS}, {"env", TOKEN_ENV}, {"process", TOKEN_PROCESS}, {"std", TOKEN_STD},
-    {NULL, 0}
-};
-
 // Create lexer
 Lexer* lexer_create(const char* source) {
     Lexer* lexer = malloc(sizeof(Lexer));
@@ -57,27 +32,40 @@ void lexer_destroy(Lexer* lexer) {
     }
 }
 
-// Create token
-static Token* token_create(TokenType type, const char* value, int line, int column) {
-    Token* token = malloc(sizeof(Token));
-    if (!token) return NULL;
-    
+// Fill a span token: value points into the source and is not NUL-terminated
+static void token_span(Lexer* lexer, Token* token, TokenType type,
+                       int offset, int length, int line, int column) {
     token->type = type;
+    token->value = length > 0 ? (char*)lexer->source + offset : NULL;
+    token->offset = offset;
+    token->length = length;
     token->line = line;
     token->column = column;
+}
+
+// Create heap token owning a NUL-terminated copy of a span token's text
+static Token* token_create_from_span(const Token* span) {
+    Token* token = malloc(sizeof(Token));
+    if (!token) return NULL;
     
-    if (value) {
-        token->length = strlen(value);
-        token->value = malloc(token->length + 1);
-        strcpy(token->value, value);
-    } else {
-        token->value = NULL;
-        token->length = 0;
-    }
+    *token = *span;
+    token->value = token_copy_value(span);
     
     return token;
 }
 
+// Copy a token's text into a new NUL-terminated string
+char* token_copy_value(const Token* token) {
+    if (!token || !token->value) return NULL;
+    
+    char* text = malloc(token->length + 1);
+    if (!text) return NULL;
+    
+    memcpy(text, token->value, token->length);
+    text[token->length] = '\0';
+    return text;
+}
+
 // Destroy token
 void token_destroy(Token* token) {
     if (token) {
@@ -114,24 +102,100 @@ static void skip_whitespace(Lexer* lexer) {
     }
 }
 
+// Classify a lexeme as a keyword without copying it.
+// Dispatches on length and first character, then confirms with a single
+// memcmp, so each identifier costs O(1) regardless of keyword count.
+#define KEYWORD(word, token) \
+    if (memcmp(text, word, sizeof(word) - 1) == 0) return token
+
+TokenType lexer_classify_keyword(const char* text, int length) {
+    switch (length) {
+        case 2:
+            switch (text[0]) {
+                case 'f': KEYWORD("fu", TOKEN_FU); break;
+                case 'i': KEYWORD("if", TOKEN_IF); KEYWORD("in", TOKEN_IN); break;
+                case 'o': KEYWORD("or", TOKEN_OR); KEYWORD("os", TOKEN_OS); break;
+                case 'O': KEYWORD("Ok", TOKEN_OK); break;
+            }
+            break;
+        case 3:
+            switch (text[0]) {
+                case 'a': KEYWORD("and", TOKEN_AND); break;
+                case 'e': KEYWORD("env", TOKEN_ENV); break;
+                case 'f': KEYWORD("fun", TOKEN_FUN); KEYWORD("for", TOKEN_FOR); break;
+                case 'i': KEYWORD("int", TOKEN_INT); break;
+                case 'n': KEYWORD("not", TOKEN_NOT); break;
+                case 's':
+                    KEYWORD("str", TOKEN_STR); KEYWORD("set", TOKEN_SET);
+                    KEYWORD("sys", TOKEN_SYS); KEYWORD("std", TOKEN_STD);
+                    break;
+                case 'v': KEYWORD("var", TOKEN_VAR); break;
+                case 'E': KEYWORD("Err", TOKEN_ERR); break;
+                case 'M': KEYWORD("Mut", TOKEN_MUT); break;
+                case 'R': KEYWORD("Ref", TOKEN_REF); break;
+            }
+            break;
+        case 4:
+            switch (text[0]) {
+                case 'b': KEYWORD("bool", TOKEN_BOOL); break;
+                case 'd': KEYWORD("dict", TOKEN_DICT); break;
+                case 'e': KEYWORD("elif", TOKEN_ELIF); KEYWORD("else", TOKEN_ELSE); break;
+                case 'f': KEYWORD("func", TOKEN_FUNC); break;
+                case 'l': KEYWORD("list", TOKEN_LIST); break;
+                case 't': KEYWORD("true", TOKEN_TRUE); KEYWORD("test", TOKEN_TEST); break;
+                case 'N': KEYWORD("None", TOKEN_NONE); break;
+                case 'S': KEYWORD("Some", TOKEN_SOME); break;
+                case 'T': KEYWORD("Task", TOKEN_TASK); KEYWORD("Time", TOKEN_TIME); break;
+                case 'V':
+                    KEYWORD("Vec2", TOKEN_VEC2); KEYWORD("Vec3", TOKEN_VEC3);
+                    KEYWORD("Vec4", TOKEN_VEC4);
+                    break;
+            }
+            break;
+        case 5:
+            switch (text[0]) {
+                case 'a': KEYWORD("async", TOKEN_ASYNC); KEYWORD("await", TOKEN_AWAIT); break;
+                case 'b': KEYWORD("bench", TOKEN_BENCH); break;
+                case 'f': KEYWORD("false", TOKEN_FALSE); KEYWORD("float", TOKEN_FLOAT); break;
+                case 'm': KEYWORD("match", TOKEN_MATCH); break;
+                case 's': KEYWORD("spawn", TOKEN_SPAWN); break;
+                case 't': KEYWORD("tuple", TOKEN_TUPLE); break;
+                case 'w': KEYWORD("while", TOKEN_WHILE); break;
+                case 'C': KEYWORD("Color", TOKEN_COLOR); break;
+            }
+            break;
+        case 6:
+            switch (text[0]) {
+                case 'i': KEYWORD("import", TOKEN_IMPORT); break;
+                case 'r': KEYWORD("return", TOKEN_RETURN); break;
+                case 's': KEYWORD("string", TOKEN_STRING_TYPE); break;
+                case 'u': KEYWORD("unsafe", TOKEN_UNSAFE); break;
+                case 'F': KEYWORD("Future", TOKEN_FUTURE); break;
+                case 'O': KEYWORD("Option", TOKEN_OPTION); break;
+                case 'R': KEYWORD("Result", TOKEN_RESULT); break;
+            }
+            break;
+        case 7:
+            switch (text[0]) {
+                case 'p': KEYWORD("process", TOKEN_PROCESS); break;
+                case 'C': KEYWORD("Channel", TOKEN_CHANNEL); break;
+                case 'M': KEYWORD("Matrix4", TOKEN_MATRIX4); break;
+            }
+            break;
+    }
+    return TOKEN_IDENTIFIER;
+}
+
+#undef KEYWORD
+
 // Check if keyword
 bool is_keyword(const char* text) {
-    for (int i = 0; keywords[i].keyword != NULL; i++) {
-        if (strcmp(text, keywords[i].keyword) == 0) {
-            return true;
-        }
-    }
-    return false;
+    return lexer_classify_keyword(text, strlen(text)) != TOKEN_IDENTIFIER;
 }
 
 // Get keyword type
 TokenType get_keyword_type(const char* text) {
-    for (int i = 0; keywords[i].keyword != NULL; i++) {
-        if (strcmp(text, keywords[i].keyword) == 0) {
-            return keywords[i].type;
-        }
-    }
-    return TOKEN_IDENTIFIER;
+    return lexer_classify_keyword(text, strlen(text));
 }
 
 // Character classification
@@ -140,7 +204,7 @@ bool is_digit(char ch) { return isdigit(ch); }
 bool is_alpha(char ch) { return isalpha(ch); }
 
 // Read identifier or keyword
-static Token* read_identifier(Lexer* lexer) {
+static void read_identifier(Lexer* lexer, Token* token) {
     int start_line = lexer->line;
     int start_column = lexer->column;
     int start_pos = lexer->position;
@@ -150,19 +214,12 @@ static Token* read_identifier(Lexer* lexer) {
     }
     
     int length = lexer->position - start_pos;
-    char* text = malloc(length + 1);
-    strncpy(text, lexer->source + start_pos, length);
-    text[length] = '\0';
-    
-    TokenType type = is_keyword(text) ? get_keyword_type(text) : TOKEN_IDENTIFIER;
-    Token* token = token_create(type, text, start_line, start_column);
-    
-    free(text);
-    return token;
+    TokenType type = lexer_classify_keyword(lexer->source + start_pos, length);
+    token_span(lexer, token, type, start_pos, length, start_line, start_column);
 }
 
 // Read number
-static Token* read_number(Lexer* lexer) {
+static void read_number(Lexer* lexer, Token* token) {
     int start_line = lexer->line;
     int start_column = lexer->column;
     int start_pos = lexer->position;
@@ -184,18 +241,12 @@ static Token* read_number(Lexer* lexer) {
         advance(lexer);
     }
     
-    int length = lexer->position - start_pos;
-    char* text = malloc(length + 1);
-    strncpy(text, lexer->source + start_pos, length);
-    text[length] = '\0';
-    
-    Token* token = token_create(TOKEN_NUMBER, text, start_line, start_column);
-    free(text);
-    return token;
+    token_span(lexer, token, TOKEN_NUMBER, start_pos, lexer->position - start_pos,
+               start_line, start_column);
 }
 
 // Read string
-static Token* read_string(Lexer* lexer) {
+static void read_string(Lexer* lexer, Token* token) {
     int start_line = lexer->line;
     int start_column = lexer->column;
     
@@ -211,124 +262,166 @@ static Token* read_string(Lexer* lexer) {
     
     if (current_char(lexer) == '"') {
         int length = lexer->position - start_pos;
-        char* text = malloc(length + 1);
-        strncpy(text, lexer->source + start_pos, length);
-        text[length] = '\0';
-        
         advance(lexer); // Skip closing quote
-        
-        Token* token = token_create(TOKEN_STRING, text, start_line, start_column);
-        free(text);
-        return token;
+        token_span(lexer, token, TOKEN_STRING, start_pos, length, start_line, start_column);
     } else {
         lexer_error(lexer, "Unterminated string literal");
-        return token_create(TOKEN_ERROR, NULL, start_line, start_column);
+        token_span(lexer, token, TOKEN_ERROR, start_pos, 0, start_line, start_column);
     }
 }
 
-// Main tokenization function
-Token* lexer_next_token(Lexer* lexer) {
+// Scan the next token as a span into the source (no allocation)
+static void scan_token(Lexer* lexer, Token* token) {
     skip_whitespace(lexer);
     
-    if (lexer->position >= lexer->source_length) {
-        return token_create(TOKEN_EOF, NULL, lexer->line, lexer->column);
-    }
-    
-    char ch = current_char(lexer);
+    int start = lexer->position;
     int line = lexer->line;
     int column = lexer->column;
     
-    // Single character tokens
-    switch (ch) {
-        case '\n': advance(lexer); return token_create(TOKEN_NEWLINE, "\n", line, column);
-        case '+': advance(lexer); return token_create(TOKEN_PLUS, "+", line, column);
-        case '-': advance(lexer); return token_create(TOKEN_MINUS, "-", line, column);
-        case '*': advance(lexer); return token_create(TOKEN_MULTIPLY, "*", line, column);
-        case '/': advance(lexer); return token_create(TOKEN_DIVIDE, "/", line, column);
-        case '%': advance(lexer); return token_create(TOKEN_MODULO, "%", line, column);
-        case '(': advance(lexer); return token_create(TOKEN_LEFT_PAREN, "(", line, column);
-        case ')': advance(lexer); return token_create(TOKEN_RIGHT_PAREN, ")", line, column);
-        case '[': advance(lexer); return token_create(TOKEN_LEFT_BRACKET, "[", line, column);
-        case ']': advance(lexer); return token_create(TOKEN_RIGHT_BRACKET, "]", line, column);
-        case '{': advance(lexer); return token_create(TOKEN_LEFT_BRACE, "{", line, column);
-        case '}': advance(lexer); return token_create(TOKEN_RIGHT_BRACE, "}", line, column);
-        case ',': advance(lexer); return token_create(TOKEN_COMMA, ",", line, column);
-        case '.': advance(lexer); return token_create(TOKEN_DOT, ".", line, column);
-        case ':': advance(lexer); return token_create(TOKEN_COLON, ":", line, column);
-        case ';': advance(lexer); return token_create(TOKEN_SEMICOLON, ";", line, column);
+    if (lexer->position >= lexer->source_length) {
+        token_span(lexer, token, TOKEN_EOF, start, 0, line, column);
+        return;
     }
     
-    // Multi-character tokens
-    if (ch == '=') {
+    char ch = current_char(lexer);
+    TokenType type;
+
+    // Return type arrow
+    if (ch == '-' && lexer->position + 1 < lexer->source_length &&
+        lexer->source[lexer->position + 1] == '>') {
         advance(lexer);
-        if (current_char(lexer) == '=') {
-            advance(lexer);
-            return token_create(TOKEN_EQ, "==", line, column);
-        }
-        return token_create(TOKEN_ASSIGN, "=", line, column);
-    }
-    
-    if (ch == '!') {
         advance(lexer);
-        if (current_char(lexer) == '=') {
-            advance(lexer);
-            return token_create(TOKEN_NE, "!=", line, column);
-        }
-        return token_create(TOKEN_NOT, "!", line, column);
+        token_span(lexer, token, TOKEN_ARROW, start, 2, line, column);
+        return;
+    }
+
+    // Single character tokens
+    switch (ch) {
+        case '\n': type = TOKEN_NEWLINE; break;
+        case '+': type = TOKEN_PLUS; break;
+        case '-': type = TOKEN_MINUS; break;
+        case '*': type = TOKEN_MULTIPLY; break;
+        case '/': type = TOKEN_DIVIDE; break;
+        case '%': type = TOKEN_MODULO; break;
+        case '(': type = TOKEN_LEFT_PAREN; break;
+        case ')': type = TOKEN_RIGHT_PAREN; break;
+        case '[': type = TOKEN_LEFT_BRACKET; break;
+        case ']': type = TOKEN_RIGHT_BRACKET; break;
+        case '{': type = TOKEN_LEFT_BRACE; break;
+        case '}': type = TOKEN_RIGHT_BRACE; break;
+        case ',': type = TOKEN_COMMA; break;
+        case '.': type = TOKEN_DOT; break;
+        case ':': type = TOKEN_COLON; break;
+        case ';': type = TOKEN_SEMICOLON; break;
+        default: type = TOKEN_ERROR; break;
     }
     
-    if (ch == '<') {
+    if (type != TOKEN_ERROR) {
         advance(lexer);
-        if (current_char(lexer) == '=') {
-            advance(lexer);
-            return token_create(TOKEN_LE, "<=", line, column);
-        }
-        return token_create(TOKEN_LT, "<", line, column);
+        token_span(lexer, token, type, start, 1, line, column);
+        return;
     }
     
-    if (ch == '>') {
+    // Multi-character tokens
+    if (ch == '=' || ch == '!' || ch == '<' || ch == '>') {
         advance(lexer);
-        if (current_char(lexer) == '=') {
-            advance(lexer);
-            return token_create(TOKEN_GE, ">=", line, column);
+        bool has_equals = current_char(lexer) == '=';
+        if (has_equals) advance(lexer);
+        
+        switch (ch) {
+            case '=': type = has_equals ? TOKEN_EQ : TOKEN_ASSIGN; break;
+            case '!': type = has_equals ? TOKEN_NE : TOKEN_NOT; break;
+            case '<': type = has_equals ? TOKEN_LE : TOKEN_LT; break;
+            default:  type = has_equals ? TOKEN_GE : TOKEN_GT; break;
         }
-        return token_create(TOKEN_GT, ">", line, column);
+        token_span(lexer, token, type, start, lexer->position - start, line, column);
+        return;
     }
     
     // Comments
     if (ch == '#') {
-        int start_pos = lexer->position;
         while (current_char(lexer) && current_char(lexer) != '\n') {
             advance(lexer);
         }
-        int length = lexer->position - start_pos;
-        char* text = malloc(length + 1);
-        strncpy(text, lexer->source + start_pos, length);
-        text[length] = '\0';
-        
-        Token* token = token_create(TOKEN_COMMENT, text, line, column);
-        free(text);
-        return token;
+        token_span(lexer, token, TOKEN_COMMENT, start, lexer->position - start, line, column);
+        return;
     }
     
     // Strings
     if (ch == '"') {
-        return read_string(lexer);
+        read_string(lexer, token);
+        return;
     }
     
     // Numbers
     if (is_digit(ch)) {
-        return read_number(lexer);
+        read_number(lexer, token);
+        return;
     }
     
     // Identifiers and keywords
     if (is_alpha(ch) || ch == '_') {
-        return read_identifier(lexer);
+        read_identifier(lexer, token);
+        return;
     }
     
     // Unknown character
     advance(lexer);
-    return token_create(TOKEN_ERROR, NULL, line, column);
+    token_span(lexer, token, TOKEN_ERROR, start, 0, line, column);
+}
+
+// Main tokenization function
+Token* lexer_next_token(Lexer* lexer) {
+    Token span;
+    scan_token(lexer, &span);
+    return token_create_from_span(&span);
+}
+
+// Initialize token buffer
+void token_buffer_init(TokenBuffer* buffer) {
+    buffer->tokens = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+}
+
+// Free token buffer (span tokens own no memory of their own)
+void token_buffer_free(TokenBuffer* buffer) {
+    if (!buffer) return;
+    free(buffer->tokens);
+    token_buffer_init(buffer);
+}
+
+// Tokenize the whole source into a contiguous array of span tokens.
+// The array is sized from the source length up front, so a typical file
+// costs a single allocation; token values point into Lexer.source.
+size_t lexer_tokenize_all(Lexer* lexer, TokenBuffer* buffer) {
+    if (!lexer || !buffer) return 0;
+    
+    size_t estimate = (size_t)lexer->source_length / 4 + 16;
+    if (buffer->capacity - buffer->count < estimate) {
+        size_t capacity = buffer->count + estimate;
+        Token* tokens = realloc(buffer->tokens, capacity * sizeof(Token));
+        if (!tokens) return 0;
+        buffer->tokens = tokens;
+        buffer->capacity = capacity;
+    }
+    
+    size_t first = buffer->count;
+    for (;;) {
+        if (buffer->count == buffer->capacity) {
+            size_t capacity = buffer->capacity * 2;
+            Token* tokens = realloc(buffer->tokens, capacity * sizeof(Token));
+            if (!tokens) return buffer->count - first;
+            buffer->tokens = tokens;
+            buffer->capacity = capacity;
+        }
+        
+        Token* token = &buffer->tokens[buffer->count++];
+        scan_token(lexer, token);
+        if (token->type == TOKEN_EOF) break;
+    }
+    
+    return buffer->count - first;
 }
 
 // Convert token type to string
@@ -70,14 +70,25 @@ typedef enum {
 } TokenType;
 
 // Token structure
+// Tokens from lexer_next_token own a NUL-terminated copy in value.
+// Tokens from lexer_tokenize_all are spans: value points into Lexer.source
+// and is NOT NUL-terminated, so always use length (or token_copy_value).
 typedef struct {
     TokenType type;
     char* value;
     int line;
     int column;
     int length;
+    int offset;     // Byte offset of the lexeme in Lexer.source
 } Token;
 
+// Contiguous array of span tokens filled by lexer_tokenize_all
+typedef struct {
+    Token* tokens;
+    size_t count;
+    size_t capacity;
+} TokenBuffer;
+
 // Lexer structure
 typedef struct {
     const char* source;
@@ -101,12 +112,19 @@ Lexer* lexer_create(const char* source);
 void lexer_destroy(Lexer* lexer);
 Token* lexer_next_token(Lexer* lexer);
 void token_destroy(Token* token);
+char* token_copy_value(const Token* token);
+
+// Batch tokenization
+void token_buffer_init(TokenBuffer* buffer);
+void token_buffer_free(TokenBuffer* buffer);
+size_t lexer_tokenize_all(Lexer* lexer, TokenBuffer* buffer);
 const char* token_type_to_string(TokenType type);
 void lexer_error(Lexer* lexer, const char* message);
 
 // Utility functions
 bool is_keyword(const char* text);
 TokenType get_keyword_type(const char* text);
+TokenType lexer_classify_keyword(const char* text, int length);
 bool is_identifier_char(char ch);
 bool is_digit(char ch);
 bool is_alpha(char ch);
@@ -10,432 +10,799 @@
 #include "parser.h"
 #include "lexer.h"
 
-// Parser state
-typedef struct {
+#define MAX_PARSE_ERRORS 100
+
+// Parser state (one per compilation unit / thread)
+struct Parser {
     Token* tokens;
     size_t token_count;
     size_t current;
     ast_node_t* root;
+    ast_arena_t* arena;     // Owns every node and name of the current unit
     error_list_t errors;
-} parser_t;
+    bool panic;             // Suppress cascading errors until the next statement
+    bool verbose;
+    Token eof;              // Returned by peek() when the token array is empty
+};
 
-static parser_t g_parser = {0};
+// Default instance behind the legacy parser_init/parse/parser_cleanup API
+static Parser* g_default_parser = NULL;
 
 // Forward declarations
-static ast_node_t* parse_expression(void);
-static ast_node_t* parse_statement(void);
-static ast_node_t* parse_function(void);
-static ast_node_t* parse_block(void);
-static ast_node_t* parse_if_statement(void);
-static ast_node_t* parse_for_statement(void);
-static ast_node_t* parse_while_statement(void);
-static ast_node_t* parse_match_statement(void);
-static ast_node_t* parse_primary(void);
-static ast_node_t* parse_binary(ast_node_t* left, int min_precedence);
-static void add_error(const char* message);
-static void print_parse_errors(void);
-static Token* peek(void);
-static Token* advance(void);
-static int is_at_end(void);
-static int check(TokenType type);
-static int match(TokenType type);
-static Token* consume(TokenType type, const char* message);
+static ast_node_t* parse_expression(Parser* p);
+static ast_node_t* parse_statement(Parser* p);
+static ast_node_t* parse_function(Parser* p);
+static ast_node_t* parse_block(Parser* p, int owner_column);
+static void parse_statement_list(Parser* p, ast_node_t* parent, bool top_level);
+static ast_node_t* parse_if_statement(Parser* p);
+static ast_node_t* parse_for_statement(Parser* p);
+static ast_node_t* parse_while_statement(Parser* p);
+static ast_node_t* parse_match_statement(Parser* p);
+static ast_node_t* parse_unary(Parser* p);
+static ast_node_t* parse_postfix(Parser* p, ast_node_t* node);
+static ast_node_t* parse_primary(Parser* p);
+static ast_node_t* parse_binary(Parser* p, ast_node_t* left, int min_precedence);
+static void add_error(Parser* p, const char* message);
+static void print_parse_errors(Parser* p);
+static void synchronize(Parser* p);
+static void skip_newlines(Parser* p);
+static int at_line_end(Parser* p);
+static Token* peek(Parser* p);
+static Token* peek_at(Parser* p, size_t offset);
+static Token* previous(Parser* p);
+static Token* advance(Parser* p);
+static int is_at_end(Parser* p);
+static int check(Parser* p, TokenType type);
+static int check_word(Parser* p, const char* word);
+static int match(Parser* p, TokenType type);
+static Token* consume(Parser* p, TokenType type, const char* message);
+static Token* consume_name(Parser* p, const char* message);
+static int is_name_token(TokenType type);
 static int get_operator_precedence(TokenType type);
 static int is_right_associative(TokenType type);
+static ast_node_t* new_node(Parser* p, ast_node_type_t type);
+static char* intern_token(Parser* p, Token* token);
+static char* intern_tokens(Parser* p, Token* first, Token* last);
+
+/*
+ * Create parser
+ */
+Parser* parser_create(void) {
+    Parser* p = calloc(1, sizeof(Parser));
+    if (!p) return NULL;
+
+    p->errors.capacity = MAX_PARSE_ERRORS;
+    p->errors.errors = calloc(p->errors.capacity, sizeof(parse_error_t));
+    if (!p->errors.errors) {
+        free(p);
+        return NULL;
+    }
+
+    p->eof.type = TOKEN_EOF;
+    return p;
+}
+
+/*
+ * Release the parser's errors and arena (invalidates the last AST)
+ */
+static void parser_reset(Parser* p) {
+    for (size_t i = 0; i < p->errors.count; i++) {
+        free((void*)p->errors.errors[i].message);
+    }
+    p->errors.count = 0;
+    p->panic = false;
+
+    // The whole AST lives in the arena: one call releases it
+    ast_arena_destroy(p->arena);
+    p->arena = NULL;
+    p->root = NULL;
+}
+
+/*
+ * Destroy parser together with the AST it produced
+ */
+void parser_destroy(Parser* parser) {
+    if (!parser) return;
+
+    parser_reset(parser);
+    free(parser->errors.errors);
+    free(parser);
+}
+
+void parser_set_verbose(Parser* parser, bool verbose) {
+    if (parser) parser->verbose = verbose;
+}
+
+ast_arena_t* parser_arena(const Parser* parser) {
+    return parser ? parser->arena : NULL;
+}
+
+size_t parser_error_count(const Parser* parser) {
+    return parser ? parser->errors.count : 0;
+}
+
+const parse_error_t* parser_error(const Parser* parser, size_t index) {
+    if (!parser || index >= parser->errors.count) return NULL;
+    return &parser->errors.errors[index];
+}
 
 /*
- * Initialize parser
+ * Parse tokens into AST
+ * The returned tree stays valid until the next parser_parse or
+ * parser_destroy on the same parser.
+ */
+ast_node_t* parser_parse(Parser* p, Token* tokens, size_t token_count) {
+    if (!p) return NULL;
+
+    if (p->verbose) {
+        printf("🔧 Parsing %zu tokens into AST...\n", token_count);
+    }
+
+    parser_reset(p);
+    p->tokens = tokens;
+    p->token_count = token_count;
+    p->current = 0;
+
+    // One arena per compilation unit
+    p->arena = ast_arena_create();
+    if (!p->arena) {
+        if (p->verbose) printf("❌ Failed to create AST arena\n");
+        return NULL;
+    }
+
+    // Create root program node
+    p->root = new_node(p, AST_PROGRAM);
+    if (!p->root) {
+        if (p->verbose) printf("❌ Failed to create root AST node\n");
+        return NULL;
+    }
+
+    // Parse top-level declarations
+    parse_statement_list(p, p->root, true);
+
+    if (p->errors.count > 0) {
+        if (p->verbose) {
+            printf("❌ Parser found %zu errors\n", p->errors.count);
+            print_parse_errors(p);
+        }
+        return NULL;
+    }
+
+    if (p->verbose) {
+        printf("✅ Parsing completed successfully\n");
+        printf("   • AST nodes created: %zu\n", count_ast_nodes(p->root));
+        printf("   • AST arena: %zu KB\n", ast_arena_bytes_allocated(p->arena) / 1024);
+    }
+
+    return p->root;
+}
+
+/*
+ * Legacy interface
  */
 int parser_init(void) {
     printf("🔧 Initializing GPLANG Parser...\n");
-    
-    memset(&g_parser, 0, sizeof(parser_t));
-    g_parser.errors.capacity = 100;
-    g_parser.errors.errors = calloc(g_parser.errors.capacity, sizeof(parse_error_t));
-    
-    if (!g_parser.errors.errors) {
+
+    parser_destroy(g_default_parser);
+    g_default_parser = parser_create();
+    if (!g_default_parser) {
         printf("❌ Failed to initialize parser error list\n");
         return -1;
     }
-    
+    g_default_parser->verbose = true;
+
     printf("✅ Parser initialized\n");
     return 0;
 }
 
-/*
- * Parse tokens into AST
- */
 ast_node_t* parse(Token* tokens, size_t token_count) {
-    printf("🔧 Parsing %zu tokens into AST...\n", token_count);
-    
-    g_parser.tokens = tokens;
-    g_parser.token_count = token_count;
-    g_parser.current = 0;
-    g_parser.errors.count = 0;
-    
-    // Create root program node
-    g_parser.root = create_ast_node(AST_PROGRAM);
-    if (!g_parser.root) {
-        printf("❌ Failed to create root AST node\n");
+    if (!g_default_parser && parser_init() != 0) {
         return NULL;
     }
-    
-    // Parse top-level declarations
-    while (!is_at_end()) {
-        ast_node_t* stmt = parse_statement();
+    return parser_parse(g_default_parser, tokens, token_count);
+}
+
+void parser_cleanup(void) {
+    parser_destroy(g_default_parser);
+    g_default_parser = NULL;
+
+    printf("🧹 Parser cleaned up\n");
+}
+
+/*
+ * Parse a run of statements aligned on one indentation column.
+ * Blocks are delimited by token columns: the first statement fixes the
+ * block's column and the block ends at the first less-indented line.
+ */
+static void parse_statement_list(Parser* p, ast_node_t* parent, bool top_level) {
+    skip_newlines(p);
+    int column = peek(p)->column;
+    bool skip_deeper = false;
+
+    while (true) {
+        skip_newlines(p);
+        if (is_at_end(p)) break;
+
+        Token* token = peek(p);
+        if (!top_level && token->column < column) break;
+
+        // Lines indented past the block belong to a statement that failed
+        // to parse; report them once and skip
+        if (token->column > column) {
+            if (!skip_deeper) {
+                add_error(p, "Unexpected indentation");
+                skip_deeper = true;
+            }
+            synchronize(p);
+            p->panic = false;
+            continue;
+        }
+
+        size_t start = p->current;
+        size_t errors_before = p->errors.count;
+
+        ast_node_t* stmt = parse_statement(p);
         if (stmt) {
-            add_child(g_parser.root, stmt);
+            add_child(parent, stmt);
         }
+
+        // Simple statements must end their line; recover at the next one
+        if (!p->panic && !at_line_end(p) && peek(p)->line == previous(p)->line) {
+            add_error(p, "Expected end of line after statement");
+        }
+        if (p->panic || p->current == start) {
+            synchronize(p);
+        }
+        p->panic = false;
+        skip_deeper = p->errors.count > errors_before;
     }
-    
-    if (g_parser.errors.count > 0) {
-        printf("❌ Parser found %zu errors\n", g_parser.errors.count);
-        print_parse_errors();
-        return NULL;
-    }
-    
-    printf("✅ Parsing completed successfully\n");
-    printf("   • AST nodes created: %zu\n", count_ast_nodes(g_parser.root));
-    
-    return g_parser.root;
 }
 
 /*
  * Parse statement
  */
-static ast_node_t* parse_statement(void) {
-    Token* current_token = peek();
-    
+static ast_node_t* parse_statement(Parser* p) {
+    Token* current_token = peek(p);
+
     switch (current_token->type) {
         case TOKEN_FUNC:
-            return parse_function();
+        case TOKEN_ASYNC:
+            return parse_function(p);
         case TOKEN_IF:
-            return parse_if_statement();
+            return parse_if_statement(p);
         case TOKEN_FOR:
         case TOKEN_PARALLEL:
-            return parse_for_statement();
+            return parse_for_statement(p);
         case TOKEN_WHILE:
-            return parse_while_statement();
+            return parse_while_statement(p);
         case TOKEN_MATCH:
-            return parse_match_statement();
+            return parse_match_statement(p);
         case TOKEN_RETURN:
-            return parse_return_statement();
+            return parse_return_statement(p);
         case TOKEN_VAR:
         case TOKEN_CONST:
-            return parse_variable_declaration();
+            return parse_variable_declaration(p);
         case TOKEN_IMPORT:
-            return parse_import_statement();
-        case TOKEN_LBRACE:
-            return parse_block();
+            return parse_import_statement(p);
         default:
-            return parse_expression_statement();
+            // 'parallel' is not reserved; it is only a keyword before 'for'
+            if (check_word(p, "parallel") && peek_at(p, 1)->type == TOKEN_FOR) {
+                return parse_for_statement(p);
+            }
+            // Likewise 'inline' before 'func'
+            if (check_word(p, "inline") && peek_at(p, 1)->type == TOKEN_FUNC) {
+                return parse_function(p);
+            }
+            return parse_expression_statement(p);
     }
 }
 
 /*
  * Parse function declaration
  */
-static ast_node_t* parse_function(void) {
-    ast_node_t* func_node = create_ast_node(AST_FUNCTION);
-    
+static ast_node_t* parse_function(Parser* p) {
+    ast_node_t* func_node = new_node(p, AST_FUNCTION);
+    int column = peek(p)->column;
+
+    if (check_word(p, "inline")) {
+        advance(p);
+        func_node->data.function.is_inline = 1;
+    }
+    match(p, TOKEN_ASYNC);
+
     // Consume 'func' keyword
-    consume(TOKEN_FUNC, "Expected 'func'");
-    
-    // Parse function name
-    Token* name_token = consume(TOKEN_IDENTIFIER, "Expected function name");
-    func_node->data.function.name = strdup(name_token->value);
-    
+    consume(p, TOKEN_FUNC, "Expected 'func'");
+
+    // Parse function name (methods are declared as Type.name)
+    Token* name_token = consume_name(p, "Expected function name");
+    Token* last_token = name_token;
+    while (name_token && check(p, TOKEN_DOT)) {
+        advance(p);
+        last_token = consume_name(p, "Expected method name after '.'");
+        if (!last_token) break;
+    }
+    func_node->data.function.name = last_token ? intern_tokens(p, name_token, last_token) : NULL;
+
     // Parse parameters
-    consume(TOKEN_LPAREN, "Expected '(' after function name");
-    
-    func_node->data.function.parameters = parse_parameter_list();
-    
-    consume(TOKEN_RPAREN, "Expected ')' after parameters");
-    
+    consume(p, TOKEN_LPAREN, "Expected '(' after function name");
+
+    func_node->data.function.parameters = parse_parameter_list(p);
+
+    consume(p, TOKEN_RPAREN, "Expected ')' after parameters");
+
     // Parse return type (optional)
-    if (match(TOKEN_ARROW)) {
-        func_node->data.function.return_type = parse_type();
+    if (match(p, TOKEN_ARROW)) {
+        func_node->data.function.return_type = parse_type(p);
     }
-    
+
     // Parse function body
-    consume(TOKEN_COLON, "Expected ':' before function body");
-    func_node->data.function.body = parse_block();
-    
+    consume(p, TOKEN_COLON, "Expected ':' before function body");
+    func_node->data.function.body = parse_block(p, column);
+
     return func_node;
 }
 
 /*
  * Parse if statement
  */
-static ast_node_t* parse_if_statement(void) {
-    ast_node_t* if_node = create_ast_node(AST_IF);
-    
-    consume(TOKEN_IF, "Expected 'if'");
-    
+static ast_node_t* parse_if_statement(Parser* p) {
+    ast_node_t* if_node = new_node(p, AST_IF);
+    int column = peek(p)->column;
+
+    advance(p); // 'if' or 'elif'
+
     // Parse condition
-    if_node->data.if_stmt.condition = parse_expression();
-    
-    consume(TOKEN_COLON, "Expected ':' after if condition");
-    
+    if_node->data.if_stmt.condition = parse_expression(p);
+
+    consume(p, TOKEN_COLON, "Expected ':' after if condition");
+
     // Parse then block
-    if_node->data.if_stmt.then_block = parse_block();
-    
+    if_node->data.if_stmt.then_block = parse_block(p, column);
+    if (p->panic) return if_node;
+
+    // elif/else must line up with their 'if'
+    size_t saved = p->current;
+    skip_newlines(p);
+    if (peek(p)->column != column) {
+        p->current = saved;
+        return if_node;
+    }
+
     // Parse optional else/elif
-    if (match(TOKEN_ELIF)) {
-        if_node->data.if_stmt.else_block = parse_if_statement(); // Recursive for elif
-    } else if (match(TOKEN_ELSE)) {
-        consume(TOKEN_COLON, "Expected ':' after else");
-        if_node->data.if_stmt.else_block = parse_block();
+    if (check(p, TOKEN_ELIF)) {
+        if_node->data.if_stmt.else_block = parse_if_statement(p); // Recursive for elif
+    } else if (match(p, TOKEN_ELSE)) {
+        consume(p, TOKEN_COLON, "Expected ':' after else");
+        if_node->data.if_stmt.else_block = parse_block(p, column);
+    } else {
+        p->current = saved;
     }
-    
+
     return if_node;
 }
 
 /*
  * Parse for statement (including parallel for)
  */
-static ast_node_t* parse_for_statement(void) {
-    ast_node_t* for_node = create_ast_node(AST_FOR);
-    
+static ast_node_t* parse_for_statement(Parser* p) {
+    ast_node_t* for_node = new_node(p, AST_FOR);
+    int column = peek(p)->column;
+
     // Check for parallel keyword
-    if (match(TOKEN_PARALLEL)) {
+    if (match(p, TOKEN_PARALLEL)) {
+        for_node->data.for_stmt.is_parallel = 1;
+    } else if (check_word(p, "parallel")) {
+        advance(p);
         for_node->data.for_stmt.is_parallel = 1;
     }
-    
-    consume(TOKEN_FOR, "Expected 'for'");
-    
+
+    consume(p, TOKEN_FOR, "Expected 'for'");
+
     // Parse iterator variable
-    Token* var_token = consume(TOKEN_IDENTIFIER, "Expected variable name");
-    for_node->data.for_stmt.variable = strdup(var_token->value);
-    
-    consume(TOKEN_IN, "Expected 'in' after for variable");
-    
+    Token* var_token = consume_name(p, "Expected variable name");
+    for_node->data.for_stmt.variable = intern_token(p, var_token);
+
+    consume(p, TOKEN_IN, "Expected 'in' after for variable");
+
     // Parse iterable expression
-    for_node->data.for_stmt.iterable = parse_expression();
-    
-    consume(TOKEN_COLON, "Expected ':' after for expression");
-    
+    for_node->data.for_stmt.iterable = parse_expression(p);
+
+    consume(p, TOKEN_COLON, "Expected ':' after for expression");
+
     // Parse body
-    for_node->data.for_stmt.body = parse_block();
-    
+    for_node->data.for_stmt.body = parse_block(p, column);
+
     return for_node;
 }
 
 /*
  * Parse while statement
  */
-static ast_node_t* parse_while_statement(void) {
-    ast_node_t* while_node = create_ast_node(AST_WHILE);
-    
-    consume(TOKEN_WHILE, "Expected 'while'");
-    
+static ast_node_t* parse_while_statement(Parser* p) {
+    ast_node_t* while_node = new_node(p, AST_WHILE);
+    int column = peek(p)->column;
+
+    consume(p, TOKEN_WHILE, "Expected 'while'");
+
     // Parse condition
-    while_node->data.while_stmt.condition = parse_expression();
-    
-    consume(TOKEN_COLON, "Expected ':' after while condition");
-    
+    while_node->data.while_stmt.condition = parse_expression(p);
+
+    consume(p, TOKEN_COLON, "Expected ':' after while condition");
+
     // Parse body
-    while_node->data.while_stmt.body = parse_block();
-    
+    while_node->data.while_stmt.body = parse_block(p, column);
+
     return while_node;
 }
 
 /*
  * Parse match statement
+ * Cases are indented under the match line and become its children.
  */
-static ast_node_t* parse_match_statement(void) {
-    ast_node_t* match_node = create_ast_node(AST_MATCH);
-    
-    consume(TOKEN_MATCH, "Expected 'match'");
-    
+static ast_node_t* parse_match_statement(Parser* p) {
+    ast_node_t* match_node = new_node(p, AST_MATCH);
+    int column = peek(p)->column;
+
+    consume(p, TOKEN_MATCH, "Expected 'match'");
+
     // Parse expression to match
-    match_node->data.match_stmt.expression = parse_expression();
-    
-    consume(TOKEN_COLON, "Expected ':' after match expression");
-    consume(TOKEN_LBRACE, "Expected '{' to start match cases");
-    
+    match_node->data.match_stmt.expression = parse_expression(p);
+
+    consume(p, TOKEN_COLON, "Expected ':' after match expression");
+    if (p->panic) return match_node;
+
+    skip_newlines(p);
+    int case_column = peek(p)->column;
+    if (case_column <= column || !check_word(p, "case")) {
+        add_error(p, "Expected 'case' in match statement");
+        return match_node;
+    }
+
     // Parse match cases
-    while (!check(TOKEN_RBRACE) && !is_at_end()) {
-        ast_node_t* case_node = parse_match_case();
+    while (!is_at_end(p) && !p->panic) {
+        size_t saved = p->current;
+        skip_newlines(p);
+        if (peek(p)->column != case_column || !check_word(p, "case")) {
+            p->current = saved;
+            break;
+        }
+        ast_node_t* case_node = parse_match_case(p);
         add_child(match_node, case_node);
     }
-    
-    consume(TOKEN_RBRACE, "Expected '}' after match cases");
-    
+
+    match_node->data.match_stmt.cases = match_node->children;
+    match_node->data.match_stmt.case_count = match_node->child_count;
+
     return match_node;
 }
 
+/*
+ * Parse indented block after a ':' (or a single statement on the same line)
+ */
+static ast_node_t* parse_block(Parser* p, int owner_column) {
+    ast_node_t* block = new_node(p, AST_BLOCK);
+    if (p->panic) return block;
+
+    // Inline body: "if x: return 1"
+    if (!at_line_end(p)) {
+        add_child(block, parse_statement(p));
+        return block;
+    }
+
+    skip_newlines(p);
+    if (is_at_end(p) || peek(p)->column <= owner_column) {
+        add_error(p, "Expected indented block");
+        return block;
+    }
+
+    parse_statement_list(p, block, false);
+
+    block->data.block.statements = block->children;
+    block->data.block.statement_count = block->child_count;
+    return block;
+}
+
 /*
  * Parse expression with operator precedence
  */
-static ast_node_t* parse_expression(void) {
-    return parse_binary(parse_primary(), 0);
+static ast_node_t* parse_expression(Parser* p) {
+    return parse_binary(p, parse_unary(p), 1);
 }
 
 /*
  * Parse binary expression with precedence climbing
  */
-static ast_node_t* parse_binary(ast_node_t* left, int min_precedence) {
+static ast_node_t* parse_binary(Parser* p, ast_node_t* left, int min_precedence) {
     while (true) {
-        Token* op_token = peek();
+        Token* op_token = peek(p);
         int precedence = get_operator_precedence(op_token->type);
-        
-        if (precedence < min_precedence) {
+
+        // Precedence 0 means "not a binary operator"
+        if (precedence == 0 || precedence < min_precedence) {
+            break;
+        }
+
+        // "x += 1" is an assignment, not an addition
+        if (peek_at(p, 1)->type == TOKEN_ASSIGN) {
             break;
         }
-        
-        advance(); // Consume operator
-        
-        ast_node_t* right = parse_primary();
-        
+
+        advance(p); // Consume operator
+
+        ast_node_t* right = parse_unary(p);
+
         // Handle right-associative operators
-        Token* next_op = peek();
+        Token* next_op = peek(p);
         int next_precedence = get_operator_precedence(next_op->type);
-        
-        if (precedence < next_precedence || 
+
+        if (precedence < next_precedence ||
             (precedence == next_precedence && is_right_associative(op_token->type))) {
-            right = parse_binary(right, precedence + 1);
+            right = parse_binary(p, right, precedence + 1);
         }
-        
+
         // Create binary operation node
-        ast_node_t* binary_node = create_ast_node(AST_BINARY_OP);
+        ast_node_t* binary_node = new_node(p, AST_BINARY_OP);
         binary_node->data.binary_op.operator = op_token->type;
         binary_node->data.binary_op.left = left;
         binary_node->data.binary_op.right = right;
-        
+
         left = binary_node;
     }
-    
+
     return left;
 }
 
+/*
+ * Parse unary expression
+ */
+static ast_node_t* parse_unary(Parser* p) {
+    switch (peek(p)->type) {
+        case TOKEN_MINUS:
+        case TOKEN_NOT:
+        case TOKEN_AWAIT:
+        case TOKEN_SPAWN: {
+            Token* op_token = advance(p);
+            ast_node_t* node = new_node(p, AST_UNARY_OP);
+            node->data.unary_op.operator = op_token->type;
+            node->data.unary_op.operand = parse_unary(p);
+            return node;
+        }
+        default:
+            return parse_postfix(p, parse_primary(p));
+    }
+}
+
+/*
+ * Parse calls, member access and indexing following a primary expression
+ */
+static ast_node_t* parse_postfix(Parser* p, ast_node_t* node) {
+    while (node && !p->panic) {
+        if (match(p, TOKEN_LPAREN)) {
+            ast_node_t* call = new_node(p, AST_CALL);
+            call->data.call.callee = node;
+
+            skip_newlines(p);
+            while (!check(p, TOKEN_RPAREN) && !is_at_end(p) && !p->panic) {
+                add_child(call, parse_expression(p));
+                skip_newlines(p);
+                if (!match(p, TOKEN_COMMA)) break;
+                skip_newlines(p);
+            }
+            consume(p, TOKEN_RPAREN, "Expected ')' after arguments");
+            node = call;
+        } else if (match(p, TOKEN_DOT)) {
+            ast_node_t* member = new_node(p, AST_MEMBER);
+            member->data.member.object = node;
+            member->data.member.name = intern_token(p, consume_name(p, "Expected member name after '.'"));
+            node = member;
+        } else if (match(p, TOKEN_LBRACKET)) {
+            ast_node_t* index = new_node(p, AST_INDEX);
+            index->data.index.object = node;
+            index->data.index.index = parse_expression(p);
+            consume(p, TOKEN_RBRACKET, "Expected ']' after index");
+            node = index;
+        } else if (check(p, TOKEN_LBRACE) && node->type == AST_IDENTIFIER &&
+                   peek(p)->line == previous(p)->line) {
+            // Struct literal: Name { field: value, ... }
+            ast_node_t* object = parse_object_literal(p);
+            object->data.identifier.name = node->data.identifier.name;
+            node = object;
+        } else {
+            break;
+        }
+    }
+    return node;
+}
+
 /*
  * Parse primary expression
  */
-static ast_node_t* parse_primary(void) {
-    Token* token = peek();
-    
+static ast_node_t* parse_primary(Parser* p) {
+    Token* token = peek(p);
+    ast_node_t* node;
+
     switch (token->type) {
+        // Token values may be spans into the source; intern them by length
         case TOKEN_NUMBER:
-            advance();
-            return create_number_node(token->value);
-            
+            advance(p);
+            node = new_node(p, AST_NUMBER);
+            node->data.literal.value = intern_token(p, token);
+            return node;
+
         case TOKEN_STRING:
-            advance();
-            return create_string_node(token->value);
-            
-        case TOKEN_IDENTIFIER:
-            advance();
-            return create_identifier_node(token->value);
-            
+            advance(p);
+            node = new_node(p, AST_STRING);
+            node->data.literal.value = intern_token(p, token);
+            return node;
+
         case TOKEN_TRUE:
         case TOKEN_FALSE:
-            advance();
-            return create_boolean_node(token->type == TOKEN_TRUE);
-            
-        case TOKEN_LPAREN:
-            advance();
-            ast_node_t* expr = parse_expression();
-            consume(TOKEN_RPAREN, "Expected ')' after expression");
+            advance(p);
+            node = new_node(p, AST_BOOLEAN);
+            node->data.literal.value = intern_token(p, token);
+            return node;
+
+        case TOKEN_LPAREN: {
+            advance(p);
+            skip_newlines(p);
+            ast_node_t* expr = parse_expression(p);
+            skip_newlines(p);
+            consume(p, TOKEN_RPAREN, "Expected ')' after expression");
             return expr;
-            
+        }
+
         case TOKEN_LBRACKET:
-            return parse_array_literal();
-            
+            return parse_array_literal(p);
+
         case TOKEN_LBRACE:
-            return parse_object_literal();
-            
+            return parse_object_literal(p);
+
         default:
-            add_error("Unexpected token in expression");
+            // Builtin type and module names (str, int, Time, ...) are
+            // ordinary identifiers in expressions
+            if (is_name_token(token->type)) {
+                advance(p);
+                node = new_node(p, AST_IDENTIFIER);
+                node->data.identifier.name = intern_token(p, token);
+                return node;
+            }
+            add_error(p, "Unexpected token in expression");
             return NULL;
     }
 }
 
 /*
- * Utility functions
+ * Error handling
+ * Only the first error of a statement is recorded; the statement loop
+ * then skips to the next line and clears the panic flag.
  */
+static void add_error(Parser* p, const char* message) {
+    if (p->panic) return;
+    p->panic = true;
 
+    if (p->errors.count >= p->errors.capacity) {
+        return; // Error list full
+    }
 
+    parse_error_t* error = &p->errors.errors[p->errors.count++];
+    error->message = strdup(message);
+    error->line = peek(p)->line;
+    error->column = peek(p)->column;
+}
 
+static void print_parse_errors(Parser* p) {
+    printf("❌ Parse Errors:\n");
+    for (size_t i = 0; i < p->errors.count; i++) {
+        parse_error_t* error = &p->errors.errors[i];
+        printf("   Line %zu:%zu: %s\n", error->line, error->column, error->message);
+    }
+}
 
 /*
- * Get operator precedence
+ * Skip to the end of the current logical line (brackets may span lines)
  */
+static void synchronize(Parser* p) {
+    int depth = 0;
+    while (!is_at_end(p)) {
+        TokenType type = peek(p)->type;
+        if (type == TOKEN_NEWLINE && depth == 0) break;
 
-
-
+        if (type == TOKEN_LPAREN || type == TOKEN_LBRACKET || type == TOKEN_LBRACE) {
+            depth++;
+        } else if ((type == TOKEN_RPAREN || type == TOKEN_RBRACKET || type == TOKEN_RBRACE) &&
+                   depth > 0) {
+            depth--;
+        }
+        advance(p);
+    }
+}
 
 /*
- * Error handling
+ * Utility functions
  */
-static void add_error(const char* message) {
-    if (g_parser.errors.count >= g_parser.errors.capacity) {
-        return; // Error list full
+static void skip_newlines(Parser* p) {
+    while (check(p, TOKEN_NEWLINE) || check(p, TOKEN_COMMENT)) {
+        advance(p);
     }
-    
-    parse_error_t* error = &g_parser.errors.errors[g_parser.errors.count++];
-    error->message = strdup(message);
-    error->line = peek()->line;
-    error->column = peek()->column;
 }
 
-static void print_parse_errors(void) {
-    printf("❌ Parse Errors:\n");
-    for (size_t i = 0; i < g_parser.errors.count; i++) {
-        parse_error_t* error = &g_parser.errors.errors[i];
-        printf("   Line %zu:%zu: %s\n", error->line, error->column, error->message);
-    }
+static int at_line_end(Parser* p) {
+    return is_at_end(p) || check(p, TOKEN_NEWLINE) || check(p, TOKEN_COMMENT);
 }
 
-/*
- * Missing function implementations
- */
-static ast_node_t* parse_block(void) {
-    ast_node_t* block = create_ast_node(AST_BLOCK);
-    // TODO: Implement block parsing
-    return block;
+static Token* peek(Parser* p) {
+    return peek_at(p, 0);
 }
 
-static Token* peek(void) {
-    if (g_parser.current >= g_parser.token_count) {
-        return &g_parser.tokens[g_parser.token_count - 1]; // Return EOF token
+static Token* peek_at(Parser* p, size_t offset) {
+    if (p->token_count == 0) {
+        return &p->eof;
     }
-    return &g_parser.tokens[g_parser.current];
+    if (p->current + offset >= p->token_count) {
+        return &p->tokens[p->token_count - 1]; // Return EOF token
+    }
+    return &p->tokens[p->current + offset];
 }
 
-static Token* advance(void) {
-    if (!is_at_end()) {
-        g_parser.current++;
+static Token* previous(Parser* p) {
+    return p->current > 0 ? &p->tokens[p->current - 1] : peek(p);
+}
+
+static Token* advance(Parser* p) {
+    if (!is_at_end(p)) {
+        p->current++;
     }
-    return &g_parser.tokens[g_parser.current - 1];
+    return previous(p);
+}
+
+static int is_at_end(Parser* p) {
+    return p->current >= p->token_count ||
+           peek(p)->type == TOKEN_EOF;
 }
 
-static int is_at_end(void) {
-    return g_parser.current >= g_parser.token_count ||
-           peek()->type == TOKEN_EOF;
+static int check(Parser* p, TokenType type) {
+    if (is_at_end(p)) return 0;
+    return peek(p)->type == type;
 }
 
-static int check(TokenType type) {
-    if (is_at_end()) return 0;
-    return peek()->type == type;
+// Match a contextual keyword that the lexer reports as an identifier
+static int check_word(Parser* p, const char* word) {
+    Token* token = peek(p);
+    size_t length = strlen(word);
+    return token->type == TOKEN_IDENTIFIER && (size_t)token->length == length &&
+           memcmp(token->value, word, length) == 0;
 }
 
-static int match(TokenType type) {
-    if (check(type)) {
-        advance();
+static int match(Parser* p, TokenType type) {
+    if (check(p, type)) {
+        advance(p);
         return 1;
     }
     return 0;
 }
 
-static Token* consume(TokenType type, const char* message) {
-    if (check(type)) {
-        return advance();
+static Token* consume(Parser* p, TokenType type, const char* message) {
+    if (check(p, type)) {
+        return advance(p);
     }
-    add_error(message);
+    add_error(p, message);
     return NULL;
 }
 
+static Token* consume_name(Parser* p, const char* message) {
+    if (!is_at_end(p) && is_name_token(peek(p)->type)) {
+        return advance(p);
+    }
+    add_error(p, message);
+    return NULL;
+}
+
+// Identifiers plus the type and module keywords (Some .. std), which
+// double as names of builtin functions, modules and fields
+static int is_name_token(TokenType type) {
+    return type == TOKEN_IDENTIFIER || (type >= TOKEN_SOME && type <= TOKEN_STD);
+}
+
 static int get_operator_precedence(TokenType type) {
     switch (type) {
         case TOKEN_OR: return 1;
@@ -453,36 +820,256 @@ static int is_right_associative(TokenType type) {
     return type == TOKEN_POWER;
 }
 
-static ast_node_t* parse_unary_operation(ast_node_t* node) {
-    // TODO: Implement unary operation analysis
-    return NULL;
+/*
+ * Allocate AST node from the parser's arena
+ */
+static ast_node_t* new_node(Parser* p, ast_node_type_t type) {
+    return ast_arena_create_node(p->arena, type);
 }
 
-static ast_node_t* parse_function_call(ast_node_t* node) {
-    // TODO: Implement function call analysis
-    return NULL;
+/*
+ * Intern a token's text in the parser's arena
+ */
+static char* intern_token(Parser* p, Token* token) {
+    if (!token || !token->value) return NULL;
+    return (char*)ast_arena_intern(p->arena, token->value, token->length);
+}
+
+/*
+ * Intern the source text spanning first..last (e.g. "std.time")
+ */
+static char* intern_tokens(Parser* p, Token* first, Token* last) {
+    if (!first || !last || !first->value) return NULL;
+    size_t length = (size_t)(last->offset + last->length - first->offset);
+    return (char*)ast_arena_intern(p->arena, first->value, length);
 }
 
+/*
+ * Parse parameter list
+ */
+ast_node_t* parse_parameter_list(Parser* p) {
+    ast_node_t* params = new_node(p, AST_BLOCK);
 
+    skip_newlines(p);
+    while (!check(p, TOKEN_RPAREN) && !is_at_end(p) && !p->panic) {
+        ast_node_t* param = new_node(p, AST_VARIABLE);
 
+        // Borrowed receivers ("&self") lex the '&' as an error token
+        while (check(p, TOKEN_ERROR)) advance(p);
 
+        param->data.variable.name = intern_token(p, consume_name(p, "Expected parameter name"));
+        if (match(p, TOKEN_COLON)) {
+            param->data.variable.type = parse_type(p);
+        }
+        add_child(params, param);
+
+        skip_newlines(p);
+        if (!match(p, TOKEN_COMMA)) break;
+        skip_newlines(p);
+    }
+
+    return params;
+}
 
 /*
- * Cleanup parser
+ * Parse type annotation
+ * Produces an identifier naming the type: "i32", "[f32]", "Option", ...
+ * Reference markers and generic arguments are accepted and dropped.
  */
-void parser_cleanup(void) {
-    if (g_parser.errors.errors) {
-        for (size_t i = 0; i < g_parser.errors.count; i++) {
-            free((void*)g_parser.errors.errors[i].message);
-        }
-        free(g_parser.errors.errors);
-        g_parser.errors.errors = NULL;
+ast_node_t* parse_type(Parser* p) {
+    ast_node_t* type_node = new_node(p, AST_IDENTIFIER);
+
+    // "&T" / "&mut T"
+    while (check(p, TOKEN_ERROR)) advance(p);
+    if (check_word(p, "mut")) advance(p);
+
+    if (match(p, TOKEN_LBRACKET)) {
+        ast_node_t* element = parse_type(p);
+        consume(p, TOKEN_RBRACKET, "Expected ']' after array element type");
+
+        char name[256];
+        snprintf(name, sizeof(name), "[%s]",
+                 element && element->data.identifier.name ? element->data.identifier.name : "auto");
+        type_node->data.identifier.name = (char*)ast_arena_intern(p->arena, name, strlen(name));
+        return type_node;
     }
 
-    if (g_parser.root) {
-        free_ast_node(g_parser.root);
-        g_parser.root = NULL;
+    Token* name_token = consume_name(p, "Expected type name");
+    type_node->data.identifier.name = intern_token(p, name_token);
+
+    // Generic arguments: Option<T>, HashMap<K, V>
+    if (name_token && check(p, TOKEN_LT)) {
+        int depth = 0;
+        do {
+            if (check(p, TOKEN_LT)) depth++;
+            else if (check(p, TOKEN_GT)) depth--;
+            advance(p);
+        } while (depth > 0 && !at_line_end(p));
     }
 
-    printf("🧹 Parser cleaned up\n");
+    return type_node;
+}
+
+/*
+ * Parse return statement
+ */
+ast_node_t* parse_return_statement(Parser* p) {
+    ast_node_t* return_node = new_node(p, AST_RETURN);
+
+    consume(p, TOKEN_RETURN, "Expected 'return'");
+
+    if (!at_line_end(p)) {
+        return_node->data.return_stmt.expression = parse_expression(p);
+    }
+
+    return return_node;
+}
+
+/*
+ * Parse variable declaration
+ */
+ast_node_t* parse_variable_declaration(Parser* p) {
+    ast_node_t* var_node = new_node(p, AST_VARIABLE);
+
+    Token* keyword = advance(p); // 'var' or 'const'
+    var_node->data.variable.is_const = keyword->type == TOKEN_CONST;
+
+    Token* name_token = consume_name(p, "Expected variable name");
+    var_node->data.variable.name = intern_token(p, name_token);
+
+    if (match(p, TOKEN_COLON)) {
+        var_node->data.variable.type = parse_type(p);
+    }
+
+    if (match(p, TOKEN_ASSIGN)) {
+        var_node->data.variable.value = parse_expression(p);
+    }
+
+    return var_node;
+}
+
+/*
+ * Parse import statement: import a.b.c
+ */
+ast_node_t* parse_import_statement(Parser* p) {
+    ast_node_t* import_node = new_node(p, AST_IMPORT);
+
+    consume(p, TOKEN_IMPORT, "Expected 'import'");
+
+    Token* first = consume_name(p, "Expected module name");
+    Token* last = first;
+    while (last && match(p, TOKEN_DOT)) {
+        last = consume_name(p, "Expected module name after '.'");
+    }
+
+    if (last) {
+        import_node->data.literal.value = intern_tokens(p, first, last);
+    }
+
+    return import_node;
+}
+
+/*
+ * Parse expression statement (including assignments)
+ */
+ast_node_t* parse_expression_statement(Parser* p) {
+    ast_node_t* expr_stmt = new_node(p, AST_EXPRESSION_STMT);
+    ast_node_t* expr = parse_unary(p);
+
+    TokenType op = peek(p)->type;
+    bool compound = (op == TOKEN_PLUS || op == TOKEN_MINUS || op == TOKEN_MULTIPLY ||
+                     op == TOKEN_DIVIDE || op == TOKEN_MODULO) &&
+                    peek_at(p, 1)->type == TOKEN_ASSIGN;
+
+    if (expr && (op == TOKEN_ASSIGN || compound)) {
+        ast_node_t* assign = new_node(p, AST_ASSIGN);
+        advance(p);
+        if (compound) advance(p);
+
+        assign->data.assign.operator = op;
+        assign->data.assign.target = expr;
+        assign->data.assign.value = parse_expression(p);
+        expr = assign;
+    } else {
+        expr = parse_binary(p, expr, 1);
+    }
+
+    add_child(expr_stmt, expr);
+    return expr_stmt;
+}
+
+/*
+ * Parse match case: case <pattern> [if <guard>]: <block>
+ * Children are the pattern, the body and, when present, the guard.
+ */
+ast_node_t* parse_match_case(Parser* p) {
+    ast_node_t* case_node = new_node(p, AST_BLOCK);
+    int column = peek(p)->column;
+
+    advance(p); // 'case'
+
+    ast_node_t* pattern = parse_expression(p);
+    ast_node_t* guard = NULL;
+    if (match(p, TOKEN_IF)) {
+        guard = parse_expression(p);
+    }
+
+    consume(p, TOKEN_COLON, "Expected ':' after case pattern");
+
+    add_child(case_node, pattern);
+    add_child(case_node, parse_block(p, column));
+    add_child(case_node, guard);
+
+    return case_node;
+}
+
+/*
+ * Parse array literal
+ */
+ast_node_t* parse_array_literal(Parser* p) {
+    ast_node_t* array_node = new_node(p, AST_ARRAY);
+
+    consume(p, TOKEN_LBRACKET, "Expected '['");
+
+    skip_newlines(p);
+    while (!check(p, TOKEN_RBRACKET) && !is_at_end(p) && !p->panic) {
+        add_child(array_node, parse_expression(p));
+        skip_newlines(p);
+        if (!match(p, TOKEN_COMMA)) break;
+        skip_newlines(p);
+    }
+
+    consume(p, TOKEN_RBRACKET, "Expected ']' after array elements");
+
+    return array_node;
+}
+
+/*
+ * Parse object literal
+ * Each field becomes an AST_VARIABLE child holding the key and value;
+ * struct literals record their type name in data.identifier.name.
+ */
+ast_node_t* parse_object_literal(Parser* p) {
+    ast_node_t* object_node = new_node(p, AST_OBJECT);
+
+    consume(p, TOKEN_LBRACE, "Expected '{'");
+
+    skip_newlines(p);
+    while (!check(p, TOKEN_RBRACE) && !is_at_end(p) && !p->panic) {
+        ast_node_t* field = new_node(p, AST_VARIABLE);
+
+        Token* key = check(p, TOKEN_STRING) ? advance(p) : consume_name(p, "Expected field name");
+        field->data.variable.name = intern_token(p, key);
+        consume(p, TOKEN_COLON, "Expected ':' after field name");
+        field->data.variable.value = parse_expression(p);
+        add_child(object_node, field);
+
+        skip_newlines(p);
+        if (!match(p, TOKEN_COMMA)) break;
+        skip_newlines(p);
+    }
+
+    consume(p, TOKEN_RBRACE, "Expected '}' after object fields");
+
+    return object_node;
 }
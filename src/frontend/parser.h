@@ -32,15 +32,22 @@ typedef enum {
     AST_ARRAY,
     AST_OBJECT,
     AST_IMPORT,
-    AST_EXPRESSION_STMT
+    AST_EXPRESSION_STMT,
+    AST_MEMBER,
+    AST_INDEX,
+    AST_ASSIGN
 } ast_node_type_t;
 
+// AST arena (bump allocator owning a whole compilation unit's AST)
+typedef struct ast_arena ast_arena_t;
+
 // AST node structure
 typedef struct ast_node {
     ast_node_type_t type;
     struct ast_node** children;
     size_t child_count;
     size_t child_capacity;
+    ast_arena_t* arena;     // Owning arena, or NULL for heap-allocated nodes
     
     union {
         struct {
@@ -48,6 +55,7 @@ typedef struct ast_node {
             struct ast_node* parameters;
             struct ast_node* return_type;
             struct ast_node* body;
+            int is_inline;          // Declared 'inline func': always inlined under -O
         } function;
         
         struct {
@@ -68,6 +76,26 @@ typedef struct ast_node {
             struct ast_node* operand;
         } unary_op;
         
+        struct {
+            struct ast_node* callee;    // Arguments are the node's children
+        } call;
+
+        struct {
+            struct ast_node* object;
+            char* name;
+        } member;
+
+        struct {
+            struct ast_node* object;
+            struct ast_node* index;
+        } index;
+
+        struct {
+            TokenType operator;         // TOKEN_ASSIGN, or the operator of a compound assignment
+            struct ast_node* target;
+            struct ast_node* value;
+        } assign;
+        
         struct {
             struct ast_node* condition;
             struct ast_node* then_block;
@@ -130,11 +158,36 @@ typedef struct {
     size_t capacity;
 } error_list_t;
 
-// Function declarations
+// Parser context
+// Each Parser owns its token cursor, error list and AST arena, so separate
+// instances can parse different files on different threads concurrently.
+typedef struct Parser Parser;
+
+Parser* parser_create(void);
+void parser_destroy(Parser* parser);
+ast_node_t* parser_parse(Parser* parser, Token* tokens, size_t token_count);
+void parser_set_verbose(Parser* parser, bool verbose);
+ast_arena_t* parser_arena(const Parser* parser);
+size_t parser_error_count(const Parser* parser);
+const parse_error_t* parser_error(const Parser* parser, size_t index);
+
+// Legacy single-instance interface (wraps a default Parser)
 int parser_init(void);
 ast_node_t* parse(Token* tokens, size_t token_count);
 void parser_cleanup(void);
 
+// AST arena functions
+// Arena-owned nodes, child vectors and interned strings are released
+// together by ast_arena_destroy; free_ast_node ignores them.
+ast_arena_t* ast_arena_create(void);
+void ast_arena_destroy(ast_arena_t* arena);
+void* ast_arena_alloc(ast_arena_t* arena, size_t size);
+const char* ast_arena_intern(ast_arena_t* arena, const char* text, size_t length);
+ast_node_t* ast_arena_create_node(ast_arena_t* arena, ast_node_type_t type);
+int ast_arena_grow_children(ast_arena_t* arena, ast_node_t* node);
+size_t ast_arena_bytes_allocated(const ast_arena_t* arena);
+size_t ast_arena_node_count(const ast_arena_t* arena);
+
 // AST utility functions
 ast_node_t* create_ast_node(ast_node_type_t type);
 ast_node_t* create_number_node(const char* value);
@@ -145,16 +198,17 @@ void add_child(ast_node_t* parent, ast_node_t* child);
 void free_ast_node(ast_node_t* node);
 void print_ast(ast_node_t* node, int depth);
 size_t count_ast_nodes(ast_node_t* node);
+bool ast_integer_constant(ast_node_t* node, long long* value);
 
 // Parser helper functions
-ast_node_t* parse_parameter_list(void);
-ast_node_t* parse_type(void);
-ast_node_t* parse_return_statement(void);
-ast_node_t* parse_variable_declaration(void);
-ast_node_t* parse_import_statement(void);
-ast_node_t* parse_expression_statement(void);
-ast_node_t* parse_match_case(void);
-ast_node_t* parse_array_literal(void);
-ast_node_t* parse_object_literal(void);
+ast_node_t* parse_parameter_list(Parser* parser);
+ast_node_t* parse_type(Parser* parser);
+ast_node_t* parse_return_statement(Parser* parser);
+ast_node_t* parse_variable_declaration(Parser* parser);
+ast_node_t* parse_import_statement(Parser* parser);
+ast_node_t* parse_expression_statement(Parser* parser);
+ast_node_t* parse_match_case(Parser* parser);
+ast_node_t* parse_array_literal(Parser* parser);
+ast_node_t* parse_object_literal(Parser* parser);
 
 #endif // PARSER_H
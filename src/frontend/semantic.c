@@ -7,133 +7,296 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdint.h>
 #include "semantic.h"
 #include "parser.h"
 
-// Semantic analyzer state
-typedef struct {
+#define MAX_SEMANTIC_ERRORS 100
+#define SYMBOL_TABLE_INITIAL_CAPACITY 16
+#define SCOPE_STACK_INITIAL_DEPTH 16
+
+// Semantic analyzer state (one per compilation unit / thread)
+struct SemanticAnalyzer {
     symbol_table_t* global_scope;
     symbol_table_t* current_scope;
     type_system_t type_system;
-    error_list_t errors;
+    semantic_error_list_t errors;
     int in_function;
     type_t* current_function_return_type;
-} semantic_analyzer_t;
-
-static semantic_analyzer_t g_analyzer = {0};
+    bool verbose;
+
+    // Scope tables are pooled by nesting depth: pushing a scope reuses the
+    // table left at that depth, so a check allocates tables only once
+    symbol_table_t** scope_stack;
+    size_t scope_depth;
+    size_t scope_capacity;
+
+    // Symbol names are interned in the unit's AST arena, so the tables
+    // compare keys by pointer; symbols and types live in storage
+    ast_arena_t* names;
+    ast_arena_t* private_names;     // For ASTs that are not arena-allocated
+    ast_arena_t* storage;
+};
+
+// Default instance behind the legacy semantic_init/analyze/cleanup API
+static SemanticAnalyzer* g_default_analyzer = NULL;
+
+// Analysis functions
+static void analyze_node(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_program(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_function(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_variable_declaration(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_binary_operation(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_unary_operation(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_function_call(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_if_statement(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_for_statement(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_while_statement(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_match_statement(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_return_statement(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_block(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_identifier(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_object_literal(SemanticAnalyzer* a, ast_node_t* node);
+static void analyze_import(SemanticAnalyzer* a, ast_node_t* node);
+
+// Scopes and symbols
+static bool push_scope(SemanticAnalyzer* a);
+static void pop_scope(SemanticAnalyzer* a);
+static symbol_t* declare_symbol(SemanticAnalyzer* a, const char* name, symbol_kind_t kind);
+static const char* intern_name(SemanticAnalyzer* a, const char* name);
+static const char* node_name(SemanticAnalyzer* a, const ast_node_t* node, const char* name);
+static type_t* new_type(SemanticAnalyzer* a, type_kind_t kind);
+
+// Built-in types and functions
+static void add_builtin_types(SemanticAnalyzer* a);
+static void add_builtin_functions(SemanticAnalyzer* a);
+static void add_builtin_type(SemanticAnalyzer* a, const char* name, type_kind_t kind);
+static void add_builtin_function(SemanticAnalyzer* a, const char* name, type_kind_t return_type, type_kind_t param_type);
+
+// Error handling
+static void add_semantic_error(SemanticAnalyzer* a, const char* format, ...);
+static void print_semantic_errors(SemanticAnalyzer* a);
 
 /*
- * Initialize semantic analyzer
+ * Create semantic analyzer
  */
-int semantic_init(void) {
-    printf("🔍 Initializing GPLANG Semantic Analyzer...\n");
-    
-    memset(&g_analyzer, 0, sizeof(semantic_analyzer_t));
+SemanticAnalyzer* semantic_create(void) {
+    SemanticAnalyzer* a = calloc(1, sizeof(SemanticAnalyzer));
+    if (!a) return NULL;
     
-    // Initialize global scope
-    g_analyzer.global_scope = create_symbol_table(NULL);
-    g_analyzer.current_scope = g_analyzer.global_scope;
+    // Initialize scope pool (the global scope is always depth 0)
+    a->scope_capacity = SCOPE_STACK_INITIAL_DEPTH;
+    a->scope_stack = calloc(a->scope_capacity, sizeof(symbol_table_t*));
     
     // Initialize type system
-    init_type_system(&g_analyzer.type_system);
+    init_type_system(&a->type_system);
     
     // Initialize error list
-    g_analyzer.errors.capacity = 100;
-    g_analyzer.errors.errors = calloc(g_analyzer.errors.capacity, sizeof(semantic_error_t));
+    a->errors.capacity = MAX_SEMANTIC_ERRORS;
+    a->errors.errors = calloc(a->errors.capacity, sizeof(semantic_error_t));
     
-    if (!g_analyzer.global_scope || !g_analyzer.errors.errors) {
-        printf("❌ Failed to initialize semantic analyzer\n");
-        return -1;
+    if (!a->scope_stack || !a->errors.errors) {
+        semantic_destroy(a);
+        return NULL;
     }
     
-    // Add built-in types and functions
-    add_builtin_types();
-    add_builtin_functions();
-    
-    printf("✅ Semantic analyzer initialized\n");
-    printf("   • Type checking: ENABLED\n");
-    printf("   • Scope resolution: ENABLED\n");
-    printf("   • Memory safety: ENABLED\n");
-    printf("   • Ownership analysis: ENABLED\n");
+    // Built-in types and functions are declared per check, because their
+    // names must be interned in the checked unit's arena
+    return a;
+}
+
+/*
+ * Destroy semantic analyzer
+ */
+void semantic_destroy(SemanticAnalyzer* analyzer) {
+    if (!analyzer) return;
     
-    return 0;
+    for (size_t i = 0; analyzer->scope_stack && i < analyzer->scope_capacity; i++) {
+        free_symbol_table(analyzer->scope_stack[i]);
+    }
+    free(analyzer->scope_stack);
+    ast_arena_destroy(analyzer->private_names);
+    ast_arena_destroy(analyzer->storage);
+    free(analyzer->errors.errors);
+    cleanup_type_system(&analyzer->type_system);
+    free(analyzer);
+}
+
+void semantic_set_verbose(SemanticAnalyzer* analyzer, bool verbose) {
+    if (analyzer) analyzer->verbose = verbose;
+}
+
+size_t semantic_error_count(const SemanticAnalyzer* analyzer) {
+    return analyzer ? analyzer->errors.count : 0;
+}
+
+const semantic_error_t* semantic_error(const SemanticAnalyzer* analyzer, size_t index) {
+    if (!analyzer || index >= analyzer->errors.count) return NULL;
+    return &analyzer->errors.errors[index];
 }
 
 /*
  * Analyze AST for semantic correctness
  */
-int semantic_analyze(ast_node_t* root) {
-    printf("🔍 Performing semantic analysis...\n");
+int semantic_check(SemanticAnalyzer* a, ast_node_t* root) {
+    if (!a) return -1;
+    
+    if (a->verbose) {
+        printf("🔍 Performing semantic analysis...\n");
+    }
+    
+    a->errors.count = 0;
+    
+    // Symbols and types of the previous check are released in bulk
+    ast_arena_destroy(a->storage);
+    a->storage = ast_arena_create();
+    
+    // Reuse the AST's interner when there is one
+    ast_arena_destroy(a->private_names);
+    a->private_names = NULL;
+    if (root && root->arena) {
+        a->names = root->arena;
+    } else {
+        a->private_names = ast_arena_create();
+        a->names = a->private_names;
+    }
+    
+    if (!a->storage || !a->names) {
+        add_semantic_error(a, "Out of memory");
+        return -1;
+    }
     
-    g_analyzer.errors.count = 0;
+    // Open the global scope
+    a->scope_depth = 0;
+    a->current_scope = NULL;
+    if (!push_scope(a)) return -1;
+    a->global_scope = a->current_scope;
+    a->in_function = 0;
+    
+    add_builtin_types(a);
+    add_builtin_functions(a);
     
     // Analyze the AST
-    analyze_node(root);
+    analyze_node(a, root);
+    
+    pop_scope(a);
     
-    if (g_analyzer.errors.count > 0) {
-        printf("❌ Semantic analysis found %zu errors\n", g_analyzer.errors.count);
-        print_semantic_errors();
+    if (a->errors.count > 0) {
+        if (a->verbose) {
+            printf("❌ Semantic analysis found %zu errors\n", a->errors.count);
+            print_semantic_errors(a);
+        }
         return -1;
     }
     
-    printf("✅ Semantic analysis completed successfully\n");
-    printf("   • Type checking: PASSED\n");
-    printf("   • Scope resolution: PASSED\n");
-    printf("   • Memory safety: VERIFIED\n");
+    if (a->verbose) {
+        printf("✅ Semantic analysis completed successfully\n");
+        printf("   • Type checking: PASSED\n");
+        printf("   • Scope resolution: PASSED\n");
+        printf("   • Memory safety: VERIFIED\n");
+    }
     
     return 0;
 }
 
+/*
+ * Legacy interface
+ */
+int semantic_init(void) {
+    printf("🔍 Initializing GPLANG Semantic Analyzer...\n");
+    
+    semantic_destroy(g_default_analyzer);
+    g_default_analyzer = semantic_create();
+    if (!g_default_analyzer) {
+        printf("❌ Failed to initialize semantic analyzer\n");
+        return -1;
+    }
+    g_default_analyzer->verbose = true;
+    
+    printf("✅ Semantic analyzer initialized\n");
+    printf("   • Type checking: ENABLED\n");
+    printf("   • Scope resolution: ENABLED\n");
+    printf("   • Memory safety: ENABLED\n");
+    printf("   • Ownership analysis: ENABLED\n");
+    
+    return 0;
+}
+
+int semantic_analyze(ast_node_t* root) {
+    if (!g_default_analyzer && semantic_init() != 0) {
+        return -1;
+    }
+    return semantic_check(g_default_analyzer, root);
+}
+
 /*
  * Analyze AST node
  */
-static void analyze_node(ast_node_t* node) {
+static void analyze_node(SemanticAnalyzer* a, ast_node_t* node) {
     if (!node) return;
     
     switch (node->type) {
         case AST_PROGRAM:
-            analyze_program(node);
+            analyze_program(a, node);
             break;
         case AST_FUNCTION:
-            analyze_function(node);
+            analyze_function(a, node);
             break;
         case AST_VARIABLE:
-            analyze_variable_declaration(node);
+            analyze_variable_declaration(a, node);
             break;
         case AST_BINARY_OP:
-            analyze_binary_operation(node);
+            analyze_binary_operation(a, node);
             break;
         case AST_UNARY_OP:
-            analyze_unary_operation(node);
+            analyze_unary_operation(a, node);
             break;
         case AST_CALL:
-            analyze_function_call(node);
+            analyze_function_call(a, node);
             break;
         case AST_IF:
-            analyze_if_statement(node);
+            analyze_if_statement(a, node);
             break;
         case AST_FOR:
-            analyze_for_statement(node);
+            analyze_for_statement(a, node);
             break;
         case AST_WHILE:
-            analyze_while_statement(node);
+            analyze_while_statement(a, node);
             break;
         case AST_MATCH:
-            analyze_match_statement(node);
+            analyze_match_statement(a, node);
             break;
         case AST_RETURN:
-            analyze_return_statement(node);
+            analyze_return_statement(a, node);
             break;
         case AST_BLOCK:
-            analyze_block(node);
+            analyze_block(a, node);
             break;
         case AST_IDENTIFIER:
-            analyze_identifier(node);
+            analyze_identifier(a, node);
+            break;
+        case AST_MEMBER:
+            // Members resolve against the object's type, not the scope
+            analyze_node(a, node->data.member.object);
+            break;
+        case AST_INDEX:
+            analyze_node(a, node->data.index.object);
+            analyze_node(a, node->data.index.index);
+            break;
+        case AST_ASSIGN:
+            analyze_node(a, node->data.assign.target);
+            analyze_node(a, node->data.assign.value);
+            break;
+        case AST_OBJECT:
+            analyze_object_literal(a, node);
+            break;
+        case AST_IMPORT:
+            analyze_import(a, node);
             break;
         default:
             // Analyze children for other node types
             for (size_t i = 0; i < node->child_count; i++) {
-                analyze_node(node->children[i]);
+                analyze_node(a, node->children[i]);
             }
             break;
     }
@@ -142,79 +305,99 @@ static void analyze_node(ast_node_t* node) {
 /*
  * Analyze program (top-level)
  */
-static void analyze_program(ast_node_t* node) {
+static void analyze_program(SemanticAnalyzer* a, ast_node_t* node) {
+    // Declare every top-level function first so calls may precede
+    // definitions
+    for (size_t i = 0; i < node->child_count; i++) {
+        ast_node_t* child = node->children[i];
+        if (!child || child->type != AST_FUNCTION || !child->data.function.name) continue;
+        
+        const char* func_name = node_name(a, child, child->data.function.name);
+        if (lookup_symbol_local(a->current_scope, func_name)) {
+            add_semantic_error(a, "Function '%s' already declared", func_name);
+            continue;
+        }
+        symbol_t* func_symbol = declare_symbol(a, func_name, SYMBOL_FUNCTION);
+        if (func_symbol) func_symbol->declaration = child;
+    }
+    
     // Analyze all top-level declarations
     for (size_t i = 0; i < node->child_count; i++) {
-        analyze_node(node->children[i]);
+        analyze_node(a, node->children[i]);
     }
 }
 
 /*
  * Analyze function declaration
  */
-static void analyze_function(ast_node_t* node) {
-    const char* func_name = node->data.function.name;
-    
-    // Check if function already exists
-    symbol_t* existing = lookup_symbol(g_analyzer.current_scope, func_name);
-    if (existing) {
-        add_semantic_error("Function '%s' already declared", func_name);
+static void analyze_function(SemanticAnalyzer* a, ast_node_t* node) {
+    const char* func_name = node_name(a, node, node->data.function.name);
+    if (!func_name) return;
+    
+    // Top-level functions were declared by analyze_program
+    symbol_t* func_symbol = lookup_symbol_local(a->current_scope, func_name);
+    if (func_symbol && func_symbol->declaration != node) {
+        if (a->current_scope != a->global_scope) {
+            add_semantic_error(a, "Function '%s' already declared", func_name);
+        }
         return;
     }
     
     // Create function symbol
-    symbol_t* func_symbol = create_symbol(func_name, SYMBOL_FUNCTION);
-    func_symbol->type = create_function_type();
-    
-    // Add to current scope
-    add_symbol(g_analyzer.current_scope, func_symbol);
+    if (!func_symbol) {
+        func_symbol = declare_symbol(a, func_name, SYMBOL_FUNCTION);
+        if (!func_symbol) return;
+        func_symbol->declaration = node;
+    }
+    func_symbol->type = new_type(a, TYPE_FUNCTION);
+    func_symbol->type->data.function.return_type = node->data.function.return_type ?
+        resolve_type(node->data.function.return_type) : get_void_type();
     
-    // Create new scope for function body
-    symbol_table_t* func_scope = create_symbol_table(g_analyzer.current_scope);
-    symbol_table_t* prev_scope = g_analyzer.current_scope;
-    g_analyzer.current_scope = func_scope;
+    // New scope for parameters and body
+    if (!push_scope(a)) return;
     
     // Set function context
-    int prev_in_function = g_analyzer.in_function;
-    type_t* prev_return_type = g_analyzer.current_function_return_type;
-    g_analyzer.in_function = 1;
-    g_analyzer.current_function_return_type = func_symbol->type->data.function.return_type;
-    
-    // Analyze parameters
-    if (node->data.function.parameters) {
-        analyze_node(node->data.function.parameters);
+    int prev_in_function = a->in_function;
+    type_t* prev_return_type = a->current_function_return_type;
+    a->in_function = 1;
+    a->current_function_return_type = func_symbol->type->data.function.return_type;
+    
+    // Analyze parameters (declared directly in the function scope)
+    ast_node_t* params = node->data.function.parameters;
+    for (size_t i = 0; params && i < params->child_count; i++) {
+        analyze_node(a, params->children[i]);
     }
     
     // Analyze function body
     if (node->data.function.body) {
-        analyze_node(node->data.function.body);
+        analyze_node(a, node->data.function.body);
     }
     
     // Restore previous context
-    g_analyzer.current_scope = prev_scope;
-    g_analyzer.in_function = prev_in_function;
-    g_analyzer.current_function_return_type = prev_return_type;
+    a->in_function = prev_in_function;
+    a->current_function_return_type = prev_return_type;
     
-    free_symbol_table(func_scope);
+    pop_scope(a);
 }
 
 /*
  * Analyze variable declaration
  */
-static void analyze_variable_declaration(ast_node_t* node) {
-    const char* var_name = node->data.variable.name;
+static void analyze_variable_declaration(SemanticAnalyzer* a, ast_node_t* node) {
+    const char* var_name = node_name(a, node, node->data.variable.name);
+    if (!var_name) return;
     
     // Check if variable already exists in current scope
-    symbol_t* existing = lookup_symbol_local(g_analyzer.current_scope, var_name);
+    symbol_t* existing = lookup_symbol_local(a->current_scope, var_name);
     if (existing) {
-        add_semantic_error("Variable '%s' already declared in this scope", var_name);
+        add_semantic_error(a, "Variable '%s' already declared in this scope", var_name);
         return;
     }
     
     // Analyze initializer expression
     type_t* init_type = NULL;
     if (node->data.variable.value) {
-        analyze_node(node->data.variable.value);
+        analyze_node(a, node->data.variable.value);
         init_type = get_expression_type(node->data.variable.value);
     }
     
@@ -225,46 +408,45 @@ static void analyze_variable_declaration(ast_node_t* node) {
     } else if (init_type) {
         var_type = init_type; // Type inference
     } else {
-        add_semantic_error("Cannot infer type for variable '%s'", var_name);
+        add_semantic_error(a, "Cannot infer type for variable '%s'", var_name);
         return;
     }
     
     // Check type compatibility
     if (init_type && !types_compatible(var_type, init_type)) {
-        add_semantic_error("Type mismatch in variable '%s' declaration", var_name);
+        add_semantic_error(a, "Type mismatch in variable '%s' declaration", var_name);
         return;
     }
     
-    // Create variable symbol
-    symbol_t* var_symbol = create_symbol(var_name, SYMBOL_VARIABLE);
+    // Create variable symbol in the current scope
+    symbol_t* var_symbol = declare_symbol(a, var_name, SYMBOL_VARIABLE);
+    if (!var_symbol) return;
     var_symbol->type = var_type;
     var_symbol->is_const = node->data.variable.is_const;
-    
-    // Add to current scope
-    add_symbol(g_analyzer.current_scope, var_symbol);
+    var_symbol->declaration = node;
 }
 
 /*
  * Analyze binary operation
  */
-static void analyze_binary_operation(ast_node_t* node) {
+static void analyze_binary_operation(SemanticAnalyzer* a, ast_node_t* node) {
     // Analyze operands
-    analyze_node(node->data.binary_op.left);
-    analyze_node(node->data.binary_op.right);
+    analyze_node(a, node->data.binary_op.left);
+    analyze_node(a, node->data.binary_op.right);
     
     // Get operand types
     type_t* left_type = get_expression_type(node->data.binary_op.left);
     type_t* right_type = get_expression_type(node->data.binary_op.right);
     
     if (!left_type || !right_type) {
-        add_semantic_error("Cannot determine operand types for binary operation");
+        add_semantic_error(a, "Cannot determine operand types for binary operation");
         return;
     }
     
     // Check operator compatibility
     TokenType op = node->data.binary_op.operator;
     if (!is_binary_operator_valid(op, left_type, right_type)) {
-        add_semantic_error("Invalid binary operation between types");
+        add_semantic_error(a, "Invalid binary operation between types");
         return;
     }
     
@@ -276,13 +458,14 @@ static void analyze_binary_operation(ast_node_t* node) {
 /*
  * Analyze identifier
  */
-static void analyze_identifier(ast_node_t* node) {
-    const char* name = node->data.identifier.name;
+static void analyze_identifier(SemanticAnalyzer* a, ast_node_t* node) {
+    const char* name = node_name(a, node, node->data.identifier.name);
+    if (!name) return;
     
     // Look up symbol
-    symbol_t* symbol = lookup_symbol(g_analyzer.current_scope, name);
+    symbol_t* symbol = lookup_symbol(a->current_scope, name);
     if (!symbol) {
-        add_semantic_error("Undefined identifier '%s'", name);
+        add_semantic_error(a, "Undefined identifier '%s'", name);
         return;
     }
     
@@ -296,78 +479,84 @@ static void analyze_identifier(ast_node_t* node) {
 /*
  * Analyze return statement
  */
-static void analyze_return_statement(ast_node_t* node) {
-    if (!g_analyzer.in_function) {
-        add_semantic_error("Return statement outside function");
+static void analyze_return_statement(SemanticAnalyzer* a, ast_node_t* node) {
+    if (!a->in_function) {
+        add_semantic_error(a, "Return statement outside function");
         return;
     }
     
     // Analyze return expression
     type_t* return_type = NULL;
     if (node->data.return_stmt.expression) {
-        analyze_node(node->data.return_stmt.expression);
+        analyze_node(a, node->data.return_stmt.expression);
         return_type = get_expression_type(node->data.return_stmt.expression);
     } else {
         return_type = get_void_type();
     }
     
     // Check return type compatibility
-    if (!types_compatible(g_analyzer.current_function_return_type, return_type)) {
-        add_semantic_error("Return type mismatch");
+    if (!types_compatible(a->current_function_return_type, return_type)) {
+        add_semantic_error(a, "Return type mismatch");
     }
 }
 
 /*
  * Add built-in types
  */
-static void add_builtin_types(void) {
+static void add_builtin_types(SemanticAnalyzer* a) {
     // Add primitive types
-    add_builtin_type("i32", TYPE_INT32);
-    add_builtin_type("i64", TYPE_INT64);
-    add_builtin_type("f32", TYPE_FLOAT32);
-    add_builtin_type("f64", TYPE_FLOAT64);
-    add_builtin_type("bool", TYPE_BOOL);
-    add_builtin_type("string", TYPE_STRING);
-    add_builtin_type("void", TYPE_VOID);
+    add_builtin_type(a, "i32", TYPE_INT32);
+    add_builtin_type(a, "i64", TYPE_INT64);
+    add_builtin_type(a, "f32", TYPE_FLOAT32);
+    add_builtin_type(a, "f64", TYPE_FLOAT64);
+    add_builtin_type(a, "bool", TYPE_BOOL);
+    add_builtin_type(a, "string", TYPE_STRING);
+    add_builtin_type(a, "void", TYPE_VOID);
     
     // Add SIMD types
-    add_builtin_type("Vec2", TYPE_VEC2);
-    add_builtin_type("Vec3", TYPE_VEC3);
-    add_builtin_type("Vec4", TYPE_VEC4);
+    add_builtin_type(a, "Vec2", TYPE_VEC2);
+    add_builtin_type(a, "Vec3", TYPE_VEC3);
+    add_builtin_type(a, "Vec4", TYPE_VEC4);
+    
+    // Clock type of std.time
+    add_builtin_type(a, "Time", TYPE_STRUCT);
     
     // Add safety types
-    add_builtin_type("Option", TYPE_OPTION);
-    add_builtin_type("Result", TYPE_RESULT);
+    add_builtin_type(a, "Option", TYPE_OPTION);
+    add_builtin_type(a, "Result", TYPE_RESULT);
 }
 
 /*
  * Add built-in functions
  */
-static void add_builtin_functions(void) {
-    // Add print function
-    symbol_t* print_func = create_symbol("print", SYMBOL_FUNCTION);
-    print_func->type = create_function_type();
-    add_symbol(g_analyzer.global_scope, print_func);
+static void add_builtin_functions(SemanticAnalyzer* a) {
+    // Add core functions
+    add_builtin_function(a, "print", TYPE_VOID, TYPE_STRING);
+    add_builtin_function(a, "range", TYPE_ARRAY, TYPE_INT64);
+    add_builtin_function(a, "len", TYPE_INT64, TYPE_ARRAY);
+    add_builtin_function(a, "str", TYPE_STRING, TYPE_VOID);
+    add_builtin_function(a, "int", TYPE_INT64, TYPE_VOID);
+    add_builtin_function(a, "float", TYPE_FLOAT64, TYPE_VOID);
     
     // Add math functions
-    add_builtin_function("sqrt", TYPE_FLOAT64, TYPE_FLOAT64);
-    add_builtin_function("sin", TYPE_FLOAT64, TYPE_FLOAT64);
-    add_builtin_function("cos", TYPE_FLOAT64, TYPE_FLOAT64);
+    add_builtin_function(a, "sqrt", TYPE_FLOAT64, TYPE_FLOAT64);
+    add_builtin_function(a, "sin", TYPE_FLOAT64, TYPE_FLOAT64);
+    add_builtin_function(a, "cos", TYPE_FLOAT64, TYPE_FLOAT64);
     
     // Add memory functions
-    add_builtin_function("alloc", TYPE_PTR, TYPE_INT64);
-    add_builtin_function("free", TYPE_VOID, TYPE_PTR);
+    add_builtin_function(a, "alloc", TYPE_PTR, TYPE_INT64);
+    add_builtin_function(a, "free", TYPE_VOID, TYPE_PTR);
 }
 
 /*
  * Error handling
  */
-static void add_semantic_error(const char* format, ...) {
-    if (g_analyzer.errors.count >= g_analyzer.errors.capacity) {
+static void add_semantic_error(SemanticAnalyzer* a, const char* format, ...) {
+    if (a->errors.count >= a->errors.capacity) {
         return; // Error list full
     }
     
-    semantic_error_t* error = &g_analyzer.errors.errors[g_analyzer.errors.count++];
+    semantic_error_t* error = &a->errors.errors[a->errors.count++];
     
     va_list args;
     va_start(args, format);
@@ -378,10 +567,10 @@ static void add_semantic_error(const char* format, ...) {
     error->column = 0;
 }
 
-static void print_semantic_errors(void) {
+static void print_semantic_errors(SemanticAnalyzer* a) {
     printf("❌ Semantic Errors:\n");
-    for (size_t i = 0; i < g_analyzer.errors.count; i++) {
-        semantic_error_t* error = &g_analyzer.errors.errors[i];
+    for (size_t i = 0; i < a->errors.count; i++) {
+        semantic_error_t* error = &a->errors.errors[i];
         printf("   Line %zu:%zu: %s\n", error->line, error->column, error->message);
     }
 }
@@ -389,50 +578,241 @@ static void print_semantic_errors(void) {
 /*
  * Missing function implementations
  */
-static void analyze_unary_operation(ast_node_t* node) {
-    // TODO: Implement unary operation analysis
+static void analyze_unary_operation(SemanticAnalyzer* a, ast_node_t* node) {
+    analyze_node(a, node->data.unary_op.operand);
+    set_expression_type(node, get_expression_type(node->data.unary_op.operand));
+}
+
+static void analyze_function_call(SemanticAnalyzer* a, ast_node_t* node) {
+    analyze_node(a, node->data.call.callee);
+    for (size_t i = 0; i < node->child_count; i++) {
+        analyze_node(a, node->children[i]);
+    }
 }
 
-static void analyze_function_call(ast_node_t* node) {
-    // TODO: Implement function call analysis
+static void analyze_if_statement(SemanticAnalyzer* a, ast_node_t* node) {
+    analyze_node(a, node->data.if_stmt.condition);
+    analyze_node(a, node->data.if_stmt.then_block);
+    analyze_node(a, node->data.if_stmt.else_block);
 }
 
-static void analyze_if_statement(ast_node_t* node) {
-    // TODO: Implement if statement analysis
+static void analyze_for_statement(SemanticAnalyzer* a, ast_node_t* node) {
+    analyze_node(a, node->data.for_stmt.iterable);
+    
+    // The loop variable lives in its own scope around the body
+    if (!push_scope(a)) return;
+    const char* var_name = node_name(a, node, node->data.for_stmt.variable);
+    symbol_t* var_symbol = var_name ? declare_symbol(a, var_name, SYMBOL_VARIABLE) : NULL;
+    if (var_symbol) {
+        var_symbol->type = get_void_type();
+        var_symbol->declaration = node;
+    }
+    analyze_node(a, node->data.for_stmt.body);
+    pop_scope(a);
 }
 
-static void analyze_for_statement(ast_node_t* node) {
-    // TODO: Implement for statement analysis
+static void analyze_while_statement(SemanticAnalyzer* a, ast_node_t* node) {
+    analyze_node(a, node->data.while_stmt.condition);
+    analyze_node(a, node->data.while_stmt.body);
 }
 
-static void analyze_while_statement(ast_node_t* node) {
-    // TODO: Implement while statement analysis
+/*
+ * Declare the names a case pattern binds: Some(x), Err(_), ...
+ * Names that already resolve (None, constants) are matched, not bound.
+ */
+static void bind_pattern(SemanticAnalyzer* a, ast_node_t* pattern) {
+    if (!pattern) return;
+    
+    if (pattern->type == AST_IDENTIFIER) {
+        const char* name = node_name(a, pattern, pattern->data.identifier.name);
+        if (name && !lookup_symbol(a->current_scope, name)) {
+            symbol_t* symbol = declare_symbol(a, name, SYMBOL_VARIABLE);
+            if (symbol) {
+                symbol->type = get_void_type();
+                symbol->declaration = pattern;
+            }
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < pattern->child_count; i++) {
+        bind_pattern(a, pattern->children[i]);
+    }
 }
 
-static void analyze_match_statement(ast_node_t* node) {
-    // TODO: Implement match statement analysis
+static void analyze_match_statement(SemanticAnalyzer* a, ast_node_t* node) {
+    analyze_node(a, node->data.match_stmt.expression);
+    
+    // Each case is [pattern, body, guard] in its own scope
+    for (size_t i = 0; i < node->child_count; i++) {
+        ast_node_t* case_node = node->children[i];
+        if (!case_node || case_node->child_count < 2) continue;
+        
+        if (!push_scope(a)) return;
+        bind_pattern(a, case_node->children[0]);
+        if (case_node->child_count > 2) {
+            analyze_node(a, case_node->children[2]);
+        }
+        analyze_node(a, case_node->children[1]);
+        pop_scope(a);
+    }
+}
+
+/*
+ * Analyze import: "import std.fs" makes the module visible as "fs"
+ */
+static void analyze_import(SemanticAnalyzer* a, ast_node_t* node) {
+    const char* path = node->data.literal.value;
+    if (!path) return;
+    
+    const char* last = strrchr(path, '.');
+    last = last ? last + 1 : path;
+    
+    const char* module_name = ast_arena_intern(a->names, last, strlen(last));
+    if (!lookup_symbol_local(a->current_scope, module_name)) {
+        symbol_t* symbol = declare_symbol(a, module_name, SYMBOL_CONSTANT);
+        if (symbol) {
+            symbol->type = get_void_type();
+            symbol->declaration = node;
+        }
+    }
 }
 
-static void analyze_block(ast_node_t* node) {
+static void analyze_object_literal(SemanticAnalyzer* a, ast_node_t* node) {
+    // Fields are AST_VARIABLE nodes, but they name keys, not variables
     for (size_t i = 0; i < node->child_count; i++) {
-        analyze_node(node->children[i]);
+        ast_node_t* field = node->children[i];
+        if (field && field->type == AST_VARIABLE) {
+            analyze_node(a, field->data.variable.value);
+        }
     }
 }
 
-static void add_builtin_type(const char* name, type_kind_t kind) {
-    // TODO: Implement builtin type addition
+static void analyze_block(SemanticAnalyzer* a, ast_node_t* node) {
+    if (!push_scope(a)) return;
+    for (size_t i = 0; i < node->child_count; i++) {
+        analyze_node(a, node->children[i]);
+    }
+    pop_scope(a);
 }
 
-static void add_builtin_function(const char* name, type_kind_t return_type, type_kind_t param_type) {
-    // TODO: Implement builtin function addition
+static void add_builtin_type(SemanticAnalyzer* a, const char* name, type_kind_t kind) {
+    symbol_t* symbol = declare_symbol(a, intern_name(a, name), SYMBOL_TYPE);
+    if (symbol) symbol->type = new_type(a, kind);
+}
+
+static void add_builtin_function(SemanticAnalyzer* a, const char* name, type_kind_t return_type, type_kind_t param_type) {
+    symbol_t* symbol = declare_symbol(a, intern_name(a, name), SYMBOL_FUNCTION);
+    if (!symbol) return;
+    
+    type_t* type = new_type(a, TYPE_FUNCTION);
+    type->data.function.return_type = new_type(a, return_type);
+    type->data.function.param_types = ast_arena_alloc(a->storage, sizeof(type_t*));
+    if (type->data.function.param_types) {
+        type->data.function.param_types[0] = new_type(a, param_type);
+        type->data.function.param_count = 1;
+    }
+    symbol->type = type;
+}
+
+/*
+ * Scope stack
+ * A failed push reports the error and returns false; the caller then
+ * skips what the scope would hold, and the matching pop_scope.
+ */
+static bool push_scope(SemanticAnalyzer* a) {
+    if (a->scope_depth == a->scope_capacity) {
+        size_t capacity = a->scope_capacity * 2;
+        symbol_table_t** stack = realloc(a->scope_stack, capacity * sizeof(symbol_table_t*));
+        if (!stack) {
+            add_semantic_error(a, "Out of memory");
+            return false;
+        }
+        memset(stack + a->scope_capacity, 0, a->scope_capacity * sizeof(symbol_table_t*));
+        a->scope_stack = stack;
+        a->scope_capacity = capacity;
+    }
+    
+    symbol_table_t* table = a->scope_stack[a->scope_depth];
+    if (table) {
+        clear_symbol_table(table);
+        table->parent = a->current_scope;
+    } else {
+        table = create_symbol_table(a->current_scope);
+        if (!table) {
+            add_semantic_error(a, "Out of memory");
+            return false;
+        }
+        a->scope_stack[a->scope_depth] = table;
+    }
+    
+    a->scope_depth++;
+    a->current_scope = table;
+    return true;
+}
+
+static void pop_scope(SemanticAnalyzer* a) {
+    if (a->scope_depth == 0) return;
+    
+    // The table stays in the pool for the next scope at this depth
+    a->scope_depth--;
+    a->current_scope = a->scope_stack[a->scope_depth]->parent;
+}
+
+/*
+ * Declare symbol in the current scope (name must be interned)
+ */
+static symbol_t* declare_symbol(SemanticAnalyzer* a, const char* name, symbol_kind_t kind) {
+    symbol_t* symbol = ast_arena_alloc(a->storage, sizeof(symbol_t));
+    if (!symbol) {
+        add_semantic_error(a, "Out of memory");
+        return NULL;
+    }
+    
+    symbol->name = (char*)name;
+    symbol->kind = kind;
+    add_symbol(a->current_scope, symbol);
+    return symbol;
+}
+
+static const char* intern_name(SemanticAnalyzer* a, const char* name) {
+    if (!name) return NULL;
+    return ast_arena_intern(a->names, name, strlen(name));
+}
+
+// A name the parser stored in node is already interned in the node's arena
+static const char* node_name(SemanticAnalyzer* a, const ast_node_t* node, const char* name) {
+    return node->arena == a->names ? name : intern_name(a, name);
+}
+
+static type_t* new_type(SemanticAnalyzer* a, type_kind_t kind) {
+    type_t* type = ast_arena_alloc(a->storage, sizeof(type_t));
+    if (!type) return get_void_type();
+    type->kind = kind;
+    return type;
+}
+
+/*
+ * Symbol tables
+ * Open addressing with linear probing. Keys are interned name pointers,
+ * so a probe compares addresses and never touches the string bytes.
+ */
+static size_t symbol_hash(const char* name, size_t mask) {
+    uint64_t key = (uint64_t)(uintptr_t)name;
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
 }
 
-// Stub implementations for missing functions
 symbol_table_t* create_symbol_table(symbol_table_t* parent) {
     symbol_table_t* table = calloc(1, sizeof(symbol_table_t));
+    if (!table) return NULL;
+    
     table->parent = parent;
-    table->capacity = 16;
+    table->capacity = SYMBOL_TABLE_INITIAL_CAPACITY;
     table->symbols = calloc(table->capacity, sizeof(symbol_t*));
+    if (!table->symbols) {
+        free(table);
+        return NULL;
+    }
     return table;
 }
 
@@ -443,26 +823,83 @@ void free_symbol_table(symbol_table_t* table) {
     }
 }
 
+void clear_symbol_table(symbol_table_t* table) {
+    if (table && table->count > 0) {
+        memset(table->symbols, 0, table->capacity * sizeof(symbol_t*));
+        table->count = 0;
+    }
+}
+
 symbol_t* create_symbol(const char* name, symbol_kind_t kind) {
     symbol_t* symbol = calloc(1, sizeof(symbol_t));
-    symbol->name = strdup(name);
+    if (!symbol) return NULL;
+    symbol->name = (char*)name;
     symbol->kind = kind;
     return symbol;
 }
 
+static void grow_symbol_table(symbol_table_t* table) {
+    size_t capacity = table->capacity * 2;
+    symbol_t** symbols = calloc(capacity, sizeof(symbol_t*));
+    if (!symbols) return;
+    
+    for (size_t i = 0; i < table->capacity; i++) {
+        symbol_t* symbol = table->symbols[i];
+        if (!symbol) continue;
+        
+        size_t slot = symbol_hash(symbol->name, capacity - 1);
+        while (symbols[slot]) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        symbols[slot] = symbol;
+    }
+    
+    free(table->symbols);
+    table->symbols = symbols;
+    table->capacity = capacity;
+}
+
 void add_symbol(symbol_table_t* table, symbol_t* symbol) {
-    if (table && symbol && table->count < table->capacity) {
-        table->symbols[table->count++] = symbol;
+    if (!table || !symbol || !symbol->name) return;
+    
+    // Keep load factor below 3/4
+    if ((table->count + 1) * 4 > table->capacity * 3) {
+        grow_symbol_table(table);
     }
+    
+    size_t mask = table->capacity - 1;
+    size_t slot = symbol_hash(symbol->name, mask);
+    while (table->symbols[slot]) {
+        // Redeclaration replaces the visible symbol
+        if (table->symbols[slot]->name == symbol->name) {
+            table->symbols[slot] = symbol;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    
+    table->symbols[slot] = symbol;
+    table->count++;
 }
 
-symbol_t* lookup_symbol(symbol_table_t* table, const char* name) {
-    // TODO: Implement symbol lookup
+symbol_t* lookup_symbol_local(symbol_table_t* table, const char* name) {
+    if (!table || !name || table->count == 0) return NULL;
+    
+    size_t mask = table->capacity - 1;
+    size_t slot = symbol_hash(name, mask);
+    symbol_t* symbol;
+    while ((symbol = table->symbols[slot]) != NULL) {
+        if (symbol->name == name) return symbol;
+        slot = (slot + 1) & mask;
+    }
     return NULL;
 }
 
-symbol_t* lookup_symbol_local(symbol_table_t* table, const char* name) {
-    // TODO: Implement local symbol lookup
+symbol_t* lookup_symbol(symbol_table_t* table, const char* name) {
+    for (; table; table = table->parent) {
+        symbol_t* symbol = lookup_symbol_local(table, name);
+        if (symbol) return symbol;
+    }
     return NULL;
 }
 
@@ -525,17 +962,8 @@ void check_ownership_rules(ast_node_t* node, symbol_t* symbol) {
  * Cleanup semantic analyzer
  */
 void semantic_cleanup(void) {
-    if (g_analyzer.global_scope) {
-        free_symbol_table(g_analyzer.global_scope);
-        g_analyzer.global_scope = NULL;
-    }
-
-    if (g_analyzer.errors.errors) {
-        free(g_analyzer.errors.errors);
-        g_analyzer.errors.errors = NULL;
-    }
-
-    cleanup_type_system(&g_analyzer.type_system);
+    semantic_destroy(g_default_analyzer);
+    g_default_analyzer = NULL;
 
     printf("🧹 Semantic analyzer cleaned up\n");
 }
@@ -80,19 +80,20 @@ typedef enum {
 
 // Symbol structure
 typedef struct symbol {
-    char* name;
+    char* name;          // Interned: tables compare names by pointer
     symbol_kind_t kind;
     type_t* type;
     int is_const;
     int is_mutable;
     int is_borrowed;
     int ownership_id;
-    struct symbol* next; // For hash table chaining
+    struct ast_node* declaration; // Declaring AST node, if any
+    struct symbol* next;
 } symbol_t;
 
-// Symbol table
+// Symbol table (open addressing, keyed by interned name pointer)
 typedef struct symbol_table {
-    symbol_t** symbols;
+    symbol_t** symbols;     // capacity slots, NULL when empty
     size_t capacity;
     size_t count;
     struct symbol_table* parent;
@@ -112,32 +113,34 @@ typedef struct {
     size_t column;
 } semantic_error_t;
 
-// Use error_list_t from parser.h
+// Semantic error list
+typedef struct {
+    semantic_error_t* errors;
+    size_t count;
+    size_t capacity;
+} semantic_error_list_t;
+
+// Semantic analyzer context
+// Each analyzer owns its scopes, type system and errors, so separate
+// instances can check different units on different threads concurrently.
+typedef struct SemanticAnalyzer SemanticAnalyzer;
 
-// Function declarations
+SemanticAnalyzer* semantic_create(void);
+void semantic_destroy(SemanticAnalyzer* analyzer);
+int semantic_check(SemanticAnalyzer* analyzer, ast_node_t* root);
+void semantic_set_verbose(SemanticAnalyzer* analyzer, bool verbose);
+size_t semantic_error_count(const SemanticAnalyzer* analyzer);
+const semantic_error_t* semantic_error(const SemanticAnalyzer* analyzer, size_t index);
+
+// Legacy single-instance interface (wraps a default analyzer)
 int semantic_init(void);
 int semantic_analyze(ast_node_t* root);
 void semantic_cleanup(void);
 
-// Analysis functions
-static void analyze_node(ast_node_t* node);
-static void analyze_program(ast_node_t* node);
-static void analyze_function(ast_node_t* node);
-static void analyze_variable_declaration(ast_node_t* node);
-static void analyze_binary_operation(ast_node_t* node);
-static void analyze_unary_operation(ast_node_t* node);
-static void analyze_function_call(ast_node_t* node);
-static void analyze_if_statement(ast_node_t* node);
-static void analyze_for_statement(ast_node_t* node);
-static void analyze_while_statement(ast_node_t* node);
-static void analyze_match_statement(ast_node_t* node);
-static void analyze_return_statement(ast_node_t* node);
-static void analyze_block(ast_node_t* node);
-static void analyze_identifier(ast_node_t* node);
-
 // Symbol table functions
 symbol_table_t* create_symbol_table(symbol_table_t* parent);
 void free_symbol_table(symbol_table_t* table);
+void clear_symbol_table(symbol_table_t* table);
 symbol_t* create_symbol(const char* name, symbol_kind_t kind);
 void add_symbol(symbol_table_t* table, symbol_t* symbol);
 symbol_t* lookup_symbol(symbol_table_t* table, const char* name);
@@ -156,17 +159,7 @@ int types_compatible(type_t* t1, type_t* t2);
 int is_binary_operator_valid(TokenType op, type_t* left, type_t* right);
 type_t* get_binary_result_type(TokenType op, type_t* left, type_t* right);
 
-// Built-in types and functions
-static void add_builtin_types(void);
-static void add_builtin_functions(void);
-static void add_builtin_type(const char* name, type_kind_t kind);
-static void add_builtin_function(const char* name, type_kind_t return_type, type_kind_t param_type);
-
 // Ownership and borrowing
 void check_ownership_rules(ast_node_t* node, symbol_t* symbol);
 
-// Error handling
-static void add_semantic_error(const char* format, ...);
-static void print_semantic_errors(void);
-
 #endif // SEMANTIC_H
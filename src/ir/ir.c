@@ -16,6 +16,7 @@ IRModule* ir_module_create(const char* name) {
     
     module->name = my_strdup(name);
     module->functions = NULL;
+    module->last_function = NULL;
     module->globals = NULL;
     module->global_count = 0;
     module->string_constants = NULL;
@@ -57,6 +58,19 @@ void ir_module_destroy(IRModule* module) {
     free(module);
 }
 
+// Append function to module
+void ir_module_add_function(IRModule* module, IRFunction* function) {
+    if (!module || !function) return;
+    
+    function->next = NULL;
+    if (module->last_function) {
+        module->last_function->next = function;
+    } else {
+        module->functions = function;
+    }
+    module->last_function = function;
+}
+
 // Create IR function
 IRFunction* ir_function_create(const char* name) {
     IRFunction* function = malloc(sizeof(IRFunction));
@@ -68,7 +82,9 @@ IRFunction* ir_function_create(const char* name) {
     function->return_type = NULL;
     function->entry_block = NULL;
     function->blocks = NULL;
+    function->last_block = NULL;
     function->next_register_id = 1;
+    function->always_inline = false;
     function->next = NULL;
     
     return function;
@@ -101,6 +117,61 @@ void ir_function_destroy(IRFunction* function) {
     free(function);
 }
 
+// Append parameter (the function takes ownership)
+void ir_function_add_parameter(IRFunction* function, IRValue* param) {
+    if (!function || !param) return;
+    
+    IRValue** parameters = realloc(function->parameters,
+                                   (function->parameter_count + 1) * sizeof(IRValue*));
+    if (!parameters) return;
+    
+    function->parameters = parameters;
+    function->parameters[function->parameter_count++] = param;
+}
+
+// Append basic block; the first block becomes the entry block
+void ir_function_add_block(IRFunction* function, IRBasicBlock* block) {
+    if (!function || !block) return;
+    
+    if (function->last_block) {
+        function->last_block->next = block;
+    } else {
+        function->blocks = block;
+    }
+    function->last_block = block;
+    block->next = NULL;
+    
+    if (!function->entry_block) {
+        function->entry_block = block;
+    }
+}
+
+static IRBasicBlock* function_block(IRFunction* function, const IRValue* label) {
+    if (!label || label->type != IR_VALUE_LABEL || !label->label) return NULL;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        if (block->label && strcmp(block->label, label->label) == 0) return block;
+    }
+    return NULL;
+}
+
+// Redo the block edges from the terminators, after a pass rewrote control flow
+void ir_function_rebuild_edges(IRFunction* function) {
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        block->successor_count = 0;
+        block->predecessor_count = 0;
+    }
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        IRInstruction* last = block->last_instruction;
+        if (!last) continue;
+        if (last->opcode == IR_JUMP) {
+            ir_basic_block_add_edge(block, function_block(function, last->src1));
+        } else if (last->opcode == IR_BRANCH) {
+            ir_basic_block_add_edge(block, function_block(function, last->src2));
+            ir_basic_block_add_edge(block, function_block(function, last->src3));
+        }
+    }
+}
+
 // Create basic block
 IRBasicBlock* ir_basic_block_create(const char* label) {
     IRBasicBlock* block = malloc(sizeof(IRBasicBlock));
@@ -137,6 +208,54 @@ void ir_basic_block_destroy(IRBasicBlock* block) {
     free(block);
 }
 
+// Append instruction to block
+void ir_basic_block_add_instruction(IRBasicBlock* block, IRInstruction* instruction) {
+    if (!block || !instruction) return;
+    
+    instruction->next = NULL;
+    if (block->last_instruction) {
+        block->last_instruction->next = instruction;
+    } else {
+        block->instructions = instruction;
+    }
+    block->last_instruction = instruction;
+}
+
+static bool block_list_append(IRBasicBlock*** list, int* count, IRBasicBlock* block) {
+    for (int i = 0; i < *count; i++) {
+        if ((*list)[i] == block) return true;
+    }
+    
+    IRBasicBlock** grown = realloc(*list, (*count + 1) * sizeof(IRBasicBlock*));
+    if (!grown) return false;
+    
+    *list = grown;
+    (*list)[(*count)++] = block;
+    return true;
+}
+
+// Record control-flow edge from -> to
+void ir_basic_block_add_edge(IRBasicBlock* from, IRBasicBlock* to) {
+    if (!from || !to) return;
+    
+    block_list_append(&from->successors, &from->successor_count, to);
+    block_list_append(&to->predecessors, &to->predecessor_count, from);
+}
+
+// True if the block already ends in a jump, branch or return
+bool ir_basic_block_is_terminated(IRBasicBlock* block) {
+    if (!block || !block->last_instruction) return false;
+    
+    switch (block->last_instruction->opcode) {
+        case IR_JUMP:
+        case IR_BRANCH:
+        case IR_RETURN:
+            return true;
+        default:
+            return false;
+    }
+}
+
 // Create instruction
 IRInstruction* ir_instruction_create(IROpcode opcode) {
     IRInstruction* instruction = malloc(sizeof(IRInstruction));
@@ -147,6 +266,8 @@ IRInstruction* ir_instruction_create(IROpcode opcode) {
     instruction->src1 = NULL;
     instruction->src2 = NULL;
     instruction->src3 = NULL;
+    instruction->args = NULL;
+    instruction->arg_count = 0;
     instruction->line_number = 0;
     instruction->comment = NULL;
     instruction->next = NULL;
@@ -162,10 +283,52 @@ void ir_instruction_destroy(IRInstruction* instruction) {
     if (instruction->src1) ir_value_destroy(instruction->src1);
     if (instruction->src2) ir_value_destroy(instruction->src2);
     if (instruction->src3) ir_value_destroy(instruction->src3);
+    for (int i = 0; i < instruction->arg_count; i++) {
+        ir_value_destroy(instruction->args[i]);
+    }
+    free(instruction->args);
     free(instruction->comment);
     free(instruction);
 }
 
+// Set destination (the instruction takes ownership)
+void ir_instruction_set_dest(IRInstruction* instruction, IRValue* dest) {
+    if (!instruction) return;
+    
+    if (instruction->dest) ir_value_destroy(instruction->dest);
+    instruction->dest = dest;
+}
+
+// Set source operand 1-3 (the instruction takes ownership)
+void ir_instruction_set_src(IRInstruction* instruction, int index, IRValue* src) {
+    if (!instruction) return;
+    
+    IRValue** slot;
+    switch (index) {
+        case 1: slot = &instruction->src1; break;
+        case 2: slot = &instruction->src2; break;
+        case 3: slot = &instruction->src3; break;
+        default: return;
+    }
+    
+    if (*slot) ir_value_destroy(*slot);
+    *slot = src;
+}
+
+// Append call argument (the instruction takes ownership)
+void ir_instruction_add_arg(IRInstruction* instruction, IRValue* arg) {
+    if (!instruction || !arg) return;
+    
+    IRValue** args = realloc(instruction->args, (instruction->arg_count + 1) * sizeof(IRValue*));
+    if (!args) {
+        ir_value_destroy(arg);
+        return;
+    }
+    
+    instruction->args = args;
+    instruction->args[instruction->arg_count++] = arg;
+}
+
 // Create register value
 IRValue* ir_value_create_register(int reg_id) {
     IRValue* value = malloc(sizeof(IRValue));
@@ -201,6 +364,64 @@ IRValue* ir_value_create_constant_string(const char* string_val) {
     return value;
 }
 
+// Create constant float value
+IRValue* ir_value_create_constant_float(double float_val) {
+    IRValue* value = malloc(sizeof(IRValue));
+    if (!value) return NULL;
+    
+    value->type = IR_VALUE_CONSTANT;
+    value->constant.const_type = IR_CONST_FLOAT_VAL;
+    value->constant.float_val = float_val;
+    
+    return value;
+}
+
+// Create label reference
+IRValue* ir_value_create_label(const char* label) {
+    IRValue* value = malloc(sizeof(IRValue));
+    if (!value) return NULL;
+    
+    value->type = IR_VALUE_LABEL;
+    value->label = my_strdup(label);
+    
+    return value;
+}
+
+// Create global reference
+IRValue* ir_value_create_global(const char* name) {
+    IRValue* value = malloc(sizeof(IRValue));
+    if (!value) return NULL;
+    
+    value->type = IR_VALUE_GLOBAL;
+    value->global_name = my_strdup(name);
+    
+    return value;
+}
+
+// Deep copy of a value
+IRValue* ir_value_clone(const IRValue* value) {
+    if (!value) return NULL;
+    
+    switch (value->type) {
+        case IR_VALUE_REGISTER:
+            return ir_value_create_register(value->reg_id);
+        case IR_VALUE_LABEL:
+            return ir_value_create_label(value->label);
+        case IR_VALUE_GLOBAL:
+            return ir_value_create_global(value->global_name);
+        case IR_VALUE_CONSTANT:
+            switch (value->constant.const_type) {
+                case IR_CONST_INT_VAL:
+                    return ir_value_create_constant_int(value->constant.int_val);
+                case IR_CONST_FLOAT_VAL:
+                    return ir_value_create_constant_float(value->constant.float_val);
+                case IR_CONST_STRING_VAL:
+                    return ir_value_create_constant_string(value->constant.string_val);
+            }
+    }
+    return NULL;
+}
+
 // Destroy value
 void ir_value_destroy(IRValue* value) {
     if (!value) return;
@@ -262,10 +483,43 @@ const char* ir_opcode_to_string(IROpcode opcode) {
         case IR_NOP: return "nop";
         case IR_LABEL: return "label";
         case IR_PHI: return "phi";
+        case IR_VEC_SPLAT: return "vec_splat";
+        case IR_VEC_IOTA: return "vec_iota";
+        case IR_VEC_ADD: return "vec_add";
+        case IR_VEC_SUB: return "vec_sub";
+        case IR_VEC_MUL: return "vec_mul";
+        case IR_VEC_REDUCE_ADD: return "vec_reduce_add";
         default: return "unknown";
     }
 }
 
+// Jump, branch or return: ends a basic block
+bool ir_opcode_is_terminator(IROpcode opcode) {
+    return opcode == IR_JUMP || opcode == IR_BRANCH || opcode == IR_RETURN;
+}
+
+/*
+ * True if the instruction must stay even when nothing reads its result:
+ * memory writes, calls, I/O, control flow and anything not known to be
+ * a plain computation
+ */
+bool ir_opcode_has_side_effects(IROpcode opcode) {
+    switch (opcode) {
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+        case IR_AND: case IR_OR: case IR_NOT:
+        case IR_LOAD: case IR_ALLOCA:
+        case IR_CONST_INT: case IR_CONST_FLOAT: case IR_CONST_STRING:
+        case IR_CAST: case IR_TYPEOF:
+        case IR_NOP: case IR_PHI:
+        case IR_VEC_SPLAT: case IR_VEC_IOTA: case IR_VEC_ADD: case IR_VEC_SUB: case IR_VEC_MUL:
+        case IR_VEC_REDUCE_ADD:
+            return false;
+        default:
+            return true;
+    }
+}
+
 // Print IR module
 void ir_module_print(IRModule* module, FILE* output) {
     if (!module || !output) return;
@@ -282,7 +536,7 @@ void ir_module_print(IRModule* module, FILE* output) {
     // Print functions
     IRFunction* function = module->functions;
     while (function) {
-        fprintf(output, "func_begin @%s\n", function->name);
+        fprintf(output, "func_begin @%s%s\n", function->name, function->always_inline ? " inline" : "");
         
         IRBasicBlock* block = function->blocks;
         while (block) {
@@ -312,19 +566,22 @@ void ir_instruction_print(IRInstruction* instruction, FILE* output) {
     
     fprintf(output, "%s", ir_opcode_to_string(instruction->opcode));
     
-    if (instruction->dest) {
-        fprintf(output, " ");
-        ir_value_print(instruction->dest, output);
-    }
-    
-    if (instruction->src1) {
-        fprintf(output, ", ");
-        ir_value_print(instruction->src1, output);
+    IRValue* operands[4] = { instruction->dest, instruction->src1, instruction->src2, instruction->src3 };
+    const char* separator = " ";
+    for (int i = 0; i < 4; i++) {
+        if (!operands[i]) continue;
+        fprintf(output, "%s", separator);
+        ir_value_print(operands[i], output);
+        separator = ", ";
     }
     
-    if (instruction->src2) {
-        fprintf(output, ", ");
-        ir_value_print(instruction->src2, output);
+    if (instruction->args) {
+        fprintf(output, "(");
+        for (int i = 0; i < instruction->arg_count; i++) {
+            if (i > 0) fprintf(output, ", ");
+            ir_value_print(instruction->args[i], output);
+        }
+        fprintf(output, ")");
     }
     
     if (instruction->comment) {
@@ -361,3 +618,198 @@ void ir_value_print(IRValue* value, FILE* output) {
             break;
     }
 }
+
+// Create builder
+IRBuilder* ir_builder_create(IRModule* module) {
+    IRBuilder* builder = calloc(1, sizeof(IRBuilder));
+    if (!builder) return NULL;
+    
+    builder->module = module;
+    return builder;
+}
+
+void ir_builder_pop_symbols(IRBuilder* builder, int symbol_count) {
+    if (!builder) return;
+    
+    while (builder->symbol_count > symbol_count) {
+        builder->symbol_count--;
+        free(builder->symbols[builder->symbol_count].name);
+        ir_value_destroy(builder->symbols[builder->symbol_count].value);
+    }
+}
+
+static void builder_clear_symbols(IRBuilder* builder) {
+    ir_builder_pop_symbols(builder, 0);
+}
+
+// Destroy builder (the module is not touched)
+void ir_builder_destroy(IRBuilder* builder) {
+    if (!builder) return;
+    
+    builder_clear_symbols(builder);
+    free(builder->symbols);
+    free(builder);
+}
+
+// Switch to function; symbols are per function
+void ir_builder_set_function(IRBuilder* builder, IRFunction* function) {
+    if (!builder) return;
+    
+    builder_clear_symbols(builder);
+    builder->current_function = function;
+    builder->current_block = function ? function->entry_block : NULL;
+    builder->next_block_id = 0;
+}
+
+void ir_builder_set_block(IRBuilder* builder, IRBasicBlock* block) {
+    if (builder) builder->current_block = block;
+}
+
+// Create a block labelled <prefix><n>, unique within the current function
+IRBasicBlock* ir_builder_create_block(IRBuilder* builder, const char* prefix) {
+    if (!builder || !builder->current_function) return NULL;
+    
+    char label[64];
+    snprintf(label, sizeof(label), "%s%d", prefix, builder->next_block_id++);
+    
+    IRBasicBlock* block = ir_basic_block_create(label);
+    ir_function_add_block(builder->current_function, block);
+    return block;
+}
+
+static IRValue* builder_new_register(IRBuilder* builder) {
+    return ir_value_create_register(builder->current_function->next_register_id++);
+}
+
+// Append instruction to the current block; returns its destination
+static IRValue* builder_emit(IRBuilder* builder, IROpcode opcode, bool has_dest,
+                             IRValue* src1, IRValue* src2, IRValue* src3) {
+    if (!builder || !builder->current_block) return NULL;
+    
+    IRInstruction* instruction = ir_instruction_create(opcode);
+    if (!instruction) return NULL;
+    
+    if (has_dest) instruction->dest = builder_new_register(builder);
+    instruction->src1 = src1;
+    instruction->src2 = src2;
+    instruction->src3 = src3;
+    
+    ir_basic_block_add_instruction(builder->current_block, instruction);
+    return instruction->dest;
+}
+
+IRValue* ir_builder_const_int(IRBuilder* builder, long long value) {
+    return builder_emit(builder, IR_CONST_INT, true, ir_value_create_constant_int(value), NULL, NULL);
+}
+
+IRValue* ir_builder_const_float(IRBuilder* builder, double value) {
+    return builder_emit(builder, IR_CONST_FLOAT, true, ir_value_create_constant_float(value), NULL, NULL);
+}
+
+IRValue* ir_builder_const_string(IRBuilder* builder, const char* value) {
+    return builder_emit(builder, IR_CONST_STRING, true, ir_value_create_constant_string(value), NULL, NULL);
+}
+
+IRValue* ir_builder_binary(IRBuilder* builder, IROpcode opcode, IRValue* lhs, IRValue* rhs) {
+    return builder_emit(builder, opcode, true, ir_value_clone(lhs), ir_value_clone(rhs), NULL);
+}
+
+IRValue* ir_builder_unary(IRBuilder* builder, IROpcode opcode, IRValue* operand) {
+    return builder_emit(builder, opcode, true, ir_value_clone(operand), NULL, NULL);
+}
+
+IRValue* ir_builder_add(IRBuilder* builder, IRValue* lhs, IRValue* rhs) {
+    return ir_builder_binary(builder, IR_ADD, lhs, rhs);
+}
+
+IRValue* ir_builder_sub(IRBuilder* builder, IRValue* lhs, IRValue* rhs) {
+    return ir_builder_binary(builder, IR_SUB, lhs, rhs);
+}
+
+IRValue* ir_builder_mul(IRBuilder* builder, IRValue* lhs, IRValue* rhs) {
+    return ir_builder_binary(builder, IR_MUL, lhs, rhs);
+}
+
+IRValue* ir_builder_div(IRBuilder* builder, IRValue* lhs, IRValue* rhs) {
+    return ir_builder_binary(builder, IR_DIV, lhs, rhs);
+}
+
+// Stack slot for a named local: alloca %ptr, "name"
+IRValue* ir_builder_alloca(IRBuilder* builder, const char* name) {
+    return builder_emit(builder, IR_ALLOCA, true, ir_value_create_constant_string(name), NULL, NULL);
+}
+
+IRValue* ir_builder_load(IRBuilder* builder, IRValue* ptr) {
+    return builder_emit(builder, IR_LOAD, true, ir_value_clone(ptr), NULL, NULL);
+}
+
+// store value, ptr
+void ir_builder_store(IRBuilder* builder, IRValue* value, IRValue* ptr) {
+    builder_emit(builder, IR_STORE, false, ir_value_clone(value), ir_value_clone(ptr), NULL);
+}
+
+// call %result, @name(args...)
+IRValue* ir_builder_call(IRBuilder* builder, const char* function_name, IRValue** args, int arg_count) {
+    IRValue* result = builder_emit(builder, IR_CALL, true, ir_value_create_global(function_name), NULL, NULL);
+    if (!result) return NULL;
+    
+    IRInstruction* call = builder->current_block->last_instruction;
+    for (int i = 0; i < arg_count; i++) {
+        ir_instruction_add_arg(call, ir_value_clone(args[i]));
+    }
+    return result;
+}
+
+void ir_builder_return(IRBuilder* builder, IRValue* value) {
+    builder_emit(builder, IR_RETURN, false, ir_value_clone(value), NULL, NULL);
+}
+
+void ir_builder_print(IRBuilder* builder, IRValue* value) {
+    builder_emit(builder, IR_PRINT, false, ir_value_clone(value), NULL, NULL);
+}
+
+void ir_builder_jump(IRBuilder* builder, IRBasicBlock* target) {
+    if (!builder || !builder->current_block || !target) return;
+    
+    ir_basic_block_add_edge(builder->current_block, target);
+    builder_emit(builder, IR_JUMP, false, ir_value_create_label(target->label), NULL, NULL);
+}
+
+// branch cond, then_label, else_label
+void ir_builder_branch(IRBuilder* builder, IRValue* condition, IRBasicBlock* then_block, IRBasicBlock* else_block) {
+    if (!builder || !builder->current_block || !then_block || !else_block) return;
+    
+    ir_basic_block_add_edge(builder->current_block, then_block);
+    ir_basic_block_add_edge(builder->current_block, else_block);
+    builder_emit(builder, IR_BRANCH, false, ir_value_clone(condition),
+                 ir_value_create_label(then_block->label),
+                 ir_value_create_label(else_block->label));
+}
+
+// Bind name to a copy of value
+void ir_builder_add_symbol(IRBuilder* builder, const char* name, IRValue* value) {
+    if (!builder || !name || !value) return;
+    
+    if (builder->symbol_count >= builder->symbol_capacity) {
+        int capacity = builder->symbol_capacity ? builder->symbol_capacity * 2 : 16;
+        void* grown = realloc(builder->symbols, capacity * sizeof(*builder->symbols));
+        if (!grown) return;
+        builder->symbols = grown;
+        builder->symbol_capacity = capacity;
+    }
+    
+    builder->symbols[builder->symbol_count].name = my_strdup(name);
+    builder->symbols[builder->symbol_count].value = ir_value_clone(value);
+    builder->symbol_count++;
+}
+
+IRValue* ir_builder_get_symbol(IRBuilder* builder, const char* name) {
+    if (!builder || !name) return NULL;
+    
+    for (int i = builder->symbol_count - 1; i >= 0; i--) {
+        if (strcmp(builder->symbols[i].name, name) == 0) {
+            return builder->symbols[i].value;
+        }
+    }
+    return NULL;
+}
@@ -5,6 +5,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+// Binary module format written by ir_module_save (see ir_format.c)
+#define IR_FORMAT_MAGIC "GPIR"
+#define IR_FORMAT_VERSION 4
 
 // IR Instruction Types
 typedef enum {
@@ -14,7 +19,9 @@ typedef enum {
     // Comparison operations
     IR_EQ, IR_NE, IR_LT, IR_LE, IR_GT, IR_GE,
     
-    // Logical operations
+    // Logical operations. IR_AND and IR_OR read two values that are
+    // already computed; source and/or is short-circuit control flow and
+    // only becomes these when its right operand is safe to speculate.
     IR_AND, IR_OR, IR_NOT,
     
     // Memory operations
@@ -45,9 +52,18 @@ typedef enum {
     IR_CAST, IR_TYPEOF,
     
     // Special
-    IR_NOP, IR_LABEL, IR_PHI
+    IR_NOP, IR_LABEL, IR_PHI,
+    
+    // Vector operations (from the -O loop vectorizer): IR_VECTOR_LANES
+    // 64-bit integer lanes per value
+    IR_VEC_SPLAT,       // Every lane = src1
+    IR_VEC_IOTA,        // Lane i = src1 + i
+    IR_VEC_ADD, IR_VEC_SUB, IR_VEC_MUL,
+    IR_VEC_REDUCE_ADD   // Scalar sum of the lanes of src1
 } IROpcode;
 
+#define IR_VECTOR_LANES 2
+
 // IR Value types
 typedef enum {
     IR_VALUE_REGISTER,
@@ -82,6 +98,10 @@ typedef struct IRInstruction {
     IRValue* src2;      // Second source operand (can be NULL)
     IRValue* src3;      // Third source operand (can be NULL)
     
+    // Call arguments (IR_CALL / IR_ASYNC_CALL / IR_SPAWN)
+    IRValue** args;
+    int arg_count;
+    
     // Metadata
     int line_number;
     char* comment;
@@ -113,10 +133,13 @@ typedef struct IRFunction {
     
     IRBasicBlock* entry_block;
     IRBasicBlock* blocks;
+    IRBasicBlock* last_block;       // Tail of blocks, for appending
     
     // Register allocation
     int next_register_id;
     
+    bool always_inline;             // Inlined at every call site, whatever its size
+    
     struct IRFunction* next;
 } IRFunction;
 
@@ -124,6 +147,7 @@ typedef struct IRFunction {
 typedef struct IRModule {
     char* name;
     IRFunction* functions;
+    IRFunction* last_function;      // Tail of functions, for appending
     
     // Global variables
     IRValue** globals;
@@ -143,8 +167,9 @@ typedef struct IRBuilder {
     IRModule* module;
     IRFunction* current_function;
     IRBasicBlock* current_block;
+    int next_block_id;      // Suffix for unique block labels
     
-    // Symbol table
+    // Symbol table (searched newest first, so shadowing works)
     struct {
         char* name;
         IRValue* value;
@@ -161,22 +186,38 @@ void ir_module_destroy(IRModule* module);
 void ir_module_print(IRModule* module, FILE* output);
 bool ir_module_save(IRModule* module, const char* filename);
 IRModule* ir_module_load(const char* filename);
+void ir_module_add_function(IRModule* module, IRFunction* function);
+
+// Binary IR files: mapped on open, function sections decoded on demand
+typedef struct IRModuleFile IRModuleFile;
+bool ir_file_is_binary(const char* filename);
+IRModuleFile* ir_file_open(const char* filename);
+void ir_file_close(IRModuleFile* file);
+int ir_file_function_count(const IRModuleFile* file);
+char* ir_file_function_name(const IRModuleFile* file, int index);
+IRFunction* ir_file_load_function(const IRModuleFile* file, int index);
+IRModule* ir_file_load_module(const IRModuleFile* file);
 
 // Function management
 IRFunction* ir_function_create(const char* name);
 void ir_function_destroy(IRFunction* function);
 void ir_function_add_parameter(IRFunction* function, IRValue* param);
+void ir_function_add_block(IRFunction* function, IRBasicBlock* block);
+void ir_function_rebuild_edges(IRFunction* function);
 
 // Basic block management
 IRBasicBlock* ir_basic_block_create(const char* label);
 void ir_basic_block_destroy(IRBasicBlock* block);
 void ir_basic_block_add_instruction(IRBasicBlock* block, IRInstruction* instruction);
+void ir_basic_block_add_edge(IRBasicBlock* from, IRBasicBlock* to);
+bool ir_basic_block_is_terminated(IRBasicBlock* block);
 
 // Instruction creation
 IRInstruction* ir_instruction_create(IROpcode opcode);
 void ir_instruction_destroy(IRInstruction* instruction);
 void ir_instruction_set_dest(IRInstruction* instruction, IRValue* dest);
 void ir_instruction_set_src(IRInstruction* instruction, int index, IRValue* src);
+void ir_instruction_add_arg(IRInstruction* instruction, IRValue* arg);
 
 // Value creation
 IRValue* ir_value_create_register(int reg_id);
@@ -185,6 +226,7 @@ IRValue* ir_value_create_constant_float(double value);
 IRValue* ir_value_create_constant_string(const char* value);
 IRValue* ir_value_create_label(const char* label);
 IRValue* ir_value_create_global(const char* name);
+IRValue* ir_value_clone(const IRValue* value);
 void ir_value_destroy(IRValue* value);
 
 // Builder functions
@@ -194,29 +236,68 @@ void ir_builder_set_function(IRBuilder* builder, IRFunction* function);
 void ir_builder_set_block(IRBuilder* builder, IRBasicBlock* block);
 
 // High-level instruction building
+// Operands are copied into the new instruction; returned registers are
+// owned by the instruction that defines them and stay valid as handles.
+IRBasicBlock* ir_builder_create_block(IRBuilder* builder, const char* prefix);
+IRValue* ir_builder_const_int(IRBuilder* builder, long long value);
+IRValue* ir_builder_const_float(IRBuilder* builder, double value);
+IRValue* ir_builder_const_string(IRBuilder* builder, const char* value);
+IRValue* ir_builder_binary(IRBuilder* builder, IROpcode opcode, IRValue* lhs, IRValue* rhs);
+IRValue* ir_builder_unary(IRBuilder* builder, IROpcode opcode, IRValue* operand);
 IRValue* ir_builder_add(IRBuilder* builder, IRValue* lhs, IRValue* rhs);
 IRValue* ir_builder_sub(IRBuilder* builder, IRValue* lhs, IRValue* rhs);
 IRValue* ir_builder_mul(IRBuilder* builder, IRValue* lhs, IRValue* rhs);
 IRValue* ir_builder_div(IRBuilder* builder, IRValue* lhs, IRValue* rhs);
+IRValue* ir_builder_alloca(IRBuilder* builder, const char* name);
 IRValue* ir_builder_load(IRBuilder* builder, IRValue* ptr);
 void ir_builder_store(IRBuilder* builder, IRValue* value, IRValue* ptr);
-void ir_builder_call(IRBuilder* builder, const char* function_name, IRValue** args, int arg_count);
+IRValue* ir_builder_call(IRBuilder* builder, const char* function_name, IRValue** args, int arg_count);
+void ir_builder_jump(IRBuilder* builder, IRBasicBlock* target);
+void ir_builder_branch(IRBuilder* builder, IRValue* condition, IRBasicBlock* then_block, IRBasicBlock* else_block);
 void ir_builder_return(IRBuilder* builder, IRValue* value);
 void ir_builder_print(IRBuilder* builder, IRValue* value);
 
 // Symbol table
 void ir_builder_add_symbol(IRBuilder* builder, const char* name, IRValue* value);
 IRValue* ir_builder_get_symbol(IRBuilder* builder, const char* name);
+void ir_builder_pop_symbols(IRBuilder* builder, int symbol_count);   // Drop bindings made after symbol_count
 
 // Utility functions
 const char* ir_opcode_to_string(IROpcode opcode);
+bool ir_opcode_is_terminator(IROpcode opcode);
+bool ir_opcode_has_side_effects(IROpcode opcode);
 void ir_value_print(IRValue* value, FILE* output);
 void ir_instruction_print(IRInstruction* instruction, FILE* output);
 
-// Optimization passes
-void ir_optimize_module(IRModule* module);
-void ir_optimize_function(IRFunction* function);
-void ir_dead_code_elimination(IRFunction* function);
-void ir_constant_folding(IRFunction* function);
+// Optimization passes (see ir_optimize.c); stats may be NULL
+#define IR_MAX_PASSES 16
+
+typedef struct {
+    const char* name;
+    int instructions_before;
+    int instructions_after;
+    int changes;            // Locals promoted, values folded, instructions removed...
+} IRPassStats;
+
+// Totals per pipeline stage, summed over every optimized function
+typedef struct {
+    IRPassStats passes[IR_MAX_PASSES];
+    int pass_count;
+} IROptimizeStats;
+
+// Block execution profiles (see ir_profile.c)
+typedef struct IRProfile IRProfile;
+int ir_profile_instrument(IRModule* module);            // Counters added, -1 when out of memory
+IRProfile* ir_profile_load(const char* filename);       // NULL if unreadable or malformed
+void ir_profile_destroy(IRProfile* profile);
+bool ir_profile_block_count(const IRProfile* profile, const char* function, const char* block, long long* count);
+bool ir_profile_function_count(const IRProfile* profile, const IRFunction* function, long long* count);
+int ir_profile_layout(IRFunction* function, const IRProfile* profile);  // Blocks moved
+
+// profile, when given, drives block layout and skips cold functions' loops
+void ir_optimize_module(IRModule* module, const IRProfile* profile, IROptimizeStats* stats);
+void ir_optimize_function(IRFunction* function, IROptimizeStats* stats);
+int ir_dead_code_elimination(IRFunction* function);     // Instructions removed
+int ir_constant_folding(IRFunction* function);          // Values and branches folded
 
 #endif // GPLANG_IR_H
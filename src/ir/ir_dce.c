@@ -0,0 +1,113 @@
+/*
+ * GPLANG Dead Code Elimination
+ * Mark-and-sweep over the flat IR: everything with a side effect is a
+ * root, operands of live instructions are live, the rest is removed.
+ * Blocks unreachable from the entry and code after a block's terminator
+ * go too.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+
+// Blocks reachable from the entry (iterative DFS)
+static bool find_reachable(const IRFlatFunction* flat, bool* reachable) {
+    uint32_t* stack = malloc(flat->block_count * sizeof(uint32_t));
+    if (!stack) return false;
+
+    uint32_t depth = 0;
+    reachable[0] = true;
+    stack[depth++] = 0;
+    while (depth > 0) {
+        const IRFlatBlock* block = &flat->blocks[stack[--depth]];
+        for (uint32_t s = 0; s < block->succ_count; s++) {
+            uint32_t succ = flat->edges[block->first_succ + s];
+            if (succ < flat->block_count && !reachable[succ]) {
+                reachable[succ] = true;
+                stack[depth++] = succ;
+            }
+        }
+    }
+
+    free(stack);
+    return true;
+}
+
+static void mark_operand(const IRFlatFunction* flat, const uint32_t* def_inst, IRFlatOperand operand,
+                         bool* live, uint32_t* worklist, uint32_t* count) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG) return;
+
+    uint32_t reg = ir_flat_payload(operand);
+    if (reg >= (uint32_t)flat->next_register_id) return;
+
+    uint32_t def = def_inst[reg];
+    if (def != IR_DOM_NONE && !live[def]) {
+        live[def] = true;
+        worklist[(*count)++] = def;
+    }
+}
+
+int ir_pass_dce(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    uint32_t reg_count = (uint32_t)flat->next_register_id;
+    bool* reachable = calloc(flat->block_count, sizeof(bool));
+    bool* live = calloc(flat->inst_count ? flat->inst_count : 1, sizeof(bool));
+    uint32_t* def_inst = malloc((reg_count ? reg_count : 1) * sizeof(uint32_t));
+    uint32_t* worklist = malloc((flat->inst_count ? flat->inst_count : 1) * sizeof(uint32_t));
+    int removed = -1;
+
+    if (reachable && live && def_inst && worklist && find_reachable(flat, reachable)) {
+        for (uint32_t r = 0; r < reg_count; r++) def_inst[r] = IR_DOM_NONE;
+
+        // Roots: side effects and the first terminator of each reachable block
+        uint32_t count = 0;
+        for (uint32_t b = 0; b < flat->block_count; b++) {
+            if (!reachable[b]) continue;
+
+            const IRFlatBlock* block = &flat->blocks[b];
+            for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+                const IRFlatInst* inst = &flat->insts[i];
+                if (ir_flat_kind(inst->dest) == IR_FLAT_REG && ir_flat_payload(inst->dest) < reg_count) {
+                    def_inst[ir_flat_payload(inst->dest)] = i;
+                }
+                if (ir_opcode_has_side_effects(inst->opcode)) {
+                    live[i] = true;
+                    worklist[count++] = i;
+                }
+                if (ir_opcode_is_terminator(inst->opcode)) break;
+            }
+        }
+
+        while (count > 0) {
+            const IRFlatInst* inst = &flat->insts[worklist[--count]];
+            for (int o = 0; o < 3; o++) mark_operand(flat, def_inst, inst->src[o], live, worklist, &count);
+            for (uint32_t a = 0; a < inst->arg_count; a++) {
+                mark_operand(flat, def_inst, flat->args[inst->first_arg + a], live, worklist, &count);
+            }
+        }
+
+        removed = 0;
+        for (uint32_t i = 0; i < flat->inst_count; i++) {
+            if (!live[i]) removed++;
+        }
+        // Flip both marks in place into what ir_flat_compact drops
+        bool* dead_blocks = reachable;
+        bool any_dead_block = false;
+        for (uint32_t b = 0; b < flat->block_count; b++) {
+            dead_blocks[b] = !reachable[b];
+            any_dead_block |= dead_blocks[b];
+        }
+        bool* dead_insts = live;
+        for (uint32_t i = 0; i < flat->inst_count; i++) dead_insts[i] = !live[i];
+
+        if ((removed > 0 || any_dead_block) && !ir_flat_compact(flat, dead_insts, dead_blocks)) removed = -1;
+    }
+
+    free(reachable);
+    free(live);
+    free(def_inst);
+    free(worklist);
+    return removed;
+}
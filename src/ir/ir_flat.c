@@ -0,0 +1,686 @@
+/*
+ * GPLANG Flat IR
+ * Conversion between linked and flat IR, operand pools and printing
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_flat.h"
+
+// Use strdup from ir.c
+extern char* my_strdup(const char* s);
+
+/*
+ * Block lookup during conversion: open-addressing table mapping both
+ * block pointers and block labels to block indices
+ */
+typedef struct {
+    const IRBasicBlock** by_pointer;
+    uint32_t* pointer_index;    // Block index for each by_pointer slot
+    uint32_t* by_label;         // Block index + 1, 0 = empty
+    const IRBasicBlock** blocks;
+    uint32_t mask;
+} BlockMap;
+
+static uint32_t hash_pointer(const void* pointer) {
+    return (uint32_t)(((uintptr_t)pointer * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static uint32_t hash_label(const char* label) {
+    uint32_t hash = 2166136261u;
+    for (; *label; label++) {
+        hash = (hash ^ (unsigned char)*label) * 16777619u;
+    }
+    return hash;
+}
+
+static bool block_map_init(BlockMap* map, const IRFunction* function, uint32_t block_count) {
+    uint32_t size = 16;
+    while (size < block_count * 2) size *= 2;
+
+    map->mask = size - 1;
+    map->by_pointer = calloc(size, sizeof(IRBasicBlock*));
+    map->pointer_index = calloc(size, sizeof(uint32_t));
+    map->by_label = calloc(size, sizeof(uint32_t));
+    map->blocks = calloc(block_count ? block_count : 1, sizeof(IRBasicBlock*));
+    if (!map->by_pointer || !map->pointer_index || !map->by_label || !map->blocks) return false;
+
+    uint32_t index = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next, index++) {
+        map->blocks[index] = block;
+
+        uint32_t slot = hash_pointer(block) & map->mask;
+        while (map->by_pointer[slot]) slot = (slot + 1) & map->mask;
+        map->by_pointer[slot] = block;
+        map->pointer_index[slot] = index;
+
+        if (block->label) {
+            slot = hash_label(block->label) & map->mask;
+            while (map->by_label[slot]) slot = (slot + 1) & map->mask;
+            map->by_label[slot] = index + 1;
+        }
+    }
+    return true;
+}
+
+static void block_map_free(BlockMap* map) {
+    free(map->by_pointer);
+    free(map->pointer_index);
+    free(map->by_label);
+    free(map->blocks);
+}
+
+static int64_t block_map_index(const BlockMap* map, const IRBasicBlock* block) {
+    uint32_t slot = hash_pointer(block) & map->mask;
+    while (map->by_pointer[slot]) {
+        if (map->by_pointer[slot] == block) return map->pointer_index[slot];
+        slot = (slot + 1) & map->mask;
+    }
+    return -1;
+}
+
+static int64_t block_map_label(const BlockMap* map, const char* label) {
+    if (!label) return -1;
+
+    uint32_t slot = hash_label(label) & map->mask;
+    while (map->by_label[slot]) {
+        uint32_t index = map->by_label[slot] - 1;
+        if (map->blocks[index]->label && strcmp(map->blocks[index]->label, label) == 0) return index;
+        slot = (slot + 1) & map->mask;
+    }
+    return -1;
+}
+
+static bool grow(void** data, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+
+    void* grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) return false;
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+uint32_t ir_flat_add_string(IRFlatFunction* flat, const char* string) {
+    if (!string) return IR_FLAT_NO_STRING;
+
+    uint32_t length = (uint32_t)strlen(string) + 1;
+    if (!grow((void**)&flat->strings, &flat->string_capacity, flat->string_size + length, 1)) {
+        return IR_FLAT_NO_STRING;
+    }
+
+    uint32_t offset = flat->string_size;
+    memcpy(flat->strings + offset, string, length);
+    flat->string_size += length;
+    return offset;
+}
+
+const char* ir_flat_string(const IRFlatFunction* flat, uint32_t offset) {
+    if (offset == IR_FLAT_NO_STRING || offset >= flat->string_size) return NULL;
+    return flat->strings + offset;
+}
+
+static uint32_t add_constant(IRFlatFunction* flat, uint64_t bits) {
+    if (!grow((void**)&flat->constants, &flat->constant_capacity, flat->constant_count + 1, sizeof(uint64_t))) {
+        return 0;
+    }
+    flat->constants[flat->constant_count] = bits;
+    return flat->constant_count++;
+}
+
+// Small integers go inline, others into the constant pool
+IRFlatOperand ir_flat_int_operand(IRFlatFunction* flat, long long value) {
+    if (value >= IR_FLAT_IMM_MIN && value <= IR_FLAT_IMM_MAX) {
+        return ir_flat_operand(IR_FLAT_IMM, (uint32_t)value);
+    }
+    return ir_flat_operand(IR_FLAT_INT, add_constant(flat, (uint64_t)value));
+}
+
+IRFlatOperand ir_flat_float_operand(IRFlatFunction* flat, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return ir_flat_operand(IR_FLAT_FLOAT, add_constant(flat, bits));
+}
+
+bool ir_flat_is_int_constant(IRFlatOperand operand) {
+    return ir_flat_kind(operand) == IR_FLAT_IMM || ir_flat_kind(operand) == IR_FLAT_INT;
+}
+
+long long ir_flat_int_value(const IRFlatFunction* flat, IRFlatOperand operand) {
+    if (ir_flat_kind(operand) == IR_FLAT_IMM) return ir_flat_imm(operand);
+    if (ir_flat_kind(operand) == IR_FLAT_INT) return (long long)flat->constants[ir_flat_payload(operand)];
+    return 0;
+}
+
+double ir_flat_float_value(const IRFlatFunction* flat, IRFlatOperand operand) {
+    if (ir_flat_kind(operand) != IR_FLAT_FLOAT) return (double)ir_flat_int_value(flat, operand);
+
+    double value;
+    memcpy(&value, &flat->constants[ir_flat_payload(operand)], sizeof(value));
+    return value;
+}
+
+static IRFlatOperand flatten_value(IRFlatFunction* flat, const BlockMap* map, const IRValue* value, bool* ok) {
+    if (!value) return IR_FLAT_NO_OPERAND;
+
+    switch (value->type) {
+        case IR_VALUE_REGISTER:
+            if ((uint32_t)value->reg_id > IR_FLAT_PAYLOAD_MASK) break;
+            return ir_flat_operand(IR_FLAT_REG, (uint32_t)value->reg_id);
+        case IR_VALUE_CONSTANT:
+            switch (value->constant.const_type) {
+                case IR_CONST_INT_VAL:
+                    return ir_flat_int_operand(flat, value->constant.int_val);
+                case IR_CONST_FLOAT_VAL:
+                    return ir_flat_float_operand(flat, value->constant.float_val);
+                case IR_CONST_STRING_VAL:
+                    return ir_flat_operand(IR_FLAT_STRING, ir_flat_add_string(flat, value->constant.string_val));
+            }
+            break;
+        case IR_VALUE_LABEL: {
+            int64_t index = block_map_label(map, value->label);
+            if (index < 0) break;
+            return ir_flat_operand(IR_FLAT_LABEL, (uint32_t)index);
+        }
+        case IR_VALUE_GLOBAL:
+            return ir_flat_operand(IR_FLAT_GLOBAL, ir_flat_add_string(flat, value->global_name));
+    }
+
+    // Register out of range or label naming no block
+    *ok = false;
+    return IR_FLAT_NO_OPERAND;
+}
+
+/*
+ * Linked -> flat. Returns NULL if the function cannot be represented
+ * (a jump to a label that names no block of the function).
+ */
+IRFlatFunction* ir_flat_from_function(const IRFunction* function) {
+    if (!function) return NULL;
+
+    IRFlatFunction* flat = calloc(1, sizeof(IRFlatFunction));
+    if (!flat) return NULL;
+
+    flat->name = my_strdup(function->name);
+    flat->next_register_id = function->next_register_id;
+
+    // Exact sizes up front: one allocation per array
+    uint32_t block_count = 0, inst_count = 0, arg_count = 0, edge_count = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        block_count++;
+        edge_count += block->successor_count + block->predecessor_count;
+        for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            inst_count++;
+            arg_count += inst->arg_count;
+        }
+    }
+
+    BlockMap map = { 0 };
+    bool ok = block_map_init(&map, function, block_count);
+
+    flat->blocks = calloc(block_count ? block_count : 1, sizeof(IRFlatBlock));
+    flat->insts = calloc(inst_count ? inst_count : 1, sizeof(IRFlatInst));
+    flat->args = calloc(arg_count ? arg_count : 1, sizeof(IRFlatOperand));
+    flat->edges = calloc(edge_count ? edge_count : 1, sizeof(uint32_t));
+    flat->params = calloc(function->parameter_count ? function->parameter_count : 1, sizeof(IRFlatOperand));
+    ok = ok && flat->blocks && flat->insts && flat->args && flat->edges && flat->params;
+    if (ok) {
+        flat->inst_capacity = inst_count;
+        flat->arg_capacity = arg_count;
+    }
+
+    for (int i = 0; ok && i < function->parameter_count; i++) {
+        flat->params[flat->param_count++] = flatten_value(flat, &map, function->parameters[i], &ok);
+    }
+    if (ok) flat->return_type = flatten_value(flat, &map, function->return_type, &ok);
+
+    for (IRBasicBlock* block = function->blocks; ok && block; block = block->next) {
+        IRFlatBlock* fb = &flat->blocks[flat->block_count++];
+        fb->label = ir_flat_add_string(flat, block->label);
+        fb->first_inst = flat->inst_count;
+
+        for (IRInstruction* inst = block->instructions; ok && inst; inst = inst->next) {
+            IRFlatInst* fi = &flat->insts[flat->inst_count++];
+            fi->opcode = inst->opcode;
+            fi->dest = flatten_value(flat, &map, inst->dest, &ok);
+            fi->src[0] = flatten_value(flat, &map, inst->src1, &ok);
+            fi->src[1] = flatten_value(flat, &map, inst->src2, &ok);
+            fi->src[2] = flatten_value(flat, &map, inst->src3, &ok);
+            fi->first_arg = flat->arg_count;
+            fi->arg_count = (uint32_t)inst->arg_count;
+            for (int a = 0; a < inst->arg_count; a++) {
+                flat->args[flat->arg_count++] = flatten_value(flat, &map, inst->args[a], &ok);
+            }
+            fi->comment = ir_flat_add_string(flat, inst->comment);
+            fi->line_number = inst->line_number;
+        }
+        fb->inst_count = flat->inst_count - fb->first_inst;
+
+        fb->first_succ = flat->edge_count;
+        for (int s = 0; ok && s < block->successor_count; s++) {
+            int64_t index = block_map_index(&map, block->successors[s]);
+            if (index < 0) ok = false;
+            else flat->edges[flat->edge_count++] = (uint32_t)index;
+        }
+        fb->succ_count = flat->edge_count - fb->first_succ;
+
+        fb->first_pred = flat->edge_count;
+        for (int p = 0; ok && p < block->predecessor_count; p++) {
+            int64_t index = block_map_index(&map, block->predecessors[p]);
+            if (index < 0) ok = false;
+            else flat->edges[flat->edge_count++] = (uint32_t)index;
+        }
+        fb->pred_count = flat->edge_count - fb->first_pred;
+    }
+
+    block_map_free(&map);
+    if (!ok) {
+        ir_flat_destroy(flat);
+        return NULL;
+    }
+    return flat;
+}
+
+static IRValue* unflatten_value(const IRFlatFunction* flat, IRFlatOperand operand) {
+    uint32_t payload = ir_flat_payload(operand);
+
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_NONE:
+            return NULL;
+        case IR_FLAT_REG:
+            return ir_value_create_register((int)payload);
+        case IR_FLAT_IMM:
+        case IR_FLAT_INT:
+            return ir_value_create_constant_int(ir_flat_int_value(flat, operand));
+        case IR_FLAT_FLOAT:
+            return ir_value_create_constant_float(ir_flat_float_value(flat, operand));
+        case IR_FLAT_STRING:
+            return ir_value_create_constant_string(ir_flat_string(flat, payload));
+        case IR_FLAT_LABEL:
+            return ir_value_create_label(payload < flat->block_count
+                                         ? ir_flat_string(flat, flat->blocks[payload].label) : NULL);
+        case IR_FLAT_GLOBAL:
+            return ir_value_create_global(ir_flat_string(flat, payload));
+    }
+    return NULL;
+}
+
+/*
+ * Flat -> linked, for passes and backends that still walk IRFunction
+ */
+IRFunction* ir_flat_to_function(const IRFlatFunction* flat) {
+    if (!flat) return NULL;
+
+    IRFunction* function = ir_function_create(flat->name);
+    if (!function) return NULL;
+
+    function->next_register_id = flat->next_register_id;
+    for (uint32_t i = 0; i < flat->param_count; i++) {
+        ir_function_add_parameter(function, unflatten_value(flat, flat->params[i]));
+    }
+    function->return_type = unflatten_value(flat, flat->return_type);
+
+    IRBasicBlock** blocks = calloc(flat->block_count ? flat->block_count : 1, sizeof(IRBasicBlock*));
+    if (!blocks) {
+        ir_function_destroy(function);
+        return NULL;
+    }
+
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* fb = &flat->blocks[b];
+        IRBasicBlock* block = ir_basic_block_create(ir_flat_string(flat, fb->label));
+        if (!block) break;
+        blocks[b] = block;
+
+        ir_function_add_block(function, block);
+
+        for (uint32_t i = fb->first_inst; i < fb->first_inst + fb->inst_count; i++) {
+            const IRFlatInst* fi = &flat->insts[i];
+            IRInstruction* inst = ir_instruction_create(fi->opcode);
+            if (!inst) break;
+
+            inst->dest = unflatten_value(flat, fi->dest);
+            inst->src1 = unflatten_value(flat, fi->src[0]);
+            inst->src2 = unflatten_value(flat, fi->src[1]);
+            inst->src3 = unflatten_value(flat, fi->src[2]);
+            for (uint32_t a = 0; a < fi->arg_count; a++) {
+                ir_instruction_add_arg(inst, unflatten_value(flat, flat->args[fi->first_arg + a]));
+            }
+            inst->comment = my_strdup(ir_flat_string(flat, fi->comment));
+            inst->line_number = fi->line_number;
+            ir_basic_block_add_instruction(block, inst);
+        }
+    }
+
+    // Successor order matters (branch targets); predecessors follow from it
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* fb = &flat->blocks[b];
+        for (uint32_t s = 0; s < fb->succ_count && blocks[b]; s++) {
+            uint32_t target = flat->edges[fb->first_succ + s];
+            if (target < flat->block_count && blocks[target]) {
+                ir_basic_block_add_edge(blocks[b], blocks[target]);
+            }
+        }
+    }
+
+    free(blocks);
+    return function;
+}
+
+void ir_flat_destroy(IRFlatFunction* flat) {
+    if (!flat) return;
+
+    free(flat->name);
+    free(flat->params);
+    free(flat->blocks);
+    free(flat->insts);
+    free(flat->args);
+    free(flat->edges);
+    free(flat->constants);
+    free(flat->strings);
+    free(flat);
+}
+
+static void print_operand(const IRFlatFunction* flat, IRFlatOperand operand, FILE* output) {
+    uint32_t payload = ir_flat_payload(operand);
+
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_NONE:
+            break;
+        case IR_FLAT_REG:
+            fprintf(output, "%%%u", payload);
+            break;
+        case IR_FLAT_IMM:
+        case IR_FLAT_INT:
+            fprintf(output, "%lld", ir_flat_int_value(flat, operand));
+            break;
+        case IR_FLAT_FLOAT:
+            fprintf(output, "%f", ir_flat_float_value(flat, operand));
+            break;
+        case IR_FLAT_STRING:
+            fprintf(output, "\"%s\"", ir_flat_string(flat, payload));
+            break;
+        case IR_FLAT_LABEL:
+            fprintf(output, "%s", payload < flat->block_count
+                    ? ir_flat_string(flat, flat->blocks[payload].label) : "?");
+            break;
+        case IR_FLAT_GLOBAL:
+            fprintf(output, "@%s", ir_flat_string(flat, payload));
+            break;
+    }
+}
+
+// Same text as ir_module_print produces for the linked function
+void ir_flat_print(const IRFlatFunction* flat, FILE* output) {
+    if (!flat || !output) return;
+
+    fprintf(output, "func_begin @%s\n", flat->name);
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* fb = &flat->blocks[b];
+        const char* label = ir_flat_string(flat, fb->label);
+        if (label) fprintf(output, "%s:\n", label);
+
+        for (uint32_t i = fb->first_inst; i < fb->first_inst + fb->inst_count; i++) {
+            const IRFlatInst* fi = &flat->insts[i];
+            fprintf(output, "    %s", ir_opcode_to_string(fi->opcode));
+
+            IRFlatOperand operands[4] = { fi->dest, fi->src[0], fi->src[1], fi->src[2] };
+            const char* separator = " ";
+            for (int o = 0; o < 4; o++) {
+                if (ir_flat_kind(operands[o]) == IR_FLAT_NONE) continue;
+                fprintf(output, "%s", separator);
+                print_operand(flat, operands[o], output);
+                separator = ", ";
+            }
+
+            if (fi->arg_count) {
+                fprintf(output, "(");
+                for (uint32_t a = 0; a < fi->arg_count; a++) {
+                    if (a > 0) fprintf(output, ", ");
+                    print_operand(flat, flat->args[fi->first_arg + a], output);
+                }
+                fprintf(output, ")");
+            }
+
+            const char* comment = ir_flat_string(flat, fi->comment);
+            if (comment) fprintf(output, " ; %s", comment);
+            fprintf(output, "\n");
+        }
+    }
+    fprintf(output, "func_end\n\n");
+}
+
+/*
+ * Replace function's parameters and blocks with the contents of flat,
+ * keeping the IRFunction itself (and its place in the module) intact.
+ * This is the adapter for running flat passes over a module.
+ */
+bool ir_flat_store(const IRFlatFunction* flat, IRFunction* function) {
+    if (!flat || !function) return false;
+
+    IRFunction* rebuilt = ir_flat_to_function(flat);
+    if (!rebuilt) return false;
+
+    IRValue** parameters = function->parameters;
+    int parameter_count = function->parameter_count;
+    IRValue* return_type = function->return_type;
+    IRBasicBlock* blocks = function->blocks;
+
+    function->parameters = rebuilt->parameters;
+    function->parameter_count = rebuilt->parameter_count;
+    function->return_type = rebuilt->return_type;
+    function->blocks = rebuilt->blocks;
+    function->last_block = rebuilt->last_block;
+    function->entry_block = rebuilt->entry_block;
+    function->next_register_id = rebuilt->next_register_id;
+
+    // The old body is released with the shell
+    rebuilt->parameters = parameters;
+    rebuilt->parameter_count = parameter_count;
+    rebuilt->return_type = return_type;
+    rebuilt->blocks = blocks;
+    ir_function_destroy(rebuilt);
+    return true;
+}
+
+static bool is_predecessor(const IRFlatFunction* flat, const IRFlatBlock* block, uint32_t pred) {
+    for (uint32_t p = 0; p < block->pred_count; p++) {
+        if (flat->edges[block->first_pred + p] == pred) return true;
+    }
+    return false;
+}
+
+// Keep one (value, label) pair per actual predecessor in each PHI
+static void prune_phi_args(IRFlatFunction* flat) {
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            IRFlatInst* inst = &flat->insts[i];
+            if (inst->opcode != IR_PHI) continue;
+
+            IRFlatOperand* args = &flat->args[inst->first_arg];
+            uint32_t kept = 0;
+            for (uint32_t a = 0; a + 1 < inst->arg_count; a += 2) {
+                uint32_t pred = ir_flat_payload(args[a + 1]);
+                bool duplicate = false;
+                for (uint32_t k = 1; k < kept; k += 2) {
+                    if (ir_flat_payload(args[k]) == pred) duplicate = true;
+                }
+                if (duplicate || !is_predecessor(flat, block, pred)) continue;
+
+                args[kept++] = args[a];
+                args[kept++] = args[a + 1];
+            }
+            inst->arg_count = kept;
+        }
+    }
+}
+
+/*
+ * Recompute successor and predecessor lists from the jumps and branches
+ * in each block, after a pass has rewritten control flow
+ */
+bool ir_flat_rebuild_edges(IRFlatFunction* flat) {
+    uint32_t n = flat->block_count;
+    uint32_t* pred_count = calloc(n ? n : 1, sizeof(uint32_t));
+    if (!pred_count) return false;
+
+    uint32_t succ_total = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        uint32_t* edges = NULL;
+        if (pass == 1) {
+            edges = calloc(succ_total ? 2 * succ_total : 1, sizeof(uint32_t));
+            if (!edges) {
+                free(pred_count);
+                return false;
+            }
+            free(flat->edges);
+            flat->edges = edges;
+            flat->edge_count = 2 * succ_total;
+
+            uint32_t offset = succ_total;
+            for (uint32_t b = 0; b < n; b++) {
+                flat->blocks[b].first_pred = offset;
+                flat->blocks[b].pred_count = 0;
+                offset += pred_count[b];
+            }
+        }
+
+        uint32_t next = 0;
+        for (uint32_t b = 0; b < n; b++) {
+            IRFlatBlock* block = &flat->blocks[b];
+            if (pass == 1) block->first_succ = next;
+
+            for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+                const IRFlatInst* inst = &flat->insts[i];
+                if (inst->opcode != IR_JUMP && inst->opcode != IR_BRANCH) continue;
+
+                for (int s = 0; s < 3; s++) {
+                    if (inst->opcode == IR_BRANCH && s == 0) continue;
+                    if (ir_flat_kind(inst->src[s]) != IR_FLAT_LABEL) continue;
+                    uint32_t target = ir_flat_payload(inst->src[s]);
+                    if (target >= n) continue;
+
+                    if (pass == 0) {
+                        succ_total++;
+                        pred_count[target]++;
+                    } else {
+                        flat->edges[next++] = target;
+                        IRFlatBlock* succ = &flat->blocks[target];
+                        flat->edges[succ->first_pred + succ->pred_count++] = b;
+                    }
+                }
+            }
+            if (pass == 1) block->succ_count = next - block->first_succ;
+        }
+    }
+
+    free(pred_count);
+    prune_phi_args(flat);
+    return true;
+}
+
+static IRFlatOperand remap_label(IRFlatOperand operand, const uint32_t* new_index) {
+    if (ir_flat_kind(operand) != IR_FLAT_LABEL) return operand;
+    return ir_flat_operand(IR_FLAT_LABEL, new_index[ir_flat_payload(operand)]);
+}
+
+/*
+ * Drop instructions and whole blocks (either array may be NULL), renumber
+ * the remaining blocks and rebuild the CFG. PHI inputs from removed
+ * predecessors are dropped. Fails without changing anything if the entry
+ * block is removed or a surviving instruction still jumps to a removed block.
+ */
+bool ir_flat_compact(IRFlatFunction* flat, const bool* dead_insts, const bool* dead_blocks) {
+    uint32_t n = flat->block_count;
+    if (n == 0) return true;
+    if (dead_blocks && dead_blocks[0]) return false;
+
+    uint32_t* new_index = malloc(n * sizeof(uint32_t));
+    if (!new_index) return false;
+
+    uint32_t block_count = 0, inst_count = 0, arg_count = 0;
+    bool ok = true;
+    for (uint32_t b = 0; b < n; b++) {
+        bool block_dead = dead_blocks && dead_blocks[b];
+        new_index[b] = block_dead ? IR_FLAT_PAYLOAD_MASK : block_count++;
+        if (block_dead) continue;
+
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            if (dead_insts && dead_insts[i]) continue;
+            inst_count++;
+            arg_count += flat->insts[i].arg_count;
+
+            for (int s = 0; dead_blocks && s < 3; s++) {
+                IRFlatOperand src = flat->insts[i].src[s];
+                if (ir_flat_kind(src) == IR_FLAT_LABEL && ir_flat_payload(src) < n &&
+                    dead_blocks[ir_flat_payload(src)]) {
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    IRFlatBlock* blocks = ok ? calloc(block_count, sizeof(IRFlatBlock)) : NULL;
+    IRFlatInst* insts = ok ? calloc(inst_count ? inst_count : 1, sizeof(IRFlatInst)) : NULL;
+    IRFlatOperand* args = ok ? calloc(arg_count ? arg_count : 1, sizeof(IRFlatOperand)) : NULL;
+    if (!blocks || !insts || !args) {
+        free(new_index);
+        free(blocks);
+        free(insts);
+        free(args);
+        return false;
+    }
+
+    uint32_t next_block = 0, next_inst = 0, next_arg = 0;
+    for (uint32_t b = 0; b < n; b++) {
+        if (dead_blocks && dead_blocks[b]) continue;
+
+        const IRFlatBlock* old_block = &flat->blocks[b];
+        IRFlatBlock* block = &blocks[next_block++];
+        block->label = old_block->label;
+        block->first_inst = next_inst;
+
+        for (uint32_t i = old_block->first_inst; i < old_block->first_inst + old_block->inst_count; i++) {
+            if (dead_insts && dead_insts[i]) continue;
+
+            const IRFlatInst* old_inst = &flat->insts[i];
+            IRFlatInst* inst = &insts[next_inst++];
+            *inst = *old_inst;
+            for (int s = 0; s < 3; s++) inst->src[s] = remap_label(inst->src[s], new_index);
+
+            inst->first_arg = next_arg;
+            for (uint32_t a = 0; a < old_inst->arg_count; a++) {
+                IRFlatOperand arg = flat->args[old_inst->first_arg + a];
+                if (old_inst->opcode == IR_PHI && a % 2 == 0 && a + 1 < old_inst->arg_count) {
+                    IRFlatOperand label = flat->args[old_inst->first_arg + a + 1];
+                    if (ir_flat_kind(label) == IR_FLAT_LABEL && ir_flat_payload(label) < n &&
+                        dead_blocks && dead_blocks[ir_flat_payload(label)]) {
+                        a++;
+                        continue;
+                    }
+                }
+                args[next_arg++] = remap_label(arg, new_index);
+            }
+            inst->arg_count = next_arg - inst->first_arg;
+        }
+        block->inst_count = next_inst - block->first_inst;
+    }
+
+    free(new_index);
+    free(flat->blocks);
+    free(flat->insts);
+    free(flat->args);
+    flat->blocks = blocks;
+    flat->block_count = block_count;
+    flat->insts = insts;
+    flat->inst_count = flat->inst_capacity = inst_count;
+    flat->args = args;
+    flat->arg_count = flat->arg_capacity = arg_count;
+    return ir_flat_rebuild_edges(flat);
+}
@@ -0,0 +1,128 @@
+/*
+ * GPLANG Flat IR
+ * Dense, index-based form of an IRFunction: instructions live in one
+ * array per function, grouped by block, and operands are 32-bit tagged
+ * words. Small integers are stored inline; larger constants, strings
+ * and call arguments live in per-function pools. Passes that walk or
+ * rewrite a whole function use this form; ir_flat_from_function and
+ * ir_flat_to_function convert to and from the linked IR.
+ */
+
+#ifndef GPLANG_IR_FLAT_H
+#define GPLANG_IR_FLAT_H
+
+#include "ir.h"
+
+// Operand: kind in the top 3 bits, payload in the low 29
+typedef uint32_t IRFlatOperand;
+
+typedef enum {
+    IR_FLAT_NONE,       // No operand
+    IR_FLAT_REG,        // Virtual register number
+    IR_FLAT_IMM,        // Signed 29-bit integer, inline
+    IR_FLAT_INT,        // Index into constants (64-bit integer)
+    IR_FLAT_FLOAT,      // Index into constants (double bits)
+    IR_FLAT_STRING,     // Offset into the string pool (string constant)
+    IR_FLAT_LABEL,      // Block index
+    IR_FLAT_GLOBAL      // Offset into the string pool (global name)
+} IRFlatKind;
+
+#define IR_FLAT_PAYLOAD_BITS 29
+#define IR_FLAT_PAYLOAD_MASK ((1u << IR_FLAT_PAYLOAD_BITS) - 1)
+#define IR_FLAT_IMM_MIN (-(1 << (IR_FLAT_PAYLOAD_BITS - 1)))
+#define IR_FLAT_IMM_MAX ((1 << (IR_FLAT_PAYLOAD_BITS - 1)) - 1)
+#define IR_FLAT_NO_OPERAND ((IRFlatOperand)0)
+#define IR_FLAT_NO_STRING 0xFFFFFFFFu
+
+static inline IRFlatOperand ir_flat_operand(IRFlatKind kind, uint32_t payload) {
+    return (IRFlatOperand)kind << IR_FLAT_PAYLOAD_BITS | (payload & IR_FLAT_PAYLOAD_MASK);
+}
+
+static inline IRFlatKind ir_flat_kind(IRFlatOperand operand) {
+    return (IRFlatKind)(operand >> IR_FLAT_PAYLOAD_BITS);
+}
+
+static inline uint32_t ir_flat_payload(IRFlatOperand operand) {
+    return operand & IR_FLAT_PAYLOAD_MASK;
+}
+
+// Sign-extended value of an IR_FLAT_IMM operand
+static inline int32_t ir_flat_imm(IRFlatOperand operand) {
+    return (int32_t)(operand << (32 - IR_FLAT_PAYLOAD_BITS)) >> (32 - IR_FLAT_PAYLOAD_BITS);
+}
+
+typedef struct {
+    IROpcode opcode;
+    IRFlatOperand dest;
+    IRFlatOperand src[3];
+    uint32_t first_arg;     // Call arguments: args[first_arg .. first_arg + arg_count)
+    uint32_t arg_count;
+    uint32_t comment;       // String pool offset or IR_FLAT_NO_STRING
+    int line_number;
+} IRFlatInst;
+
+typedef struct {
+    uint32_t label;         // String pool offset
+    uint32_t first_inst;    // insts[first_inst .. first_inst + inst_count)
+    uint32_t inst_count;
+    uint32_t first_succ;    // edges[first_succ .. first_succ + succ_count)
+    uint32_t succ_count;
+    uint32_t first_pred;    // edges[first_pred .. first_pred + pred_count)
+    uint32_t pred_count;
+} IRFlatBlock;
+
+typedef struct IRFlatFunction {
+    char* name;
+    int next_register_id;
+
+    IRFlatOperand* params;
+    uint32_t param_count;
+    IRFlatOperand return_type;
+
+    IRFlatBlock* blocks;
+    uint32_t block_count;
+
+    IRFlatInst* insts;
+    uint32_t inst_count;
+    uint32_t inst_capacity;
+
+    IRFlatOperand* args;
+    uint32_t arg_count;
+    uint32_t arg_capacity;
+
+    uint32_t* edges;        // Successor and predecessor block indices
+    uint32_t edge_count;
+
+    uint64_t* constants;    // Integer values and double bit patterns
+    uint32_t constant_count;
+    uint32_t constant_capacity;
+
+    char* strings;          // NUL-terminated strings, addressed by offset
+    uint32_t string_size;
+    uint32_t string_capacity;
+} IRFlatFunction;
+
+// Function declarations
+IRFlatFunction* ir_flat_from_function(const IRFunction* function);
+IRFunction* ir_flat_to_function(const IRFlatFunction* flat);
+bool ir_flat_store(const IRFlatFunction* flat, IRFunction* function);  // Rewrite function in place
+void ir_flat_destroy(IRFlatFunction* flat);
+
+// CFG maintenance for passes that rewrite control flow
+bool ir_flat_rebuild_edges(IRFlatFunction* flat);
+bool ir_flat_compact(IRFlatFunction* flat, const bool* dead_insts, const bool* dead_blocks);
+
+// Operand construction (pools grow as needed)
+IRFlatOperand ir_flat_int_operand(IRFlatFunction* flat, long long value);
+IRFlatOperand ir_flat_float_operand(IRFlatFunction* flat, double value);
+uint32_t ir_flat_add_string(IRFlatFunction* flat, const char* string);
+
+// Operand access
+long long ir_flat_int_value(const IRFlatFunction* flat, IRFlatOperand operand);
+double ir_flat_float_value(const IRFlatFunction* flat, IRFlatOperand operand);
+const char* ir_flat_string(const IRFlatFunction* flat, uint32_t offset);
+bool ir_flat_is_int_constant(IRFlatOperand operand);
+
+void ir_flat_print(const IRFlatFunction* flat, FILE* output);
+
+#endif // GPLANG_IR_FLAT_H
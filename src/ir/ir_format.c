@@ -0,0 +1,764 @@
+/*
+ * GPLANG Binary IR Format
+ *
+ * Layout (all fixed-width fields little-endian):
+ *
+ *   header      "GPIR", u32 version, u32 string_count, u32 string_table,
+ *               u32 function_count, u32 function_index, u32 module_section,
+ *               u32 file_size
+ *   functions   one varint-encoded section per function
+ *   module      name/source/target string ids, globals, string constants
+ *   index       per function: u32 name id, u32 section offset, u32 size
+ *   strings     varint length + bytes for every distinct string
+ *
+ * Strings are referenced by id (0 = NULL, n = nth string). Operands are
+ * LEB128 varints, signed constants zigzag encoded. Opening a file maps it
+ * and validates the header and index only; each function section is
+ * decoded when it is first asked for.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ir.h"
+
+#define HEADER_SIZE 32
+#define INDEX_ENTRY_SIZE 12
+
+// Value tags
+enum {
+    TAG_NONE,
+    TAG_REGISTER,
+    TAG_INT,
+    TAG_FLOAT,
+    TAG_STRING,
+    TAG_LABEL,
+    TAG_GLOBAL
+};
+
+// Instruction field-presence bits
+enum {
+    HAS_DEST = 1 << 0,
+    HAS_SRC1 = 1 << 1,
+    HAS_SRC2 = 1 << 2,
+    HAS_SRC3 = 1 << 3,
+    HAS_ARGS = 1 << 4,
+    HAS_COMMENT = 1 << 5,
+    HAS_LINE = 1 << 6
+};
+
+/* ------------------------------------------------------------------ */
+/* Writer                                                              */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} ByteBuffer;
+
+typedef struct {
+    const char** strings;       // Id n is strings[n - 1]
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t* slots;            // Open-addressing table of ids (0 = empty)
+    uint32_t slot_mask;
+} StringTable;
+
+static bool buffer_reserve(ByteBuffer* buffer, size_t extra) {
+    if (buffer->failed) return false;
+    if (buffer->size + extra <= buffer->capacity) return true;
+
+    size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+    while (capacity < buffer->size + extra) capacity *= 2;
+
+    unsigned char* data = realloc(buffer->data, capacity);
+    if (!data) {
+        buffer->failed = true;
+        return false;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static void put_bytes(ByteBuffer* buffer, const void* bytes, size_t length) {
+    if (!buffer_reserve(buffer, length)) return;
+    memcpy(buffer->data + buffer->size, bytes, length);
+    buffer->size += length;
+}
+
+static void put_u8(ByteBuffer* buffer, uint8_t value) {
+    put_bytes(buffer, &value, 1);
+}
+
+static void put_u32(ByteBuffer* buffer, uint32_t value) {
+    unsigned char bytes[4] = { value, value >> 8, value >> 16, value >> 24 };
+    put_bytes(buffer, bytes, 4);
+}
+
+static void patch_u32(ByteBuffer* buffer, size_t offset, uint32_t value) {
+    if (buffer->failed) return;
+    unsigned char* p = buffer->data + offset;
+    p[0] = value; p[1] = value >> 8; p[2] = value >> 16; p[3] = value >> 24;
+}
+
+static void put_varint(ByteBuffer* buffer, uint64_t value) {
+    unsigned char bytes[10];
+    size_t length = 0;
+    do {
+        unsigned char byte = value & 0x7F;
+        value >>= 7;
+        bytes[length++] = byte | (value ? 0x80 : 0);
+    } while (value);
+    put_bytes(buffer, bytes, length);
+}
+
+static uint64_t zigzag_encode(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static uint32_t hash_string(const char* string) {
+    uint32_t hash = 2166136261u;
+    for (; *string; string++) {
+        hash = (hash ^ (unsigned char)*string) * 16777619u;
+    }
+    return hash;
+}
+
+static bool string_table_grow(StringTable* table) {
+    uint32_t slot_count = table->slot_mask ? (table->slot_mask + 1) * 2 : 256;
+    uint32_t* slots = calloc(slot_count, sizeof(uint32_t));
+    const char** strings = realloc(table->strings, (slot_count / 2) * sizeof(char*));
+    if (!slots || !strings) {
+        free(slots);
+        if (strings) table->strings = strings;
+        return false;
+    }
+
+    table->strings = strings;
+    table->capacity = slot_count / 2;
+    free(table->slots);
+    table->slots = slots;
+    table->slot_mask = slot_count - 1;
+
+    for (uint32_t id = 1; id <= table->count; id++) {
+        uint32_t slot = hash_string(table->strings[id - 1]) & table->slot_mask;
+        while (table->slots[slot]) slot = (slot + 1) & table->slot_mask;
+        table->slots[slot] = id;
+    }
+    return true;
+}
+
+// Id of string, adding it on first use; 0 for NULL (or on OOM)
+static uint32_t string_id(StringTable* table, const char* string) {
+    if (!string) return 0;
+    if (table->count >= table->capacity && !string_table_grow(table)) return 0;
+
+    uint32_t slot = hash_string(string) & table->slot_mask;
+    while (table->slots[slot]) {
+        uint32_t id = table->slots[slot];
+        if (strcmp(table->strings[id - 1], string) == 0) return id;
+        slot = (slot + 1) & table->slot_mask;
+    }
+
+    table->strings[table->count++] = string;
+    table->slots[slot] = table->count;
+    return table->count;
+}
+
+static void put_string(ByteBuffer* buffer, StringTable* table, const char* string) {
+    put_varint(buffer, string_id(table, string));
+}
+
+static void put_value(ByteBuffer* buffer, StringTable* table, const IRValue* value) {
+    if (!value) {
+        put_u8(buffer, TAG_NONE);
+        return;
+    }
+
+    switch (value->type) {
+        case IR_VALUE_REGISTER:
+            put_u8(buffer, TAG_REGISTER);
+            put_varint(buffer, (uint32_t)value->reg_id);
+            break;
+        case IR_VALUE_CONSTANT:
+            switch (value->constant.const_type) {
+                case IR_CONST_INT_VAL:
+                    put_u8(buffer, TAG_INT);
+                    put_varint(buffer, zigzag_encode(value->constant.int_val));
+                    break;
+                case IR_CONST_FLOAT_VAL: {
+                    uint64_t bits;
+                    memcpy(&bits, &value->constant.float_val, sizeof(bits));
+                    put_u8(buffer, TAG_FLOAT);
+                    put_u32(buffer, (uint32_t)bits);
+                    put_u32(buffer, (uint32_t)(bits >> 32));
+                    break;
+                }
+                case IR_CONST_STRING_VAL:
+                    put_u8(buffer, TAG_STRING);
+                    put_string(buffer, table, value->constant.string_val);
+                    break;
+            }
+            break;
+        case IR_VALUE_LABEL:
+            put_u8(buffer, TAG_LABEL);
+            put_string(buffer, table, value->label);
+            break;
+        case IR_VALUE_GLOBAL:
+            put_u8(buffer, TAG_GLOBAL);
+            put_string(buffer, table, value->global_name);
+            break;
+    }
+}
+
+static uint32_t block_index(const IRFunction* function, const IRBasicBlock* target) {
+    uint32_t index = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next, index++) {
+        if (block == target) return index;
+    }
+    return 0;
+}
+
+static void put_function(ByteBuffer* buffer, StringTable* table, const IRFunction* function) {
+    put_varint(buffer, (uint32_t)function->next_register_id);
+    put_varint(buffer, function->always_inline ? 1 : 0);
+
+    put_varint(buffer, (uint32_t)function->parameter_count);
+    for (int i = 0; i < function->parameter_count; i++) {
+        put_value(buffer, table, function->parameters[i]);
+    }
+    put_value(buffer, table, function->return_type);
+
+    uint32_t block_count = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) block_count++;
+    put_varint(buffer, block_count);
+
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        put_string(buffer, table, block->label);
+
+        uint32_t instruction_count = 0;
+        for (IRInstruction* inst = block->instructions; inst; inst = inst->next) instruction_count++;
+        put_varint(buffer, instruction_count);
+
+        for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            unsigned flags = (inst->dest ? HAS_DEST : 0) | (inst->src1 ? HAS_SRC1 : 0) |
+                             (inst->src2 ? HAS_SRC2 : 0) | (inst->src3 ? HAS_SRC3 : 0) |
+                             (inst->args ? HAS_ARGS : 0) | (inst->comment ? HAS_COMMENT : 0) |
+                             (inst->line_number ? HAS_LINE : 0);
+            put_varint(buffer, (uint32_t)inst->opcode);
+            put_u8(buffer, (uint8_t)flags);
+
+            if (flags & HAS_DEST) put_value(buffer, table, inst->dest);
+            if (flags & HAS_SRC1) put_value(buffer, table, inst->src1);
+            if (flags & HAS_SRC2) put_value(buffer, table, inst->src2);
+            if (flags & HAS_SRC3) put_value(buffer, table, inst->src3);
+            if (flags & HAS_ARGS) {
+                put_varint(buffer, (uint32_t)inst->arg_count);
+                for (int i = 0; i < inst->arg_count; i++) {
+                    put_value(buffer, table, inst->args[i]);
+                }
+            }
+            if (flags & HAS_COMMENT) put_string(buffer, table, inst->comment);
+            if (flags & HAS_LINE) put_varint(buffer, (uint32_t)inst->line_number);
+        }
+
+        put_varint(buffer, (uint32_t)block->successor_count);
+        for (int i = 0; i < block->successor_count; i++) {
+            put_varint(buffer, block_index(function, block->successors[i]));
+        }
+    }
+}
+
+// Save module in binary form
+bool ir_module_save(IRModule* module, const char* filename) {
+    if (!module || !filename) return false;
+
+    ByteBuffer buffer = { 0 };
+    StringTable table = { 0 };
+
+    put_bytes(&buffer, IR_FORMAT_MAGIC, 4);
+    while (buffer.size < HEADER_SIZE) put_u8(&buffer, 0);
+
+    // Function sections
+    uint32_t function_count = 0;
+    for (IRFunction* function = module->functions; function; function = function->next) function_count++;
+
+    uint32_t* offsets = calloc(function_count ? function_count : 1, 2 * sizeof(uint32_t));
+    if (!offsets) buffer.failed = true;
+
+    uint32_t index = 0;
+    for (IRFunction* function = module->functions; function && !buffer.failed; function = function->next) {
+        offsets[2 * index] = (uint32_t)buffer.size;
+        put_function(&buffer, &table, function);
+        offsets[2 * index + 1] = (uint32_t)buffer.size - offsets[2 * index];
+        index++;
+    }
+
+    // Module section
+    uint32_t module_section = (uint32_t)buffer.size;
+    put_string(&buffer, &table, module->name);
+    put_string(&buffer, &table, module->source_file);
+    put_string(&buffer, &table, module->target_triple);
+    put_varint(&buffer, (uint32_t)module->global_count);
+    for (int i = 0; i < module->global_count; i++) {
+        put_value(&buffer, &table, module->globals[i]);
+    }
+    put_varint(&buffer, (uint32_t)module->string_constant_count);
+    for (int i = 0; i < module->string_constant_count; i++) {
+        put_string(&buffer, &table, module->string_constants[i]);
+    }
+
+    // Function index (fixed width so entries are directly addressable)
+    uint32_t function_index = (uint32_t)buffer.size;
+    index = 0;
+    for (IRFunction* function = module->functions; function && offsets; function = function->next) {
+        put_u32(&buffer, string_id(&table, function->name));
+        put_u32(&buffer, offsets[2 * index]);
+        put_u32(&buffer, offsets[2 * index + 1]);
+        index++;
+    }
+
+    // String table
+    uint32_t string_table = (uint32_t)buffer.size;
+    for (uint32_t id = 1; id <= table.count; id++) {
+        size_t length = strlen(table.strings[id - 1]);
+        put_varint(&buffer, length);
+        put_bytes(&buffer, table.strings[id - 1], length);
+    }
+
+    patch_u32(&buffer, 4, IR_FORMAT_VERSION);
+    patch_u32(&buffer, 8, table.count);
+    patch_u32(&buffer, 12, string_table);
+    patch_u32(&buffer, 16, function_count);
+    patch_u32(&buffer, 20, function_index);
+    patch_u32(&buffer, 24, module_section);
+    patch_u32(&buffer, 28, (uint32_t)buffer.size);
+
+    bool ok = !buffer.failed && buffer.size <= UINT32_MAX;
+    if (ok) {
+        FILE* file = fopen(filename, "wb");
+        ok = file && fwrite(buffer.data, 1, buffer.size, file) == buffer.size;
+        if (file && fclose(file) != 0) ok = false;
+    }
+
+    free(offsets);
+    free(table.strings);
+    free(table.slots);
+    free(buffer.data);
+    return ok;
+}
+
+/* ------------------------------------------------------------------ */
+/* Reader                                                              */
+/* ------------------------------------------------------------------ */
+
+struct IRModuleFile {
+    const unsigned char* data;
+    size_t size;
+
+    uint32_t string_count;
+    const unsigned char** string_data;  // Start of each string's bytes
+    uint32_t* string_lengths;
+
+    uint32_t function_count;
+    const unsigned char* function_index;
+    uint32_t module_section;
+};
+
+// Bounds-checked cursor over one section
+typedef struct {
+    const unsigned char* p;
+    const unsigned char* end;
+    bool failed;
+} Cursor;
+
+static uint32_t load_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint8_t get_u8(Cursor* c) {
+    if (c->p >= c->end) {
+        c->failed = true;
+        return 0;
+    }
+    return *c->p++;
+}
+
+static uint64_t get_varint(Cursor* c) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (c->p >= c->end) break;
+        unsigned char byte = *c->p++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    c->failed = true;
+    return 0;
+}
+
+// Counts are bounded by the bytes left: every element takes at least one
+static uint32_t get_count(Cursor* c) {
+    uint64_t count = get_varint(c);
+    if (count > (uint64_t)(c->end - c->p)) {
+        c->failed = true;
+        return 0;
+    }
+    return (uint32_t)count;
+}
+
+// Heap copy of string id; NULL for id 0
+static char* file_string(const IRModuleFile* file, uint64_t id, bool* failed) {
+    if (id == 0) return NULL;
+    if (id > file->string_count) {
+        *failed = true;
+        return NULL;
+    }
+
+    uint32_t length = file->string_lengths[id - 1];
+    char* string = malloc(length + 1);
+    if (!string) {
+        *failed = true;
+        return NULL;
+    }
+    memcpy(string, file->string_data[id - 1], length);
+    string[length] = '\0';
+    return string;
+}
+
+static char* get_string(const IRModuleFile* file, Cursor* c) {
+    return file_string(file, get_varint(c), &c->failed);
+}
+
+static IRValue* get_value(const IRModuleFile* file, Cursor* c) {
+    IRValue* value = NULL;
+    char* string;
+
+    switch (get_u8(c)) {
+        case TAG_NONE:
+            return NULL;
+        case TAG_REGISTER:
+            value = ir_value_create_register((int)get_varint(c));
+            break;
+        case TAG_INT:
+            value = ir_value_create_constant_int(zigzag_decode(get_varint(c)));
+            break;
+        case TAG_FLOAT: {
+            if (c->end - c->p < 8) {
+                c->failed = true;
+                return NULL;
+            }
+            uint64_t bits = load_u32(c->p) | (uint64_t)load_u32(c->p + 4) << 32;
+            c->p += 8;
+            double float_val;
+            memcpy(&float_val, &bits, sizeof(float_val));
+            value = ir_value_create_constant_float(float_val);
+            break;
+        }
+        case TAG_STRING:
+            string = get_string(file, c);
+            value = ir_value_create_constant_string(string ? string : "");
+            free(string);
+            break;
+        case TAG_LABEL:
+            string = get_string(file, c);
+            value = ir_value_create_label(string);
+            free(string);
+            break;
+        case TAG_GLOBAL:
+            string = get_string(file, c);
+            value = ir_value_create_global(string);
+            free(string);
+            break;
+        default:
+            c->failed = true;
+            return NULL;
+    }
+
+    if (!value) c->failed = true;
+    return value;
+}
+
+// Sniff the magic bytes
+bool ir_file_is_binary(const char* filename) {
+    FILE* file = filename ? fopen(filename, "rb") : NULL;
+    if (!file) return false;
+
+    char magic[4];
+    bool binary = fread(magic, 1, 4, file) == 4 && memcmp(magic, IR_FORMAT_MAGIC, 4) == 0;
+    fclose(file);
+    return binary;
+}
+
+// Map file and validate header, string table and function index
+IRModuleFile* ir_file_open(const char* filename) {
+    if (!filename) return NULL;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < HEADER_SIZE || (uint64_t)st.st_size > UINT32_MAX) {
+        close(fd);
+        return NULL;
+    }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    IRModuleFile* file = calloc(1, sizeof(IRModuleFile));
+    if (!file) {
+        munmap(data, (size_t)st.st_size);
+        return NULL;
+    }
+    file->data = data;
+    file->size = (size_t)st.st_size;
+
+    const unsigned char* header = file->data;
+    uint32_t string_table = load_u32(header + 12);
+    uint32_t function_index = load_u32(header + 20);
+    file->string_count = load_u32(header + 8);
+    file->function_count = load_u32(header + 16);
+    file->module_section = load_u32(header + 24);
+
+    bool valid = memcmp(header, IR_FORMAT_MAGIC, 4) == 0 &&
+                 load_u32(header + 4) == IR_FORMAT_VERSION &&
+                 load_u32(header + 28) == file->size &&
+                 string_table <= file->size &&
+                 file->module_section <= file->size &&
+                 function_index <= file->size &&
+                 file->function_count <= (file->size - function_index) / INDEX_ENTRY_SIZE &&
+                 file->string_count <= file->size - string_table;
+
+    // String table: one pass to find where each string starts
+    if (valid && file->string_count) {
+        file->string_data = malloc(file->string_count * sizeof(unsigned char*));
+        file->string_lengths = malloc(file->string_count * sizeof(uint32_t));
+        valid = file->string_data && file->string_lengths;
+
+        Cursor c = { file->data + string_table, file->data + file->size, false };
+        for (uint32_t i = 0; i < file->string_count && valid; i++) {
+            uint64_t length = get_varint(&c);
+            if (c.failed || length > (uint64_t)(c.end - c.p)) {
+                valid = false;
+                break;
+            }
+            file->string_data[i] = c.p;
+            file->string_lengths[i] = (uint32_t)length;
+            c.p += length;
+        }
+    }
+
+    // Function sections must lie inside the file
+    if (valid) {
+        file->function_index = file->data + function_index;
+        for (uint32_t i = 0; i < file->function_count; i++) {
+            const unsigned char* entry = file->function_index + i * INDEX_ENTRY_SIZE;
+            uint64_t offset = load_u32(entry + 4);
+            uint64_t size = load_u32(entry + 8);
+            if (load_u32(entry) > file->string_count || offset < HEADER_SIZE || offset + size > file->size) {
+                valid = false;
+                break;
+            }
+        }
+    }
+
+    if (!valid) {
+        ir_file_close(file);
+        return NULL;
+    }
+    return file;
+}
+
+void ir_file_close(IRModuleFile* file) {
+    if (!file) return;
+
+    munmap((void*)file->data, file->size);
+    free(file->string_data);
+    free(file->string_lengths);
+    free(file);
+}
+
+int ir_file_function_count(const IRModuleFile* file) {
+    return file ? (int)file->function_count : 0;
+}
+
+// Name of function index (heap copy) without decoding its body
+char* ir_file_function_name(const IRModuleFile* file, int index) {
+    if (!file || index < 0 || (uint32_t)index >= file->function_count) return NULL;
+
+    bool failed = false;
+    return file_string(file, load_u32(file->function_index + index * INDEX_ENTRY_SIZE), &failed);
+}
+
+// Decode one function section; NULL on corrupt data
+IRFunction* ir_file_load_function(const IRModuleFile* file, int index) {
+    if (!file || index < 0 || (uint32_t)index >= file->function_count) return NULL;
+
+    const unsigned char* entry = file->function_index + index * INDEX_ENTRY_SIZE;
+    Cursor c = { file->data + load_u32(entry + 4), file->data + load_u32(entry + 4) + load_u32(entry + 8), false };
+
+    char* name = file_string(file, load_u32(entry), &c.failed);
+    IRFunction* function = ir_function_create(name);
+    free(name);
+    if (!function) return NULL;
+
+    function->next_register_id = (int)get_varint(&c);
+    function->always_inline = get_varint(&c) != 0;
+
+    uint32_t parameter_count = get_count(&c);
+    for (uint32_t i = 0; i < parameter_count && !c.failed; i++) {
+        ir_function_add_parameter(function, get_value(file, &c));
+    }
+    function->return_type = get_value(file, &c);
+
+    uint32_t block_count = get_count(&c);
+    IRBasicBlock** blocks = calloc(block_count ? block_count : 1, sizeof(IRBasicBlock*));
+    if (!blocks) c.failed = true;
+
+    // Edges can point forward; remember them until every block exists
+    uint32_t* edges = NULL;
+    size_t edge_count = 0;
+    size_t edge_capacity = 0;
+
+    for (uint32_t b = 0; b < block_count && !c.failed; b++) {
+        char* label = get_string(file, &c);
+        IRBasicBlock* block = ir_basic_block_create(label);
+        free(label);
+        if (!block) {
+            c.failed = true;
+            break;
+        }
+        ir_function_add_block(function, block);
+        blocks[b] = block;
+
+        uint32_t instruction_count = get_count(&c);
+        for (uint32_t i = 0; i < instruction_count && !c.failed; i++) {
+            uint64_t opcode = get_varint(&c);
+            IRInstruction* inst = opcode <= IR_VEC_REDUCE_ADD ? ir_instruction_create((IROpcode)opcode) : NULL;
+            if (!inst) {
+                c.failed = true;
+                break;
+            }
+            ir_basic_block_add_instruction(block, inst);
+
+            uint8_t flags = get_u8(&c);
+            if (flags & HAS_DEST) inst->dest = get_value(file, &c);
+            if (flags & HAS_SRC1) inst->src1 = get_value(file, &c);
+            if (flags & HAS_SRC2) inst->src2 = get_value(file, &c);
+            if (flags & HAS_SRC3) inst->src3 = get_value(file, &c);
+            if (flags & HAS_ARGS) {
+                uint32_t arg_count = get_count(&c);
+                for (uint32_t a = 0; a < arg_count && !c.failed; a++) {
+                    ir_instruction_add_arg(inst, get_value(file, &c));
+                }
+            }
+            if (flags & HAS_COMMENT) inst->comment = get_string(file, &c);
+            if (flags & HAS_LINE) inst->line_number = (int)get_varint(&c);
+        }
+
+        uint32_t successor_count = get_count(&c);
+        for (uint32_t s = 0; s < successor_count && !c.failed; s++) {
+            uint64_t target = get_varint(&c);
+            if (target >= block_count) {
+                c.failed = true;
+                break;
+            }
+            if (edge_count + 2 > edge_capacity) {
+                edge_capacity = edge_capacity ? edge_capacity * 2 : 32;
+                uint32_t* grown = realloc(edges, edge_capacity * sizeof(uint32_t));
+                if (!grown) {
+                    c.failed = true;
+                    break;
+                }
+                edges = grown;
+            }
+            edges[edge_count++] = b;
+            edges[edge_count++] = (uint32_t)target;
+        }
+    }
+
+    if (!c.failed) {
+        for (size_t e = 0; e < edge_count; e += 2) {
+            ir_basic_block_add_edge(blocks[edges[e]], blocks[edges[e + 1]]);
+        }
+    }
+
+    free(edges);
+    free(blocks);
+
+    if (c.failed || c.p != c.end) {
+        ir_function_destroy(function);
+        return NULL;
+    }
+    return function;
+}
+
+// Decode the module header section and every function
+IRModule* ir_file_load_module(const IRModuleFile* file) {
+    if (!file) return NULL;
+
+    Cursor c = { file->data + file->module_section, file->data + file->size, false };
+
+    char* name = get_string(file, &c);
+    IRModule* module = ir_module_create(name);
+    free(name);
+    if (!module) return NULL;
+
+    module->source_file = get_string(file, &c);
+    module->target_triple = get_string(file, &c);
+
+    uint32_t global_count = get_count(&c);
+    if (global_count) {
+        module->globals = calloc(global_count, sizeof(IRValue*));
+        if (!module->globals) c.failed = true;
+        for (uint32_t i = 0; i < global_count && !c.failed; i++) {
+            module->globals[module->global_count++] = get_value(file, &c);
+        }
+    }
+
+    uint32_t string_count = get_count(&c);
+    if (string_count) {
+        module->string_constants = calloc(string_count, sizeof(char*));
+        if (!module->string_constants) c.failed = true;
+        for (uint32_t i = 0; i < string_count && !c.failed; i++) {
+            module->string_constants[module->string_constant_count++] = get_string(file, &c);
+        }
+    }
+
+    for (uint32_t i = 0; i < file->function_count && !c.failed; i++) {
+        IRFunction* function = ir_file_load_function(file, (int)i);
+        if (!function) {
+            c.failed = true;
+            break;
+        }
+        ir_module_add_function(module, function);
+    }
+
+    if (c.failed) {
+        ir_module_destroy(module);
+        return NULL;
+    }
+    return module;
+}
+
+// Load module saved by ir_module_save; NULL on I/O error or bad data
+IRModule* ir_module_load(const char* filename) {
+    IRModuleFile* file = ir_file_open(filename);
+    if (!file) return NULL;
+
+    IRModule* module = ir_file_load_module(file);
+    ir_file_close(file);
+    return module;
+}
@@ -0,0 +1,333 @@
+/*
+ * GPLANG Global Value Numbering
+ * Dominator-based hash-consing over SSA: walking the dominator tree, a
+ * pure instruction whose (opcode, operands) key is already in scope is
+ * replaced by the earlier value. Operands are looked up through the
+ * replacements made so far, so chains of redundant expressions collapse
+ * in one walk. Scopes are undone on the way back up the tree.
+ *
+ * Loads are keyed on their address the same way, and a store makes its
+ * value the known contents of its address (store-to-load forwarding).
+ * Allocas and globals are distinct objects, so a store to one leaves
+ * what is known about the others; a store anywhere else, a call, or
+ * entering a block with several predecessors forgets all of memory.
+ * Memory facts carry the epoch they were learned in, so forgetting is a
+ * new epoch rather than a sweep of the table.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+
+typedef struct {
+    IROpcode opcode;
+    IRFlatOperand src[3];
+    IRFlatOperand value;
+    uint32_t epoch;             // Memory epoch for loads, 0 for pure expressions
+    bool used;
+} Entry;
+
+typedef struct {
+    uint32_t slot;
+    Entry previous;
+} Undo;
+
+typedef struct {
+    IRFlatFunction* flat;
+    uint32_t reg_count;
+    uint32_t* def_inst;
+    IRFlatOperand* value_of;    // Per register: the value it was replaced by, or NO_OPERAND
+    bool* is_int;
+
+    Entry* table;
+    uint32_t mask;
+    Undo* undo;
+    uint32_t undo_count;
+    uint32_t epoch;
+    uint32_t next_epoch;
+
+    // Pooled operands are not interned: the first operand seen with each
+    // string or constant stands for every equal one
+    IRFlatOperand* pooled;
+    uint32_t pooled_mask;
+} GVN;
+
+static bool pooled_kind(IRFlatKind kind) {
+    return kind == IR_FLAT_INT || kind == IR_FLAT_FLOAT || kind == IR_FLAT_STRING || kind == IR_FLAT_GLOBAL;
+}
+
+static bool same_contents(const IRFlatFunction* flat, IRFlatOperand a, IRFlatOperand b) {
+    if (ir_flat_kind(a) != ir_flat_kind(b)) return false;
+    if (ir_flat_kind(a) == IR_FLAT_INT || ir_flat_kind(a) == IR_FLAT_FLOAT) {
+        return flat->constants[ir_flat_payload(a)] == flat->constants[ir_flat_payload(b)];
+    }
+    return strcmp(ir_flat_string(flat, ir_flat_payload(a)), ir_flat_string(flat, ir_flat_payload(b))) == 0;
+}
+
+static uint32_t hash_contents(const IRFlatFunction* flat, IRFlatOperand operand) {
+    uint64_t hash = 14695981039346656037ull ^ ir_flat_kind(operand);
+    if (ir_flat_kind(operand) == IR_FLAT_INT || ir_flat_kind(operand) == IR_FLAT_FLOAT) {
+        hash = (hash ^ flat->constants[ir_flat_payload(operand)]) * 1099511628211ull;
+    } else {
+        for (const char* c = ir_flat_string(flat, ir_flat_payload(operand)); *c; c++) {
+            hash = (hash ^ (unsigned char)*c) * 1099511628211ull;
+        }
+    }
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static IRFlatOperand canonical(GVN* g, IRFlatOperand operand) {
+    if (!pooled_kind(ir_flat_kind(operand))) return operand;
+
+    uint32_t slot = hash_contents(g->flat, operand) & g->pooled_mask;
+    while (g->pooled[slot] != IR_FLAT_NO_OPERAND) {
+        if (same_contents(g->flat, g->pooled[slot], operand)) return g->pooled[slot];
+        slot = (slot + 1) & g->pooled_mask;
+    }
+    g->pooled[slot] = operand;
+    return operand;
+}
+
+static IRFlatOperand leader(GVN* g, IRFlatOperand operand) {
+    operand = canonical(g, operand);
+    while (ir_flat_kind(operand) == IR_FLAT_REG && ir_flat_payload(operand) < g->reg_count &&
+           g->value_of[ir_flat_payload(operand)] != IR_FLAT_NO_OPERAND) {
+        operand = g->value_of[ir_flat_payload(operand)];
+    }
+    return operand;
+}
+
+// Duplicates of these compute the same value as the first
+static bool is_pure(IROpcode opcode) {
+    switch (opcode) {
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+        case IR_AND: case IR_OR: case IR_NOT:
+        case IR_CONST_INT: case IR_CONST_FLOAT: case IR_CONST_STRING:
+        case IR_CAST: case IR_TYPEOF:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool numeric(const GVN* g, IRFlatOperand operand) {
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_IMM: case IR_FLAT_INT: case IR_FLAT_FLOAT:
+            return true;
+        case IR_FLAT_REG:
+            return ir_flat_payload(operand) < g->reg_count && g->is_int[ir_flat_payload(operand)];
+        default:
+            return false;
+    }
+}
+
+// Operand order does not matter: add and mul only on numbers, since add also concatenates strings
+static bool commutative(const GVN* g, IROpcode opcode, IRFlatOperand a, IRFlatOperand b) {
+    switch (opcode) {
+        case IR_EQ: case IR_NE: case IR_AND: case IR_OR:
+            return true;
+        case IR_ADD: case IR_MUL:
+            return numeric(g, a) && numeric(g, b);
+        default:
+            return false;
+    }
+}
+
+static uint32_t hash_key(IROpcode opcode, const IRFlatOperand* src) {
+    uint32_t hash = 2166136261u ^ (uint32_t)opcode;
+    for (int s = 0; s < 3; s++) hash = (hash ^ src[s]) * 16777619u;
+    return hash ^ (hash >> 15);
+}
+
+static uint32_t find_slot(const GVN* g, IROpcode opcode, const IRFlatOperand* src) {
+    uint32_t slot = hash_key(opcode, src) & g->mask;
+    while (g->table[slot].used) {
+        const Entry* entry = &g->table[slot];
+        if (entry->opcode == opcode && entry->src[0] == src[0] && entry->src[1] == src[1] &&
+            entry->src[2] == src[2]) {
+            break;
+        }
+        slot = (slot + 1) & g->mask;
+    }
+    return slot;
+}
+
+static void remember(GVN* g, uint32_t slot, IROpcode opcode, const IRFlatOperand* src, IRFlatOperand value,
+                     uint32_t epoch) {
+    g->undo[g->undo_count++] = (Undo){ slot, g->table[slot] };
+    Entry* entry = &g->table[slot];
+    entry->opcode = opcode;
+    memcpy(entry->src, src, sizeof(entry->src));
+    entry->value = value;
+    entry->epoch = epoch;
+    entry->used = true;
+}
+
+static void forget_memory(GVN* g) {
+    g->epoch = g->next_epoch++;
+}
+
+// Allocas and globals are separate objects; anything else may point anywhere
+static bool distinct_object(const GVN* g, IRFlatOperand address) {
+    if (ir_flat_kind(address) == IR_FLAT_GLOBAL) return true;
+    if (ir_flat_kind(address) != IR_FLAT_REG || ir_flat_payload(address) >= g->reg_count) return false;
+    uint32_t def = g->def_inst[ir_flat_payload(address)];
+    return def != IR_DOM_NONE && g->flat->insts[def].opcode == IR_ALLOCA;
+}
+
+// Number the instructions of one block; returns how many became redundant
+static int visit_block(GVN* g, uint32_t b, bool* dead) {
+    IRFlatFunction* flat = g->flat;
+    const IRFlatBlock* block = &flat->blocks[b];
+    if (block->pred_count > 1) forget_memory(g);
+
+    int removed = 0;
+    for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+        IRFlatInst* inst = &flat->insts[i];
+        IRFlatOperand src[3] = { leader(g, inst->src[0]), leader(g, inst->src[1]), leader(g, inst->src[2]) };
+        bool has_dest = ir_flat_kind(inst->dest) == IR_FLAT_REG && ir_flat_payload(inst->dest) < g->reg_count;
+
+        if (inst->opcode == IR_STORE) {
+            if (!distinct_object(g, src[1])) forget_memory(g);
+            IRFlatOperand address[3] = { src[1], IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND };
+            remember(g, find_slot(g, IR_LOAD, address), IR_LOAD, address, src[0], g->epoch);
+            continue;
+        }
+        if (inst->opcode == IR_LOAD && has_dest && inst->arg_count == 0) {
+            uint32_t slot = find_slot(g, IR_LOAD, src);
+            const Entry* entry = &g->table[slot];
+            if (entry->used && entry->epoch == g->epoch) {
+                g->value_of[ir_flat_payload(inst->dest)] = entry->value;
+                dead[i] = true;
+                removed++;
+            } else {
+                remember(g, slot, IR_LOAD, src, inst->dest, g->epoch);
+            }
+            continue;
+        }
+        if (ir_opcode_has_side_effects(inst->opcode)) {
+            if (!ir_opcode_is_terminator(inst->opcode)) forget_memory(g);
+            continue;
+        }
+        if (!is_pure(inst->opcode) || !has_dest || inst->arg_count > 0) continue;
+
+        if (commutative(g, inst->opcode, src[0], src[1]) && src[1] < src[0]) {
+            IRFlatOperand swap = src[0];
+            src[0] = src[1];
+            src[1] = swap;
+        }
+        uint32_t slot = find_slot(g, inst->opcode, src);
+        if (g->table[slot].used) {
+            g->value_of[ir_flat_payload(inst->dest)] = g->table[slot].value;
+            dead[i] = true;
+            removed++;
+        } else {
+            remember(g, slot, inst->opcode, src, inst->dest, 0);
+        }
+    }
+    return removed;
+}
+
+static IRFlatOperand resolve(GVN* g, IRFlatOperand operand) {
+    return ir_flat_kind(operand) == IR_FLAT_REG ? leader(g, operand) : operand;
+}
+
+int ir_pass_gvn(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    GVN g = { 0 };
+    g.flat = flat;
+    g.reg_count = (uint32_t)flat->next_register_id;
+    uint32_t size = 16;
+    while (size < 2 * flat->inst_count) size *= 2;
+    g.mask = size - 1;
+    uint32_t pooled_size = 16;
+    while (pooled_size < 2 * (3 * flat->inst_count + flat->arg_count)) pooled_size *= 2;
+    g.pooled_mask = pooled_size - 1;
+
+    IRDominators* dom = ir_dominators_compute(flat);
+    bool* dead = calloc(flat->inst_count ? flat->inst_count : 1, sizeof(bool));
+    g.def_inst = malloc((g.reg_count ? g.reg_count : 1) * sizeof(uint32_t));
+    g.value_of = malloc((g.reg_count ? g.reg_count : 1) * sizeof(IRFlatOperand));
+    g.is_int = ir_ssa_integer_registers(flat);
+    g.table = calloc(size, sizeof(Entry));
+    g.undo = malloc((flat->inst_count ? flat->inst_count : 1) * sizeof(Undo));
+    g.pooled = malloc(pooled_size * sizeof(IRFlatOperand));
+    uint32_t* stack = malloc(flat->block_count * sizeof(uint32_t));
+    uint32_t* next_child = calloc(flat->block_count, sizeof(uint32_t));
+    uint32_t* undo_mark = malloc(flat->block_count * sizeof(uint32_t));
+    uint32_t* saved_epoch = malloc(flat->block_count * sizeof(uint32_t));
+    int removed = -1;
+
+    if (dom && dead && g.def_inst && g.value_of && g.is_int && g.table && g.undo && g.pooled && stack && next_child &&
+        undo_mark && saved_epoch) {
+        for (uint32_t p = 0; p < pooled_size; p++) g.pooled[p] = IR_FLAT_NO_OPERAND;
+        for (uint32_t r = 0; r < g.reg_count; r++) {
+            g.def_inst[r] = IR_DOM_NONE;
+            g.value_of[r] = IR_FLAT_NO_OPERAND;
+        }
+        for (uint32_t i = 0; i < flat->inst_count; i++) {
+            IRFlatOperand dest = flat->insts[i].dest;
+            if (ir_flat_kind(dest) == IR_FLAT_REG && ir_flat_payload(dest) < g.reg_count) {
+                g.def_inst[ir_flat_payload(dest)] = i;
+            }
+        }
+
+        // Preorder walk of the dominator tree; a block's scope closes after its subtree
+        removed = 0;
+        g.next_epoch = 1;
+        forget_memory(&g);
+        uint32_t depth = 0;
+        if (dom->order_count > 0) {
+            uint32_t entry = dom->order[0];
+            undo_mark[entry] = g.undo_count;
+            saved_epoch[entry] = g.epoch;
+            removed += visit_block(&g, entry, dead);
+            stack[depth++] = entry;
+        }
+        while (depth > 0) {
+            uint32_t b = stack[depth - 1];
+            if (next_child[b] < dom->child_count[b]) {
+                uint32_t child = dom->children[dom->first_child[b] + next_child[b]++];
+                undo_mark[child] = g.undo_count;
+                saved_epoch[child] = g.epoch;
+                removed += visit_block(&g, child, dead);
+                stack[depth++] = child;
+                continue;
+            }
+
+            while (g.undo_count > undo_mark[b]) {
+                const Undo* undo = &g.undo[--g.undo_count];
+                g.table[undo->slot] = undo->previous;
+            }
+            g.epoch = saved_epoch[b];
+            depth--;
+        }
+
+        // Uses anywhere, PHI inputs from back edges included, read the surviving values
+        for (uint32_t i = 0; removed > 0 && i < flat->inst_count; i++) {
+            IRFlatInst* inst = &flat->insts[i];
+            for (int s = 0; s < 3; s++) inst->src[s] = resolve(&g, inst->src[s]);
+            for (uint32_t a = 0; a < inst->arg_count; a++) {
+                flat->args[inst->first_arg + a] = resolve(&g, flat->args[inst->first_arg + a]);
+            }
+        }
+        if (removed > 0 && !ir_flat_compact(flat, dead, NULL)) removed = -1;
+    }
+
+    ir_dominators_destroy(dom);
+    free(dead);
+    free(g.def_inst);
+    free(g.value_of);
+    free(g.is_int);
+    free(g.table);
+    free(g.undo);
+    free(g.pooled);
+    free(stack);
+    free(next_child);
+    free(undo_mark);
+    free(saved_epoch);
+    return removed;
+}
@@ -0,0 +1,436 @@
+/*
+ * GPLANG Inliner
+ * Works bottom-up over the call graph: a function's calls are inlined
+ * and the function optimized before any of its callers look at it, so
+ * the size a caller sees is the callee's optimized size.
+ *
+ * A call site is inlined when the callee's instruction count, less what
+ * the call itself costs and a bonus for each constant argument, is under
+ * INLINE_THRESHOLD. Functions declared `inline func` are inlined whatever
+ * their size. Calls within one strongly connected component of the call
+ * graph (direct or mutual recursion) are never inlined, and a caller
+ * stops growing at MAX_CALLER_SIZE instructions.
+ *
+ * With a profile, call sites that never ran are left alone and hot ones
+ * get a larger threshold.
+ *
+ * The callee's body is copied between the two halves of the calling
+ * block. Its returns store to a new local and jump to the second half,
+ * which loads the result; mem2reg then turns the local into a PHI.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+
+extern char* my_strdup(const char* s);
+
+#define INLINE_THRESHOLD 40         // Net callee instructions inlined anywhere
+#define INLINE_HOT_THRESHOLD 120    // ... at call sites the profile shows are hot
+#define INLINE_HOT_COUNT 1000       // Executions that make a call site hot
+#define CONSTANT_ARG_BONUS 4        // Folding a constant argument saves about this much
+#define MAX_CALLER_SIZE 4000
+
+typedef struct {
+    IRFunction** functions;     // Module functions, in module order
+    int count;
+    int** callees;              // Per function: indices of module functions it calls
+    int* callee_count;
+
+    // Tarjan's algorithm
+    int* index;
+    int* lowlink;
+    bool* on_stack;
+    int* stack;
+    int stack_size;
+    int next_index;
+
+    int* component;             // Strongly connected component of each function
+    int* order;                 // Functions, callees before callers
+    int order_count;
+} CallGraph;
+
+typedef struct {
+    IRBasicBlock* block;
+    IRInstruction* call;
+    int callee;
+    long long count;            // Profiled executions, or -1
+} CallSite;
+
+static int find_function(const CallGraph* graph, const IRValue* name) {
+    if (!name || name->type != IR_VALUE_GLOBAL || !name->global_name) return -1;
+    for (int i = 0; i < graph->count; i++) {
+        if (strcmp(graph->functions[i]->name, name->global_name) == 0) return i;
+    }
+    return -1;
+}
+
+static void strong_connect(CallGraph* graph, int v) {
+    graph->index[v] = graph->lowlink[v] = graph->next_index++;
+    graph->stack[graph->stack_size++] = v;
+    graph->on_stack[v] = true;
+
+    for (int i = 0; i < graph->callee_count[v]; i++) {
+        int w = graph->callees[v][i];
+        if (graph->index[w] < 0) {
+            strong_connect(graph, w);
+            if (graph->lowlink[w] < graph->lowlink[v]) graph->lowlink[v] = graph->lowlink[w];
+        } else if (graph->on_stack[w] && graph->index[w] < graph->lowlink[v]) {
+            graph->lowlink[v] = graph->index[w];
+        }
+    }
+
+    // Components are completed callees first, which is the order we want
+    if (graph->lowlink[v] == graph->index[v]) {
+        int w;
+        do {
+            w = graph->stack[--graph->stack_size];
+            graph->on_stack[w] = false;
+            graph->component[w] = v;
+            graph->order[graph->order_count++] = w;
+        } while (w != v);
+    }
+}
+
+static void call_graph_destroy(CallGraph* graph) {
+    for (int i = 0; graph->callees && i < graph->count; i++) free(graph->callees[i]);
+    free(graph->functions);
+    free(graph->callees);
+    free(graph->callee_count);
+    free(graph->index);
+    free(graph->lowlink);
+    free(graph->on_stack);
+    free(graph->stack);
+    free(graph->component);
+    free(graph->order);
+}
+
+static bool call_graph_build(CallGraph* graph, IRModule* module) {
+    memset(graph, 0, sizeof(*graph));
+    for (IRFunction* function = module->functions; function; function = function->next) graph->count++;
+
+    int n = graph->count ? graph->count : 1;
+    graph->functions = malloc(n * sizeof(IRFunction*));
+    graph->callees = calloc(n, sizeof(int*));
+    graph->callee_count = calloc(n, sizeof(int));
+    graph->index = malloc(n * sizeof(int));
+    graph->lowlink = malloc(n * sizeof(int));
+    graph->on_stack = calloc(n, sizeof(bool));
+    graph->stack = malloc(n * sizeof(int));
+    graph->component = malloc(n * sizeof(int));
+    graph->order = malloc(n * sizeof(int));
+    if (!graph->functions || !graph->callees || !graph->callee_count || !graph->index ||
+        !graph->lowlink || !graph->on_stack || !graph->stack || !graph->component || !graph->order) {
+        return false;
+    }
+
+    int i = 0;
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        graph->functions[i] = function;
+        graph->index[i] = -1;
+        i++;
+    }
+
+    for (i = 0; i < graph->count; i++) {
+        int capacity = 0;
+        for (IRBasicBlock* block = graph->functions[i]->blocks; block; block = block->next) {
+            for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+                int callee = inst->opcode == IR_CALL ? find_function(graph, inst->src1) : -1;
+                if (callee < 0) continue;
+
+                if (graph->callee_count[i] == capacity) {
+                    capacity = capacity ? capacity * 2 : 4;
+                    int* grown = realloc(graph->callees[i], capacity * sizeof(int));
+                    if (!grown) return false;
+                    graph->callees[i] = grown;
+                }
+                graph->callees[i][graph->callee_count[i]++] = callee;
+            }
+        }
+    }
+
+    for (i = 0; i < graph->count; i++) {
+        if (graph->index[i] < 0) strong_connect(graph, i);
+    }
+    return true;
+}
+
+// Size for the inlining budget: NOPs and allocas generate no code
+static int inline_cost(const IRFunction* function) {
+    int count = 0;
+    for (const IRBasicBlock* block = function->blocks; block; block = block->next) {
+        for (const IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            if (inst->opcode != IR_NOP && inst->opcode != IR_ALLOCA) count++;
+        }
+    }
+    return count;
+}
+
+// Every instruction, the unit the optimizer's stats count in
+static int instruction_count(const IRFunction* function) {
+    int count = 0;
+    for (const IRBasicBlock* block = function->blocks; block; block = block->next) {
+        for (const IRInstruction* inst = block->instructions; inst; inst = inst->next) count++;
+    }
+    return count;
+}
+
+static bool worth_inlining(const CallSite* site, const IRFunction* callee, int callee_size,
+                           int caller_size) {
+    if (callee->always_inline) return true;
+    if (site->count == 0) return false;
+    if (caller_size + callee_size > MAX_CALLER_SIZE) return false;
+
+    int saved = site->call->arg_count + 2;      // Argument moves, call and return
+    for (int i = 0; i < site->call->arg_count; i++) {
+        if (site->call->args[i]->type == IR_VALUE_CONSTANT) saved += CONSTANT_ARG_BONUS;
+    }
+    int threshold = site->count >= INLINE_HOT_COUNT ? INLINE_HOT_THRESHOLD : INLINE_THRESHOLD;
+    return callee_size - saved <= threshold;
+}
+
+// Copying one callee into one call site
+typedef struct {
+    const IRFunction* callee;
+    const IRInstruction* call;
+    int register_base;
+    int site;
+} InlineCopy;
+
+static char* copy_label(const InlineCopy* copy, const char* label) {
+    size_t size = strlen(copy->callee->name) + strlen(label) + 24;
+    char* name = malloc(size);
+    if (name) snprintf(name, size, "%s.%d.%s", copy->callee->name, copy->site, label);
+    return name;
+}
+
+static IRValue* copy_value(const InlineCopy* copy, const IRValue* value) {
+    if (!value) return NULL;
+
+    if (value->type == IR_VALUE_REGISTER) {
+        for (int i = 0; i < copy->callee->parameter_count; i++) {
+            if (copy->callee->parameters[i]->reg_id == value->reg_id) {
+                return ir_value_clone(copy->call->args[i]);
+            }
+        }
+        return ir_value_create_register(value->reg_id + copy->register_base);
+    }
+    if (value->type == IR_VALUE_LABEL && value->label) {
+        char* label = copy_label(copy, value->label);
+        IRValue* result = label ? ir_value_create_label(label) : NULL;
+        free(label);
+        return result;
+    }
+    return ir_value_clone(value);
+}
+
+static IRInstruction* copy_instruction(const InlineCopy* copy, const IRInstruction* inst) {
+    IRInstruction* result = ir_instruction_create(inst->opcode);
+    if (!result) return NULL;
+
+    ir_instruction_set_dest(result, copy_value(copy, inst->dest));
+    ir_instruction_set_src(result, 1, copy_value(copy, inst->src1));
+    ir_instruction_set_src(result, 2, copy_value(copy, inst->src2));
+    ir_instruction_set_src(result, 3, copy_value(copy, inst->src3));
+    for (int i = 0; i < inst->arg_count; i++) {
+        ir_instruction_add_arg(result, copy_value(copy, inst->args[i]));
+    }
+    result->line_number = inst->line_number;
+    if (inst->comment) result->comment = my_strdup(inst->comment);
+    return result;
+}
+
+static IRInstruction* jump_to(const char* label) {
+    IRInstruction* jump = ir_instruction_create(IR_JUMP);
+    if (jump) ir_instruction_set_src(jump, 1, ir_value_create_label(label));
+    return jump;
+}
+
+static void insert_block_after(IRFunction* function, IRBasicBlock* after, IRBasicBlock* block) {
+    block->next = after->next;
+    after->next = block;
+    if (function->last_block == after) function->last_block = block;
+}
+
+// Allocas go to the head of the caller's entry block, where mem2reg promotes them
+static void add_to_entry(IRFunction* function, IRInstruction* alloca_inst) {
+    IRBasicBlock* entry = function->entry_block;
+    alloca_inst->next = entry->instructions;
+    entry->instructions = alloca_inst;
+    if (!entry->last_instruction) entry->last_instruction = alloca_inst;
+}
+
+static void rename_phi_inputs(IRBasicBlock* block, const char* from, const char* to) {
+    for (IRInstruction* inst = block->instructions; inst && inst->opcode == IR_PHI; inst = inst->next) {
+        for (int i = 1; i < inst->arg_count; i += 2) {
+            IRValue* label = inst->args[i];
+            if (label->type == IR_VALUE_LABEL && label->label && strcmp(label->label, from) == 0) {
+                free(label->label);
+                label->label = my_strdup(to);
+            }
+        }
+    }
+}
+
+// Replace the call with a copy of the callee's body
+static bool inline_call(IRFunction* caller, CallSite* site, const IRFunction* callee, int number) {
+    InlineCopy copy = { callee, site->call, caller->next_register_id, number };
+    IRBasicBlock* block = site->block;
+    IRInstruction* call = site->call;
+
+    char* label = copy_label(&copy, "ret");
+    IRBasicBlock* rest = label ? ir_basic_block_create(label) : NULL;
+    free(label);
+    IRInstruction* result_slot = NULL;
+    if (rest && call->dest) {
+        result_slot = ir_instruction_create(IR_ALLOCA);
+        if (result_slot) {
+            ir_instruction_set_dest(result_slot, ir_value_create_register(caller->next_register_id + callee->next_register_id));
+            ir_instruction_set_src(result_slot, 1, ir_value_create_constant_string("inline.result"));
+        }
+    }
+    char* entry_label = rest ? copy_label(&copy, callee->entry_block->label) : NULL;
+    IRInstruction* enter = entry_label ? jump_to(entry_label) : NULL;
+    free(entry_label);
+    if (!enter || (call->dest && !result_slot)) {
+        ir_basic_block_destroy(rest);
+        ir_instruction_destroy(result_slot);
+        ir_instruction_destroy(enter);
+        return false;
+    }
+    caller->next_register_id += callee->next_register_id + (result_slot ? 1 : 0);
+
+    // Split the block: everything after the call moves to rest
+    IRInstruction* previous = NULL;
+    for (IRInstruction* inst = block->instructions; inst != call; inst = inst->next) previous = inst;
+    rest->instructions = call->next;
+    rest->last_instruction = call->next ? block->last_instruction : NULL;
+    if (previous) previous->next = enter;
+    else block->instructions = enter;
+    block->last_instruction = enter;
+    insert_block_after(caller, block, rest);
+    for (IRBasicBlock* successor = caller->blocks; successor; successor = successor->next) {
+        rename_phi_inputs(successor, block->label, rest->label);
+    }
+
+    // The result comes back through result_slot
+    if (result_slot) {
+        IRInstruction* load = ir_instruction_create(IR_LOAD);
+        if (load) {
+            ir_instruction_set_dest(load, call->dest);
+            call->dest = NULL;
+            ir_instruction_set_src(load, 1, ir_value_clone(result_slot->dest));
+            load->next = rest->instructions;
+            rest->instructions = load;
+            if (!rest->last_instruction) rest->last_instruction = load;
+        }
+        add_to_entry(caller, result_slot);
+    }
+
+    IRBasicBlock* after = block;
+    for (const IRBasicBlock* original = callee->blocks; original; original = original->next) {
+        label = copy_label(&copy, original->label);
+        IRBasicBlock* body = label ? ir_basic_block_create(label) : NULL;
+        free(label);
+        if (!body) break;
+        insert_block_after(caller, after, body);
+        after = body;
+
+        for (const IRInstruction* inst = original->instructions; inst; inst = inst->next) {
+            if (inst->opcode == IR_RETURN) {
+                if (result_slot) {
+                    IRInstruction* store = ir_instruction_create(IR_STORE);
+                    if (store) {
+                        ir_instruction_set_src(store, 1, inst->src1 ? copy_value(&copy, inst->src1)
+                                                                    : ir_value_create_constant_int(0));
+                        ir_instruction_set_src(store, 2, ir_value_clone(result_slot->dest));
+                        ir_basic_block_add_instruction(body, store);
+                    }
+                }
+                IRInstruction* jump = jump_to(rest->label);
+                if (jump) ir_basic_block_add_instruction(body, jump);
+                break;
+            }
+
+            IRInstruction* clone = copy_instruction(&copy, inst);
+            if (!clone) continue;
+            if (clone->opcode == IR_ALLOCA) add_to_entry(caller, clone);
+            else ir_basic_block_add_instruction(body, clone);
+        }
+    }
+
+    ir_instruction_destroy(call);
+    return true;
+}
+
+// Inline the calls caller makes to functions outside its own component
+static int inline_into(CallGraph* graph, int caller_index, const IRProfile* profile, int* sites) {
+    IRFunction* caller = graph->functions[caller_index];
+    if (!caller->entry_block) return 0;
+
+    // Collect the original call sites first: inlined bodies are not revisited
+    CallSite* calls = NULL;
+    int call_count = 0, capacity = 0;
+    for (IRBasicBlock* block = caller->blocks; block; block = block->next) {
+        long long count;
+        if (!ir_profile_block_count(profile, caller->name, block->label, &count)) count = -1;
+
+        for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            int callee = inst->opcode == IR_CALL ? find_function(graph, inst->src1) : -1;
+            if (callee < 0 || graph->component[callee] == graph->component[caller_index]) continue;
+
+            if (call_count == capacity) {
+                capacity = capacity ? capacity * 2 : 8;
+                CallSite* grown = realloc(calls, capacity * sizeof(CallSite));
+                if (!grown) break;
+                calls = grown;
+            }
+            calls[call_count++] = (CallSite){ block, inst, callee, count };
+        }
+    }
+
+    // Later sites first, so splitting a block leaves earlier sites where they were
+    int inlined = 0;
+    int caller_size = inline_cost(caller);
+    for (int i = call_count - 1; i >= 0; i--) {
+        const IRFunction* callee = graph->functions[calls[i].callee];
+        if (!callee->entry_block || callee->entry_block->predecessor_count > 0 ||
+            strcmp(callee->name, "main") == 0 || callee->parameter_count != calls[i].call->arg_count) {
+            continue;
+        }
+
+        int callee_size = inline_cost(callee);
+        if (!worth_inlining(&calls[i], callee, callee_size, caller_size)) continue;
+        if (inline_call(caller, &calls[i], callee, (*sites)++)) {
+            caller_size += callee_size;
+            inlined++;
+        }
+    }
+    free(calls);
+
+    if (inlined > 0) ir_function_rebuild_edges(caller);
+    return inlined;
+}
+
+int ir_inline_module(IRModule* module, const IRProfile* profile, IRInlineVisit visit, void* context) {
+    if (!module) return 0;
+
+    CallGraph graph;
+    if (!call_graph_build(&graph, module)) {
+        call_graph_destroy(&graph);
+        return -1;
+    }
+
+    int total = 0, sites = 0;
+    for (int i = 0; i < graph.order_count; i++) {
+        int f = graph.order[i];
+        int size = instruction_count(graph.functions[f]);
+        int inlined = inline_into(&graph, f, profile, &sites);
+        total += inlined;
+        if (visit) visit(graph.functions[f], size, inlined, context);
+    }
+
+    call_graph_destroy(&graph);
+    return total;
+}
@@ -0,0 +1,515 @@
+/*
+ * GPLANG Loop Optimizations
+ * Loop-invariant code motion and strength reduction over natural loops
+ * (ir_loops_compute), inner loops first.
+ *
+ * LICM moves pure instructions whose operands are all defined outside a
+ * loop into its preheader, so an invariant computed in an inner loop
+ * can move out of the enclosing ones as well. Only instructions that
+ * cannot trap are moved, since the preheader runs even when the loop
+ * body does not. Loads stay where they are: calls may store to globals.
+ *
+ * Strength reduction rewrites `mul t, i, k` with i a basic induction
+ * variable (a header PHI stepped by a constant) and k an integer loop
+ * invariant: a new PHI starts at init * k and is stepped by step * k
+ * next to i's own update, and t's uses read it instead. Matrix indexing
+ * such as `row * width + col` turns into one add per iteration. Both
+ * sides must be provably integers, so the rewrite is exact even when
+ * the products wrap.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+
+#define MAX_REDUCED_PER_LOOP 16
+
+// Instructions added in front of existing ones, and instructions dropped, applied in one rebuild
+typedef struct {
+    IRFlatInst inst;
+    IRFlatOperand args[4];      // PHI inputs
+    uint32_t before;            // Instruction it goes in front of
+    uint32_t sequence;          // Keeps insertions before the same instruction in order
+} Insertion;
+
+typedef struct {
+    Insertion* insertions;
+    uint32_t count;
+    uint32_t capacity;
+    bool* removed;              // Per instruction
+} Rewrite;
+
+typedef struct {
+    IRFlatFunction* flat;
+    IRDominators* dom;
+    IRLoops* loops;
+    uint32_t reg_count;
+    uint32_t* def_inst;         // Per register, IR_DOM_NONE if not defined by an instruction
+    uint32_t* inst_block;
+} LoopAnalysis;
+
+static bool analysis_init(LoopAnalysis* a, IRFlatFunction* flat) {
+    memset(a, 0, sizeof(*a));
+    a->flat = flat;
+    a->dom = ir_dominators_compute(flat);
+    a->loops = a->dom ? ir_loops_compute(flat, a->dom) : NULL;
+    return a->loops != NULL;
+}
+
+// Definitions move whenever a rewrite is applied
+static bool analysis_update(LoopAnalysis* a) {
+    const IRFlatFunction* flat = a->flat;
+    free(a->def_inst);
+    free(a->inst_block);
+    a->reg_count = (uint32_t)flat->next_register_id;
+    a->def_inst = malloc((a->reg_count ? a->reg_count : 1) * sizeof(uint32_t));
+    a->inst_block = malloc((flat->inst_count ? flat->inst_count : 1) * sizeof(uint32_t));
+    if (!a->def_inst || !a->inst_block) return false;
+
+    for (uint32_t r = 0; r < a->reg_count; r++) a->def_inst[r] = IR_DOM_NONE;
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            a->inst_block[i] = b;
+            IRFlatOperand dest = flat->insts[i].dest;
+            if (ir_flat_kind(dest) == IR_FLAT_REG && ir_flat_payload(dest) < a->reg_count) {
+                a->def_inst[ir_flat_payload(dest)] = i;
+            }
+        }
+    }
+    return true;
+}
+
+static void analysis_free(LoopAnalysis* a) {
+    ir_loops_destroy(a->loops);
+    ir_dominators_destroy(a->dom);
+    free(a->def_inst);
+    free(a->inst_block);
+}
+
+// Defined outside the loop, or not a register at all
+static bool defined_outside(const LoopAnalysis* a, const IRLoop* loop, IRFlatOperand operand) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG) return true;
+    uint32_t reg = ir_flat_payload(operand);
+    if (reg >= a->reg_count) return false;
+    uint32_t def = a->def_inst[reg];
+    return def == IR_DOM_NONE || !ir_loop_contains(a->loops, loop, a->inst_block[def]);
+}
+
+// Last instruction of the preheader, where hoisted code goes in front of
+static uint32_t preheader_jump(const IRFlatFunction* flat, const IRLoop* loop) {
+    if (loop->preheader == IR_DOM_NONE) return IR_DOM_NONE;
+    const IRFlatBlock* block = &flat->blocks[loop->preheader];
+    if (block->inst_count == 0) return IR_DOM_NONE;
+    uint32_t last = block->first_inst + block->inst_count - 1;
+    return flat->insts[last].opcode == IR_JUMP ? last : IR_DOM_NONE;
+}
+
+static IRFlatInst* insert_before(Rewrite* rewrite, uint32_t before, IROpcode opcode, IRFlatOperand dest,
+                                 IRFlatOperand a, IRFlatOperand b, int line) {
+    if (rewrite->count == rewrite->capacity) {
+        uint32_t capacity = rewrite->capacity ? rewrite->capacity * 2 : 16;
+        Insertion* grown = realloc(rewrite->insertions, capacity * sizeof(Insertion));
+        if (!grown) return NULL;
+        rewrite->insertions = grown;
+        rewrite->capacity = capacity;
+    }
+
+    Insertion* insertion = &rewrite->insertions[rewrite->count];
+    memset(insertion, 0, sizeof(*insertion));
+    insertion->before = before;
+    insertion->sequence = rewrite->count++;
+    insertion->inst.opcode = opcode;
+    insertion->inst.dest = dest;
+    insertion->inst.src[0] = a;
+    insertion->inst.src[1] = b;
+    insertion->inst.comment = IR_FLAT_NO_STRING;
+    insertion->inst.line_number = line;
+    return &insertion->inst;
+}
+
+static int compare_insertions(const void* a, const void* b) {
+    const Insertion* x = a;
+    const Insertion* y = b;
+    if (x->before != y->before) return x->before < y->before ? -1 : 1;
+    return x->sequence < y->sequence ? -1 : x->sequence > y->sequence;
+}
+
+// Rebuild the instruction and argument arrays; blocks and edges stay as they are
+static bool apply(IRFlatFunction* flat, Rewrite* rewrite) {
+    qsort(rewrite->insertions, rewrite->count, sizeof(Insertion), compare_insertions);
+
+    uint32_t inst_count = rewrite->count, arg_count = 0;
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        if (!rewrite->removed[i]) {
+            inst_count++;
+            arg_count += flat->insts[i].arg_count;
+        }
+    }
+    for (uint32_t k = 0; k < rewrite->count; k++) arg_count += rewrite->insertions[k].inst.arg_count;
+
+    IRFlatInst* insts = calloc(inst_count ? inst_count : 1, sizeof(IRFlatInst));
+    IRFlatOperand* args = calloc(arg_count ? arg_count : 1, sizeof(IRFlatOperand));
+    if (!insts || !args) {
+        free(insts);
+        free(args);
+        return false;
+    }
+
+    uint32_t next_inst = 0, next_arg = 0, k = 0;
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        IRFlatBlock* block = &flat->blocks[b];
+        uint32_t first = block->first_inst, end = block->first_inst + block->inst_count;
+        block->first_inst = next_inst;
+
+        for (uint32_t i = first; i < end; i++) {
+            for (; k < rewrite->count && rewrite->insertions[k].before == i; k++) {
+                const Insertion* insertion = &rewrite->insertions[k];
+                IRFlatInst* inst = &insts[next_inst++];
+                *inst = insertion->inst;
+                inst->first_arg = next_arg;
+                for (uint32_t p = 0; p < inst->arg_count; p++) args[next_arg++] = insertion->args[p];
+            }
+            if (rewrite->removed[i]) continue;
+
+            IRFlatInst* inst = &insts[next_inst++];
+            *inst = flat->insts[i];
+            inst->first_arg = next_arg;
+            for (uint32_t p = 0; p < inst->arg_count; p++) args[next_arg++] = flat->args[flat->insts[i].first_arg + p];
+        }
+        block->inst_count = next_inst - block->first_inst;
+    }
+
+    free(flat->insts);
+    free(flat->args);
+    flat->insts = insts;
+    flat->inst_count = flat->inst_capacity = inst_count;
+    flat->args = args;
+    flat->arg_count = flat->arg_capacity = arg_count;
+    return true;
+}
+
+static bool rewrite_init(Rewrite* rewrite, const IRFlatFunction* flat) {
+    memset(rewrite, 0, sizeof(*rewrite));
+    rewrite->removed = calloc(flat->inst_count ? flat->inst_count : 1, sizeof(bool));
+    return rewrite->removed != NULL;
+}
+
+static void rewrite_free(Rewrite* rewrite) {
+    free(rewrite->insertions);
+    free(rewrite->removed);
+}
+
+// ============================================================================
+// LOOP-INVARIANT CODE MOTION
+// ============================================================================
+
+// Pure, and cannot trap whatever its operands are
+static bool can_hoist(const IRFlatFunction* flat, const IRFlatInst* inst) {
+    if (ir_flat_kind(inst->dest) != IR_FLAT_REG || inst->arg_count > 0) return false;
+
+    switch (inst->opcode) {
+        case IR_ADD: case IR_SUB: case IR_MUL:
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+        case IR_AND: case IR_OR: case IR_NOT:
+        case IR_CONST_INT: case IR_CONST_FLOAT: case IR_CONST_STRING:
+            return true;
+        case IR_DIV: case IR_MOD: {
+            // Integer division traps on zero and on LLONG_MIN / -1
+            if (!ir_flat_is_int_constant(inst->src[1])) return false;
+            long long divisor = ir_flat_int_value(flat, inst->src[1]);
+            return divisor != 0 && divisor != -1;
+        }
+        default:
+            return false;
+    }
+}
+
+static int hoist_loop(LoopAnalysis* a, const IRLoop* loop, uint32_t* hoisted_in) {
+    IRFlatFunction* flat = a->flat;
+    uint32_t target = preheader_jump(flat, loop);
+    if (target == IR_DOM_NONE) return 0;
+
+    Rewrite rewrite;
+    if (!rewrite_init(&rewrite, flat)) return -1;
+
+    // Reverse postorder visits definitions before their uses
+    int hoisted = 0;
+    uint32_t loop_id = (uint32_t)(loop - a->loops->loops);
+    for (uint32_t o = 0; o < a->dom->order_count; o++) {
+        uint32_t b = a->dom->order[o];
+        if (!ir_loop_contains(a->loops, loop, b)) continue;
+
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            const IRFlatInst* inst = &flat->insts[i];
+            if (!can_hoist(flat, inst)) continue;
+
+            bool invariant = true;
+            for (int s = 0; s < 3 && invariant; s++) {
+                IRFlatOperand src = inst->src[s];
+                bool moved = ir_flat_kind(src) == IR_FLAT_REG && ir_flat_payload(src) < a->reg_count &&
+                             hoisted_in[ir_flat_payload(src)] == loop_id;
+                invariant = moved || defined_outside(a, loop, src);
+            }
+            if (!invariant) continue;
+
+            IRFlatInst* copy = insert_before(&rewrite, target, inst->opcode, inst->dest, inst->src[0],
+                                             inst->src[1], inst->line_number);
+            if (!copy) {
+                rewrite_free(&rewrite);
+                return -1;
+            }
+            *copy = *inst;
+            rewrite.removed[i] = true;
+            hoisted_in[ir_flat_payload(inst->dest)] = loop_id;
+            hoisted++;
+        }
+    }
+
+    bool ok = hoisted == 0 || (apply(flat, &rewrite) && analysis_update(a));
+    rewrite_free(&rewrite);
+    return ok ? hoisted : -1;
+}
+
+int ir_pass_licm(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    LoopAnalysis a;
+    uint32_t* hoisted_in = NULL;    // Per register: loop it was hoisted out of
+    bool ok = analysis_init(&a, flat) && analysis_update(&a);
+    if (ok) {
+        hoisted_in = malloc((a.reg_count ? a.reg_count : 1) * sizeof(uint32_t));
+        ok = hoisted_in != NULL;
+        for (uint32_t r = 0; ok && r < a.reg_count; r++) hoisted_in[r] = IR_DOM_NONE;
+    }
+
+    int total = 0;
+    for (uint32_t l = 0; ok && l < a.loops->loop_count; l++) {
+        int hoisted = hoist_loop(&a, &a.loops->loops[l], hoisted_in);
+        if (hoisted < 0) ok = false;
+        else total += hoisted;
+    }
+
+    free(hoisted_in);
+    analysis_free(&a);
+    return ok ? total : -1;
+}
+
+// ============================================================================
+// STRENGTH REDUCTION
+// ============================================================================
+
+typedef struct {
+    IRFlatOperand iv;
+    IRFlatOperand factor;
+    uint32_t reg;               // The PHI standing for iv * factor
+} Reduced;
+
+static bool is_register(IRFlatOperand operand, uint32_t reg) {
+    return ir_flat_kind(operand) == IR_FLAT_REG && ir_flat_payload(operand) == reg;
+}
+
+static IRFlatOperand phi_input(const IRFlatFunction* flat, const IRFlatInst* phi, uint32_t pred) {
+    for (uint32_t p = 0; p + 1 < phi->arg_count; p += 2) {
+        IRFlatOperand label = flat->args[phi->first_arg + p + 1];
+        if (ir_flat_kind(label) == IR_FLAT_LABEL && ir_flat_payload(label) == pred) {
+            return flat->args[phi->first_arg + p];
+        }
+    }
+    return IR_FLAT_NO_OPERAND;
+}
+
+// The constant a basic induction variable steps by each iteration, through update
+static bool induction_step(const IRFlatFunction* flat, const IRFlatInst* update, uint32_t iv, long long* step) {
+    if (update->opcode == IR_ADD && is_register(update->src[0], iv) && ir_flat_is_int_constant(update->src[1])) {
+        *step = ir_flat_int_value(flat, update->src[1]);
+    } else if (update->opcode == IR_ADD && is_register(update->src[1], iv) &&
+               ir_flat_is_int_constant(update->src[0])) {
+        *step = ir_flat_int_value(flat, update->src[0]);
+    } else if (update->opcode == IR_SUB && is_register(update->src[0], iv) &&
+               ir_flat_is_int_constant(update->src[1])) {
+        *step = (long long)(0ULL - (unsigned long long)ir_flat_int_value(flat, update->src[1]));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static long long wrapping_mul(long long a, long long b) {
+    return (long long)((unsigned long long)a * (unsigned long long)b);
+}
+
+// a * b, folded when both are constants, otherwise computed in front of the preheader's jump
+static IRFlatOperand product(IRFlatFunction* flat, Rewrite* rewrite, uint32_t target, IRFlatOperand a,
+                             IRFlatOperand b, int line) {
+    if (ir_flat_is_int_constant(a) && ir_flat_is_int_constant(b)) {
+        return ir_flat_int_operand(flat, wrapping_mul(ir_flat_int_value(flat, a), ir_flat_int_value(flat, b)));
+    }
+    IRFlatOperand dest = ir_flat_operand(IR_FLAT_REG, (uint32_t)flat->next_register_id++);
+    return insert_before(rewrite, target, IR_MUL, dest, a, b, line) ? dest : IR_FLAT_NO_OPERAND;
+}
+
+// Registers read by instructions outside the loop
+static bool* uses_outside(const LoopAnalysis* a, const IRLoop* loop) {
+    const IRFlatFunction* flat = a->flat;
+    bool* used = calloc(a->reg_count ? a->reg_count : 1, sizeof(bool));
+    if (!used) return NULL;
+
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        if (ir_loop_contains(a->loops, loop, a->inst_block[i])) continue;
+        const IRFlatInst* inst = &flat->insts[i];
+        for (int s = 0; s < 3; s++) {
+            if (ir_flat_kind(inst->src[s]) == IR_FLAT_REG && ir_flat_payload(inst->src[s]) < a->reg_count) {
+                used[ir_flat_payload(inst->src[s])] = true;
+            }
+        }
+        for (uint32_t p = 0; p < inst->arg_count; p++) {
+            IRFlatOperand arg = flat->args[inst->first_arg + p];
+            if (ir_flat_kind(arg) == IR_FLAT_REG && ir_flat_payload(arg) < a->reg_count) {
+                used[ir_flat_payload(arg)] = true;
+            }
+        }
+    }
+    return used;
+}
+
+static void replace_register(IRFlatFunction* flat, uint32_t from, IRFlatOperand to) {
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        IRFlatInst* inst = &flat->insts[i];
+        for (int s = 0; s < 3; s++) {
+            if (is_register(inst->src[s], from)) inst->src[s] = to;
+        }
+        for (uint32_t p = 0; p < inst->arg_count; p++) {
+            if (is_register(flat->args[inst->first_arg + p], from)) flat->args[inst->first_arg + p] = to;
+        }
+    }
+}
+
+/*
+ * For each `mul t, iv, k` in the loop: j = phi(init * k, j + step * k),
+ * with the add placed right after iv's own update so it reaches the latch
+ */
+static int reduce_loop(LoopAnalysis* a, const IRLoop* loop, const bool* is_int) {
+    IRFlatFunction* flat = a->flat;
+    uint32_t target = preheader_jump(flat, loop);
+    const IRFlatBlock* header = &flat->blocks[loop->header];
+    if (target == IR_DOM_NONE || loop->latch_count != 1 || header->pred_count != 2) return 0;
+
+    uint32_t latch = flat->edges[header->first_pred];
+    if (latch == loop->preheader) latch = flat->edges[header->first_pred + 1];
+
+    Rewrite rewrite;
+    bool* used_outside = uses_outside(a, loop);
+    if (!used_outside || !rewrite_init(&rewrite, flat)) {
+        free(used_outside);
+        return -1;
+    }
+
+    Reduced reduced[MAX_REDUCED_PER_LOOP];
+    uint32_t reduced_count = 0;
+    int rewritten = 0;
+    bool ok = true;
+    for (uint32_t o = 0; ok && o < a->dom->order_count; o++) {
+        uint32_t b = a->dom->order[o];
+        if (!ir_loop_contains(a->loops, loop, b)) continue;
+
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; ok && i < block->first_inst + block->inst_count; i++) {
+            IRFlatInst* mul = &flat->insts[i];
+            if (mul->opcode != IR_MUL || ir_flat_kind(mul->dest) != IR_FLAT_REG ||
+                used_outside[ir_flat_payload(mul->dest)]) {
+                continue;
+            }
+
+            // One side a basic induction variable of this loop, the other an integer invariant
+            for (int side = 0; side < 2; side++) {
+                IRFlatOperand iv = mul->src[side], factor = mul->src[1 - side];
+                if (ir_flat_kind(iv) != IR_FLAT_REG || ir_flat_payload(iv) >= a->reg_count ||
+                    !is_int[ir_flat_payload(iv)]) {
+                    continue;
+                }
+                bool int_factor = ir_flat_is_int_constant(factor) ||
+                                  (ir_flat_kind(factor) == IR_FLAT_REG && ir_flat_payload(factor) < a->reg_count &&
+                                   is_int[ir_flat_payload(factor)]);
+                if (!int_factor || !defined_outside(a, loop, factor)) continue;
+
+                uint32_t phi = a->def_inst[ir_flat_payload(iv)];
+                if (phi == IR_DOM_NONE || a->inst_block[phi] != loop->header || flat->insts[phi].opcode != IR_PHI) {
+                    continue;
+                }
+                IRFlatOperand initial = phi_input(flat, &flat->insts[phi], loop->preheader);
+                IRFlatOperand next = phi_input(flat, &flat->insts[phi], latch);
+                uint32_t update = ir_flat_kind(next) == IR_FLAT_REG && ir_flat_payload(next) < a->reg_count
+                                  ? a->def_inst[ir_flat_payload(next)] : IR_DOM_NONE;
+                long long step;
+                if (initial == IR_FLAT_NO_OPERAND || update == IR_DOM_NONE ||
+                    !ir_loop_contains(a->loops, loop, a->inst_block[update]) ||
+                    !induction_step(flat, &flat->insts[update], ir_flat_payload(iv), &step)) {
+                    continue;
+                }
+
+                uint32_t reg = IR_DOM_NONE;
+                for (uint32_t r = 0; r < reduced_count; r++) {
+                    if (reduced[r].iv == iv && reduced[r].factor == factor) reg = reduced[r].reg;
+                }
+                if (reg == IR_DOM_NONE) {
+                    if (reduced_count == MAX_REDUCED_PER_LOOP) break;
+
+                    int line = mul->line_number;
+                    IRFlatOperand start = product(flat, &rewrite, target, initial, factor, line);
+                    IRFlatOperand stride = product(flat, &rewrite, target, factor, ir_flat_int_operand(flat, step), line);
+                    reg = (uint32_t)flat->next_register_id++;
+                    IRFlatOperand stepped = ir_flat_operand(IR_FLAT_REG, (uint32_t)flat->next_register_id++);
+                    IRFlatInst* new_phi = start != IR_FLAT_NO_OPERAND && stride != IR_FLAT_NO_OPERAND
+                        ? insert_before(&rewrite, header->first_inst, IR_PHI, ir_flat_operand(IR_FLAT_REG, reg),
+                                        IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND, line)
+                        : NULL;
+                    if (new_phi) {
+                        Insertion* insertion = &rewrite.insertions[rewrite.count - 1];
+                        new_phi->arg_count = 4;
+                        insertion->args[0] = start;
+                        insertion->args[1] = ir_flat_operand(IR_FLAT_LABEL, loop->preheader);
+                        insertion->args[2] = stepped;
+                        insertion->args[3] = ir_flat_operand(IR_FLAT_LABEL, latch);
+                    }
+                    ok = new_phi && insert_before(&rewrite, update + 1, IR_ADD, stepped,
+                                                  ir_flat_operand(IR_FLAT_REG, reg), stride, line);
+                    if (!ok) break;
+                    reduced[reduced_count++] = (Reduced){ iv, factor, reg };
+                }
+
+                replace_register(flat, ir_flat_payload(mul->dest), ir_flat_operand(IR_FLAT_REG, reg));
+                rewrite.removed[i] = true;
+                rewritten++;
+                break;
+            }
+        }
+    }
+
+    ok = ok && (rewritten == 0 || (apply(flat, &rewrite) && analysis_update(a)));
+    rewrite_free(&rewrite);
+    free(used_outside);
+    return ok ? rewritten : -1;
+}
+
+int ir_pass_strength_reduce(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    LoopAnalysis a;
+    bool ok = analysis_init(&a, flat) && analysis_update(&a);
+
+    int total = 0;
+    for (uint32_t l = 0; ok && l < a.loops->loop_count; l++) {
+        // New PHIs are integers too, so recompute for each loop
+        bool* is_int = ir_ssa_integer_registers(flat);
+        int rewritten = is_int ? reduce_loop(&a, &a.loops->loops[l], is_int) : -1;
+        free(is_int);
+        if (rewritten < 0) ok = false;
+        else total += rewritten;
+    }
+
+    analysis_free(&a);
+    return ok ? total : -1;
+}
@@ -0,0 +1,156 @@
+/*
+ * GPLANG IR Optimizer
+ * The -O pipeline: self-recursive tail calls first become loops (see
+ * ir_tailrec.c). Functions are then visited bottom-up over the call graph.
+ * Each has its calls inlined (see ir_inline.c), then is flattened, run
+ * through the scalar passes in SSA form and written back, before its
+ * callers are inlined into. A second round then runs the late stages
+ * on every function: the vectorizer, only for targets whose backend
+ * lowers the IR_VEC_* instructions (x86-64), and strength reduction,
+ * which comes after it so the vectorizer still sees the
+ * multiplications it widens.
+ *
+ * With a profile (--profile-use), functions that never ran are kept
+ * small: their loops are not vectorized. Every function's blocks are
+ * then laid out along its hot paths.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+
+typedef int (*FlatPass)(IRFlatFunction* flat);
+
+typedef struct {
+    const char* name;
+    FlatPass run;
+    bool late;              // Runs in the second round
+    bool vector;            // Emits vector instructions
+} PipelineStage;
+
+static const PipelineStage pipeline[] = {
+    { "mem2reg", ir_ssa_promote, false, false },
+    { "sccp", ir_pass_sccp, false, false },
+    { "gvn", ir_pass_gvn, false, false },
+    { "licm", ir_pass_licm, false, false },
+    { "dce", ir_pass_dce, false, false },
+    { "vectorize", ir_pass_vectorize, true, true },
+    { "strength", ir_pass_strength_reduce, true, false },
+};
+
+#define PIPELINE_LENGTH ((int)(sizeof(pipeline) / sizeof(pipeline[0])))
+
+// Stats slots: the flat passes sit between those on the linked IR
+#define TAILREC_STAGE 0
+#define INLINE_STAGE 1
+#define FIRST_FLAT_STAGE 2
+#define LAYOUT_STAGE (FIRST_FLAT_STAGE + PIPELINE_LENGTH)
+
+static void record(IROptimizeStats* stats, int stage, const char* name, int before, int after, int changes) {
+    if (!stats || stage >= IR_MAX_PASSES) return;
+
+    IRPassStats* pass = &stats->passes[stage];
+    pass->name = name;
+    pass->instructions_before += before;
+    pass->instructions_after += after;
+    pass->changes += changes;
+    if (stats->pass_count <= stage) stats->pass_count = stage + 1;
+}
+
+// Run the stages of one round, skipping vector stages unless asked for
+static void optimize(IRFunction* function, bool late, bool vector, IROptimizeStats* stats) {
+    IRFlatFunction* flat = ir_flat_from_function(function);
+    if (!flat) return;
+
+    // A pass that runs out of memory leaves valid IR; skip the rest
+    bool changed = false;
+    for (int stage = 0; stage < PIPELINE_LENGTH; stage++) {
+        if (pipeline[stage].late != late || (pipeline[stage].vector && !vector)) continue;
+        int before = (int)flat->inst_count;
+        int changes = pipeline[stage].run(flat);
+        if (changes < 0) break;
+
+        record(stats, FIRST_FLAT_STAGE + stage, pipeline[stage].name, before, (int)flat->inst_count, changes);
+        changed |= changes > 0;
+    }
+
+    if (changed) ir_flat_store(flat, function);
+    ir_flat_destroy(flat);
+}
+
+// Scalar passes only: without a module there is no target to vectorize for
+void ir_optimize_function(IRFunction* function, IROptimizeStats* stats) {
+    optimize(function, false, false, stats);
+    optimize(function, true, false, stats);
+}
+
+static int instruction_count(const IRFunction* function) {
+    int count = 0;
+    for (const IRBasicBlock* block = function->blocks; block; block = block->next) {
+        for (const IRInstruction* inst = block->instructions; inst; inst = inst->next) count++;
+    }
+    return count;
+}
+
+static int module_size(const IRModule* module) {
+    int size = 0;
+    for (const IRFunction* function = module->functions; function; function = function->next) {
+        size += instruction_count(function);
+    }
+    return size;
+}
+
+// Every function is recorded, so the inline totals are whole-module sizes, as mem2reg's are
+static void optimize_inlined(IRFunction* function, int size_before, int inlined, void* context) {
+    IROptimizeStats* stats = context;
+    record(stats, INLINE_STAGE, "inline", size_before, instruction_count(function), inlined);
+    optimize(function, false, false, stats);
+}
+
+void ir_optimize_module(IRModule* module, const IRProfile* profile, IROptimizeStats* stats) {
+    if (!module) return;
+
+    int before = module_size(module);
+    int eliminated = ir_tail_recursion_module(module);
+    if (eliminated > 0) record(stats, TAILREC_STAGE, "tailrec", before, module_size(module), eliminated);
+
+    // Without memory for the call graph, optimize the functions as they are
+    if (ir_inline_module(module, profile, optimize_inlined, stats) < 0) {
+        for (IRFunction* function = module->functions; function; function = function->next) {
+            optimize(function, false, false, stats);
+        }
+    }
+
+    bool vector = module->target_triple && strcmp(module->target_triple, "x86_64") == 0;
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        long long calls;
+        bool cold = ir_profile_function_count(profile, function, &calls) && calls == 0;
+        optimize(function, true, vector && !cold, stats);
+
+        if (profile) {
+            int size = instruction_count(function);
+            int moved = ir_profile_layout(function, profile);
+            if (moved >= 0) record(stats, LAYOUT_STAGE, "layout", size, size, moved);
+        }
+    }
+}
+
+// Run a single flat pass over a linked function
+static int run_single(IRFunction* function, FlatPass pass) {
+    IRFlatFunction* flat = ir_flat_from_function(function);
+    if (!flat) return -1;
+
+    int changes = pass(flat);
+    if (changes > 0 && !ir_flat_store(flat, function)) changes = -1;
+    ir_flat_destroy(flat);
+    return changes;
+}
+
+int ir_constant_folding(IRFunction* function) {
+    return run_single(function, ir_pass_sccp);
+}
+
+int ir_dead_code_elimination(IRFunction* function) {
+    return run_single(function, ir_pass_dce);
+}
@@ -0,0 +1,49 @@
+/*
+ * GPLANG Optimization Passes
+ * Scalar passes over the flat IR. Each returns the number of changes it
+ * made, or -1 if it ran out of memory (the function is left valid).
+ * ir_optimize_function runs them in order on SSA form.
+ */
+
+#ifndef GPLANG_IR_PASSES_H
+#define GPLANG_IR_PASSES_H
+
+#include "ir_flat.h"
+#include "ir_ssa.h"
+
+// Sparse conditional constant propagation: folds constant values and
+// branches, removes blocks no executable edge reaches
+int ir_pass_sccp(IRFlatFunction* flat);
+
+// Mark-and-sweep dead code elimination from side-effecting roots
+int ir_pass_dce(IRFlatFunction* flat);
+
+// Dominator-scoped global value numbering: removes pure instructions and
+// loads that repeat an available (opcode, operands) value
+int ir_pass_gvn(IRFlatFunction* flat);
+
+// Moves pure, non-trapping loop invariants into loop preheaders
+int ir_pass_licm(IRFlatFunction* flat);
+
+// Replaces multiplications of induction variables by invariants with
+// PHIs stepped by addition
+int ir_pass_strength_reduce(IRFlatFunction* flat);
+
+// Runs counted integer sum loops IR_VECTOR_LANES iterations at a time
+// with IR_VEC_* instructions, ahead of the original loop as the epilogue
+int ir_pass_vectorize(IRFlatFunction* flat);
+
+// Self-recursive tail calls, and linear recursion through an integer
+// add or mul, turned into loops on the linked IR. Returns the number of
+// calls removed, or -1 if it ran out of memory.
+int ir_tail_recursion_module(IRModule* module);
+
+// Bottom-up inlining over the call graph, on the linked IR. Each function
+// has its calls inlined, then visit(function, size_before, inlined,
+// context) runs on it before any caller inlines it; size_before is its
+// instruction count, NOPs and allocas included, ahead of inlining. Returns the number of call sites
+// inlined, or -1 if it ran out of memory.
+typedef void (*IRInlineVisit)(IRFunction* function, int size_before, int inlined, void* context);
+int ir_inline_module(IRModule* module, const IRProfile* profile, IRInlineVisit visit, void* context);
+
+#endif // GPLANG_IR_PASSES_H
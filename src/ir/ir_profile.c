@@ -0,0 +1,379 @@
+/*
+ * GPLANG Block Profiles
+ * --instrument gives every block of the frontend IR a counter, a module
+ * global bumped on entry to the block. When main returns, a generated
+ * __profile_write function hands each count to the runtime, which
+ * writes them to <module>.gpprof (or $GPLANG_PROFILE) as lines of
+ *
+ *     function block count
+ *
+ * --profile-use reads such a file back. Counters are placed before any
+ * optimization, so the labels match those of the frontend IR whether or
+ * not the instrumented build used -O, and blocks the optimizer adds
+ * later simply have no count. Lines for the same block are summed, so
+ * the profiles of several runs can be concatenated.
+ *
+ * ir_profile_layout orders a function's blocks along the hottest paths,
+ * so the backends fall through to the likely successor, and moves
+ * blocks that never ran to the end (hot/cold splitting within the
+ * function).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir.h"
+
+extern char* my_strdup(const char* s);
+
+#define PROFILE_WRITER "__profile_write"
+
+typedef struct {
+    char* function;
+    char* block;
+    long long count;
+} IRProfileEntry;
+
+struct IRProfile {
+    IRProfileEntry* entries;        // Sorted by function, then block
+    int count;
+};
+
+// Counter globals are named prof.<n>: no GPLANG identifier contains a dot
+static IRValue* counter_global(int counter) {
+    char name[32];
+    snprintf(name, sizeof(name), "prof.%d", counter);
+    return ir_value_create_global(name);
+}
+
+// Move the instructions built in scratch to the head of block, after its PHIs
+static void insert_at_head(IRBasicBlock* block, IRBasicBlock* scratch) {
+    if (!scratch->instructions) return;
+
+    IRInstruction* after = NULL;
+    for (IRInstruction* inst = block->instructions; inst && inst->opcode == IR_PHI; inst = inst->next) {
+        after = inst;
+    }
+    IRInstruction** link = after ? &after->next : &block->instructions;
+    scratch->last_instruction->next = *link;
+    if (!*link) block->last_instruction = scratch->last_instruction;
+    *link = scratch->instructions;
+
+    scratch->instructions = NULL;
+    scratch->last_instruction = NULL;
+}
+
+// load/add/store of the block's counter
+static bool count_block(IRBuilder* builder, IRBasicBlock* block, int counter) {
+    IRBasicBlock* scratch = ir_basic_block_create("profile");
+    IRValue* global = counter_global(counter);
+    IRValue* one = ir_value_create_constant_int(1);
+    bool ok = scratch && global && one;
+
+    if (ok) {
+        ir_builder_set_block(builder, scratch);
+        IRValue* old = ir_builder_load(builder, global);
+        IRValue* bumped = old ? ir_builder_add(builder, old, one) : NULL;
+        if (bumped) ir_builder_store(builder, bumped, global);
+        ok = bumped != NULL;
+        insert_at_head(block, scratch);
+    }
+
+    ir_value_destroy(one);
+    ir_value_destroy(global);
+    ir_basic_block_destroy(scratch);
+    return ok;
+}
+
+// __profile_write(): one runtime call per counter, in counter order
+static IRFunction* build_writer(IRBuilder* builder, IRModule* module, int counters) {
+    IRFunction* writer = ir_function_create(PROFILE_WRITER);
+    IRBasicBlock* entry = writer ? ir_basic_block_create("entry") : NULL;
+    if (!entry) {
+        ir_function_destroy(writer);
+        return NULL;
+    }
+    ir_function_add_block(writer, entry);
+    ir_builder_set_function(builder, writer);
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s.gpprof", module->name ? module->name : "gplang");
+    IRValue* args[3] = { ir_value_create_constant_string(path), NULL, NULL };
+    ir_builder_call(builder, "gp_rt_profile_open", args, 1);
+    ir_value_destroy(args[0]);
+
+    int counter = 0;
+    for (IRFunction* function = module->functions; function && counter < counters; function = function->next) {
+        for (IRBasicBlock* block = function->blocks; block && counter < counters; block = block->next) {
+            IRValue* global = counter_global(counter++);
+            args[0] = ir_value_create_constant_string(function->name);
+            args[1] = ir_value_create_constant_string(block->label);
+            args[2] = ir_builder_load(builder, global);
+            ir_builder_call(builder, "gp_rt_profile_count", args, 3);
+            ir_value_destroy(args[0]);
+            ir_value_destroy(args[1]);
+            ir_value_destroy(global);
+        }
+    }
+    ir_builder_call(builder, "gp_rt_profile_close", NULL, 0);
+    ir_builder_return(builder, NULL);
+    return writer;
+}
+
+// call __profile_write() ahead of every return in main
+static void write_on_return(IRFunction* function) {
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        IRInstruction* previous = NULL;
+        for (IRInstruction* inst = block->instructions; inst; previous = inst, inst = inst->next) {
+            if (inst->opcode != IR_RETURN) continue;
+
+            IRInstruction* call = ir_instruction_create(IR_CALL);
+            if (!call) return;
+            ir_instruction_set_src(call, 1, ir_value_create_global(PROFILE_WRITER));
+            call->next = inst;
+            if (previous) previous->next = call;
+            else block->instructions = call;
+            previous = call;
+        }
+    }
+}
+
+int ir_profile_instrument(IRModule* module) {
+    if (!module) return -1;
+
+    IRFunction* main_function = NULL;
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        if (strcmp(function->name, "main") == 0) main_function = function;
+    }
+    if (!main_function) return 0;    // Nothing would ever write the counts
+
+    IRBuilder* builder = ir_builder_create(module);
+    if (!builder) return -1;
+
+    int counters = 0;
+    bool ok = true;
+    for (IRFunction* function = module->functions; function && ok; function = function->next) {
+        ir_builder_set_function(builder, function);
+        for (IRBasicBlock* block = function->blocks; block && ok; block = block->next) {
+            ok = count_block(builder, block, counters++);
+        }
+    }
+
+    IRFunction* writer = ok ? build_writer(builder, module, counters) : NULL;
+    ir_builder_destroy(builder);
+    if (!writer) return -1;
+
+    write_on_return(main_function);
+    ir_module_add_function(module, writer);
+    return counters;
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const IRProfileEntry* left = a;
+    const IRProfileEntry* right = b;
+    int order = strcmp(left->function, right->function);
+    return order ? order : strcmp(left->block, right->block);
+}
+
+void ir_profile_destroy(IRProfile* profile) {
+    if (!profile) return;
+
+    for (int i = 0; i < profile->count; i++) {
+        free(profile->entries[i].function);
+        free(profile->entries[i].block);
+    }
+    free(profile->entries);
+    free(profile);
+}
+
+// Parse "function block count"; false for malformed lines
+static bool parse_line(char* line, IRProfileEntry* entry) {
+    char* save = NULL;
+    char* function = strtok_r(line, " \t\r\n", &save);
+    char* block = function ? strtok_r(NULL, " \t\r\n", &save) : NULL;
+    char* count = block ? strtok_r(NULL, " \t\r\n", &save) : NULL;
+    if (!count || strtok_r(NULL, " \t\r\n", &save)) return false;
+
+    char* end;
+    entry->count = strtoll(count, &end, 10);
+    if (*end || entry->count < 0) return false;
+    entry->function = my_strdup(function);
+    entry->block = my_strdup(block);
+    return entry->function && entry->block;
+}
+
+IRProfile* ir_profile_load(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) return NULL;
+
+    IRProfile* profile = calloc(1, sizeof(IRProfile));
+    int capacity = 0;
+    bool ok = profile != NULL;
+    char line[1024];
+    while (ok && fgets(line, sizeof(line), file)) {
+        char* start = line + strspn(line, " \t\r\n");
+        if (*start == '\0' || *start == '#') continue;
+
+        if (profile->count == capacity) {
+            capacity = capacity ? capacity * 2 : 256;
+            IRProfileEntry* grown = realloc(profile->entries, capacity * sizeof(IRProfileEntry));
+            if (!grown) {
+                ok = false;
+                break;
+            }
+            profile->entries = grown;
+        }
+        IRProfileEntry* entry = &profile->entries[profile->count];
+        entry->function = entry->block = NULL;
+        ok = parse_line(start, entry);
+        if (ok) {
+            profile->count++;
+        } else {
+            free(entry->function);
+            free(entry->block);
+        }
+    }
+    fclose(file);
+    if (!ok) {
+        ir_profile_destroy(profile);
+        return NULL;
+    }
+
+    // Sort, then sum repeated blocks into their first entry
+    qsort(profile->entries, profile->count, sizeof(IRProfileEntry), compare_entries);
+    int unique = 0;
+    for (int i = 0; i < profile->count; i++) {
+        IRProfileEntry* entry = &profile->entries[i];
+        if (unique > 0 && compare_entries(&profile->entries[unique - 1], entry) == 0) {
+            profile->entries[unique - 1].count += entry->count;
+            free(entry->function);
+            free(entry->block);
+        } else {
+            profile->entries[unique++] = *entry;
+        }
+    }
+    profile->count = unique;
+    return profile;
+}
+
+bool ir_profile_block_count(const IRProfile* profile, const char* function, const char* block, long long* count) {
+    if (!profile || !function || !block) return false;
+
+    IRProfileEntry key = { (char*)function, (char*)block, 0 };
+    const IRProfileEntry* entry = bsearch(&key, profile->entries, profile->count,
+                                          sizeof(IRProfileEntry), compare_entries);
+    if (entry && count) *count = entry->count;
+    return entry != NULL;
+}
+
+bool ir_profile_function_count(const IRProfile* profile, const IRFunction* function, long long* count) {
+    return function && function->blocks &&
+           ir_profile_block_count(profile, function->name, function->blocks->label, count);
+}
+
+typedef struct {
+    IRBasicBlock* block;
+    long long count;
+    bool known;                 // Has a profile entry
+    bool cold;                  // Profiled and never ran
+    bool placed;
+    int successors[2];          // Indices, -1 if none
+} LayoutBlock;
+
+static int find_label(const LayoutBlock* blocks, int count, const IRValue* label) {
+    if (!label || label->type != IR_VALUE_LABEL) return -1;
+    for (int i = 0; i < count; i++) {
+        if (strcmp(blocks[i].block->label, label->label) == 0) return i;
+    }
+    return -1;
+}
+
+// Read the successors from each terminator; counts for blocks without
+// a profile entry come from their hottest predecessor
+static void describe_blocks(LayoutBlock* blocks, int count) {
+    for (int i = 0; i < count; i++) {
+        IRInstruction* last = blocks[i].block->last_instruction;
+        blocks[i].successors[0] = blocks[i].successors[1] = -1;
+        if (last && last->opcode == IR_JUMP) {
+            blocks[i].successors[0] = find_label(blocks, count, last->src1);
+        } else if (last && last->opcode == IR_BRANCH) {
+            blocks[i].successors[0] = find_label(blocks, count, last->src2);
+            blocks[i].successors[1] = find_label(blocks, count, last->src3);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        for (int s = 0; s < 2; s++) {
+            int succ = blocks[i].successors[s];
+            if (succ >= 0 && !blocks[succ].known && blocks[i].count > blocks[succ].count) {
+                blocks[succ].count = blocks[i].count;
+            }
+        }
+    }
+}
+
+int ir_profile_layout(IRFunction* function, const IRProfile* profile) {
+    if (!function || !profile || !function->blocks) return 0;
+
+    int count = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) count++;
+    LayoutBlock* blocks = calloc(count, sizeof(LayoutBlock));
+    IRBasicBlock** order = malloc(count * sizeof(IRBasicBlock*));
+    if (!blocks || !order) {
+        free(blocks);
+        free(order);
+        return -1;
+    }
+
+    int known = 0, i = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next, i++) {
+        blocks[i].block = block;
+        if (ir_profile_block_count(profile, function->name, block->label, &blocks[i].count)) {
+            blocks[i].known = true;
+            blocks[i].cold = blocks[i].count == 0;
+            known++;
+        }
+    }
+    if (known == 0) {
+        free(blocks);
+        free(order);
+        return 0;
+    }
+    describe_blocks(blocks, count);
+
+    // Chains from the entry: after each block, its hottest unplaced
+    // successor; when there is none, the next warm block in source order
+    int placed = 0, current = 0;
+    blocks[0].placed = true;
+    order[placed++] = blocks[0].block;
+    while (current >= 0) {
+        int next = -1;
+        for (int s = 0; s < 2; s++) {
+            int succ = blocks[current].successors[s];
+            if (succ < 0 || blocks[succ].placed || blocks[succ].cold) continue;
+            if (next < 0 || blocks[succ].count > blocks[next].count) next = succ;
+        }
+        for (int b = 0; next < 0 && b < count; b++) {
+            if (!blocks[b].placed && !blocks[b].cold) next = b;
+        }
+        if (next >= 0) {
+            blocks[next].placed = true;
+            order[placed++] = blocks[next].block;
+        }
+        current = next;
+    }
+    for (int b = 0; b < count; b++) {
+        if (!blocks[b].placed) order[placed++] = blocks[b].block;
+    }
+
+    int moved = 0;
+    for (int b = 0; b < count; b++) {
+        if (order[b] != blocks[b].block) moved++;
+        order[b]->next = b + 1 < count ? order[b + 1] : NULL;
+    }
+    function->blocks = order[0];
+    function->last_block = order[count - 1];
+
+    free(blocks);
+    free(order);
+    return moved;
+}
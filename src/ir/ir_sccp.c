@@ -0,0 +1,487 @@
+/*
+ * GPLANG Sparse Conditional Constant Propagation
+ * Wegman-Zadeck SCCP over the flat IR: values and CFG edges are
+ * discovered together, so constants flowing only along executable paths
+ * still fold, and branches on them are resolved
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "ir_passes.h"
+
+typedef enum {
+    LATTICE_TOP,        // No value seen yet
+    LATTICE_CONST,      // Always this constant
+    LATTICE_BOTTOM      // Varies at run time
+} LatticeState;
+
+typedef struct {
+    LatticeState state;
+    bool is_float;
+    long long int_value;
+    double float_value;
+} Lattice;
+
+typedef struct {
+    IRFlatFunction* flat;
+    uint32_t reg_count;
+    Lattice* values;            // Per register
+
+    uint32_t* inst_block;       // Block of each instruction
+    uint32_t* use_first;        // uses[use_first[r] .. use_first[r + 1]): instructions reading r
+    uint32_t* uses;
+
+    bool* block_executable;
+    bool* edge_executable;      // Per predecessor slot in flat->edges
+
+    uint32_t* block_work;
+    uint32_t block_work_count;
+    uint32_t* reg_work;         // A register is lowered at most twice
+    uint32_t reg_work_count;
+} SCCP;
+
+static const Lattice bottom = { LATTICE_BOTTOM, false, 0, 0.0 };
+static const Lattice top = { LATTICE_TOP, false, 0, 0.0 };
+
+static Lattice int_lattice(long long value) {
+    Lattice lattice = { LATTICE_CONST, false, value, 0.0 };
+    return lattice;
+}
+
+static Lattice float_lattice(double value) {
+    Lattice lattice = { LATTICE_CONST, true, 0, value };
+    return lattice;
+}
+
+static bool same_constant(const Lattice* a, const Lattice* b) {
+    if (a->is_float != b->is_float) return false;
+    if (a->is_float) return memcmp(&a->float_value, &b->float_value, sizeof(double)) == 0;
+    return a->int_value == b->int_value;
+}
+
+static Lattice meet(Lattice a, Lattice b) {
+    if (a.state == LATTICE_TOP) return b;
+    if (b.state == LATTICE_TOP) return a;
+    if (a.state == LATTICE_BOTTOM || b.state == LATTICE_BOTTOM) return bottom;
+    return same_constant(&a, &b) ? a : bottom;
+}
+
+static Lattice operand_value(const SCCP* s, IRFlatOperand operand) {
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_REG: {
+            uint32_t reg = ir_flat_payload(operand);
+            return reg < s->reg_count ? s->values[reg] : bottom;
+        }
+        case IR_FLAT_IMM:
+        case IR_FLAT_INT:
+            return int_lattice(ir_flat_int_value(s->flat, operand));
+        case IR_FLAT_FLOAT:
+            return float_lattice(ir_flat_float_value(s->flat, operand));
+        default:
+            return bottom;
+    }
+}
+
+static Lattice fold_float(IROpcode opcode, double a, double b) {
+    switch (opcode) {
+        case IR_ADD: return float_lattice(a + b);
+        case IR_SUB: return float_lattice(a - b);
+        case IR_MUL: return float_lattice(a * b);
+        case IR_DIV: return b != 0.0 ? float_lattice(a / b) : bottom;
+        case IR_EQ: return int_lattice(a == b);
+        case IR_NE: return int_lattice(a != b);
+        case IR_LT: return int_lattice(a < b);
+        case IR_LE: return int_lattice(a <= b);
+        case IR_GT: return int_lattice(a > b);
+        case IR_GE: return int_lattice(a >= b);
+        default: return bottom;
+    }
+}
+
+// Integer arithmetic wraps; division by zero is left for run time
+static Lattice fold_int(IROpcode opcode, long long a, long long b) {
+    unsigned long long ua = (unsigned long long)a, ub = (unsigned long long)b;
+    switch (opcode) {
+        case IR_ADD: return int_lattice((long long)(ua + ub));
+        case IR_SUB: return int_lattice((long long)(ua - ub));
+        case IR_MUL: return int_lattice((long long)(ua * ub));
+        case IR_DIV:
+            if (b == 0 || (a == LLONG_MIN && b == -1)) return bottom;
+            return int_lattice(a / b);
+        case IR_MOD:
+            if (b == 0 || (a == LLONG_MIN && b == -1)) return bottom;
+            return int_lattice(a % b);
+        case IR_EQ: return int_lattice(a == b);
+        case IR_NE: return int_lattice(a != b);
+        case IR_LT: return int_lattice(a < b);
+        case IR_LE: return int_lattice(a <= b);
+        case IR_GT: return int_lattice(a > b);
+        case IR_GE: return int_lattice(a >= b);
+        case IR_AND: return int_lattice(a && b);
+        case IR_OR: return int_lattice(a || b);
+        default: return bottom;
+    }
+}
+
+static Lattice evaluate(const SCCP* s, const IRFlatInst* inst) {
+    switch (inst->opcode) {
+        case IR_CONST_INT:
+        case IR_CONST_FLOAT:
+            return operand_value(s, inst->src[0]);
+
+        case IR_NOT: {
+            Lattice a = operand_value(s, inst->src[0]);
+            if (a.state != LATTICE_CONST) return a;
+            return a.is_float ? bottom : int_lattice(!a.int_value);
+        }
+
+        case IR_ADD: case IR_SUB: case IR_MUL: case IR_DIV: case IR_MOD:
+        case IR_EQ: case IR_NE: case IR_LT: case IR_LE: case IR_GT: case IR_GE:
+        case IR_AND: case IR_OR: {
+            Lattice a = operand_value(s, inst->src[0]);
+            Lattice b = operand_value(s, inst->src[1]);
+            if (a.state == LATTICE_BOTTOM || b.state == LATTICE_BOTTOM) return bottom;
+            if (a.state == LATTICE_TOP || b.state == LATTICE_TOP) return top;
+            if (a.is_float || b.is_float) {
+                return fold_float(inst->opcode,
+                                  a.is_float ? a.float_value : (double)a.int_value,
+                                  b.is_float ? b.float_value : (double)b.int_value);
+            }
+            return fold_int(inst->opcode, a.int_value, b.int_value);
+        }
+
+        default:
+            return bottom;
+    }
+}
+
+static void lower(SCCP* s, IRFlatOperand dest, Lattice value) {
+    if (ir_flat_kind(dest) != IR_FLAT_REG || ir_flat_payload(dest) >= s->reg_count) return;
+
+    uint32_t reg = ir_flat_payload(dest);
+    Lattice merged = meet(s->values[reg], value);
+    Lattice* old = &s->values[reg];
+    if (merged.state == old->state && (merged.state != LATTICE_CONST || same_constant(&merged, old))) return;
+
+    *old = merged;
+    s->reg_work[s->reg_work_count++] = reg;
+}
+
+static void visit_inst(SCCP* s, uint32_t i);
+
+static void mark_edge(SCCP* s, uint32_t from, uint32_t to) {
+    IRFlatFunction* flat = s->flat;
+    if (to >= flat->block_count) return;
+
+    const IRFlatBlock* block = &flat->blocks[to];
+    bool changed = false;
+    for (uint32_t p = 0; p < block->pred_count; p++) {
+        uint32_t slot = block->first_pred + p;
+        if (flat->edges[slot] == from && !s->edge_executable[slot]) {
+            s->edge_executable[slot] = true;
+            changed = true;
+        }
+    }
+    if (!changed) return;
+
+    if (!s->block_executable[to]) {
+        s->block_executable[to] = true;
+        s->block_work[s->block_work_count++] = to;
+    } else {
+        // Only the PHIs can see a new incoming edge
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            if (flat->insts[i].opcode == IR_PHI) visit_inst(s, i);
+        }
+    }
+}
+
+static bool edge_is_executable(const SCCP* s, uint32_t from, uint32_t to) {
+    const IRFlatBlock* block = &s->flat->blocks[to];
+    for (uint32_t p = 0; p < block->pred_count; p++) {
+        uint32_t slot = block->first_pred + p;
+        if (s->flat->edges[slot] == from && s->edge_executable[slot]) return true;
+    }
+    return false;
+}
+
+static void visit_inst(SCCP* s, uint32_t i) {
+    IRFlatFunction* flat = s->flat;
+    const IRFlatInst* inst = &flat->insts[i];
+    uint32_t b = s->inst_block[i];
+    if (!s->block_executable[b]) return;
+
+    switch (inst->opcode) {
+        case IR_PHI: {
+            Lattice value = top;
+            for (uint32_t a = 0; a + 1 < inst->arg_count; a += 2) {
+                IRFlatOperand label = flat->args[inst->first_arg + a + 1];
+                if (ir_flat_kind(label) != IR_FLAT_LABEL ||
+                    !edge_is_executable(s, ir_flat_payload(label), b)) continue;
+                value = meet(value, operand_value(s, flat->args[inst->first_arg + a]));
+            }
+            lower(s, inst->dest, value);
+            break;
+        }
+
+        case IR_JUMP:
+            if (ir_flat_kind(inst->src[0]) == IR_FLAT_LABEL) mark_edge(s, b, ir_flat_payload(inst->src[0]));
+            break;
+
+        case IR_BRANCH: {
+            Lattice condition = operand_value(s, inst->src[0]);
+            if (condition.state == LATTICE_TOP) break;
+
+            bool taken[2] = { true, true };
+            if (condition.state == LATTICE_CONST) {
+                bool truth = condition.is_float ? condition.float_value != 0.0 : condition.int_value != 0;
+                taken[0] = truth;
+                taken[1] = !truth;
+            }
+            for (int t = 0; t < 2; t++) {
+                IRFlatOperand target = inst->src[1 + t];
+                if (taken[t] && ir_flat_kind(target) == IR_FLAT_LABEL) mark_edge(s, b, ir_flat_payload(target));
+            }
+            break;
+        }
+
+        default:
+            if (ir_flat_kind(inst->dest) == IR_FLAT_REG) lower(s, inst->dest, evaluate(s, inst));
+            break;
+    }
+}
+
+static bool build_uses(SCCP* s) {
+    IRFlatFunction* flat = s->flat;
+    s->use_first = calloc(s->reg_count + 1, sizeof(uint32_t));
+    if (!s->use_first) return false;
+
+    // Count, then fill each list backwards from its end so the starts
+    // land in use_first and every list is in instruction order
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            uint32_t end = 0;
+            for (uint32_t r = 0; r < s->reg_count; r++) {
+                end += s->use_first[r];
+                s->use_first[r] = end;
+            }
+            s->use_first[s->reg_count] = end;
+            s->uses = malloc((end ? end : 1) * sizeof(uint32_t));
+            if (!s->uses) return false;
+        }
+        for (uint32_t n = flat->inst_count; n > 0; n--) {
+            uint32_t i = n - 1;
+            const IRFlatInst* inst = &flat->insts[i];
+            for (uint32_t o = 0; o < 3 + inst->arg_count; o++) {
+                IRFlatOperand operand = o < 3 ? inst->src[o] : flat->args[inst->first_arg + o - 3];
+                if (ir_flat_kind(operand) != IR_FLAT_REG || ir_flat_payload(operand) >= s->reg_count) continue;
+
+                uint32_t reg = ir_flat_payload(operand);
+                if (pass == 0) s->use_first[reg]++;
+                else s->uses[--s->use_first[reg]] = i;
+            }
+        }
+    }
+    return true;
+}
+
+static void propagate(SCCP* s) {
+    s->block_executable[0] = true;
+    s->block_work[s->block_work_count++] = 0;
+
+    while (s->block_work_count > 0 || s->reg_work_count > 0) {
+        while (s->reg_work_count > 0) {
+            uint32_t reg = s->reg_work[--s->reg_work_count];
+            for (uint32_t u = s->use_first[reg]; u < s->use_first[reg + 1]; u++) visit_inst(s, s->uses[u]);
+        }
+        if (s->block_work_count > 0) {
+            const IRFlatBlock* block = &s->flat->blocks[s->block_work[--s->block_work_count]];
+            for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) visit_inst(s, i);
+        }
+    }
+}
+
+static IRFlatOperand constant_operand(IRFlatFunction* flat, const Lattice* value) {
+    return value->is_float ? ir_flat_float_operand(flat, value->float_value)
+                           : ir_flat_int_operand(flat, value->int_value);
+}
+
+static IRFlatOperand substitute(const SCCP* s, IRFlatOperand operand) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG || ir_flat_payload(operand) >= s->reg_count) return operand;
+
+    const Lattice* value = &s->values[ir_flat_payload(operand)];
+    return value->state == LATTICE_CONST ? constant_operand(s->flat, value) : operand;
+}
+
+// Replace constant registers by their values, fold branches, drop dead blocks
+static int rewrite(SCCP* s) {
+    IRFlatFunction* flat = s->flat;
+    bool* dead_insts = calloc(flat->inst_count ? flat->inst_count : 1, sizeof(bool));
+    bool* dead_blocks = calloc(flat->block_count, sizeof(bool));
+    if (!dead_insts || !dead_blocks) {
+        free(dead_insts);
+        free(dead_blocks);
+        return -1;
+    }
+
+    int changes = 0;
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* block = &flat->blocks[b];
+        if (!s->block_executable[b]) {
+            dead_blocks[b] = true;
+            changes++;
+            continue;
+        }
+
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            IRFlatInst* inst = &flat->insts[i];
+            for (int o = 0; o < 3; o++) inst->src[o] = substitute(s, inst->src[o]);
+            for (uint32_t a = 0; a < inst->arg_count; a++) {
+                flat->args[inst->first_arg + a] = substitute(s, flat->args[inst->first_arg + a]);
+            }
+
+            if (ir_flat_kind(inst->dest) == IR_FLAT_REG && ir_flat_payload(inst->dest) < s->reg_count &&
+                inst->opcode != IR_CONST_INT && inst->opcode != IR_CONST_FLOAT) {
+                const Lattice* value = &s->values[ir_flat_payload(inst->dest)];
+                if (value->state == LATTICE_CONST) {
+                    if (inst->opcode == IR_PHI) {
+                        dead_insts[i] = true;       // PHIs must stay at the block head
+                    } else {
+                        inst->opcode = value->is_float ? IR_CONST_FLOAT : IR_CONST_INT;
+                        inst->src[0] = constant_operand(flat, value);
+                        inst->src[1] = inst->src[2] = IR_FLAT_NO_OPERAND;
+                        inst->arg_count = 0;
+                    }
+                    changes++;
+                }
+            }
+
+            if (inst->opcode == IR_BRANCH && ir_flat_is_int_constant(inst->src[0])) {
+                IRFlatOperand target = ir_flat_int_value(flat, inst->src[0]) ? inst->src[1] : inst->src[2];
+                inst->opcode = IR_JUMP;
+                inst->src[0] = target;
+                inst->src[1] = inst->src[2] = IR_FLAT_NO_OPERAND;
+                changes++;
+            }
+        }
+    }
+
+    bool ok = ir_flat_compact(flat, dead_insts, dead_blocks);
+    free(dead_insts);
+    free(dead_blocks);
+    return ok ? changes : -1;
+}
+
+static IRFlatOperand resolve(const IRFlatOperand* value_of, uint32_t reg_count, IRFlatOperand operand) {
+    while (ir_flat_kind(operand) == IR_FLAT_REG && ir_flat_payload(operand) < reg_count &&
+           value_of[ir_flat_payload(operand)] != IR_FLAT_NO_OPERAND) {
+        operand = value_of[ir_flat_payload(operand)];
+    }
+    return operand;
+}
+
+/*
+ * Once branches fold, PHIs often merge a single value (or one value and
+ * themselves); forward that value to the PHI's users
+ */
+static int simplify_phis(IRFlatFunction* flat) {
+    uint32_t reg_count = (uint32_t)flat->next_register_id;
+    IRFlatOperand* value_of = calloc(reg_count ? reg_count : 1, sizeof(IRFlatOperand));
+    bool* dead_insts = calloc(flat->inst_count ? flat->inst_count : 1, sizeof(bool));
+    if (!value_of || !dead_insts) {
+        free(value_of);
+        free(dead_insts);
+        return -1;
+    }
+
+    int removed = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t i = 0; i < flat->inst_count; i++) {
+            const IRFlatInst* inst = &flat->insts[i];
+            if (inst->opcode != IR_PHI || dead_insts[i] || inst->arg_count == 0 ||
+                ir_flat_kind(inst->dest) != IR_FLAT_REG || ir_flat_payload(inst->dest) >= reg_count) continue;
+
+            IRFlatOperand unique = IR_FLAT_NO_OPERAND;
+            bool trivial = true;
+            for (uint32_t a = 0; trivial && a < inst->arg_count; a += 2) {
+                IRFlatOperand value = resolve(value_of, reg_count, flat->args[inst->first_arg + a]);
+                if (value == inst->dest) continue;
+                if (unique == IR_FLAT_NO_OPERAND) unique = value;
+                else if (unique != value) trivial = false;
+            }
+            if (!trivial || unique == IR_FLAT_NO_OPERAND) continue;
+
+            value_of[ir_flat_payload(inst->dest)] = unique;
+            dead_insts[i] = true;
+            removed++;
+            changed = true;
+        }
+    }
+
+    bool ok = true;
+    if (removed > 0) {
+        for (uint32_t i = 0; i < flat->inst_count; i++) {
+            IRFlatInst* inst = &flat->insts[i];
+            for (int o = 0; o < 3; o++) inst->src[o] = resolve(value_of, reg_count, inst->src[o]);
+            for (uint32_t a = 0; a < inst->arg_count; a++) {
+                flat->args[inst->first_arg + a] = resolve(value_of, reg_count, flat->args[inst->first_arg + a]);
+            }
+        }
+        ok = ir_flat_compact(flat, dead_insts, NULL);
+    }
+
+    free(value_of);
+    free(dead_insts);
+    return ok ? removed : -1;
+}
+
+int ir_pass_sccp(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    SCCP s = { 0 };
+    s.flat = flat;
+    s.reg_count = (uint32_t)flat->next_register_id;
+    s.values = calloc(s.reg_count ? s.reg_count : 1, sizeof(Lattice));
+    s.inst_block = malloc((flat->inst_count ? flat->inst_count : 1) * sizeof(uint32_t));
+    s.block_executable = calloc(flat->block_count, sizeof(bool));
+    s.edge_executable = calloc(flat->edge_count ? flat->edge_count : 1, sizeof(bool));
+    s.block_work = malloc(flat->block_count * sizeof(uint32_t));
+    s.reg_work = malloc((2 * s.reg_count + 1) * sizeof(uint32_t));
+
+    int changes = -1;
+    if (s.values && s.inst_block && s.block_executable && s.edge_executable &&
+        s.block_work && s.reg_work && build_uses(&s)) {
+        // Parameters and anything defined outside the function vary
+        for (uint32_t r = 0; r < s.reg_count; r++) s.values[r] = bottom;
+        for (uint32_t i = 0; i < flat->inst_count; i++) {
+            IRFlatOperand dest = flat->insts[i].dest;
+            if (ir_flat_kind(dest) == IR_FLAT_REG && ir_flat_payload(dest) < s.reg_count) {
+                s.values[ir_flat_payload(dest)] = top;
+            }
+        }
+        for (uint32_t b = 0; b < flat->block_count; b++) {
+            const IRFlatBlock* block = &flat->blocks[b];
+            for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) s.inst_block[i] = b;
+        }
+
+        propagate(&s);
+        changes = rewrite(&s);
+        if (changes >= 0) {
+            int simplified = simplify_phis(flat);
+            changes = simplified < 0 ? -1 : changes + simplified;
+        }
+    }
+
+    free(s.values);
+    free(s.inst_block);
+    free(s.use_first);
+    free(s.uses);
+    free(s.block_executable);
+    free(s.edge_executable);
+    free(s.block_work);
+    free(s.reg_work);
+    return changes;
+}
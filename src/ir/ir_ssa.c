@@ -0,0 +1,965 @@
+/*
+ * GPLANG SSA Construction
+ * Dominators (Cooper-Harvey-Kennedy), dominance frontiers and mem2reg
+ * (Cytron et al.) over the flat IR
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_ssa.h"
+
+static bool grow(void** data, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) return true;
+
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) new_capacity *= 2;
+
+    void* grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) return false;
+    *data = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+static uint32_t* block_array(uint32_t count, uint32_t fill) {
+    uint32_t* array = malloc((count ? count : 1) * sizeof(uint32_t));
+    if (array) {
+        for (uint32_t i = 0; i < count; i++) array[i] = fill;
+    }
+    return array;
+}
+
+// ============================================================================
+// DOMINATORS
+// ============================================================================
+
+// Reachable blocks from the entry in reverse postorder (iterative DFS)
+static bool compute_order(const IRFlatFunction* flat, IRDominators* dom) {
+    uint32_t n = flat->block_count;
+    uint32_t* stack = malloc((n ? n : 1) * sizeof(uint32_t));
+    uint32_t* next_succ = block_array(n, 0);
+    uint32_t* postorder = malloc((n ? n : 1) * sizeof(uint32_t));
+    bool* visited = calloc(n ? n : 1, sizeof(bool));
+    if (!stack || !next_succ || !postorder || !visited) {
+        free(stack);
+        free(next_succ);
+        free(postorder);
+        free(visited);
+        return false;
+    }
+
+    uint32_t depth = 0, count = 0;
+    if (n > 0) {
+        stack[depth++] = 0;
+        visited[0] = true;
+    }
+    while (depth > 0) {
+        uint32_t b = stack[depth - 1];
+        const IRFlatBlock* block = &flat->blocks[b];
+        if (next_succ[b] < block->succ_count) {
+            uint32_t s = flat->edges[block->first_succ + next_succ[b]++];
+            if (s < n && !visited[s]) {
+                visited[s] = true;
+                stack[depth++] = s;
+            }
+        } else {
+            postorder[count++] = b;
+            depth--;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        dom->order[i] = postorder[count - 1 - i];
+        dom->rpo_number[dom->order[i]] = i;
+    }
+    dom->order_count = count;
+
+    free(stack);
+    free(next_succ);
+    free(postorder);
+    free(visited);
+    return true;
+}
+
+static uint32_t intersect(const IRDominators* dom, uint32_t a, uint32_t b) {
+    while (a != b) {
+        while (dom->rpo_number[a] > dom->rpo_number[b]) a = dom->idom[a];
+        while (dom->rpo_number[b] > dom->rpo_number[a]) b = dom->idom[b];
+    }
+    return a;
+}
+
+// Dominator tree children in CSR form, plus DFS intervals for dominance queries
+static bool compute_tree(IRDominators* dom) {
+    uint32_t n = dom->block_count;
+    dom->first_child = block_array(n, 0);
+    dom->child_count = block_array(n, 0);
+    dom->children = block_array(n, 0);
+    dom->tree_in = block_array(n, IR_DOM_NONE);
+    dom->tree_out = block_array(n, IR_DOM_NONE);
+    uint32_t* stack = block_array(n, 0);
+    uint32_t* next_child = block_array(n, 0);
+    bool ok = dom->first_child && dom->child_count && dom->children &&
+              dom->tree_in && dom->tree_out && stack && next_child;
+
+    if (ok) {
+        for (uint32_t b = 0; b < n; b++) {
+            if (dom->idom[b] != IR_DOM_NONE) dom->child_count[dom->idom[b]]++;
+        }
+        uint32_t offset = 0;
+        for (uint32_t b = 0; b < n; b++) {
+            dom->first_child[b] = offset;
+            offset += dom->child_count[b];
+            dom->child_count[b] = 0;
+        }
+        // Children in reverse postorder, so walks visit them in CFG order
+        for (uint32_t i = 0; i < dom->order_count; i++) {
+            uint32_t b = dom->order[i];
+            uint32_t parent = dom->idom[b];
+            if (parent != IR_DOM_NONE) {
+                dom->children[dom->first_child[parent] + dom->child_count[parent]++] = b;
+            }
+        }
+
+        uint32_t clock = 0, depth = 0;
+        if (dom->order_count > 0) {
+            stack[depth++] = dom->order[0];
+            dom->tree_in[dom->order[0]] = clock++;
+        }
+        while (depth > 0) {
+            uint32_t b = stack[depth - 1];
+            if (next_child[b] < dom->child_count[b]) {
+                uint32_t child = dom->children[dom->first_child[b] + next_child[b]++];
+                dom->tree_in[child] = clock++;
+                stack[depth++] = child;
+            } else {
+                dom->tree_out[b] = clock++;
+                depth--;
+            }
+        }
+    }
+
+    free(stack);
+    free(next_child);
+    return ok;
+}
+
+/*
+ * Dominance frontiers: for each join point b, walk up from every
+ * predecessor to idom(b). Two passes, counting then filling, so the
+ * frontiers land in one array.
+ */
+static bool compute_frontiers(const IRFlatFunction* flat, IRDominators* dom) {
+    uint32_t n = dom->block_count;
+    dom->first_frontier = block_array(n, 0);
+    dom->frontier_count = block_array(n, 0);
+    uint32_t* last_added = block_array(n, IR_DOM_NONE);
+    if (!dom->first_frontier || !dom->frontier_count || !last_added) {
+        free(last_added);
+        return false;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            uint32_t offset = 0;
+            for (uint32_t b = 0; b < n; b++) {
+                dom->first_frontier[b] = offset;
+                offset += dom->frontier_count[b];
+                dom->frontier_count[b] = 0;
+                last_added[b] = IR_DOM_NONE;
+            }
+            dom->frontier = block_array(offset, 0);
+            if (!dom->frontier) {
+                free(last_added);
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < dom->order_count; i++) {
+            uint32_t b = dom->order[i];
+            const IRFlatBlock* block = &flat->blocks[b];
+            if (block->pred_count < 2) continue;
+
+            for (uint32_t p = 0; p < block->pred_count; p++) {
+                uint32_t runner = flat->edges[block->first_pred + p];
+                if (runner >= n || dom->rpo_number[runner] == IR_DOM_NONE) continue;
+
+                while (runner != IR_DOM_NONE && runner != dom->idom[b]) {
+                    if (last_added[runner] != b) {
+                        last_added[runner] = b;
+                        if (pass == 1) {
+                            dom->frontier[dom->first_frontier[runner] + dom->frontier_count[runner]] = b;
+                        }
+                        dom->frontier_count[runner]++;
+                    }
+                    runner = dom->idom[runner];
+                }
+            }
+        }
+    }
+
+    free(last_added);
+    return true;
+}
+
+IRDominators* ir_dominators_compute(const IRFlatFunction* flat) {
+    if (!flat) return NULL;
+
+    IRDominators* dom = calloc(1, sizeof(IRDominators));
+    if (!dom) return NULL;
+
+    uint32_t n = flat->block_count;
+    dom->block_count = n;
+    dom->idom = block_array(n, IR_DOM_NONE);
+    dom->order = block_array(n, 0);
+    dom->rpo_number = block_array(n, IR_DOM_NONE);
+    if (!dom->idom || !dom->order || !dom->rpo_number || !compute_order(flat, dom)) {
+        ir_dominators_destroy(dom);
+        return NULL;
+    }
+
+    // Iterate to a fixed point over reverse postorder; the entry is its
+    // own dominator while this runs so intersect() terminates there
+    if (dom->order_count > 0) dom->idom[0] = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t i = 1; i < dom->order_count; i++) {
+            uint32_t b = dom->order[i];
+            const IRFlatBlock* block = &flat->blocks[b];
+            uint32_t new_idom = IR_DOM_NONE;
+
+            for (uint32_t p = 0; p < block->pred_count; p++) {
+                uint32_t pred = flat->edges[block->first_pred + p];
+                if (pred >= n || dom->idom[pred] == IR_DOM_NONE) continue;
+                new_idom = new_idom == IR_DOM_NONE ? pred : intersect(dom, pred, new_idom);
+            }
+            if (dom->idom[b] != new_idom) {
+                dom->idom[b] = new_idom;
+                changed = true;
+            }
+        }
+    }
+    if (dom->order_count > 0) dom->idom[0] = IR_DOM_NONE;
+
+    if (!compute_tree(dom) || !compute_frontiers(flat, dom)) {
+        ir_dominators_destroy(dom);
+        return NULL;
+    }
+    return dom;
+}
+
+void ir_dominators_destroy(IRDominators* dom) {
+    if (!dom) return;
+
+    free(dom->idom);
+    free(dom->order);
+    free(dom->rpo_number);
+    free(dom->first_child);
+    free(dom->child_count);
+    free(dom->children);
+    free(dom->tree_in);
+    free(dom->tree_out);
+    free(dom->first_frontier);
+    free(dom->frontier_count);
+    free(dom->frontier);
+    free(dom);
+}
+
+bool ir_dominators_reachable(const IRDominators* dom, uint32_t block) {
+    return block < dom->block_count && dom->rpo_number[block] != IR_DOM_NONE;
+}
+
+// a dominates b (reflexive); false if either is unreachable
+bool ir_dominators_dominates(const IRDominators* dom, uint32_t a, uint32_t b) {
+    if (!ir_dominators_reachable(dom, a) || !ir_dominators_reachable(dom, b)) return false;
+    return dom->tree_in[a] <= dom->tree_in[b] && dom->tree_out[b] <= dom->tree_out[a];
+}
+
+// ============================================================================
+// LOOPS
+// ============================================================================
+
+static int compare_blocks(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+static int compare_loop_size(const void* a, const void* b) {
+    const IRLoop* x = a;
+    const IRLoop* y = b;
+    if (x->block_count != y->block_count) return x->block_count < y->block_count ? -1 : 1;
+    return compare_blocks(&x->header, &y->header);
+}
+
+/*
+ * A header is a block some predecessor it dominates jumps back to. Its
+ * body is found by walking predecessors back from those latches until
+ * the header. Nested loops are strictly smaller, so sorting by size puts
+ * inner loops first.
+ */
+IRLoops* ir_loops_compute(const IRFlatFunction* flat, const IRDominators* dom) {
+    if (!flat || !dom) return NULL;
+
+    uint32_t n = flat->block_count;
+    IRLoops* loops = calloc(1, sizeof(IRLoops));
+    uint32_t* stack = block_array(n, 0);
+    uint32_t* mark = block_array(n, IR_DOM_NONE);     // Header of the loop being collected
+    uint32_t loop_capacity = 0, block_capacity = 0, block_total = 0;
+    bool ok = loops && stack && mark;
+
+    for (uint32_t i = 0; ok && i < dom->order_count; i++) {
+        uint32_t h = dom->order[i];
+        const IRFlatBlock* header = &flat->blocks[h];
+        uint32_t latches = 0, depth = 0;
+        for (uint32_t p = 0; p < header->pred_count; p++) {
+            uint32_t pred = flat->edges[header->first_pred + p];
+            if (!ir_dominators_dominates(dom, h, pred)) continue;
+            latches++;
+            if (mark[pred] != h && pred != h) {
+                mark[pred] = h;
+                stack[depth++] = pred;
+            }
+        }
+        if (latches == 0) continue;
+
+        uint32_t first = block_total;
+        mark[h] = h;
+        ok = grow((void**)&loops->blocks, &block_capacity, block_total + 1, sizeof(uint32_t));
+        if (ok) loops->blocks[block_total++] = h;
+        while (ok && depth > 0) {
+            uint32_t b = stack[--depth];
+            ok = grow((void**)&loops->blocks, &block_capacity, block_total + 1, sizeof(uint32_t));
+            if (!ok) break;
+            loops->blocks[block_total++] = b;
+
+            const IRFlatBlock* block = &flat->blocks[b];
+            for (uint32_t p = 0; p < block->pred_count; p++) {
+                uint32_t pred = flat->edges[block->first_pred + p];
+                if (mark[pred] == h || !ir_dominators_reachable(dom, pred)) continue;
+                mark[pred] = h;
+                stack[depth++] = pred;
+            }
+        }
+        if (!ok) break;
+        qsort(loops->blocks + first, block_total - first, sizeof(uint32_t), compare_blocks);
+
+        uint32_t outside = IR_DOM_NONE, outside_count = 0;
+        for (uint32_t p = 0; p < header->pred_count; p++) {
+            uint32_t pred = flat->edges[header->first_pred + p];
+            if (mark[pred] == h || !ir_dominators_reachable(dom, pred)) continue;
+            outside = pred;
+            outside_count++;
+        }
+
+        ok = grow((void**)&loops->loops, &loop_capacity, loops->loop_count + 1, sizeof(IRLoop));
+        if (!ok) break;
+        IRLoop* loop = &loops->loops[loops->loop_count++];
+        loop->header = h;
+        loop->preheader = outside_count == 1 && flat->blocks[outside].succ_count == 1 ? outside : IR_DOM_NONE;
+        loop->latch_count = latches;
+        loop->first_block = first;
+        loop->block_count = block_total - first;
+    }
+
+    free(stack);
+    free(mark);
+    if (!ok) {
+        ir_loops_destroy(loops);
+        return NULL;
+    }
+    qsort(loops->loops, loops->loop_count, sizeof(IRLoop), compare_loop_size);
+    return loops;
+}
+
+void ir_loops_destroy(IRLoops* loops) {
+    if (!loops) return;
+
+    free(loops->loops);
+    free(loops->blocks);
+    free(loops);
+}
+
+bool ir_loop_contains(const IRLoops* loops, const IRLoop* loop, uint32_t block) {
+    return bsearch(&block, loops->blocks + loop->first_block, loop->block_count,
+                   sizeof(uint32_t), compare_blocks) != NULL;
+}
+
+// ============================================================================
+// INTEGER REGISTERS
+// ============================================================================
+
+static bool integer_operand(const bool* is_int, uint32_t reg_count, IRFlatOperand operand) {
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_IMM: case IR_FLAT_INT:
+            return true;
+        case IR_FLAT_REG:
+            return ir_flat_payload(operand) < reg_count && is_int[ir_flat_payload(operand)];
+        default:
+            return false;
+    }
+}
+
+/*
+ * Optimistic fixed point: everything defined by an integer constant,
+ * add/sub/mul or a PHI starts as an integer and is demoted once an
+ * operand is not. Parameters, loads and call results are unknown.
+ */
+bool* ir_ssa_integer_registers(const IRFlatFunction* flat) {
+    uint32_t reg_count = (uint32_t)flat->next_register_id;
+    bool* is_int = calloc(reg_count ? reg_count : 1, sizeof(bool));
+    if (!is_int) return NULL;
+
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        const IRFlatInst* inst = &flat->insts[i];
+        if (ir_flat_kind(inst->dest) != IR_FLAT_REG || ir_flat_payload(inst->dest) >= reg_count) continue;
+        bool candidate = inst->opcode == IR_ADD || inst->opcode == IR_SUB || inst->opcode == IR_MUL ||
+                         inst->opcode == IR_PHI ||
+                         (inst->opcode == IR_CONST_INT && ir_flat_is_int_constant(inst->src[0]));
+        is_int[ir_flat_payload(inst->dest)] = candidate;
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t i = 0; i < flat->inst_count; i++) {
+            const IRFlatInst* inst = &flat->insts[i];
+            if (ir_flat_kind(inst->dest) != IR_FLAT_REG || ir_flat_payload(inst->dest) >= reg_count) continue;
+            uint32_t dest = ir_flat_payload(inst->dest);
+            if (!is_int[dest]) continue;
+
+            bool ok = true;
+            if (inst->opcode == IR_PHI) {
+                for (uint32_t p = 0; p + 1 < inst->arg_count; p += 2) {
+                    ok &= integer_operand(is_int, reg_count, flat->args[inst->first_arg + p]);
+                }
+            } else if (inst->opcode != IR_CONST_INT) {
+                ok = integer_operand(is_int, reg_count, inst->src[0]) &&
+                     integer_operand(is_int, reg_count, inst->src[1]);
+            }
+            if (!ok) {
+                is_int[dest] = false;
+                changed = true;
+            }
+        }
+    }
+    return is_int;
+}
+
+// ============================================================================
+// MEM2REG
+// ============================================================================
+
+typedef struct {
+    uint32_t block;
+    uint32_t var;
+    uint32_t reg;           // Register the PHI defines
+    uint32_t first_arg;     // Incoming values in phi_args, one per predecessor
+    bool live;
+} PendingPhi;
+
+typedef struct {
+    IRFlatFunction* flat;
+    IRDominators* dom;
+    uint32_t reg_count;     // Registers that existed before promotion
+
+    int32_t* var_of;        // Register -> promoted local, or -1
+    uint32_t var_count;
+
+    PendingPhi* phis;
+    uint32_t phi_count;
+    uint32_t phi_capacity;
+    IRFlatOperand* phi_args;
+    uint32_t phi_arg_count;
+    uint32_t phi_arg_capacity;
+    uint32_t* block_first_phi;  // phi_order[block_first_phi[b] .. block_first_phi[b + 1])
+    uint32_t* phi_order;
+
+    IRFlatOperand* current;     // Reaching value of each local during renaming
+    struct { uint32_t var; IRFlatOperand value; }* undo;
+    uint32_t undo_count;
+    uint32_t undo_capacity;
+
+    IRFlatOperand* value_of;    // Replacement for each removed load's register
+    bool* removed;              // Per instruction
+} Mem2Reg;
+
+// Reads of a local before any store see zero, like an uninitialized slot
+#define UNDEF_VALUE ir_flat_operand(IR_FLAT_IMM, 0)
+
+static bool is_var(const Mem2Reg* m, IRFlatOperand operand) {
+    return ir_flat_kind(operand) == IR_FLAT_REG && ir_flat_payload(operand) < m->reg_count &&
+           m->var_of[ir_flat_payload(operand)] >= 0;
+}
+
+static uint32_t var_index(const Mem2Reg* m, IRFlatOperand operand) {
+    return (uint32_t)m->var_of[ir_flat_payload(operand)];
+}
+
+// Follow replacements of removed loads to the value that reaches them
+static IRFlatOperand resolve(const Mem2Reg* m, IRFlatOperand operand) {
+    while (ir_flat_kind(operand) == IR_FLAT_REG && ir_flat_payload(operand) < m->reg_count &&
+           m->value_of[ir_flat_payload(operand)] != IR_FLAT_NO_OPERAND) {
+        operand = m->value_of[ir_flat_payload(operand)];
+    }
+    return operand;
+}
+
+// Entry-block allocas whose address never escapes a load or store
+static void find_promotable(Mem2Reg* m) {
+    IRFlatFunction* flat = m->flat;
+    const IRFlatBlock* entry = &flat->blocks[0];
+
+    for (uint32_t i = entry->first_inst; i < entry->first_inst + entry->inst_count; i++) {
+        IRFlatInst* inst = &flat->insts[i];
+        if (inst->opcode == IR_ALLOCA && ir_flat_kind(inst->dest) == IR_FLAT_REG &&
+            ir_flat_payload(inst->dest) < m->reg_count) {
+            m->var_of[ir_flat_payload(inst->dest)] = 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        IRFlatInst* inst = &flat->insts[i];
+        for (int s = 0; s < 3; s++) {
+            if (!is_var(m, inst->src[s])) continue;
+            bool address_use = (inst->opcode == IR_LOAD && s == 0) || (inst->opcode == IR_STORE && s == 1);
+            if (!address_use) m->var_of[ir_flat_payload(inst->src[s])] = -1;
+        }
+        for (uint32_t a = 0; a < inst->arg_count; a++) {
+            IRFlatOperand arg = flat->args[inst->first_arg + a];
+            if (is_var(m, arg)) m->var_of[ir_flat_payload(arg)] = -1;
+        }
+        bool plain_load = ir_flat_kind(inst->dest) == IR_FLAT_REG && ir_flat_payload(inst->dest) < m->reg_count;
+        if (inst->opcode == IR_LOAD && is_var(m, inst->src[0]) && !plain_load) {
+            m->var_of[ir_flat_payload(inst->src[0])] = -1;
+        }
+        if (inst->opcode != IR_ALLOCA && is_var(m, inst->dest)) {
+            m->var_of[ir_flat_payload(inst->dest)] = -1;
+        }
+    }
+
+    for (uint32_t r = 0; r < m->reg_count; r++) {
+        if (m->var_of[r] >= 0) m->var_of[r] = (int32_t)m->var_count++;
+    }
+}
+
+static bool add_phi(Mem2Reg* m, uint32_t block, uint32_t var) {
+    IRFlatFunction* flat = m->flat;
+    uint32_t pred_count = flat->blocks[block].pred_count;
+    if ((uint32_t)flat->next_register_id >= IR_FLAT_PAYLOAD_MASK) return false;
+    if (!grow((void**)&m->phis, &m->phi_capacity, m->phi_count + 1, sizeof(PendingPhi)) ||
+        !grow((void**)&m->phi_args, &m->phi_arg_capacity, m->phi_arg_count + pred_count, sizeof(IRFlatOperand))) {
+        return false;
+    }
+
+    PendingPhi* phi = &m->phis[m->phi_count++];
+    phi->block = block;
+    phi->var = var;
+    phi->reg = (uint32_t)flat->next_register_id++;
+    phi->first_arg = m->phi_arg_count;
+    phi->live = false;
+    for (uint32_t p = 0; p < pred_count; p++) m->phi_args[m->phi_arg_count++] = UNDEF_VALUE;
+    return true;
+}
+
+/*
+ * PHIs for each local on the iterated dominance frontier of the blocks
+ * that store to it. Store sites are gathered per local in one pass so
+ * the placement is linear in the function size.
+ */
+static bool place_phis(Mem2Reg* m) {
+    IRFlatFunction* flat = m->flat;
+    uint32_t n = flat->block_count;
+    uint32_t* first_def = block_array(m->var_count + 1, 0);
+    uint32_t* last_block = block_array(m->var_count, IR_DOM_NONE);
+    uint32_t* has_phi = block_array(n, IR_DOM_NONE);
+    uint32_t* queued = block_array(n, IR_DOM_NONE);
+    uint32_t* worklist = NULL;
+    uint32_t* defs = NULL;
+    bool ok = first_def && last_block && has_phi && queued;
+
+    // Count, then fill, the distinct blocks that store to each local
+    uint32_t def_count = 0;
+    for (int pass = 0; ok && pass < 2; pass++) {
+        if (pass == 1) {
+            uint32_t offset = 0;
+            for (uint32_t v = 0; v <= m->var_count; v++) {
+                uint32_t count = first_def[v];
+                first_def[v] = offset;
+                offset += count;
+            }
+            for (uint32_t v = 0; v < m->var_count; v++) last_block[v] = IR_DOM_NONE;
+            defs = block_array(def_count, 0);
+            ok = defs != NULL;
+        }
+        for (uint32_t b = 0; ok && b < n; b++) {
+            const IRFlatBlock* block = &flat->blocks[b];
+            for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+                const IRFlatInst* inst = &flat->insts[i];
+                if (inst->opcode != IR_STORE || !is_var(m, inst->src[1])) continue;
+
+                uint32_t v = var_index(m, inst->src[1]);
+                if (last_block[v] == b) continue;
+                last_block[v] = b;
+                if (pass == 0) {
+                    first_def[v]++;
+                    def_count++;
+                } else {
+                    defs[first_def[v]++] = b;
+                }
+            }
+        }
+    }
+    // The fill pass advanced each start to the next local's start
+    for (uint32_t v = m->var_count; ok && v > 0; v--) first_def[v] = first_def[v - 1];
+    if (ok) first_def[0] = 0;
+
+    worklist = block_array(n, 0);
+    ok = ok && worklist;
+
+    for (uint32_t v = 0; ok && v < m->var_count; v++) {
+        uint32_t count = 0;
+        for (uint32_t d = first_def[v]; d < first_def[v + 1]; d++) {
+            worklist[count++] = defs[d];
+            queued[defs[d]] = v;
+        }
+        while (ok && count > 0) {
+            uint32_t x = worklist[--count];
+            if (!ir_dominators_reachable(m->dom, x)) continue;
+
+            uint32_t first = m->dom->first_frontier[x];
+            for (uint32_t f = first; ok && f < first + m->dom->frontier_count[x]; f++) {
+                uint32_t y = m->dom->frontier[f];
+                if (has_phi[y] == v) continue;
+                has_phi[y] = v;
+                ok = add_phi(m, y, v);
+                if (queued[y] != v) {
+                    queued[y] = v;
+                    worklist[count++] = y;
+                }
+            }
+        }
+    }
+
+    // Group PHIs by block
+    m->block_first_phi = block_array(n + 1, 0);
+    m->phi_order = block_array(m->phi_count, 0);
+    ok = ok && m->block_first_phi && m->phi_order;
+    if (ok) {
+        for (uint32_t p = 0; p < m->phi_count; p++) m->block_first_phi[m->phis[p].block + 1]++;
+        for (uint32_t b = 0; b < n; b++) m->block_first_phi[b + 1] += m->block_first_phi[b];
+        uint32_t* cursor = block_array(n, 0);
+        ok = cursor != NULL;
+        for (uint32_t b = 0; ok && b < n; b++) cursor[b] = m->block_first_phi[b];
+        for (uint32_t p = 0; ok && p < m->phi_count; p++) {
+            m->phi_order[cursor[m->phis[p].block]++] = p;
+        }
+        free(cursor);
+    }
+
+    free(first_def);
+    free(last_block);
+    free(has_phi);
+    free(queued);
+    free(worklist);
+    free(defs);
+    return ok;
+}
+
+static bool set_current(Mem2Reg* m, uint32_t var, IRFlatOperand value) {
+    if (!grow((void**)&m->undo, &m->undo_capacity, m->undo_count + 1, sizeof(*m->undo))) return false;
+    m->undo[m->undo_count].var = var;
+    m->undo[m->undo_count].value = m->current[var];
+    m->undo_count++;
+    m->current[var] = value;
+    return true;
+}
+
+static void restore_current(Mem2Reg* m, uint32_t mark) {
+    while (m->undo_count > mark) {
+        m->undo_count--;
+        m->current[m->undo[m->undo_count].var] = m->undo[m->undo_count].value;
+    }
+}
+
+// Rename one block: PHIs and stores define, loads read the reaching value
+static bool rename_block(Mem2Reg* m, uint32_t b) {
+    IRFlatFunction* flat = m->flat;
+    const IRFlatBlock* block = &flat->blocks[b];
+
+    for (uint32_t p = m->block_first_phi[b]; p < m->block_first_phi[b + 1]; p++) {
+        const PendingPhi* phi = &m->phis[m->phi_order[p]];
+        if (!set_current(m, phi->var, ir_flat_operand(IR_FLAT_REG, phi->reg))) return false;
+    }
+
+    for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+        IRFlatInst* inst = &flat->insts[i];
+        for (int s = 0; s < 3; s++) inst->src[s] = resolve(m, inst->src[s]);
+        for (uint32_t a = 0; a < inst->arg_count; a++) {
+            flat->args[inst->first_arg + a] = resolve(m, flat->args[inst->first_arg + a]);
+        }
+
+        if (inst->opcode == IR_ALLOCA && is_var(m, inst->dest)) {
+            m->removed[i] = true;
+        } else if (inst->opcode == IR_LOAD && is_var(m, inst->src[0])) {
+            m->value_of[ir_flat_payload(inst->dest)] = m->current[var_index(m, inst->src[0])];
+            m->removed[i] = true;
+        } else if (inst->opcode == IR_STORE && is_var(m, inst->src[1])) {
+            if (!set_current(m, var_index(m, inst->src[1]), inst->src[0])) return false;
+            m->removed[i] = true;
+        }
+    }
+
+    // Feed the values leaving this block into successor PHIs
+    for (uint32_t e = 0; e < block->succ_count; e++) {
+        uint32_t s = flat->edges[block->first_succ + e];
+        if (s >= flat->block_count) continue;
+        const IRFlatBlock* succ = &flat->blocks[s];
+
+        for (uint32_t p = m->block_first_phi[s]; p < m->block_first_phi[s + 1]; p++) {
+            const PendingPhi* phi = &m->phis[m->phi_order[p]];
+            for (uint32_t j = 0; j < succ->pred_count; j++) {
+                if (flat->edges[succ->first_pred + j] == b) {
+                    m->phi_args[phi->first_arg + j] = m->current[phi->var];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*
+ * Walk the dominator tree so each block sees the values reaching it from
+ * its dominators; the undo log rewinds definitions on the way back up.
+ * Unreachable blocks are renamed afterwards, each on its own.
+ */
+static bool rename_all(Mem2Reg* m) {
+    IRFlatFunction* flat = m->flat;
+    const IRDominators* dom = m->dom;
+    uint32_t n = flat->block_count;
+    uint32_t* stack = block_array(n, 0);
+    uint32_t* next_child = block_array(n, 0);
+    uint32_t* mark = block_array(n, 0);
+    bool ok = stack && next_child && mark;
+
+    for (uint32_t v = 0; ok && v < m->var_count; v++) m->current[v] = UNDEF_VALUE;
+
+    uint32_t depth = 0;
+    if (ok && dom->order_count > 0) {
+        mark[0] = m->undo_count;
+        ok = rename_block(m, 0);
+        stack[depth++] = 0;
+    }
+    while (ok && depth > 0) {
+        uint32_t b = stack[depth - 1];
+        if (next_child[b] < dom->child_count[b]) {
+            uint32_t child = dom->children[dom->first_child[b] + next_child[b]++];
+            mark[child] = m->undo_count;
+            ok = rename_block(m, child);
+            stack[depth++] = child;
+        } else {
+            restore_current(m, mark[b]);
+            depth--;
+        }
+    }
+
+    for (uint32_t b = 0; ok && b < n; b++) {
+        if (ir_dominators_reachable(dom, b)) continue;
+        uint32_t start = m->undo_count;
+        ok = rename_block(m, b);
+        restore_current(m, start);
+    }
+
+    free(stack);
+    free(next_child);
+    free(mark);
+    return ok;
+}
+
+static void mark_phi_use(Mem2Reg* m, const uint32_t* phi_of_reg, IRFlatOperand operand,
+                         uint32_t* worklist, uint32_t* count) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG) return;
+
+    uint32_t reg = ir_flat_payload(operand);
+    if (reg < m->reg_count || reg >= (uint32_t)m->flat->next_register_id) return;
+
+    uint32_t p = phi_of_reg[reg - m->reg_count];
+    if (p != IR_DOM_NONE && !m->phis[p].live) {
+        m->phis[p].live = true;
+        worklist[(*count)++] = p;
+    }
+}
+
+// A PHI is kept only if a real instruction reads it, directly or through other PHIs
+static bool mark_live_phis(Mem2Reg* m) {
+    IRFlatFunction* flat = m->flat;
+    uint32_t new_regs = (uint32_t)flat->next_register_id - m->reg_count;
+    uint32_t* phi_of_reg = block_array(new_regs, IR_DOM_NONE);
+    uint32_t* worklist = block_array(m->phi_count, 0);
+    if (!phi_of_reg || !worklist) {
+        free(phi_of_reg);
+        free(worklist);
+        return false;
+    }
+
+    for (uint32_t p = 0; p < m->phi_count; p++) phi_of_reg[m->phis[p].reg - m->reg_count] = p;
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        if (m->removed[i]) continue;
+        IRFlatInst* inst = &flat->insts[i];
+        for (int s = 0; s < 3; s++) {
+            inst->src[s] = resolve(m, inst->src[s]);
+            mark_phi_use(m, phi_of_reg, inst->src[s], worklist, &count);
+        }
+        for (uint32_t a = 0; a < inst->arg_count; a++) {
+            IRFlatOperand* arg = &flat->args[inst->first_arg + a];
+            *arg = resolve(m, *arg);
+            mark_phi_use(m, phi_of_reg, *arg, worklist, &count);
+        }
+    }
+    while (count > 0) {
+        const PendingPhi* phi = &m->phis[worklist[--count]];
+        uint32_t pred_count = flat->blocks[phi->block].pred_count;
+        for (uint32_t j = 0; j < pred_count; j++) {
+            IRFlatOperand* arg = &m->phi_args[phi->first_arg + j];
+            *arg = resolve(m, *arg);
+            mark_phi_use(m, phi_of_reg, *arg, worklist, &count);
+        }
+    }
+
+    free(phi_of_reg);
+    free(worklist);
+    return true;
+}
+
+// Rebuild the instruction and argument arrays: live PHIs first in each block
+static bool rebuild(Mem2Reg* m) {
+    IRFlatFunction* flat = m->flat;
+
+    uint32_t inst_count = 0, arg_count = 0;
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        if (m->removed[i]) continue;
+        inst_count++;
+        arg_count += flat->insts[i].arg_count;
+    }
+    for (uint32_t p = 0; p < m->phi_count; p++) {
+        if (!m->phis[p].live) continue;
+        inst_count++;
+        arg_count += 2 * flat->blocks[m->phis[p].block].pred_count;
+    }
+
+    IRFlatInst* insts = calloc(inst_count ? inst_count : 1, sizeof(IRFlatInst));
+    IRFlatOperand* args = calloc(arg_count ? arg_count : 1, sizeof(IRFlatOperand));
+    if (!insts || !args) {
+        free(insts);
+        free(args);
+        return false;
+    }
+
+    uint32_t next_inst = 0, next_arg = 0;
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        IRFlatBlock* block = &flat->blocks[b];
+        uint32_t first = next_inst;
+        int line = block->inst_count ? flat->insts[block->first_inst].line_number : 0;
+
+        for (uint32_t p = m->block_first_phi[b]; p < m->block_first_phi[b + 1]; p++) {
+            const PendingPhi* phi = &m->phis[m->phi_order[p]];
+            if (!phi->live) continue;
+
+            IRFlatInst* inst = &insts[next_inst++];
+            inst->opcode = IR_PHI;
+            inst->dest = ir_flat_operand(IR_FLAT_REG, phi->reg);
+            inst->first_arg = next_arg;
+            inst->arg_count = 2 * block->pred_count;
+            inst->comment = IR_FLAT_NO_STRING;
+            inst->line_number = line;
+            for (uint32_t j = 0; j < block->pred_count; j++) {
+                args[next_arg++] = m->phi_args[phi->first_arg + j];
+                args[next_arg++] = ir_flat_operand(IR_FLAT_LABEL, flat->edges[block->first_pred + j]);
+            }
+        }
+
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            if (m->removed[i]) continue;
+
+            IRFlatInst* inst = &insts[next_inst++];
+            *inst = flat->insts[i];
+            inst->first_arg = next_arg;
+            for (uint32_t a = 0; a < inst->arg_count; a++) {
+                args[next_arg++] = flat->args[flat->insts[i].first_arg + a];
+            }
+        }
+
+        block->first_inst = first;
+        block->inst_count = next_inst - first;
+    }
+
+    free(flat->insts);
+    free(flat->args);
+    flat->insts = insts;
+    flat->inst_count = flat->inst_capacity = inst_count;
+    flat->args = args;
+    flat->arg_count = flat->arg_capacity = arg_count;
+    return true;
+}
+
+int ir_ssa_promote(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    // A branch back to the entry would need PHIs with no incoming edge for the call itself
+    if (flat->blocks[0].pred_count > 0) return 0;
+
+    Mem2Reg m = { 0 };
+    m.flat = flat;
+    m.reg_count = (uint32_t)flat->next_register_id;
+    m.var_of = malloc((m.reg_count ? m.reg_count : 1) * sizeof(int32_t));
+    if (!m.var_of) return -1;
+    for (uint32_t r = 0; r < m.reg_count; r++) m.var_of[r] = -1;
+
+    find_promotable(&m);
+    int result = (int)m.var_count;
+    if (m.var_count > 0) {
+        m.dom = ir_dominators_compute(flat);
+        m.current = calloc(m.var_count, sizeof(IRFlatOperand));
+        m.value_of = calloc(m.reg_count ? m.reg_count : 1, sizeof(IRFlatOperand));
+        m.removed = calloc(flat->inst_count ? flat->inst_count : 1, sizeof(bool));
+
+        bool ok = m.dom && m.current && m.value_of && m.removed &&
+                  place_phis(&m) && rename_all(&m) && mark_live_phis(&m) && rebuild(&m);
+        if (!ok) result = -1;
+    }
+
+    ir_dominators_destroy(m.dom);
+    free(m.var_of);
+    free(m.phis);
+    free(m.phi_args);
+    free(m.block_first_phi);
+    free(m.phi_order);
+    free(m.current);
+    free(m.undo);
+    free(m.value_of);
+    free(m.removed);
+    return result;
+}
+
+int ir_ssa_construct(IRFunction* function) {
+    IRFlatFunction* flat = ir_flat_from_function(function);
+    if (!flat) return -1;
+
+    int promoted = ir_ssa_promote(flat);
+    if (promoted > 0 && !ir_flat_store(flat, function)) promoted = -1;
+    ir_flat_destroy(flat);
+    return promoted;
+}
+
+// Total locals promoted across the module; functions that fail are left as they were
+int ir_ssa_construct_module(IRModule* module) {
+    int total = 0;
+    for (IRFunction* function = module ? module->functions : NULL; function; function = function->next) {
+        int promoted = ir_ssa_construct(function);
+        if (promoted > 0) total += promoted;
+    }
+    return total;
+}
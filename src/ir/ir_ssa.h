@@ -0,0 +1,77 @@
+/*
+ * GPLANG SSA Construction
+ * Dominator tree, dominance frontiers, natural loops and promotion of
+ * stack locals (alloca/load/store) to SSA registers joined by PHIs
+ */
+
+#ifndef GPLANG_IR_SSA_H
+#define GPLANG_IR_SSA_H
+
+#include "ir.h"
+#include "ir_flat.h"
+
+#define IR_DOM_NONE 0xFFFFFFFFu
+
+// Dominator information for a flat function; blocks are flat block indices
+typedef struct {
+    uint32_t block_count;
+    uint32_t* idom;             // Immediate dominator, IR_DOM_NONE for entry and unreachable blocks
+    uint32_t* order;            // Reachable blocks in reverse postorder
+    uint32_t order_count;
+    uint32_t* rpo_number;       // Position in order, IR_DOM_NONE if unreachable
+
+    // Dominator tree children: child[first_child[b] .. first_child[b] + child_count[b])
+    uint32_t* first_child;
+    uint32_t* child_count;
+    uint32_t* children;
+    uint32_t* tree_in;          // Dominator tree DFS interval, for constant-time dominance queries
+    uint32_t* tree_out;
+
+    // Dominance frontier: frontier[first_frontier[b] .. first_frontier[b] + frontier_count[b])
+    uint32_t* first_frontier;
+    uint32_t* frontier_count;
+    uint32_t* frontier;
+} IRDominators;
+
+// Function declarations
+IRDominators* ir_dominators_compute(const IRFlatFunction* flat);
+void ir_dominators_destroy(IRDominators* dom);
+bool ir_dominators_dominates(const IRDominators* dom, uint32_t a, uint32_t b);
+bool ir_dominators_reachable(const IRDominators* dom, uint32_t block);
+
+// A natural loop: the header and every block that reaches one of its
+// back edges without passing through it
+typedef struct {
+    uint32_t header;
+    uint32_t preheader;         // Only predecessor from outside, if it jumps nowhere else; else IR_DOM_NONE
+    uint32_t latch_count;       // Back edges into the header
+    uint32_t first_block;       // blocks[first_block .. first_block + block_count), in block order
+    uint32_t block_count;
+} IRLoop;
+
+typedef struct {
+    IRLoop* loops;              // Inner loops before the loops around them
+    uint32_t loop_count;
+    uint32_t* blocks;
+} IRLoops;
+
+IRLoops* ir_loops_compute(const IRFlatFunction* flat, const IRDominators* dom);
+void ir_loops_destroy(IRLoops* loops);
+bool ir_loop_contains(const IRLoops* loops, const IRLoop* loop, uint32_t block);
+
+// Per register: provably a 64-bit integer on every path, built from
+// integer constants with add, sub, mul and PHIs. NULL if out of memory.
+bool* ir_ssa_integer_registers(const IRFlatFunction* flat);
+
+/*
+ * mem2reg: rewrite every alloca whose address is only loaded from and
+ * stored to into SSA registers, placing PHIs on the iterated dominance
+ * frontier of its stores. PHI operands are (value, predecessor label)
+ * pairs in the instruction's args. Returns the number of promoted
+ * locals, or -1 if the function could not be converted.
+ */
+int ir_ssa_promote(IRFlatFunction* flat);
+int ir_ssa_construct(IRFunction* function);     // Linked IR wrapper
+int ir_ssa_construct_module(IRModule* module);
+
+#endif // GPLANG_IR_SSA_H
@@ -0,0 +1,353 @@
+/*
+ * GPLANG Tail Recursion Elimination
+ * Turns self-recursive calls in tail position into jumps back to the
+ * top of the function, on the linked IR before inlining, so recursion
+ * that only ever returns its recursive call's result runs as a loop.
+ *
+ * Each parameter gets a local, and the old entry block becomes the loop
+ * header that reads them; a tail call stores its arguments to those
+ * locals and jumps there. mem2reg turns the locals into PHIs.
+ *
+ * Linear recursion of the form `return f(...) + x` (or x + f(...), or
+ * with *) also becomes a loop by introducing an accumulator: the call
+ * site folds x into it, and every other return combines the accumulator
+ * with its value. Reordering the additions is only exact for integers,
+ * so the accumulator is used when the backend's value kinds show that
+ * the function and x are integers. `return fib(n - 1) + fib(n - 2)`
+ * keeps its first call and loops on the second.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+#include "../backend/value_kinds.h"
+
+typedef struct {
+    IRBasicBlock* block;
+    IRInstruction* call;        // Recursive call
+    IRInstruction* combine;     // add/mul of its result with addend, returned; NULL for a plain tail call
+    IRValue* addend;
+} TailSite;
+
+static bool same_register(const IRValue* a, const IRValue* b) {
+    return a && b && a->type == IR_VALUE_REGISTER && b->type == IR_VALUE_REGISTER && a->reg_id == b->reg_id;
+}
+
+static bool is_self_call(const IRFunction* function, const IRInstruction* inst) {
+    return inst && inst->opcode == IR_CALL && inst->dest && inst->src1 && inst->src1->type == IR_VALUE_GLOBAL &&
+           inst->src1->global_name && strcmp(inst->src1->global_name, function->name) == 0 &&
+           inst->arg_count == function->parameter_count;
+}
+
+static IRInstruction* instruction(IROpcode opcode, IRValue* dest, IRValue* a, IRValue* b) {
+    IRInstruction* inst = ir_instruction_create(opcode);
+    if (!inst) {
+        ir_value_destroy(dest);
+        ir_value_destroy(a);
+        ir_value_destroy(b);
+        return NULL;
+    }
+    ir_instruction_set_dest(inst, dest);
+    ir_instruction_set_src(inst, 1, a);
+    ir_instruction_set_src(inst, 2, b);
+    return inst;
+}
+
+static void prepend(IRBasicBlock* block, IRInstruction* inst) {
+    inst->next = block->instructions;
+    block->instructions = inst;
+    if (!block->last_instruction) block->last_instruction = inst;
+}
+
+// Drop everything from first on; returns false if first is not in block
+static bool truncate_at(IRBasicBlock* block, IRInstruction* first) {
+    IRInstruction* previous = NULL;
+    IRInstruction* inst = block->instructions;
+    while (inst && inst != first) {
+        previous = inst;
+        inst = inst->next;
+    }
+    if (!inst) return false;
+
+    if (previous) previous->next = NULL;
+    else block->instructions = NULL;
+    block->last_instruction = previous;
+    while (inst) {
+        IRInstruction* next = inst->next;
+        inst->next = NULL;
+        ir_instruction_destroy(inst);
+        inst = next;
+    }
+    return true;
+}
+
+static bool is_alloca_result(const IRFunction* function, const IRValue* value) {
+    if (!value || value->type != IR_VALUE_REGISTER) return false;
+    for (const IRBasicBlock* block = function->blocks; block; block = block->next) {
+        for (const IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            if (inst->opcode == IR_ALLOCA && same_register(inst->dest, value)) return true;
+        }
+    }
+    return false;
+}
+
+static bool uses_register(const IRInstruction* inst, const IRValue* reg) {
+    if (same_register(inst->src1, reg) || same_register(inst->src2, reg) || same_register(inst->src3, reg)) return true;
+    for (int a = 0; a < inst->arg_count; a++) {
+        if (same_register(inst->args[a], reg)) return true;
+    }
+    return false;
+}
+
+/*
+ * The returned value is the recursive call's, possibly combined with
+ * one more operand. Pure instructions and loads of this frame's locals
+ * that do not read the call's result may sit between the call and the
+ * combine (`f(n - 1) * n` reloads n); they stay, and run before the
+ * jump instead.
+ */
+static bool match_site(const IRFunction* function, IRBasicBlock* block, TailSite* site) {
+    IRInstruction* call = NULL;
+    IRInstruction* last = block->instructions;
+    if (!last) return false;
+    for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+        if (is_self_call(function, inst)) call = inst;
+        last = inst;
+    }
+    if (last->opcode != IR_RETURN || !last->src1 || !call) return false;
+
+    site->block = block;
+    site->call = call;
+    site->combine = NULL;
+    site->addend = NULL;
+    if (call->next == last) return same_register(call->dest, last->src1);
+
+    IRInstruction* combine = call->next;
+    while (combine->next != last) {
+        if (ir_opcode_has_side_effects(combine->opcode) || uses_register(combine, call->dest) ||
+            (combine->opcode == IR_LOAD && !is_alloca_result(function, combine->src1))) {
+            return false;
+        }
+        combine = combine->next;
+    }
+    if ((combine->opcode != IR_ADD && combine->opcode != IR_MUL) || !same_register(combine->dest, last->src1)) {
+        return false;
+    }
+    bool left = same_register(combine->src1, call->dest);
+    bool right = same_register(combine->src2, call->dest);
+    if (left == right) return false;
+    site->combine = combine;
+    site->addend = left ? combine->src2 : combine->src1;
+    return true;
+}
+
+static void rename_register(IRValue* value, int from, int to) {
+    if (value && value->type == IR_VALUE_REGISTER && value->reg_id == from) value->reg_id = to;
+}
+
+// Sites found, with the accumulator opcode (IR_NOP when none) they agree on
+static int find_sites(IRFunction* function, const ModuleKinds* kinds, TailSite* sites, IROpcode* accumulate) {
+    int index = value_kinds_function_index(kinds, function->name);
+    const ValueKind* registers = index >= 0 ? value_kinds_registers(kinds, function) : NULL;
+    bool integer_result = index >= 0 && kinds->returns[index] == VALUE_INT;
+
+    int count = 0;
+    *accumulate = IR_NOP;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        TailSite site;
+        if (!match_site(function, block, &site)) continue;
+
+        // The next iteration reuses this frame's slots
+        bool escapes = false;
+        for (int a = 0; a < site.call->arg_count; a++) escapes |= is_alloca_result(function, site.call->args[a]);
+        if (escapes) continue;
+
+        if (site.combine) {
+            if (!registers || !integer_result ||
+                value_kind_of(registers, function->next_register_id, site.addend) != VALUE_INT) {
+                continue;
+            }
+            if (*accumulate == IR_NOP) *accumulate = site.combine->opcode;
+            if (site.combine->opcode != *accumulate) continue;
+        }
+        sites[count++] = site;
+    }
+    return count;
+}
+
+static int eliminate(IRFunction* function, const ModuleKinds* kinds) {
+    if (!function->entry_block || strcmp(function->name, "main") == 0) return 0;
+
+    int block_count = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) block_count++;
+    TailSite* sites = malloc(block_count * sizeof(TailSite));
+    int* slots = malloc((function->parameter_count ? function->parameter_count : 1) * sizeof(int));
+    IRBasicBlock* entry = ir_basic_block_create("tailrec.entry");
+    if (!sites || !slots || !entry) {
+        free(sites);
+        free(slots);
+        ir_basic_block_destroy(entry);
+        return -1;
+    }
+
+    IROpcode accumulate;
+    int count = find_sites(function, kinds, sites, &accumulate);
+    if (count == 0) {
+        free(sites);
+        free(slots);
+        ir_basic_block_destroy(entry);
+        return 0;
+    }
+
+    // The old entry becomes the loop header; its allocas move ahead of it
+    IRBasicBlock* header = function->entry_block;
+    IRInstruction* previous = NULL;
+    for (IRInstruction* inst = header->instructions; inst;) {
+        IRInstruction* next = inst->next;
+        if (inst->opcode == IR_ALLOCA) {
+            if (previous) previous->next = next;
+            else header->instructions = next;
+            if (header->last_instruction == inst) header->last_instruction = previous;
+            inst->next = NULL;
+            ir_basic_block_add_instruction(entry, inst);
+        } else {
+            previous = inst;
+        }
+        inst = next;
+    }
+
+    int accumulator = accumulate != IR_NOP ? function->next_register_id++ : -1;
+    for (int p = 0; p < function->parameter_count; p++) {
+        slots[p] = function->next_register_id++;
+        IRInstruction* slot = instruction(IR_ALLOCA, ir_value_create_register(slots[p]),
+                                          ir_value_create_constant_string("tailrec.arg"), NULL);
+        if (slot) ir_basic_block_add_instruction(entry, slot);
+    }
+    if (accumulator >= 0) {
+        IRInstruction* slot = instruction(IR_ALLOCA, ir_value_create_register(accumulator),
+                                          ir_value_create_constant_string("tailrec.acc"), NULL);
+        if (slot) ir_basic_block_add_instruction(entry, slot);
+    }
+
+    // Parameters are read back from their locals at the top of every iteration
+    for (int p = function->parameter_count - 1; p >= 0; p--) {
+        int from = function->parameters[p]->reg_id;
+        int to = function->next_register_id++;
+        for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+            for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+                rename_register(inst->src1, from, to);
+                rename_register(inst->src2, from, to);
+                rename_register(inst->src3, from, to);
+                for (int a = 0; a < inst->arg_count; a++) rename_register(inst->args[a], from, to);
+            }
+        }
+        IRInstruction* load = instruction(IR_LOAD, ir_value_create_register(to), ir_value_create_register(slots[p]), NULL);
+        if (load) prepend(header, load);
+    }
+    for (int p = 0; p < function->parameter_count; p++) {
+        IRInstruction* store = instruction(IR_STORE, NULL, ir_value_clone(function->parameters[p]),
+                                           ir_value_create_register(slots[p]));
+        if (store) ir_basic_block_add_instruction(entry, store);
+    }
+    if (accumulator >= 0) {
+        IRInstruction* store = instruction(IR_STORE, NULL, ir_value_create_constant_int(accumulate == IR_MUL ? 1 : 0),
+                                           ir_value_create_register(accumulator));
+        if (store) ir_basic_block_add_instruction(entry, store);
+    }
+    IRInstruction* enter = instruction(IR_JUMP, NULL, ir_value_create_label(header->label), NULL);
+    if (enter) ir_basic_block_add_instruction(entry, enter);
+    entry->next = function->blocks;
+    function->blocks = entry;
+    function->entry_block = entry;
+
+    // Every other return combines its value with the accumulator
+    if (accumulator >= 0) {
+        for (IRBasicBlock* block = header; block; block = block->next) {
+            IRInstruction* last = block->last_instruction;
+            bool is_site = false;
+            for (int s = 0; s < count; s++) is_site |= sites[s].block == block;
+            if (is_site || !last || last->opcode != IR_RETURN) continue;
+
+            int partial = function->next_register_id++;
+            int result = function->next_register_id++;
+            IRInstruction* load = instruction(IR_LOAD, ir_value_create_register(partial),
+                                              ir_value_create_register(accumulator), NULL);
+            IRInstruction* combine = instruction(accumulate, ir_value_create_register(result),
+                                                 ir_value_create_register(partial),
+                                                 last->src1 ? ir_value_clone(last->src1) : ir_value_create_constant_int(0));
+            if (!load || !combine) {
+                ir_instruction_destroy(load);
+                ir_instruction_destroy(combine);
+                continue;
+            }
+            IRInstruction* ret = instruction(IR_RETURN, NULL, ir_value_create_register(result), NULL);
+            if (!ret || !truncate_at(block, last)) {
+                ir_instruction_destroy(ret);
+                ir_instruction_destroy(load);
+                ir_instruction_destroy(combine);
+                continue;
+            }
+            ir_basic_block_add_instruction(block, load);
+            ir_basic_block_add_instruction(block, combine);
+            ir_basic_block_add_instruction(block, ret);
+        }
+    }
+
+    // Tail calls store their arguments and go round again
+    for (int s = 0; s < count; s++) {
+        TailSite* site = &sites[s];
+        IRInstruction* call = site->call;
+        IRInstruction* tail[3] = { NULL, NULL, NULL };
+        if (site->combine) {
+            int partial = function->next_register_id++;
+            int result = function->next_register_id++;
+            tail[0] = instruction(IR_LOAD, ir_value_create_register(partial), ir_value_create_register(accumulator), NULL);
+            tail[1] = instruction(accumulate, ir_value_create_register(result), ir_value_create_register(partial),
+                                  ir_value_clone(site->addend));
+            tail[2] = instruction(IR_STORE, NULL, ir_value_create_register(result), ir_value_create_register(accumulator));
+        }
+
+        // Detach the call so its arguments outlive the truncation; what sat between it and the combine stays
+        IRInstruction* previous_inst = NULL;
+        for (IRInstruction* inst = site->block->instructions; inst != call; inst = inst->next) previous_inst = inst;
+        if (previous_inst) previous_inst->next = call->next;
+        else site->block->instructions = call->next;
+        truncate_at(site->block, site->combine ? site->combine : call->next);
+
+        for (int t = 0; t < 3; t++) {
+            if (tail[t]) ir_basic_block_add_instruction(site->block, tail[t]);
+        }
+        for (int p = 0; p < function->parameter_count; p++) {
+            IRInstruction* store = instruction(IR_STORE, NULL, ir_value_clone(call->args[p]),
+                                               ir_value_create_register(slots[p]));
+            if (store) ir_basic_block_add_instruction(site->block, store);
+        }
+        IRInstruction* jump = instruction(IR_JUMP, NULL, ir_value_create_label(header->label), NULL);
+        if (jump) ir_basic_block_add_instruction(site->block, jump);
+        call->next = NULL;
+        ir_instruction_destroy(call);
+    }
+
+    ir_function_rebuild_edges(function);
+    free(sites);
+    free(slots);
+    return count;
+}
+
+int ir_tail_recursion_module(IRModule* module) {
+    ModuleKinds* kinds = value_kinds_infer(module);
+    if (!kinds) return -1;
+
+    int total = 0;
+    for (IRFunction* function = module->functions; function; function = function->next) {
+        int eliminated = eliminate(function, kinds);
+        if (eliminated < 0) {
+            total = -1;
+            break;
+        }
+        total += eliminated;
+    }
+    value_kinds_destroy(kinds);
+    return total;
+}
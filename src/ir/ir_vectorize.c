@@ -0,0 +1,621 @@
+/*
+ * GPLANG Loop Vectorizer
+ * Widens counted loops whose body is straight-line integer arithmetic
+ * feeding sum reductions, such as
+ *
+ *     for i in range(a, n):
+ *         total += i * k + 1
+ *
+ * In SSA form the loop is a header of PHIs ending in `lt c, i, n` and a
+ * branch, and a chain of blocks leading back to it. A vector copy of
+ * the loop is placed in front of the header and runs IR_VECTOR_LANES
+ * iterations at a time: the induction variable becomes a vector of
+ * consecutive values and each reduction a vector of partial sums, added
+ * up on exit. The original loop then runs the remaining iterations as
+ * the scalar epilogue.
+ *
+ * The IR is untyped, so every value the vector code computes must be
+ * provably an integer: built from integer constants with add, sub, mul
+ * and PHIs. Double reductions are never widened, since summing in a
+ * different order would change their rounding.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ir_passes.h"
+
+#define MAX_CHAIN_BLOCKS 8
+#define MAX_BODY_INSTS 48
+#define MAX_REDUCTIONS 8
+#define MAX_INVARIANTS 16
+
+typedef struct {
+    uint32_t phi;               // PHI instruction in the header
+    uint32_t update;            // add/sub of the PHI in the body
+    IRFlatOperand initial;      // Value on entry from the preheader
+    IRFlatOperand term;         // Operand added (or subtracted) per iteration
+} Reduction;
+
+typedef struct {
+    uint32_t header;
+    uint32_t preheader;
+    uint32_t exit;
+    uint32_t chain[MAX_CHAIN_BLOCKS];   // Body blocks, header successor first
+    uint32_t chain_length;
+
+    uint32_t iv_update;         // add iv_next, iv, 1
+    IRFlatOperand iv;
+    IRFlatOperand iv_initial;
+    IRFlatOperand bound;
+
+    Reduction reductions[MAX_REDUCTIONS];
+    uint32_t reduction_count;
+} Loop;
+
+typedef struct {
+    IRFlatFunction* flat;
+    uint32_t reg_count;
+    uint32_t* def_inst;         // Defining instruction per register, IR_DOM_NONE if none
+    uint32_t* inst_block;
+    bool* is_int;               // Provably a 64-bit integer on every path (ir_ssa_integer_registers)
+} Analysis;
+
+// New instructions for the vector blocks, before they are spliced in
+typedef struct {
+    IRFlatInst insts[2 * MAX_BODY_INSTS + 4 * MAX_REDUCTIONS + MAX_INVARIANTS + 16];
+    uint32_t inst_count;
+    IRFlatOperand args[4 * (2 + MAX_REDUCTIONS)];
+    uint32_t arg_count;
+    uint32_t block_end[4];      // inst_count at the end of each new block
+    int line;
+} VectorCode;
+
+static bool analysis_init(Analysis* a, IRFlatFunction* flat) {
+    a->flat = flat;
+    a->reg_count = (uint32_t)flat->next_register_id;
+    a->def_inst = malloc((a->reg_count ? a->reg_count : 1) * sizeof(uint32_t));
+    a->inst_block = malloc((flat->inst_count ? flat->inst_count : 1) * sizeof(uint32_t));
+    a->is_int = ir_ssa_integer_registers(flat);
+    if (!a->def_inst || !a->inst_block || !a->is_int) return false;
+
+    for (uint32_t r = 0; r < a->reg_count; r++) a->def_inst[r] = IR_DOM_NONE;
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        const IRFlatBlock* block = &flat->blocks[b];
+        for (uint32_t i = block->first_inst; i < block->first_inst + block->inst_count; i++) {
+            a->inst_block[i] = b;
+            IRFlatOperand dest = flat->insts[i].dest;
+            if (ir_flat_kind(dest) == IR_FLAT_REG && ir_flat_payload(dest) < a->reg_count) {
+                a->def_inst[ir_flat_payload(dest)] = i;
+            }
+        }
+    }
+    return true;
+}
+
+static void analysis_free(Analysis* a) {
+    free(a->def_inst);
+    free(a->inst_block);
+    free(a->is_int);
+}
+
+static bool operand_is_int(const Analysis* a, IRFlatOperand operand) {
+    switch (ir_flat_kind(operand)) {
+        case IR_FLAT_IMM: case IR_FLAT_INT:
+            return true;
+        case IR_FLAT_REG:
+            return ir_flat_payload(operand) < a->reg_count && a->is_int[ir_flat_payload(operand)];
+        default:
+            return false;
+    }
+}
+
+static bool in_loop(const Loop* loop, uint32_t block) {
+    if (block == loop->header) return true;
+    for (uint32_t c = 0; c < loop->chain_length; c++) {
+        if (loop->chain[c] == block) return true;
+    }
+    return false;
+}
+
+static bool is_one(const IRFlatFunction* flat, IRFlatOperand operand) {
+    return ir_flat_is_int_constant(operand) && ir_flat_int_value(flat, operand) == 1;
+}
+
+static bool same_register(IRFlatOperand a, IRFlatOperand b) {
+    return ir_flat_kind(a) == IR_FLAT_REG && a == b;
+}
+
+// Instruction in the loop body defining operand, IR_DOM_NONE if it is defined elsewhere
+static uint32_t body_def(const Analysis* a, const Loop* loop, IRFlatOperand operand) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG || ir_flat_payload(operand) >= a->reg_count) return IR_DOM_NONE;
+    uint32_t def = a->def_inst[ir_flat_payload(operand)];
+    if (def == IR_DOM_NONE || a->inst_block[def] == loop->header || !in_loop(loop, a->inst_block[def])) {
+        return IR_DOM_NONE;
+    }
+    return def;
+}
+
+static bool is_update(const Loop* loop, uint32_t inst) {
+    if (inst == loop->iv_update) return true;
+    for (uint32_t r = 0; r < loop->reduction_count; r++) {
+        if (loop->reductions[r].update == inst) return true;
+    }
+    return false;
+}
+
+// Defined outside the loop (or a constant), so one splat serves every iteration
+static bool is_invariant(const Analysis* a, const Loop* loop, IRFlatOperand operand) {
+    if (ir_flat_kind(operand) != IR_FLAT_REG) return true;
+    uint32_t reg = ir_flat_payload(operand);
+    if (reg >= a->reg_count) return false;
+    uint32_t def = a->def_inst[reg];
+    return def == IR_DOM_NONE || !in_loop(loop, a->inst_block[def]);
+}
+
+// An operand the vector body can compute: the induction variable, a widened body value or an invariant
+static bool widenable(const Analysis* a, const Loop* loop, IRFlatOperand operand) {
+    if (!operand_is_int(a, operand)) return false;
+    if (same_register(operand, loop->iv)) return true;
+    uint32_t def = body_def(a, loop, operand);
+    if (def != IR_DOM_NONE) return !is_update(loop, def);
+    return is_invariant(a, loop, operand);
+}
+
+// The chain of single-entry blocks from the header's branch back to the header
+static bool find_chain(const Analysis* a, Loop* loop, uint32_t first) {
+    const IRFlatFunction* flat = a->flat;
+    uint32_t b = first;
+    loop->chain_length = 0;
+    for (;;) {
+        if (b == loop->header || loop->chain_length == MAX_CHAIN_BLOCKS) return false;
+        const IRFlatBlock* block = &flat->blocks[b];
+        if (block->pred_count != 1 || block->inst_count == 0) return false;
+
+        const IRFlatInst* last = &flat->insts[block->first_inst + block->inst_count - 1];
+        if (last->opcode != IR_JUMP || ir_flat_kind(last->src[0]) != IR_FLAT_LABEL) return false;
+        for (uint32_t i = block->first_inst; i + 1 < block->first_inst + block->inst_count; i++) {
+            const IRFlatInst* inst = &flat->insts[i];
+            if (inst->opcode != IR_ADD && inst->opcode != IR_SUB && inst->opcode != IR_MUL) return false;
+            if (ir_flat_kind(inst->dest) != IR_FLAT_REG) return false;
+        }
+
+        loop->chain[loop->chain_length++] = b;
+        b = ir_flat_payload(last->src[0]);
+        if (b == loop->header) return true;
+    }
+}
+
+// The value a header PHI takes from pred
+static IRFlatOperand phi_input(const IRFlatFunction* flat, const IRFlatInst* phi, uint32_t pred) {
+    for (uint32_t p = 0; p + 1 < phi->arg_count; p += 2) {
+        IRFlatOperand label = flat->args[phi->first_arg + p + 1];
+        if (ir_flat_kind(label) == IR_FLAT_LABEL && ir_flat_payload(label) == pred) {
+            return flat->args[phi->first_arg + p];
+        }
+    }
+    return IR_FLAT_NO_OPERAND;
+}
+
+// Each header PHI is the induction variable or a sum reduction
+static bool classify_phis(const Analysis* a, Loop* loop, uint32_t latch, uint32_t phi_count) {
+    const IRFlatFunction* flat = a->flat;
+    const IRFlatBlock* header = &flat->blocks[loop->header];
+    loop->iv_update = IR_DOM_NONE;
+    loop->reduction_count = 0;
+
+    for (uint32_t i = header->first_inst; i < header->first_inst + phi_count; i++) {
+        const IRFlatInst* phi = &flat->insts[i];
+        IRFlatOperand initial = phi_input(flat, phi, loop->preheader);
+        uint32_t update = body_def(a, loop, phi_input(flat, phi, latch));
+        if (initial == IR_FLAT_NO_OPERAND || update == IR_DOM_NONE || !operand_is_int(a, phi->dest)) return false;
+
+        const IRFlatInst* inst = &flat->insts[update];
+        if (same_register(phi->dest, loop->iv)) {
+            bool step = inst->opcode == IR_ADD &&
+                        ((same_register(inst->src[0], phi->dest) && is_one(flat, inst->src[1])) ||
+                         (same_register(inst->src[1], phi->dest) && is_one(flat, inst->src[0])));
+            if (!step) return false;
+            loop->iv_update = update;
+            loop->iv_initial = initial;
+            continue;
+        }
+
+        IRFlatOperand term;
+        if (inst->opcode == IR_ADD && same_register(inst->src[0], phi->dest)) term = inst->src[1];
+        else if (inst->opcode == IR_ADD && same_register(inst->src[1], phi->dest)) term = inst->src[0];
+        else if (inst->opcode == IR_SUB && same_register(inst->src[0], phi->dest)) term = inst->src[1];
+        else return false;
+        if (same_register(term, phi->dest) || loop->reduction_count == MAX_REDUCTIONS) return false;
+
+        Reduction* reduction = &loop->reductions[loop->reduction_count++];
+        reduction->phi = i;
+        reduction->update = update;
+        reduction->initial = initial;
+        reduction->term = term;
+    }
+    return loop->iv_update != IR_DOM_NONE && loop->reduction_count > 0;
+}
+
+// Operands inside the body only read values the vector code has
+static bool check_body(const Analysis* a, const Loop* loop) {
+    const IRFlatFunction* flat = a->flat;
+    uint32_t count = 0;
+    for (uint32_t c = 0; c < loop->chain_length; c++) {
+        const IRFlatBlock* block = &flat->blocks[loop->chain[c]];
+        count += block->inst_count - 1;
+        if (count > MAX_BODY_INSTS) return false;
+        for (uint32_t i = block->first_inst; i + 1 < block->first_inst + block->inst_count; i++) {
+            const IRFlatInst* inst = &flat->insts[i];
+            if (i == loop->iv_update) continue;
+
+            bool reduction = false;
+            for (uint32_t r = 0; r < loop->reduction_count; r++) {
+                if (loop->reductions[r].update == i) {
+                    reduction = true;
+                    if (!widenable(a, loop, loop->reductions[r].term)) return false;
+                }
+            }
+            if (!reduction && (!widenable(a, loop, inst->src[0]) || !widenable(a, loop, inst->src[1]))) return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Match the loop headed by block h: PHIs, `lt c, iv, bound`, a branch
+ * into the body chain or out to the exit, and exactly two predecessors
+ * (the preheader and the end of the chain)
+ */
+static bool match_loop(const Analysis* a, uint32_t h, Loop* loop) {
+    const IRFlatFunction* flat = a->flat;
+    const IRFlatBlock* header = &flat->blocks[h];
+    memset(loop, 0, sizeof(*loop));
+    loop->header = h;
+
+    uint32_t phi_count = 0;
+    while (phi_count < header->inst_count && flat->insts[header->first_inst + phi_count].opcode == IR_PHI) phi_count++;
+    if (phi_count == 0 || header->inst_count != phi_count + 2 || header->pred_count != 2) return false;
+
+    const IRFlatInst* compare = &flat->insts[header->first_inst + phi_count];
+    const IRFlatInst* branch = compare + 1;
+    if (compare->opcode != IR_LT || branch->opcode != IR_BRANCH || !same_register(branch->src[0], compare->dest) ||
+        ir_flat_kind(branch->src[1]) != IR_FLAT_LABEL || ir_flat_kind(branch->src[2]) != IR_FLAT_LABEL) {
+        return false;
+    }
+    loop->iv = compare->src[0];
+    loop->bound = compare->src[1];
+    loop->exit = ir_flat_payload(branch->src[2]);
+    if (ir_flat_kind(loop->iv) != IR_FLAT_REG || !find_chain(a, loop, ir_flat_payload(branch->src[1]))) return false;
+    if (in_loop(loop, loop->exit)) return false;
+
+    uint32_t latch = loop->chain[loop->chain_length - 1];
+    uint32_t first_pred = flat->edges[header->first_pred], second_pred = flat->edges[header->first_pred + 1];
+    if (first_pred != latch && second_pred != latch) return false;
+    loop->preheader = first_pred == latch ? second_pred : first_pred;
+    if (loop->preheader == latch) return false;
+
+    uint32_t iv_def = a->def_inst[ir_flat_payload(loop->iv)];
+    if (iv_def == IR_DOM_NONE || a->inst_block[iv_def] != h || flat->insts[iv_def].opcode != IR_PHI) return false;
+    if (!is_invariant(a, loop, loop->bound)) return false;
+
+    return classify_phis(a, loop, latch, phi_count) && check_body(a, loop);
+}
+
+// Code generation for the vector blocks
+
+static uint32_t new_register(IRFlatFunction* flat) {
+    return (uint32_t)flat->next_register_id++;
+}
+
+static IRFlatInst* emit(VectorCode* code, IROpcode opcode, IRFlatOperand dest,
+                        IRFlatOperand a, IRFlatOperand b, IRFlatOperand c) {
+    IRFlatInst* inst = &code->insts[code->inst_count++];
+    memset(inst, 0, sizeof(*inst));
+    inst->opcode = opcode;
+    inst->dest = dest;
+    inst->src[0] = a;
+    inst->src[1] = b;
+    inst->src[2] = c;
+    inst->comment = IR_FLAT_NO_STRING;
+    inst->line_number = code->line;
+    return inst;
+}
+
+static IRFlatOperand reg_operand(uint32_t reg) {
+    return ir_flat_operand(IR_FLAT_REG, reg);
+}
+
+static IRFlatOperand label_operand(uint32_t block) {
+    return ir_flat_operand(IR_FLAT_LABEL, block);
+}
+
+static IRFlatOperand imm_operand(int value) {
+    return ir_flat_operand(IR_FLAT_IMM, (uint32_t)value);
+}
+
+static void emit_phi(VectorCode* code, uint32_t dest, IRFlatOperand entry, uint32_t entry_block,
+                     IRFlatOperand back, uint32_t back_block) {
+    IRFlatInst* phi = emit(code, IR_PHI, reg_operand(dest), IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND,
+                           IR_FLAT_NO_OPERAND);
+    phi->first_arg = code->arg_count;
+    phi->arg_count = 4;
+    code->args[code->arg_count++] = entry;
+    code->args[code->arg_count++] = label_operand(entry_block);
+    code->args[code->arg_count++] = back;
+    code->args[code->arg_count++] = label_operand(back_block);
+}
+
+typedef struct {
+    IRFlatOperand scalar;
+    uint32_t vector;
+} Splat;
+
+// Vector register for a widenable operand; invariants are splatted in the preheader on first use
+static IRFlatOperand vector_of(IRFlatFunction* flat, const Loop* loop, const uint32_t* widened, uint32_t viv,
+                               Splat* splats, uint32_t* splat_count, VectorCode* preheader, IRFlatOperand operand) {
+    if (same_register(operand, loop->iv)) return reg_operand(viv);
+    if (ir_flat_kind(operand) == IR_FLAT_REG && widened[ir_flat_payload(operand)] != IR_DOM_NONE) {
+        return reg_operand(widened[ir_flat_payload(operand)]);
+    }
+    for (uint32_t s = 0; s < *splat_count; s++) {
+        if (splats[s].scalar == operand) return reg_operand(splats[s].vector);
+    }
+    if (*splat_count == MAX_INVARIANTS) return IR_FLAT_NO_OPERAND;
+
+    Splat* splat = &splats[(*splat_count)++];
+    splat->scalar = operand;
+    splat->vector = new_register(flat);
+    emit(preheader, IR_VEC_SPLAT, reg_operand(splat->vector), operand, IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND);
+    return reg_operand(splat->vector);
+}
+
+/*
+ * Build the four vector blocks for loop, numbered h .. h + 3 where h is
+ * the header's index (the header itself moves to h + 4):
+ *
+ *   vec.ph:   viv0 = iota(iv_initial), splats of the invariants, jump vec
+ *   vec:      PHIs for viv, the scalar iv and each vector sum;
+ *             branch on iv + LANES - 1 < bound to vec.body or vec.end
+ *   vec.body: the widened body, then viv += LANES, iv += LANES
+ *   vec.end:  each reduction's initial value plus its lane sums
+ *
+ * entry_values receives the values the header's PHIs now take from vec.end.
+ */
+static bool build_vector_code(IRFlatFunction* flat, const Analysis* a, const Loop* loop,
+                              VectorCode* code, IRFlatOperand* entry_values) {
+    uint32_t h = loop->header;
+    uint32_t ph = h, cond = h + 1, body = h + 2, end = h + 3;
+    code->line = flat->insts[flat->blocks[h].first_inst].line_number;
+
+    uint32_t* widened = malloc((a->reg_count ? a->reg_count : 1) * sizeof(uint32_t));
+    VectorCode* preheader = calloc(1, sizeof(VectorCode));
+    VectorCode* vector_body = calloc(1, sizeof(VectorCode));
+    if (!widened || !preheader || !vector_body) {
+        free(widened);
+        free(preheader);
+        free(vector_body);
+        return false;
+    }
+    for (uint32_t r = 0; r < a->reg_count; r++) widened[r] = IR_DOM_NONE;
+    preheader->line = vector_body->line = code->line;
+
+    uint32_t viv0 = new_register(flat), viv = new_register(flat), viv_next = new_register(flat);
+    uint32_t step = new_register(flat), zero = new_register(flat);
+    uint32_t iv = new_register(flat), iv_next = new_register(flat);
+    uint32_t last = new_register(flat), condition = new_register(flat);
+    uint32_t accumulators[MAX_REDUCTIONS], next_accumulators[MAX_REDUCTIONS];
+    for (uint32_t r = 0; r < loop->reduction_count; r++) {
+        accumulators[r] = new_register(flat);
+        next_accumulators[r] = new_register(flat);
+    }
+
+    emit(preheader, IR_VEC_IOTA, reg_operand(viv0), loop->iv_initial, IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND);
+    emit(preheader, IR_VEC_SPLAT, reg_operand(step), imm_operand(IR_VECTOR_LANES), IR_FLAT_NO_OPERAND,
+         IR_FLAT_NO_OPERAND);
+    emit(preheader, IR_VEC_SPLAT, reg_operand(zero), imm_operand(0), IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND);
+
+    // Widen the body in order; the updates of the iv and the sums come after it
+    Splat splats[MAX_INVARIANTS];
+    uint32_t splat_count = 0;
+    bool ok = true;
+    for (uint32_t c = 0; ok && c < loop->chain_length; c++) {
+        const IRFlatBlock* block = &flat->blocks[loop->chain[c]];
+        for (uint32_t i = block->first_inst; ok && i + 1 < block->first_inst + block->inst_count; i++) {
+            if (is_update(loop, i)) continue;
+            const IRFlatInst* inst = &flat->insts[i];
+            IRFlatOperand lhs = vector_of(flat, loop, widened, viv, splats, &splat_count, preheader, inst->src[0]);
+            IRFlatOperand rhs = vector_of(flat, loop, widened, viv, splats, &splat_count, preheader, inst->src[1]);
+            ok = lhs != IR_FLAT_NO_OPERAND && rhs != IR_FLAT_NO_OPERAND;
+
+            IROpcode opcode = inst->opcode == IR_ADD ? IR_VEC_ADD : inst->opcode == IR_SUB ? IR_VEC_SUB : IR_VEC_MUL;
+            uint32_t dest = new_register(flat);
+            widened[ir_flat_payload(inst->dest)] = dest;
+            emit(vector_body, opcode, reg_operand(dest), lhs, rhs, IR_FLAT_NO_OPERAND);
+        }
+    }
+    for (uint32_t r = 0; ok && r < loop->reduction_count; r++) {
+        const Reduction* reduction = &loop->reductions[r];
+        IRFlatOperand term = vector_of(flat, loop, widened, viv, splats, &splat_count, preheader, reduction->term);
+        ok = term != IR_FLAT_NO_OPERAND;
+        IROpcode opcode = flat->insts[reduction->update].opcode == IR_SUB ? IR_VEC_SUB : IR_VEC_ADD;
+        emit(vector_body, opcode, reg_operand(next_accumulators[r]), reg_operand(accumulators[r]), term,
+             IR_FLAT_NO_OPERAND);
+    }
+
+    if (ok) {
+        // vec.ph
+        for (uint32_t i = 0; i < preheader->inst_count; i++) code->insts[code->inst_count++] = preheader->insts[i];
+        emit(code, IR_JUMP, IR_FLAT_NO_OPERAND, label_operand(cond), IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND);
+        code->block_end[0] = code->inst_count;
+
+        // vec
+        emit_phi(code, viv, reg_operand(viv0), ph, reg_operand(viv_next), body);
+        emit_phi(code, iv, loop->iv_initial, ph, reg_operand(iv_next), body);
+        for (uint32_t r = 0; r < loop->reduction_count; r++) {
+            emit_phi(code, accumulators[r], reg_operand(zero), ph, reg_operand(next_accumulators[r]), body);
+        }
+        emit(code, IR_ADD, reg_operand(last), reg_operand(iv), imm_operand(IR_VECTOR_LANES - 1), IR_FLAT_NO_OPERAND);
+        emit(code, IR_LT, reg_operand(condition), reg_operand(last), loop->bound, IR_FLAT_NO_OPERAND);
+        emit(code, IR_BRANCH, IR_FLAT_NO_OPERAND, reg_operand(condition), label_operand(body), label_operand(end));
+        code->block_end[1] = code->inst_count;
+
+        // vec.body
+        for (uint32_t i = 0; i < vector_body->inst_count; i++) code->insts[code->inst_count++] = vector_body->insts[i];
+        emit(code, IR_VEC_ADD, reg_operand(viv_next), reg_operand(viv), reg_operand(step), IR_FLAT_NO_OPERAND);
+        emit(code, IR_ADD, reg_operand(iv_next), reg_operand(iv), imm_operand(IR_VECTOR_LANES), IR_FLAT_NO_OPERAND);
+        emit(code, IR_JUMP, IR_FLAT_NO_OPERAND, label_operand(cond), IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND);
+        code->block_end[2] = code->inst_count;
+
+        // vec.end
+        entry_values[0] = reg_operand(iv);
+        for (uint32_t r = 0; r < loop->reduction_count; r++) {
+            uint32_t sum = new_register(flat), total = new_register(flat);
+            emit(code, IR_VEC_REDUCE_ADD, reg_operand(sum), reg_operand(accumulators[r]), IR_FLAT_NO_OPERAND,
+                 IR_FLAT_NO_OPERAND);
+            emit(code, IR_ADD, reg_operand(total), loop->reductions[r].initial, reg_operand(sum), IR_FLAT_NO_OPERAND);
+            entry_values[1 + r] = reg_operand(total);
+        }
+        emit(code, IR_JUMP, IR_FLAT_NO_OPERAND, label_operand(h + 4), IR_FLAT_NO_OPERAND, IR_FLAT_NO_OPERAND);
+        code->block_end[3] = code->inst_count;
+    }
+
+    free(widened);
+    free(preheader);
+    free(vector_body);
+    return ok;
+}
+
+static IRFlatOperand shift_label(IRFlatOperand operand, uint32_t h) {
+    if (ir_flat_kind(operand) != IR_FLAT_LABEL || ir_flat_payload(operand) < h) return operand;
+    return label_operand(ir_flat_payload(operand) + 4);
+}
+
+/*
+ * Splice the vector blocks in front of the header: blocks from the
+ * header on move up by four, the preheader jumps to vec.ph instead of
+ * the header, and the header's PHIs take their entry values from vec.end
+ */
+static bool splice(IRFlatFunction* flat, const Loop* loop, const VectorCode* code, const IRFlatOperand* entry_values) {
+    uint32_t h = loop->header;
+    char name[256];
+    const char* header_label = ir_flat_string(flat, flat->blocks[h].label);
+    static const char* suffixes[4] = { "vec.ph", "vec", "vec.body", "vec.end" };
+    uint32_t labels[4];
+    for (int b = 0; b < 4; b++) {
+        snprintf(name, sizeof(name), "%s.%s", header_label ? header_label : "loop", suffixes[b]);
+        labels[b] = ir_flat_add_string(flat, name);
+        header_label = ir_flat_string(flat, flat->blocks[h].label);    // The pool may have moved
+        if (labels[b] == IR_FLAT_NO_STRING) return false;
+    }
+
+    uint32_t block_count = flat->block_count + 4;
+    uint32_t inst_count = flat->inst_count + code->inst_count;
+    uint32_t arg_count = flat->arg_count + code->arg_count;
+    IRFlatBlock* blocks = calloc(block_count, sizeof(IRFlatBlock));
+    IRFlatInst* insts = calloc(inst_count, sizeof(IRFlatInst));
+    IRFlatOperand* args = calloc(arg_count ? arg_count : 1, sizeof(IRFlatOperand));
+    if (!blocks || !insts || !args) {
+        free(blocks);
+        free(insts);
+        free(args);
+        return false;
+    }
+
+    uint32_t next_block = 0, next_inst = 0, next_arg = 0;
+    for (uint32_t b = 0; b < flat->block_count; b++) {
+        if (b == h) {
+            uint32_t start = 0;
+            for (int v = 0; v < 4; v++) {
+                IRFlatBlock* block = &blocks[next_block++];
+                block->label = labels[v];
+                block->first_inst = next_inst;
+                for (uint32_t i = start; i < code->block_end[v]; i++) {
+                    IRFlatInst* inst = &insts[next_inst++];
+                    *inst = code->insts[i];
+                    inst->first_arg = next_arg;
+                    for (uint32_t p = 0; p < inst->arg_count; p++) args[next_arg++] = code->args[code->insts[i].first_arg + p];
+                }
+                block->inst_count = next_inst - block->first_inst;
+                start = code->block_end[v];
+            }
+        }
+
+        const IRFlatBlock* old_block = &flat->blocks[b];
+        IRFlatBlock* block = &blocks[next_block++];
+        block->label = old_block->label;
+        block->first_inst = next_inst;
+        for (uint32_t i = old_block->first_inst; i < old_block->first_inst + old_block->inst_count; i++) {
+            const IRFlatInst* old_inst = &flat->insts[i];
+            IRFlatInst* inst = &insts[next_inst++];
+            *inst = *old_inst;
+            for (int s = 0; s < 3; s++) {
+                bool to_header = ir_flat_kind(inst->src[s]) == IR_FLAT_LABEL && ir_flat_payload(inst->src[s]) == h;
+                inst->src[s] = b == loop->preheader && to_header ? label_operand(h) : shift_label(inst->src[s], h);
+            }
+
+            inst->first_arg = next_arg;
+            for (uint32_t p = 0; p < old_inst->arg_count; p++) {
+                IRFlatOperand arg = flat->args[old_inst->first_arg + p];
+                if (b == h && old_inst->opcode == IR_PHI && p % 2 == 1 && ir_flat_payload(arg) == loop->preheader) {
+                    // (initial, preheader) becomes (value after the vector loop, vec.end)
+                    IRFlatOperand value = entry_values[0];
+                    for (uint32_t r = 0; r < loop->reduction_count; r++) {
+                        if (loop->reductions[r].phi == i) value = entry_values[1 + r];
+                    }
+                    args[next_arg - 1] = value;
+                    args[next_arg++] = label_operand(h + 3);
+                    continue;
+                }
+                args[next_arg++] = shift_label(arg, h);
+            }
+        }
+        block->inst_count = next_inst - block->first_inst;
+    }
+
+    free(flat->blocks);
+    free(flat->insts);
+    free(flat->args);
+    flat->blocks = blocks;
+    flat->block_count = block_count;
+    flat->insts = insts;
+    flat->inst_count = flat->inst_capacity = inst_count;
+    flat->args = args;
+    flat->arg_count = flat->arg_capacity = arg_count;
+    return ir_flat_rebuild_edges(flat);
+}
+
+int ir_pass_vectorize(IRFlatFunction* flat) {
+    if (!flat || flat->block_count == 0) return 0;
+
+    // Later blocks first, so the indices of loops still to do stay put
+    int vectorized = 0;
+    uint32_t limit = flat->block_count;
+    while (limit > 0) {
+        Analysis a = { 0 };
+        if (!analysis_init(&a, flat)) {
+            analysis_free(&a);
+            return -1;
+        }
+
+        Loop loop;
+        uint32_t h = limit;
+        while (h > 0 && !match_loop(&a, h - 1, &loop)) h--;
+        if (h == 0) {
+            analysis_free(&a);
+            break;
+        }
+        limit = h - 1;
+
+        // The iv's entry value, then each reduction's
+        IRFlatOperand entry_values[1 + MAX_REDUCTIONS];
+        VectorCode* code = calloc(1, sizeof(VectorCode));
+        bool ok = code && build_vector_code(flat, &a, &loop, code, entry_values) &&
+                  splice(flat, &loop, code, entry_values);
+        free(code);
+        analysis_free(&a);
+        if (!ok) return -1;
+        vectorized++;
+    }
+    return vectorized;
+}
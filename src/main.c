@@ -3,12 +3,23 @@
 #include <string.h>
 #include <getopt.h>
 #include <unistd.h>
+#include <limits.h>
+#include <time.h>
+#include <errno.h>
 
 #define _GNU_SOURCE
 
 #include "frontend/lexer.h"
+#include "frontend/parser.h"
+#include "frontend/semantic.h"
+#include "frontend/irgen.h"
 #include "ir/ir.h"
 #include "backend/codegen.h"
+#include "backend/elf_writer.h"
+#include "backend/jit.h"
+#include "backend/llvm_codegen.h"
+#include "compiler/thread_pool.h"
+#include "compiler/compile_cache.h"
 
 // Use strdup from ir.c
 extern char* my_strdup(const char* s);
@@ -19,6 +30,9 @@ typedef enum {
     MODE_FRONTEND_ONLY,
     MODE_BACKEND_ONLY,
     MODE_TOKENIZE_ONLY,
+    MODE_CHECK,
+    MODE_RUN,
+    MODE_EMIT_LLVM,
     MODE_HELP
 } CompilerMode;
 
@@ -26,10 +40,17 @@ typedef enum {
 typedef struct {
     CompilerMode mode;
     char* input_file;
+    char** input_files;     // Every positional argument (--check takes many)
+    int input_count;
+    int jobs;               // Worker threads for --check and code generation (0 = one per CPU)
     char* output_file;
     TargetArch target;
     bool verbose;
     bool optimize;
+    bool use_cache;         // Reuse frontend IR from the compilation cache
+    bool instrument;        // Count block executions into <module>.gpprof
+    char* profile_use;      // Block counts from an instrumented run (implies -O)
+    char* runtime_path;     // RUNPATH for executables ("" for none); NULL: where the runtime is
 } CompilerOptions;
 
 // Print usage information
@@ -37,30 +58,50 @@ void print_usage(const char* program_name) {
     printf("GPLANG Compiler - Modern compilation pipeline: .gp → IR → Assembly → .o → .bin\n\n");
     printf("Usage: %s [OPTIONS] <input_file>\n\n", program_name);
     printf("Compilation Modes:\n");
-    printf("  --frontend         Frontend only: .gp → IR\n");
-    printf("  --backend          Backend only: IR → Assembly\n");
+    printf("  --frontend         Frontend only: .gp → IR (binary with -o FILE.gpir)\n");
+    printf("  --backend          Backend only: binary IR → Assembly\n");
     printf("  --tokenize         Tokenize only: .gp → Tokens\n");
-    printf("  (default)          Full compilation: .gp → Assembly\n\n");
+    printf("  --check            Parse and check FILES... in parallel\n");
+    printf("  --run              Compile to memory and run (x86_64 only)\n");
+    printf("  --emit-llvm        Typed LLVM IR for opt/llc: .gp → .ll\n");
+    printf("  (default)          Full compilation: .gp → Assembly, object or executable\n\n");
     printf("Options:\n");
-    printf("  -o, --output FILE  Output file (default: stdout)\n");
-    printf("  --target ARCH      Target architecture (x86_64, arm64, riscv64)\n");
+    printf("  -o, --output FILE  Output file (default: stdout); on x86_64, FILE.s is assembly,\n");
+    printf("                     FILE.o an ELF object and any other name an executable\n");
+    printf("  --target ARCH      Target architecture (x86_64, arm64; riscv64 is not implemented)\n");
     printf("  -O, --optimize     Enable optimizations\n");
+    printf("  --instrument       Count block executions; the program writes NAME.gpprof\n");
+    printf("                     (or $GPLANG_PROFILE) when main returns\n");
+    printf("  --profile-use FILE Optimize (-O) with block counts from FILE\n");
+    printf("  --runtime-path DIR Where executables load libgplang_rt.so from, written as given\n");
+    printf("                     ('$ORIGIN/../lib', or '' for the loader's search path)\n");
     printf("  --lto              Enable Link-Time Optimization\n");
     printf("  --lto=thin         Enable Thin LTO (faster compilation)\n");
     printf("  --lto=full         Enable Full LTO (maximum optimization)\n");
+    printf("  -j, --jobs N       Worker threads for --check and code generation (default: CPU count)\n");
+    printf("  --no-cache         Ignore the compilation cache (%s, or $GPLANG_CACHE_DIR)\n",
+           COMPILE_CACHE_DEFAULT_DIR);
     printf("  -v, --verbose      Verbose output\n");
     printf("  -h, --help         Show this help\n\n");
     printf("Examples:\n");
     printf("  %s examples/basic/count_1m.gp\n", program_name);
     printf("  %s --frontend count_1m.gp -o count_1m.ir\n", program_name);
-    printf("  %s --backend count_1m.ir --target x86_64 -o count_1m.s\n", program_name);
+    printf("  %s --frontend count_1m.gp -o count_1m.gpir\n", program_name);
+    printf("  %s --backend count_1m.gpir --target x86_64 -o count_1m.s\n", program_name);
     printf("  %s --target arm64 -O count_1m.gp -o count_1m.s\n", program_name);
+    printf("  %s -O count_1m.gp -o count_1m       (no assembler or linker needed)\n", program_name);
+    printf("  %s --run -O examples/basic/fibonacci.gp\n", program_name);
+    printf("  %s --instrument app.gp -o app && ./app && %s --profile-use app.gpprof app.gp -o app\n",
+           program_name, program_name);
+    printf("  %s --emit-llvm count_1m.gp -o count_1m.ll && opt -O3 count_1m.ll | llc\n", program_name);
+    printf("  %s --check -j 8 examples/*/*.gp\n", program_name);
     printf("\nCompilation Pipeline:\n");
     printf("  1. Frontend: .gp → IR (Intermediate Representation)\n");
     printf("  2. Optimization: IR → Optimized IR\n");
     printf("  3. Backend: IR → Target Assembly (x86_64/ARM64/RISC-V)\n");
-    printf("  4. Assembly: .s → .o (using system assembler)\n");
-    printf("  5. Linking: .o → .bin (using system linker)\n");
+    printf("  4. Encoding: x86_64 machine code → .o or executable (in-process)\n");
+    printf("  5. Loading: executables link libgplang_rt.so at run time (--runtime-path,\n");
+    printf("     else the directory it was found in: $GPLANG_RUNTIME_DIR or ../lib)\n");
 }
 
 // Parse command line arguments
@@ -68,28 +109,43 @@ CompilerOptions parse_arguments(int argc, char* argv[]) {
     CompilerOptions options = {
         .mode = MODE_FULL_COMPILE,
         .input_file = NULL,
+        .input_files = NULL,
+        .input_count = 0,
+        .jobs = 0,
         .output_file = NULL,
         .target = TARGET_X86_64,
         .verbose = false,
-        .optimize = false
+        .optimize = false,
+        .use_cache = true,
+        .instrument = false,
+        .profile_use = NULL,
+        .runtime_path = NULL
     };
     
     static struct option long_options[] = {
         {"frontend", no_argument, 0, 'f'},
         {"backend", no_argument, 0, 'b'},
         {"tokenize", no_argument, 0, 't'},
+        {"check", no_argument, 0, 'c'},
+        {"run", no_argument, 0, 'R'},
+        {"emit-llvm", no_argument, 0, 'L'},
+        {"jobs", required_argument, 0, 'j'},
         {"output", required_argument, 0, 'o'},
         {"target", required_argument, 0, 'T'},
         {"optimize", no_argument, 0, 'O'},
         {"verbose", no_argument, 0, 'v'},
         {"help", no_argument, 0, 'h'},
+        {"no-cache", no_argument, 0, 'N'},
+        {"instrument", no_argument, 0, 'I'},
+        {"profile-use", required_argument, 0, 'P'},
+        {"runtime-path", required_argument, 0, 'r'},
         {0, 0, 0, 0}
     };
     
     int option_index = 0;
     int c;
     
-    while ((c = getopt_long(argc, argv, "fbto:T:Ovh", long_options, &option_index)) != -1) {
+    while ((c = getopt_long(argc, argv, "fbtcj:o:T:Ovh", long_options, &option_index)) != -1) {
         switch (c) {
             case 'f':
                 options.mode = MODE_FRONTEND_ONLY;
@@ -100,6 +156,22 @@ CompilerOptions parse_arguments(int argc, char* argv[]) {
             case 't':
                 options.mode = MODE_TOKENIZE_ONLY;
                 break;
+            case 'c':
+                options.mode = MODE_CHECK;
+                break;
+            case 'R':
+                options.mode = MODE_RUN;
+                break;
+            case 'L':
+                options.mode = MODE_EMIT_LLVM;
+                break;
+            case 'j':
+                options.jobs = atoi(optarg);
+                if (options.jobs < 1) {
+                    fprintf(stderr, "Error: Invalid job count '%s'\n", optarg);
+                    exit(1);
+                }
+                break;
             case 'o':
                 options.output_file = my_strdup(optarg);
                 break;
@@ -124,27 +196,39 @@ CompilerOptions parse_arguments(int argc, char* argv[]) {
             case 'h':
                 options.mode = MODE_HELP;
                 break;
+            case 'N':
+                options.use_cache = false;
+                break;
+            case 'I':
+                options.instrument = true;
+                break;
+            case 'P':
+                options.profile_use = my_strdup(optarg);
+                options.optimize = true;
+                break;
+            case 'r':
+                options.runtime_path = my_strdup(optarg);
+                break;
             default:
                 fprintf(stderr, "Error: Unknown option\n");
                 exit(1);
         }
     }
     
-    // Get input file
+    // Get input files
     if (optind < argc) {
         options.input_file = my_strdup(argv[optind]);
+        options.input_files = &argv[optind];
+        options.input_count = argc - optind;
     }
     
     return options;
 }
 
-// Read file contents
-char* read_file(const char* filename) {
+// Read file contents; NULL with errno set if it cannot be opened
+static char* load_file(const char* filename) {
     FILE* file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
-        return NULL;
-    }
+    if (!file) return NULL;
     
     fseek(file, 0, SEEK_END);
     long length = ftell(file);
@@ -158,6 +242,13 @@ char* read_file(const char* filename) {
     return content;
 }
 
+// Read file contents, reporting a file that cannot be opened
+char* read_file(const char* filename) {
+    char* content = load_file(filename);
+    if (!content) fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
+    return content;
+}
+
 // Tokenize mode
 int tokenize_mode(CompilerOptions* options) {
     if (options->verbose) {
@@ -176,100 +267,612 @@ int tokenize_mode(CompilerOptions* options) {
     
     FILE* output = options->output_file ? fopen(options->output_file, "w") : stdout;
     
-    Token* token;
-    int token_count = 0;
+    // Batch tokenize into span tokens: one allocation for the whole file
+    TokenBuffer tokens;
+    token_buffer_init(&tokens);
+    lexer_tokenize_all(lexer, &tokens);
     
-    while ((token = lexer_next_token(lexer)) && token->type != TOKEN_EOF) {
-        fprintf(output, "%s: '%s' (line %d, col %d)\n",
+    int token_count = 0;
+    for (size_t i = 0; i < tokens.count; i++) {
+        Token* token = &tokens.tokens[i];
+        if (token->type == TOKEN_EOF) break;
+        
+        fprintf(output, "%s: '%.*s' (line %d, col %d)\n",
                 token_type_to_string(token->type),
-                token->value ? token->value : "",
+                token->length, token->value ? token->value : "",
                 token->line, token->column);
-        
-        token_destroy(token);
         token_count++;
     }
     
-    if (token) token_destroy(token);
-    
     if (options->verbose) {
         printf("✅ Tokenization complete: %d tokens\n", token_count);
     }
     
     if (output != stdout) fclose(output);
+    token_buffer_free(&tokens);
     lexer_destroy(lexer);
     free(source);
     
     return 0;
 }
 
-// Frontend mode
-int frontend_mode(CompilerOptions* options) {
+// Per-file result of --check
+typedef struct {
+    const char* filename;
+    size_t token_count;
+    size_t node_count;
+    size_t read_errors;     // The file could not be opened
+    size_t parse_errors;
+    size_t semantic_errors;
+    char* report;           // Diagnostics, printed in input order
+    size_t report_size;
+    bool failed;
+} CheckResult;
+
+// Lex, parse and analyze one file with its own Parser and analyzer,
+// so any number of these can run at once
+static void check_file(void* context, size_t index) {
+    CheckResult* result = &((CheckResult*)context)[index];
+    FILE* report = open_memstream(&result->report, &result->report_size);
+    
+    char* source = load_file(result->filename);
+    if (!source) {
+        result->read_errors = 1;
+        result->failed = true;
+        if (report) {
+            fprintf(report, "   %s: Cannot open file: %s\n", result->filename, strerror(errno));
+            fclose(report);
+        }
+        return;
+    }
+    
+    Lexer* lexer = lexer_create(source);
+    TokenBuffer tokens;
+    token_buffer_init(&tokens);
+    lexer_tokenize_all(lexer, &tokens);
+    result->token_count = tokens.count;
+    
+    Parser* parser = parser_create();
+    ast_node_t* ast = parser_parse(parser, tokens.tokens, tokens.count);
+    result->parse_errors = parser_error_count(parser);
+    for (size_t i = 0; i < result->parse_errors && report; i++) {
+        const parse_error_t* error = parser_error(parser, i);
+        fprintf(report, "   %s:%zu:%zu: %s\n", result->filename,
+                error->line, error->column, error->message);
+    }
+    
+    if (ast) {
+        result->node_count = ast_arena_node_count(parser_arena(parser));
+        
+        SemanticAnalyzer* analyzer = semantic_create();
+        semantic_check(analyzer, ast);
+        result->semantic_errors = semantic_error_count(analyzer);
+        for (size_t i = 0; i < result->semantic_errors && report; i++) {
+            fprintf(report, "   %s: %s\n", result->filename,
+                    semantic_error(analyzer, i)->message);
+        }
+        semantic_destroy(analyzer);
+    }
+    
+    result->failed = result->parse_errors > 0 || result->semantic_errors > 0;
+    
+    if (report) fclose(report);
+    parser_destroy(parser);
+    token_buffer_free(&tokens);
+    lexer_destroy(lexer);
+    free(source);
+}
+
+// Check mode: front end over many files on a thread pool
+int check_mode(CompilerOptions* options) {
+    int count = options->input_count;
+    CheckResult* results = calloc(count, sizeof(CheckResult));
+    if (!results) return 1;
+    
+    for (int i = 0; i < count; i++) {
+        results[i].filename = options->input_files[i];
+    }
+    
+    thread_pool_t* pool = thread_pool_create(options->jobs);
     if (options->verbose) {
-        printf("🌳 Frontend: %s → IR\n", options->input_file);
+        printf("🔍 Checking %d files on %d threads\n", count, thread_pool_size(pool));
     }
     
-    char* source = read_file(options->input_file);
-    if (!source) return 1;
+    thread_pool_run(pool, count, check_file, results);
+    thread_pool_destroy(pool);
+    
+    int failed = 0;
+    for (int i = 0; i < count; i++) {
+        CheckResult* result = &results[i];
+        if (result->failed) {
+            failed++;
+            if (result->read_errors > 0) {
+                printf("❌ %s: %zu read errors\n", result->filename, result->read_errors);
+            } else {
+                printf("❌ %s: %zu parse errors, %zu semantic errors\n", result->filename,
+                       result->parse_errors, result->semantic_errors);
+            }
+            if (result->report_size > 0) {
+                fwrite(result->report, 1, result->report_size, stdout);
+            }
+        } else if (options->verbose) {
+            printf("✅ %s: %zu tokens, %zu AST nodes\n", result->filename,
+                   result->token_count, result->node_count);
+        }
+        free(result->report);
+    }
     
-    // TODO: Implement full frontend pipeline
-    // For now, just tokenize and show structure
+    printf("%s Checked %d files: %d passed, %d failed\n", failed ? "❌" : "✅",
+           count, count - failed, failed);
     
-    Lexer* lexer = lexer_create(source);
-    if (!lexer) {
+    free(results);
+    return failed ? 1 : 0;
+}
+
+// Module name: file name without directory or extension
+static char* module_name_for(const char* filename) {
+    const char* base = strrchr(filename, '/');
+    base = base ? base + 1 : filename;
+    
+    char* name = my_strdup(base);
+    char* dot = name ? strrchr(name, '.') : NULL;
+    if (dot && dot != name) *dot = '\0';
+    return name;
+}
+
+// A parsed and checked source file; the AST lives in the parser's arena
+typedef struct {
+    Lexer* lexer;
+    TokenBuffer tokens;
+    Parser* parser;
+    ast_node_t* ast;        // NULL when there were errors
+} SourceUnit;
+
+static void source_unit_release(SourceUnit* unit) {
+    parser_destroy(unit->parser);
+    token_buffer_free(&unit->tokens);
+    lexer_destroy(unit->lexer);
+}
+
+// Lex, parse and check one source file; false after reporting errors
+static bool parse_source(CompilerOptions* options, const char* source, SourceUnit* unit) {
+    memset(unit, 0, sizeof(*unit));
+    token_buffer_init(&unit->tokens);
+    unit->lexer = lexer_create(source);
+    if (!unit->lexer) {
         fprintf(stderr, "Error: Failed to create lexer\n");
-        free(source);
-        return 1;
+        return false;
+    }
+    
+    lexer_tokenize_all(unit->lexer, &unit->tokens);
+    
+    unit->parser = parser_create();
+    ast_node_t* ast = parser_parse(unit->parser, unit->tokens.tokens, unit->tokens.count);
+    size_t error_count = parser_error_count(unit->parser);
+    for (size_t i = 0; i < error_count; i++) {
+        const parse_error_t* error = parser_error(unit->parser, i);
+        fprintf(stderr, "%s:%zu:%zu: %s\n", options->input_file,
+                error->line, error->column, error->message);
+    }
+    
+    if (ast && error_count == 0) {
+        SemanticAnalyzer* analyzer = semantic_create();
+        semantic_check(analyzer, ast);
+        error_count = semantic_error_count(analyzer);
+        for (size_t i = 0; i < error_count; i++) {
+            fprintf(stderr, "%s: %s\n", options->input_file, semantic_error(analyzer, i)->message);
+        }
+        semantic_destroy(analyzer);
+    }
+    
+    unit->ast = error_count == 0 ? ast : NULL;
+    return unit->ast != NULL;
+}
+
+// Lex, parse, check and lower one source file; NULL after reporting errors
+static IRModule* compile_source(CompilerOptions* options, const char* source) {
+    SourceUnit unit;
+    IRModule* module = NULL;
+    if (parse_source(options, source, &unit)) {
+        char* name = module_name_for(options->input_file);
+        module = irgen_module(unit.ast, name);
+        free(name);
+        if (module) {
+            module->source_file = my_strdup(options->input_file);
+            module->target_triple = my_strdup(target_arch_to_string(options->target));
+        }
+    }
+    
+    source_unit_release(&unit);
+    return module;
+}
+
+// Optimization pipeline run on frontend IR for -O
+static void optimize_module(CompilerOptions* options, IRModule* module, const IRProfile* profile) {
+    IROptimizeStats stats = { 0 };
+    ir_optimize_module(module, profile, &stats);
+    
+    if (options->verbose) {
+        printf("🔧 Optimizer:\n");
+        for (int i = 0; i < stats.pass_count; i++) {
+            const IRPassStats* pass = &stats.passes[i];
+            if (!pass->name) continue;      // Stage that never ran
+            printf("   • %-8s %6d → %6d instructions (%d changes)\n", pass->name,
+                   pass->instructions_before, pass->instructions_after, pass->changes);
+        }
+    }
+}
+
+// Frontend IR for the input file, from the compilation cache when the
+// source, compiler version and target are unchanged. The cache holds
+// unoptimized IR, so -O and plain builds share entries, and so do
+// byte-identical files: a hit is renamed after this input file.
+static IRModule* run_frontend(CompilerOptions* options) {
+    char* source = read_file(options->input_file);
+    if (!source) return NULL;
+    
+    const char* cache_dir = compile_cache_dir();
+    CompileCacheKey key = compile_cache_key(source, strlen(source), VERSION,
+                                            target_arch_to_string(options->target));
+    
+    IRModule* module = options->use_cache ? compile_cache_lookup(cache_dir, &key) : NULL;
+    if (module) {
+        free(module->name);
+        module->name = module_name_for(options->input_file);
+        free(module->source_file);
+        module->source_file = my_strdup(options->input_file);
+        if (options->verbose) {
+            printf("♻️  Cache hit: %s/%016llx.gpir\n", cache_dir, (unsigned long long)key.hash);
+        }
+    } else {
+        module = compile_source(options, source);
+        
+        if (module && options->use_cache) {
+            bool stored = compile_cache_store(cache_dir, &key, module);
+            if (options->verbose) {
+                printf("%s Cache %s: %s/%016llx.gpir\n", stored ? "💾" : "⚠️ ",
+                       stored ? "store" : "store failed", cache_dir, (unsigned long long)key.hash);
+            }
+        }
+    }
+    free(source);
+    if (!module) return NULL;
+    
+    // Counters go in before optimization, so profiles name frontend blocks
+    if (options->instrument) {
+        int counters = ir_profile_instrument(module);
+        if (counters < 0) {
+            fprintf(stderr, "Error: Out of memory\n");
+            ir_module_destroy(module);
+            return NULL;
+        }
+        if (options->verbose) {
+            printf("📊 Instrumented %d blocks: counts go to %s.gpprof when main returns\n",
+                   counters, module->name);
+        }
+    }
+    
+    IRProfile* profile = NULL;
+    if (options->profile_use) {
+        profile = ir_profile_load(options->profile_use);
+        if (!profile) {
+            fprintf(stderr, "Error: Cannot read profile '%s'\n", options->profile_use);
+            ir_module_destroy(module);
+            return NULL;
+        }
+        if (options->verbose) printf("📈 Profile: %s\n", options->profile_use);
+    }
+    
+    if (options->optimize) optimize_module(options, module, profile);
+    ir_profile_destroy(profile);
+    return module;
+}
+
+// Frontend mode
+int frontend_mode(CompilerOptions* options) {
+    if (options->verbose) {
+        printf("🌳 Frontend: %s → IR\n", options->input_file);
+    }
+    
+    IRModule* module = run_frontend(options);
+    if (!module) return 1;
+    
+    // "-o name.gpir" writes binary IR for --backend
+    const char* extension = options->output_file ? strrchr(options->output_file, '.') : NULL;
+    if (extension && strcmp(extension, ".gpir") == 0) {
+        bool saved = ir_module_save(module, options->output_file);
+        if (!saved) {
+            fprintf(stderr, "Error: Cannot write IR file '%s'\n", options->output_file);
+        } else if (options->verbose) {
+            printf("✅ Frontend complete: binary IR written to %s\n", options->output_file);
+        }
+        ir_module_destroy(module);
+        return saved ? 0 : 1;
     }
     
     FILE* output = options->output_file ? fopen(options->output_file, "w") : stdout;
+    if (!output) {
+        fprintf(stderr, "Error: Cannot open output file '%s'\n", options->output_file);
+        ir_module_destroy(module);
+        return 1;
+    }
     
-    // Generate placeholder IR
-    fprintf(output, "; GPLANG IR - Generated from %s\n", options->input_file);
-    fprintf(output, "; Target: %s\n", target_arch_to_string(options->target));
-    fprintf(output, "\n");
-    fprintf(output, "func_begin @main\n");
-    fprintf(output, "    ; Placeholder IR for count_1m.gp\n");
-    fprintf(output, "    const_int 1000000\n");
-    fprintf(output, "    store %%1, @count\n");
-    fprintf(output, "    call @Time.now\n");
-    fprintf(output, "    store %%2, @start_time\n");
-    fprintf(output, "    \n");
-    fprintf(output, "loop_begin:\n");
-    fprintf(output, "    load %%3, @i\n");
-    fprintf(output, "    load %%4, @count\n");
-    fprintf(output, "    lt %%5, %%3, %%4\n");
-    fprintf(output, "    branch %%5, loop_body, loop_end\n");
-    fprintf(output, "    \n");
-    fprintf(output, "loop_body:\n");
-    fprintf(output, "    ; Loop body implementation\n");
-    fprintf(output, "    jump loop_begin\n");
-    fprintf(output, "    \n");
-    fprintf(output, "loop_end:\n");
-    fprintf(output, "    call @Time.now\n");
-    fprintf(output, "    store %%6, @end_time\n");
-    fprintf(output, "    const_int 0\n");
-    fprintf(output, "    return %%7\n");
-    fprintf(output, "func_end\n");
+    ir_module_print(module, output);
     
     if (options->verbose) {
         printf("✅ Frontend complete: IR generated\n");
     }
     
     if (output != stdout) fclose(output);
-    lexer_destroy(lexer);
-    free(source);
+    ir_module_destroy(module);
     
     return 0;
 }
 
+// What -o asks for, by extension: .s (or stdout) is assembly text, .o an
+// ELF object and anything else a runnable executable. Only x86-64 has an
+// in-process encoder; the other targets always write assembly.
+typedef enum {
+    OUTPUT_ASSEMBLY,
+    OUTPUT_OBJECT,
+    OUTPUT_EXECUTABLE
+} OutputKind;
+
+static OutputKind output_kind(CompilerOptions* options) {
+    if (!options->output_file || options->target != TARGET_X86_64) return OUTPUT_ASSEMBLY;
+    
+    const char* base = strrchr(options->output_file, '/');
+    const char* extension = strrchr(base ? base : options->output_file, '.');
+    if (extension && strcmp(extension, ".s") == 0) return OUTPUT_ASSEMBLY;
+    if (extension && strcmp(extension, ".o") == 0) return OUTPUT_OBJECT;
+    return OUTPUT_EXECUTABLE;
+}
+
+// RUNPATH for executables: --runtime-path as given, else the directory
+// holding libgplang_rt.so: $GPLANG_RUNTIME_DIR, or ../lib next to this
+// binary. NULL leaves the search to the dynamic loader.
+static char* runtime_library_dir(const CompilerOptions* options) {
+    if (options->runtime_path) return *options->runtime_path ? my_strdup(options->runtime_path) : NULL;
+    
+    char path[PATH_MAX];
+    const char* dir = getenv("GPLANG_RUNTIME_DIR");
+    
+    if (!dir || !*dir) {
+        ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+        if (length <= 0) return NULL;
+        path[length] = '\0';
+        char* slash = strrchr(path, '/');
+        if (!slash) return NULL;
+        snprintf(slash, sizeof(path) - (slash - path), "/../lib");
+        dir = path;
+    }
+    
+    char library[PATH_MAX];
+    snprintf(library, sizeof(library), "%s/%s", dir, ELF_RUNTIME_LIBRARY);
+    if (access(library, R_OK) != 0) return NULL;
+    return realpath(dir, NULL);
+}
+
+// Threads generating the module's functions; none for a single function
+static thread_pool_t* codegen_pool(CompilerOptions* options, IRModule* module) {
+    if (!module->functions || !module->functions->next) return NULL;
+    return thread_pool_create(options->jobs);
+}
+
+// x86-64 machine code for module, or NULL after reporting an error
+static X86Encoder* encode_module(CompilerOptions* options, IRModule* module) {
+    X86Encoder* encoder = x86_64_encoder_create();
+    CodeGenerator* codegen = encoder ? codegen_create(options->target, NULL) : NULL;
+    if (!codegen) {
+        fprintf(stderr, "Error: Out of memory\n");
+        x86_64_encoder_destroy(encoder);
+        return NULL;
+    }
+    
+    codegen->encoder = encoder;
+    codegen->pool = codegen_pool(options, module);
+    if (!codegen_generate_module(codegen, module)) {
+        fprintf(stderr, "Error: %s\n", codegen->error_message
+                ? codegen->error_message : "Code generation failed");
+        x86_64_encoder_destroy(encoder);
+        encoder = NULL;
+    } else if (options->verbose) {
+        printf("🪛 Peephole: %d rewrites\n", codegen->peephole_rewrites);
+    }
+    thread_pool_destroy(codegen->pool);
+    codegen_destroy(codegen);
+    return encoder;
+}
+
+// Output file written under a temporary name and renamed into place once
+// it is complete, so a failed compile leaves no empty or partial file
+typedef struct {
+    FILE* file;
+    const char* path;               // NULL for stdout
+    char temp_path[PATH_MAX + 32];
+} OutputFile;
+
+static bool output_open(OutputFile* output, const char* path) {
+    output->path = path;
+    if (!path) {
+        output->file = stdout;
+        return true;
+    }
+    snprintf(output->temp_path, sizeof(output->temp_path), "%s.tmp.%ld", path, (long)getpid());
+    output->file = fopen(output->temp_path, "w");
+    if (!output->file) fprintf(stderr, "Error: Cannot open output file '%s'\n", path);
+    return output->file != NULL;
+}
+
+// Keep the output if ok and it was written in full; false otherwise
+static bool output_close(OutputFile* output, bool ok) {
+    if (!output->path) return ok;
+    ok = fclose(output->file) == 0 && ok;
+    if (ok && rename(output->temp_path, output->path) != 0) {
+        fprintf(stderr, "Error: Cannot write output file '%s'\n", output->path);
+        ok = false;
+    }
+    if (!ok) unlink(output->temp_path);
+    return ok;
+}
+
+// Machine code for module, written as an object or executable without
+// running the system assembler or linker
+static int generate_binary(CompilerOptions* options, IRModule* module, OutputKind kind) {
+    X86Encoder* encoder = encode_module(options, module);
+    if (!encoder) return 1;
+    
+    char* runtime_dir = kind == OUTPUT_EXECUTABLE ? runtime_library_dir(options) : NULL;
+    bool ok = kind == OUTPUT_OBJECT ? elf_write_object(encoder, options->output_file)
+                                    : elf_write_executable(encoder, options->output_file, runtime_dir);
+    if (!ok) {
+        fprintf(stderr, "Error: %s\n", encoder->error);
+    } else if (options->verbose) {
+        printf("✅ Backend complete: %s %s written to %s\n", target_arch_to_string(options->target),
+               kind == OUTPUT_OBJECT ? "object" : "executable", options->output_file);
+        if (kind == OUTPUT_EXECUTABLE) {
+            printf("   Runtime library: %s/%s\n", runtime_dir ? runtime_dir : "(loader search path)",
+                   ELF_RUNTIME_LIBRARY);
+        }
+    }
+    
+    free(runtime_dir);
+    x86_64_encoder_destroy(encoder);
+    return ok ? 0 : 1;
+}
+
+static double elapsed_us(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1e6 + (now.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+// Run mode: compile into executable memory and call main in this process.
+// The program's exit status becomes gplang's.
+int run_mode(CompilerOptions* options) {
+    if (options->target != TARGET_X86_64) {
+        fprintf(stderr, "Error: --run needs the x86_64 target\n");
+        return 1;
+    }
+    
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    IRModule* module = run_frontend(options);
+    if (!module) return 1;
+    X86Encoder* encoder = encode_module(options, module);
+    ir_module_destroy(module);
+    if (!encoder) return 1;
+    
+    JITModule* program = jit_load(encoder);
+    if (!program) {
+        fprintf(stderr, "Error: %s\n", encoder->error);
+        x86_64_encoder_destroy(encoder);
+        return 1;
+    }
+    if (options->verbose) {
+        printf("⚡ Loaded %zu bytes of code in %.0f µs\n", encoder->text.size, elapsed_us(&start));
+        fflush(stdout);
+    }
+    x86_64_encoder_destroy(encoder);
+    
+    int status = jit_run_main(program);
+    jit_destroy(program);
+    return status;
+}
+
+// LLVM mode: typed LLVM IR straight from the checked AST, for opt and llc
+int llvm_mode(CompilerOptions* options) {
+    if (options->instrument || options->profile_use) {
+        fprintf(stderr, "Error: --instrument and --profile-use need the gplang IR pipeline, not --emit-llvm\n");
+        return 1;
+    }
+    if (options->verbose) {
+        printf("🐉 LLVM: %s → LLVM IR\n", options->input_file);
+    }
+    
+    char* source = read_file(options->input_file);
+    if (!source) return 1;
+    
+    SourceUnit unit;
+    if (!parse_source(options, source, &unit)) {
+        source_unit_release(&unit);
+        free(source);
+        return 1;
+    }
+    
+    OutputFile output;
+    if (!output_open(&output, options->output_file)) {
+        source_unit_release(&unit);
+        free(source);
+        return 1;
+    }
+    
+    char* name = module_name_for(options->input_file);
+    LLVMCodegen* codegen = llvm_codegen_create(output.file);
+    bool ok = codegen && llvm_codegen_generate(codegen, unit.ast, name);
+    if (!ok) {
+        fprintf(stderr, "Error: %s\n", codegen && llvm_codegen_error(codegen)
+                ? llvm_codegen_error(codegen) : "LLVM IR generation failed");
+    } else if (options->verbose) {
+        printf("✅ LLVM IR generated%s%s\n", options->output_file ? ": " : "",
+               options->output_file ? options->output_file : "");
+    }
+    
+    llvm_codegen_destroy(codegen);
+    free(name);
+    ok = output_close(&output, ok);
+    source_unit_release(&unit);
+    free(source);
+    return ok ? 0 : 1;
+}
+
+// Assembly for module, to the output file or stdout; objects and
+// executables go through generate_binary
+static int generate_assembly(CompilerOptions* options, IRModule* module) {
+    OutputKind kind = output_kind(options);
+    if (kind != OUTPUT_ASSEMBLY) return generate_binary(options, module, kind);
+    
+    OutputFile output;
+    if (!output_open(&output, options->output_file)) return 1;
+    
+    CodeGenerator* codegen = codegen_create(options->target, output.file);
+    if (codegen) codegen->pool = codegen_pool(options, module);
+    bool ok = codegen && codegen_generate_module(codegen, module);
+    if (!ok) {
+        fprintf(stderr, "Error: %s\n", codegen && codegen->error_message
+                ? codegen->error_message : "Code generation failed");
+    } else if (options->verbose) {
+        printf("🪛 Peephole: %d rewrites\n", codegen->peephole_rewrites);
+        printf("✅ Backend complete: %s assembly generated\n", target_arch_to_string(options->target));
+    }
+    
+    if (codegen) thread_pool_destroy(codegen->pool);
+    codegen_destroy(codegen);
+    return output_close(&output, ok) ? 0 : 1;
+}
+
 // Backend mode
 int backend_mode(CompilerOptions* options) {
     if (options->verbose) {
         printf("⚙️  Backend: IR → %s Assembly\n", target_arch_to_string(options->target));
     }
     
-    // TODO: Implement IR loading and code generation
-    // For now, generate placeholder assembly
+    // Binary IR from --frontend or the compilation cache
+    if (ir_file_is_binary(options->input_file)) {
+        IRModule* module = ir_module_load(options->input_file);
+        if (!module) {
+            fprintf(stderr, "Error: '%s' is not a valid IR file for this compiler version\n",
+                    options->input_file);
+            return 1;
+        }
+        
+        int result = generate_assembly(options, module);
+        ir_module_destroy(module);
+        return result;
+    }
+    
+    // TODO: Parse textual IR; for now, generate placeholder assembly
     
     FILE* output = options->output_file ? fopen(options->output_file, "w") : stdout;
     
@@ -351,6 +954,9 @@ int main(int argc, char* argv[]) {
         printf("Mode: ");
         switch (options.mode) {
             case MODE_TOKENIZE_ONLY: printf("Tokenize\n"); break;
+            case MODE_CHECK: printf("Check (%d files)\n", options.input_count); break;
+            case MODE_RUN: printf("Run\n"); break;
+            case MODE_EMIT_LLVM: printf("LLVM IR\n"); break;
             case MODE_FRONTEND_ONLY: printf("Frontend\n"); break;
             case MODE_BACKEND_ONLY: printf("Backend\n"); break;
             case MODE_FULL_COMPILE: printf("Full Compile\n"); break;
@@ -365,6 +971,15 @@ int main(int argc, char* argv[]) {
         case MODE_TOKENIZE_ONLY:
             result = tokenize_mode(&options);
             break;
+        case MODE_CHECK:
+            result = check_mode(&options);
+            break;
+        case MODE_RUN:
+            result = run_mode(&options);
+            break;
+        case MODE_EMIT_LLVM:
+            result = llvm_mode(&options);
+            break;
         case MODE_FRONTEND_ONLY:
             result = frontend_mode(&options);
             break;
@@ -373,10 +988,10 @@ int main(int argc, char* argv[]) {
             break;
         case MODE_FULL_COMPILE:
             // Full compilation: frontend then backend
-            result = frontend_mode(&options);
-            if (result == 0) {
-                // TODO: Chain frontend output to backend input
-                result = backend_mode(&options);
+            {
+                IRModule* module = run_frontend(&options);
+                result = module ? generate_assembly(&options, module) : 1;
+                ir_module_destroy(module);
             }
             break;
         default:
@@ -388,6 +1003,8 @@ int main(int argc, char* argv[]) {
     // Cleanup
     free(options.input_file);
     free(options.output_file);
+    free(options.profile_use);
+    free(options.runtime_path);
     
     if (options.verbose) {
         if (result == 0) {
@@ -0,0 +1,203 @@
+/*
+ * GPLANG parallel loop runtime
+ * A work-stealing scheduler for `parallel for`, on plain pthreads (no
+ * OpenMP runtime needed).
+ *
+ * Each worker owns a contiguous range of iterations. It takes chunks from
+ * the front of its own range, and the chunks get smaller as the range
+ * runs down. A worker whose range is empty steals the back half of the
+ * largest range it can find, so the load stays balanced when iterations
+ * take uneven time. The calling thread works too, and returns once every
+ * iteration has run.
+ *
+ * Workers start on first use and then wait for the next loop. A parallel
+ * loop inside another one runs serially on the thread that reaches it.
+ */
+
+#define _GNU_SOURCE
+#include "gp_runtime.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define GP_MAX_WORKERS 256
+#define GP_CHUNKS_PER_WORKER 64     // Smallest chunk: iterations / (workers * this)
+
+// One worker's remaining iterations, [next, end), on its own cache line
+typedef struct {
+    pthread_mutex_t lock;
+    int64_t next;
+    int64_t end;
+} __attribute__((aligned(64))) gp_range;
+
+static struct {
+    pthread_once_t once;
+    int worker_count;               // Including the calling thread
+    gp_range ranges[GP_MAX_WORKERS];
+
+    pthread_mutex_t lock;           // Protects generation and active
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned generation;            // Bumped for every loop handed to the workers
+    int active;                     // Workers still running the current loop
+
+    pthread_mutex_t loop_lock;      // One parallel loop at a time; held while these are set
+    gp_rt_loop_body body;
+    void* env;
+    int64_t grain;
+} pool = {
+    .once = PTHREAD_ONCE_INIT,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .loop_lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+static __thread bool in_parallel_loop;
+
+// Next chunk of worker's own range; false when it is empty
+static bool take_chunk(int worker, int64_t* first, int64_t* last) {
+    gp_range* range = &pool.ranges[worker];
+    pthread_mutex_lock(&range->lock);
+    int64_t remaining = range->end - range->next;
+    bool found = remaining > 0;
+    if (found) {
+        int64_t size = remaining / 4;
+        if (size < pool.grain) size = pool.grain;
+        if (size > remaining) size = remaining;
+        *first = range->next;
+        *last = range->next + size;
+        range->next += size;
+    }
+    pthread_mutex_unlock(&range->lock);
+    return found;
+}
+
+// Move the back half of the fullest other range into worker's own
+static bool steal(int worker) {
+    for (;;) {
+        int victim = -1;
+        int64_t most = 0;
+        for (int i = 0; i < pool.worker_count; i++) {
+            int64_t remaining = pool.ranges[i].end - pool.ranges[i].next;   // A hint; checked under the lock
+            if (i != worker && remaining > most) {
+                most = remaining;
+                victim = i;
+            }
+        }
+        if (victim < 0) return false;
+
+        gp_range* from = &pool.ranges[victim];
+        pthread_mutex_lock(&from->lock);
+        int64_t remaining = from->end - from->next;
+        int64_t half = remaining > pool.grain ? remaining / 2 : remaining;
+        int64_t first = from->end - half;
+        from->end = first;
+        pthread_mutex_unlock(&from->lock);
+        if (half <= 0) continue;
+
+        gp_range* own = &pool.ranges[worker];
+        pthread_mutex_lock(&own->lock);
+        own->next = first;
+        own->end = first + half;
+        pthread_mutex_unlock(&own->lock);
+        return true;
+    }
+}
+
+static void run_worker(int worker) {
+    int64_t first, last;
+    do {
+        while (take_chunk(worker, &first, &last)) {
+            pool.body(pool.env, first, last);
+        }
+    } while (steal(worker));
+}
+
+static void* worker_main(void* argument) {
+    int worker = (int)(intptr_t)argument;
+    unsigned seen = 0;
+    in_parallel_loop = true;
+
+    for (;;) {
+        pthread_mutex_lock(&pool.lock);
+        while (pool.generation == seen) pthread_cond_wait(&pool.start, &pool.lock);
+        seen = pool.generation;
+        pthread_mutex_unlock(&pool.lock);
+
+        run_worker(worker);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.active == 0) pthread_cond_signal(&pool.done);
+        pthread_mutex_unlock(&pool.lock);
+    }
+    return NULL;
+}
+
+static void start_workers(void) {
+    const char* setting = getenv("GPLANG_THREADS");
+    long count = setting && *setting ? strtol(setting, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1) count = 1;
+    if (count > GP_MAX_WORKERS) count = GP_MAX_WORKERS;
+
+    pool.worker_count = 1;
+    pthread_mutex_init(&pool.ranges[0].lock, NULL);
+    for (int i = 1; i < count; i++) {
+        pthread_t thread;
+        pthread_mutex_init(&pool.ranges[i].lock, NULL);
+        if (pthread_create(&thread, NULL, worker_main, (void*)(intptr_t)i) != 0) break;
+        pthread_detach(thread);
+        pool.worker_count++;
+    }
+}
+
+static int64_t iteration_count(int64_t start, int64_t end, int64_t step) {
+    if (step > 0 && end > start) return (end - start - 1) / step + 1;
+    if (step < 0 && end < start) return (start - end - 1) / -step + 1;
+    return 0;
+}
+
+void gp_rt_parallel_for(int64_t start, int64_t end, int64_t step, gp_rt_loop_body body, void* env) {
+    int64_t count = iteration_count(start, end, step);
+    if (count == 0) return;
+    if (in_parallel_loop) {
+        body(env, 0, count);
+        return;
+    }
+
+    pthread_once(&pool.once, start_workers);
+    int workers = pool.worker_count;
+    if (workers == 1 || count < 2 * workers) {
+        body(env, 0, count);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.loop_lock);
+    pool.body = body;
+    pool.env = env;
+    pool.grain = count / ((int64_t)workers * GP_CHUNKS_PER_WORKER);
+    if (pool.grain < 1) pool.grain = 1;
+    int64_t share = count / workers, extra = count % workers, next = 0;
+    for (int i = 0; i < workers; i++) {
+        pool.ranges[i].next = next;
+        next += share + (i < extra ? 1 : 0);
+        pool.ranges[i].end = next;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.active = workers;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+
+    in_parallel_loop = true;
+    run_worker(0);
+    in_parallel_loop = false;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.active--;
+    while (pool.active > 0) pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+    pthread_mutex_unlock(&pool.loop_lock);
+}
@@ -0,0 +1,33 @@
+/*
+ * GPLANG profile runtime
+ * Writes the block counts of a program built with --instrument, for
+ * gplang --profile-use. The program calls these once, as main returns.
+ */
+
+#include "gp_runtime.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static FILE* profile;
+
+void gp_rt_profile_open(const char* path) {
+    const char* setting = getenv("GPLANG_PROFILE");
+    if (setting && *setting) path = setting;
+
+    profile = fopen(path, "w");
+    if (!profile) {
+        fprintf(stderr, "gplang: cannot write profile '%s'\n", path);
+        return;
+    }
+    fprintf(profile, "# GPLANG block profile: function block count\n");
+}
+
+void gp_rt_profile_count(const char* function, const char* block, int64_t count) {
+    if (profile) fprintf(profile, "%s %s %" PRId64 "\n", function, block, count);
+}
+
+void gp_rt_profile_close(void) {
+    if (profile) fclose(profile);
+    profile = NULL;
+}
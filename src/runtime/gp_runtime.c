@@ -0,0 +1,141 @@
+#define _POSIX_C_SOURCE 199309L
+#include "gp_runtime.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Heap copy of a formatted number; the runtime never frees strings
+static const char* copy_string(const char* text) {
+    size_t length = strlen(text);
+    char* copy = malloc(length + 1);
+    if (!copy) {
+        fputs("gplang: out of memory\n", stderr);
+        exit(1);
+    }
+    memcpy(copy, text, length + 1);
+    return copy;
+}
+
+static double bits_to_double(int64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Text of a value of any kind
+static const char* value_to_string(int64_t value, int64_t kind) {
+    switch (kind) {
+        case GP_KIND_FLOAT: return gp_rt_str_float(bits_to_double(value));
+        case GP_KIND_STRING: return value ? (const char*)(intptr_t)value : "";
+        default: return gp_rt_str_int(value);
+    }
+}
+
+// Print functions
+int64_t gp_rt_print_int(int64_t value) {
+    printf("%lld\n", (long long)value);
+    return 0;
+}
+
+int64_t gp_rt_print_float(double value) {
+    puts(gp_rt_str_float(value));
+    return 0;
+}
+
+int64_t gp_rt_print_string(const char* value) {
+    puts(value ? value : "");
+    return 0;
+}
+
+// Conversion functions
+const char* gp_rt_str_int(int64_t value) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%lld", (long long)value);
+    return copy_string(buffer);
+}
+
+// Shortest text that reads back as the same double, always with a decimal point
+const char* gp_rt_str_float(double value) {
+    char buffer[40];
+    for (int precision = 1; precision <= 17; precision++) {
+        snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (strtod(buffer, NULL) == value) break;
+    }
+    if (!strpbrk(buffer, ".eEni")) strcat(buffer, ".0");
+    return copy_string(buffer);
+}
+
+int64_t gp_rt_int_from_float(double value) {
+    return (int64_t)value;
+}
+
+int64_t gp_rt_int_from_string(const char* value) {
+    return value ? strtoll(value, NULL, 10) : 0;
+}
+
+double gp_rt_float_from_int(int64_t value) {
+    return (double)value;
+}
+
+double gp_rt_float_from_string(const char* value) {
+    return value ? strtod(value, NULL) : 0.0;
+}
+
+// String functions
+int64_t gp_rt_string_length(const char* value) {
+    return value ? (int64_t)strlen(value) : 0;
+}
+
+const char* gp_rt_string_concat(const char* left, const char* right) {
+    size_t left_length = left ? strlen(left) : 0;
+    size_t right_length = right ? strlen(right) : 0;
+    char* result = malloc(left_length + right_length + 1);
+    if (!result) {
+        fputs("gplang: out of memory\n", stderr);
+        exit(1);
+    }
+    if (left_length) memcpy(result, left, left_length);
+    if (right_length) memcpy(result + left_length, right, right_length);
+    result[left_length + right_length] = '\0';
+    return result;
+}
+
+// Value functions
+const char* gp_rt_concat_values(int64_t left, int64_t left_kind, int64_t right, int64_t right_kind) {
+    return gp_rt_string_concat(value_to_string(left, left_kind), value_to_string(right, right_kind));
+}
+
+// <0, 0 or >0; strings compare by text, numbers by value
+int64_t gp_rt_compare_values(int64_t left, int64_t left_kind, int64_t right, int64_t right_kind) {
+    if (left_kind == GP_KIND_STRING || right_kind == GP_KIND_STRING) {
+        return strcmp(value_to_string(left, left_kind), value_to_string(right, right_kind));
+    }
+    if (left_kind == GP_KIND_FLOAT || right_kind == GP_KIND_FLOAT) {
+        double a = left_kind == GP_KIND_FLOAT ? bits_to_double(left) : (double)left;
+        double b = right_kind == GP_KIND_FLOAT ? bits_to_double(right) : (double)right;
+        return (a > b) - (a < b);
+    }
+    return (left > right) - (left < right);
+}
+
+// Time functions
+int64_t gp_rt_time_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+double gp_rt_time_seconds(int64_t nanoseconds) {
+    return (double)nanoseconds / 1e9;
+}
+
+double gp_rt_time_milliseconds(int64_t nanoseconds) {
+    return (double)nanoseconds / 1e6;
+}
+
+// Arithmetic functions
+double gp_rt_float_mod(double left, double right) {
+    return fmod(left, right);
+}
@@ -0,0 +1,57 @@
+#ifndef GPLANG_RUNTIME_H
+#define GPLANG_RUNTIME_H
+
+// GPLANG Runtime
+// Support functions called by compiled programs (libgplang_rt.a). The
+// backend picks the variant matching each argument's kind, so every
+// function here takes plain C integers, doubles or strings.
+
+#include <stdint.h>
+
+// Value kinds, numbered as the backend's ValueKind
+#define GP_KIND_INT 0
+#define GP_KIND_FLOAT 1
+#define GP_KIND_STRING 2
+
+// print
+int64_t gp_rt_print_int(int64_t value);
+int64_t gp_rt_print_float(double value);
+int64_t gp_rt_print_string(const char* value);
+
+// Conversions: str(), int(), float()
+const char* gp_rt_str_int(int64_t value);
+const char* gp_rt_str_float(double value);
+int64_t gp_rt_int_from_float(double value);
+int64_t gp_rt_int_from_string(const char* value);
+double gp_rt_float_from_int(int64_t value);
+double gp_rt_float_from_string(const char* value);
+
+// Strings. Results are heap-allocated and live for the whole run.
+int64_t gp_rt_string_length(const char* value);
+const char* gp_rt_string_concat(const char* left, const char* right);
+
+// Operations on values of any kind, passed as raw 64-bit patterns plus GP_KIND_*
+const char* gp_rt_concat_values(int64_t left, int64_t left_kind, int64_t right, int64_t right_kind);
+int64_t gp_rt_compare_values(int64_t left, int64_t left_kind, int64_t right, int64_t right_kind);
+
+// Time: Time.now() is a monotonic timestamp in nanoseconds
+int64_t gp_rt_time_now(void);
+double gp_rt_time_seconds(int64_t nanoseconds);
+double gp_rt_time_milliseconds(int64_t nanoseconds);
+
+// Arithmetic
+double gp_rt_float_mod(double left, double right);
+
+// parallel for (gp_parallel.c). body runs iterations [first, last) of the
+// loop; iteration k has loop variable start + k * step. Worker threads:
+// $GPLANG_THREADS, else one per CPU.
+typedef void (*gp_rt_loop_body)(void* env, int64_t first, int64_t last);
+void gp_rt_parallel_for(int64_t start, int64_t end, int64_t step, gp_rt_loop_body body, void* env);
+
+// Block profiles from --instrument (gp_profile.c): written when main
+// returns, to path or $GPLANG_PROFILE, one "function block count" line each
+void gp_rt_profile_open(const char* path);
+void gp_rt_profile_count(const char* function, const char* block, int64_t count);
+void gp_rt_profile_close(void);
+
+#endif // GPLANG_RUNTIME_H
@@ -0,0 +1,146 @@
+/*
+ * GPLANG Flat IR Benchmark
+ * Compares a full-function walk over the linked IR with the flat IR
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/ir/ir.h"
+#include "../src/ir/ir_flat.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// A long chain of blocks, each doing a little arithmetic through a local
+static IRFunction* build_function(IRModule* module, int block_count) {
+    IRBuilder* builder = ir_builder_create(module);
+    IRFunction* function = ir_function_create("bench");
+    ir_module_add_function(module, function);
+    ir_builder_set_function(builder, function);
+
+    IRBasicBlock* entry = ir_builder_create_block(builder, "entry");
+    ir_builder_set_block(builder, entry);
+    IRValue* slot = ir_builder_alloca(builder, "acc");
+    ir_builder_store(builder, ir_builder_const_int(builder, 0), slot);
+
+    for (int b = 0; b < block_count; b++) {
+        IRBasicBlock* next = ir_builder_create_block(builder, "body");
+        IRBasicBlock* skip = ir_builder_create_block(builder, "skip");
+        IRValue* acc = ir_builder_load(builder, slot);
+        IRValue* sum = ir_builder_add(builder, acc, ir_builder_const_int(builder, b));
+        IRValue* scaled = ir_builder_mul(builder, sum, ir_builder_const_int(builder, 3));
+        ir_builder_store(builder, scaled, slot);
+        IRValue* cond = ir_builder_binary(builder, IR_LT, scaled, ir_builder_const_int(builder, 1000000));
+        ir_builder_branch(builder, cond, next, skip);
+        ir_builder_set_block(builder, skip);
+        ir_builder_jump(builder, next);
+        ir_builder_set_block(builder, next);
+    }
+    ir_builder_return(builder, ir_builder_load(builder, slot));
+    ir_builder_destroy(builder);
+    return function;
+}
+
+// Count register operands, the typical inner loop of a dataflow pass
+static long walk_linked(const IRFunction* function) {
+    long uses = 0;
+    for (IRBasicBlock* block = function->blocks; block; block = block->next) {
+        for (IRInstruction* inst = block->instructions; inst; inst = inst->next) {
+            IRValue* srcs[3] = {inst->src1, inst->src2, inst->src3};
+            for (int i = 0; i < 3; i++) {
+                if (srcs[i] && srcs[i]->type == IR_VALUE_REGISTER) uses++;
+            }
+        }
+    }
+    return uses;
+}
+
+static long walk_flat(const IRFlatFunction* flat) {
+    long uses = 0;
+    for (uint32_t i = 0; i < flat->inst_count; i++) {
+        const IRFlatInst* inst = &flat->insts[i];
+        for (int s = 0; s < 3; s++) {
+            if (ir_flat_kind(inst->src[s]) == IR_FLAT_REG) uses++;
+        }
+    }
+    return uses;
+}
+
+static char* print_to_string(const IRFunction* function, const IRFlatFunction* flat) {
+    char* text = NULL;
+    size_t size = 0;
+    FILE* stream = open_memstream(&text, &size);
+    if (function) {
+        IRModule* module = ir_module_create("roundtrip");
+        ir_module_add_function(module, (IRFunction*)function);
+        ir_module_print(module, stream);
+        module->functions = NULL;
+        ir_module_destroy(module);
+    } else {
+        ir_flat_print(flat, stream);
+    }
+    fclose(stream);
+    return text;
+}
+
+int main(int argc, char* argv[]) {
+    int block_count = argc > 1 ? atoi(argv[1]) : 20000;
+    int iterations = argc > 2 ? atoi(argv[2]) : 50;
+
+    printf("⚡ GPLANG Flat IR Benchmark\n");
+    printf("==========================\n");
+
+    IRModule* module = ir_module_create("bench");
+    IRFunction* function = build_function(module, block_count);
+
+    double start = now_seconds();
+    IRFlatFunction* flat = ir_flat_from_function(function);
+    double flatten_time = now_seconds() - start;
+    if (!flat) {
+        printf("❌ Flattening failed\n");
+        return 1;
+    }
+
+    // Converting back must reproduce the same IR text
+    IRFunction* rebuilt = ir_flat_to_function(flat);
+    char* original_text = print_to_string(function, NULL);
+    char* rebuilt_text = print_to_string(rebuilt, NULL);
+    char* flat_text = print_to_string(NULL, flat);
+    if (!rebuilt || strcmp(original_text, rebuilt_text) != 0 ||
+        strstr(original_text, flat_text) == NULL) {
+        printf("❌ Round trip changed the IR\n");
+        return 1;
+    }
+    printf("✅ Round trip preserved %u instructions in %u blocks\n",
+           flat->inst_count, flat->block_count);
+    free(original_text);
+    free(rebuilt_text);
+    free(flat_text);
+    ir_function_destroy(rebuilt);
+
+    volatile long sink = 0;
+
+    start = now_seconds();
+    for (int n = 0; n < iterations; n++) sink += walk_linked(function);
+    double linked_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int n = 0; n < iterations; n++) sink += walk_flat(flat);
+    double flat_time = now_seconds() - start;
+
+    double per_inst = 1e9 / ((double)flat->inst_count * iterations);
+    printf("   • Flatten:     %8.2f ms\n", flatten_time * 1000);
+    printf("   • Linked walk: %8.2f ns/inst\n", linked_time * per_inst);
+    printf("   • Flat walk:   %8.2f ns/inst\n", flat_time * per_inst);
+    printf("   • Speedup: %.1fx\n", flat_time > 0 ? linked_time / flat_time : 0.0);
+
+    (void)sink;
+    ir_flat_destroy(flat);
+    ir_module_destroy(module);
+    return 0;
+}
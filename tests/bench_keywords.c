@@ -0,0 +1,115 @@
+/*
+ * GPLANG Keyword Recognition Benchmark
+ * Compares lexer_classify_keyword against the original linear table walk
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/frontend/lexer.h"
+
+// Reference implementation: the linear strcmp walk the lexer used to do
+typedef struct {
+    const char* keyword;
+    TokenType type;
+} KeywordMapping;
+
+static KeywordMapping keywords[] = {
+    {"func", TOKEN_FUNC}, {"fun", TOKEN_FUN}, {"fu", TOKEN_FU},
+    {"var", TOKEN_VAR}, {"if", TOKEN_IF}, {"elif", TOKEN_ELIF}, {"else", TOKEN_ELSE},
+    {"while", TOKEN_WHILE}, {"for", TOKEN_FOR}, {"in", TOKEN_IN}, {"return", TOKEN_RETURN},
+    {"and", TOKEN_AND}, {"or", TOKEN_OR}, {"not", TOKEN_NOT},
+    {"true", TOKEN_TRUE}, {"false", TOKEN_FALSE}, {"import", TOKEN_IMPORT},
+    {"unsafe", TOKEN_UNSAFE}, {"async", TOKEN_ASYNC}, {"await", TOKEN_AWAIT}, {"spawn", TOKEN_SPAWN},
+    {"match", TOKEN_MATCH}, {"Some", TOKEN_SOME}, {"None", TOKEN_NONE},
+    {"Ok", TOKEN_OK}, {"Err", TOKEN_ERR}, {"Option", TOKEN_OPTION}, {"Result", TOKEN_RESULT},
+    {"test", TOKEN_TEST}, {"bench", TOKEN_BENCH},
+    {"int", TOKEN_INT}, {"float", TOKEN_FLOAT}, {"str", TOKEN_STR}, {"string", TOKEN_STRING_TYPE},
+    {"bool", TOKEN_BOOL}, {"list", TOKEN_LIST}, {"dict", TOKEN_DICT}, {"set", TOKEN_SET}, {"tuple", TOKEN_TUPLE},
+    {"Future", TOKEN_FUTURE}, {"Channel", TOKEN_CHANNEL}, {"Task", TOKEN_TASK},
+    {"Vec2", TOKEN_VEC2}, {"Vec3", TOKEN_VEC3}, {"Vec4", TOKEN_VEC4}, {"Matrix4", TOKEN_MATRIX4},
+    {"Color", TOKEN_COLOR}, {"Time", TOKEN_TIME}, {"Ref", TOKEN_REF}, {"Mut", TOKEN_MUT},
+    {"os", TOKEN_OS}, {"sys", TOKEN_SYS}, {"env", TOKEN_ENV}, {"process", TOKEN_PROCESS}, {"std", TOKEN_STD},
+    {NULL, 0}
+};
+
+// The table walk needs a NUL-terminated copy, just like the old read_identifier
+static TokenType table_walk_classify(const char* text, int length) {
+    char buffer[64];
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+
+    for (int i = 0; keywords[i].keyword != NULL; i++) {
+        if (strcmp(buffer, keywords[i].keyword) == 0) {
+            return keywords[i].type;
+        }
+    }
+    return TOKEN_IDENTIFIER;
+}
+
+// Identifiers typical of generated sources, mixed with keywords
+static const char* corpus[] = {
+    "func", "main", "var", "count", "i", "for", "in", "range", "if", "result",
+    "return", "print", "start_time", "Time", "now", "end_time", "elapsed", "else",
+    "matrix", "data", "rows", "cols", "while", "temp", "fibonacci", "n", "true",
+    "false", "import", "std", "value", "index", "Vec3", "position", "velocity",
+    "parallel", "chunk", "and", "or", "not", "buffer", "length", "string", "Option"
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? atol(argv[1]) : 2000000;
+    size_t corpus_size = sizeof(corpus) / sizeof(corpus[0]);
+    int lengths[sizeof(corpus) / sizeof(corpus[0])];
+
+    printf("⚡ GPLANG Keyword Recognition Benchmark\n");
+    printf("======================================\n");
+
+    // Both classifiers must agree on every keyword and every corpus entry
+    for (int i = 0; keywords[i].keyword != NULL; i++) {
+        int length = strlen(keywords[i].keyword);
+        if (lexer_classify_keyword(keywords[i].keyword, length) != keywords[i].type) {
+            printf("❌ Mismatch for keyword '%s'\n", keywords[i].keyword);
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < corpus_size; i++) {
+        lengths[i] = strlen(corpus[i]);
+        if (lexer_classify_keyword(corpus[i], lengths[i]) !=
+            table_walk_classify(corpus[i], lengths[i])) {
+            printf("❌ Mismatch for identifier '%s'\n", corpus[i]);
+            return 1;
+        }
+    }
+    printf("✅ Classifiers agree on %zu identifiers\n", corpus_size);
+
+    volatile unsigned long sink = 0;
+
+    double start = now_seconds();
+    for (long n = 0; n < iterations; n++) {
+        size_t i = n % corpus_size;
+        sink += table_walk_classify(corpus[i], lengths[i]);
+    }
+    double table_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (long n = 0; n < iterations; n++) {
+        size_t i = n % corpus_size;
+        sink += lexer_classify_keyword(corpus[i], lengths[i]);
+    }
+    double switch_time = now_seconds() - start;
+
+    printf("   • Lookups: %ld\n", iterations);
+    printf("   • Table walk:       %8.2f ns/lookup\n", table_time * 1e9 / iterations);
+    printf("   • Length+char switch: %6.2f ns/lookup\n", switch_time * 1e9 / iterations);
+    printf("   • Speedup: %.1fx\n", switch_time > 0 ? table_time / switch_time : 0.0);
+
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,44 @@
+# GPLANG: Short-Circuit - and/or skip their right operand when the left decides
+# Demonstrates: conditions with calls on the right, and/or as values,
+# while conditions, and a guard against dividing by zero
+
+var calls = 0
+
+func touch(result: i64) -> i64:
+    calls = calls + 1
+    return result
+
+func safe_ratio(x: i64, y: i64) -> i64:
+    if x != 0 and y / x > 1:
+        return 1
+    return 0
+
+func main():
+    print("🔀 GPLANG Short-Circuit")
+
+    var hits = 0
+    for i in range(0, 6):
+        if i > 2 and touch(1) == 1:
+            hits = hits + 1
+    print("if calls: " + str(calls) + ", hits: " + str(hits))
+
+    calls = 0
+    var flag = 1 or touch(0)
+    var other = 0 and touch(1)
+    var both = 0 or touch(1)
+    print("value calls: " + str(calls))
+    var small = hits < 5 and calls < 5
+    var large = hits > 5 or calls > 5
+    print("hits < 5 and calls < 5: " + str(small) + ", hits > 5 or calls > 5: " + str(large))
+    print("1 or _: " + str(flag) + ", 0 and _: " + str(other) + ", 0 or 1: " + str(both))
+
+    calls = 0
+    var loops = 0
+    while loops < 10 and touch(1) == 1:
+        loops = loops + 1
+    print("while calls: " + str(calls))
+
+    print("safe_ratio(0, 10): " + str(safe_ratio(0, 10)))
+    print("safe_ratio(2, 10): " + str(safe_ratio(2, 10)))
+    print("not (0 or 0): " + str(not (0 or touch(0))))
+    return 0
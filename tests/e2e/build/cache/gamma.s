@@ -0,0 +1,414 @@
+# GPLANG Generated Assembly
+# Module: gamma
+# Source: build/cache/gamma.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+touch:
+    # 4 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Ltouch.entry:
+    movq %rcx, -8(%rbp)
+    movq gp_global_calls(%rip), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, gp_global_calls(%rip)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+safe_ratio:
+    # 8 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lsafe_ratio.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq -8(%rbp), %rcx
+    testq %rcx, %rcx
+    jne .Lsafe_ratio.and.rhs2
+    jmp .Lsafe_ratio.if.end1
+.Lsafe_ratio.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lsafe_ratio.if.end1:
+    xorl %eax, %eax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lsafe_ratio.and.rhs2:
+    movq -16(%rbp), %rcx
+    movq -8(%rbp), %rsi
+    movq %rcx, %rax
+    cqto 
+    idivq %rsi
+    movq %rax, %rdi
+    cmpq $1, %rdi
+    jg .Lsafe_ratio.if.then0
+    jmp .Lsafe_ratio.if.end1
+
+main:
+    # 96 values in registers, 0 spilled, 112-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $112, %rsp
+    movq %rbx, -104(%rbp)
+    # Function prologue
+    call __init
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -8(%rbp)
+    movq $0, -16(%rbp)
+.Lmain.for.cond0:
+    movq -16(%rbp), %rcx
+    cmpq $6, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -16(%rbp), %rcx
+    cmpq $2, %rcx
+    jg .Lmain.and.rhs6
+    jmp .Lmain.if.end5
+.Lmain.for.step2:
+    movq -16(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC2(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, gp_global_calls(%rip)
+    jmp .Lmain.logic.true7
+.Lmain.if.then4:
+    movq -8(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -8(%rbp)
+.Lmain.if.end5:
+    jmp .Lmain.for.step2
+.Lmain.and.rhs6:
+    movq $1, %rdi
+    call touch
+    movq %rax, %rcx
+    cmpq $1, %rcx
+    je .Lmain.if.then4
+    jmp .Lmain.if.end5
+.Lmain.logic.true7:
+    movq $1, -24(%rbp)
+    jmp .Lmain.logic.end9
+.Lmain.logic.false8:
+    movq $0, -24(%rbp)
+.Lmain.logic.end9:
+    movq -24(%rbp), %rcx
+    movq %rcx, -32(%rbp)
+    jmp .Lmain.logic.false12
+.Lmain.or.rhs10:
+    xorl %edi, %edi
+    call touch
+    movq %rax, %rcx
+    testq %rcx, %rcx
+    jne .Lmain.logic.true7
+    jmp .Lmain.logic.false8
+.Lmain.logic.true11:
+    movq $1, -40(%rbp)
+    jmp .Lmain.logic.end13
+.Lmain.logic.false12:
+    movq $0, -40(%rbp)
+.Lmain.logic.end13:
+    movq -40(%rbp), %rcx
+    movq %rcx, -48(%rbp)
+    jmp .Lmain.or.rhs18
+.Lmain.and.rhs14:
+    movq $1, %rdi
+    call touch
+    movq %rax, %rcx
+    testq %rcx, %rcx
+    jne .Lmain.logic.true11
+    jmp .Lmain.logic.false12
+.Lmain.logic.true15:
+    movq $1, -56(%rbp)
+    jmp .Lmain.logic.end17
+.Lmain.logic.false16:
+    movq $0, -56(%rbp)
+.Lmain.logic.end17:
+    movq -56(%rbp), %rcx
+    movq %rcx, -64(%rbp)
+    leaq .LC3(%rip), %rbx
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq -8(%rbp), %rcx
+    cmpq $5, %rcx
+    setl %al
+    movzbl %al, %eax
+    movq %rax, %rsi
+    movq gp_global_calls(%rip), %rcx
+    cmpq $5, %rcx
+    setl %al
+    movzbl %al, %eax
+    movq %rax, %rdi
+    xorl %eax, %eax
+    xorl %r11d, %r11d
+    testq %rdi, %rdi
+    setne %al
+    testq %rsi, %rsi
+    cmoveq %r11, %rax
+    movq %rax, %rcx
+    movq %rcx, -72(%rbp)
+    movq -8(%rbp), %rcx
+    cmpq $5, %rcx
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %rsi
+    movq gp_global_calls(%rip), %rcx
+    cmpq $5, %rcx
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %rdi
+    xorl %eax, %eax
+    movl $1, %r11d
+    testq %rdi, %rdi
+    setne %al
+    testq %rsi, %rsi
+    cmovneq %r11, %rax
+    movq %rax, %rcx
+    movq %rcx, -80(%rbp)
+    leaq .LC4(%rip), %rbx
+    movq -72(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC5(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -80(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %rbx
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC7(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -48(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC8(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -64(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, gp_global_calls(%rip)
+    movq $0, -88(%rbp)
+    jmp .Lmain.while.cond19
+.Lmain.or.rhs18:
+    movq $1, %rdi
+    call touch
+    movq %rax, %rcx
+    testq %rcx, %rcx
+    jne .Lmain.logic.true15
+    jmp .Lmain.logic.false16
+.Lmain.while.cond19:
+    movq -88(%rbp), %rcx
+    cmpq $10, %rcx
+    jl .Lmain.and.rhs22
+    jmp .Lmain.while.end21
+.Lmain.while.body20:
+    movq -88(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -88(%rbp)
+    jmp .Lmain.while.cond19
+.Lmain.while.end21:
+    leaq .LC9(%rip), %rbx
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC10(%rip), %rbx
+    xorl %edi, %edi
+    movq $10, %rsi
+    call safe_ratio
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC11(%rip), %rbx
+    movq $2, %rdi
+    movq $10, %rsi
+    call safe_ratio
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC12(%rip), %rbx
+    jmp .Lmain.or.rhs26
+.Lmain.and.rhs22:
+    movq $1, %rdi
+    call touch
+    movq %rax, %rcx
+    cmpq $1, %rcx
+    je .Lmain.while.body20
+    jmp .Lmain.while.end21
+.Lmain.logic.true23:
+    movq $1, -96(%rbp)
+    jmp .Lmain.logic.end25
+.Lmain.logic.false24:
+    movq $0, -96(%rbp)
+.Lmain.logic.end25:
+    movq -96(%rbp), %rcx
+    testq %rcx, %rcx
+    sete %al
+    movzbl %al, %eax
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -104(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lmain.or.rhs26:
+    xorl %edi, %edi
+    call touch
+    movq %rax, %rcx
+    testq %rcx, %rcx
+    jne .Lmain.logic.true23
+    jmp .Lmain.logic.false24
+
+__init:
+    # 0 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+.L__init.entry:
+    movq $0, gp_global_calls(%rip)
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\200 GPLANG Short-Circuit"
+.LC1:
+    .string "if calls: "
+.LC2:
+    .string ", hits: "
+.LC3:
+    .string "value calls: "
+.LC4:
+    .string "hits < 5 and calls < 5: "
+.LC5:
+    .string ", hits > 5 or calls > 5: "
+.LC6:
+    .string "1 or _: "
+.LC7:
+    .string ", 0 and _: "
+.LC8:
+    .string ", 0 or 1: "
+.LC9:
+    .string "while calls: "
+.LC10:
+    .string "safe_ratio(0, 10): "
+.LC11:
+    .string "safe_ratio(2, 10): "
+.LC12:
+    .string "not (0 or 0): "
+
+.section .bss
+.p2align 3
+gp_global_calls:
+    .zero 8
+
+.section .note.GNU-stack,"",@progbits
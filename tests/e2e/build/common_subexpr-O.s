@@ -0,0 +1,193 @@
+# GPLANG Generated Assembly
+# Module: common_subexpr
+# Source: ../../examples/basic/common_subexpr.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+bump:
+    # 3 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lbump.entry:
+    movq gp_global_calls(%rip), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, gp_global_calls(%rip)
+    movq %rdi, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+main:
+    # 50 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    # Function prologue
+    call __init
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ecx, %ecx
+    xorl %esi, %esi
+.Lmain.for.cond0:
+    cmpq $20, %rsi
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    leaq 7(%rsi), %rdi
+    movq $5, %r8
+    subq %rsi, %r8
+    movq %rdi, %r9
+    imulq %r8, %r9
+    leaq (%r9,%rdi), %r8
+    leaq (%r9,%r8), %rdi
+    leaq (%rcx,%rdi), %r8
+    movq gp_global_total(%rip), %rdi
+    leaq (%rdi,%r9), %rbx
+    movq %rbx, gp_global_total(%rip)
+    leaq (%r8,%rbx), %rdi
+.Lmain.for.step2:
+    leaq 1(%rsi), %r8
+    movq %rdi, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+    movq gp_global_total(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq gp_global_calls(%rip), %rcx
+.Lmain.bump.0.entry:
+    leaq 3(%rcx), %rbx
+    movq %rbx, gp_global_calls(%rip)
+.Lmain.bump.0.ret:
+    leaq .LC3(%rip), %r12
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %r12, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC4(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r12
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r12, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC5(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq gp_global_calls(%rip), %rcx
+    leaq (%rcx,%rcx), %rsi
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %rbx
+    leaq .LC7(%rip), %r12
+    leaq .LC8(%rip), %rcx
+    movq %rcx, %rdi
+    movq %rbx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    movq %r12, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC9(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    movq %r12, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    movq %rbx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+__init:
+    # 0 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+.L__init.entry:
+    movq $0, gp_global_total(%rip)
+    movq $0, gp_global_calls(%rip)
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\201 GPLANG Common Subexpressions"
+.LC1:
+    .string "Sum: "
+.LC2:
+    .string "Total: "
+.LC3:
+    .string "Calls: "
+.LC4:
+    .string " -> "
+.LC5:
+    .string ", doubled "
+.LC6:
+    .string "ab"
+.LC7:
+    .string "cd"
+.LC8:
+    .string "Strings: "
+.LC9:
+    .string " "
+
+.section .bss
+.p2align 3
+gp_global_calls:
+    .zero 8
+gp_global_total:
+    .zero 8
+
+.section .note.GNU-stack,"",@progbits
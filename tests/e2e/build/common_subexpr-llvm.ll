@@ -0,0 +1,183 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'common_subexpr'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+@g.calls = internal global i64 0
+@g.total = internal global i64 0
+
+; Function: bump
+define internal i64 @gp.bump(i64 %p.step) #0 {
+entry:
+  %v.step = alloca i64
+  store i64 %p.step, i64* %v.step
+  %t0 = load i64, i64* @g.calls
+  %t1 = load i64, i64* %v.step
+  %t2 = add nsw i64 %t0, %t1
+  store i64 %t2, i64* @g.calls
+  %t3 = load i64, i64* @g.calls
+  ret i64 %t3
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.a = alloca i64
+  %v.b = alloca i64
+  %v.sum = alloca i64
+  %v.i = alloca i64
+  %v.p = alloca i64
+  %v.q = alloca i64
+  %v.before = alloca i64
+  %v.after = alloca i64
+  %v.left = alloca i8*
+  %v.right = alloca i8*
+  call void @gp.__init()
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([34 x i8], [34 x i8]* @.str.0, i64 0, i64 0))
+  store i64 7, i64* %v.a
+  store i64 5, i64* %v.b
+  store i64 0, i64* %v.sum
+  store i64 0, i64* %v.i
+  br label %for.cond.0
+
+for.cond.0:
+  %t0 = load i64, i64* %v.i
+  %t1 = icmp slt i64 %t0, 20
+  br i1 %t1, label %for.body.0, label %for.end.0
+
+for.body.0:
+  %t2 = load i64, i64* %v.a
+  %t3 = load i64, i64* %v.i
+  %t4 = add nsw i64 %t2, %t3
+  %t5 = load i64, i64* %v.b
+  %t6 = load i64, i64* %v.i
+  %t7 = sub nsw i64 %t5, %t6
+  %t8 = mul nsw i64 %t4, %t7
+  store i64 %t8, i64* %v.p
+  %t9 = load i64, i64* %v.i
+  %t10 = load i64, i64* %v.a
+  %t11 = add nsw i64 %t9, %t10
+  %t12 = load i64, i64* %v.b
+  %t13 = load i64, i64* %v.i
+  %t14 = sub nsw i64 %t12, %t13
+  %t15 = mul nsw i64 %t11, %t14
+  %t16 = load i64, i64* %v.a
+  %t17 = load i64, i64* %v.i
+  %t18 = add nsw i64 %t16, %t17
+  %t19 = add nsw i64 %t15, %t18
+  store i64 %t19, i64* %v.q
+  %t20 = load i64, i64* %v.p
+  %t21 = load i64, i64* %v.q
+  %t22 = add nsw i64 %t20, %t21
+  %t23 = load i64, i64* %v.sum
+  %t24 = add nsw i64 %t23, %t22
+  store i64 %t24, i64* %v.sum
+  %t25 = load i64, i64* @g.total
+  %t26 = load i64, i64* %v.p
+  %t27 = add nsw i64 %t25, %t26
+  store i64 %t27, i64* @g.total
+  %t28 = load i64, i64* @g.total
+  %t29 = load i64, i64* %v.sum
+  %t30 = add nsw i64 %t29, %t28
+  store i64 %t30, i64* %v.sum
+  br label %for.step.0
+
+for.step.0:
+  %t31 = load i64, i64* %v.i
+  %t32 = add nsw i64 %t31, 1
+  store i64 %t32, i64* %v.i
+  br label %for.cond.0, !llvm.loop !2
+
+for.end.0:
+  %t33 = load i64, i64* %v.sum
+  %t34 = call i8* @gp_rt_str_int(i64 %t33)
+  %t35 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str.1, i64 0, i64 0), i8* %t34)
+  call i64 @gp_rt_print_string(i8* %t35)
+  %t36 = load i64, i64* @g.total
+  %t37 = call i8* @gp_rt_str_int(i64 %t36)
+  %t38 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([8 x i8], [8 x i8]* @.str.2, i64 0, i64 0), i8* %t37)
+  call i64 @gp_rt_print_string(i8* %t38)
+  %t39 = load i64, i64* @g.calls
+  store i64 %t39, i64* %v.before
+  %t40 = call i64 @gp.bump(i64 3)
+  %t41 = load i64, i64* @g.calls
+  store i64 %t41, i64* %v.after
+  %t42 = load i64, i64* %v.before
+  %t43 = call i8* @gp_rt_str_int(i64 %t42)
+  %t44 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([8 x i8], [8 x i8]* @.str.3, i64 0, i64 0), i8* %t43)
+  %t45 = call i8* @gp_rt_string_concat(i8* %t44, i8* getelementptr inbounds ([5 x i8], [5 x i8]* @.str.4, i64 0, i64 0))
+  %t46 = load i64, i64* %v.after
+  %t47 = call i8* @gp_rt_str_int(i64 %t46)
+  %t48 = call i8* @gp_rt_string_concat(i8* %t45, i8* %t47)
+  %t49 = call i8* @gp_rt_string_concat(i8* %t48, i8* getelementptr inbounds ([11 x i8], [11 x i8]* @.str.5, i64 0, i64 0))
+  %t50 = load i64, i64* @g.calls
+  %t51 = load i64, i64* @g.calls
+  %t52 = add nsw i64 %t50, %t51
+  %t53 = call i8* @gp_rt_str_int(i64 %t52)
+  %t54 = call i8* @gp_rt_string_concat(i8* %t49, i8* %t53)
+  call i64 @gp_rt_print_string(i8* %t54)
+  store i8* getelementptr inbounds ([3 x i8], [3 x i8]* @.str.6, i64 0, i64 0), i8** %v.left
+  store i8* getelementptr inbounds ([3 x i8], [3 x i8]* @.str.7, i64 0, i64 0), i8** %v.right
+  %t55 = load i8*, i8** %v.left
+  %t56 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([10 x i8], [10 x i8]* @.str.8, i64 0, i64 0), i8* %t55)
+  %t57 = load i8*, i8** %v.right
+  %t58 = call i8* @gp_rt_string_concat(i8* %t56, i8* %t57)
+  %t59 = call i8* @gp_rt_string_concat(i8* %t58, i8* getelementptr inbounds ([2 x i8], [2 x i8]* @.str.9, i64 0, i64 0))
+  %t60 = load i8*, i8** %v.right
+  %t61 = call i8* @gp_rt_string_concat(i8* %t59, i8* %t60)
+  %t62 = load i8*, i8** %v.left
+  %t63 = call i8* @gp_rt_string_concat(i8* %t61, i8* %t62)
+  call i64 @gp_rt_print_string(i8* %t63)
+  %t64 = trunc i64 0 to i32
+  ret i32 %t64
+}
+
+; Function: __init
+define internal void @gp.__init() #0 {
+entry:
+  store i64 0, i64* @g.total
+  store i64 0, i64* @g.calls
+  ret void
+}
+
+@.str.0 = private unnamed_addr constant [34 x i8] c"\F0\9F\94\81 GPLANG Common Subexpressions\00"
+@.str.1 = private unnamed_addr constant [6 x i8] c"Sum: \00"
+@.str.2 = private unnamed_addr constant [8 x i8] c"Total: \00"
+@.str.3 = private unnamed_addr constant [8 x i8] c"Calls: \00"
+@.str.4 = private unnamed_addr constant [5 x i8] c" -> \00"
+@.str.5 = private unnamed_addr constant [11 x i8] c", doubled \00"
+@.str.6 = private unnamed_addr constant [3 x i8] c"ab\00"
+@.str.7 = private unnamed_addr constant [3 x i8] c"cd\00"
+@.str.8 = private unnamed_addr constant [10 x i8] c"Strings: \00"
+@.str.9 = private unnamed_addr constant [2 x i8] c" \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0}
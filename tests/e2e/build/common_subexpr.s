@@ -0,0 +1,231 @@
+# GPLANG Generated Assembly
+# Module: common_subexpr
+# Source: ../../examples/basic/common_subexpr.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+bump:
+    # 5 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lbump.entry:
+    movq %rcx, -8(%rbp)
+    movq gp_global_calls(%rip), %rcx
+    movq -8(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, gp_global_calls(%rip)
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 79 values in registers, 0 spilled, 96-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $96, %rsp
+    movq %rbx, -88(%rbp)
+    # Function prologue
+    call __init
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $7, -8(%rbp)
+    movq $5, -16(%rbp)
+    movq $0, -24(%rbp)
+    movq $0, -32(%rbp)
+.Lmain.for.cond0:
+    movq -32(%rbp), %rcx
+    cmpq $20, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -8(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq -16(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    movq %rcx, %r8
+    subq %rsi, %r8
+    movq %rdi, %rcx
+    imulq %r8, %rcx
+    movq %rcx, -40(%rbp)
+    movq -32(%rbp), %rcx
+    movq -8(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq -16(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    movq %rcx, %r8
+    subq %rsi, %r8
+    movq %rdi, %rcx
+    imulq %r8, %rcx
+    movq -8(%rbp), %rsi
+    movq -32(%rbp), %rdi
+    leaq (%rsi,%rdi), %r8
+    leaq (%rcx,%r8), %rsi
+    movq %rsi, -48(%rbp)
+    movq -40(%rbp), %rcx
+    movq -48(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq -24(%rbp), %rcx
+    leaq (%rcx,%rdi), %rsi
+    movq %rsi, -24(%rbp)
+    movq gp_global_total(%rip), %rcx
+    movq -40(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, gp_global_total(%rip)
+    movq gp_global_total(%rip), %rcx
+    movq -24(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -24(%rbp)
+.Lmain.for.step2:
+    movq -32(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -32(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq -24(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+    movq gp_global_total(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, -56(%rbp)
+    movq $3, %rdi
+    call bump
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, -64(%rbp)
+    leaq .LC3(%rip), %rbx
+    movq -56(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC4(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -64(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC5(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq gp_global_calls(%rip), %rcx
+    movq gp_global_calls(%rip), %rsi
+    leaq (%rcx,%rsi), %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %rcx
+    movq %rcx, -72(%rbp)
+    leaq .LC7(%rip), %rcx
+    movq %rcx, -80(%rbp)
+    leaq .LC8(%rip), %rcx
+    movq -72(%rbp), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    movq -80(%rbp), %rcx
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC9(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    movq -80(%rbp), %rcx
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq -72(%rbp), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -88(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+__init:
+    # 0 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+.L__init.entry:
+    movq $0, gp_global_total(%rip)
+    movq $0, gp_global_calls(%rip)
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\201 GPLANG Common Subexpressions"
+.LC1:
+    .string "Sum: "
+.LC2:
+    .string "Total: "
+.LC3:
+    .string "Calls: "
+.LC4:
+    .string " -> "
+.LC5:
+    .string ", doubled "
+.LC6:
+    .string "ab"
+.LC7:
+    .string "cd"
+.LC8:
+    .string "Strings: "
+.LC9:
+    .string " "
+
+.section .bss
+.p2align 3
+gp_global_calls:
+    .zero 8
+gp_global_total:
+    .zero 8
+
+.section .note.GNU-stack,"",@progbits
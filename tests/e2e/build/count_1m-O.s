@@ -0,0 +1,122 @@
+# GPLANG Generated Assembly
+# Module: count_1m
+# Source: ../../examples/basic/count_1m.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+main:
+    # 29 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    movq %r14, -32(%rbp)
+    movq %r15, -40(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    call gp_rt_time_now@PLT
+    movq %rax, %rbx
+    leaq .LC2(%rip), %r12
+    movq $1, %r13
+.Lmain.for.cond0:
+    cmpq $1000001, %r13
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq $100000, %r11
+    movq %r13, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rcx
+    testq %rcx, %rcx
+    je .Lmain.if.then4
+    jmp .Lmain.if.end5
+.Lmain.for.step2:
+    leaq 1(%r13), %rcx
+    movq %rcx, %r13
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, %r14
+    subq %rbx, %r14
+    leaq .LC3(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %r15
+    movq %r14, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r15, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC5(%rip), %r15
+    movq %r14, %rdi
+    call gp_rt_time_seconds@PLT
+    movq %xmm0, %rcx
+    movabsq $4696837146684686336, %r11
+    movq %r11, %xmm0
+    movq %rcx, %xmm1
+    divsd %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, %xmm0
+    call gp_rt_int_from_float@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %r15, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq -40(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lmain.if.then4:
+    movq %r13, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r12, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.if.end5:
+    jmp .Lmain.for.step2
+
+.section .rodata
+.LC0:
+    .string "\360\237\232\200 GPLANG Count Performance Test"
+.LC1:
+    .string "Counting from 1 to 1,000,000..."
+.LC2:
+    .string "Count: "
+.LC3:
+    .string "\342\234\205 COMPLETED!"
+.LC4:
+    .string "Total time: "
+.LC5:
+    .string "Operations/sec: "
+
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,107 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'count_1m'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.start_time = alloca i64
+  %v.i = alloca i64
+  %v.end_time = alloca i64
+  %v.total_time = alloca i64
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([35 x i8], [35 x i8]* @.str.0, i64 0, i64 0))
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([32 x i8], [32 x i8]* @.str.1, i64 0, i64 0))
+  %t0 = call i64 @gp_rt_time_now()
+  store i64 %t0, i64* %v.start_time
+  ; parallel for i runs serially: body prints
+  store i64 1, i64* %v.i
+  br label %for.cond.0
+
+for.cond.0:
+  %t1 = load i64, i64* %v.i
+  %t2 = icmp slt i64 %t1, 1000001
+  br i1 %t2, label %for.body.0, label %for.end.0
+
+for.body.0:
+  %t3 = load i64, i64* %v.i
+  %t4 = srem i64 %t3, 100000
+  %t5 = icmp eq i64 %t4, 0
+  br i1 %t5, label %if.then.1, label %if.end.1
+
+if.then.1:
+  %t6 = load i64, i64* %v.i
+  %t7 = call i8* @gp_rt_str_int(i64 %t6)
+  %t8 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([8 x i8], [8 x i8]* @.str.2, i64 0, i64 0), i8* %t7)
+  call i64 @gp_rt_print_string(i8* %t8)
+  br label %if.end.1
+
+if.end.1:
+  br label %for.step.0
+
+for.step.0:
+  %t9 = load i64, i64* %v.i
+  %t10 = add nsw i64 %t9, 1
+  store i64 %t10, i64* %v.i
+  br label %for.cond.0, !llvm.loop !2
+
+for.end.0:
+  %t11 = call i64 @gp_rt_time_now()
+  store i64 %t11, i64* %v.end_time
+  %t12 = load i64, i64* %v.end_time
+  %t13 = load i64, i64* %v.start_time
+  %t14 = sub nsw i64 %t12, %t13
+  store i64 %t14, i64* %v.total_time
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([15 x i8], [15 x i8]* @.str.3, i64 0, i64 0))
+  %t15 = load i64, i64* %v.total_time
+  %t16 = call i8* @gp_rt_str_int(i64 %t15)
+  %t17 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([13 x i8], [13 x i8]* @.str.4, i64 0, i64 0), i8* %t16)
+  call i64 @gp_rt_print_string(i8* %t17)
+  %t18 = load i64, i64* %v.total_time
+  %t19 = call double @gp_rt_time_seconds(i64 %t18)
+  %t20 = fdiv double 0x412E848000000000, %t19
+  %t21 = fptosi double %t20 to i64
+  %t22 = call i8* @gp_rt_str_int(i64 %t21)
+  %t23 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([17 x i8], [17 x i8]* @.str.5, i64 0, i64 0), i8* %t22)
+  call i64 @gp_rt_print_string(i8* %t23)
+  %t24 = trunc i64 0 to i32
+  ret i32 %t24
+}
+
+@.str.0 = private unnamed_addr constant [35 x i8] c"\F0\9F\9A\80 GPLANG Count Performance Test\00"
+@.str.1 = private unnamed_addr constant [32 x i8] c"Counting from 1 to 1,000,000...\00"
+@.str.2 = private unnamed_addr constant [8 x i8] c"Count: \00"
+@.str.3 = private unnamed_addr constant [15 x i8] c"\E2\9C\85 COMPLETED!\00"
+@.str.4 = private unnamed_addr constant [13 x i8] c"Total time: \00"
+@.str.5 = private unnamed_addr constant [17 x i8] c"Operations/sec: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0}
@@ -0,0 +1,125 @@
+# GPLANG Generated Assembly
+# Module: count_1m
+# Source: ../../examples/basic/count_1m.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+main:
+    # 37 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -40(%rbp)
+    movq %r12, -48(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, -8(%rbp)
+    movq $1, -16(%rbp)
+.Lmain.for.cond0:
+    movq -16(%rbp), %rcx
+    cmpq $1000001, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -16(%rbp), %rcx
+    movq $100000, %r11
+    movq %rcx, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rsi
+    testq %rsi, %rsi
+    je .Lmain.if.then4
+    jmp .Lmain.if.end5
+.Lmain.for.step2:
+    movq -16(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, -24(%rbp)
+    movq -8(%rbp), %rsi
+    movq %rcx, %rdi
+    subq %rsi, %rdi
+    movq %rdi, -32(%rbp)
+    leaq .LC2(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC3(%rip), %rbx
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %rbx
+    movabsq $4696837146684686336, %r12
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_time_seconds@PLT
+    movq %xmm0, %rsi
+    movq %r12, %xmm0
+    movq %rsi, %xmm1
+    divsd %xmm1, %xmm0
+    movq %xmm0, %rcx
+    movq %rcx, %xmm0
+    call gp_rt_int_from_float@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -40(%rbp), %rbx
+    movq -48(%rbp), %r12
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lmain.if.then4:
+    leaq .LC5(%rip), %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.if.end5:
+    jmp .Lmain.for.step2
+
+.section .rodata
+.LC0:
+    .string "\360\237\232\200 GPLANG Count Performance Test"
+.LC1:
+    .string "Counting from 1 to 1,000,000..."
+.LC2:
+    .string "\342\234\205 COMPLETED!"
+.LC3:
+    .string "Total time: "
+.LC4:
+    .string "Operations/sec: "
+.LC5:
+    .string "Count: "
+
+.section .note.GNU-stack,"",@progbits
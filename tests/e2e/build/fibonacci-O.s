@@ -0,0 +1,286 @@
+# GPLANG Generated Assembly
+# Module: fibonacci
+# Source: ../../examples/basic/fibonacci.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+fibonacci:
+    # 9 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lfibonacci.tailrec.entry:
+    xorl %ebx, %ebx
+    movq %rcx, %r12
+.Lfibonacci.entry:
+    cmpq $1, %r12
+    jg .Lfibonacci.if.else1
+.Lfibonacci.if.then0:
+    leaq (%rbx,%r12), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci.if.else1:
+    leaq -1(%r12), %rcx
+    movq %rcx, %rdi
+    call fibonacci
+    movq %rax, %rsi
+    leaq -2(%r12), %rcx
+    leaq (%rbx,%rsi), %rdi
+    movq %rdi, %rbx
+    movq %rcx, %r12
+    jmp .Lfibonacci.entry
+
+fibonacci_iterative:
+    # 9 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lfibonacci_iterative.entry:
+    cmpq $1, %rcx
+    jg .Lfibonacci_iterative.if.end1
+.Lfibonacci_iterative.if.then0:
+    movq %rcx, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci_iterative.if.end1:
+    leaq 1(%rcx), %rsi
+    xorl %ecx, %ecx
+    movq $1, %rdi
+    movq $2, %r8
+.Lfibonacci_iterative.for.cond2:
+    cmpq %rsi, %r8
+    jge .Lfibonacci_iterative.for.end5
+.Lfibonacci_iterative.for.body3:
+    leaq (%rcx,%rdi), %r9
+.Lfibonacci_iterative.for.step4:
+    leaq 1(%r8), %rbx
+    movq %rdi, %rcx
+    movq %r9, %rdi
+    movq %rbx, %r8
+    jmp .Lfibonacci_iterative.for.cond2
+.Lfibonacci_iterative.for.end5:
+    movq %rdi, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 58 values in registers, 2 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -24(%rbp)
+    movq %r12, -32(%rbp)
+    movq %r13, -40(%rbp)
+    movq %r14, -48(%rbp)
+    movq %r15, -56(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    call gp_rt_time_now@PLT
+    movq %rax, %rbx
+.Lmain.fibonacci.1.tailrec.entry:
+    xorl %r12d, %r12d
+    movq $35, %r13
+.Lmain.fibonacci.1.entry:
+    cmpq $1, %r13
+    jg .Lmain.fibonacci.1.if.else1
+.Lmain.fibonacci.1.if.then0:
+    leaq (%r12,%r13), %r14
+    jmp .Lmain.fibonacci.1.ret
+.Lmain.fibonacci.1.if.else1:
+    leaq -1(%r13), %rcx
+    movq %rcx, %rdi
+    call fibonacci
+    movq %rax, %rsi
+    leaq -2(%r13), %rcx
+    leaq (%r12,%rsi), %rdi
+    movq %rdi, %r12
+    movq %rcx, %r13
+    jmp .Lmain.fibonacci.1.entry
+.Lmain.fibonacci.1.ret:
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, %r10
+    subq %rbx, %r10
+    movq %r10, -8(%rbp)
+    leaq .LC2(%rip), %rbx
+    movq $35, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC3(%rip), %rbx
+    movq %rsi, %rdi
+    movq %rbx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r13
+    movq %r14, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %r13
+    movq -8(%rbp), %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rcx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %r13, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC5(%rip), %r14
+    movq %rcx, %rdi
+    movq %r14, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    call gp_rt_time_now@PLT
+    movq %rax, %r15
+.Lmain.fibonacci_iterative.0.entry:
+.Lmain.fibonacci_iterative.0.if.end1:
+    xorl %ecx, %ecx
+    movq $1, %r12
+    movq $2, %rsi
+.Lmain.fibonacci_iterative.0.for.cond2:
+    cmpq $36, %rsi
+    jge .Lmain.fibonacci_iterative.0.for.end5
+.Lmain.fibonacci_iterative.0.for.body3:
+    leaq (%rcx,%r12), %rdi
+.Lmain.fibonacci_iterative.0.for.step4:
+    leaq 1(%rsi), %r8
+    movq %r12, %rcx
+    movq %rdi, %r12
+    movq %r8, %rsi
+    jmp .Lmain.fibonacci_iterative.0.for.cond2
+.Lmain.fibonacci_iterative.0.for.end5:
+.Lmain.fibonacci_iterative.0.ret:
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, %r10
+    subq %r15, %r10
+    movq %r10, -16(%rbp)
+    leaq .LC6(%rip), %r15
+    movq $35, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r15, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    movq %rbx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r15
+    movq %r12, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r15, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    movq -16(%rbp), %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rcx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %r13, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    movq %r14, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    movq -8(%rbp), %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rbx
+    movq -16(%rbp), %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rcx
+    movq %rbx, %xmm0
+    movq %rcx, %xmm1
+    divsd %xmm1, %xmm0
+    movq %xmm0, %rsi
+    leaq .LC7(%rip), %rbx
+    movq %rsi, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC8(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -24(%rbp), %rbx
+    movq -32(%rbp), %r12
+    movq -40(%rbp), %r13
+    movq -48(%rbp), %r14
+    movq -56(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\242 GPLANG Fibonacci Benchmark"
+.LC1:
+    .string "============================"
+.LC2:
+    .string "Recursive fibonacci("
+.LC3:
+    .string ") = "
+.LC4:
+    .string "Time: "
+.LC5:
+    .string "ms"
+.LC6:
+    .string "Iterative fibonacci("
+.LC7:
+    .string "Speedup: "
+.LC8:
+    .string "x"
+
+.section .note.GNU-stack,"",@progbits
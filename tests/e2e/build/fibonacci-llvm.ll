@@ -0,0 +1,201 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'fibonacci'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: fibonacci
+define internal i64 @gp.fibonacci(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp sle i64 %t0, 1
+  br i1 %t1, label %if.then.0, label %if.else.0
+
+if.then.0:
+  %t2 = load i64, i64* %v.n
+  ret i64 %t2
+
+if.else.0:
+  %t3 = load i64, i64* %v.n
+  %t4 = sub nsw i64 %t3, 1
+  %t5 = call i64 @gp.fibonacci(i64 %t4)
+  %t6 = load i64, i64* %v.n
+  %t7 = sub nsw i64 %t6, 2
+  %t8 = call i64 @gp.fibonacci(i64 %t7)
+  %t9 = add nsw i64 %t5, %t8
+  ret i64 %t9
+
+if.end.0:
+  ret i64 0
+}
+
+; Function: fibonacci_iterative
+define internal i64 @gp.fibonacci_iterative(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  %v.a = alloca i64
+  %v.b = alloca i64
+  %v.i = alloca i64
+  %v.temp = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp sle i64 %t0, 1
+  br i1 %t1, label %if.then.1, label %if.end.1
+
+if.then.1:
+  %t2 = load i64, i64* %v.n
+  ret i64 %t2
+
+if.end.1:
+  store i64 0, i64* %v.a
+  store i64 1, i64* %v.b
+  %t3 = load i64, i64* %v.n
+  %t4 = add nsw i64 %t3, 1
+  store i64 2, i64* %v.i
+  br label %for.cond.2
+
+for.cond.2:
+  %t5 = load i64, i64* %v.i
+  %t6 = icmp slt i64 %t5, %t4
+  br i1 %t6, label %for.body.2, label %for.end.2
+
+for.body.2:
+  %t7 = load i64, i64* %v.a
+  %t8 = load i64, i64* %v.b
+  %t9 = add nsw i64 %t7, %t8
+  store i64 %t9, i64* %v.temp
+  %t10 = load i64, i64* %v.b
+  store i64 %t10, i64* %v.a
+  %t11 = load i64, i64* %v.temp
+  store i64 %t11, i64* %v.b
+  br label %for.step.2
+
+for.step.2:
+  %t12 = load i64, i64* %v.i
+  %t13 = add nsw i64 %t12, 1
+  store i64 %t13, i64* %v.i
+  br label %for.cond.2, !llvm.loop !2
+
+for.end.2:
+  %t14 = load i64, i64* %v.b
+  ret i64 %t14
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.n = alloca i64
+  %v.start_time = alloca i64
+  %v.result_recursive = alloca i64
+  %v.recursive_time = alloca i64
+  %v.result_iterative = alloca i64
+  %v.iterative_time = alloca i64
+  %v.speedup = alloca double
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([32 x i8], [32 x i8]* @.str.0, i64 0, i64 0))
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([29 x i8], [29 x i8]* @.str.1, i64 0, i64 0))
+  store i64 35, i64* %v.n
+  %t0 = call i64 @gp_rt_time_now()
+  store i64 %t0, i64* %v.start_time
+  %t1 = load i64, i64* %v.n
+  %t2 = call i64 @gp.fibonacci(i64 %t1)
+  store i64 %t2, i64* %v.result_recursive
+  %t3 = call i64 @gp_rt_time_now()
+  %t4 = load i64, i64* %v.start_time
+  %t5 = sub nsw i64 %t3, %t4
+  store i64 %t5, i64* %v.recursive_time
+  %t6 = load i64, i64* %v.n
+  %t7 = call i8* @gp_rt_str_int(i64 %t6)
+  %t8 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([21 x i8], [21 x i8]* @.str.2, i64 0, i64 0), i8* %t7)
+  %t9 = call i8* @gp_rt_string_concat(i8* %t8, i8* getelementptr inbounds ([5 x i8], [5 x i8]* @.str.3, i64 0, i64 0))
+  %t10 = load i64, i64* %v.result_recursive
+  %t11 = call i8* @gp_rt_str_int(i64 %t10)
+  %t12 = call i8* @gp_rt_string_concat(i8* %t9, i8* %t11)
+  call i64 @gp_rt_print_string(i8* %t12)
+  %t13 = load i64, i64* %v.recursive_time
+  %t14 = call double @gp_rt_time_milliseconds(i64 %t13)
+  %t15 = call i8* @gp_rt_str_float(double %t14)
+  %t16 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([7 x i8], [7 x i8]* @.str.4, i64 0, i64 0), i8* %t15)
+  %t17 = call i8* @gp_rt_string_concat(i8* %t16, i8* getelementptr inbounds ([3 x i8], [3 x i8]* @.str.5, i64 0, i64 0))
+  call i64 @gp_rt_print_string(i8* %t17)
+  %t18 = call i64 @gp_rt_time_now()
+  store i64 %t18, i64* %v.start_time
+  %t19 = load i64, i64* %v.n
+  %t20 = call i64 @gp.fibonacci_iterative(i64 %t19)
+  store i64 %t20, i64* %v.result_iterative
+  %t21 = call i64 @gp_rt_time_now()
+  %t22 = load i64, i64* %v.start_time
+  %t23 = sub nsw i64 %t21, %t22
+  store i64 %t23, i64* %v.iterative_time
+  %t24 = load i64, i64* %v.n
+  %t25 = call i8* @gp_rt_str_int(i64 %t24)
+  %t26 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([21 x i8], [21 x i8]* @.str.6, i64 0, i64 0), i8* %t25)
+  %t27 = call i8* @gp_rt_string_concat(i8* %t26, i8* getelementptr inbounds ([5 x i8], [5 x i8]* @.str.7, i64 0, i64 0))
+  %t28 = load i64, i64* %v.result_iterative
+  %t29 = call i8* @gp_rt_str_int(i64 %t28)
+  %t30 = call i8* @gp_rt_string_concat(i8* %t27, i8* %t29)
+  call i64 @gp_rt_print_string(i8* %t30)
+  %t31 = load i64, i64* %v.iterative_time
+  %t32 = call double @gp_rt_time_milliseconds(i64 %t31)
+  %t33 = call i8* @gp_rt_str_float(double %t32)
+  %t34 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([7 x i8], [7 x i8]* @.str.8, i64 0, i64 0), i8* %t33)
+  %t35 = call i8* @gp_rt_string_concat(i8* %t34, i8* getelementptr inbounds ([3 x i8], [3 x i8]* @.str.9, i64 0, i64 0))
+  call i64 @gp_rt_print_string(i8* %t35)
+  %t36 = load i64, i64* %v.recursive_time
+  %t37 = call double @gp_rt_time_milliseconds(i64 %t36)
+  %t38 = load i64, i64* %v.iterative_time
+  %t39 = call double @gp_rt_time_milliseconds(i64 %t38)
+  %t40 = fdiv double %t37, %t39
+  store double %t40, double* %v.speedup
+  %t41 = load double, double* %v.speedup
+  %t42 = call i8* @gp_rt_str_float(double %t41)
+  %t43 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([10 x i8], [10 x i8]* @.str.10, i64 0, i64 0), i8* %t42)
+  %t44 = call i8* @gp_rt_string_concat(i8* %t43, i8* getelementptr inbounds ([2 x i8], [2 x i8]* @.str.11, i64 0, i64 0))
+  call i64 @gp_rt_print_string(i8* %t44)
+  %t45 = trunc i64 0 to i32
+  ret i32 %t45
+}
+
+@.str.0 = private unnamed_addr constant [32 x i8] c"\F0\9F\94\A2 GPLANG Fibonacci Benchmark\00"
+@.str.1 = private unnamed_addr constant [29 x i8] c"============================\00"
+@.str.2 = private unnamed_addr constant [21 x i8] c"Recursive fibonacci(\00"
+@.str.3 = private unnamed_addr constant [5 x i8] c") = \00"
+@.str.4 = private unnamed_addr constant [7 x i8] c"Time: \00"
+@.str.5 = private unnamed_addr constant [3 x i8] c"ms\00"
+@.str.6 = private unnamed_addr constant [21 x i8] c"Iterative fibonacci(\00"
+@.str.7 = private unnamed_addr constant [5 x i8] c") = \00"
+@.str.8 = private unnamed_addr constant [7 x i8] c"Time: \00"
+@.str.9 = private unnamed_addr constant [3 x i8] c"ms\00"
+@.str.10 = private unnamed_addr constant [10 x i8] c"Speedup: \00"
+@.str.11 = private unnamed_addr constant [2 x i8] c"x\00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0, !1}
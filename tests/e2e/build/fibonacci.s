@@ -0,0 +1,279 @@
+# GPLANG Generated Assembly
+# Module: fibonacci
+# Source: ../../examples/basic/fibonacci.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+fibonacci:
+    # 11 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lfibonacci.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $1, %rcx
+    jg .Lfibonacci.if.else1
+.Lfibonacci.if.then0:
+    movq -8(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci.if.else1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    call fibonacci
+    movq %rax, %rbx
+    movq -8(%rbp), %rcx
+    leaq -2(%rcx), %rsi
+    movq %rsi, %rdi
+    call fibonacci
+    movq %rax, %rcx
+    leaq (%rbx,%rcx), %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci.if.end2:
+    xorl %eax, %eax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+fibonacci_iterative:
+    # 16 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lfibonacci_iterative.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $1, %rcx
+    jg .Lfibonacci_iterative.if.end1
+.Lfibonacci_iterative.if.then0:
+    movq -8(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci_iterative.if.end1:
+    movq $0, -16(%rbp)
+    movq $1, -24(%rbp)
+    movq -8(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq $2, -32(%rbp)
+.Lfibonacci_iterative.for.cond2:
+    movq -32(%rbp), %rcx
+    cmpq %rsi, %rcx
+    jge .Lfibonacci_iterative.for.end5
+.Lfibonacci_iterative.for.body3:
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rdi
+    leaq (%rcx,%rdi), %r8
+    movq %r8, -40(%rbp)
+    movq -24(%rbp), %rcx
+    movq %rcx, -16(%rbp)
+    movq -40(%rbp), %rcx
+    movq %rcx, -24(%rbp)
+.Lfibonacci_iterative.for.step4:
+    movq -32(%rbp), %rcx
+    leaq 1(%rcx), %rdi
+    movq %rdi, -32(%rbp)
+    jmp .Lfibonacci_iterative.for.cond2
+.Lfibonacci_iterative.for.end5:
+    movq -24(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 64 values in registers, 0 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -64(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $35, -8(%rbp)
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, -16(%rbp)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call fibonacci
+    movq %rax, %rsi
+    movq %rsi, -24(%rbp)
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq -16(%rbp), %rsi
+    movq %rcx, %rdi
+    subq %rsi, %rdi
+    movq %rdi, -32(%rbp)
+    leaq .LC2(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC3(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -24(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %rbx
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rsi
+    movq %rsi, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC5(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq %rcx, -16(%rbp)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call fibonacci_iterative
+    movq %rax, %rsi
+    movq %rsi, -40(%rbp)
+    call gp_rt_time_now@PLT
+    movq %rax, %rcx
+    movq -16(%rbp), %rsi
+    movq %rcx, %rdi
+    subq %rsi, %rdi
+    movq %rdi, -48(%rbp)
+    leaq .LC6(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC3(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -40(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %rbx
+    movq -48(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rsi
+    movq %rsi, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC5(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rbx
+    movq -48(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_time_milliseconds@PLT
+    movq %xmm0, %rsi
+    movq %rbx, %xmm0
+    movq %rsi, %xmm1
+    divsd %xmm1, %xmm0
+    movq %xmm0, %rcx
+    movq %rcx, -56(%rbp)
+    leaq .LC7(%rip), %rbx
+    movq -56(%rbp), %rcx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC8(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -64(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\242 GPLANG Fibonacci Benchmark"
+.LC1:
+    .string "============================"
+.LC2:
+    .string "Recursive fibonacci("
+.LC3:
+    .string ") = "
+.LC4:
+    .string "Time: "
+.LC5:
+    .string "ms"
+.LC6:
+    .string "Iterative fibonacci("
+.LC7:
+    .string "Speedup: "
+.LC8:
+    .string "x"
+
+.section .note.GNU-stack,"",@progbits
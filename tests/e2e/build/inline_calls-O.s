@@ -0,0 +1,381 @@
+# GPLANG Generated Assembly
+# Module: inline_calls
+# Source: ../../examples/basic/inline_calls.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+cell:
+    # 5 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lcell.entry:
+    movq %rcx, %r8
+    imulq %rdi, %r8
+    leaq (%r8,%rsi), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+clamp:
+    # 5 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lclamp.entry:
+    cmpq %rsi, %rcx
+    jge .Lclamp.if.end1
+.Lclamp.if.then0:
+    movq %rsi, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lclamp.if.end1:
+    cmpq %rdi, %rcx
+    jle .Lclamp.if.end3
+.Lclamp.if.then2:
+    movq %rdi, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lclamp.if.end3:
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+weight:
+    # 6 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lweight.entry:
+    leaq (%rcx,%rcx,2), %rsi
+    movq $2, %r11
+    movq %rcx, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rdi
+    testq %rdi, %rdi
+    je .Lweight.if.then0
+    movq %rsi, %rcx
+    jmp .Lweight.if.end1
+.Lweight.if.then0:
+    leaq 1(%rsi), %rdi
+    movq %rdi, %rcx
+.Lweight.if.end1:
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+is_even:
+    # 4 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_even.entry:
+    testq %rcx, %rcx
+    jne .Lis_even.if.end1
+.Lis_even.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_even.if.end1:
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    popq %rbp
+    jmp is_odd
+
+is_odd:
+    # 4 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_odd.entry:
+    testq %rcx, %rcx
+    jne .Lis_odd.if.end1
+.Lis_odd.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_odd.if.end1:
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    popq %rbp
+    jmp is_even
+
+factorial:
+    # 7 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lfactorial.tailrec.entry:
+    movq $1, %rsi
+    movq %rcx, %rdi
+.Lfactorial.entry:
+    cmpq $1, %rdi
+    jg .Lfactorial.if.end1
+.Lfactorial.if.then0:
+    movq %rsi, %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lfactorial.if.end1:
+    leaq -1(%rdi), %rcx
+    movq %rsi, %r8
+    imulq %rdi, %r8
+    movq %r8, %rsi
+    movq %rcx, %rdi
+    jmp .Lfactorial.entry
+
+main:
+    # 65 values in registers, 1 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -16(%rbp)
+    movq %r12, -24(%rbp)
+    movq %r13, -32(%rbp)
+    movq %r14, -40(%rbp)
+    movq %r15, -48(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %r12d, %r12d
+    xorl %ecx, %ecx
+    xorl %ebx, %ebx
+.Lmain.for.cond0:
+    cmpq $8, %rbx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq %rcx, %r13
+    xorl %r14d, %r14d
+    jmp .Lmain.for.cond4
+.Lmain.for.step2:
+    leaq 1(%rbx), %rsi
+    leaq 8(%r12), %rdi
+    movq %rdi, %r12
+    movq %r13, %rcx
+    movq %rsi, %rbx
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %r15
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %r15, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %edi, %edi
+    movq $0, -8(%rbp)
+    xorl %esi, %esi
+    jmp .Lmain.for.cond8
+.Lmain.for.cond4:
+    cmpq $8, %r14
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+.Lmain.cell.7.entry:
+    leaq (%r12,%r14), %r8
+.Lmain.cell.7.ret:
+    movq %rbx, %r9
+    subq %r14, %r9
+.Lmain.clamp.6.entry:
+    cmpq $-2, %r9
+    jge .Lmain.clamp.6.if.end1
+.Lmain.clamp.6.if.then0:
+    movq $-2, %r15
+    jmp .Lmain.clamp.6.ret
+.Lmain.clamp.6.if.end1:
+    cmpq $2, %r9
+    jle .Lmain.clamp.6.if.end3
+.Lmain.clamp.6.if.then2:
+    movq $2, %r15
+    jmp .Lmain.clamp.6.ret
+.Lmain.clamp.6.if.end3:
+    movq %r9, %r15
+.Lmain.clamp.6.ret:
+    movq %r8, %rcx
+    imulq %r15, %rcx
+    leaq (%r13,%rcx), %r8
+.Lmain.for.step6:
+    leaq 1(%r14), %rcx
+    movq %r8, %r13
+    movq %rcx, %r14
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    jmp .Lmain.for.step2
+.Lmain.for.cond8:
+    cmpq $100, %rsi
+    jge .Lmain.for.end11
+.Lmain.for.body9:
+.Lmain.weight.5.entry:
+    movq $2, %r11
+    movq %rsi, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rcx
+    testq %rcx, %rcx
+    je .Lmain.weight.5.if.then0
+    movq %rdi, %rcx
+    jmp .Lmain.weight.5.if.end1
+.Lmain.weight.5.if.then0:
+    leaq 1(%rdi), %r8
+    movq %r8, %rcx
+.Lmain.weight.5.if.end1:
+.Lmain.weight.5.ret:
+    movq -8(%rbp), %r8
+    addq %rcx, %r8
+.Lmain.for.step10:
+    leaq 1(%rsi), %rcx
+    leaq 3(%rdi), %r9
+    movq %r9, %rdi
+    movq %r8, -8(%rbp)
+    movq %rcx, %rsi
+    jmp .Lmain.for.cond8
+.Lmain.for.end11:
+    leaq .LC2(%rip), %rbx
+    movq -8(%rbp), %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC3(%rip), %rbx
+.Lmain.clamp.4.entry:
+.Lmain.clamp.4.if.end1:
+.Lmain.clamp.4.if.then2:
+.Lmain.clamp.4.ret:
+    movq $10, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC4(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+.Lmain.clamp.3.entry:
+.Lmain.clamp.3.if.then0:
+.Lmain.clamp.3.ret:
+    xorl %edi, %edi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC5(%rip), %rbx
+.Lmain.is_even.2.entry:
+.Lmain.is_even.2.if.end1:
+    movq $9, %rdi
+    call is_odd
+    movq %rax, %rcx
+.Lmain.is_even.2.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %rbx
+.Lmain.is_odd.1.entry:
+.Lmain.is_odd.1.if.end1:
+    movq $6, %rdi
+    call is_even
+    movq %rax, %rcx
+.Lmain.is_odd.1.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC7(%rip), %rbx
+.Lmain.factorial.0.tailrec.entry:
+    movq $1, %rcx
+    movq $12, %rsi
+.Lmain.factorial.0.entry:
+    cmpq $1, %rsi
+    jg .Lmain.factorial.0.if.end1
+.Lmain.factorial.0.if.then0:
+    movq %rcx, %rdi
+    jmp .Lmain.factorial.0.ret
+.Lmain.factorial.0.if.end1:
+    leaq -1(%rsi), %r8
+    movq %rcx, %r9
+    imulq %rsi, %r9
+    movq %r9, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.factorial.0.entry
+.Lmain.factorial.0.ret:
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq -24(%rbp), %r12
+    movq -32(%rbp), %r13
+    movq -40(%rbp), %r14
+    movq -48(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\223\245 GPLANG Inline Calls"
+.LC1:
+    .string "Weighted cells: "
+.LC2:
+    .string "Weights: "
+.LC3:
+    .string "Clamped: "
+.LC4:
+    .string " "
+.LC5:
+    .string "10 is even: "
+.LC6:
+    .string "7 is odd: "
+.LC7:
+    .string "12!: "
+
+.section .note.GNU-stack,"",@progbits
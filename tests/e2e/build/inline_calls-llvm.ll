@@ -0,0 +1,298 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'inline_calls'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: cell
+define internal i64 @gp.cell(i64 %p.row, i64 %p.col, i64 %p.width) #0 {
+entry:
+  %v.row = alloca i64
+  %v.col = alloca i64
+  %v.width = alloca i64
+  store i64 %p.row, i64* %v.row
+  store i64 %p.col, i64* %v.col
+  store i64 %p.width, i64* %v.width
+  %t0 = load i64, i64* %v.row
+  %t1 = load i64, i64* %v.width
+  %t2 = mul nsw i64 %t0, %t1
+  %t3 = load i64, i64* %v.col
+  %t4 = add nsw i64 %t2, %t3
+  ret i64 %t4
+}
+
+; Function: clamp
+define internal i64 @gp.clamp(i64 %p.value, i64 %p.low, i64 %p.high) #0 {
+entry:
+  %v.value = alloca i64
+  %v.low = alloca i64
+  %v.high = alloca i64
+  store i64 %p.value, i64* %v.value
+  store i64 %p.low, i64* %v.low
+  store i64 %p.high, i64* %v.high
+  %t0 = load i64, i64* %v.value
+  %t1 = load i64, i64* %v.low
+  %t2 = icmp slt i64 %t0, %t1
+  br i1 %t2, label %if.then.0, label %if.end.0
+
+if.then.0:
+  %t3 = load i64, i64* %v.low
+  ret i64 %t3
+
+if.end.0:
+  %t4 = load i64, i64* %v.value
+  %t5 = load i64, i64* %v.high
+  %t6 = icmp sgt i64 %t4, %t5
+  br i1 %t6, label %if.then.1, label %if.end.1
+
+if.then.1:
+  %t7 = load i64, i64* %v.high
+  ret i64 %t7
+
+if.end.1:
+  %t8 = load i64, i64* %v.value
+  ret i64 %t8
+}
+
+; Function: weight
+define internal i64 @gp.weight(i64 %p.value) #2 {
+entry:
+  %v.value = alloca i64
+  %v.result = alloca i64
+  store i64 %p.value, i64* %v.value
+  %t0 = load i64, i64* %v.value
+  %t1 = mul nsw i64 %t0, 3
+  store i64 %t1, i64* %v.result
+  %t2 = load i64, i64* %v.value
+  %t3 = srem i64 %t2, 2
+  %t4 = icmp eq i64 %t3, 0
+  br i1 %t4, label %if.then.2, label %if.end.2
+
+if.then.2:
+  %t5 = load i64, i64* %v.result
+  %t6 = add nsw i64 %t5, 1
+  store i64 %t6, i64* %v.result
+  br label %if.end.2
+
+if.end.2:
+  %t7 = load i64, i64* %v.result
+  ret i64 %t7
+}
+
+; Function: is_even
+define internal i64 @gp.is_even(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.3, label %if.end.3
+
+if.then.3:
+  ret i64 1
+
+if.end.3:
+  %t2 = load i64, i64* %v.n
+  %t3 = sub nsw i64 %t2, 1
+  %t4 = call i64 @gp.is_odd(i64 %t3)
+  ret i64 %t4
+}
+
+; Function: is_odd
+define internal i64 @gp.is_odd(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.4, label %if.end.4
+
+if.then.4:
+  ret i64 0
+
+if.end.4:
+  %t2 = load i64, i64* %v.n
+  %t3 = sub nsw i64 %t2, 1
+  %t4 = call i64 @gp.is_even(i64 %t3)
+  ret i64 %t4
+}
+
+; Function: factorial
+define internal i64 @gp.factorial(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp sle i64 %t0, 1
+  br i1 %t1, label %if.then.5, label %if.end.5
+
+if.then.5:
+  ret i64 1
+
+if.end.5:
+  %t2 = load i64, i64* %v.n
+  %t3 = load i64, i64* %v.n
+  %t4 = sub nsw i64 %t3, 1
+  %t5 = call i64 @gp.factorial(i64 %t4)
+  %t6 = mul nsw i64 %t2, %t5
+  ret i64 %t6
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.width = alloca i64
+  %v.trace = alloca i64
+  %v.row = alloca i64
+  %v.col = alloca i64
+  %v.weights = alloca i64
+  %v.i = alloca i64
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([25 x i8], [25 x i8]* @.str.0, i64 0, i64 0))
+  store i64 8, i64* %v.width
+  store i64 0, i64* %v.trace
+  store i64 0, i64* %v.row
+  br label %for.cond.6
+
+for.cond.6:
+  %t0 = load i64, i64* %v.row
+  %t1 = icmp slt i64 %t0, 8
+  br i1 %t1, label %for.body.6, label %for.end.6
+
+for.body.6:
+  store i64 0, i64* %v.col
+  br label %for.cond.7
+
+for.cond.7:
+  %t2 = load i64, i64* %v.col
+  %t3 = icmp slt i64 %t2, 8
+  br i1 %t3, label %for.body.7, label %for.end.7
+
+for.body.7:
+  %t4 = load i64, i64* %v.row
+  %t5 = load i64, i64* %v.col
+  %t6 = load i64, i64* %v.width
+  %t7 = call i64 @gp.cell(i64 %t4, i64 %t5, i64 %t6)
+  %t8 = load i64, i64* %v.row
+  %t9 = load i64, i64* %v.col
+  %t10 = sub nsw i64 %t8, %t9
+  %t11 = sub nsw i64 0, 2
+  %t12 = call i64 @gp.clamp(i64 %t10, i64 %t11, i64 2)
+  %t13 = mul nsw i64 %t7, %t12
+  %t14 = load i64, i64* %v.trace
+  %t15 = add nsw i64 %t14, %t13
+  store i64 %t15, i64* %v.trace
+  br label %for.step.7
+
+for.step.7:
+  %t16 = load i64, i64* %v.col
+  %t17 = add nsw i64 %t16, 1
+  store i64 %t17, i64* %v.col
+  br label %for.cond.7, !llvm.loop !3
+
+for.end.7:
+  br label %for.step.6
+
+for.step.6:
+  %t18 = load i64, i64* %v.row
+  %t19 = add nsw i64 %t18, 1
+  store i64 %t19, i64* %v.row
+  br label %for.cond.6, !llvm.loop !2
+
+for.end.6:
+  %t20 = load i64, i64* %v.trace
+  %t21 = call i8* @gp_rt_str_int(i64 %t20)
+  %t22 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([17 x i8], [17 x i8]* @.str.1, i64 0, i64 0), i8* %t21)
+  call i64 @gp_rt_print_string(i8* %t22)
+  store i64 0, i64* %v.weights
+  store i64 0, i64* %v.i
+  br label %for.cond.8
+
+for.cond.8:
+  %t23 = load i64, i64* %v.i
+  %t24 = icmp slt i64 %t23, 100
+  br i1 %t24, label %for.body.8, label %for.end.8
+
+for.body.8:
+  %t25 = load i64, i64* %v.i
+  %t26 = call i64 @gp.weight(i64 %t25)
+  %t27 = load i64, i64* %v.weights
+  %t28 = add nsw i64 %t27, %t26
+  store i64 %t28, i64* %v.weights
+  br label %for.step.8
+
+for.step.8:
+  %t29 = load i64, i64* %v.i
+  %t30 = add nsw i64 %t29, 1
+  store i64 %t30, i64* %v.i
+  br label %for.cond.8, !llvm.loop !4
+
+for.end.8:
+  %t31 = load i64, i64* %v.weights
+  %t32 = call i8* @gp_rt_str_int(i64 %t31)
+  %t33 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([10 x i8], [10 x i8]* @.str.2, i64 0, i64 0), i8* %t32)
+  call i64 @gp_rt_print_string(i8* %t33)
+  %t34 = call i64 @gp.clamp(i64 42, i64 0, i64 10)
+  %t35 = call i8* @gp_rt_str_int(i64 %t34)
+  %t36 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([10 x i8], [10 x i8]* @.str.3, i64 0, i64 0), i8* %t35)
+  %t37 = call i8* @gp_rt_string_concat(i8* %t36, i8* getelementptr inbounds ([2 x i8], [2 x i8]* @.str.4, i64 0, i64 0))
+  %t38 = sub nsw i64 0, 5
+  %t39 = call i64 @gp.clamp(i64 %t38, i64 0, i64 10)
+  %t40 = call i8* @gp_rt_str_int(i64 %t39)
+  %t41 = call i8* @gp_rt_string_concat(i8* %t37, i8* %t40)
+  call i64 @gp_rt_print_string(i8* %t41)
+  %t42 = call i64 @gp.is_even(i64 10)
+  %t43 = call i8* @gp_rt_str_int(i64 %t42)
+  %t44 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([13 x i8], [13 x i8]* @.str.5, i64 0, i64 0), i8* %t43)
+  call i64 @gp_rt_print_string(i8* %t44)
+  %t45 = call i64 @gp.is_odd(i64 7)
+  %t46 = call i8* @gp_rt_str_int(i64 %t45)
+  %t47 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([11 x i8], [11 x i8]* @.str.6, i64 0, i64 0), i8* %t46)
+  call i64 @gp_rt_print_string(i8* %t47)
+  %t48 = call i64 @gp.factorial(i64 12)
+  %t49 = call i8* @gp_rt_str_int(i64 %t48)
+  %t50 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([6 x i8], [6 x i8]* @.str.7, i64 0, i64 0), i8* %t49)
+  call i64 @gp_rt_print_string(i8* %t50)
+  %t51 = trunc i64 0 to i32
+  ret i32 %t51
+}
+
+@.str.0 = private unnamed_addr constant [25 x i8] c"\F0\9F\93\A5 GPLANG Inline Calls\00"
+@.str.1 = private unnamed_addr constant [17 x i8] c"Weighted cells: \00"
+@.str.2 = private unnamed_addr constant [10 x i8] c"Weights: \00"
+@.str.3 = private unnamed_addr constant [10 x i8] c"Clamped: \00"
+@.str.4 = private unnamed_addr constant [2 x i8] c" \00"
+@.str.5 = private unnamed_addr constant [13 x i8] c"10 is even: \00"
+@.str.6 = private unnamed_addr constant [11 x i8] c"7 is odd: \00"
+@.str.7 = private unnamed_addr constant [6 x i8] c"12!: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0}
+!3 = distinct !{!3, !0}
+!4 = distinct !{!4, !0}
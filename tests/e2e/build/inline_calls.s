@@ -0,0 +1,389 @@
+# GPLANG Generated Assembly
+# Module: inline_calls
+# Source: ../../examples/basic/inline_calls.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+cell:
+    # 8 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lcell.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq %rdi, -24(%rbp)
+    movq -8(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    movq %rcx, %rdi
+    imulq %rsi, %rdi
+    movq -16(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+clamp:
+    # 12 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lclamp.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq %rdi, -24(%rbp)
+    movq -8(%rbp), %rcx
+    movq -16(%rbp), %rsi
+    cmpq %rsi, %rcx
+    jge .Lclamp.if.end1
+.Lclamp.if.then0:
+    movq -16(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lclamp.if.end1:
+    movq -8(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    cmpq %rsi, %rcx
+    jle .Lclamp.if.end3
+.Lclamp.if.then2:
+    movq -24(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lclamp.if.end3:
+    movq -8(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+weight:
+    # 9 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lweight.entry:
+    movq %rcx, -8(%rbp)
+    leaq (%rcx,%rcx,2), %rsi
+    movq %rsi, -16(%rbp)
+    movq -8(%rbp), %rcx
+    movq $2, %r11
+    movq %rcx, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rsi
+    testq %rsi, %rsi
+    jne .Lweight.if.end1
+.Lweight.if.then0:
+    movq -16(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+.Lweight.if.end1:
+    movq -16(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+is_even:
+    # 6 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_even.entry:
+    movq %rcx, -8(%rbp)
+    testq %rcx, %rcx
+    jne .Lis_even.if.end1
+.Lis_even.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_even.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    jmp is_odd
+
+is_odd:
+    # 6 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_odd.entry:
+    movq %rcx, -8(%rbp)
+    testq %rcx, %rcx
+    jne .Lis_odd.if.end1
+.Lis_odd.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_odd.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    jmp is_even
+
+factorial:
+    # 8 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lfactorial.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $1, %rcx
+    jg .Lfactorial.if.end1
+.Lfactorial.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfactorial.if.end1:
+    movq -8(%rbp), %rbx
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    call factorial
+    movq %rax, %rcx
+    movq %rbx, %rsi
+    imulq %rcx, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 66 values in registers, 0 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -56(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $8, -8(%rbp)
+    movq $0, -16(%rbp)
+    movq $0, -24(%rbp)
+.Lmain.for.cond0:
+    movq -24(%rbp), %rcx
+    cmpq $8, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq $0, -32(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.step2:
+    movq -24(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -24(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -40(%rbp)
+    movq $0, -48(%rbp)
+    jmp .Lmain.for.cond8
+.Lmain.for.cond4:
+    movq -32(%rbp), %rcx
+    cmpq $8, %rcx
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    movq -24(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    movq -8(%rbp), %rdi
+    movq %rdi, %rdx
+    movq %rcx, %rdi
+    call cell
+    movq %rax, %rbx
+    movq -24(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    movq %rcx, %rdi
+    subq %rsi, %rdi
+    xorl %ecx, %ecx
+    subq $2, %rcx
+    movq %rcx, %rsi
+    movq $2, %rdx
+    call clamp
+    movq %rax, %rsi
+    movq %rbx, %rcx
+    imulq %rsi, %rcx
+    movq -16(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -16(%rbp)
+.Lmain.for.step6:
+    movq -32(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -32(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    jmp .Lmain.for.step2
+.Lmain.for.cond8:
+    movq -48(%rbp), %rcx
+    cmpq $100, %rcx
+    jge .Lmain.for.end11
+.Lmain.for.body9:
+    movq -48(%rbp), %rcx
+    movq %rcx, %rdi
+    call weight
+    movq %rax, %rsi
+    movq -40(%rbp), %rcx
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, -40(%rbp)
+.Lmain.for.step10:
+    movq -48(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -48(%rbp)
+    jmp .Lmain.for.cond8
+.Lmain.for.end11:
+    leaq .LC2(%rip), %rbx
+    movq -40(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC3(%rip), %rbx
+    movq $42, %rdi
+    xorl %esi, %esi
+    movq $10, %rdx
+    call clamp
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC4(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    xorl %ecx, %ecx
+    subq $5, %rcx
+    movq %rcx, %rdi
+    xorl %esi, %esi
+    movq $10, %rdx
+    call clamp
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC5(%rip), %rbx
+    movq $10, %rdi
+    call is_even
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %rbx
+    movq $7, %rdi
+    call is_odd
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC7(%rip), %rbx
+    movq $12, %rdi
+    call factorial
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -56(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\223\245 GPLANG Inline Calls"
+.LC1:
+    .string "Weighted cells: "
+.LC2:
+    .string "Weights: "
+.LC3:
+    .string "Clamped: "
+.LC4:
+    .string " "
+.LC5:
+    .string "10 is even: "
+.LC6:
+    .string "7 is odd: "
+.LC7:
+    .string "12!: "
+
+.section .note.GNU-stack,"",@progbits
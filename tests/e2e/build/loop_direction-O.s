@@ -0,0 +1,242 @@
+# GPLANG Generated Assembly
+# Module: loop_direction
+# Source: ../../examples/basic/loop_direction.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+count:
+    # 10 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lcount.entry:
+    testq %rdi, %rdi
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %r8
+    xorl %r9d, %r9d
+    movq %rcx, %rbx
+.Lcount.for.cond0:
+    testq %r8, %r8
+    jne .Lcount.for.up4
+    jmp .Lcount.for.down5
+.Lcount.for.body1:
+    leaq 1(%r9), %rcx
+.Lcount.for.step2:
+    leaq (%rbx,%rdi), %r12
+    movq %rcx, %r9
+    movq %r12, %rbx
+    jmp .Lcount.for.cond0
+.Lcount.for.end3:
+    movq %r9, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lcount.for.up4:
+    cmpq %rsi, %rbx
+    jl .Lcount.for.body1
+    jmp .Lcount.for.end3
+.Lcount.for.down5:
+    cmpq %rsi, %rbx
+    jg .Lcount.for.body1
+    jmp .Lcount.for.end3
+
+main:
+    # 51 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rbx
+.Lmain.count.3.entry:
+.Lmain.count.3.for.cond0:
+    jmp .Lmain.count.3.for.down5
+.Lmain.count.3.for.end3:
+    jmp .Lmain.count.3.ret
+.Lmain.count.3.for.down5:
+    jmp .Lmain.count.3.for.end3
+.Lmain.count.3.ret:
+    xorl %edi, %edi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+.Lmain.count.2.entry:
+    xorl %ecx, %ecx
+    xorl %esi, %esi
+.Lmain.count.2.for.cond0:
+    jmp .Lmain.count.2.for.down5
+.Lmain.count.2.for.body1:
+    leaq 1(%rcx), %rdi
+.Lmain.count.2.for.step2:
+    leaq -1(%rsi), %r8
+    movq %rdi, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.count.2.for.cond0
+.Lmain.count.2.for.end3:
+    jmp .Lmain.count.2.ret
+.Lmain.count.2.for.down5:
+    cmpq $-5, %rsi
+    jg .Lmain.count.2.for.body1
+    jmp .Lmain.count.2.for.end3
+.Lmain.count.2.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC3(%rip), %rbx
+.Lmain.count.1.entry:
+    xorl %ecx, %ecx
+    movq $10, %rsi
+.Lmain.count.1.for.cond0:
+    jmp .Lmain.count.1.for.down5
+.Lmain.count.1.for.body1:
+    leaq 1(%rcx), %rdi
+.Lmain.count.1.for.step2:
+    leaq -3(%rsi), %r8
+    movq %rdi, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.count.1.for.cond0
+.Lmain.count.1.for.end3:
+    jmp .Lmain.count.1.ret
+.Lmain.count.1.for.down5:
+    testq %rsi, %rsi
+    jg .Lmain.count.1.for.body1
+    jmp .Lmain.count.1.for.end3
+.Lmain.count.1.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %rbx
+.Lmain.count.0.entry:
+    xorl %ecx, %ecx
+    xorl %esi, %esi
+.Lmain.count.0.for.cond0:
+    jmp .Lmain.count.0.for.up4
+.Lmain.count.0.for.body1:
+    leaq 1(%rcx), %rdi
+.Lmain.count.0.for.step2:
+    leaq 3(%rsi), %r8
+    movq %rdi, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.count.0.for.cond0
+.Lmain.count.0.for.end3:
+    jmp .Lmain.count.0.ret
+.Lmain.count.0.for.up4:
+    cmpq $10, %rsi
+    jl .Lmain.count.0.for.body1
+    jmp .Lmain.count.0.for.end3
+.Lmain.count.0.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ecx, %ecx
+    xorl %esi, %esi
+.Lmain.for.cond0:
+    cmpq $10, %rsi
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    leaq (%rcx,%rsi), %rdi
+.Lmain.for.step2:
+    leaq 2(%rsi), %r8
+    movq %rdi, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC5(%rip), %rbx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ebx, %ebx
+    movq $100000, %r12
+.Lmain.for.cond4:
+    jmp .Lmain.for.down9
+.Lmain.for.body5:
+    leaq (%rbx,%r12), %rcx
+.Lmain.for.step6:
+    leaq -1(%r12), %rsi
+    movq %rcx, %rbx
+    movq %rsi, %r12
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC6(%rip), %r13
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lmain.for.down9:
+    testq %r12, %r12
+    jg .Lmain.for.body5
+    jmp .Lmain.for.end7
+
+.section .rodata
+.LC0:
+    .string "\342\206\225\357\270\217 GPLANG Loop Direction"
+.LC1:
+    .string "range(0, 5, -1): "
+.LC2:
+    .string "range(0, -5, -1): "
+.LC3:
+    .string "range(10, 0, -3): "
+.LC4:
+    .string "range(0, 10, 3): "
+.LC5:
+    .string "Sum of range(0, 10, -(-2)): "
+.LC6:
+    .string "Parallel sum counting down: "
+
+.section .note.GNU-stack,"",@progbits
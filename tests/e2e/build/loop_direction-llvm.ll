@@ -0,0 +1,213 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'loop_direction'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: count
+define internal i64 @gp.count(i64 %p.start, i64 %p.end, i64 %p.step) #0 {
+entry:
+  %v.start = alloca i64
+  %v.end = alloca i64
+  %v.step = alloca i64
+  %v.n = alloca i64
+  %v.i = alloca i64
+  store i64 %p.start, i64* %v.start
+  store i64 %p.end, i64* %v.end
+  store i64 %p.step, i64* %v.step
+  store i64 0, i64* %v.n
+  %t0 = load i64, i64* %v.start
+  %t1 = load i64, i64* %v.end
+  %t2 = load i64, i64* %v.step
+  store i64 %t0, i64* %v.i
+  %t3 = icmp sgt i64 %t2, 0
+  br label %for.cond.0
+
+for.cond.0:
+  %t4 = load i64, i64* %v.i
+  %t5 = icmp slt i64 %t4, %t1
+  %t6 = icmp sgt i64 %t4, %t1
+  %t7 = select i1 %t3, i1 %t5, i1 %t6
+  br i1 %t7, label %for.body.0, label %for.end.0
+
+for.body.0:
+  %t8 = load i64, i64* %v.n
+  %t9 = add nsw i64 %t8, 1
+  store i64 %t9, i64* %v.n
+  br label %for.step.0
+
+for.step.0:
+  %t10 = load i64, i64* %v.i
+  %t11 = add nsw i64 %t10, %t2
+  store i64 %t11, i64* %v.i
+  br label %for.cond.0, !llvm.loop !2
+
+for.end.0:
+  %t12 = load i64, i64* %v.n
+  ret i64 %t12
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.down = alloca i64
+  %v.k = alloca i64
+  %v.i = alloca i64
+  %v.total = alloca i64
+  %v.i.1 = alloca i64
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([29 x i8], [29 x i8]* @.str.0, i64 0, i64 0))
+  %t0 = sub nsw i64 0, 1
+  store i64 %t0, i64* %v.down
+  %t1 = load i64, i64* %v.down
+  %t2 = call i64 @gp.count(i64 0, i64 5, i64 %t1)
+  %t3 = call i8* @gp_rt_str_int(i64 %t2)
+  %t4 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([18 x i8], [18 x i8]* @.str.1, i64 0, i64 0), i8* %t3)
+  call i64 @gp_rt_print_string(i8* %t4)
+  %t5 = sub nsw i64 0, 5
+  %t6 = load i64, i64* %v.down
+  %t7 = call i64 @gp.count(i64 0, i64 %t5, i64 %t6)
+  %t8 = call i8* @gp_rt_str_int(i64 %t7)
+  %t9 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([19 x i8], [19 x i8]* @.str.2, i64 0, i64 0), i8* %t8)
+  call i64 @gp_rt_print_string(i8* %t9)
+  %t10 = sub nsw i64 0, 3
+  %t11 = call i64 @gp.count(i64 10, i64 0, i64 %t10)
+  %t12 = call i8* @gp_rt_str_int(i64 %t11)
+  %t13 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([19 x i8], [19 x i8]* @.str.3, i64 0, i64 0), i8* %t12)
+  call i64 @gp_rt_print_string(i8* %t13)
+  %t14 = call i64 @gp.count(i64 0, i64 10, i64 3)
+  %t15 = call i8* @gp_rt_str_int(i64 %t14)
+  %t16 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([18 x i8], [18 x i8]* @.str.4, i64 0, i64 0), i8* %t15)
+  call i64 @gp_rt_print_string(i8* %t16)
+  store i64 0, i64* %v.k
+  %t17 = sub nsw i64 0, 2
+  %t18 = sub nsw i64 0, %t17
+  store i64 0, i64* %v.i
+  br label %for.cond.1
+
+for.cond.1:
+  %t19 = load i64, i64* %v.i
+  %t20 = icmp slt i64 %t19, 10
+  br i1 %t20, label %for.body.1, label %for.end.1
+
+for.body.1:
+  %t21 = load i64, i64* %v.k
+  %t22 = load i64, i64* %v.i
+  %t23 = add nsw i64 %t21, %t22
+  store i64 %t23, i64* %v.k
+  br label %for.step.1
+
+for.step.1:
+  %t24 = load i64, i64* %v.i
+  %t25 = add nsw i64 %t24, %t18
+  store i64 %t25, i64* %v.i
+  br label %for.cond.1, !llvm.loop !3
+
+for.end.1:
+  %t26 = load i64, i64* %v.k
+  %t27 = call i8* @gp_rt_str_int(i64 %t26)
+  %t28 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([29 x i8], [29 x i8]* @.str.5, i64 0, i64 0), i8* %t27)
+  call i64 @gp_rt_print_string(i8* %t28)
+  store i64 0, i64* %v.total
+  %t29 = load i64, i64* %v.down
+  %t30 = call i8* @llvm.stacksave()
+  %t31 = alloca { i64, i64, i64* }
+  %t32 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t31, i32 0, i32 0
+  store i64 100000, i64* %t32
+  %t33 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t31, i32 0, i32 1
+  store i64 %t29, i64* %t33
+  %t34 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t31, i32 0, i32 2
+  store i64* %v.total, i64** %t34
+  %t35 = bitcast { i64, i64, i64* }* %t31 to i8*
+  call void @gp_rt_parallel_for(i64 100000, i64 0, i64 %t29, void (i8*, i64, i64)* @gp.main.parallel.2, i8* %t35)
+  call void @llvm.stackrestore(i8* %t30)
+  %t36 = load i64, i64* %v.total
+  %t37 = call i8* @gp_rt_str_int(i64 %t36)
+  %t38 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([29 x i8], [29 x i8]* @.str.6, i64 0, i64 0), i8* %t37)
+  call i64 @gp_rt_print_string(i8* %t38)
+  %t39 = trunc i64 0 to i32
+  ret i32 %t39
+}
+
+; parallel for i in main
+define internal void @gp.main.parallel.2(i8* %env, i64 %first, i64 %last) #0 {
+entry:
+  %env.fields = bitcast i8* %env to { i64, i64, i64* }*
+  %env.start = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 0
+  %start = load i64, i64* %env.start
+  %env.step = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 1
+  %step = load i64, i64* %env.step
+  %slot.total = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 2
+  %sum.total = load i64*, i64** %slot.total
+  %v.total = alloca i64
+  store i64 0, i64* %v.total
+  %v.i.1 = alloca i64
+  %iteration = alloca i64
+  store i64 %first, i64* %iteration
+  br label %chunk.cond.3
+
+chunk.cond.3:
+  %t0 = load i64, i64* %iteration
+  %t1 = icmp slt i64 %t0, %last
+  br i1 %t1, label %chunk.body.3, label %chunk.end.3
+
+chunk.body.3:
+  %t2 = mul nsw i64 %t0, %step
+  %t3 = add nsw i64 %start, %t2
+  store i64 %t3, i64* %v.i.1
+  %t4 = load i64, i64* %v.i.1
+  %t5 = load i64, i64* %v.total
+  %t6 = add nsw i64 %t5, %t4
+  store i64 %t6, i64* %v.total
+  br label %chunk.step.3
+
+chunk.step.3:
+  %t7 = load i64, i64* %iteration
+  %t8 = add nsw i64 %t7, 1
+  store i64 %t8, i64* %iteration
+  br label %chunk.cond.3, !llvm.loop !4
+
+chunk.end.3:
+  %t9 = load i64, i64* %v.total
+  atomicrmw add i64* %sum.total, i64 %t9 monotonic
+  ret void
+}
+
+@.str.0 = private unnamed_addr constant [29 x i8] c"\E2\86\95\EF\B8\8F GPLANG Loop Direction\00"
+@.str.1 = private unnamed_addr constant [18 x i8] c"range(0, 5, -1): \00"
+@.str.2 = private unnamed_addr constant [19 x i8] c"range(0, -5, -1): \00"
+@.str.3 = private unnamed_addr constant [19 x i8] c"range(10, 0, -3): \00"
+@.str.4 = private unnamed_addr constant [18 x i8] c"range(0, 10, 3): \00"
+@.str.5 = private unnamed_addr constant [29 x i8] c"Sum of range(0, 10, -(-2)): \00"
+@.str.6 = private unnamed_addr constant [29 x i8] c"Parallel sum counting down: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0, !1}
+!3 = distinct !{!3, !0, !1}
+!4 = distinct !{!4, !0, !1}
@@ -0,0 +1,241 @@
+# GPLANG Generated Assembly
+# Module: loop_direction
+# Source: ../../examples/basic/loop_direction.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+count:
+    # 15 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -48(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lcount.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq %rdi, -24(%rbp)
+    movq $0, -32(%rbp)
+    movq -8(%rbp), %rcx
+    movq -16(%rbp), %rsi
+    movq -24(%rbp), %rdi
+    testq %rdi, %rdi
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %r8
+    movq %rcx, -40(%rbp)
+.Lcount.for.cond0:
+    movq -40(%rbp), %rcx
+    testq %r8, %r8
+    jne .Lcount.for.up4
+    jmp .Lcount.for.down5
+.Lcount.for.body1:
+    movq -32(%rbp), %r9
+    leaq 1(%r9), %rbx
+    movq %rbx, -32(%rbp)
+.Lcount.for.step2:
+    movq -40(%rbp), %r9
+    leaq (%r9,%rdi), %rbx
+    movq %rbx, -40(%rbp)
+    jmp .Lcount.for.cond0
+.Lcount.for.end3:
+    movq -32(%rbp), %r9
+    movq %r9, %rax
+    # Function epilogue
+    movq -48(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lcount.for.up4:
+    cmpq %rsi, %rcx
+    jl .Lcount.for.body1
+    jmp .Lcount.for.end3
+.Lcount.for.down5:
+    cmpq %rsi, %rcx
+    jg .Lcount.for.body1
+    jmp .Lcount.for.end3
+
+main:
+    # 56 values in registers, 0 spilled, 80-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $80, %rsp
+    movq %rbx, -48(%rbp)
+    movq %r12, -56(%rbp)
+    movq %r13, -64(%rbp)
+    movq %r14, -72(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ecx, %ecx
+    subq $1, %rcx
+    movq %rcx, -8(%rbp)
+    leaq .LC1(%rip), %rbx
+    movq -8(%rbp), %rcx
+    xorl %edi, %edi
+    movq $5, %rsi
+    movq %rcx, %rdx
+    call count
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+    xorl %ecx, %ecx
+    subq $5, %rcx
+    movq -8(%rbp), %rsi
+    xorl %edi, %edi
+    movq %rsi, %rdx
+    movq %rcx, %rsi
+    call count
+    movq %rax, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC3(%rip), %rbx
+    xorl %ecx, %ecx
+    subq $3, %rcx
+    movq $10, %rdi
+    xorl %esi, %esi
+    movq %rcx, %rdx
+    call count
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC4(%rip), %rbx
+    xorl %edi, %edi
+    movq $10, %rsi
+    movq $3, %rdx
+    call count
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -16(%rbp)
+    xorl %ecx, %ecx
+    subq $2, %rcx
+    xorl %esi, %esi
+    subq %rcx, %rsi
+    movq $0, -24(%rbp)
+.Lmain.for.cond0:
+    movq -24(%rbp), %rcx
+    cmpq $10, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rdi
+    leaq (%rcx,%rdi), %r8
+    movq %r8, -16(%rbp)
+.Lmain.for.step2:
+    movq -24(%rbp), %rcx
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, -24(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC5(%rip), %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -32(%rbp)
+    movq -8(%rbp), %rbx
+    testq %rbx, %rbx
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %r12
+    movq $100000, -40(%rbp)
+.Lmain.for.cond4:
+    movq -40(%rbp), %r13
+    testq %r12, %r12
+    jne .Lmain.for.up8
+    jmp .Lmain.for.down9
+.Lmain.for.body5:
+    movq -40(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -32(%rbp)
+.Lmain.for.step6:
+    movq -40(%rbp), %rcx
+    leaq (%rcx,%rbx), %rsi
+    movq %rsi, -40(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC6(%rip), %r14
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %r14, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -48(%rbp), %rbx
+    movq -56(%rbp), %r12
+    movq -64(%rbp), %r13
+    movq -72(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lmain.for.up8:
+    testq %r13, %r13
+    jl .Lmain.for.body5
+    jmp .Lmain.for.end7
+.Lmain.for.down9:
+    testq %r13, %r13
+    jg .Lmain.for.body5
+    jmp .Lmain.for.end7
+
+.section .rodata
+.LC0:
+    .string "\342\206\225\357\270\217 GPLANG Loop Direction"
+.LC1:
+    .string "range(0, 5, -1): "
+.LC2:
+    .string "range(0, -5, -1): "
+.LC3:
+    .string "range(10, 0, -3): "
+.LC4:
+    .string "range(0, 10, 3): "
+.LC5:
+    .string "Sum of range(0, 10, -(-2)): "
+.LC6:
+    .string "Parallel sum counting down: "
+
+.section .note.GNU-stack,"",@progbits
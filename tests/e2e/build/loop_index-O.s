@@ -0,0 +1,264 @@
+# GPLANG Generated Assembly
+# Module: loop_index
+# Source: ../../examples/basic/loop_index.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+main:
+    # 81 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    movq %r14, -32(%rbp)
+    movq %r15, -40(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %r13d, %r13d
+    xorl %ebx, %ebx
+    xorl %r12d, %r12d
+.Lmain.for.cond0:
+    cmpq $9, %r12
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    jmp .Lmain.for.cond4.vec.ph
+.Lmain.for.step2:
+    leaq 1(%r12), %rcx
+    leaq 12(%r13), %rsi
+    movq %rsi, %r13
+    movq %r14, %rbx
+    movq %rcx, %r12
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %r15
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r15, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    movq $15, %rdi
+    xorl %ecx, %ecx
+    movq $3, %rsi
+    jmp .Lmain.for.cond8
+.Lmain.for.cond4.vec.ph:
+    xorl %r11d, %r11d
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movq %r13, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm5
+    movq $108, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm6
+    movdqa %xmm2, %xmm7
+    xorl %r8d, %r8d
+    movdqa %xmm4, %xmm8
+.Lmain.for.cond4.vec:
+    leaq 1(%r8), %r9
+    cmpq $12, %r9
+    jge .Lmain.for.cond4.vec.end
+.Lmain.for.cond4.vec.body:
+    movdqa %xmm5, %xmm2
+    paddq %xmm7, %xmm2
+    movdqa %xmm6, %xmm4
+    psubq %xmm2, %xmm4
+    movdqa %xmm2, %xmm0
+    psrlq $32, %xmm0
+    pmuludq %xmm4, %xmm0
+    movdqa %xmm4, %xmm1
+    psrlq $32, %xmm1
+    pmuludq %xmm2, %xmm1
+    paddq %xmm1, %xmm0
+    psllq $32, %xmm0
+    movdqa %xmm2, %xmm1
+    pmuludq %xmm4, %xmm1
+    paddq %xmm1, %xmm0
+    movdqa %xmm0, %xmm9
+    movdqa %xmm8, %xmm2
+    paddq %xmm9, %xmm2
+    movdqa %xmm7, %xmm4
+    paddq %xmm3, %xmm4
+    leaq 2(%r8), %r9
+    movdqa %xmm4, %xmm7
+    movq %r9, %r8
+    movdqa %xmm2, %xmm8
+    jmp .Lmain.for.cond4.vec
+.Lmain.for.cond4.vec.end:
+    movdqa %xmm8, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %r9
+    leaq (%rbx,%r9), %r15
+    movq %r15, %r14
+    movq %r8, %r9
+.Lmain.for.cond4:
+    cmpq $12, %r9
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    leaq (%r13,%r9), %r8
+    movq $108, %rbx
+    subq %r8, %rbx
+    movq %r8, %r15
+    imulq %rbx, %r15
+    leaq (%r14,%r15), %r8
+.Lmain.for.step6:
+    leaq 1(%r9), %rbx
+    movq %r8, %r14
+    movq %rbx, %r9
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    jmp .Lmain.for.step2
+.Lmain.for.cond8:
+    cmpq $300, %rsi
+    jge .Lmain.for.end11
+.Lmain.for.body9:
+    leaq 24(%rdi), %r8
+    leaq (%rcx,%r8), %r9
+.Lmain.for.step10:
+    leaq 7(%rsi), %r8
+    leaq 35(%rdi), %rbx
+    movq %rbx, %rdi
+    movq %r9, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.for.cond8
+.Lmain.for.end11:
+    leaq .LC2(%rip), %rbx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $440, %rdi
+    xorl %ecx, %ecx
+    movq $40, %rsi
+.Lmain.for.cond12:
+    testq %rsi, %rsi
+    jle .Lmain.for.end15
+.Lmain.for.body13:
+    leaq (%rcx,%rdi), %r8
+.Lmain.for.step14:
+    leaq -3(%rsi), %r9
+    leaq -33(%rdi), %rbx
+    movq %rbx, %rdi
+    movq %r8, %rcx
+    movq %r9, %rsi
+    jmp .Lmain.for.cond12
+.Lmain.for.end15:
+    leaq .LC3(%rip), %rbx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %esi, %esi
+    movabsq $0, %rcx
+.Lmain.for.cond16:
+    cmpq $10, %rsi
+    jge .Lmain.for.end19
+.Lmain.for.body17:
+    cvtsi2sdq %rsi, %xmm0
+    movabsq $4591870180066957722, %r11
+    movq %r11, %xmm1
+    mulsd %xmm1, %xmm0
+    movq %xmm0, %rdi
+    movq %rcx, %xmm0
+    movq %rdi, %xmm1
+    addsd %xmm1, %xmm0
+    movq %xmm0, %r8
+.Lmain.for.step18:
+    leaq 1(%rsi), %rdi
+    movq %r8, %rcx
+    movq %rdi, %rsi
+    jmp .Lmain.for.cond16
+.Lmain.for.end19:
+    leaq .LC4(%rip), %rbx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC5(%rip), %rcx
+    leaq .LC6(%rip), %rbx
+    xorl %r12d, %r12d
+    movq %rcx, %r13
+.Lmain.while.cond20:
+    cmpq $4, %r12
+    jge .Lmain.while.end22
+.Lmain.while.body21:
+    movq %r13, %rdi
+    movq %rbx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq 1(%r12), %rsi
+    movq %rsi, %r12
+    movq %rcx, %r13
+    jmp .Lmain.while.cond20
+.Lmain.while.end22:
+    leaq .LC7(%rip), %rcx
+    movq %rcx, %rdi
+    movq %r13, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq -40(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\242 GPLANG Loop Index"
+.LC1:
+    .string "Grid checksum: "
+.LC2:
+    .string "Stepped: "
+.LC3:
+    .string "Falling: "
+.LC4:
+    .string "Fractions: "
+.LC5:
+    .string ""
+.LC6:
+    .string "ab"
+.LC7:
+    .string "Label: "
+
+.section .note.GNU-stack,"",@progbits
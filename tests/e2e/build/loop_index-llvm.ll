@@ -0,0 +1,245 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'loop_index'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.width = alloca i64
+  %v.height = alloca i64
+  %v.checksum = alloca i64
+  %v.row = alloca i64
+  %v.col = alloca i64
+  %v.index = alloca i64
+  %v.stepped = alloca i64
+  %v.i = alloca i64
+  %v.falling = alloca i64
+  %v.j = alloca i64
+  %v.scale = alloca double
+  %v.fractions = alloca double
+  %v.k = alloca i64
+  %v.n = alloca i64
+  %v.label = alloca i8*
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([23 x i8], [23 x i8]* @.str.0, i64 0, i64 0))
+  store i64 12, i64* %v.width
+  store i64 9, i64* %v.height
+  store i64 0, i64* %v.checksum
+  %t0 = load i64, i64* %v.height
+  store i64 0, i64* %v.row
+  br label %for.cond.0
+
+for.cond.0:
+  %t1 = load i64, i64* %v.row
+  %t2 = icmp slt i64 %t1, %t0
+  br i1 %t2, label %for.body.0, label %for.end.0
+
+for.body.0:
+  %t3 = load i64, i64* %v.width
+  store i64 0, i64* %v.col
+  br label %for.cond.1
+
+for.cond.1:
+  %t4 = load i64, i64* %v.col
+  %t5 = icmp slt i64 %t4, %t3
+  br i1 %t5, label %for.body.1, label %for.end.1
+
+for.body.1:
+  %t6 = load i64, i64* %v.row
+  %t7 = load i64, i64* %v.width
+  %t8 = mul nsw i64 %t6, %t7
+  %t9 = load i64, i64* %v.col
+  %t10 = add nsw i64 %t8, %t9
+  store i64 %t10, i64* %v.index
+  %t11 = load i64, i64* %v.index
+  %t12 = load i64, i64* %v.width
+  %t13 = load i64, i64* %v.height
+  %t14 = mul nsw i64 %t12, %t13
+  %t15 = load i64, i64* %v.index
+  %t16 = sub nsw i64 %t14, %t15
+  %t17 = mul nsw i64 %t11, %t16
+  %t18 = load i64, i64* %v.checksum
+  %t19 = add nsw i64 %t18, %t17
+  store i64 %t19, i64* %v.checksum
+  br label %for.step.1
+
+for.step.1:
+  %t20 = load i64, i64* %v.col
+  %t21 = add nsw i64 %t20, 1
+  store i64 %t21, i64* %v.col
+  br label %for.cond.1, !llvm.loop !3
+
+for.end.1:
+  br label %for.step.0
+
+for.step.0:
+  %t22 = load i64, i64* %v.row
+  %t23 = add nsw i64 %t22, 1
+  store i64 %t23, i64* %v.row
+  br label %for.cond.0, !llvm.loop !2
+
+for.end.0:
+  %t24 = load i64, i64* %v.checksum
+  %t25 = call i8* @gp_rt_str_int(i64 %t24)
+  %t26 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @.str.1, i64 0, i64 0), i8* %t25)
+  call i64 @gp_rt_print_string(i8* %t26)
+  store i64 0, i64* %v.stepped
+  store i64 3, i64* %v.i
+  br label %for.cond.2
+
+for.cond.2:
+  %t27 = load i64, i64* %v.i
+  %t28 = icmp slt i64 %t27, 300
+  br i1 %t28, label %for.body.2, label %for.end.2
+
+for.body.2:
+  %t29 = load i64, i64* %v.i
+  %t30 = mul nsw i64 %t29, 5
+  %t31 = load i64, i64* %v.width
+  %t32 = mul nsw i64 %t31, 2
+  %t33 = add nsw i64 %t30, %t32
+  %t34 = load i64, i64* %v.stepped
+  %t35 = add nsw i64 %t34, %t33
+  store i64 %t35, i64* %v.stepped
+  br label %for.step.2
+
+for.step.2:
+  %t36 = load i64, i64* %v.i
+  %t37 = add nsw i64 %t36, 7
+  store i64 %t37, i64* %v.i
+  br label %for.cond.2, !llvm.loop !4
+
+for.end.2:
+  %t38 = load i64, i64* %v.stepped
+  %t39 = call i8* @gp_rt_str_int(i64 %t38)
+  %t40 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([10 x i8], [10 x i8]* @.str.2, i64 0, i64 0), i8* %t39)
+  call i64 @gp_rt_print_string(i8* %t40)
+  store i64 0, i64* %v.falling
+  %t41 = sub nsw i64 0, 3
+  store i64 40, i64* %v.j
+  br label %for.cond.3
+
+for.cond.3:
+  %t42 = load i64, i64* %v.j
+  %t43 = icmp sgt i64 %t42, 0
+  br i1 %t43, label %for.body.3, label %for.end.3
+
+for.body.3:
+  %t44 = load i64, i64* %v.j
+  %t45 = mul nsw i64 %t44, 11
+  %t46 = load i64, i64* %v.falling
+  %t47 = add nsw i64 %t46, %t45
+  store i64 %t47, i64* %v.falling
+  br label %for.step.3
+
+for.step.3:
+  %t48 = load i64, i64* %v.j
+  %t49 = add nsw i64 %t48, %t41
+  store i64 %t49, i64* %v.j
+  br label %for.cond.3, !llvm.loop !5
+
+for.end.3:
+  %t50 = load i64, i64* %v.falling
+  %t51 = call i8* @gp_rt_str_int(i64 %t50)
+  %t52 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([10 x i8], [10 x i8]* @.str.3, i64 0, i64 0), i8* %t51)
+  call i64 @gp_rt_print_string(i8* %t52)
+  store double 0x3FB999999999999A, double* %v.scale
+  store double 0x0000000000000000, double* %v.fractions
+  store i64 0, i64* %v.k
+  br label %for.cond.4
+
+for.cond.4:
+  %t53 = load i64, i64* %v.k
+  %t54 = icmp slt i64 %t53, 10
+  br i1 %t54, label %for.body.4, label %for.end.4
+
+for.body.4:
+  %t55 = load i64, i64* %v.k
+  %t56 = load double, double* %v.scale
+  %t57 = sitofp i64 %t55 to double
+  %t58 = fmul double %t57, %t56
+  %t59 = load double, double* %v.fractions
+  %t60 = fadd double %t59, %t58
+  store double %t60, double* %v.fractions
+  br label %for.step.4
+
+for.step.4:
+  %t61 = load i64, i64* %v.k
+  %t62 = add nsw i64 %t61, 1
+  store i64 %t62, i64* %v.k
+  br label %for.cond.4, !llvm.loop !6
+
+for.end.4:
+  %t63 = load double, double* %v.fractions
+  %t64 = call i8* @gp_rt_str_float(double %t63)
+  %t65 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([12 x i8], [12 x i8]* @.str.4, i64 0, i64 0), i8* %t64)
+  call i64 @gp_rt_print_string(i8* %t65)
+  store i64 0, i64* %v.n
+  store i8* getelementptr inbounds ([1 x i8], [1 x i8]* @.str.5, i64 0, i64 0), i8** %v.label
+  br label %while.cond.5
+
+while.cond.5:
+  %t66 = load i64, i64* %v.n
+  %t67 = icmp slt i64 %t66, 4
+  br i1 %t67, label %while.body.5, label %while.end.5
+
+while.body.5:
+  %t68 = load i8*, i8** %v.label
+  %t69 = call i8* @gp_rt_string_concat(i8* %t68, i8* getelementptr inbounds ([3 x i8], [3 x i8]* @.str.6, i64 0, i64 0))
+  store i8* %t69, i8** %v.label
+  %t70 = load i64, i64* %v.n
+  %t71 = add nsw i64 %t70, 1
+  store i64 %t71, i64* %v.n
+  br label %while.cond.5
+
+while.end.5:
+  %t72 = load i8*, i8** %v.label
+  %t73 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([8 x i8], [8 x i8]* @.str.7, i64 0, i64 0), i8* %t72)
+  call i64 @gp_rt_print_string(i8* %t73)
+  %t74 = trunc i64 0 to i32
+  ret i32 %t74
+}
+
+@.str.0 = private unnamed_addr constant [23 x i8] c"\F0\9F\94\A2 GPLANG Loop Index\00"
+@.str.1 = private unnamed_addr constant [16 x i8] c"Grid checksum: \00"
+@.str.2 = private unnamed_addr constant [10 x i8] c"Stepped: \00"
+@.str.3 = private unnamed_addr constant [10 x i8] c"Falling: \00"
+@.str.4 = private unnamed_addr constant [12 x i8] c"Fractions: \00"
+@.str.5 = private unnamed_addr constant [1 x i8] c"\00"
+@.str.6 = private unnamed_addr constant [3 x i8] c"ab\00"
+@.str.7 = private unnamed_addr constant [8 x i8] c"Label: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0}
+!3 = distinct !{!3, !0, !1}
+!4 = distinct !{!4, !0, !1}
+!5 = distinct !{!5, !0, !1}
+!6 = distinct !{!6, !0}
@@ -0,0 +1,235 @@
+# GPLANG Generated Assembly
+# Module: loop_index
+# Source: ../../examples/basic/loop_index.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+main:
+    # 89 values in registers, 0 spilled, 144-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $144, %rsp
+    movq %rbx, -128(%rbp)
+    movq %r12, -136(%rbp)
+    movq %r13, -144(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $12, -8(%rbp)
+    movq $9, -16(%rbp)
+    movq $0, -24(%rbp)
+    movq -16(%rbp), %rbx
+    movq $0, -32(%rbp)
+.Lmain.for.cond0:
+    movq -32(%rbp), %rcx
+    cmpq %rbx, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -8(%rbp), %r12
+    movq $0, -40(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.step2:
+    movq -32(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -32(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %r13
+    movq -24(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %r13, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -56(%rbp)
+    movq $3, -64(%rbp)
+    jmp .Lmain.for.cond8
+.Lmain.for.cond4:
+    movq -40(%rbp), %rcx
+    cmpq %r12, %rcx
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    movq -32(%rbp), %rcx
+    movq -8(%rbp), %rsi
+    movq %rcx, %rdi
+    imulq %rsi, %rdi
+    movq -40(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq %rsi, -48(%rbp)
+    movq %rsi, %rcx
+    movq -8(%rbp), %rsi
+    movq -16(%rbp), %rdi
+    movq %rsi, %r8
+    imulq %rdi, %r8
+    movq -48(%rbp), %rsi
+    movq %r8, %rdi
+    subq %rsi, %rdi
+    movq %rcx, %rsi
+    imulq %rdi, %rsi
+    movq -24(%rbp), %rcx
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, -24(%rbp)
+.Lmain.for.step6:
+    movq -40(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -40(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    jmp .Lmain.for.step2
+.Lmain.for.cond8:
+    movq -64(%rbp), %rcx
+    cmpq $300, %rcx
+    jge .Lmain.for.end11
+.Lmain.for.body9:
+    movq -64(%rbp), %rcx
+    leaq (%rcx,%rcx,4), %rsi
+    movq -8(%rbp), %rcx
+    leaq (%rsi,%rcx,2), %rcx
+    movq -56(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -56(%rbp)
+.Lmain.for.step10:
+    movq -64(%rbp), %rcx
+    leaq 7(%rcx), %rsi
+    movq %rsi, -64(%rbp)
+    jmp .Lmain.for.cond8
+.Lmain.for.end11:
+    leaq .LC2(%rip), %rbx
+    movq -56(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -72(%rbp)
+    xorl %ecx, %ecx
+    subq $3, %rcx
+    movq $40, -80(%rbp)
+.Lmain.for.cond12:
+    movq -80(%rbp), %rsi
+    testq %rsi, %rsi
+    jle .Lmain.for.end15
+.Lmain.for.body13:
+    movq -80(%rbp), %rsi
+    movq %rsi, %rdi
+    imulq $11, %rdi
+    movq -72(%rbp), %rsi
+    leaq (%rsi,%rdi), %r8
+    movq %r8, -72(%rbp)
+.Lmain.for.step14:
+    movq -80(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -80(%rbp)
+    jmp .Lmain.for.cond12
+.Lmain.for.end15:
+    leaq .LC3(%rip), %rbx
+    movq -72(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movabsq $4591870180066957722, %rcx
+    movq %rcx, -88(%rbp)
+    movabsq $0, %rcx
+    movq %rcx, -96(%rbp)
+    movq $0, -104(%rbp)
+.Lmain.for.cond16:
+    movq -104(%rbp), %rcx
+    cmpq $10, %rcx
+    jge .Lmain.for.end19
+.Lmain.for.body17:
+    movq -104(%rbp), %rcx
+    movq -88(%rbp), %rsi
+    cvtsi2sdq %rcx, %xmm0
+    movq %rsi, %xmm1
+    mulsd %xmm1, %xmm0
+    movq %xmm0, %rdi
+    movq -96(%rbp), %rcx
+    movq %rcx, %xmm0
+    movq %rdi, %xmm1
+    addsd %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, -96(%rbp)
+.Lmain.for.step18:
+    movq -104(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -104(%rbp)
+    jmp .Lmain.for.cond16
+.Lmain.for.end19:
+    leaq .LC4(%rip), %rbx
+    movq -96(%rbp), %rcx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -112(%rbp)
+    leaq .LC5(%rip), %rcx
+    movq %rcx, -120(%rbp)
+.Lmain.while.cond20:
+    movq -112(%rbp), %rcx
+    cmpq $4, %rcx
+    jge .Lmain.while.end22
+.Lmain.while.body21:
+    movq -120(%rbp), %rcx
+    leaq .LC6(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    movq %rdi, -120(%rbp)
+    movq -112(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -112(%rbp)
+    jmp .Lmain.while.cond20
+.Lmain.while.end22:
+    leaq .LC7(%rip), %rcx
+    movq -120(%rbp), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -128(%rbp), %rbx
+    movq -136(%rbp), %r12
+    movq -144(%rbp), %r13
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\242 GPLANG Loop Index"
+.LC1:
+    .string "Grid checksum: "
+.LC2:
+    .string "Stepped: "
+.LC3:
+    .string "Falling: "
+.LC4:
+    .string "Fractions: "
+.LC5:
+    .string ""
+.LC6:
+    .string "ab"
+.LC7:
+    .string "Label: "
+
+.section .note.GNU-stack,"",@progbits
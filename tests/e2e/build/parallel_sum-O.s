@@ -0,0 +1,244 @@
+# GPLANG Generated Assembly
+# Module: parallel_sum
+# Source: ../../examples/basic/parallel_sum.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+is_prime:
+    # 8 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_prime.entry:
+    cmpq $2, %rcx
+    jge .Lis_prime.if.end1
+.Lis_prime.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_prime.if.end1:
+    movq $2, %rsi
+.Lis_prime.while.cond2:
+    movq %rsi, %rdi
+    imulq %rsi, %rdi
+    cmpq %rcx, %rdi
+    jg .Lis_prime.while.end4
+.Lis_prime.while.body3:
+    movq %rcx, %rax
+    cqto 
+    idivq %rsi
+    movq %rdx, %rdi
+    testq %rdi, %rdi
+    je .Lis_prime.if.then5
+    jmp .Lis_prime.if.end6
+.Lis_prime.while.end4:
+    movq $1, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_prime.if.then5:
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_prime.if.end6:
+    leaq 1(%rsi), %rdi
+    movq %rdi, %rsi
+    jmp .Lis_prime.while.cond2
+
+main:
+    # 53 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    movq %r14, -32(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.for.cond0.vec.ph:
+    movq $1, %r11
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movdqa %xmm2, %xmm5
+    movq $1, %rcx
+    movdqa %xmm4, %xmm6
+.Lmain.for.cond0.vec:
+    leaq 1(%rcx), %rsi
+    cmpq $1000001, %rsi
+    jge .Lmain.for.cond0.vec.end
+.Lmain.for.cond0.vec.body:
+    movdqa %xmm6, %xmm2
+    paddq %xmm5, %xmm2
+    movdqa %xmm5, %xmm4
+    paddq %xmm3, %xmm4
+    leaq 2(%rcx), %rsi
+    movdqa %xmm4, %xmm5
+    movq %rsi, %rcx
+    movdqa %xmm2, %xmm6
+    jmp .Lmain.for.cond0.vec
+.Lmain.for.cond0.vec.end:
+    movdqa %xmm6, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, %rdi
+    movq %rcx, %r8
+.Lmain.for.cond0:
+    cmpq $1000001, %r8
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    leaq (%rsi,%r8), %rcx
+.Lmain.for.step2:
+    leaq 1(%r8), %rdi
+    movq %rcx, %rsi
+    movq %rdi, %r8
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ebx, %ebx
+    xorl %r12d, %r12d
+.Lmain.for.cond4:
+    cmpq $200000, %r12
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+.Lmain.is_prime.0.entry:
+    cmpq $2, %r12
+    jge .Lmain.is_prime.0.if.end1
+.Lmain.is_prime.0.if.then0:
+    xorl %ecx, %ecx
+    jmp .Lmain.is_prime.0.ret
+.Lmain.is_prime.0.if.end1:
+    movq $2, %rsi
+.Lmain.is_prime.0.while.cond2:
+    movq %rsi, %rdi
+    imulq %rsi, %rdi
+    cmpq %r12, %rdi
+    jg .Lmain.is_prime.0.while.end4
+.Lmain.is_prime.0.while.body3:
+    movq %r12, %rax
+    cqto 
+    idivq %rsi
+    movq %rdx, %rdi
+    testq %rdi, %rdi
+    je .Lmain.is_prime.0.if.then5
+    jmp .Lmain.is_prime.0.if.end6
+.Lmain.is_prime.0.while.end4:
+    movq $1, %rcx
+    jmp .Lmain.is_prime.0.ret
+.Lmain.is_prime.0.if.then5:
+    xorl %ecx, %ecx
+    jmp .Lmain.is_prime.0.ret
+.Lmain.is_prime.0.if.end6:
+    leaq 1(%rsi), %rdi
+    movq %rdi, %rsi
+    jmp .Lmain.is_prime.0.while.cond2
+.Lmain.is_prime.0.ret:
+    testq %rcx, %rcx
+    jne .Lmain.if.then8
+    movq %rbx, %r13
+    jmp .Lmain.if.end9
+.Lmain.for.step6:
+    leaq 1(%r12), %rcx
+    movq %r13, %rbx
+    movq %rcx, %r12
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC2(%rip), %r14
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r14, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    movq $1000, %rsi
+    movabsq $0, %rcx
+    jmp .Lmain.for.cond10
+.Lmain.if.then8:
+    leaq 1(%rbx), %rdi
+    movq %rdi, %r13
+.Lmain.if.end9:
+    jmp .Lmain.for.step6
+.Lmain.for.cond10:
+    testq %rsi, %rsi
+    jle .Lmain.for.end13
+.Lmain.for.body11:
+    cvtsi2sdq %rsi, %xmm0
+    movabsq $4602678819172646912, %r11
+    movq %r11, %xmm1
+    mulsd %xmm1, %xmm0
+    movq %xmm0, %rdi
+    movq %rdi, %xmm0
+    movq %rdi, %xmm1
+    mulsd %xmm1, %xmm0
+    movq %xmm0, %r8
+    movq %rcx, %xmm0
+    movq %r8, %xmm1
+    addsd %xmm1, %xmm0
+    movq %xmm0, %rdi
+.Lmain.for.step12:
+    leaq -1(%rsi), %r8
+    movq %rdi, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.for.cond10
+.Lmain.for.end13:
+    leaq .LC3(%rip), %rbx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\247\256 GPLANG Parallel Sum"
+.LC1:
+    .string "Sum of 1..1000000: "
+.LC2:
+    .string "Primes below 200000: "
+.LC3:
+    .string "Sum of squares: "
+
+.section .note.GNU-stack,"",@progbits
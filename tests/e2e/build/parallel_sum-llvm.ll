@@ -0,0 +1,297 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'parallel_sum'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: is_prime
+define internal i1 @gp.is_prime(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  %v.d = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp slt i64 %t0, 2
+  br i1 %t1, label %if.then.0, label %if.end.0
+
+if.then.0:
+  ret i1 false
+
+if.end.0:
+  store i64 2, i64* %v.d
+  br label %while.cond.1
+
+while.cond.1:
+  %t2 = load i64, i64* %v.d
+  %t3 = load i64, i64* %v.d
+  %t4 = mul nsw i64 %t2, %t3
+  %t5 = load i64, i64* %v.n
+  %t6 = icmp sle i64 %t4, %t5
+  br i1 %t6, label %while.body.1, label %while.end.1
+
+while.body.1:
+  %t7 = load i64, i64* %v.n
+  %t8 = load i64, i64* %v.d
+  %t9 = srem i64 %t7, %t8
+  %t10 = icmp eq i64 %t9, 0
+  br i1 %t10, label %if.then.2, label %if.end.2
+
+if.then.2:
+  ret i1 false
+
+if.end.2:
+  %t11 = load i64, i64* %v.d
+  %t12 = add nsw i64 %t11, 1
+  store i64 %t12, i64* %v.d
+  br label %while.cond.1
+
+while.end.1:
+  ret i1 true
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.total = alloca i64
+  %v.i = alloca i64
+  %v.primes = alloca i64
+  %v.n = alloca i64
+  %v.squares = alloca double
+  %v.k = alloca i64
+  %v.x = alloca double
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([25 x i8], [25 x i8]* @.str.0, i64 0, i64 0))
+  store i64 0, i64* %v.total
+  %t0 = call i8* @llvm.stacksave()
+  %t1 = alloca { i64, i64, i64* }
+  %t2 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t1, i32 0, i32 0
+  store i64 1, i64* %t2
+  %t3 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t1, i32 0, i32 1
+  store i64 1, i64* %t3
+  %t4 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t1, i32 0, i32 2
+  store i64* %v.total, i64** %t4
+  %t5 = bitcast { i64, i64, i64* }* %t1 to i8*
+  call void @gp_rt_parallel_for(i64 1, i64 1000001, i64 1, void (i8*, i64, i64)* @gp.main.parallel.3, i8* %t5)
+  call void @llvm.stackrestore(i8* %t0)
+  %t6 = load i64, i64* %v.total
+  %t7 = call i8* @gp_rt_str_int(i64 %t6)
+  %t8 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([20 x i8], [20 x i8]* @.str.1, i64 0, i64 0), i8* %t7)
+  call i64 @gp_rt_print_string(i8* %t8)
+  store i64 0, i64* %v.primes
+  %t9 = call i8* @llvm.stacksave()
+  %t10 = alloca { i64, i64, i64* }
+  %t11 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t10, i32 0, i32 0
+  store i64 0, i64* %t11
+  %t12 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t10, i32 0, i32 1
+  store i64 1, i64* %t12
+  %t13 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t10, i32 0, i32 2
+  store i64* %v.primes, i64** %t13
+  %t14 = bitcast { i64, i64, i64* }* %t10 to i8*
+  call void @gp_rt_parallel_for(i64 0, i64 200000, i64 1, void (i8*, i64, i64)* @gp.main.parallel.5, i8* %t14)
+  call void @llvm.stackrestore(i8* %t9)
+  %t15 = load i64, i64* %v.primes
+  %t16 = call i8* @gp_rt_str_int(i64 %t15)
+  %t17 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([22 x i8], [22 x i8]* @.str.2, i64 0, i64 0), i8* %t16)
+  call i64 @gp_rt_print_string(i8* %t17)
+  store double 0x0000000000000000, double* %v.squares
+  %t18 = sub nsw i64 0, 1
+  %t19 = call i8* @llvm.stacksave()
+  %t20 = alloca { i64, i64, double* }
+  %t21 = getelementptr inbounds { i64, i64, double* }, { i64, i64, double* }* %t20, i32 0, i32 0
+  store i64 1000, i64* %t21
+  %t22 = getelementptr inbounds { i64, i64, double* }, { i64, i64, double* }* %t20, i32 0, i32 1
+  store i64 %t18, i64* %t22
+  %t23 = getelementptr inbounds { i64, i64, double* }, { i64, i64, double* }* %t20, i32 0, i32 2
+  store double* %v.squares, double** %t23
+  %t24 = bitcast { i64, i64, double* }* %t20 to i8*
+  call void @gp_rt_parallel_for(i64 1000, i64 0, i64 %t18, void (i8*, i64, i64)* @gp.main.parallel.8, i8* %t24)
+  call void @llvm.stackrestore(i8* %t19)
+  %t25 = load double, double* %v.squares
+  %t26 = call i8* @gp_rt_str_float(double %t25)
+  %t27 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([17 x i8], [17 x i8]* @.str.3, i64 0, i64 0), i8* %t26)
+  call i64 @gp_rt_print_string(i8* %t27)
+  %t28 = trunc i64 0 to i32
+  ret i32 %t28
+}
+
+; parallel for i in main
+define internal void @gp.main.parallel.3(i8* %env, i64 %first, i64 %last) #0 {
+entry:
+  %env.fields = bitcast i8* %env to { i64, i64, i64* }*
+  %env.start = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 0
+  %start = load i64, i64* %env.start
+  %env.step = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 1
+  %step = load i64, i64* %env.step
+  %slot.total = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 2
+  %sum.total = load i64*, i64** %slot.total
+  %v.total = alloca i64
+  store i64 0, i64* %v.total
+  %v.i = alloca i64
+  %iteration = alloca i64
+  store i64 %first, i64* %iteration
+  br label %chunk.cond.4
+
+chunk.cond.4:
+  %t0 = load i64, i64* %iteration
+  %t1 = icmp slt i64 %t0, %last
+  br i1 %t1, label %chunk.body.4, label %chunk.end.4
+
+chunk.body.4:
+  %t2 = mul nsw i64 %t0, %step
+  %t3 = add nsw i64 %start, %t2
+  store i64 %t3, i64* %v.i
+  %t4 = load i64, i64* %v.i
+  %t5 = load i64, i64* %v.total
+  %t6 = add nsw i64 %t5, %t4
+  store i64 %t6, i64* %v.total
+  br label %chunk.step.4
+
+chunk.step.4:
+  %t7 = load i64, i64* %iteration
+  %t8 = add nsw i64 %t7, 1
+  store i64 %t8, i64* %iteration
+  br label %chunk.cond.4, !llvm.loop !2
+
+chunk.end.4:
+  %t9 = load i64, i64* %v.total
+  atomicrmw add i64* %sum.total, i64 %t9 monotonic
+  ret void
+}
+
+; parallel for n in main
+define internal void @gp.main.parallel.5(i8* %env, i64 %first, i64 %last) #0 {
+entry:
+  %env.fields = bitcast i8* %env to { i64, i64, i64* }*
+  %env.start = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 0
+  %start = load i64, i64* %env.start
+  %env.step = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 1
+  %step = load i64, i64* %env.step
+  %slot.primes = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 2
+  %sum.primes = load i64*, i64** %slot.primes
+  %v.primes = alloca i64
+  store i64 0, i64* %v.primes
+  %v.n = alloca i64
+  %iteration = alloca i64
+  store i64 %first, i64* %iteration
+  br label %chunk.cond.6
+
+chunk.cond.6:
+  %t0 = load i64, i64* %iteration
+  %t1 = icmp slt i64 %t0, %last
+  br i1 %t1, label %chunk.body.6, label %chunk.end.6
+
+chunk.body.6:
+  %t2 = mul nsw i64 %t0, %step
+  %t3 = add nsw i64 %start, %t2
+  store i64 %t3, i64* %v.n
+  %t4 = load i64, i64* %v.n
+  %t5 = call i1 @gp.is_prime(i64 %t4)
+  br i1 %t5, label %if.then.7, label %if.end.7
+
+if.then.7:
+  %t6 = load i64, i64* %v.primes
+  %t7 = add nsw i64 %t6, 1
+  store i64 %t7, i64* %v.primes
+  br label %if.end.7
+
+if.end.7:
+  br label %chunk.step.6
+
+chunk.step.6:
+  %t8 = load i64, i64* %iteration
+  %t9 = add nsw i64 %t8, 1
+  store i64 %t9, i64* %iteration
+  br label %chunk.cond.6, !llvm.loop !3
+
+chunk.end.6:
+  %t10 = load i64, i64* %v.primes
+  atomicrmw add i64* %sum.primes, i64 %t10 monotonic
+  ret void
+}
+
+; parallel for k in main
+define internal void @gp.main.parallel.8(i8* %env, i64 %first, i64 %last) #0 {
+entry:
+  %env.fields = bitcast i8* %env to { i64, i64, double* }*
+  %env.start = getelementptr inbounds { i64, i64, double* }, { i64, i64, double* }* %env.fields, i32 0, i32 0
+  %start = load i64, i64* %env.start
+  %env.step = getelementptr inbounds { i64, i64, double* }, { i64, i64, double* }* %env.fields, i32 0, i32 1
+  %step = load i64, i64* %env.step
+  %slot.squares = getelementptr inbounds { i64, i64, double* }, { i64, i64, double* }* %env.fields, i32 0, i32 2
+  %sum.squares = load double*, double** %slot.squares
+  %v.squares = alloca double
+  store double 0.0, double* %v.squares
+  %v.k = alloca i64
+  %v.x = alloca double
+  %iteration = alloca i64
+  store i64 %first, i64* %iteration
+  br label %chunk.cond.9
+
+chunk.cond.9:
+  %t0 = load i64, i64* %iteration
+  %t1 = icmp slt i64 %t0, %last
+  br i1 %t1, label %chunk.body.9, label %chunk.end.9
+
+chunk.body.9:
+  %t2 = mul nsw i64 %t0, %step
+  %t3 = add nsw i64 %start, %t2
+  store i64 %t3, i64* %v.k
+  %t4 = load i64, i64* %v.k
+  %t5 = sitofp i64 %t4 to double
+  %t6 = fmul double %t5, 0x3FE0000000000000
+  store double %t6, double* %v.x
+  %t7 = load double, double* %v.squares
+  %t8 = load double, double* %v.x
+  %t9 = load double, double* %v.x
+  %t10 = fmul double %t8, %t9
+  %t11 = fadd double %t7, %t10
+  store double %t11, double* %v.squares
+  br label %chunk.step.9
+
+chunk.step.9:
+  %t12 = load i64, i64* %iteration
+  %t13 = add nsw i64 %t12, 1
+  store i64 %t13, i64* %iteration
+  br label %chunk.cond.9, !llvm.loop !4
+
+chunk.end.9:
+  %t14 = load double, double* %v.squares
+  atomicrmw fadd double* %sum.squares, double %t14 monotonic
+  ret void
+}
+
+@.str.0 = private unnamed_addr constant [25 x i8] c"\F0\9F\A7\AE GPLANG Parallel Sum\00"
+@.str.1 = private unnamed_addr constant [20 x i8] c"Sum of 1..1000000: \00"
+@.str.2 = private unnamed_addr constant [22 x i8] c"Primes below 200000: \00"
+@.str.3 = private unnamed_addr constant [17 x i8] c"Sum of squares: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0, !1}
+!3 = distinct !{!3, !0}
+!4 = distinct !{!4, !0}
@@ -0,0 +1,201 @@
+# GPLANG Generated Assembly
+# Module: parallel_sum
+# Source: ../../examples/basic/parallel_sum.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+is_prime:
+    # 14 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_prime.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $2, %rcx
+    jge .Lis_prime.if.end1
+.Lis_prime.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_prime.if.end1:
+    movq $2, -16(%rbp)
+.Lis_prime.while.cond2:
+    movq -16(%rbp), %rcx
+    movq -16(%rbp), %rsi
+    movq %rcx, %rdi
+    imulq %rsi, %rdi
+    movq -8(%rbp), %rcx
+    cmpq %rcx, %rdi
+    jg .Lis_prime.while.end4
+.Lis_prime.while.body3:
+    movq -8(%rbp), %rcx
+    movq -16(%rbp), %rsi
+    movq %rcx, %rax
+    cqto 
+    idivq %rsi
+    movq %rdx, %rdi
+    testq %rdi, %rdi
+    je .Lis_prime.if.then5
+    jmp .Lis_prime.if.end6
+.Lis_prime.while.end4:
+    movq $1, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_prime.if.then5:
+    xorl %eax, %eax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_prime.if.end6:
+    movq -16(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+    jmp .Lis_prime.while.cond2
+
+main:
+    # 46 values in registers, 0 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -64(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -8(%rbp)
+    movq $1, -16(%rbp)
+.Lmain.for.cond0:
+    movq -16(%rbp), %rcx
+    cmpq $1000001, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -16(%rbp), %rcx
+    movq -8(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -8(%rbp)
+.Lmain.for.step2:
+    movq -16(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -24(%rbp)
+    movq $0, -32(%rbp)
+.Lmain.for.cond4:
+    movq -32(%rbp), %rcx
+    cmpq $200000, %rcx
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call is_prime
+    movq %rax, %rsi
+    testq %rsi, %rsi
+    jne .Lmain.if.then8
+    jmp .Lmain.if.end9
+.Lmain.for.step6:
+    movq -32(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -32(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC2(%rip), %rbx
+    movq -24(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movabsq $0, %rcx
+    movq %rcx, -40(%rbp)
+    xorl %ecx, %ecx
+    subq $1, %rcx
+    movq $1000, -48(%rbp)
+    jmp .Lmain.for.cond10
+.Lmain.if.then8:
+    movq -24(%rbp), %rsi
+    leaq 1(%rsi), %rdi
+    movq %rdi, -24(%rbp)
+.Lmain.if.end9:
+    jmp .Lmain.for.step6
+.Lmain.for.cond10:
+    movq -48(%rbp), %rsi
+    testq %rsi, %rsi
+    jle .Lmain.for.end13
+.Lmain.for.body11:
+    movq -48(%rbp), %rsi
+    movabsq $4602678819172646912, %rdi
+    cvtsi2sdq %rsi, %xmm0
+    movq %rdi, %xmm1
+    mulsd %xmm1, %xmm0
+    movq %xmm0, %r8
+    movq %r8, -56(%rbp)
+    movq -40(%rbp), %rsi
+    movq -56(%rbp), %rdi
+    movq -56(%rbp), %r8
+    movq %rdi, %xmm0
+    movq %r8, %xmm1
+    mulsd %xmm1, %xmm0
+    movq %xmm0, %r9
+    movq %rsi, %xmm0
+    movq %r9, %xmm1
+    addsd %xmm1, %xmm0
+    movq %xmm0, %rdi
+    movq %rdi, -40(%rbp)
+.Lmain.for.step12:
+    movq -48(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -48(%rbp)
+    jmp .Lmain.for.cond10
+.Lmain.for.end13:
+    leaq .LC3(%rip), %rbx
+    movq -40(%rbp), %rcx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -64(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\247\256 GPLANG Parallel Sum"
+.LC1:
+    .string "Sum of 1..1000000: "
+.LC2:
+    .string "Primes below 200000: "
+.LC3:
+    .string "Sum of squares: "
+
+.section .note.GNU-stack,"",@progbits
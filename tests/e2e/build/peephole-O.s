@@ -0,0 +1,282 @@
+# GPLANG Generated Assembly
+# Module: peephole
+# Source: ../../examples/basic/peephole.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+scale:
+    # 6 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lscale.entry:
+    movq %rcx, %rsi
+    shlq $3, %rsi
+    movq %rcx, %rdi
+    leaq (%rsi,%rdi), %r8
+    movq %rcx, %rsi
+    shlq $6, %rsi
+    movq %r8, %rcx
+    subq %rsi, %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+pick:
+    # 5 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lpick.entry:
+    cmpq %rsi, %rcx
+    jle .Lpick.if.else1
+.Lpick.if.then0:
+    movq %rcx, %rdi
+    shlq $4, %rdi
+    movq %rdi, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lpick.if.else1:
+    movq %rsi, %rcx
+    shlq $1, %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+mix:
+    # 21 values in registers, 3 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -32(%rbp)
+    movq %r12, -40(%rbp)
+    movq %r13, -48(%rbp)
+    movq %r14, -56(%rbp)
+    movq %r15, -64(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lmix.entry:
+    leaq 1(%rcx), %rsi
+    movq %rcx, %rdi
+    shlq $1, %rdi
+    movq %rcx, %r8
+    shlq $2, %r8
+    leaq 3(%rcx), %r9
+    movq %rcx, %rbx
+    shlq $5, %rbx
+    leaq 5(%rcx), %r12
+    movq %rcx, %r13
+    shlq $7, %r13
+    leaq 7(%rcx), %r14
+    leaq (%rcx,%rcx,2), %r15
+    movq %rcx, %r10
+    addq $9, %r10
+    movq %r10, -8(%rbp)
+    leaq (%rcx,%rcx,4), %r10
+    movq %r10, -16(%rbp)
+    movq %rcx, %r10
+    addq $11, %r10
+    movq %r10, -24(%rbp)
+    leaq (%rsi,%rdi), %rcx
+    leaq (%rcx,%r8), %rsi
+    leaq (%rsi,%r9), %rcx
+    leaq (%rcx,%rbx), %rsi
+    leaq (%rsi,%r12), %rcx
+    leaq (%rcx,%r13), %rsi
+    leaq (%rsi,%r14), %rcx
+    leaq (%rcx,%r15), %rsi
+    movq %rsi, %rcx
+    addq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    addq -16(%rbp), %rsi
+    movq %rsi, %rcx
+    addq -24(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq -32(%rbp), %rbx
+    movq -40(%rbp), %r12
+    movq -48(%rbp), %r13
+    movq -56(%rbp), %r14
+    movq -64(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 47 values in registers, 14 spilled, 160-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $160, %rsp
+    movq %rbx, -120(%rbp)
+    movq %r12, -128(%rbp)
+    movq %r13, -136(%rbp)
+    movq %r14, -144(%rbp)
+    movq %r15, -152(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %edi, %edi
+    xorl %r8d, %r8d
+    xorl %r9d, %r9d
+    xorl %ebx, %ebx
+    movq $0, -8(%rbp)
+    xorl %esi, %esi
+.Lmain.for.cond0:
+    cmpq $1000, %rsi
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+.Lmain.scale.2.entry:
+    leaq (%rdi,%r8), %r12
+    movq %r12, %r13
+    subq %r9, %r13
+.Lmain.scale.2.ret:
+    movq -8(%rbp), %r12
+    addq %r13, %r12
+.Lmain.pick.1.entry:
+    cmpq $500, %rsi
+    jle .Lmain.pick.1.if.else1
+.Lmain.pick.1.if.then0:
+    movq %rbx, %r13
+    jmp .Lmain.pick.1.ret
+.Lmain.pick.1.if.else1:
+    movq $1000, %r13
+.Lmain.pick.1.ret:
+    leaq (%r12,%r13), %r14
+.Lmain.for.step2:
+    leaq 1(%rsi), %r12
+    leaq 8(%rdi), %r13
+    leaq 1(%r8), %r15
+    leaq 64(%r9), %rcx
+    movq %rbx, %r10
+    addq $16, %r10
+    movq %r10, -16(%rbp)
+    movq %r13, %rdi
+    movq %r15, %r8
+    movq %rcx, %r9
+    movq -16(%rbp), %rbx
+    movq %r14, -8(%rbp)
+    movq %r12, %rsi
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq -8(%rbp), %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %edi, %edi
+    xorl %r8d, %r8d
+    movq $0, -112(%rbp)
+    movq $0, -104(%rbp)
+    movq $0, -96(%rbp)
+    movq $0, -88(%rbp)
+    movq $0, -24(%rbp)
+    xorl %esi, %esi
+.Lmain.for.cond4:
+    cmpq $100, %rsi
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+.Lmain.mix.0.entry:
+    movq %rsi, %r10
+    addq $1, %r10
+    movq %r10, -80(%rbp)
+    movq %rdi, %r10
+    addq $2, %r10
+    movq %r10, -72(%rbp)
+    movq %r8, %r10
+    addq $4, %r10
+    movq %r10, -64(%rbp)
+    movq -112(%rbp), %r10
+    addq $32, %r10
+    movq %r10, -32(%rbp)
+    movq -104(%rbp), %r10
+    addq $128, %r10
+    movq %r10, -40(%rbp)
+    movq -96(%rbp), %r10
+    addq $3, %r10
+    movq %r10, -48(%rbp)
+    movq -88(%rbp), %r10
+    addq $5, %r10
+    movq %r10, -56(%rbp)
+    leaq 3(%rsi), %rcx
+    leaq 5(%rsi), %r15
+    leaq 7(%rsi), %r14
+    leaq 9(%rsi), %r13
+    leaq 11(%rsi), %r12
+    movq -80(%rbp), %rbx
+    addq %rdi, %rbx
+    leaq (%rbx,%r8), %r9
+    leaq (%r9,%rcx), %rbx
+    movq %rbx, %rcx
+    addq -112(%rbp), %rcx
+    leaq (%rcx,%r15), %r9
+    movq %r9, %rcx
+    addq -104(%rbp), %rcx
+    leaq (%rcx,%r14), %r9
+    movq %r9, %rcx
+    addq -96(%rbp), %rcx
+    leaq (%rcx,%r13), %r9
+    movq %r9, %rcx
+    addq -88(%rbp), %rcx
+    leaq (%rcx,%r12), %r9
+.Lmain.mix.0.ret:
+    movq -24(%rbp), %rcx
+    addq %r9, %rcx
+.Lmain.for.step6:
+    movq -72(%rbp), %rdi
+    movq -64(%rbp), %r8
+    movq -32(%rbp), %r10
+    movq %r10, -112(%rbp)
+    movq -40(%rbp), %r10
+    movq %r10, -104(%rbp)
+    movq -48(%rbp), %r10
+    movq %r10, -96(%rbp)
+    movq -56(%rbp), %r10
+    movq %r10, -88(%rbp)
+    movq %rcx, -24(%rbp)
+    movq -80(%rbp), %rsi
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC2(%rip), %rbx
+    movq -24(%rbp), %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -120(%rbp), %rbx
+    movq -128(%rbp), %r12
+    movq -136(%rbp), %r13
+    movq -144(%rbp), %r14
+    movq -152(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\247 GPLANG Peephole"
+.LC1:
+    .string "Scaled and picked: "
+.LC2:
+    .string "Mixed: "
+
+.section .note.GNU-stack,"",@progbits
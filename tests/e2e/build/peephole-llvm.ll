@@ -0,0 +1,232 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'peephole'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: scale
+define internal i64 @gp.scale(i64 %p.x) #0 {
+entry:
+  %v.x = alloca i64
+  store i64 %p.x, i64* %v.x
+  %t0 = load i64, i64* %v.x
+  %t1 = mul nsw i64 %t0, 8
+  %t2 = load i64, i64* %v.x
+  %t3 = mul nsw i64 %t2, 1
+  %t4 = add nsw i64 %t1, %t3
+  %t5 = load i64, i64* %v.x
+  %t6 = mul nsw i64 %t5, 64
+  %t7 = sub nsw i64 %t4, %t6
+  ret i64 %t7
+}
+
+; Function: pick
+define internal i64 @gp.pick(i64 %p.a, i64 %p.b) #0 {
+entry:
+  %v.a = alloca i64
+  %v.b = alloca i64
+  store i64 %p.a, i64* %v.a
+  store i64 %p.b, i64* %v.b
+  %t0 = load i64, i64* %v.a
+  %t1 = load i64, i64* %v.b
+  %t2 = icmp sgt i64 %t0, %t1
+  br i1 %t2, label %if.then.0, label %if.else.0
+
+if.then.0:
+  %t3 = load i64, i64* %v.a
+  %t4 = mul nsw i64 %t3, 16
+  ret i64 %t4
+
+if.else.0:
+  %t5 = load i64, i64* %v.b
+  %t6 = mul nsw i64 %t5, 2
+  ret i64 %t6
+
+if.end.0:
+  ret i64 0
+}
+
+; Function: mix
+define internal i64 @gp.mix(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  %v.a = alloca i64
+  %v.b = alloca i64
+  %v.c = alloca i64
+  %v.d = alloca i64
+  %v.e = alloca i64
+  %v.f = alloca i64
+  %v.g = alloca i64
+  %v.h = alloca i64
+  %v.i = alloca i64
+  %v.j = alloca i64
+  %v.k = alloca i64
+  %v.l = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = add nsw i64 %t0, 1
+  store i64 %t1, i64* %v.a
+  %t2 = load i64, i64* %v.n
+  %t3 = mul nsw i64 %t2, 2
+  store i64 %t3, i64* %v.b
+  %t4 = load i64, i64* %v.n
+  %t5 = mul nsw i64 %t4, 4
+  store i64 %t5, i64* %v.c
+  %t6 = load i64, i64* %v.n
+  %t7 = add nsw i64 %t6, 3
+  store i64 %t7, i64* %v.d
+  %t8 = load i64, i64* %v.n
+  %t9 = mul nsw i64 %t8, 32
+  store i64 %t9, i64* %v.e
+  %t10 = load i64, i64* %v.n
+  %t11 = add nsw i64 %t10, 5
+  store i64 %t11, i64* %v.f
+  %t12 = load i64, i64* %v.n
+  %t13 = mul nsw i64 %t12, 128
+  store i64 %t13, i64* %v.g
+  %t14 = load i64, i64* %v.n
+  %t15 = add nsw i64 %t14, 7
+  store i64 %t15, i64* %v.h
+  %t16 = load i64, i64* %v.n
+  %t17 = mul nsw i64 %t16, 3
+  store i64 %t17, i64* %v.i
+  %t18 = load i64, i64* %v.n
+  %t19 = add nsw i64 %t18, 9
+  store i64 %t19, i64* %v.j
+  %t20 = load i64, i64* %v.n
+  %t21 = mul nsw i64 %t20, 5
+  store i64 %t21, i64* %v.k
+  %t22 = load i64, i64* %v.n
+  %t23 = add nsw i64 %t22, 11
+  store i64 %t23, i64* %v.l
+  %t24 = load i64, i64* %v.a
+  %t25 = load i64, i64* %v.b
+  %t26 = add nsw i64 %t24, %t25
+  %t27 = load i64, i64* %v.c
+  %t28 = add nsw i64 %t26, %t27
+  %t29 = load i64, i64* %v.d
+  %t30 = add nsw i64 %t28, %t29
+  %t31 = load i64, i64* %v.e
+  %t32 = add nsw i64 %t30, %t31
+  %t33 = load i64, i64* %v.f
+  %t34 = add nsw i64 %t32, %t33
+  %t35 = load i64, i64* %v.g
+  %t36 = add nsw i64 %t34, %t35
+  %t37 = load i64, i64* %v.h
+  %t38 = add nsw i64 %t36, %t37
+  %t39 = load i64, i64* %v.i
+  %t40 = add nsw i64 %t38, %t39
+  %t41 = load i64, i64* %v.j
+  %t42 = add nsw i64 %t40, %t41
+  %t43 = load i64, i64* %v.k
+  %t44 = add nsw i64 %t42, %t43
+  %t45 = load i64, i64* %v.l
+  %t46 = add nsw i64 %t44, %t45
+  ret i64 %t46
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.total = alloca i64
+  %v.n = alloca i64
+  %v.mixed = alloca i64
+  %v.n.1 = alloca i64
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([21 x i8], [21 x i8]* @.str.0, i64 0, i64 0))
+  store i64 0, i64* %v.total
+  store i64 0, i64* %v.n
+  br label %for.cond.1
+
+for.cond.1:
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp slt i64 %t0, 1000
+  br i1 %t1, label %for.body.1, label %for.end.1
+
+for.body.1:
+  %t2 = load i64, i64* %v.total
+  %t3 = load i64, i64* %v.n
+  %t4 = call i64 @gp.scale(i64 %t3)
+  %t5 = add nsw i64 %t2, %t4
+  %t6 = load i64, i64* %v.n
+  %t7 = call i64 @gp.pick(i64 %t6, i64 500)
+  %t8 = add nsw i64 %t5, %t7
+  store i64 %t8, i64* %v.total
+  br label %for.step.1
+
+for.step.1:
+  %t9 = load i64, i64* %v.n
+  %t10 = add nsw i64 %t9, 1
+  store i64 %t10, i64* %v.n
+  br label %for.cond.1, !llvm.loop !2
+
+for.end.1:
+  %t11 = load i64, i64* %v.total
+  %t12 = call i8* @gp_rt_str_int(i64 %t11)
+  %t13 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([20 x i8], [20 x i8]* @.str.1, i64 0, i64 0), i8* %t12)
+  call i64 @gp_rt_print_string(i8* %t13)
+  store i64 0, i64* %v.mixed
+  store i64 0, i64* %v.n.1
+  br label %for.cond.2
+
+for.cond.2:
+  %t14 = load i64, i64* %v.n.1
+  %t15 = icmp slt i64 %t14, 100
+  br i1 %t15, label %for.body.2, label %for.end.2
+
+for.body.2:
+  %t16 = load i64, i64* %v.mixed
+  %t17 = load i64, i64* %v.n.1
+  %t18 = call i64 @gp.mix(i64 %t17)
+  %t19 = add nsw i64 %t16, %t18
+  store i64 %t19, i64* %v.mixed
+  br label %for.step.2
+
+for.step.2:
+  %t20 = load i64, i64* %v.n.1
+  %t21 = add nsw i64 %t20, 1
+  store i64 %t21, i64* %v.n.1
+  br label %for.cond.2, !llvm.loop !3
+
+for.end.2:
+  %t22 = load i64, i64* %v.mixed
+  %t23 = call i8* @gp_rt_str_int(i64 %t22)
+  %t24 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([8 x i8], [8 x i8]* @.str.2, i64 0, i64 0), i8* %t23)
+  call i64 @gp_rt_print_string(i8* %t24)
+  %t25 = trunc i64 0 to i32
+  ret i32 %t25
+}
+
+@.str.0 = private unnamed_addr constant [21 x i8] c"\F0\9F\94\A7 GPLANG Peephole\00"
+@.str.1 = private unnamed_addr constant [20 x i8] c"Scaled and picked: \00"
+@.str.2 = private unnamed_addr constant [8 x i8] c"Mixed: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0}
+!3 = distinct !{!3, !0}
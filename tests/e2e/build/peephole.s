@@ -0,0 +1,244 @@
+# GPLANG Generated Assembly
+# Module: peephole
+# Source: ../../examples/basic/peephole.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+scale:
+    # 9 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lscale.entry:
+    movq %rcx, -8(%rbp)
+    movq %rcx, %rsi
+    shlq $3, %rsi
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    leaq (%rsi,%rdi), %rcx
+    movq -8(%rbp), %rsi
+    movq %rsi, %rdi
+    shlq $6, %rdi
+    movq %rcx, %rsi
+    subq %rdi, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+pick:
+    # 9 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lpick.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq -8(%rbp), %rcx
+    movq -16(%rbp), %rsi
+    cmpq %rsi, %rcx
+    jle .Lpick.if.else1
+.Lpick.if.then0:
+    movq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $4, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lpick.if.else1:
+    movq -16(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lpick.if.end2:
+    xorl %eax, %eax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+mix:
+    # 48 values in registers, 0 spilled, 112-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $112, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lmix.entry:
+    movq %rcx, -8(%rbp)
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, -24(%rbp)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $2, %rsi
+    movq %rsi, -32(%rbp)
+    movq -8(%rbp), %rcx
+    leaq 3(%rcx), %rsi
+    movq %rsi, -40(%rbp)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $5, %rsi
+    movq %rsi, -48(%rbp)
+    movq -8(%rbp), %rcx
+    leaq 5(%rcx), %rsi
+    movq %rsi, -56(%rbp)
+    movq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $7, %rsi
+    movq %rsi, -64(%rbp)
+    movq -8(%rbp), %rcx
+    leaq 7(%rcx), %rsi
+    movq %rsi, -72(%rbp)
+    movq -8(%rbp), %rcx
+    leaq (%rcx,%rcx,2), %rsi
+    movq %rsi, -80(%rbp)
+    movq -8(%rbp), %rcx
+    leaq 9(%rcx), %rsi
+    movq %rsi, -88(%rbp)
+    movq -8(%rbp), %rcx
+    leaq (%rcx,%rcx,4), %rsi
+    movq %rsi, -96(%rbp)
+    movq -8(%rbp), %rcx
+    leaq 11(%rcx), %rsi
+    movq %rsi, -104(%rbp)
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq -32(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -40(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq -48(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -56(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq -64(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -72(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq -80(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -88(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq -96(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -104(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 31 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -40(%rbp)
+    movq %r12, -48(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -8(%rbp)
+    movq $0, -16(%rbp)
+.Lmain.for.cond0:
+    movq -16(%rbp), %rcx
+    cmpq $1000, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call scale
+    movq %rax, %rsi
+    leaq (%rbx,%rsi), %r12
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    movq $500, %rsi
+    call pick
+    movq %rax, %rsi
+    leaq (%r12,%rsi), %rcx
+    movq %rcx, -8(%rbp)
+.Lmain.for.step2:
+    movq -16(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -16(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -24(%rbp)
+    movq $0, -32(%rbp)
+.Lmain.for.cond4:
+    movq -32(%rbp), %rcx
+    cmpq $100, %rcx
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    movq -24(%rbp), %rbx
+    movq -32(%rbp), %rcx
+    movq %rcx, %rdi
+    call mix
+    movq %rax, %rsi
+    leaq (%rbx,%rsi), %rcx
+    movq %rcx, -24(%rbp)
+.Lmain.for.step6:
+    movq -32(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -32(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC2(%rip), %rbx
+    movq -24(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -40(%rbp), %rbx
+    movq -48(%rbp), %r12
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\247 GPLANG Peephole"
+.LC1:
+    .string "Scaled and picked: "
+.LC2:
+    .string "Mixed: "
+
+.section .note.GNU-stack,"",@progbits
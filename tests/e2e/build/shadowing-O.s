@@ -0,0 +1,330 @@
+# GPLANG Generated Assembly
+# Module: shadowing
+# Source: ../../examples/basic/shadowing.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+scale:
+    # 3 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lscale.entry:
+    cmpq $10, %rcx
+    jle .Lscale.if.end1
+.Lscale.if.then0:
+    movq $20, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lscale.if.end1:
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+main:
+    # 89 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ebx, %ebx
+.Lmain.while.cond0:
+    cmpq $3, %rbx
+    jge .Lmain.while.end2
+.Lmain.while.body1:
+    leaq 8(%rbx), %rcx
+    movq %rcx, %rbx
+    jmp .Lmain.while.cond0
+.Lmain.while.end2:
+    leaq .LC1(%rip), %r12
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r12, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC2(%rip), %r12
+    movq %rsi, %rdi
+    movq %r12, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r13
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    testq %rbx, %rbx
+    jle .Lmain.if.end4
+.Lmain.if.then3:
+    leaq .LC3(%rip), %r13
+    movabsq $4612811918334230528, %r11
+    movq %r11, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.if.end4:
+    leaq .LC4(%rip), %r13
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.for.cond5.vec.ph:
+    xorl %r11d, %r11d
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movq $100, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm5
+    movdqa %xmm2, %xmm6
+    xorl %ecx, %ecx
+    movdqa %xmm4, %xmm7
+.Lmain.for.cond5.vec:
+    leaq 1(%rcx), %rsi
+    cmpq $3, %rsi
+    jge .Lmain.for.cond5.vec.end
+.Lmain.for.cond5.vec.body:
+    movdqa %xmm6, %xmm2
+    paddq %xmm5, %xmm2
+    movdqa %xmm7, %xmm4
+    paddq %xmm2, %xmm4
+    movdqa %xmm6, %xmm2
+    paddq %xmm3, %xmm2
+    leaq 2(%rcx), %rsi
+    movdqa %xmm2, %xmm6
+    movq %rsi, %rcx
+    movdqa %xmm4, %xmm7
+    jmp .Lmain.for.cond5.vec
+.Lmain.for.cond5.vec.end:
+    movdqa %xmm7, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    leaq (%rbx,%rsi), %rdi
+    movq %rdi, %rbx
+    movq %rcx, %rsi
+.Lmain.for.cond5:
+    cmpq $3, %rsi
+    jge .Lmain.for.end8
+.Lmain.for.body6:
+    leaq 100(%rsi), %rcx
+    leaq (%rbx,%rcx), %rdi
+.Lmain.for.step7:
+    leaq 1(%rsi), %rcx
+    movq %rdi, %rbx
+    movq %rcx, %rsi
+    jmp .Lmain.for.cond5
+.Lmain.for.end8:
+    leaq .LC5(%rip), %r13
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    movq %r12, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r13
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.for.cond9.vec.ph:
+    xorl %r11d, %r11d
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm5
+    movdqa %xmm2, %xmm6
+    xorl %ecx, %ecx
+    movdqa %xmm4, %xmm7
+.Lmain.for.cond9.vec:
+    leaq 1(%rcx), %rsi
+    cmpq $1000, %rsi
+    jge .Lmain.for.cond9.vec.end
+.Lmain.for.cond9.vec.body:
+    movdqa %xmm6, %xmm0
+    psrlq $32, %xmm0
+    pmuludq %xmm5, %xmm0
+    movdqa %xmm5, %xmm1
+    psrlq $32, %xmm1
+    pmuludq %xmm6, %xmm1
+    paddq %xmm1, %xmm0
+    psllq $32, %xmm0
+    movdqa %xmm6, %xmm1
+    pmuludq %xmm5, %xmm1
+    paddq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movdqa %xmm7, %xmm4
+    paddq %xmm2, %xmm4
+    movdqa %xmm6, %xmm2
+    paddq %xmm3, %xmm2
+    leaq 2(%rcx), %rsi
+    movdqa %xmm2, %xmm6
+    movq %rsi, %rcx
+    movdqa %xmm4, %xmm7
+    jmp .Lmain.for.cond9.vec
+.Lmain.for.cond9.vec.end:
+    movdqa %xmm7, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, %rbx
+    movq %rdi, %r8
+    movq %rcx, %r9
+.Lmain.for.cond9:
+    cmpq $1000, %r9
+    jge .Lmain.for.end12
+.Lmain.for.body10:
+    leaq (%r8,%rbx), %rcx
+.Lmain.for.step11:
+    leaq 1(%r9), %rsi
+    leaq 2(%rbx), %rdi
+    movq %rdi, %rbx
+    movq %rcx, %r8
+    movq %rsi, %r9
+    jmp .Lmain.for.cond9
+.Lmain.for.end12:
+    leaq .LC6(%rip), %rbx
+    movq %r8, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC7(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC8(%rip), %rbx
+.Lmain.scale.1.entry:
+.Lmain.scale.1.if.end1:
+.Lmain.scale.1.ret:
+    movq $8, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC9(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+.Lmain.scale.0.entry:
+.Lmain.scale.0.if.then0:
+.Lmain.scale.0.ret:
+    movq $20, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\253\245 GPLANG Shadowing"
+.LC1:
+    .string "After while: x = "
+.LC2:
+    .string ", n = "
+.LC3:
+    .string "Inside if: x = "
+.LC4:
+    .string "After if: x = "
+.LC5:
+    .string "After for: x = "
+.LC6:
+    .string "Parallel total: "
+.LC7:
+    .string ", x = "
+.LC8:
+    .string "scale(4) = "
+.LC9:
+    .string ", scale(40) = "
+
+.section .note.GNU-stack,"",@progbits
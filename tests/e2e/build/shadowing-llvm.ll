@@ -0,0 +1,239 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'shadowing'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: scale
+define internal i64 @gp.scale(i64 %p.x) #0 {
+entry:
+  %v.x = alloca i64
+  %v.x.1 = alloca i64
+  store i64 %p.x, i64* %v.x
+  %t0 = load i64, i64* %v.x
+  %t1 = icmp sgt i64 %t0, 10
+  br i1 %t1, label %if.then.0, label %if.end.0
+
+if.then.0:
+  store i64 10, i64* %v.x.1
+  %t2 = load i64, i64* %v.x.1
+  %t3 = mul nsw i64 %t2, 2
+  ret i64 %t3
+
+if.end.0:
+  %t4 = load i64, i64* %v.x
+  %t5 = mul nsw i64 %t4, 2
+  ret i64 %t5
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.x = alloca i64
+  %v.n = alloca i64
+  %v.x.1 = alloca i64
+  %v.x.2 = alloca double
+  %v.i = alloca i64
+  %v.x.3 = alloca i64
+  %v.total = alloca i64
+  %v.i.1 = alloca i64
+  %v.x.4 = alloca i64
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([22 x i8], [22 x i8]* @.str.0, i64 0, i64 0))
+  store i64 1, i64* %v.x
+  store i64 0, i64* %v.n
+  br label %while.cond.1
+
+while.cond.1:
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp slt i64 %t0, 3
+  br i1 %t1, label %while.body.1, label %while.end.1
+
+while.body.1:
+  store i64 8, i64* %v.x.1
+  %t2 = load i64, i64* %v.n
+  %t3 = load i64, i64* %v.x.1
+  %t4 = add nsw i64 %t2, %t3
+  store i64 %t4, i64* %v.n
+  br label %while.cond.1
+
+while.end.1:
+  %t5 = load i64, i64* %v.x
+  %t6 = call i8* @gp_rt_str_int(i64 %t5)
+  %t7 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([18 x i8], [18 x i8]* @.str.1, i64 0, i64 0), i8* %t6)
+  %t8 = call i8* @gp_rt_string_concat(i8* %t7, i8* getelementptr inbounds ([7 x i8], [7 x i8]* @.str.2, i64 0, i64 0))
+  %t9 = load i64, i64* %v.n
+  %t10 = call i8* @gp_rt_str_int(i64 %t9)
+  %t11 = call i8* @gp_rt_string_concat(i8* %t8, i8* %t10)
+  call i64 @gp_rt_print_string(i8* %t11)
+  %t12 = load i64, i64* %v.n
+  %t13 = icmp sgt i64 %t12, 0
+  br i1 %t13, label %if.then.2, label %if.end.2
+
+if.then.2:
+  store double 0x4004000000000000, double* %v.x.2
+  %t14 = load double, double* %v.x.2
+  %t15 = call i8* @gp_rt_str_float(double %t14)
+  %t16 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @.str.3, i64 0, i64 0), i8* %t15)
+  call i64 @gp_rt_print_string(i8* %t16)
+  br label %if.end.2
+
+if.end.2:
+  %t17 = load i64, i64* %v.x
+  %t18 = call i8* @gp_rt_str_int(i64 %t17)
+  %t19 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([15 x i8], [15 x i8]* @.str.4, i64 0, i64 0), i8* %t18)
+  call i64 @gp_rt_print_string(i8* %t19)
+  store i64 0, i64* %v.i
+  br label %for.cond.3
+
+for.cond.3:
+  %t20 = load i64, i64* %v.i
+  %t21 = icmp slt i64 %t20, 3
+  br i1 %t21, label %for.body.3, label %for.end.3
+
+for.body.3:
+  %t22 = load i64, i64* %v.i
+  %t23 = add nsw i64 %t22, 100
+  store i64 %t23, i64* %v.x.3
+  %t24 = load i64, i64* %v.n
+  %t25 = load i64, i64* %v.x.3
+  %t26 = add nsw i64 %t24, %t25
+  store i64 %t26, i64* %v.n
+  br label %for.step.3
+
+for.step.3:
+  %t27 = load i64, i64* %v.i
+  %t28 = add nsw i64 %t27, 1
+  store i64 %t28, i64* %v.i
+  br label %for.cond.3, !llvm.loop !2
+
+for.end.3:
+  %t29 = load i64, i64* %v.x
+  %t30 = call i8* @gp_rt_str_int(i64 %t29)
+  %t31 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @.str.5, i64 0, i64 0), i8* %t30)
+  %t32 = call i8* @gp_rt_string_concat(i8* %t31, i8* getelementptr inbounds ([7 x i8], [7 x i8]* @.str.6, i64 0, i64 0))
+  %t33 = load i64, i64* %v.n
+  %t34 = call i8* @gp_rt_str_int(i64 %t33)
+  %t35 = call i8* @gp_rt_string_concat(i8* %t32, i8* %t34)
+  call i64 @gp_rt_print_string(i8* %t35)
+  store i64 0, i64* %v.total
+  %t36 = call i8* @llvm.stacksave()
+  %t37 = alloca { i64, i64, i64* }
+  %t38 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t37, i32 0, i32 0
+  store i64 0, i64* %t38
+  %t39 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t37, i32 0, i32 1
+  store i64 1, i64* %t39
+  %t40 = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %t37, i32 0, i32 2
+  store i64* %v.total, i64** %t40
+  %t41 = bitcast { i64, i64, i64* }* %t37 to i8*
+  call void @gp_rt_parallel_for(i64 0, i64 1000, i64 1, void (i8*, i64, i64)* @gp.main.parallel.4, i8* %t41)
+  call void @llvm.stackrestore(i8* %t36)
+  %t42 = load i64, i64* %v.total
+  %t43 = call i8* @gp_rt_str_int(i64 %t42)
+  %t44 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([17 x i8], [17 x i8]* @.str.7, i64 0, i64 0), i8* %t43)
+  %t45 = call i8* @gp_rt_string_concat(i8* %t44, i8* getelementptr inbounds ([7 x i8], [7 x i8]* @.str.8, i64 0, i64 0))
+  %t46 = load i64, i64* %v.x
+  %t47 = call i8* @gp_rt_str_int(i64 %t46)
+  %t48 = call i8* @gp_rt_string_concat(i8* %t45, i8* %t47)
+  call i64 @gp_rt_print_string(i8* %t48)
+  %t49 = call i64 @gp.scale(i64 4)
+  %t50 = call i8* @gp_rt_str_int(i64 %t49)
+  %t51 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([12 x i8], [12 x i8]* @.str.9, i64 0, i64 0), i8* %t50)
+  %t52 = call i8* @gp_rt_string_concat(i8* %t51, i8* getelementptr inbounds ([15 x i8], [15 x i8]* @.str.10, i64 0, i64 0))
+  %t53 = call i64 @gp.scale(i64 40)
+  %t54 = call i8* @gp_rt_str_int(i64 %t53)
+  %t55 = call i8* @gp_rt_string_concat(i8* %t52, i8* %t54)
+  call i64 @gp_rt_print_string(i8* %t55)
+  %t56 = trunc i64 0 to i32
+  ret i32 %t56
+}
+
+; parallel for i in main
+define internal void @gp.main.parallel.4(i8* %env, i64 %first, i64 %last) #0 {
+entry:
+  %env.fields = bitcast i8* %env to { i64, i64, i64* }*
+  %env.start = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 0
+  %start = load i64, i64* %env.start
+  %env.step = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 1
+  %step = load i64, i64* %env.step
+  %slot.total = getelementptr inbounds { i64, i64, i64* }, { i64, i64, i64* }* %env.fields, i32 0, i32 2
+  %sum.total = load i64*, i64** %slot.total
+  %v.total = alloca i64
+  store i64 0, i64* %v.total
+  %v.i.1 = alloca i64
+  %v.x.4 = alloca i64
+  %iteration = alloca i64
+  store i64 %first, i64* %iteration
+  br label %chunk.cond.5
+
+chunk.cond.5:
+  %t0 = load i64, i64* %iteration
+  %t1 = icmp slt i64 %t0, %last
+  br i1 %t1, label %chunk.body.5, label %chunk.end.5
+
+chunk.body.5:
+  %t2 = mul nsw i64 %t0, %step
+  %t3 = add nsw i64 %start, %t2
+  store i64 %t3, i64* %v.i.1
+  %t4 = load i64, i64* %v.i.1
+  %t5 = mul nsw i64 %t4, 2
+  store i64 %t5, i64* %v.x.4
+  %t6 = load i64, i64* %v.x.4
+  %t7 = load i64, i64* %v.total
+  %t8 = add nsw i64 %t7, %t6
+  store i64 %t8, i64* %v.total
+  br label %chunk.step.5
+
+chunk.step.5:
+  %t9 = load i64, i64* %iteration
+  %t10 = add nsw i64 %t9, 1
+  store i64 %t10, i64* %iteration
+  br label %chunk.cond.5, !llvm.loop !3
+
+chunk.end.5:
+  %t11 = load i64, i64* %v.total
+  atomicrmw add i64* %sum.total, i64 %t11 monotonic
+  ret void
+}
+
+@.str.0 = private unnamed_addr constant [22 x i8] c"\F0\9F\AB\A5 GPLANG Shadowing\00"
+@.str.1 = private unnamed_addr constant [18 x i8] c"After while: x = \00"
+@.str.2 = private unnamed_addr constant [7 x i8] c", n = \00"
+@.str.3 = private unnamed_addr constant [16 x i8] c"Inside if: x = \00"
+@.str.4 = private unnamed_addr constant [15 x i8] c"After if: x = \00"
+@.str.5 = private unnamed_addr constant [16 x i8] c"After for: x = \00"
+@.str.6 = private unnamed_addr constant [7 x i8] c", n = \00"
+@.str.7 = private unnamed_addr constant [17 x i8] c"Parallel total: \00"
+@.str.8 = private unnamed_addr constant [7 x i8] c", x = \00"
+@.str.9 = private unnamed_addr constant [12 x i8] c"scale(4) = \00"
+@.str.10 = private unnamed_addr constant [15 x i8] c", scale(40) = \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0, !1}
+!3 = distinct !{!3, !0, !1}
@@ -0,0 +1,249 @@
+# GPLANG Generated Assembly
+# Module: shadowing
+# Source: ../../examples/basic/shadowing.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+scale:
+    # 7 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lscale.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $10, %rcx
+    jle .Lscale.if.end1
+.Lscale.if.then0:
+    movq $10, -16(%rbp)
+    movq $10, %rcx
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lscale.if.end1:
+    movq -8(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 78 values in registers, 0 spilled, 80-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $80, %rsp
+    movq %rbx, -80(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $1, -8(%rbp)
+    movq $0, -16(%rbp)
+.Lmain.while.cond0:
+    movq -16(%rbp), %rcx
+    cmpq $3, %rcx
+    jge .Lmain.while.end2
+.Lmain.while.body1:
+    movq $8, -24(%rbp)
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, -16(%rbp)
+    jmp .Lmain.while.cond0
+.Lmain.while.end2:
+    leaq .LC1(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC2(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq -16(%rbp), %rcx
+    testq %rcx, %rcx
+    jle .Lmain.if.end4
+.Lmain.if.then3:
+    movabsq $4612811918334230528, %rcx
+    movq %rcx, -32(%rbp)
+    leaq .LC3(%rip), %rbx
+    movq -32(%rbp), %rcx
+    movq %rcx, %xmm0
+    call gp_rt_str_float@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.if.end4:
+    leaq .LC4(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -40(%rbp)
+.Lmain.for.cond5:
+    movq -40(%rbp), %rcx
+    cmpq $3, %rcx
+    jge .Lmain.for.end8
+.Lmain.for.body6:
+    movq -40(%rbp), %rcx
+    leaq 100(%rcx), %rsi
+    movq %rsi, -48(%rbp)
+    movq -16(%rbp), %rcx
+    movq -48(%rbp), %rsi
+    leaq (%rcx,%rsi), %rdi
+    movq %rdi, -16(%rbp)
+.Lmain.for.step7:
+    movq -40(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -40(%rbp)
+    jmp .Lmain.for.cond5
+.Lmain.for.end8:
+    leaq .LC5(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC2(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -56(%rbp)
+    movq $0, -64(%rbp)
+.Lmain.for.cond9:
+    movq -64(%rbp), %rcx
+    cmpq $1000, %rcx
+    jge .Lmain.for.end12
+.Lmain.for.body10:
+    movq -64(%rbp), %rcx
+    movq %rcx, %rsi
+    shlq $1, %rsi
+    movq %rsi, -72(%rbp)
+    movq %rsi, %rcx
+    movq -56(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -56(%rbp)
+.Lmain.for.step11:
+    movq -64(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -64(%rbp)
+    jmp .Lmain.for.cond9
+.Lmain.for.end12:
+    leaq .LC6(%rip), %rbx
+    movq -56(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC7(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC8(%rip), %rbx
+    movq $4, %rdi
+    call scale
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC9(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq $40, %rdi
+    call scale
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -80(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\253\245 GPLANG Shadowing"
+.LC1:
+    .string "After while: x = "
+.LC2:
+    .string ", n = "
+.LC3:
+    .string "Inside if: x = "
+.LC4:
+    .string "After if: x = "
+.LC5:
+    .string "After for: x = "
+.LC6:
+    .string "Parallel total: "
+.LC7:
+    .string ", x = "
+.LC8:
+    .string "scale(4) = "
+.LC9:
+    .string ", scale(40) = "
+
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,364 @@
+# GPLANG Generated Assembly
+# Module: short_circuit
+# Source: ../../examples/basic/short_circuit.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+touch:
+    # 3 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Ltouch.entry:
+    movq gp_global_calls(%rip), %rsi
+    leaq 1(%rsi), %rdi
+    movq %rdi, gp_global_calls(%rip)
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+safe_ratio:
+    # 5 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lsafe_ratio.entry:
+    testq %rcx, %rcx
+    jne .Lsafe_ratio.and.rhs2
+    jmp .Lsafe_ratio.if.end1
+.Lsafe_ratio.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lsafe_ratio.if.end1:
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lsafe_ratio.and.rhs2:
+    movq %rsi, %rax
+    cqto 
+    idivq %rcx
+    movq %rax, %rdi
+    cmpq $1, %rdi
+    jg .Lsafe_ratio.if.then0
+    jmp .Lsafe_ratio.if.end1
+
+main:
+    # 76 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    movq %r14, -32(%rbp)
+    # Function prologue
+    call __init
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ebx, %ebx
+    xorl %r12d, %r12d
+.Lmain.for.cond0:
+    cmpq $6, %r12
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    cmpq $2, %r12
+    jg .Lmain.and.rhs6
+    movq %rbx, %r13
+    jmp .Lmain.if.end5
+.Lmain.for.step2:
+    leaq 1(%r12), %rcx
+    movq %r13, %rbx
+    movq %rcx, %r12
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %r14
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %r14, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC2(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r14
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r14, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, gp_global_calls(%rip)
+    jmp .Lmain.logic.true7
+.Lmain.if.then4:
+    leaq 1(%rbx), %rcx
+    movq %rcx, %r13
+.Lmain.if.end5:
+    jmp .Lmain.for.step2
+.Lmain.and.rhs6:
+.Lmain.touch.7.entry:
+    movq gp_global_calls(%rip), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, gp_global_calls(%rip)
+.Lmain.touch.7.ret:
+    jmp .Lmain.if.then4
+.Lmain.logic.true7:
+.Lmain.logic.end9:
+.Lmain.logic.false12:
+.Lmain.logic.end13:
+    jmp .Lmain.or.rhs18
+.Lmain.logic.true15:
+.Lmain.logic.end17:
+    leaq .LC3(%rip), %r13
+    movq %r12, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    cmpq $5, %rbx
+    setl %al
+    movzbl %al, %eax
+    movq %rax, %rcx
+    movq gp_global_calls(%rip), %rsi
+    cmpq $5, %rsi
+    setl %al
+    movzbl %al, %eax
+    movq %rax, %rdi
+    xorl %eax, %eax
+    xorl %r11d, %r11d
+    testq %rdi, %rdi
+    setne %al
+    testq %rcx, %rcx
+    cmoveq %r11, %rax
+    movq %rax, %r8
+    cmpq $5, %rbx
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %rcx
+    cmpq $5, %rsi
+    setg %al
+    movzbl %al, %eax
+    movq %rax, %rdi
+    xorl %eax, %eax
+    movl $1, %r11d
+    testq %rdi, %rdi
+    setne %al
+    testq %rcx, %rcx
+    cmovneq %r11, %rax
+    movq %rax, %r13
+    leaq .LC4(%rip), %r14
+    movq %r8, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r14, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC5(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r14
+    movq %r13, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r14, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %r13
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC7(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r13
+    xorl %edi, %edi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    leaq .LC8(%rip), %rcx
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %r13
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r13, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, gp_global_calls(%rip)
+    xorl %r13d, %r13d
+    jmp .Lmain.while.cond19
+.Lmain.or.rhs18:
+.Lmain.touch.4.entry:
+    xorl %r12d, %r12d
+    addq $1, %r12
+    movq %r12, gp_global_calls(%rip)
+.Lmain.touch.4.ret:
+    jmp .Lmain.logic.true15
+.Lmain.while.cond19:
+    cmpq $10, %r13
+    jl .Lmain.and.rhs22
+    jmp .Lmain.while.end21
+.Lmain.while.body20:
+    leaq 1(%r13), %rcx
+    movq %rcx, %r13
+    jmp .Lmain.while.cond19
+.Lmain.while.end21:
+    leaq .LC9(%rip), %rbx
+    movq gp_global_calls(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC10(%rip), %rbx
+.Lmain.safe_ratio.3.entry:
+.Lmain.safe_ratio.3.if.end1:
+.Lmain.safe_ratio.3.ret:
+    xorl %edi, %edi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC11(%rip), %rbx
+.Lmain.safe_ratio.2.entry:
+    jmp .Lmain.safe_ratio.2.and.rhs2
+.Lmain.safe_ratio.2.if.then0:
+    jmp .Lmain.safe_ratio.2.ret
+.Lmain.safe_ratio.2.and.rhs2:
+    jmp .Lmain.safe_ratio.2.if.then0
+.Lmain.safe_ratio.2.ret:
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC12(%rip), %rbx
+    jmp .Lmain.or.rhs26
+.Lmain.and.rhs22:
+.Lmain.touch.1.entry:
+    movq gp_global_calls(%rip), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, gp_global_calls(%rip)
+.Lmain.touch.1.ret:
+    jmp .Lmain.while.body20
+.Lmain.logic.false24:
+.Lmain.logic.end25:
+    movq $1, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lmain.or.rhs26:
+.Lmain.touch.0.entry:
+    movq gp_global_calls(%rip), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, gp_global_calls(%rip)
+.Lmain.touch.0.ret:
+    jmp .Lmain.logic.false24
+
+__init:
+    # 0 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+.L__init.entry:
+    movq $0, gp_global_calls(%rip)
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\200 GPLANG Short-Circuit"
+.LC1:
+    .string "if calls: "
+.LC2:
+    .string ", hits: "
+.LC3:
+    .string "value calls: "
+.LC4:
+    .string "hits < 5 and calls < 5: "
+.LC5:
+    .string ", hits > 5 or calls > 5: "
+.LC6:
+    .string "1 or _: "
+.LC7:
+    .string ", 0 and _: "
+.LC8:
+    .string ", 0 or 1: "
+.LC9:
+    .string "while calls: "
+.LC10:
+    .string "safe_ratio(0, 10): "
+.LC11:
+    .string "safe_ratio(2, 10): "
+.LC12:
+    .string "not (0 or 0): "
+
+.section .bss
+.p2align 3
+gp_global_calls:
+    .zero 8
+
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,290 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'short_circuit'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+@g.calls = internal global i64 0
+
+; Function: touch
+define internal i64 @gp.touch(i64 %p.result) #0 {
+entry:
+  %v.result = alloca i64
+  store i64 %p.result, i64* %v.result
+  %t0 = load i64, i64* @g.calls
+  %t1 = add nsw i64 %t0, 1
+  store i64 %t1, i64* @g.calls
+  %t2 = load i64, i64* %v.result
+  ret i64 %t2
+}
+
+; Function: safe_ratio
+define internal i64 @gp.safe_ratio(i64 %p.x, i64 %p.y) #0 {
+entry:
+  %v.x = alloca i64
+  %v.y = alloca i64
+  store i64 %p.x, i64* %v.x
+  store i64 %p.y, i64* %v.y
+  %t0 = load i64, i64* %v.x
+  %t1 = icmp ne i64 %t0, 0
+  br i1 %t1, label %and.rhs.1, label %if.end.0
+
+and.rhs.1:
+  %t2 = load i64, i64* %v.y
+  %t3 = load i64, i64* %v.x
+  %t4 = sdiv i64 %t2, %t3
+  %t5 = icmp sgt i64 %t4, 1
+  br i1 %t5, label %if.then.0, label %if.end.0
+
+if.then.0:
+  ret i64 1
+
+if.end.0:
+  ret i64 0
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.hits = alloca i64
+  %v.i = alloca i64
+  %v.flag = alloca i1
+  %v.other = alloca i1
+  %v.both = alloca i1
+  %v.small = alloca i1
+  %v.large = alloca i1
+  %v.loops = alloca i64
+  call void @gp.__init()
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([26 x i8], [26 x i8]* @.str.0, i64 0, i64 0))
+  store i64 0, i64* %v.hits
+  store i64 0, i64* %v.i
+  br label %for.cond.2
+
+for.cond.2:
+  %t0 = load i64, i64* %v.i
+  %t1 = icmp slt i64 %t0, 6
+  br i1 %t1, label %for.body.2, label %for.end.2
+
+for.body.2:
+  %t2 = load i64, i64* %v.i
+  %t3 = icmp sgt i64 %t2, 2
+  br i1 %t3, label %and.rhs.4, label %if.end.3
+
+and.rhs.4:
+  %t4 = call i64 @gp.touch(i64 1)
+  %t5 = icmp eq i64 %t4, 1
+  br i1 %t5, label %if.then.3, label %if.end.3
+
+if.then.3:
+  %t6 = load i64, i64* %v.hits
+  %t7 = add nsw i64 %t6, 1
+  store i64 %t7, i64* %v.hits
+  br label %if.end.3
+
+if.end.3:
+  br label %for.step.2
+
+for.step.2:
+  %t8 = load i64, i64* %v.i
+  %t9 = add nsw i64 %t8, 1
+  store i64 %t9, i64* %v.i
+  br label %for.cond.2, !llvm.loop !2
+
+for.end.2:
+  %t10 = load i64, i64* @g.calls
+  %t11 = call i8* @gp_rt_str_int(i64 %t10)
+  %t12 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([11 x i8], [11 x i8]* @.str.1, i64 0, i64 0), i8* %t11)
+  %t13 = call i8* @gp_rt_string_concat(i8* %t12, i8* getelementptr inbounds ([9 x i8], [9 x i8]* @.str.2, i64 0, i64 0))
+  %t14 = load i64, i64* %v.hits
+  %t15 = call i8* @gp_rt_str_int(i64 %t14)
+  %t16 = call i8* @gp_rt_string_concat(i8* %t13, i8* %t15)
+  call i64 @gp_rt_print_string(i8* %t16)
+  store i64 0, i64* @g.calls
+  %t17 = icmp ne i64 1, 0
+  br i1 %t17, label %or.end.5, label %or.rhs.5
+
+or.rhs.5:
+  %t18 = call i64 @gp.touch(i64 0)
+  %t19 = icmp ne i64 %t18, 0
+  br label %or.end.5
+
+or.end.5:
+  %t20 = phi i1 [ true, %for.end.2 ], [ %t19, %or.rhs.5 ]
+  store i1 %t20, i1* %v.flag
+  %t21 = icmp ne i64 0, 0
+  br i1 %t21, label %and.rhs.6, label %and.end.6
+
+and.rhs.6:
+  %t22 = call i64 @gp.touch(i64 1)
+  %t23 = icmp ne i64 %t22, 0
+  br label %and.end.6
+
+and.end.6:
+  %t24 = phi i1 [ false, %or.end.5 ], [ %t23, %and.rhs.6 ]
+  store i1 %t24, i1* %v.other
+  %t25 = icmp ne i64 0, 0
+  br i1 %t25, label %or.end.7, label %or.rhs.7
+
+or.rhs.7:
+  %t26 = call i64 @gp.touch(i64 1)
+  %t27 = icmp ne i64 %t26, 0
+  br label %or.end.7
+
+or.end.7:
+  %t28 = phi i1 [ true, %and.end.6 ], [ %t27, %or.rhs.7 ]
+  store i1 %t28, i1* %v.both
+  %t29 = load i64, i64* @g.calls
+  %t30 = call i8* @gp_rt_str_int(i64 %t29)
+  %t31 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([14 x i8], [14 x i8]* @.str.3, i64 0, i64 0), i8* %t30)
+  call i64 @gp_rt_print_string(i8* %t31)
+  %t32 = load i64, i64* %v.hits
+  %t33 = icmp slt i64 %t32, 5
+  br i1 %t33, label %and.rhs.8, label %and.end.8
+
+and.rhs.8:
+  %t34 = load i64, i64* @g.calls
+  %t35 = icmp slt i64 %t34, 5
+  br label %and.end.8
+
+and.end.8:
+  %t36 = phi i1 [ false, %or.end.7 ], [ %t35, %and.rhs.8 ]
+  store i1 %t36, i1* %v.small
+  %t37 = load i64, i64* %v.hits
+  %t38 = icmp sgt i64 %t37, 5
+  br i1 %t38, label %or.end.9, label %or.rhs.9
+
+or.rhs.9:
+  %t39 = load i64, i64* @g.calls
+  %t40 = icmp sgt i64 %t39, 5
+  br label %or.end.9
+
+or.end.9:
+  %t41 = phi i1 [ true, %and.end.8 ], [ %t40, %or.rhs.9 ]
+  store i1 %t41, i1* %v.large
+  %t42 = load i1, i1* %v.small
+  %t43 = zext i1 %t42 to i64
+  %t44 = call i8* @gp_rt_str_int(i64 %t43)
+  %t45 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([25 x i8], [25 x i8]* @.str.4, i64 0, i64 0), i8* %t44)
+  %t46 = call i8* @gp_rt_string_concat(i8* %t45, i8* getelementptr inbounds ([26 x i8], [26 x i8]* @.str.5, i64 0, i64 0))
+  %t47 = load i1, i1* %v.large
+  %t48 = zext i1 %t47 to i64
+  %t49 = call i8* @gp_rt_str_int(i64 %t48)
+  %t50 = call i8* @gp_rt_string_concat(i8* %t46, i8* %t49)
+  call i64 @gp_rt_print_string(i8* %t50)
+  %t51 = load i1, i1* %v.flag
+  %t52 = zext i1 %t51 to i64
+  %t53 = call i8* @gp_rt_str_int(i64 %t52)
+  %t54 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([9 x i8], [9 x i8]* @.str.6, i64 0, i64 0), i8* %t53)
+  %t55 = call i8* @gp_rt_string_concat(i8* %t54, i8* getelementptr inbounds ([12 x i8], [12 x i8]* @.str.7, i64 0, i64 0))
+  %t56 = load i1, i1* %v.other
+  %t57 = zext i1 %t56 to i64
+  %t58 = call i8* @gp_rt_str_int(i64 %t57)
+  %t59 = call i8* @gp_rt_string_concat(i8* %t55, i8* %t58)
+  %t60 = call i8* @gp_rt_string_concat(i8* %t59, i8* getelementptr inbounds ([11 x i8], [11 x i8]* @.str.8, i64 0, i64 0))
+  %t61 = load i1, i1* %v.both
+  %t62 = zext i1 %t61 to i64
+  %t63 = call i8* @gp_rt_str_int(i64 %t62)
+  %t64 = call i8* @gp_rt_string_concat(i8* %t60, i8* %t63)
+  call i64 @gp_rt_print_string(i8* %t64)
+  store i64 0, i64* @g.calls
+  store i64 0, i64* %v.loops
+  br label %while.cond.10
+
+while.cond.10:
+  %t65 = load i64, i64* %v.loops
+  %t66 = icmp slt i64 %t65, 10
+  br i1 %t66, label %and.rhs.11, label %while.end.10
+
+and.rhs.11:
+  %t67 = call i64 @gp.touch(i64 1)
+  %t68 = icmp eq i64 %t67, 1
+  br i1 %t68, label %while.body.10, label %while.end.10
+
+while.body.10:
+  %t69 = load i64, i64* %v.loops
+  %t70 = add nsw i64 %t69, 1
+  store i64 %t70, i64* %v.loops
+  br label %while.cond.10
+
+while.end.10:
+  %t71 = load i64, i64* @g.calls
+  %t72 = call i8* @gp_rt_str_int(i64 %t71)
+  %t73 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([14 x i8], [14 x i8]* @.str.9, i64 0, i64 0), i8* %t72)
+  call i64 @gp_rt_print_string(i8* %t73)
+  %t74 = call i64 @gp.safe_ratio(i64 0, i64 10)
+  %t75 = call i8* @gp_rt_str_int(i64 %t74)
+  %t76 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([20 x i8], [20 x i8]* @.str.10, i64 0, i64 0), i8* %t75)
+  call i64 @gp_rt_print_string(i8* %t76)
+  %t77 = call i64 @gp.safe_ratio(i64 2, i64 10)
+  %t78 = call i8* @gp_rt_str_int(i64 %t77)
+  %t79 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([20 x i8], [20 x i8]* @.str.11, i64 0, i64 0), i8* %t78)
+  call i64 @gp_rt_print_string(i8* %t79)
+  %t80 = icmp ne i64 0, 0
+  br i1 %t80, label %or.end.12, label %or.rhs.12
+
+or.rhs.12:
+  %t81 = call i64 @gp.touch(i64 0)
+  %t82 = icmp ne i64 %t81, 0
+  br label %or.end.12
+
+or.end.12:
+  %t83 = phi i1 [ true, %while.end.10 ], [ %t82, %or.rhs.12 ]
+  %t84 = xor i1 %t83, true
+  %t85 = zext i1 %t84 to i64
+  %t86 = call i8* @gp_rt_str_int(i64 %t85)
+  %t87 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([15 x i8], [15 x i8]* @.str.12, i64 0, i64 0), i8* %t86)
+  call i64 @gp_rt_print_string(i8* %t87)
+  %t88 = trunc i64 0 to i32
+  ret i32 %t88
+}
+
+; Function: __init
+define internal void @gp.__init() #0 {
+entry:
+  store i64 0, i64* @g.calls
+  ret void
+}
+
+@.str.0 = private unnamed_addr constant [26 x i8] c"\F0\9F\94\80 GPLANG Short-Circuit\00"
+@.str.1 = private unnamed_addr constant [11 x i8] c"if calls: \00"
+@.str.2 = private unnamed_addr constant [9 x i8] c", hits: \00"
+@.str.3 = private unnamed_addr constant [14 x i8] c"value calls: \00"
+@.str.4 = private unnamed_addr constant [25 x i8] c"hits < 5 and calls < 5: \00"
+@.str.5 = private unnamed_addr constant [26 x i8] c", hits > 5 or calls > 5: \00"
+@.str.6 = private unnamed_addr constant [9 x i8] c"1 or _: \00"
+@.str.7 = private unnamed_addr constant [12 x i8] c", 0 and _: \00"
+@.str.8 = private unnamed_addr constant [11 x i8] c", 0 or 1: \00"
+@.str.9 = private unnamed_addr constant [14 x i8] c"while calls: \00"
+@.str.10 = private unnamed_addr constant [20 x i8] c"safe_ratio(0, 10): \00"
+@.str.11 = private unnamed_addr constant [20 x i8] c"safe_ratio(2, 10): \00"
+@.str.12 = private unnamed_addr constant [15 x i8] c"not (0 or 0): \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0}
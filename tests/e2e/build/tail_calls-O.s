@@ -0,0 +1,712 @@
+# GPLANG Generated Assembly
+# Module: tail_calls
+# Source: ../../examples/basic/tail_calls.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+count_down:
+    # 8 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lcount_down.tailrec.entry:
+    movq %rcx, %rdi
+    movq %rsi, %r8
+.Lcount_down.entry:
+    testq %rdi, %rdi
+    jne .Lcount_down.if.end1
+.Lcount_down.if.then0:
+    movq %r8, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lcount_down.if.end1:
+    leaq -1(%rdi), %rcx
+    movq $7, %r11
+    movq %rdi, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rsi
+    leaq (%r8,%rsi), %r9
+    movq %rcx, %rdi
+    movq %r9, %r8
+    jmp .Lcount_down.entry
+
+is_even:
+    # 4 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_even.entry:
+    testq %rcx, %rcx
+    jne .Lis_even.if.end1
+.Lis_even.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_even.if.end1:
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    popq %rbp
+    jmp is_odd
+
+is_odd:
+    # 4 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_odd.entry:
+    testq %rcx, %rcx
+    jne .Lis_odd.if.end1
+.Lis_odd.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lis_odd.if.end1:
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    popq %rbp
+    jmp is_even
+
+ping:
+    # 21 values in registers, 0 spilled, 48-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $48, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    movq %r14, -32(%rbp)
+    movq %r15, -40(%rbp)
+    # Function prologue
+    movq %r9, %rbx
+    movq 16(%rbp), %r12
+    movq %r8, %r9
+    movq %rcx, %r8
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lping.entry:
+    testq %rcx, %rcx
+    jne .Lping.if.end1
+.Lping.if.then0:
+    leaq (%rsi,%rdi,2), %r14
+    leaq (%r8,%r8,2), %r13
+    leaq (%r14,%r13), %r15
+    leaq (%r15,%r9,4), %r14
+    leaq (%rbx,%rbx,4), %r13
+    leaq (%r14,%r13), %r15
+    movq $6, %r13
+    imulq %r12, %r13
+    leaq (%r15,%r13), %r14
+    movq %r14, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq -40(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lping.if.end1:
+    leaq -1(%rcx), %r13
+    leaq 1(%rbx), %rcx
+    movq %rsi, %rdx
+    movq %rcx, 16(%rbp)
+    movq %r12, %rsi
+    movq %rdi, %rcx
+    movq %r13, %rdi
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq -40(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    jmp pong
+
+pong:
+    # 17 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    movq %r14, -32(%rbp)
+    # Function prologue
+    movq %r9, %rbx
+    movq 16(%rbp), %r12
+    movq %r8, %r9
+    movq %rcx, %r8
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lpong.entry:
+    testq %rcx, %rcx
+    jne .Lpong.if.end1
+.Lpong.if.then0:
+    movq %rsi, %r13
+    subq %rdi, %r13
+    leaq (%r13,%r8), %r14
+    movq %r14, %r13
+    subq %r9, %r13
+    leaq (%r13,%rbx), %r14
+    movq %r14, %r13
+    subq %r12, %r13
+    movq %r13, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lpong.if.end1:
+    leaq -1(%rcx), %r13
+    movq $3, %r11
+    movq %rcx, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r14
+    leaq (%rsi,%r14), %rcx
+    movq %rdi, %rsi
+    movq %r8, %rdx
+    movq %rbx, %r8
+    movq %rcx, 16(%rbp)
+    movq %r13, %rdi
+    movq %r9, %rcx
+    movq %r12, %r9
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq -32(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    jmp ping
+
+spread:
+    # 26 values in registers, 6 spilled, 96-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $96, %rsp
+    movq %rbx, -56(%rbp)
+    movq %r12, -64(%rbp)
+    movq %r13, -72(%rbp)
+    movq %r14, -80(%rbp)
+    movq %r15, -88(%rbp)
+    # Function prologue
+    movq %r9, %rbx
+    movq 16(%rbp), %r12
+    movq 24(%rbp), %r13
+    movq %r8, %r9
+    movq %rcx, %r8
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lspread.tailrec.entry:
+    movq %rcx, %r14
+    movq %rsi, %r15
+    movq %rdi, -8(%rbp)
+    movq %r8, -16(%rbp)
+    movq %r9, -24(%rbp)
+    movq %rbx, -32(%rbp)
+    movq %r12, -40(%rbp)
+    movq %r13, -48(%rbp)
+.Lspread.entry:
+    testq %r14, %r14
+    jne .Lspread.if.end1
+.Lspread.if.then0:
+    movq -8(%rbp), %rcx
+    shlq $1, %rcx
+    leaq (%r15,%rcx), %rsi
+    movq $3, %rcx
+    imulq -16(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq -24(%rbp), %rcx
+    shlq $2, %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq $5, %rcx
+    imulq -32(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq $6, %rcx
+    imulq -40(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq $7, %rcx
+    imulq -48(%rbp), %rcx
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, %rax
+    # Function epilogue
+    movq -56(%rbp), %rbx
+    movq -64(%rbp), %r12
+    movq -72(%rbp), %r13
+    movq -80(%rbp), %r14
+    movq -88(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lspread.if.end1:
+    leaq -1(%r14), %rcx
+    movq $5, %r11
+    movq %r14, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %rsi
+    movq -40(%rbp), %rdi
+    addq %rsi, %rdi
+    movq %rcx, %r14
+    movq -32(%rbp), %r10
+    movq %r10, -40(%rbp)
+    movq -24(%rbp), %r10
+    movq %r10, -32(%rbp)
+    movq -16(%rbp), %r10
+    movq %r10, -24(%rbp)
+    movq -8(%rbp), %r10
+    movq %r10, -16(%rbp)
+    movq %r15, -8(%rbp)
+    movq -48(%rbp), %r15
+    movq %rdi, -48(%rbp)
+    jmp .Lspread.entry
+
+widen:
+    # 23 values in registers, 2 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -24(%rbp)
+    movq %r12, -32(%rbp)
+    movq %r13, -40(%rbp)
+    movq %r14, -48(%rbp)
+    movq %r15, -56(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lwiden.entry:
+.Lwiden.spread.0.tailrec.entry:
+    movq %rcx, %rsi
+    movq $1, %rdi
+    movq $2, %r8
+    movq $3, %r9
+    movq $4, %rbx
+    movq $5, %r12
+    movq $6, %r13
+    movq $7, -8(%rbp)
+.Lwiden.spread.0.entry:
+    testq %rsi, %rsi
+    jne .Lwiden.spread.0.if.end1
+.Lwiden.spread.0.if.then0:
+    leaq (%rdi,%r8,2), %r15
+    leaq (%r9,%r9,2), %rcx
+    leaq (%r15,%rcx), %r14
+    leaq (%r14,%rbx,4), %r15
+    leaq (%r12,%r12,4), %rcx
+    leaq (%r15,%rcx), %r14
+    movq $6, %rcx
+    imulq %r13, %rcx
+    leaq (%r14,%rcx), %r15
+    movq $7, %rcx
+    imulq -8(%rbp), %rcx
+    movq %r15, %r10
+    addq %rcx, %r10
+    movq %r10, -16(%rbp)
+    jmp .Lwiden.spread.0.ret
+.Lwiden.spread.0.if.end1:
+    leaq -1(%rsi), %rcx
+    movq $5, %r11
+    movq %rsi, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r15
+    leaq (%r13,%r15), %r14
+    movq %rcx, %rsi
+    movq %r12, %r13
+    movq %rbx, %r12
+    movq %r9, %rbx
+    movq %r8, %r9
+    movq %rdi, %r8
+    movq -8(%rbp), %rdi
+    movq %r14, -8(%rbp)
+    jmp .Lwiden.spread.0.entry
+.Lwiden.spread.0.ret:
+    movq -16(%rbp), %rax
+    # Function epilogue
+    movq -24(%rbp), %rbx
+    movq -32(%rbp), %r12
+    movq -40(%rbp), %r13
+    movq -48(%rbp), %r14
+    movq -56(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+triangle:
+    # 7 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Ltriangle.tailrec.entry:
+    xorl %esi, %esi
+    movq %rcx, %rdi
+.Ltriangle.entry:
+    testq %rdi, %rdi
+    jne .Ltriangle.if.end1
+.Ltriangle.if.then0:
+    movq %rsi, %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Ltriangle.if.end1:
+    leaq -1(%rdi), %rcx
+    leaq (%rsi,%rdi), %r8
+    movq %r8, %rsi
+    movq %rcx, %rdi
+    jmp .Ltriangle.entry
+
+factorial:
+    # 7 values in registers, 0 spilled, 0-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    # Function prologue
+    movq %rdi, %rcx
+.Lfactorial.tailrec.entry:
+    movq $1, %rsi
+    movq %rcx, %rdi
+.Lfactorial.entry:
+    cmpq $1, %rdi
+    jg .Lfactorial.if.end1
+.Lfactorial.if.then0:
+    movq %rsi, %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    popq %rbp
+    ret 
+.Lfactorial.if.end1:
+    leaq -1(%rdi), %rcx
+    movq %rsi, %r8
+    imulq %rdi, %r8
+    movq %r8, %rsi
+    movq %rcx, %rdi
+    jmp .Lfactorial.entry
+
+fibonacci:
+    # 9 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lfibonacci.tailrec.entry:
+    xorl %ebx, %ebx
+    movq %rcx, %r12
+.Lfibonacci.entry:
+    cmpq $1, %r12
+    jg .Lfibonacci.if.end1
+.Lfibonacci.if.then0:
+    leaq (%rbx,%r12), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci.if.end1:
+    leaq -1(%r12), %rcx
+    movq %rcx, %rdi
+    call fibonacci
+    movq %rax, %rsi
+    leaq -2(%r12), %rcx
+    leaq (%rbx,%rsi), %rdi
+    movq %rdi, %rbx
+    movq %rcx, %r12
+    jmp .Lfibonacci.entry
+
+main:
+    # 86 values in registers, 3 spilled, 64-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $64, %rsp
+    movq %rbx, -32(%rbp)
+    movq %r12, -40(%rbp)
+    movq %r13, -48(%rbp)
+    movq %r14, -56(%rbp)
+    movq %r15, -64(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rbx
+.Lmain.count_down.8.tailrec.entry:
+    movq $1000000, %rcx
+    xorl %esi, %esi
+.Lmain.count_down.8.entry:
+    testq %rcx, %rcx
+    jne .Lmain.count_down.8.if.end1
+.Lmain.count_down.8.if.then0:
+    jmp .Lmain.count_down.8.ret
+.Lmain.count_down.8.if.end1:
+    leaq -1(%rcx), %rdi
+    movq $7, %r11
+    movq %rcx, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r8
+    leaq (%rsi,%r8), %r9
+    movq %rdi, %rcx
+    movq %r9, %rsi
+    jmp .Lmain.count_down.8.entry
+.Lmain.count_down.8.ret:
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+.Lmain.is_even.7.entry:
+.Lmain.is_even.7.if.end1:
+    movq $1000000, %rdi
+    call is_odd
+    movq %rax, %rcx
+.Lmain.is_even.7.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC3(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+.Lmain.is_odd.6.entry:
+.Lmain.is_odd.6.if.end1:
+    movq $1000000, %rdi
+    call is_even
+    movq %rax, %rcx
+.Lmain.is_odd.6.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC4(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC5(%rip), %rbx
+.Lmain.ping.5.entry:
+.Lmain.ping.5.if.end1:
+    subq $8, %rsp
+    pushq $6
+    movq $100000, %rdi
+    movq $6, %rsi
+    movq $1, %rdx
+    movq $2, %rcx
+    movq $3, %r8
+    movq $4, %r9
+    call pong
+    addq $16, %rsp
+    movq %rax, %rcx
+.Lmain.ping.5.ret:
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %r10
+    movq %r10, -8(%rbp)
+.Lmain.widen.4.entry:
+.Lmain.widen.4.spread.0.tailrec.entry:
+    movq $1000000, %rcx
+    movq $1, %rsi
+    movq $2, %rdi
+    movq $3, %r8
+    movq $4, %r9
+    movq $5, %r12
+    movq $6, %r13
+    movq $7, -16(%rbp)
+.Lmain.widen.4.spread.0.entry:
+    testq %rcx, %rcx
+    jne .Lmain.widen.4.spread.0.if.end1
+.Lmain.widen.4.spread.0.if.then0:
+    leaq (%rsi,%rdi,2), %rbx
+    leaq (%r8,%r8,2), %r15
+    leaq (%rbx,%r15), %r14
+    leaq (%r14,%r9,4), %r15
+    leaq (%r12,%r12,4), %rbx
+    leaq (%r15,%rbx), %r14
+    movq $6, %rbx
+    imulq %r13, %rbx
+    leaq (%r14,%rbx), %r15
+    movq $7, %rbx
+    imulq -16(%rbp), %rbx
+    movq %r15, %r10
+    addq %rbx, %r10
+    movq %r10, -24(%rbp)
+    jmp .Lmain.widen.4.spread.0.ret
+.Lmain.widen.4.spread.0.if.end1:
+    leaq -1(%rcx), %rbx
+    movq $5, %r11
+    movq %rcx, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r15
+    leaq (%r13,%r15), %r14
+    movq %rbx, %rcx
+    movq %r12, %r13
+    movq %r9, %r12
+    movq %r8, %r9
+    movq %rdi, %r8
+    movq %rsi, %rdi
+    movq -16(%rbp), %rsi
+    movq %r14, -16(%rbp)
+    jmp .Lmain.widen.4.spread.0.entry
+.Lmain.widen.4.spread.0.ret:
+.Lmain.widen.4.ret:
+    movq -24(%rbp), %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq -8(%rbp), %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC7(%rip), %rbx
+.Lmain.triangle.3.tailrec.entry:
+    xorl %ecx, %ecx
+    movq $50000, %rsi
+.Lmain.triangle.3.entry:
+    testq %rsi, %rsi
+    jne .Lmain.triangle.3.if.end1
+.Lmain.triangle.3.if.then0:
+    movq %rcx, %rdi
+    jmp .Lmain.triangle.3.ret
+.Lmain.triangle.3.if.end1:
+    leaq -1(%rsi), %r8
+    leaq (%rcx,%rsi), %r9
+    movq %r9, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.triangle.3.entry
+.Lmain.triangle.3.ret:
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC8(%rip), %rbx
+.Lmain.factorial.2.tailrec.entry:
+    movq $1, %rcx
+    movq $20, %rsi
+.Lmain.factorial.2.entry:
+    cmpq $1, %rsi
+    jg .Lmain.factorial.2.if.end1
+.Lmain.factorial.2.if.then0:
+    movq %rcx, %rdi
+    jmp .Lmain.factorial.2.ret
+.Lmain.factorial.2.if.end1:
+    leaq -1(%rsi), %r8
+    movq %rcx, %r9
+    imulq %rsi, %r9
+    movq %r9, %rcx
+    movq %r8, %rsi
+    jmp .Lmain.factorial.2.entry
+.Lmain.factorial.2.ret:
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC9(%rip), %rbx
+.Lmain.fibonacci.1.tailrec.entry:
+    xorl %r12d, %r12d
+    movq $24, %r13
+.Lmain.fibonacci.1.entry:
+    cmpq $1, %r13
+    jg .Lmain.fibonacci.1.if.end1
+.Lmain.fibonacci.1.if.then0:
+    leaq (%r12,%r13), %r14
+    jmp .Lmain.fibonacci.1.ret
+.Lmain.fibonacci.1.if.end1:
+    leaq -1(%r13), %rcx
+    movq %rcx, %rdi
+    call fibonacci
+    movq %rax, %rsi
+    leaq -2(%r13), %rcx
+    leaq (%r12,%rsi), %rdi
+    movq %rdi, %r12
+    movq %rcx, %r13
+    jmp .Lmain.fibonacci.1.entry
+.Lmain.fibonacci.1.ret:
+    movq %r14, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -32(%rbp), %rbx
+    movq -40(%rbp), %r12
+    movq -48(%rbp), %r13
+    movq -56(%rbp), %r14
+    movq -64(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\201 GPLANG Tail Calls"
+.LC1:
+    .string "Count down: "
+.LC2:
+    .string "Parity of 1000001: "
+.LC3:
+    .string " even, "
+.LC4:
+    .string " odd"
+.LC5:
+    .string "Ping-pong over 7 arguments: "
+.LC6:
+    .string "Spread over 8 arguments: "
+.LC7:
+    .string "Triangle(50000): "
+.LC8:
+    .string "Factorial(20): "
+.LC9:
+    .string "Fibonacci(24): "
+
+.section .note.GNU-stack,"",@progbits
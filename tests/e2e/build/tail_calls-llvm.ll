@@ -0,0 +1,390 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'tail_calls'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: count_down
+define internal i64 @gp.count_down(i64 %p.n, i64 %p.total) #0 {
+entry:
+  %v.n = alloca i64
+  %v.total = alloca i64
+  store i64 %p.n, i64* %v.n
+  store i64 %p.total, i64* %v.total
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.0, label %if.end.0
+
+if.then.0:
+  %t2 = load i64, i64* %v.total
+  ret i64 %t2
+
+if.end.0:
+  %t3 = load i64, i64* %v.n
+  %t4 = sub nsw i64 %t3, 1
+  %t5 = load i64, i64* %v.total
+  %t6 = load i64, i64* %v.n
+  %t7 = srem i64 %t6, 7
+  %t8 = add nsw i64 %t5, %t7
+  %t9 = call i64 @gp.count_down(i64 %t4, i64 %t8)
+  ret i64 %t9
+}
+
+; Function: is_even
+define internal i64 @gp.is_even(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.1, label %if.end.1
+
+if.then.1:
+  ret i64 1
+
+if.end.1:
+  %t2 = load i64, i64* %v.n
+  %t3 = sub nsw i64 %t2, 1
+  %t4 = call i64 @gp.is_odd(i64 %t3)
+  ret i64 %t4
+}
+
+; Function: is_odd
+define internal i64 @gp.is_odd(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.2, label %if.end.2
+
+if.then.2:
+  ret i64 0
+
+if.end.2:
+  %t2 = load i64, i64* %v.n
+  %t3 = sub nsw i64 %t2, 1
+  %t4 = call i64 @gp.is_even(i64 %t3)
+  ret i64 %t4
+}
+
+; Function: ping
+define internal i64 @gp.ping(i64 %p.n, i64 %p.a, i64 %p.b, i64 %p.c, i64 %p.d, i64 %p.e, i64 %p.f) #0 {
+entry:
+  %v.n = alloca i64
+  %v.a = alloca i64
+  %v.b = alloca i64
+  %v.c = alloca i64
+  %v.d = alloca i64
+  %v.e = alloca i64
+  %v.f = alloca i64
+  store i64 %p.n, i64* %v.n
+  store i64 %p.a, i64* %v.a
+  store i64 %p.b, i64* %v.b
+  store i64 %p.c, i64* %v.c
+  store i64 %p.d, i64* %v.d
+  store i64 %p.e, i64* %v.e
+  store i64 %p.f, i64* %v.f
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.3, label %if.end.3
+
+if.then.3:
+  %t2 = load i64, i64* %v.a
+  %t3 = load i64, i64* %v.b
+  %t4 = mul nsw i64 2, %t3
+  %t5 = add nsw i64 %t2, %t4
+  %t6 = load i64, i64* %v.c
+  %t7 = mul nsw i64 3, %t6
+  %t8 = add nsw i64 %t5, %t7
+  %t9 = load i64, i64* %v.d
+  %t10 = mul nsw i64 4, %t9
+  %t11 = add nsw i64 %t8, %t10
+  %t12 = load i64, i64* %v.e
+  %t13 = mul nsw i64 5, %t12
+  %t14 = add nsw i64 %t11, %t13
+  %t15 = load i64, i64* %v.f
+  %t16 = mul nsw i64 6, %t15
+  %t17 = add nsw i64 %t14, %t16
+  ret i64 %t17
+
+if.end.3:
+  %t18 = load i64, i64* %v.n
+  %t19 = sub nsw i64 %t18, 1
+  %t20 = load i64, i64* %v.f
+  %t21 = load i64, i64* %v.a
+  %t22 = load i64, i64* %v.b
+  %t23 = load i64, i64* %v.c
+  %t24 = load i64, i64* %v.d
+  %t25 = load i64, i64* %v.e
+  %t26 = add nsw i64 %t25, 1
+  %t27 = call i64 @gp.pong(i64 %t19, i64 %t20, i64 %t21, i64 %t22, i64 %t23, i64 %t24, i64 %t26)
+  ret i64 %t27
+}
+
+; Function: pong
+define internal i64 @gp.pong(i64 %p.n, i64 %p.a, i64 %p.b, i64 %p.c, i64 %p.d, i64 %p.e, i64 %p.f) #0 {
+entry:
+  %v.n = alloca i64
+  %v.a = alloca i64
+  %v.b = alloca i64
+  %v.c = alloca i64
+  %v.d = alloca i64
+  %v.e = alloca i64
+  %v.f = alloca i64
+  store i64 %p.n, i64* %v.n
+  store i64 %p.a, i64* %v.a
+  store i64 %p.b, i64* %v.b
+  store i64 %p.c, i64* %v.c
+  store i64 %p.d, i64* %v.d
+  store i64 %p.e, i64* %v.e
+  store i64 %p.f, i64* %v.f
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.4, label %if.end.4
+
+if.then.4:
+  %t2 = load i64, i64* %v.a
+  %t3 = load i64, i64* %v.b
+  %t4 = sub nsw i64 %t2, %t3
+  %t5 = load i64, i64* %v.c
+  %t6 = add nsw i64 %t4, %t5
+  %t7 = load i64, i64* %v.d
+  %t8 = sub nsw i64 %t6, %t7
+  %t9 = load i64, i64* %v.e
+  %t10 = add nsw i64 %t8, %t9
+  %t11 = load i64, i64* %v.f
+  %t12 = sub nsw i64 %t10, %t11
+  ret i64 %t12
+
+if.end.4:
+  %t13 = load i64, i64* %v.n
+  %t14 = sub nsw i64 %t13, 1
+  %t15 = load i64, i64* %v.b
+  %t16 = load i64, i64* %v.c
+  %t17 = load i64, i64* %v.d
+  %t18 = load i64, i64* %v.e
+  %t19 = load i64, i64* %v.f
+  %t20 = load i64, i64* %v.a
+  %t21 = load i64, i64* %v.n
+  %t22 = srem i64 %t21, 3
+  %t23 = add nsw i64 %t20, %t22
+  %t24 = call i64 @gp.ping(i64 %t14, i64 %t15, i64 %t16, i64 %t17, i64 %t18, i64 %t19, i64 %t23)
+  ret i64 %t24
+}
+
+; Function: spread
+define internal i64 @gp.spread(i64 %p.n, i64 %p.a, i64 %p.b, i64 %p.c, i64 %p.d, i64 %p.e, i64 %p.f, i64 %p.g) #0 {
+entry:
+  %v.n = alloca i64
+  %v.a = alloca i64
+  %v.b = alloca i64
+  %v.c = alloca i64
+  %v.d = alloca i64
+  %v.e = alloca i64
+  %v.f = alloca i64
+  %v.g = alloca i64
+  store i64 %p.n, i64* %v.n
+  store i64 %p.a, i64* %v.a
+  store i64 %p.b, i64* %v.b
+  store i64 %p.c, i64* %v.c
+  store i64 %p.d, i64* %v.d
+  store i64 %p.e, i64* %v.e
+  store i64 %p.f, i64* %v.f
+  store i64 %p.g, i64* %v.g
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.5, label %if.end.5
+
+if.then.5:
+  %t2 = load i64, i64* %v.a
+  %t3 = load i64, i64* %v.b
+  %t4 = mul nsw i64 2, %t3
+  %t5 = add nsw i64 %t2, %t4
+  %t6 = load i64, i64* %v.c
+  %t7 = mul nsw i64 3, %t6
+  %t8 = add nsw i64 %t5, %t7
+  %t9 = load i64, i64* %v.d
+  %t10 = mul nsw i64 4, %t9
+  %t11 = add nsw i64 %t8, %t10
+  %t12 = load i64, i64* %v.e
+  %t13 = mul nsw i64 5, %t12
+  %t14 = add nsw i64 %t11, %t13
+  %t15 = load i64, i64* %v.f
+  %t16 = mul nsw i64 6, %t15
+  %t17 = add nsw i64 %t14, %t16
+  %t18 = load i64, i64* %v.g
+  %t19 = mul nsw i64 7, %t18
+  %t20 = add nsw i64 %t17, %t19
+  ret i64 %t20
+
+if.end.5:
+  %t21 = load i64, i64* %v.n
+  %t22 = sub nsw i64 %t21, 1
+  %t23 = load i64, i64* %v.g
+  %t24 = load i64, i64* %v.a
+  %t25 = load i64, i64* %v.b
+  %t26 = load i64, i64* %v.c
+  %t27 = load i64, i64* %v.d
+  %t28 = load i64, i64* %v.e
+  %t29 = load i64, i64* %v.f
+  %t30 = load i64, i64* %v.n
+  %t31 = srem i64 %t30, 5
+  %t32 = add nsw i64 %t29, %t31
+  %t33 = call i64 @gp.spread(i64 %t22, i64 %t23, i64 %t24, i64 %t25, i64 %t26, i64 %t27, i64 %t28, i64 %t32)
+  ret i64 %t33
+}
+
+; Function: widen
+define internal i64 @gp.widen(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = call i64 @gp.spread(i64 %t0, i64 1, i64 2, i64 3, i64 4, i64 5, i64 6, i64 7)
+  ret i64 %t1
+}
+
+; Function: triangle
+define internal i64 @gp.triangle(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp eq i64 %t0, 0
+  br i1 %t1, label %if.then.6, label %if.end.6
+
+if.then.6:
+  ret i64 0
+
+if.end.6:
+  %t2 = load i64, i64* %v.n
+  %t3 = load i64, i64* %v.n
+  %t4 = sub nsw i64 %t3, 1
+  %t5 = call i64 @gp.triangle(i64 %t4)
+  %t6 = add nsw i64 %t2, %t5
+  ret i64 %t6
+}
+
+; Function: factorial
+define internal i64 @gp.factorial(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp sle i64 %t0, 1
+  br i1 %t1, label %if.then.7, label %if.end.7
+
+if.then.7:
+  ret i64 1
+
+if.end.7:
+  %t2 = load i64, i64* %v.n
+  %t3 = sub nsw i64 %t2, 1
+  %t4 = call i64 @gp.factorial(i64 %t3)
+  %t5 = load i64, i64* %v.n
+  %t6 = mul nsw i64 %t4, %t5
+  ret i64 %t6
+}
+
+; Function: fibonacci
+define internal i64 @gp.fibonacci(i64 %p.n) #0 {
+entry:
+  %v.n = alloca i64
+  store i64 %p.n, i64* %v.n
+  %t0 = load i64, i64* %v.n
+  %t1 = icmp sle i64 %t0, 1
+  br i1 %t1, label %if.then.8, label %if.end.8
+
+if.then.8:
+  %t2 = load i64, i64* %v.n
+  ret i64 %t2
+
+if.end.8:
+  %t3 = load i64, i64* %v.n
+  %t4 = sub nsw i64 %t3, 1
+  %t5 = call i64 @gp.fibonacci(i64 %t4)
+  %t6 = load i64, i64* %v.n
+  %t7 = sub nsw i64 %t6, 2
+  %t8 = call i64 @gp.fibonacci(i64 %t7)
+  %t9 = add nsw i64 %t5, %t8
+  ret i64 %t9
+}
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([23 x i8], [23 x i8]* @.str.0, i64 0, i64 0))
+  %t0 = call i64 @gp.count_down(i64 1000000, i64 0)
+  %t1 = call i8* @gp_rt_str_int(i64 %t0)
+  %t2 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([13 x i8], [13 x i8]* @.str.1, i64 0, i64 0), i8* %t1)
+  call i64 @gp_rt_print_string(i8* %t2)
+  %t3 = call i64 @gp.is_even(i64 1000001)
+  %t4 = call i8* @gp_rt_str_int(i64 %t3)
+  %t5 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([20 x i8], [20 x i8]* @.str.2, i64 0, i64 0), i8* %t4)
+  %t6 = call i8* @gp_rt_string_concat(i8* %t5, i8* getelementptr inbounds ([8 x i8], [8 x i8]* @.str.3, i64 0, i64 0))
+  %t7 = call i64 @gp.is_odd(i64 1000001)
+  %t8 = call i8* @gp_rt_str_int(i64 %t7)
+  %t9 = call i8* @gp_rt_string_concat(i8* %t6, i8* %t8)
+  %t10 = call i8* @gp_rt_string_concat(i8* %t9, i8* getelementptr inbounds ([5 x i8], [5 x i8]* @.str.4, i64 0, i64 0))
+  call i64 @gp_rt_print_string(i8* %t10)
+  %t11 = call i64 @gp.ping(i64 100001, i64 1, i64 2, i64 3, i64 4, i64 5, i64 6)
+  %t12 = call i8* @gp_rt_str_int(i64 %t11)
+  %t13 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([29 x i8], [29 x i8]* @.str.5, i64 0, i64 0), i8* %t12)
+  call i64 @gp_rt_print_string(i8* %t13)
+  %t14 = call i64 @gp.widen(i64 1000000)
+  %t15 = call i8* @gp_rt_str_int(i64 %t14)
+  %t16 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([26 x i8], [26 x i8]* @.str.6, i64 0, i64 0), i8* %t15)
+  call i64 @gp_rt_print_string(i8* %t16)
+  %t17 = call i64 @gp.triangle(i64 50000)
+  %t18 = call i8* @gp_rt_str_int(i64 %t17)
+  %t19 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([18 x i8], [18 x i8]* @.str.7, i64 0, i64 0), i8* %t18)
+  call i64 @gp_rt_print_string(i8* %t19)
+  %t20 = call i64 @gp.factorial(i64 20)
+  %t21 = call i8* @gp_rt_str_int(i64 %t20)
+  %t22 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @.str.8, i64 0, i64 0), i8* %t21)
+  call i64 @gp_rt_print_string(i8* %t22)
+  %t23 = call i64 @gp.fibonacci(i64 24)
+  %t24 = call i8* @gp_rt_str_int(i64 %t23)
+  %t25 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @.str.9, i64 0, i64 0), i8* %t24)
+  call i64 @gp_rt_print_string(i8* %t25)
+  %t26 = trunc i64 0 to i32
+  ret i32 %t26
+}
+
+@.str.0 = private unnamed_addr constant [23 x i8] c"\F0\9F\94\81 GPLANG Tail Calls\00"
+@.str.1 = private unnamed_addr constant [13 x i8] c"Count down: \00"
+@.str.2 = private unnamed_addr constant [20 x i8] c"Parity of 1000001: \00"
+@.str.3 = private unnamed_addr constant [8 x i8] c" even, \00"
+@.str.4 = private unnamed_addr constant [5 x i8] c" odd\00"
+@.str.5 = private unnamed_addr constant [29 x i8] c"Ping-pong over 7 arguments: \00"
+@.str.6 = private unnamed_addr constant [26 x i8] c"Spread over 8 arguments: \00"
+@.str.7 = private unnamed_addr constant [18 x i8] c"Triangle(50000): \00"
+@.str.8 = private unnamed_addr constant [16 x i8] c"Factorial(20): \00"
+@.str.9 = private unnamed_addr constant [16 x i8] c"Fibonacci(24): \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
@@ -0,0 +1,633 @@
+# GPLANG Generated Assembly
+# Module: tail_calls
+# Source: ../../examples/basic/tail_calls.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+count_down:
+    # 12 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lcount_down.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq -8(%rbp), %rcx
+    testq %rcx, %rcx
+    jne .Lcount_down.if.end1
+.Lcount_down.if.then0:
+    movq -16(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lcount_down.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq -16(%rbp), %rcx
+    movq -8(%rbp), %rdi
+    movq $7, %r11
+    movq %rdi, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r8
+    leaq (%rcx,%r8), %rdi
+    movq %rdi, %r11
+    movq %rsi, %rdi
+    movq %r11, %rsi
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    jmp count_down
+
+is_even:
+    # 6 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_even.entry:
+    movq %rcx, -8(%rbp)
+    testq %rcx, %rcx
+    jne .Lis_even.if.end1
+.Lis_even.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_even.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    jmp is_odd
+
+is_odd:
+    # 6 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lis_odd.entry:
+    movq %rcx, -8(%rbp)
+    testq %rcx, %rcx
+    jne .Lis_odd.if.end1
+.Lis_odd.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lis_odd.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    jmp is_even
+
+ping:
+    # 35 values in registers, 0 spilled, 80-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $80, %rsp
+    movq %rbx, -64(%rbp)
+    movq %r12, -72(%rbp)
+    movq %r13, -80(%rbp)
+    # Function prologue
+    movq %r9, %rbx
+    movq 16(%rbp), %r12
+    movq %r8, %r9
+    movq %rcx, %r8
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lping.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq %rdi, -24(%rbp)
+    movq %r8, -32(%rbp)
+    movq %r9, -40(%rbp)
+    movq %rbx, -48(%rbp)
+    movq %r12, -56(%rbp)
+    movq -8(%rbp), %rcx
+    testq %rcx, %rcx
+    jne .Lping.if.end1
+.Lping.if.then0:
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    leaq (%rcx,%rsi,2), %rsi
+    movq -32(%rbp), %rcx
+    leaq (%rcx,%rcx,2), %rdi
+    leaq (%rsi,%rdi), %rcx
+    movq -40(%rbp), %rsi
+    leaq (%rcx,%rsi,4), %rsi
+    movq -48(%rbp), %rcx
+    leaq (%rcx,%rcx,4), %rdi
+    leaq (%rsi,%rdi), %rcx
+    movq -56(%rbp), %rsi
+    movq $6, %rdi
+    imulq %rsi, %rdi
+    leaq (%rcx,%rdi), %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq -64(%rbp), %rbx
+    movq -72(%rbp), %r12
+    movq -80(%rbp), %r13
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lping.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq -56(%rbp), %rcx
+    movq -16(%rbp), %rdi
+    movq -24(%rbp), %r8
+    movq -32(%rbp), %r9
+    movq -40(%rbp), %rbx
+    movq -48(%rbp), %r12
+    leaq 1(%r12), %r13
+    movq %rdi, %rdx
+    movq %r13, 16(%rbp)
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    movq %r8, %rcx
+    movq %r9, %r8
+    movq %rbx, %r9
+    # Function epilogue
+    movq -64(%rbp), %rbx
+    movq -72(%rbp), %r12
+    movq -80(%rbp), %r13
+    movq %rbp, %rsp
+    popq %rbp
+    jmp pong
+
+pong:
+    # 32 values in registers, 0 spilled, 96-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $96, %rsp
+    movq %rbx, -64(%rbp)
+    movq %r12, -72(%rbp)
+    movq %r13, -80(%rbp)
+    movq %r14, -88(%rbp)
+    # Function prologue
+    movq %r9, %rbx
+    movq 16(%rbp), %r12
+    movq %r8, %r9
+    movq %rcx, %r8
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lpong.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq %rdi, -24(%rbp)
+    movq %r8, -32(%rbp)
+    movq %r9, -40(%rbp)
+    movq %rbx, -48(%rbp)
+    movq %r12, -56(%rbp)
+    movq -8(%rbp), %rcx
+    testq %rcx, %rcx
+    jne .Lpong.if.end1
+.Lpong.if.then0:
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    movq %rcx, %rdi
+    subq %rsi, %rdi
+    movq -32(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -40(%rbp), %rcx
+    movq %rsi, %rdi
+    subq %rcx, %rdi
+    movq -48(%rbp), %rcx
+    leaq (%rdi,%rcx), %rsi
+    movq -56(%rbp), %rcx
+    movq %rsi, %rdi
+    subq %rcx, %rdi
+    movq %rdi, %rax
+    # Function epilogue
+    movq -64(%rbp), %rbx
+    movq -72(%rbp), %r12
+    movq -80(%rbp), %r13
+    movq -88(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lpong.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq -24(%rbp), %rcx
+    movq -32(%rbp), %rdi
+    movq -40(%rbp), %r8
+    movq -48(%rbp), %r9
+    movq -56(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -8(%rbp), %r13
+    movq $3, %r11
+    movq %r13, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r14
+    leaq (%r12,%r14), %r13
+    movq %rdi, %rdx
+    movq %r13, 16(%rbp)
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    movq %r8, %rcx
+    movq %r9, %r8
+    movq %rbx, %r9
+    # Function epilogue
+    movq -64(%rbp), %rbx
+    movq -72(%rbp), %r12
+    movq -80(%rbp), %r13
+    movq -88(%rbp), %r14
+    movq %rbp, %rsp
+    popq %rbp
+    jmp ping
+
+spread:
+    # 42 values in registers, 0 spilled, 112-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $112, %rsp
+    movq %rbx, -72(%rbp)
+    movq %r12, -80(%rbp)
+    movq %r13, -88(%rbp)
+    movq %r14, -96(%rbp)
+    movq %r15, -104(%rbp)
+    # Function prologue
+    movq %r9, %rbx
+    movq 16(%rbp), %r12
+    movq 24(%rbp), %r13
+    movq %r8, %r9
+    movq %rcx, %r8
+    movq %rdi, %rcx
+    movq %rdx, %rdi
+.Lspread.entry:
+    movq %rcx, -8(%rbp)
+    movq %rsi, -16(%rbp)
+    movq %rdi, -24(%rbp)
+    movq %r8, -32(%rbp)
+    movq %r9, -40(%rbp)
+    movq %rbx, -48(%rbp)
+    movq %r12, -56(%rbp)
+    movq %r13, -64(%rbp)
+    movq -8(%rbp), %rcx
+    testq %rcx, %rcx
+    jne .Lspread.if.end1
+.Lspread.if.then0:
+    movq -16(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    leaq (%rcx,%rsi,2), %rsi
+    movq -32(%rbp), %rcx
+    leaq (%rcx,%rcx,2), %rdi
+    leaq (%rsi,%rdi), %rcx
+    movq -40(%rbp), %rsi
+    leaq (%rcx,%rsi,4), %rsi
+    movq -48(%rbp), %rcx
+    leaq (%rcx,%rcx,4), %rdi
+    leaq (%rsi,%rdi), %rcx
+    movq -56(%rbp), %rsi
+    movq $6, %rdi
+    imulq %rsi, %rdi
+    leaq (%rcx,%rdi), %rsi
+    movq -64(%rbp), %rcx
+    movq $7, %rdi
+    imulq %rcx, %rdi
+    leaq (%rsi,%rdi), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq -72(%rbp), %rbx
+    movq -80(%rbp), %r12
+    movq -88(%rbp), %r13
+    movq -96(%rbp), %r14
+    movq -104(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lspread.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq -64(%rbp), %rcx
+    movq -16(%rbp), %rdi
+    movq -24(%rbp), %r8
+    movq -32(%rbp), %r9
+    movq -40(%rbp), %rbx
+    movq -48(%rbp), %r12
+    movq -56(%rbp), %r13
+    movq -8(%rbp), %r14
+    movq $5, %r11
+    movq %r14, %rax
+    cqto 
+    idivq %r11
+    movq %rdx, %r15
+    leaq (%r13,%r15), %r14
+    movq %rdi, %rdx
+    movq %r12, 16(%rbp)
+    movq %r14, 24(%rbp)
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    movq %r8, %rcx
+    movq %r9, %r8
+    movq %rbx, %r9
+    # Function epilogue
+    movq -72(%rbp), %rbx
+    movq -80(%rbp), %r12
+    movq -88(%rbp), %r13
+    movq -96(%rbp), %r14
+    movq -104(%rbp), %r15
+    movq %rbp, %rsp
+    popq %rbp
+    jmp spread
+
+widen:
+    # 3 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lwiden.entry:
+    movq %rcx, -8(%rbp)
+    # Not a tail call: the callee needs more stack arguments than this frame received
+    pushq $7
+    pushq $6
+    movq %rcx, %rdi
+    movq $1, %rsi
+    movq $2, %rdx
+    movq $3, %rcx
+    movq $4, %r8
+    movq $5, %r9
+    call spread
+    addq $16, %rsp
+    movq %rax, %rsi
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+triangle:
+    # 8 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Ltriangle.entry:
+    movq %rcx, -8(%rbp)
+    testq %rcx, %rcx
+    jne .Ltriangle.if.end1
+.Ltriangle.if.then0:
+    xorl %eax, %eax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Ltriangle.if.end1:
+    movq -8(%rbp), %rbx
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    call triangle
+    movq %rax, %rcx
+    leaq (%rbx,%rcx), %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+factorial:
+    # 8 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    # Function prologue
+    movq %rdi, %rcx
+.Lfactorial.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $1, %rcx
+    jg .Lfactorial.if.end1
+.Lfactorial.if.then0:
+    movq $1, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfactorial.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    call factorial
+    movq %rax, %rcx
+    movq -8(%rbp), %rsi
+    movq %rcx, %rdi
+    imulq %rsi, %rdi
+    movq %rdi, %rax
+    # Function epilogue
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+fibonacci:
+    # 11 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -16(%rbp)
+    # Function prologue
+    movq %rdi, %rcx
+.Lfibonacci.entry:
+    movq %rcx, -8(%rbp)
+    cmpq $1, %rcx
+    jg .Lfibonacci.if.end1
+.Lfibonacci.if.then0:
+    movq -8(%rbp), %rcx
+    movq %rcx, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+.Lfibonacci.if.end1:
+    movq -8(%rbp), %rcx
+    leaq -1(%rcx), %rsi
+    movq %rsi, %rdi
+    call fibonacci
+    movq %rax, %rbx
+    movq -8(%rbp), %rcx
+    leaq -2(%rcx), %rsi
+    movq %rsi, %rdi
+    call fibonacci
+    movq %rax, %rcx
+    leaq (%rbx,%rcx), %rsi
+    movq %rsi, %rax
+    # Function epilogue
+    movq -16(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+main:
+    # 44 values in registers, 0 spilled, 16-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC1(%rip), %rbx
+    movq $1000000, %rdi
+    xorl %esi, %esi
+    call count_down
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+    movq $1000001, %rdi
+    call is_even
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC3(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rbx
+    movq $1000001, %rdi
+    call is_odd
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    leaq .LC4(%rip), %rsi
+    movq %rcx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC5(%rip), %rbx
+    subq $8, %rsp
+    pushq $6
+    movq $100001, %rdi
+    movq $1, %rsi
+    movq $2, %rdx
+    movq $3, %rcx
+    movq $4, %r8
+    movq $5, %r9
+    call ping
+    addq $16, %rsp
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC6(%rip), %rbx
+    movq $1000000, %rdi
+    call widen
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC7(%rip), %rbx
+    movq $50000, %rdi
+    call triangle
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC8(%rip), %rbx
+    movq $20, %rdi
+    call factorial
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC9(%rip), %rbx
+    movq $24, %rdi
+    call fibonacci
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\360\237\224\201 GPLANG Tail Calls"
+.LC1:
+    .string "Count down: "
+.LC2:
+    .string "Parity of 1000001: "
+.LC3:
+    .string " even, "
+.LC4:
+    .string " odd"
+.LC5:
+    .string "Ping-pong over 7 arguments: "
+.LC6:
+    .string "Spread over 8 arguments: "
+.LC7:
+    .string "Triangle(50000): "
+.LC8:
+    .string "Factorial(20): "
+.LC9:
+    .string "Fibonacci(24): "
+
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,328 @@
+# GPLANG Generated Assembly
+# Module: vector_sum
+# Source: ../../examples/basic/vector_sum.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+main:
+    # 96 values in registers, 0 spilled, 32-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $32, %rsp
+    movq %rbx, -8(%rbp)
+    movq %r12, -16(%rbp)
+    movq %r13, -24(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.for.cond0.vec.ph:
+    movq $1, %r11
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movq $3, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm5
+    movq $1, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm6
+    movdqa %xmm2, %xmm7
+    movq $1, %rcx
+    movdqa %xmm4, %xmm8
+    movdqa %xmm4, %xmm9
+.Lmain.for.cond0.vec:
+    leaq 1(%rcx), %rsi
+    cmpq $1000001, %rsi
+    jge .Lmain.for.cond0.vec.end
+.Lmain.for.cond0.vec.body:
+    movdqa %xmm7, %xmm0
+    psrlq $32, %xmm0
+    pmuludq %xmm5, %xmm0
+    movdqa %xmm5, %xmm1
+    psrlq $32, %xmm1
+    pmuludq %xmm7, %xmm1
+    paddq %xmm1, %xmm0
+    psllq $32, %xmm0
+    movdqa %xmm7, %xmm1
+    pmuludq %xmm5, %xmm1
+    paddq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movdqa %xmm2, %xmm4
+    paddq %xmm6, %xmm4
+    movdqa %xmm7, %xmm0
+    psrlq $32, %xmm0
+    pmuludq %xmm7, %xmm0
+    movdqa %xmm7, %xmm1
+    psrlq $32, %xmm1
+    pmuludq %xmm7, %xmm1
+    paddq %xmm1, %xmm0
+    psllq $32, %xmm0
+    movdqa %xmm7, %xmm1
+    pmuludq %xmm7, %xmm1
+    paddq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movdqa %xmm8, %xmm10
+    paddq %xmm4, %xmm10
+    movdqa %xmm9, %xmm4
+    paddq %xmm2, %xmm4
+    movdqa %xmm7, %xmm2
+    paddq %xmm3, %xmm2
+    leaq 2(%rcx), %rsi
+    movdqa %xmm2, %xmm7
+    movq %rsi, %rcx
+    movdqa %xmm10, %xmm8
+    movdqa %xmm4, %xmm9
+    jmp .Lmain.for.cond0.vec
+.Lmain.for.cond0.vec.end:
+    movdqa %xmm8, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, %rdi
+    movdqa %xmm9, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, %r8
+    leaq (%rcx,%rcx,2), %rsi
+    movq %rsi, %r13
+    movq %rdi, %r9
+    movq %r8, %rbx
+    movq %rcx, %r12
+.Lmain.for.cond0:
+    cmpq $1000001, %r12
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    leaq 1(%r13), %rcx
+    leaq (%r9,%rcx), %rsi
+    movq %r12, %rcx
+    imulq %r12, %rcx
+    leaq (%rbx,%rcx), %rdi
+.Lmain.for.step2:
+    leaq 1(%r12), %rcx
+    leaq 3(%r13), %r8
+    movq %r8, %r13
+    movq %rsi, %r9
+    movq %rdi, %rbx
+    movq %rcx, %r12
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %r12
+    movq %r9, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r12, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %r12
+    movq %rbx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %r12, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.for.cond4.vec.ph:
+    xorl %r11d, %r11d
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movq $-40000000, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm5
+    movq $1000, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm6
+    movdqa %xmm2, %xmm7
+    xorl %ecx, %ecx
+    movdqa %xmm4, %xmm8
+.Lmain.for.cond4.vec:
+    leaq 1(%rcx), %rsi
+    cmpq $7, %rsi
+    jge .Lmain.for.cond4.vec.end
+.Lmain.for.cond4.vec.body:
+    movdqa %xmm7, %xmm0
+    psrlq $32, %xmm0
+    pmuludq %xmm5, %xmm0
+    movdqa %xmm5, %xmm1
+    psrlq $32, %xmm1
+    pmuludq %xmm7, %xmm1
+    paddq %xmm1, %xmm0
+    psllq $32, %xmm0
+    movdqa %xmm7, %xmm1
+    pmuludq %xmm5, %xmm1
+    paddq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movdqa %xmm2, %xmm0
+    psrlq $32, %xmm0
+    pmuludq %xmm6, %xmm0
+    movdqa %xmm6, %xmm1
+    psrlq $32, %xmm1
+    pmuludq %xmm2, %xmm1
+    paddq %xmm1, %xmm0
+    psllq $32, %xmm0
+    movdqa %xmm2, %xmm1
+    pmuludq %xmm6, %xmm1
+    paddq %xmm1, %xmm0
+    movdqa %xmm0, %xmm4
+    movdqa %xmm8, %xmm2
+    psubq %xmm4, %xmm2
+    movdqa %xmm7, %xmm4
+    paddq %xmm3, %xmm4
+    leaq 2(%rcx), %rsi
+    movdqa %xmm4, %xmm7
+    movq %rsi, %rcx
+    movdqa %xmm2, %xmm8
+    jmp .Lmain.for.cond4.vec
+.Lmain.for.cond4.vec.end:
+    movdqa %xmm8, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    movq %rsi, %rdi
+    movq %rcx, %rsi
+    imulq $-40000000, %rsi
+    movq %rsi, %rbx
+    movq %rdi, %r8
+    movq %rcx, %r9
+.Lmain.for.cond4:
+    cmpq $7, %r9
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    movq %rbx, %rcx
+    imulq $1000, %rcx
+    movq %r8, %rsi
+    subq %rcx, %rsi
+.Lmain.for.step6:
+    leaq 1(%r9), %rcx
+    leaq -40000000(%rbx), %rdi
+    movq %rdi, %rbx
+    movq %rsi, %r8
+    movq %rcx, %r9
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC3(%rip), %rbx
+    movq %r8, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+.Lmain.for.cond8.vec.ph:
+    movq $5, %r11
+    movq %r11, %xmm0
+    addq $1, %r11
+    movq %r11, %xmm1
+    punpcklqdq %xmm1, %xmm0
+    movdqa %xmm0, %xmm2
+    movq $2, %r11
+    movq %r11, %xmm0
+    punpcklqdq %xmm0, %xmm0
+    movdqa %xmm0, %xmm3
+    pxor %xmm0, %xmm0
+    movdqa %xmm0, %xmm4
+    movdqa %xmm2, %xmm5
+    movq $5, %rcx
+    movdqa %xmm4, %xmm6
+.Lmain.for.cond8.vec:
+    leaq 1(%rcx), %rsi
+    cmpq $10, %rsi
+    jge .Lmain.for.cond8.vec.end
+.Lmain.for.cond8.vec.body:
+    movdqa %xmm6, %xmm2
+    psubq %xmm5, %xmm2
+    movdqa %xmm5, %xmm4
+    paddq %xmm3, %xmm4
+    leaq 2(%rcx), %rsi
+    movdqa %xmm4, %xmm5
+    movq %rsi, %rcx
+    movdqa %xmm2, %xmm6
+    jmp .Lmain.for.cond8.vec
+.Lmain.for.cond8.vec.end:
+    movdqa %xmm6, %xmm0
+    movdqa %xmm0, %xmm1
+    punpckhqdq %xmm1, %xmm1
+    paddq %xmm1, %xmm0
+    movq %xmm0, %rsi
+    leaq 100(%rsi), %rdi
+    movq %rdi, %rsi
+    movq %rcx, %r8
+.Lmain.for.cond8:
+    cmpq $10, %r8
+    jge .Lmain.for.end11
+.Lmain.for.body9:
+    movq %rsi, %rcx
+    subq %r8, %rcx
+.Lmain.for.step10:
+    leaq 1(%r8), %rdi
+    movq %rcx, %rsi
+    movq %rdi, %r8
+    jmp .Lmain.for.cond8
+.Lmain.for.end11:
+    leaq .LC4(%rip), %rbx
+    movq %rsi, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rcx
+    movq %rbx, %rdi
+    movq %rcx, %rsi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rsi
+    movq %rsi, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %r12
+    movq -24(%rbp), %r13
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\342\236\225 GPLANG Vector Sum"
+.LC1:
+    .string "Sum of 3i+1: "
+.LC2:
+    .string "Sum of squares: "
+.LC3:
+    .string "Wide products: "
+.LC4:
+    .string "Countdown: "
+
+.section .note.GNU-stack,"",@progbits
@@ -0,0 +1,158 @@
+; GPLANG Generated LLVM IR
+; ModuleID = 'vector_sum'
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i64 @gp_rt_print_int(i64) #1
+declare i64 @gp_rt_print_float(double) #1
+declare i64 @gp_rt_print_string(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_str_int(i64) #1
+declare noalias i8* @gp_rt_str_float(double) #1
+declare i64 @gp_rt_int_from_string(i8* nocapture readonly) #1
+declare double @gp_rt_float_from_string(i8* nocapture readonly) #1
+declare i64 @gp_rt_string_length(i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_string_concat(i8* nocapture readonly, i8* nocapture readonly) #1
+declare noalias i8* @gp_rt_concat_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_compare_values(i64, i64, i64, i64) #1
+declare i64 @gp_rt_time_now() #1
+declare double @gp_rt_time_seconds(i64) #1
+declare double @gp_rt_time_milliseconds(i64) #1
+declare void @gp_rt_parallel_for(i64, i64, i64, void (i8*, i64, i64)*, i8*) #1
+declare double @llvm.pow.f64(double, double)
+declare double @llvm.sqrt.f64(double)
+declare double @llvm.sin.f64(double)
+declare double @llvm.cos.f64(double)
+declare i8* @llvm.stacksave()
+declare void @llvm.stackrestore(i8*)
+
+; Function: main
+define i32 @main() #0 {
+entry:
+  %v.total = alloca i64
+  %v.squares = alloca i64
+  %v.i = alloca i64
+  %v.scale = alloca i64
+  %v.wide = alloca i64
+  %v.k = alloca i64
+  %v.countdown = alloca i64
+  %v.j = alloca i64
+  call i64 @gp_rt_print_string(i8* getelementptr inbounds ([22 x i8], [22 x i8]* @.str.0, i64 0, i64 0))
+  store i64 0, i64* %v.total
+  store i64 0, i64* %v.squares
+  store i64 1, i64* %v.i
+  br label %for.cond.0
+
+for.cond.0:
+  %t0 = load i64, i64* %v.i
+  %t1 = icmp slt i64 %t0, 1000001
+  br i1 %t1, label %for.body.0, label %for.end.0
+
+for.body.0:
+  %t2 = load i64, i64* %v.i
+  %t3 = mul nsw i64 %t2, 3
+  %t4 = add nsw i64 %t3, 1
+  %t5 = load i64, i64* %v.total
+  %t6 = add nsw i64 %t5, %t4
+  store i64 %t6, i64* %v.total
+  %t7 = load i64, i64* %v.i
+  %t8 = load i64, i64* %v.i
+  %t9 = mul nsw i64 %t7, %t8
+  %t10 = load i64, i64* %v.squares
+  %t11 = add nsw i64 %t10, %t9
+  store i64 %t11, i64* %v.squares
+  br label %for.step.0
+
+for.step.0:
+  %t12 = load i64, i64* %v.i
+  %t13 = add nsw i64 %t12, 1
+  store i64 %t13, i64* %v.i
+  br label %for.cond.0, !llvm.loop !2
+
+for.end.0:
+  %t14 = load i64, i64* %v.total
+  %t15 = call i8* @gp_rt_str_int(i64 %t14)
+  %t16 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([14 x i8], [14 x i8]* @.str.1, i64 0, i64 0), i8* %t15)
+  call i64 @gp_rt_print_string(i8* %t16)
+  %t17 = load i64, i64* %v.squares
+  %t18 = call i8* @gp_rt_str_int(i64 %t17)
+  %t19 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([17 x i8], [17 x i8]* @.str.2, i64 0, i64 0), i8* %t18)
+  call i64 @gp_rt_print_string(i8* %t19)
+  %t20 = sub nsw i64 0, 40000000
+  store i64 %t20, i64* %v.scale
+  store i64 0, i64* %v.wide
+  store i64 0, i64* %v.k
+  br label %for.cond.1
+
+for.cond.1:
+  %t21 = load i64, i64* %v.k
+  %t22 = icmp slt i64 %t21, 7
+  br i1 %t22, label %for.body.1, label %for.end.1
+
+for.body.1:
+  %t23 = load i64, i64* %v.k
+  %t24 = load i64, i64* %v.scale
+  %t25 = mul nsw i64 %t23, %t24
+  %t26 = mul nsw i64 %t25, 1000
+  %t27 = load i64, i64* %v.wide
+  %t28 = sub nsw i64 %t27, %t26
+  store i64 %t28, i64* %v.wide
+  br label %for.step.1
+
+for.step.1:
+  %t29 = load i64, i64* %v.k
+  %t30 = add nsw i64 %t29, 1
+  store i64 %t30, i64* %v.k
+  br label %for.cond.1, !llvm.loop !3
+
+for.end.1:
+  %t31 = load i64, i64* %v.wide
+  %t32 = call i8* @gp_rt_str_int(i64 %t31)
+  %t33 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([16 x i8], [16 x i8]* @.str.3, i64 0, i64 0), i8* %t32)
+  call i64 @gp_rt_print_string(i8* %t33)
+  store i64 100, i64* %v.countdown
+  store i64 5, i64* %v.j
+  br label %for.cond.2
+
+for.cond.2:
+  %t34 = load i64, i64* %v.j
+  %t35 = icmp slt i64 %t34, 10
+  br i1 %t35, label %for.body.2, label %for.end.2
+
+for.body.2:
+  %t36 = load i64, i64* %v.j
+  %t37 = load i64, i64* %v.countdown
+  %t38 = sub nsw i64 %t37, %t36
+  store i64 %t38, i64* %v.countdown
+  br label %for.step.2
+
+for.step.2:
+  %t39 = load i64, i64* %v.j
+  %t40 = add nsw i64 %t39, 1
+  store i64 %t40, i64* %v.j
+  br label %for.cond.2, !llvm.loop !4
+
+for.end.2:
+  %t41 = load i64, i64* %v.countdown
+  %t42 = call i8* @gp_rt_str_int(i64 %t41)
+  %t43 = call i8* @gp_rt_string_concat(i8* getelementptr inbounds ([12 x i8], [12 x i8]* @.str.4, i64 0, i64 0), i8* %t42)
+  call i64 @gp_rt_print_string(i8* %t43)
+  %t44 = trunc i64 0 to i32
+  ret i32 %t44
+}
+
+@.str.0 = private unnamed_addr constant [22 x i8] c"\E2\9E\95 GPLANG Vector Sum\00"
+@.str.1 = private unnamed_addr constant [14 x i8] c"Sum of 3i+1: \00"
+@.str.2 = private unnamed_addr constant [17 x i8] c"Sum of squares: \00"
+@.str.3 = private unnamed_addr constant [16 x i8] c"Wide products: \00"
+@.str.4 = private unnamed_addr constant [12 x i8] c"Countdown: \00"
+
+attributes #0 = { nounwind }
+attributes #1 = { nounwind }
+attributes #2 = { nounwind alwaysinline }
+
+!0 = !{!"llvm.loop.mustprogress"}
+!1 = !{!"llvm.loop.vectorize.enable", i1 true}
+!2 = distinct !{!2, !0, !1}
+!3 = distinct !{!3, !0, !1}
+!4 = distinct !{!4, !0, !1}
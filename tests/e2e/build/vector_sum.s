@@ -0,0 +1,150 @@
+# GPLANG Generated Assembly
+# Module: vector_sum
+# Source: ../../examples/basic/vector_sum.gp
+# Target: x86_64
+
+.section .text
+.global main
+
+main:
+    # 54 values in registers, 0 spilled, 80-byte frame
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $80, %rsp
+    movq %rbx, -72(%rbp)
+    # Function prologue
+.Lmain.entry:
+    leaq .LC0(%rip), %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $0, -8(%rbp)
+    movq $0, -16(%rbp)
+    movq $1, -24(%rbp)
+.Lmain.for.cond0:
+    movq -24(%rbp), %rcx
+    cmpq $1000001, %rcx
+    jge .Lmain.for.end3
+.Lmain.for.body1:
+    movq -24(%rbp), %rcx
+    leaq (%rcx,%rcx,2), %rsi
+    leaq 1(%rsi), %rcx
+    movq -8(%rbp), %rsi
+    leaq (%rsi,%rcx), %rdi
+    movq %rdi, -8(%rbp)
+    movq -24(%rbp), %rcx
+    movq -24(%rbp), %rsi
+    movq %rcx, %rdi
+    imulq %rsi, %rdi
+    movq -16(%rbp), %rcx
+    leaq (%rcx,%rdi), %rsi
+    movq %rsi, -16(%rbp)
+.Lmain.for.step2:
+    movq -24(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -24(%rbp)
+    jmp .Lmain.for.cond0
+.Lmain.for.end3:
+    leaq .LC1(%rip), %rbx
+    movq -8(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    leaq .LC2(%rip), %rbx
+    movq -16(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %ecx, %ecx
+    subq $40000000, %rcx
+    movq %rcx, -32(%rbp)
+    movq $0, -40(%rbp)
+    movq $0, -48(%rbp)
+.Lmain.for.cond4:
+    movq -48(%rbp), %rcx
+    cmpq $7, %rcx
+    jge .Lmain.for.end7
+.Lmain.for.body5:
+    movq -48(%rbp), %rcx
+    movq -32(%rbp), %rsi
+    movq %rcx, %rdi
+    imulq %rsi, %rdi
+    movq %rdi, %rcx
+    imulq $1000, %rcx
+    movq -40(%rbp), %rsi
+    movq %rsi, %rdi
+    subq %rcx, %rdi
+    movq %rdi, -40(%rbp)
+.Lmain.for.step6:
+    movq -48(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -48(%rbp)
+    jmp .Lmain.for.cond4
+.Lmain.for.end7:
+    leaq .LC3(%rip), %rbx
+    movq -40(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    movq $100, -56(%rbp)
+    movq $5, -64(%rbp)
+.Lmain.for.cond8:
+    movq -64(%rbp), %rcx
+    cmpq $10, %rcx
+    jge .Lmain.for.end11
+.Lmain.for.body9:
+    movq -64(%rbp), %rcx
+    movq -56(%rbp), %rsi
+    movq %rsi, %rdi
+    subq %rcx, %rdi
+    movq %rdi, -56(%rbp)
+.Lmain.for.step10:
+    movq -64(%rbp), %rcx
+    leaq 1(%rcx), %rsi
+    movq %rsi, -64(%rbp)
+    jmp .Lmain.for.cond8
+.Lmain.for.end11:
+    leaq .LC4(%rip), %rbx
+    movq -56(%rbp), %rcx
+    movq %rcx, %rdi
+    call gp_rt_str_int@PLT
+    movq %rax, %rsi
+    movq %rbx, %rdi
+    call gp_rt_string_concat@PLT
+    movq %rax, %rcx
+    movq %rcx, %rdi
+    call gp_rt_print_string@PLT
+    xorl %eax, %eax
+    # Function epilogue
+    movq -72(%rbp), %rbx
+    movq %rbp, %rsp
+    popq %rbp
+    ret 
+
+.section .rodata
+.LC0:
+    .string "\342\236\225 GPLANG Vector Sum"
+.LC1:
+    .string "Sum of 3i+1: "
+.LC2:
+    .string "Sum of squares: "
+.LC3:
+    .string "Wide products: "
+.LC4:
+    .string "Countdown: "
+
+.section .note.GNU-stack,"",@progbits
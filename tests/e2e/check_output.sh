@@ -0,0 +1,27 @@
+#!/bin/sh
+# Compare a program's output with its expected file, line by line.
+# Expected lines are shell glob patterns so timings can be written as "Time: *ms".
+# Usage: check_output.sh expected.out actual.out
+
+expected="$1"
+actual="$2"
+
+if [ "$(wc -l < "$expected")" -ne "$(wc -l < "$actual")" ]; then
+    echo "line count differs: expected $(wc -l < "$expected"), got $(wc -l < "$actual")"
+    exit 1
+fi
+
+line=0
+status=0
+while IFS= read -r pattern <&3 && IFS= read -r output <&4; do
+    line=$((line + 1))
+    case "$output" in
+        $pattern) ;;
+        *)
+            echo "line $line: expected '$pattern', got '$output'"
+            status=1
+            ;;
+    esac
+done 3< "$expected" 4< "$actual"
+
+exit $status
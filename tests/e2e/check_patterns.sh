@@ -0,0 +1,45 @@
+#!/bin/sh
+# Check a compile's assembly and -v output against a file of patterns.
+# Each line is "asm|pairs|log OP REGEX", REGEX an extended regular expression:
+#   +  some line matches      -  no line matches      N  exactly N lines match
+# "pairs" is the assembly with each line joined to the next by " ; ", for
+# patterns over two instructions. Blank lines and lines starting with #
+# are skipped.
+# Usage: check_patterns.sh expected.checks program.s verbose.log
+
+checks="$1"
+asm="$2"
+log="$3"
+pairs="$asm.pairs"
+awk 'NR > 1 { print previous " ; " $0 } { previous = $0 }' "$asm" > "$pairs"
+
+line=0
+status=0
+while read -r target op pattern; do
+    line=$((line + 1))
+    case "$target" in
+        ''|'#'*) continue ;;
+        asm) file="$asm" ;;
+        pairs) file="$pairs" ;;
+        log) file="$log" ;;
+        *)
+            echo "$checks:$line: unknown target '$target'"
+            status=1
+            continue
+            ;;
+    esac
+
+    count=$(grep -cE -- "$pattern" "$file")
+    case "$op" in
+        +) test "$count" -gt 0 ;;
+        -) test "$count" -eq 0 ;;
+        *) test "$count" -eq "$op" ;;
+    esac || {
+        printf "%s:%d: expected '%s' lines of %s to match '%s', found %d\n" \
+            "$checks" "$line" "$op" "$target" "$pattern" "$count"
+        grep -E -- "$pattern" "$file" | head -5
+        status=1
+    }
+done < "$checks"
+
+exit $status